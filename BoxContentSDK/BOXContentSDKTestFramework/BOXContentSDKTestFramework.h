@@ -12,3 +12,7 @@
 #import "BOXCannedURLProtocol.h"
 #import "BOXContentSDKTestCase.h"
 #import "BOXCannedResponse.h"
+#import "BOXNetworkConditions.h"
+#import "BOXSimulatedNetwork.h"
+#import "BOXAPIEmulator.h"
+#import "BOXAPIEmulatorURLProtocol.h"
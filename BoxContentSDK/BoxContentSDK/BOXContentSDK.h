@@ -34,6 +34,7 @@
 #import "BOXAuthorizationViewController.h"
 #import "BOXAbstractSession.h"
 #import "BOXAbstractSession_Private.h"
+#import "BOXSessionTokenSnapshot.h"
 #import "BOXOAuth2Session.h"
 #import "BOXParallelOAuth2Session.h"
 #import "BOXAppUserSession.h"
@@ -100,12 +101,29 @@
 #import "BOXItemSetCollectionsRequest.h"
 #import "BOXEventsRequest.h"
 #import "BOXEventsAdminLogsRequest.h"
+#import "BOXEventsRealtimeServerRequest.h"
+#import "BOXEventsLongPollRequest.h"
+#import "BOXEventsRealtimeMonitor.h"
+#import "BOXEventsAdminLogsExporter.h"
+#import "BOXEventsNDJSONFileSink.h"
 #import "BOXCollaborationRequest.h"
 #import "BOXCollaborationCreateRequest.h"
 #import "BOXCollaborationRemoveRequest.h"
 #import "BOXCollaborationUpdateRequest.h"
 #import "BOXCollaborationPendingRequest.h"
 #import "BOXSearchRequest.h"
+#import "BOXSearchSession.h"
+#import "BOXItemNameIndex.h"
+#import "BOXPathResolver.h"
+#import "BOXFolderTreeWalker.h"
+#import "BOXFolderDownloader.h"
+#import "BOXDirectoryUploader.h"
+#import "BOXBulkItemProcessor.h"
+#import "BOXMetadataUpdateQueue.h"
+#import "BOXTransferMemoryMonitor.h"
+#import "BOXMetricsRegistry.h"
+#import "BOXCancellationContext.h"
+#import "BOXTraceLog.h"
 #import "BOXTrashedItemArrayRequest.h"
 #import "BOXTrashedFolderRestoreRequest.h"
 #import "BOXTrashedFileRestoreRequest.h"
@@ -125,6 +143,7 @@
 #import "BOXAPIQueueManager.h"
 #import "BOXSerialAPIQueueManager.h"
 #import "BOXParallelAPIQueueManager.h"
+#import "BOXAPIScheduler.h"
 #import "BOXAPIAccessTokenDelegate.h"
 
 // API Operations
@@ -152,6 +171,7 @@
 
 #import "BOXCollection.h"
 #import "BOXEvent.h"
+#import "BOXRealtimeServer.h"
 #import "BOXCollaboration.h"
 #import "BOXGroup.h"
 #import "BOXFileVersion.h"
@@ -171,6 +191,7 @@
 #import "NSURL+BOXURLHelper.h"
 #import "NSJSONSerialization+BOXContentSDKAdditions.h"
 #import "NSDate+BOXContentSDKAdditions.h"
+#import "NSData+BOXContentSDKAdditions.h"
 
 // External
 #import "BOXHashHelper.h"
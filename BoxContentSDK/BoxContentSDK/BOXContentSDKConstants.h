@@ -61,6 +61,9 @@ extern BOXAPIHTTPHeader *const BOXAPIHTTPHeaderIfMatch;
 extern BOXAPIHTTPHeader *const BOXAPIHTTPHeaderIfNoneMatch;
 extern BOXAPIHTTPHeader *const BOXAPIHTTPHeaderBoxAPI;
 extern BOXAPIHTTPHeader *const BOXAPIHTTPHeaderXRepHints;
+extern BOXAPIHTTPHeader *const BOXAPIHTTPHeaderRange;
+extern BOXAPIHTTPHeader *const BOXAPIHTTPHeaderAcceptEncoding;
+extern BOXAPIHTTPHeader *const BOXAPIHTTPHeaderContentEncoding;
 
 // OAuth2 constants
 // Authorization code response
@@ -93,6 +96,18 @@ extern NSString *const BOXOAuth2AuthDelegationNewClientKey;
 extern NSString *const BOXUserWasLoggedOutDueToErrorNotification;
 extern NSString *const BOXAuthOperationDidCompleteNotification;
 extern NSString *const BOXFileDownloadCorruptedNotification;
+extern NSString *const BOXTransferMemoryHighWaterNotification;
+extern NSString *const BOXTransferMemoryLimitReachedNotification;
+
+// Transfer memory notification keys
+extern NSString *const BOXTransferMemoryCurrentBytesKey;
+extern NSString *const BOXTransferMemoryPeakBytesKey;
+extern NSString *const BOXTransferMemoryOperationBytesKey;
+
+// Cache layers reported to BOXMetricsRegistry
+extern NSString *const BOXMetricsCacheLayerPathResolver;
+extern NSString *const BOXMetricsCacheLayerSearchSession;
+extern NSString *const BOXMetricsCacheLayerResumeData;
 
 // Private Notifications. No guarantee for future support.
 extern NSString *const BOXAccessTokenRefreshDiagnosisNotification;
@@ -110,6 +125,7 @@ extern BOXAPIItemType *const BOXAPIItemTypeCollaboration;
 extern BOXAPIItemType *const BOXAPIItemTypeGroup;
 extern BOXAPIItemType *const BOXAPIItemTypeFileVersion;
 extern BOXAPIItemType *const BOXAPIItemTypeRecentItem;
+extern BOXAPIItemType *const BOXAPIItemTypeRealtimeServer;
 
 // Shared Link Access Levels
 typedef NSString BOXSharedLinkAccessLevel;
@@ -361,6 +377,9 @@ extern NSString *const BOXAPIObjectKeyCollectionType;
 extern NSString *const BOXAPIObjectKeyCollectionRank;
 extern NSString *const BOXAPIObjectKeyEventID;
 extern NSString *const BOXAPIObjectKeyEventType;
+extern NSString *const BOXAPIObjectKeyTTL;
+extern NSString *const BOXAPIObjectKeyMaxRetries;
+extern NSString *const BOXAPIObjectKeyRetryTimeout;
 extern NSString *const BOXAPIObjectKeyInteractionSharedLink;
 extern NSString *const BOXAPIObjectKeyInteractionType;
 extern NSString *const BOXAPIObjectKeySessionID;
@@ -377,6 +396,8 @@ extern NSString *const BOXAPIObjectKeyLinks;
 extern NSString *const BOXAPIObjectKeyContent;
 extern NSString *const BOXAPIObjectKeyInfo;
 extern NSString *const BOXAPIObjectKeyDimensions;
+extern NSString *const BOXAPIObjectKeyContextInfo;
+extern NSString *const BOXAPIObjectKeyConflicts;
 
 // API Metadata Object keys
 extern NSString *const BOXAPIMetadataObjectKeyID;
@@ -398,12 +419,16 @@ extern NSString *const BOXAPIFavoritesCollectionType;
 
 // API Events Constants
 extern NSString *const BOXAPIEventStreamPositionDefault;
+extern NSString *const BOXAPIEventStreamPositionNow;
 
 extern NSString *const BOXAPIEventStreamTypeAll;
 extern NSString *const BOXAPIEventStreamTypeChanges;
 extern NSString *const BOXAPIEventStreamTypeSync;
 extern NSString *const BOXAPIEventStreamTypeAdminLogs;
 
+extern NSString *const BOXAPIEventLongPollMessageNewChange;
+extern NSString *const BOXAPIEventLongPollMessageReconnect;
+
 // API Recent Items Constants
 extern NSString *const BOXAPIRecentItemsListTypeShared;
 extern NSString *const BOXAPIRecentItemsInteractionTypeOpen;
@@ -55,6 +55,9 @@ BOXAPIHTTPHeader *const BOXAPIHTTPHeaderIfMatch = @"If-Match";
 BOXAPIHTTPHeader *const BOXAPIHTTPHeaderIfNoneMatch = @"If-None-Match";
 BOXAPIHTTPHeader *const BOXAPIHTTPHeaderBoxAPI = @"BoxApi";
 BOXAPIHTTPHeader *const BOXAPIHTTPHeaderXRepHints = @"X-Rep-Hints";
+BOXAPIHTTPHeader *const BOXAPIHTTPHeaderRange = @"Range";
+BOXAPIHTTPHeader *const BOXAPIHTTPHeaderAcceptEncoding = @"Accept-Encoding";
+BOXAPIHTTPHeader *const BOXAPIHTTPHeaderContentEncoding = @"Content-Encoding";
 
 // OAuth2 constants
 // Authorization code response
@@ -88,6 +91,18 @@ NSString *const BOXUserWasLoggedOutDueToErrorNotification = @"BOXUserWasLoggedOu
 NSString *const BOXAuthOperationDidCompleteNotification = @"BOXOAuth2OperationDidComplete";
 NSString *const BOXAccessTokenRefreshDiagnosisNotification = @"BOXAccessTokenRefreshDiagnosisNotification";
 NSString *const BOXFileDownloadCorruptedNotification = @"BOXFileDownloadCorruptedNotification";
+NSString *const BOXTransferMemoryHighWaterNotification = @"BOXTransferMemoryHighWaterNotification";
+NSString *const BOXTransferMemoryLimitReachedNotification = @"BOXTransferMemoryLimitReachedNotification";
+
+// Transfer memory notification keys
+NSString *const BOXTransferMemoryCurrentBytesKey = @"BOXTransferMemoryCurrentBytes";
+NSString *const BOXTransferMemoryPeakBytesKey = @"BOXTransferMemoryPeakBytes";
+NSString *const BOXTransferMemoryOperationBytesKey = @"BOXTransferMemoryOperationBytes";
+
+// Cache layers reported to BOXMetricsRegistry
+NSString *const BOXMetricsCacheLayerPathResolver = @"path_resolver";
+NSString *const BOXMetricsCacheLayerSearchSession = @"search_session";
+NSString *const BOXMetricsCacheLayerResumeData = @"resume_data";
 
 // Item Types
 BOXAPIItemType *const BOXAPIItemTypeFile = @"file";
@@ -101,6 +116,7 @@ BOXAPIItemType *const BOXAPIItemTypeCollaboration = @"collaboration";
 BOXAPIItemType *const BOXAPIItemTypeGroup = @"group";
 BOXAPIItemType *const BOXAPIItemTypeFileVersion = @"file_version";
 BOXAPIItemType *const BOXAPIItemTypeRecentItem = @"recent_item";
+BOXAPIItemType *const BOXAPIItemTypeRealtimeServer = @"realtime_server";
 
 // Shared Link Access Levels
 BOXSharedLinkAccessLevel *const BOXSharedLinkAccessLevelOpen = @"open";
@@ -334,6 +350,9 @@ NSString *const BOXAPIObjectKeyCollectionType = @"collection_type";
 NSString *const BOXAPIObjectKeyCollectionRank = @"rank";
 NSString *const BOXAPIObjectKeyEventID = @"event_id";
 NSString *const BOXAPIObjectKeyEventType = @"event_type";
+NSString *const BOXAPIObjectKeyTTL = @"ttl";
+NSString *const BOXAPIObjectKeyMaxRetries = @"max_retries";
+NSString *const BOXAPIObjectKeyRetryTimeout = @"retry_timeout";
 NSString *const BOXAPIObjectKeyInteractionSharedLink = @"interaction_shared_link";
 NSString *const BOXAPIObjectKeyInteractionType = @"interaction_type";
 NSString *const BOXAPIObjectKeySessionID = @"session_id";
@@ -350,6 +369,8 @@ NSString *const BOXAPIObjectKeyLinks = @"links";
 NSString *const BOXAPIObjectKeyContent = @"content";
 NSString *const BOXAPIObjectKeyInfo = @"info";
 NSString *const BOXAPIObjectKeyDimensions = @"dimensions";
+NSString *const BOXAPIObjectKeyContextInfo = @"context_info";
+NSString *const BOXAPIObjectKeyConflicts = @"conflicts";
 
 // API metadata object keys
 NSString *const BOXAPIMetadataObjectKeyID = @"$id";
@@ -372,12 +393,16 @@ NSString *const BOXAPIFavoritesCollectionType = @"favorites";
 
 // API Events Constants
 NSString *const BOXAPIEventStreamPositionDefault = @"0";
+NSString *const BOXAPIEventStreamPositionNow = @"now";
 
 NSString *const BOXAPIEventStreamTypeAll = @"all";
 NSString *const BOXAPIEventStreamTypeChanges = @"changes";
 NSString *const BOXAPIEventStreamTypeSync = @"sync";
 NSString *const BOXAPIEventStreamTypeAdminLogs = @"admin_logs";
 
+NSString *const BOXAPIEventLongPollMessageNewChange = @"new_change";
+NSString *const BOXAPIEventLongPollMessageReconnect = @"reconnect";
+
 // API Recent Items Constants
 NSString *const BOXAPIRecentItemsListTypeShared = @"shared";
 NSString *const BOXAPIRecentItemsInteractionTypeOpen = @"item_open";
@@ -44,6 +44,8 @@ typedef NS_ENUM(NSUInteger, BOXContentSDKAPIError) {
     BOXContentSDKAPIErrorInternalServerError = 500,
     BOXContentSDKAPIErrorInsufficientStorage = 507,
     
+    // The deadline of the request's BOXCancellationContext passed
+    BOXContentSDKAPIDeadlineExceededError = 996,
     // Access Denied by user
     BOXContentSDKAPIErrorUserDeniedAccess = 997,
     // Cancelation
@@ -74,7 +76,8 @@ typedef NS_ENUM(NSUInteger, BOXContentSDKAppUserError) {
 
 typedef NS_ENUM(NSUInteger, BOXContentSDKStreamError) {
     BOXContentSDKStreamErrorWriteFailed = 30000,
-    BOXContentSDKStreamErrorReadFailed = 30001
+    BOXContentSDKStreamErrorReadFailed = 30001,
+    BOXContentSDKStreamErrorMemoryLimitExceeded = 30002 // Operation failed because it held more bytes in memory than BOXTransferMemoryMonitor allows
 };
 
 typedef NS_ENUM(NSUInteger, BOXContentSDKURLSessionError) {
@@ -0,0 +1,111 @@
+//
+//  BOXTraceLog.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+typedef NS_ENUM(uint8_t, BOXTraceLevel) {
+    BOXTraceLevelDebug = 0,
+    BOXTraceLevelInfo,
+    BOXTraceLevelWarning,
+    BOXTraceLevelError,
+};
+
+/**
+ * What a trace record describes. The meaning of the values of a record depends on its event.
+ */
+typedef NS_ENUM(uint16_t, BOXTraceEvent) {
+    /** value1: BOXTraceQueue, value2: class of the operation. */
+    BOXTraceEventOperationEnqueued = 1,
+    BOXTraceEventOperationStarted,
+    BOXTraceEventOperationExecuting,
+    /** value1: error code. */
+    BOXTraceEventOperationSessionTaskFailed,
+    BOXTraceEventOperationShortCircuited,
+    BOXTraceEventOperationCancelled,
+    /** value1: HTTP status code, value2: error code, value3: BOXTraceErrorDomain. */
+    BOXTraceEventOperationFinished,
+    /** value1: bytes held by the operation. */
+    BOXTraceEventOperationMemoryLimitExceeded,
+    BOXTraceEventAuthOperationCompleted,
+};
+
+typedef NS_ENUM(int64_t, BOXTraceQueue) {
+    BOXTraceQueueGlobal = 0,
+    BOXTraceQueueDownloads,
+    BOXTraceQueueSmallDownloads,
+    BOXTraceQueueUploads,
+    BOXTraceQueueSmallUploads,
+    BOXTraceQueueLongPoll,
+};
+
+typedef NS_ENUM(int64_t, BOXTraceErrorDomain) {
+    BOXTraceErrorDomainNone = 0,
+    BOXTraceErrorDomainContentSDK,
+    BOXTraceErrorDomainURL,
+    BOXTraceErrorDomainOther,
+};
+
+/**
+ * Records below this level are dropped. Defaults to BOXTraceLevelDebug. Read without synchronization on every
+ * record, so set it once, early.
+ */
+extern BOXTraceLevel BOXTraceMinimumLevel;
+
+/**
+ * Appends a record to the ring buffer of the calling thread. Does not allocate, format or lock, except the first
+ * time a thread records.
+ */
+void BOXTraceRecord(BOXTraceLevel level, BOXTraceEvent event, uint64_t operationID, int64_t value1, int64_t value2, int64_t value3);
+
+#define BOXTrace(level, event, operationID, value1, value2, value3) \
+    do { \
+        if ((level) >= BOXTraceMinimumLevel) { \
+            BOXTraceRecord((level), (event), (operationID), (int64_t)(value1), (int64_t)(value2), (int64_t)(value3)); \
+        } \
+    } while (0)
+
+#define BOX_TRACE_LOG_BUFFER_CAPACITY (512)
+
+typedef void (^BOXTraceFailureHandler)(uint64_t operationID, NSError *error, NSString *dump);
+
+/**
+ * Structured, leveled trace of what the SDK's operations do, kept for diagnostics.
+ *
+ * Each thread records fixed-size binary records (time, level, event, operation ID and three integers) into a
+ * ring buffer of its own, without formatting strings or taking locks. The last BOX_TRACE_LOG_BUFFER_CAPACITY - 1
+ * records of each thread are kept: the oldest slot is the one the thread may be overwriting during a dump.
+ * Records are formatted only when dumped: on request, or for an operation that fails, if a failure handler is
+ * set.
+ */
+@interface BOXTraceLog : NSObject
+
+/**
+ * Formats the records of every thread, oldest first, one per line.
+ */
++ (NSString *)dump;
+
+/**
+ * Formats the records of one operation, oldest first, one per line.
+ */
++ (NSString *)dumpForOperationID:(uint64_t)operationID;
+
+/**
+ * Called with the dump of an operation that failed with an error other than a cancellation, on the thread the
+ * operation finished on. nil, the default, leaves failures undumped.
+ */
++ (void)setFailureHandler:(BOXTraceFailureHandler)failureHandler;
++ (BOXTraceFailureHandler)failureHandler;
+
+/**
+ * A process-unique ID for a new operation.
+ */
++ (uint64_t)nextOperationID;
+
+/**
+ * Drops every record.
+ */
++ (void)clear;
+
+@end
@@ -0,0 +1,286 @@
+//
+//  BOXTraceLog.m
+//  BoxContentSDK
+//
+
+#import "BOXTraceLog.h"
+#import <pthread.h>
+#import <stdatomic.h>
+
+BOXTraceLevel BOXTraceMinimumLevel = BOXTraceLevelDebug;
+
+typedef struct {
+    CFAbsoluteTime time;
+    uint64_t operationID;
+    int64_t values[3];
+    uint32_t threadNumber;
+    uint16_t event;
+    uint8_t level;
+} BOXTraceRecordData;
+
+// Only the thread owning a buffer writes its records. writeIndex is published after each record is written, so
+// that a dump can tell which records it read were overwritten meanwhile.
+typedef struct BOXTraceBuffer {
+    BOXTraceRecordData records[BOX_TRACE_LOG_BUFFER_CAPACITY];
+    _Atomic uint64_t writeIndex;
+    _Atomic uint64_t clearedIndex;
+    uint32_t threadNumber;
+    // Set when the owning thread exits, so that the next new thread reuses the buffer. Guarded by BOXTraceBuffersLock.
+    BOOL retired;
+    struct BOXTraceBuffer *next;
+} BOXTraceBuffer;
+
+static pthread_mutex_t BOXTraceBuffersLock = PTHREAD_MUTEX_INITIALIZER;
+static BOXTraceBuffer *BOXTraceBuffers = NULL;
+static uint32_t BOXTraceThreadCount = 0;
+static pthread_key_t BOXTraceBufferKey;
+static pthread_once_t BOXTraceBufferKeyOnce = PTHREAD_ONCE_INIT;
+static __thread BOXTraceBuffer *BOXTraceThreadBuffer = NULL;
+static _Atomic uint64_t BOXTraceLastOperationID = 0;
+static BOXTraceFailureHandler BOXTraceCurrentFailureHandler = nil;
+
+static void BOXTraceRetireBuffer(void *buffer)
+{
+    // The destructors of other thread-specific values may still record. They must claim a buffer of their own
+    // rather than write into this one once the next new thread has taken it over.
+    BOXTraceThreadBuffer = NULL;
+
+    pthread_mutex_lock(&BOXTraceBuffersLock);
+    ((BOXTraceBuffer *)buffer)->retired = YES;
+    pthread_mutex_unlock(&BOXTraceBuffersLock);
+}
+
+static void BOXTraceCreateBufferKey(void)
+{
+    pthread_key_create(&BOXTraceBufferKey, BOXTraceRetireBuffer);
+}
+
+static BOXTraceBuffer *BOXTraceClaimBuffer(void)
+{
+    pthread_once(&BOXTraceBufferKeyOnce, BOXTraceCreateBufferKey);
+
+    pthread_mutex_lock(&BOXTraceBuffersLock);
+    BOXTraceBuffer *buffer = BOXTraceBuffers;
+    while (buffer != NULL && !buffer->retired) {
+        buffer = buffer->next;
+    }
+    if (buffer == NULL) {
+        buffer = calloc(1, sizeof(BOXTraceBuffer));
+        if (buffer == NULL) {
+            pthread_mutex_unlock(&BOXTraceBuffersLock);
+            return NULL;
+        }
+        buffer->next = BOXTraceBuffers;
+        BOXTraceBuffers = buffer;
+    }
+    buffer->retired = NO;
+    buffer->threadNumber = ++BOXTraceThreadCount;
+    pthread_mutex_unlock(&BOXTraceBuffersLock);
+
+    pthread_setspecific(BOXTraceBufferKey, buffer);
+    return buffer;
+}
+
+void BOXTraceRecord(BOXTraceLevel level, BOXTraceEvent event, uint64_t operationID, int64_t value1, int64_t value2, int64_t value3)
+{
+    BOXTraceBuffer *buffer = BOXTraceThreadBuffer;
+    if (buffer == NULL) {
+        buffer = BOXTraceClaimBuffer();
+        if (buffer == NULL) {
+            return;
+        }
+        BOXTraceThreadBuffer = buffer;
+    }
+
+    uint64_t writeIndex = atomic_load_explicit(&buffer->writeIndex, memory_order_relaxed);
+    // Keeps the record's writes from becoming visible before the write index published for the previous record,
+    // which a dump relies on to tell that the record is being overwritten.
+    atomic_thread_fence(memory_order_release);
+    BOXTraceRecordData *record = &buffer->records[writeIndex % BOX_TRACE_LOG_BUFFER_CAPACITY];
+    record->time = CFAbsoluteTimeGetCurrent();
+    record->operationID = operationID;
+    record->values[0] = value1;
+    record->values[1] = value2;
+    record->values[2] = value3;
+    record->threadNumber = buffer->threadNumber;
+    record->event = event;
+    record->level = level;
+    atomic_store_explicit(&buffer->writeIndex, writeIndex + 1, memory_order_release);
+}
+
+static int BOXTraceCompareRecords(const void *first, const void *second)
+{
+    CFAbsoluteTime firstTime = ((const BOXTraceRecordData *)first)->time;
+    CFAbsoluteTime secondTime = ((const BOXTraceRecordData *)second)->time;
+    return (firstTime > secondTime) - (firstTime < secondTime);
+}
+
+static NSString *BOXTraceLevelName(uint8_t level)
+{
+    switch (level) {
+        case BOXTraceLevelDebug:
+            return @"debug";
+        case BOXTraceLevelInfo:
+            return @"info";
+        case BOXTraceLevelWarning:
+            return @"warning";
+        case BOXTraceLevelError:
+            return @"error";
+    }
+    return @"?";
+}
+
+static NSString *BOXTraceQueueName(int64_t queue)
+{
+    switch (queue) {
+        case BOXTraceQueueGlobal:
+            return @"global";
+        case BOXTraceQueueDownloads:
+            return @"downloads";
+        case BOXTraceQueueSmallDownloads:
+            return @"small downloads";
+        case BOXTraceQueueUploads:
+            return @"uploads";
+        case BOXTraceQueueSmallUploads:
+            return @"small uploads";
+        case BOXTraceQueueLongPoll:
+            return @"long-poll";
+    }
+    return @"?";
+}
+
+static NSString *BOXTraceErrorDomainName(int64_t domain)
+{
+    switch (domain) {
+        case BOXTraceErrorDomainNone:
+            return @"none";
+        case BOXTraceErrorDomainContentSDK:
+            return @"BOXContentSDKErrorDomain";
+        case BOXTraceErrorDomainURL:
+            return @"NSURLErrorDomain";
+        case BOXTraceErrorDomainOther:
+            return @"other";
+    }
+    return @"?";
+}
+
+static NSString *BOXTraceEventDescription(const BOXTraceRecordData *record)
+{
+    switch ((BOXTraceEvent)record->event) {
+        case BOXTraceEventOperationEnqueued:
+            // Classes are never deallocated, so the pointer recorded is still valid.
+            return [NSString stringWithFormat:@"enqueued %@ on %@ queue",
+                    NSStringFromClass((__bridge Class)(void *)(uintptr_t)record->values[1]), BOXTraceQueueName(record->values[0])];
+        case BOXTraceEventOperationStarted:
+            return @"started";
+        case BOXTraceEventOperationExecuting:
+            return @"executing";
+        case BOXTraceEventOperationSessionTaskFailed:
+            return [NSString stringWithFormat:@"failed to create session task, error %lld", record->values[0]];
+        case BOXTraceEventOperationShortCircuited:
+            return @"cancelled before the API call, short circuiting";
+        case BOXTraceEventOperationCancelled:
+            return @"cancelled";
+        case BOXTraceEventOperationFinished:
+            return [NSString stringWithFormat:@"finished with status %lld, error %lld in %@",
+                    record->values[0], record->values[1], BOXTraceErrorDomainName(record->values[2])];
+        case BOXTraceEventOperationMemoryLimitExceeded:
+            return [NSString stringWithFormat:@"over its memory limit with %lld bytes", record->values[0]];
+        case BOXTraceEventAuthOperationCompleted:
+            return @"auth operation completed, removed from auth dependencies";
+    }
+    return [NSString stringWithFormat:@"event %u (%lld, %lld, %lld)", record->event, record->values[0], record->values[1], record->values[2]];
+}
+
+@implementation BOXTraceLog
+
++ (NSString *)dump
+{
+    return [self dumpRecordsMatchingOperationID:NO operationID:0];
+}
+
++ (NSString *)dumpForOperationID:(uint64_t)operationID
+{
+    return [self dumpRecordsMatchingOperationID:YES operationID:operationID];
+}
+
++ (NSString *)dumpRecordsMatchingOperationID:(BOOL)matchesOperationID operationID:(uint64_t)operationID
+{
+    NSMutableData *recordsData = [NSMutableData data];
+
+    pthread_mutex_lock(&BOXTraceBuffersLock);
+    for (BOXTraceBuffer *buffer = BOXTraceBuffers; buffer != NULL; buffer = buffer->next) {
+        uint64_t endIndex = atomic_load_explicit(&buffer->writeIndex, memory_order_acquire);
+        uint64_t clearedIndex = atomic_load_explicit(&buffer->clearedIndex, memory_order_relaxed);
+        uint64_t startIndex = MAX(clearedIndex, endIndex > BOX_TRACE_LOG_BUFFER_CAPACITY ? endIndex - BOX_TRACE_LOG_BUFFER_CAPACITY : 0);
+        if (startIndex >= endIndex) {
+            continue;
+        }
+
+        BOXTraceRecordData copies[BOX_TRACE_LOG_BUFFER_CAPACITY];
+        for (uint64_t index = startIndex; index < endIndex; index++) {
+            copies[index - startIndex] = buffer->records[index % BOX_TRACE_LOG_BUFFER_CAPACITY];
+        }
+
+        // The owning thread kept recording while the records were copied. Drop the ones it may have overwritten.
+        // The fence keeps the copies above from being read after the write index below.
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t writeIndexAfterCopy = atomic_load_explicit(&buffer->writeIndex, memory_order_relaxed);
+        uint64_t firstIntactIndex = writeIndexAfterCopy >= BOX_TRACE_LOG_BUFFER_CAPACITY ? writeIndexAfterCopy - BOX_TRACE_LOG_BUFFER_CAPACITY + 1 : 0;
+        for (uint64_t index = MAX(startIndex, firstIntactIndex); index < endIndex; index++) {
+            BOXTraceRecordData *record = &copies[index - startIndex];
+            if (!matchesOperationID || record->operationID == operationID) {
+                [recordsData appendBytes:record length:sizeof(BOXTraceRecordData)];
+            }
+        }
+    }
+    pthread_mutex_unlock(&BOXTraceBuffersLock);
+
+    NSUInteger recordCount = recordsData.length / sizeof(BOXTraceRecordData);
+    BOXTraceRecordData *records = recordsData.mutableBytes;
+    // Stable, so that records of a thread recorded within the same microsecond keep their order.
+    mergesort(records, recordCount, sizeof(BOXTraceRecordData), BOXTraceCompareRecords);
+
+    NSDateFormatter *dateFormatter = [[NSDateFormatter alloc] init];
+    dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+    dateFormatter.dateFormat = @"HH:mm:ss.SSS";
+
+    NSMutableString *dump = [NSMutableString string];
+    for (NSUInteger index = 0; index < recordCount; index++) {
+        BOXTraceRecordData *record = &records[index];
+        NSDate *date = [NSDate dateWithTimeIntervalSinceReferenceDate:record->time];
+        [dump appendFormat:@"%@ [%@] T%u op %llu: %@\n",
+         [dateFormatter stringFromDate:date], BOXTraceLevelName(record->level), record->threadNumber, record->operationID, BOXTraceEventDescription(record)];
+    }
+    return dump;
+}
+
++ (void)setFailureHandler:(BOXTraceFailureHandler)failureHandler
+{
+    @synchronized(self) {
+        BOXTraceCurrentFailureHandler = [failureHandler copy];
+    }
+}
+
++ (BOXTraceFailureHandler)failureHandler
+{
+    @synchronized(self) {
+        return BOXTraceCurrentFailureHandler;
+    }
+}
+
++ (uint64_t)nextOperationID
+{
+    return atomic_fetch_add_explicit(&BOXTraceLastOperationID, 1, memory_order_relaxed) + 1;
+}
+
++ (void)clear
+{
+    pthread_mutex_lock(&BOXTraceBuffersLock);
+    for (BOXTraceBuffer *buffer = BOXTraceBuffers; buffer != NULL; buffer = buffer->next) {
+        atomic_store_explicit(&buffer->clearedIndex, atomic_load_explicit(&buffer->writeIndex, memory_order_acquire), memory_order_relaxed);
+    }
+    pthread_mutex_unlock(&BOXTraceBuffersLock);
+}
+
+@end
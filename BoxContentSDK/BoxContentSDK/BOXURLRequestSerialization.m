@@ -49,8 +49,34 @@ NSString * BOXPercentEscapedStringFromString(NSString *string) {
     static NSString * const kBOXCharactersGeneralDelimitersToEncode = @":#[]@"; // does not include "?" or "/" due to RFC 3986 - Section 3.4
     static NSString * const kBOXCharactersSubDelimitersToEncode = @"!$&'()*+,;=";
 
-    NSMutableCharacterSet * allowedCharacterSet = [[NSCharacterSet URLQueryAllowedCharacterSet] mutableCopy];
-    [allowedCharacterSet removeCharactersInString:[kBOXCharactersGeneralDelimitersToEncode stringByAppendingString:kBOXCharactersSubDelimitersToEncode]];
+    // Long values, such as the fields parameter, are sent with most requests; their escaped form is kept.
+    static NSUInteger const minimumCachedLength = 64;
+
+    static NSCharacterSet *allowedCharacterSet = nil;
+    static NSCharacterSet *disallowedCharacterSet = nil;
+    static NSCache *escapedStringsByString = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableCharacterSet *mutableAllowedCharacterSet = [[NSCharacterSet URLQueryAllowedCharacterSet] mutableCopy];
+        [mutableAllowedCharacterSet removeCharactersInString:[kBOXCharactersGeneralDelimitersToEncode stringByAppendingString:kBOXCharactersSubDelimitersToEncode]];
+        allowedCharacterSet = [mutableAllowedCharacterSet copy];
+        disallowedCharacterSet = [allowedCharacterSet invertedSet];
+        escapedStringsByString = [[NSCache alloc] init];
+        escapedStringsByString.countLimit = 256;
+    });
+
+    // Most keys and IDs have nothing to escape.
+    if ([string rangeOfCharacterFromSet:disallowedCharacterSet].location == NSNotFound) {
+        return [string copy];
+    }
+
+    BOOL shouldCache = string.length >= minimumCachedLength;
+    if (shouldCache) {
+        NSString *cachedString = [escapedStringsByString objectForKey:string];
+        if (cachedString != nil) {
+            return cachedString;
+        }
+    }
 
 	// FIXME: https://github.com/AFNetworking/AFNetworking/pull/3028
     // return [string stringByAddingPercentEncodingWithAllowedCharacters:allowedCharacterSet];
@@ -77,6 +103,12 @@ NSString * BOXPercentEscapedStringFromString(NSString *string) {
         index += range.length;
     }
 
+    if (shouldCache) {
+        NSString *escapedString = [escaped copy];
+        [escapedStringsByString setObject:escapedString forKey:[string copy]];
+        return escapedString;
+    }
+
 	return escaped;
 }
 
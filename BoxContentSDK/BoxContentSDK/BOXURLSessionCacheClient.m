@@ -9,6 +9,7 @@
 #import "BOXURLSessionCacheClient.h"
 #import "BOXContentSDKConstants.h"
 #import "BOXLog.h"
+#import "BOXMetricsRegistry.h"
 #import "BOXContentSDKErrors.h"
 
 
@@ -455,7 +456,9 @@ backgroundSessionId:(NSString *)backgroundSessionId
                                                 sessionTaskId:sessionTaskId
                                                          type:BOXURLSessionTaskCacheFileTypeResponseData];
     //decrypt data found at filePath
-    return [self unencryptedDataAtFilePath:filePath];
+    NSData *resumeData = [self unencryptedDataAtFilePath:filePath];
+    [[BOXMetricsRegistry sharedRegistry] recordCacheLookupInLayer:BOXMetricsCacheLayerResumeData hit:(resumeData != nil)];
+    return resumeData;
 }
 
 - (NSData *)resumeDataForUserId:(NSString *)userId associateId:(NSString *)associateId
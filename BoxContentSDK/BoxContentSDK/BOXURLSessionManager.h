@@ -38,6 +38,14 @@ NS_ASSUME_NONNULL_BEGIN
  */
 - (void)sessionTask:(NSURLSessionTask *)sessionTask processIntermediateData:(NSData *)data;
 
+/**
+ * To be called once the loading system collected the metrics of the task, before the task finishes. Only called on
+ * iOS 10 and later.
+ *
+ * @param metrics   The metrics of the task, one transaction per request and redirect
+ */
+- (void)sessionTask:(NSURLSessionTask *)sessionTask didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0));
+
 @end
 
 
@@ -77,6 +85,17 @@ totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend;
 @protocol BOXURLSessionManagerDelegate <BOXURLSessionCacheClientDelegate>
 @end
 
+/**
+ * Classes of foreground traffic. Each class has its own NSURLSession, and so its own connection pool,
+ * configured for the kind of requests it carries.
+ */
+typedef NS_ENUM(NSUInteger, BOXURLSessionTrafficClass) {
+    BOXURLSessionTrafficClassAPI = 0,
+    BOXURLSessionTrafficClassAuth,
+    BOXURLSessionTrafficClassUpload,
+    BOXURLSessionTrafficClassDownload,
+};
+
 /**
  This class is responsible for creating different NSURLSessionTask
  */
@@ -131,6 +150,28 @@ totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend;
 - (void)reconnectWithBackgroundSessionIdFromExtension:(NSString *)backgroundSessionId
                                            completion:(nullable void (^)(NSError * _Nullable error))completionBlock;
 
+/**
+ * Sets the base URL requests of a traffic class go to, which is the host prewarm connects to.
+ * Data tasks whose URL starts with the auth base URL run on the auth session. A class without a base URL,
+ * such as downloads that are redirected to content servers, is not prewarmed.
+ */
+- (void)setBaseURL:(nullable NSURL *)baseURL forTrafficClass:(BOXURLSessionTrafficClass)trafficClass;
+- (nullable NSURL *)baseURLForTrafficClass:(BOXURLSessionTrafficClass)trafficClass;
+
+/**
+ * Whether prewarm opens connections. The default is NO, so that no request is sent that the app did not ask for.
+ */
+@property (nonatomic, readwrite, assign) BOOL prewarmsConnections;
+
+/**
+ * Opens connections to the base URL host of each traffic class ahead of the first request, so that it
+ * does not pay for DNS, TCP and TLS. Hosts prewarmed in the last 30 seconds are skipped, and nothing is
+ * sent unless prewarmsConnections is YES.
+ * Called when the app returns to the foreground and after requests fail because the network went away;
+ * apps that monitor network changes can call it when the path changes.
+ */
+- (void)prewarm;
+
 /**
  Create a NSURLSessionDataTask which does not need to be run in background,
  and its completionHandler will be called upon completion of the task
@@ -138,6 +179,15 @@ totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend;
 - (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
                             completionHandler:(void (^)(NSData * data, NSURLResponse * response, NSError * error))completionHandler;
 
+/**
+ Create a NSURLSessionDataTask which does not need to be run in background, and its completionHandler will be called
+ upon completion of the task. taskDelegate is sent the optional messages that do not carry the response, such as
+ sessionTask:didFinishCollectingMetrics:, and never sessionTask:didFinishWithResponse:responseData:error:.
+ */
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                 taskDelegate:(nullable id <BOXURLSessionTaskDelegate>)taskDelegate
+                            completionHandler:(void (^)(NSData * data, NSURLResponse * response, NSError * error))completionHandler;
+
 /**
  Create a NSURLSessionDataTask which can be run in foreground to download data
  */
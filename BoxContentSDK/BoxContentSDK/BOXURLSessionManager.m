@@ -9,6 +9,25 @@
 #import "BOXURLSessionManager.h"
 #import "BOXLog.h"
 #import "BOXContentSDKErrors.h"
+#import <UIKit/UIKit.h>
+
+#define BOX_URL_SESSION_TRAFFIC_CLASS_COUNT (4)
+
+// Connections per host. With HTTP/2, which Box hosts negotiate, requests to a host are multiplexed over one
+// connection and these only matter when falling back to HTTP/1.1.
+#define BOX_URL_SESSION_API_MAX_CONNECTIONS_PER_HOST (6)
+#define BOX_URL_SESSION_AUTH_MAX_CONNECTIONS_PER_HOST (2)
+#define BOX_URL_SESSION_UPLOAD_MAX_CONNECTIONS_PER_HOST (4)
+#define BOX_URL_SESSION_DOWNLOAD_MAX_CONNECTIONS_PER_HOST (6)
+
+// Idle timeouts, in seconds. Token requests gate every other request, so they fail fast and get retried.
+#define BOX_URL_SESSION_API_REQUEST_TIMEOUT (60.0)
+#define BOX_URL_SESSION_AUTH_REQUEST_TIMEOUT (30.0)
+#define BOX_URL_SESSION_TRANSFER_REQUEST_TIMEOUT (120.0)
+
+// A host is not prewarmed again within this many seconds.
+#define BOX_URL_SESSION_PREWARM_MIN_INTERVAL (30.0)
+#define BOX_URL_SESSION_PREWARM_REQUEST_TIMEOUT (10.0)
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -59,12 +78,17 @@ NS_ASSUME_NONNULL_BEGIN
 
 @interface BOXURLSessionManager() <NSURLSessionDataDelegate, NSURLSessionDownloadDelegate, NSURLSessionStreamDelegate>
 
-//Default NSURLSession to be used by NSURLSessionTask which does not need to be run in the background
-@property (nonatomic, readwrite, strong) NSURLSession *defaultSession;
-
-//Progress NSURLSession to be used by NSURLSessionTask which needs progress reporting during the life of the tasks
+//Foreground NSURLSessions indexed by BOXURLSessionTrafficClass, each with its own connection pool.
+//API and auth sessions are used by NSURLSessionTask which does not need to be run in the background.
+//Upload and download sessions are used by NSURLSessionTask which needs progress reporting during the life of the tasks
 //but does not need to be in the background. e.g. non-background download, upload tasks
-@property (nonatomic, readwrite, strong) NSURLSession *progressSession;
+@property (nonatomic, readonly, strong) NSArray<NSURLSession *> *foregroundSessions;
+
+//Base URLs requests of each traffic class go to, keyed by BOXURLSessionTrafficClass. Guarded by @synchronized(self.baseURLs)
+@property (nonatomic, readonly, strong) NSMutableDictionary<NSNumber *, NSURL *> *baseURLs;
+
+//When each traffic class was last prewarmed, keyed by BOXURLSessionTrafficClass. Guarded by @synchronized(self.baseURLs)
+@property (nonatomic, readonly, strong) NSMutableDictionary<NSNumber *, NSDate *> *lastPrewarmDates;
 
 //Background NSURLSession to be used by downloads/uploads which needs to be run in the background even if app terminates
 @property (nonatomic, readwrite, strong) NSURLSession *backgroundSession;
@@ -75,8 +99,15 @@ NS_ASSUME_NONNULL_BEGIN
 @property (nonatomic, strong, readwrite) id<BOXURLSessionManagerDelegate> defaultDelegate;
 
 //a map to associate a progress session' task to its delegate
+//keyed by the task itself, as the upload and download sessions number their tasks independently
 //during session/task's delegate callbacks, we call appropriate methods on task delegate
-@property (nonatomic, readonly, strong) NSMapTable<NSNumber *, id<BOXURLSessionTaskDelegate>> *progressSessionTaskIdToTaskDelegate;
+@property (nonatomic, readonly, strong) NSMapTable<NSURLSessionTask *, id<BOXURLSessionTaskDelegate>> *progressSessionTaskToTaskDelegate;
+
+//a map to associate a data task that reports through its completion handler to its delegate
+//the loading system still sends task-level messages such as metrics to the session delegate for these tasks, but never
+//URLSession:task:didCompleteWithError:, so they are kept apart from progress tasks to only be finished once
+//entries are removed when the completion handler runs. Guarded by @synchronized(self.completionHandlerSessionTaskToTaskDelegate)
+@property (nonatomic, readonly, strong) NSMapTable<NSURLSessionTask *, id<BOXURLSessionTaskDelegate>> *completionHandlerSessionTaskToTaskDelegate;
 
 //a map to associate a background session to its session task and session task delegate
 //there can be more than one background session at a time as an app takes over background sessions created from app extensions
@@ -105,7 +136,8 @@ static NSString *backgroundSessionIdentifierForMainApp = @"com.box.BOXURLSession
 
 @implementation BOXURLSessionManager
 
-@synthesize progressSessionTaskIdToTaskDelegate = _progressSessionTaskIdToTaskDelegate;
+@synthesize progressSessionTaskToTaskDelegate = _progressSessionTaskToTaskDelegate;
+@synthesize completionHandlerSessionTaskToTaskDelegate = _completionHandlerSessionTaskToTaskDelegate;
 @synthesize backgroundSessionIdToSessionTask = _backgroundSessionIdToSessionTask;
 
 + (BOXURLSessionManager *)sharedInstance
@@ -129,56 +161,92 @@ static NSString *backgroundSessionIdentifierForMainApp = @"com.box.BOXURLSession
     self = [super init];
     if (self != nil) {
         _protocolClasses = protocolClasses;
-        _progressSessionTaskIdToTaskDelegate = [NSMapTable strongToWeakObjectsMapTable];
+        _progressSessionTaskToTaskDelegate = [NSMapTable strongToWeakObjectsMapTable];
+        _completionHandlerSessionTaskToTaskDelegate = [NSMapTable strongToWeakObjectsMapTable];
         _backgroundSessionIdToSessionTask = [NSMutableDictionary new];
         _backgroundSessionIdToSession = [NSMutableDictionary new];
-        [self createDefaultSession];
-        [self createProgressSession];
+        _baseURLs = [NSMutableDictionary new];
+        _lastPrewarmDates = [NSMutableDictionary new];
+        _foregroundSessions = @[[self createForegroundSessionForTrafficClass:BOXURLSessionTrafficClassAPI],
+                                [self createForegroundSessionForTrafficClass:BOXURLSessionTrafficClassAuth],
+                                [self createForegroundSessionForTrafficClass:BOXURLSessionTrafficClassUpload],
+                                [self createForegroundSessionForTrafficClass:BOXURLSessionTrafficClassDownload]];
         _didFinishSettingUpBackgroundSession = NO;
+
+        // Idle connections are usually gone after the app was in the background, or the network changed meanwhile.
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationWillEnterForeground:)
+                                                     name:UIApplicationWillEnterForegroundNotification
+                                                   object:nil];
     }
     
     return self;
 }
 
-- (NSURLSession *)createDefaultSession
+- (void)dealloc
 {
-    if (_defaultSession == nil) {
-        //FIXME: revisit configuration for url session and its operation queue
-        //arbitrary maxConcurrentOperationCount given that the number should not go above
-        //the max number of concurrent Box api operations
-        NSURLSessionConfiguration *sessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
-        if (self.protocolClasses != nil) {
-            sessionConfig.protocolClasses = [self.protocolClasses arrayByAddingObjectsFromArray:sessionConfig.protocolClasses];
-        }
-        NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-        queue.name = @"com.box.BOXURLSessionManager.default";
-        queue.maxConcurrentOperationCount = NSOperationQueueDefaultMaxConcurrentOperationCount;
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
 
-        _defaultSession = [NSURLSession sessionWithConfiguration:sessionConfig delegate:nil delegateQueue:queue];
++ (NSURLSessionConfiguration *)sessionConfigurationForTrafficClass:(BOXURLSessionTrafficClass)trafficClass
+{
+    NSURLSessionConfiguration *sessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
+    switch (trafficClass) {
+        case BOXURLSessionTrafficClassAPI:
+            sessionConfig.HTTPMaximumConnectionsPerHost = BOX_URL_SESSION_API_MAX_CONNECTIONS_PER_HOST;
+            sessionConfig.timeoutIntervalForRequest = BOX_URL_SESSION_API_REQUEST_TIMEOUT;
+            break;
+        case BOXURLSessionTrafficClassAuth:
+            sessionConfig.HTTPMaximumConnectionsPerHost = BOX_URL_SESSION_AUTH_MAX_CONNECTIONS_PER_HOST;
+            sessionConfig.timeoutIntervalForRequest = BOX_URL_SESSION_AUTH_REQUEST_TIMEOUT;
+            sessionConfig.URLCache = nil;
+            break;
+        case BOXURLSessionTrafficClassUpload:
+            sessionConfig.HTTPMaximumConnectionsPerHost = BOX_URL_SESSION_UPLOAD_MAX_CONNECTIONS_PER_HOST;
+            sessionConfig.timeoutIntervalForRequest = BOX_URL_SESSION_TRANSFER_REQUEST_TIMEOUT;
+            sessionConfig.URLCache = nil;
+            break;
+        case BOXURLSessionTrafficClassDownload:
+            sessionConfig.HTTPMaximumConnectionsPerHost = BOX_URL_SESSION_DOWNLOAD_MAX_CONNECTIONS_PER_HOST;
+            sessionConfig.timeoutIntervalForRequest = BOX_URL_SESSION_TRANSFER_REQUEST_TIMEOUT;
+            // File contents are cached by the app if at all, not by NSURLCache.
+            sessionConfig.URLCache = nil;
+            break;
     }
-    
-    return _defaultSession;
+    return sessionConfig;
 }
 
-- (NSURLSession *)createProgressSession
+- (NSURLSession *)createForegroundSessionForTrafficClass:(BOXURLSessionTrafficClass)trafficClass
 {
-    if (_progressSession == nil) {
-        //FIXME: revisit configuration for url session and its operation queue
-        //arbitrary maxConcurrentOperationCount given that the number should not go above
-        //the max number of concurrent Box api operations
-        NSURLSessionConfiguration *sessionConfig = [NSURLSessionConfiguration defaultSessionConfiguration];
-        
-        if (self.protocolClasses != nil) {
-            sessionConfig.protocolClasses = [self.protocolClasses arrayByAddingObjectsFromArray:sessionConfig.protocolClasses];
-        }
-        NSOperationQueue *queue = [[NSOperationQueue alloc] init];
-        queue.name = @"com.box.BOXURLSessionManager.progress";
-        queue.maxConcurrentOperationCount = 40;
+    NSURLSessionConfiguration *sessionConfig = [[self class] sessionConfigurationForTrafficClass:trafficClass];
+    if (self.protocolClasses != nil) {
+        sessionConfig.protocolClasses = [self.protocolClasses arrayByAddingObjectsFromArray:sessionConfig.protocolClasses];
+    }
 
-        _progressSession = [NSURLSession sessionWithConfiguration:sessionConfig delegate:self delegateQueue:queue];
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    switch (trafficClass) {
+        case BOXURLSessionTrafficClassAPI:
+        case BOXURLSessionTrafficClassAuth:
+            //tasks report through their completion handler, and their metrics to their task delegate through this manager
+            queue.name = (trafficClass == BOXURLSessionTrafficClassAPI ? @"com.box.BOXURLSessionManager.default" : @"com.box.BOXURLSessionManager.auth");
+            queue.maxConcurrentOperationCount = NSOperationQueueDefaultMaxConcurrentOperationCount;
+            break;
+        case BOXURLSessionTrafficClassUpload:
+        case BOXURLSessionTrafficClassDownload:
+            //tasks report progress to their task delegate, through this manager
+            //arbitrary maxConcurrentOperationCount given that the number should not go above
+            //the max number of concurrent Box api operations
+            queue.name = (trafficClass == BOXURLSessionTrafficClassUpload ? @"com.box.BOXURLSessionManager.upload" : @"com.box.BOXURLSessionManager.download");
+            queue.maxConcurrentOperationCount = 40;
+            break;
     }
-    
-    return _progressSession;
+
+    return [NSURLSession sessionWithConfiguration:sessionConfig delegate:self delegateQueue:queue];
+}
+
+- (NSURLSession *)foregroundSessionForTrafficClass:(BOXURLSessionTrafficClass)trafficClass
+{
+    return self.foregroundSessions[trafficClass];
 }
 
 - (NSURLSession *)createBackgroundSessionWithId:(NSString *)backgroundSessionIdentifier
@@ -396,8 +464,8 @@ static NSString *backgroundSessionIdentifierForMainApp = @"com.box.BOXURLSession
     NSUInteger sessionTaskId = sessionTask.taskIdentifier;
 
     if (sessionId == nil) {
-        @synchronized (self.progressSessionTaskIdToTaskDelegate) {
-            [self.progressSessionTaskIdToTaskDelegate setObject:taskDelegate forKey:@(sessionTaskId)];
+        @synchronized (self.progressSessionTaskToTaskDelegate) {
+            [self.progressSessionTaskToTaskDelegate setObject:taskDelegate forKey:sessionTask];
         }
     } else {
         if (self.backgroundSessionIdToSessionTask[sessionId] == nil) {
@@ -414,28 +482,140 @@ static NSString *backgroundSessionIdentifierForMainApp = @"com.box.BOXURLSession
     }
 }
 
-- (void)deassociateSessionId:(NSString *)sessionId sessionTaskId:(NSUInteger)sessionTaskId
+- (void)deassociateSessionId:(nullable NSString *)sessionId sessionTask:(NSURLSessionTask *)sessionTask
 {
     if (sessionId == nil) {
-        @synchronized (self.progressSessionTaskIdToTaskDelegate) {
-            [self.progressSessionTaskIdToTaskDelegate removeObjectForKey:@(sessionTaskId)];
+        @synchronized (self.progressSessionTaskToTaskDelegate) {
+            [self.progressSessionTaskToTaskDelegate removeObjectForKey:sessionTask];
         }
     } else {
-        @synchronized (self.backgroundSessionIdToSessionTask[sessionId]) {
-            [self.backgroundSessionIdToSessionTask[sessionId] removeObjectForKey:@(sessionTaskId)];
+        [self deassociateSessionId:sessionId sessionTaskId:sessionTask.taskIdentifier];
+    }
+}
+
+//background sessions only
+- (void)deassociateSessionId:(NSString *)sessionId sessionTaskId:(NSUInteger)sessionTaskId
+{
+    @synchronized (self.backgroundSessionIdToSessionTask[sessionId]) {
+        [self.backgroundSessionIdToSessionTask[sessionId] removeObjectForKey:@(sessionTaskId)];
+    }
+}
+
+#pragma mark - Traffic classes and prewarming
+
+- (void)setBaseURL:(nullable NSURL *)baseURL forTrafficClass:(BOXURLSessionTrafficClass)trafficClass
+{
+    @synchronized (self.baseURLs) {
+        // A new host has not been prewarmed yet, whatever was done for the previous one.
+        if (![baseURL.host isEqualToString:self.baseURLs[@(trafficClass)].host]) {
+            [self.lastPrewarmDates removeObjectForKey:@(trafficClass)];
+        }
+        self.baseURLs[@(trafficClass)] = baseURL;
+    }
+}
+
+- (nullable NSURL *)baseURLForTrafficClass:(BOXURLSessionTrafficClass)trafficClass
+{
+    @synchronized (self.baseURLs) {
+        return self.baseURLs[@(trafficClass)];
+    }
+}
+
+- (BOXURLSessionTrafficClass)trafficClassForDataTaskRequest:(NSURLRequest *)request
+{
+    NSString *authBaseURLString = [self baseURLForTrafficClass:BOXURLSessionTrafficClassAuth].absoluteString;
+    if (authBaseURLString.length > 0 && [request.URL.absoluteString hasPrefix:authBaseURLString]) {
+        return BOXURLSessionTrafficClassAuth;
+    }
+    return BOXURLSessionTrafficClassAPI;
+}
+
+- (void)prewarm
+{
+    if (!self.prewarmsConnections) {
+        return;
+    }
+
+    NSDate *now = [NSDate date];
+    for (NSUInteger trafficClass = 0; trafficClass < BOX_URL_SESSION_TRAFFIC_CLASS_COUNT; trafficClass++) {
+        NSURL *baseURL = nil;
+        @synchronized (self.baseURLs) {
+            baseURL = self.baseURLs[@(trafficClass)];
+            NSDate *lastPrewarmDate = self.lastPrewarmDates[@(trafficClass)];
+            if (baseURL.host == nil || (lastPrewarmDate != nil && [now timeIntervalSinceDate:lastPrewarmDate] < BOX_URL_SESSION_PREWARM_MIN_INTERVAL)) {
+                continue;
+            }
+            self.lastPrewarmDates[@(trafficClass)] = now;
         }
+
+        // Any answer will do, the connection stays in the session's pool for the requests that follow.
+        NSURLComponents *components = [[NSURLComponents alloc] init];
+        components.scheme = baseURL.scheme;
+        components.host = baseURL.host;
+        components.port = baseURL.port;
+        components.path = @"/";
+        NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:components.URL
+                                                               cachePolicy:NSURLRequestReloadIgnoringLocalCacheData
+                                                           timeoutInterval:BOX_URL_SESSION_PREWARM_REQUEST_TIMEOUT];
+        request.HTTPMethod = @"HEAD";
+
+        NSURLSession *session = [self foregroundSessionForTrafficClass:trafficClass];
+        NSURLSessionDataTask *task = [session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+            if (error != nil) {
+                BOXLog(@"failed to prewarm connection to %@ due to %@", request.URL.host, error);
+            }
+        }];
+        [task resume];
+    }
+}
+
+- (void)prewarmIfNetworkChangedWithError:(nullable NSError *)error
+{
+    if ([error.domain isEqualToString:NSURLErrorDomain] &&
+        (error.code == NSURLErrorNetworkConnectionLost || error.code == NSURLErrorNotConnectedToInternet)) {
+        [self prewarm];
     }
 }
 
+- (void)applicationWillEnterForeground:(NSNotification *)notification
+{
+    [self prewarm];
+}
+
+- (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                            completionHandler:(void (^)(NSData * data, NSURLResponse * response, NSError * error))completionHandler
+{
+    return [self dataTaskWithRequest:request taskDelegate:nil completionHandler:completionHandler];
+}
+
 - (NSURLSessionDataTask *)dataTaskWithRequest:(NSURLRequest *)request
+                                 taskDelegate:(nullable id <BOXURLSessionTaskDelegate>)taskDelegate
                             completionHandler:(void (^)(NSData * data, NSURLResponse * response, NSError * error))completionHandler
 {
-    return [self.defaultSession dataTaskWithRequest:request completionHandler:completionHandler];
+    NSURLSession *session = [self foregroundSessionForTrafficClass:[self trafficClassForDataTaskRequest:request]];
+    __block __weak NSURLSessionDataTask *weakTask = nil;
+    NSURLSessionDataTask *task = [session dataTaskWithRequest:request completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        NSURLSessionDataTask *strongTask = weakTask;
+        if (strongTask != nil) {
+            @synchronized (self.completionHandlerSessionTaskToTaskDelegate) {
+                [self.completionHandlerSessionTaskToTaskDelegate removeObjectForKey:strongTask];
+            }
+        }
+        [self prewarmIfNetworkChangedWithError:error];
+        completionHandler(data, response, error);
+    }];
+    if (taskDelegate != nil) {
+        weakTask = task;
+        @synchronized (self.completionHandlerSessionTaskToTaskDelegate) {
+            [self.completionHandlerSessionTaskToTaskDelegate setObject:taskDelegate forKey:task];
+        }
+    }
+    return task;
 }
 
 - (NSURLSessionDataTask *)foregroundDownloadTaskWithRequest:(NSURLRequest *)request taskDelegate:(id <BOXURLSessionDownloadTaskDelegate>)taskDelegate
 {
-    NSURLSessionDataTask *task = [self.progressSession dataTaskWithRequest:request];
+    NSURLSessionDataTask *task = [[self foregroundSessionForTrafficClass:BOXURLSessionTrafficClassDownload] dataTaskWithRequest:request];
     [self associateProgressSessionTask:task withTaskDelegate:taskDelegate];
     
     return task;
@@ -443,7 +623,7 @@ static NSString *backgroundSessionIdentifierForMainApp = @"com.box.BOXURLSession
 
 - (NSURLSessionUploadTask *)foregroundUploadTaskWithStreamedRequest:(NSURLRequest *)request taskDelegate:(id <BOXURLSessionUploadTaskDelegate>)taskDelegate
 {
-    NSURLSessionUploadTask *task = [self.progressSession uploadTaskWithStreamedRequest:request];
+    NSURLSessionUploadTask *task = [[self foregroundSessionForTrafficClass:BOXURLSessionTrafficClassUpload] uploadTaskWithStreamedRequest:request];
     [self associateProgressSessionTask:task withTaskDelegate:taskDelegate];
     
     return task;
@@ -760,18 +940,24 @@ static NSString *backgroundSessionIdentifierForMainApp = @"com.box.BOXURLSession
                                    error:error];
 }
 
-- (id<BOXURLSessionTaskDelegate>)taskDelegateForSessionId:(NSString *)sessionId sessionTaskId:(NSUInteger)sessionTaskId
+- (id<BOXURLSessionTaskDelegate>)taskDelegateForSessionId:(nullable NSString *)sessionId sessionTask:(NSURLSessionTask *)sessionTask
 {
-    id<BOXURLSessionTaskDelegate> taskDelegate = nil;
-    
     if (sessionId == nil) {
-        @synchronized (self.progressSessionTaskIdToTaskDelegate) {
-            taskDelegate = [self.progressSessionTaskIdToTaskDelegate objectForKey:@(sessionTaskId)];
+        @synchronized (self.progressSessionTaskToTaskDelegate) {
+            return [self.progressSessionTaskToTaskDelegate objectForKey:sessionTask];
         }
     } else {
-        @synchronized (self.backgroundSessionIdToSessionTask[sessionId]) {
-            taskDelegate = [[self.backgroundSessionIdToSessionTask[sessionId] objectForKey:@(sessionTaskId)] delegate];
-        }
+        return [self taskDelegateForSessionId:sessionId sessionTaskId:sessionTask.taskIdentifier];
+    }
+}
+
+//background sessions only
+- (id<BOXURLSessionTaskDelegate>)taskDelegateForSessionId:(NSString *)sessionId sessionTaskId:(NSUInteger)sessionTaskId
+{
+    id<BOXURLSessionTaskDelegate> taskDelegate = nil;
+    
+    @synchronized (self.backgroundSessionIdToSessionTask[sessionId]) {
+        taskDelegate = [[self.backgroundSessionIdToSessionTask[sessionId] objectForKey:@(sessionTaskId)] delegate];
     }
     
     return taskDelegate;
@@ -864,7 +1050,7 @@ didFinishDownloadingToURL:(NSURL *)location
             // File was downloaded into a temporary location, retrieve destinationFilePath to move the downloaded file into
             // If taskDelegate exists, retrieve destinationFilePath from it, else retrieve from cache
 
-            id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTaskId:downloadTask.taskIdentifier];
+            id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTask:downloadTask];
             NSString *destinationFilePath = nil;
 
             if ([taskDelegate conformsToProtocol:@protocol(BOXURLSessionDownloadTaskDelegate)] && [taskDelegate respondsToSelector:@selector(destinationFilePath)]) {
@@ -889,7 +1075,7 @@ didFinishDownloadingToURL:(NSURL *)location
 totalBytesExpectedToWrite:(int64_t)totalBytesExpectedToWrite
 {
     //this method is only called by foreground session tasks, call its taskDelegate to handle
-    id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTaskId:downloadTask.taskIdentifier];
+    id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTask:downloadTask];
 
     if ([taskDelegate conformsToProtocol:@protocol(BOXURLSessionDownloadTaskDelegate)]) {
         id<BOXURLSessionDownloadTaskDelegate> downloadTaskDelegate = (id<BOXURLSessionDownloadTaskDelegate>)taskDelegate;
@@ -916,7 +1102,7 @@ didReceiveResponse:(NSURLResponse *)response
  completionHandler:(void (^)(NSURLSessionResponseDisposition disposition))completionHandler
 {
     //this method is only called by foreground session tasks, call its taskDelegate to handle
-    id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTaskId:dataTask.taskIdentifier];
+    id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTask:dataTask];
 
     if ([taskDelegate respondsToSelector:@selector(sessionTask:processIntermediateResponse:)]) {
         [taskDelegate sessionTask:dataTask processIntermediateResponse:response];
@@ -946,7 +1132,7 @@ didReceiveResponse:(NSURLResponse *)response
         }
     } else {
         //for foreground tasks, call its taskDelegate to handle
-        id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTaskId:dataTask.taskIdentifier];
+        id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTask:dataTask];
         if ([taskDelegate respondsToSelector:@selector(sessionTask:processIntermediateData:)]) {
             [taskDelegate sessionTask:dataTask processIntermediateData:data];
         }
@@ -964,7 +1150,7 @@ didReceiveResponse:(NSURLResponse *)response
 totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
 {
     //this method is only called by foreground session tasks, call its taskDelegate to handle
-    id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTaskId:task.taskIdentifier];
+    id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTask:task];
 
     if ([taskDelegate conformsToProtocol:@protocol(BOXURLSessionUploadTaskDelegate)]) {
         id<BOXURLSessionUploadTaskDelegate> uploadTaskDelegate = (id<BOXURLSessionUploadTaskDelegate>)taskDelegate;
@@ -974,6 +1160,25 @@ totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
     }
 }
 
+/* Sent when complete statistics information has been collected for the task.
+ * Sent before URLSession:task:didCompleteWithError:.
+ */
+- (void)URLSession:(NSURLSession *)session task:(NSURLSessionTask *)task didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0))
+{
+    id<BOXURLSessionTaskDelegate> taskDelegate = nil;
+    if (session.configuration.identifier == nil) {
+        @synchronized (self.completionHandlerSessionTaskToTaskDelegate) {
+            taskDelegate = [self.completionHandlerSessionTaskToTaskDelegate objectForKey:task];
+        }
+    }
+    if (taskDelegate == nil) {
+        taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTask:task];
+    }
+    if ([taskDelegate respondsToSelector:@selector(sessionTask:didFinishCollectingMetrics:)]) {
+        [taskDelegate sessionTask:task didFinishCollectingMetrics:metrics];
+    }
+}
+
 /* Sent as the last message related to a specific task.  Error may be
  * nil, which implies that no error occurred and this task is complete.
  */
@@ -1017,11 +1222,13 @@ totalBytesExpectedToSend:(int64_t)totalBytesExpectedToSend
     } else {
         //foreground session task finishes, notify its taskDelegate accordingly
 
-        id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTaskId:task.taskIdentifier];
+        id<BOXURLSessionTaskDelegate> taskDelegate = [self taskDelegateForSessionId:session.configuration.identifier sessionTask:task];
         [taskDelegate sessionTask:task didFinishWithResponse:task.response responseData:nil error:error];
+
+        [self prewarmIfNetworkChangedWithError:error];
     }
     
-    [self deassociateSessionId:session.configuration.identifier sessionTaskId:task.taskIdentifier];
+    [self deassociateSessionId:session.configuration.identifier sessionTask:task];
 }
 
 /* Sent if a task requires a new, unopened body stream.  This may be
@@ -12,4 +12,7 @@
 // Currently used by test cases to control the expected responses/data for API requests without reaching the server
 - (_Nullable id)initWithProtocolClasses:(NSArray * _Nullable)protocolClasses;
 
+// The foreground NSURLSession requests of trafficClass run on
+- (NSURLSession * _Nonnull)foregroundSessionForTrafficClass:(BOXURLSessionTrafficClass)trafficClass;
+
 @end
@@ -0,0 +1,16 @@
+//
+//  NSData+BOXContentSDKAdditions.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@interface NSData (BOXContentSDKAdditions)
+
+/**
+ *  @return The data compressed in the gzip format, suitable for a "Content-Encoding: gzip" body,
+ *  or nil if it could not be compressed.
+ */
+- (NSData *)box_gzipCompressedData;
+
+@end
@@ -0,0 +1,44 @@
+//
+//  NSData+BOXContentSDKAdditions.m
+//  BoxContentSDK
+//
+
+#import "NSData+BOXContentSDKAdditions.h"
+#import <zlib.h>
+
+// 15 bits of window, plus 16 to have zlib write a gzip header and trailer instead of a zlib one.
+#define BOX_GZIP_WINDOW_BITS (15 + 16)
+#define BOX_GZIP_MEMORY_LEVEL (8)
+
+@implementation NSData (BOXContentSDKAdditions)
+
+- (NSData *)box_gzipCompressedData
+{
+    if (self.length > UINT_MAX) {
+        return nil;
+    }
+
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, BOX_GZIP_WINDOW_BITS, BOX_GZIP_MEMORY_LEVEL, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return nil;
+    }
+
+    // deflateBound is enough for the whole output, so a single call to deflate finishes the stream.
+    NSMutableData *compressedData = [NSMutableData dataWithLength:deflateBound(&stream, (uLong)self.length)];
+    stream.next_in = (Bytef *)self.bytes;
+    stream.avail_in = (uInt)self.length;
+    stream.next_out = compressedData.mutableBytes;
+    stream.avail_out = (uInt)compressedData.length;
+
+    int result = deflate(&stream, Z_FINISH);
+    deflateEnd(&stream);
+    if (result != Z_STREAM_END) {
+        return nil;
+    }
+
+    compressedData.length = stream.total_out;
+    return compressedData;
+}
+
+@end
@@ -10,6 +10,12 @@
 
 @class BOXEventsRequest;
 @class BOXEventsAdminLogsRequest;
+@class BOXEventsRealtimeServerRequest;
+@class BOXEventsLongPollRequest;
+@class BOXEventsRealtimeMonitor;
+@class BOXRealtimeServer;
+@class BOXEventsAdminLogsExporter;
+@protocol BOXEventsExportSink;
 
 @interface BOXContentClient(EventAPI)
 
@@ -27,4 +33,46 @@
  */
 - (BOXEventsAdminLogsRequest *)eventsRequestForEnterprise;
 
+/**
+ *  Generate a request to retrieve the long-poll server for realtime notifications on the event stream.
+ *
+ *  @return A request that can be customized and then executed.
+ */
+- (BOXEventsRealtimeServerRequest *)eventsRealtimeServerRequest;
+
+/**
+ *  Generate a request that waits on a realtime server for changes past a position in the event stream.
+ *
+ *  @param realtimeServer The server returned by an events realtime server request.
+ *  @param streamPosition The position in the event stream to wait for changes from.
+ *
+ *  @return A request that can be customized and then executed.
+ */
+- (BOXEventsLongPollRequest *)eventsLongPollRequestWithRealtimeServer:(BOXRealtimeServer *)realtimeServer
+                                                       streamPosition:(NSString *)streamPosition;
+
+/**
+ *  Create a monitor that delivers new events for the current user as soon as they happen, using
+ *  long-poll notifications. The monitor has to be started.
+ *
+ *  @param streamPosition The position in the event stream to start from. Pass nil to only receive new events.
+ *
+ *  @return A monitor that can be customized and then started.
+ */
+- (BOXEventsRealtimeMonitor *)eventsRealtimeMonitorWithStreamPosition:(NSString *)streamPosition;
+
+/**
+ *  Create an exporter that writes the enterprise admin logs of a date range to a sink, fetching
+ *  several time windows of the range concurrently. The user must be an administrator to perform this.
+ *
+ *  @param createdAfterDate  Start of the range to export.
+ *  @param createdBeforeDate End of the range to export.
+ *  @param sink              Destination of the exported events, e.g. a BOXEventsNDJSONFileSink.
+ *
+ *  @return An exporter that can be customized and then started.
+ */
+- (BOXEventsAdminLogsExporter *)eventsAdminLogsExporterWithCreatedAfterDate:(NSDate *)createdAfterDate
+                                                          createdBeforeDate:(NSDate *)createdBeforeDate
+                                                                       sink:(id<BOXEventsExportSink>)sink;
+
 @end
@@ -9,6 +9,10 @@
 #import "BOXContentClient+Event.h"
 #import "BOXEventsRequest.h"
 #import "BOXEventsAdminLogsRequest.h"
+#import "BOXEventsRealtimeServerRequest.h"
+#import "BOXEventsLongPollRequest.h"
+#import "BOXEventsRealtimeMonitor.h"
+#import "BOXEventsAdminLogsExporter.h"
 #import "BOXContentClient_Private.h"
 
 @implementation BOXContentClient(EventAPI)
@@ -29,4 +33,37 @@
     return request;
 }
 
+- (BOXEventsRealtimeServerRequest *)eventsRealtimeServerRequest
+{
+    BOXEventsRealtimeServerRequest *request = [[BOXEventsRealtimeServerRequest alloc] init];
+    [self prepareRequest:request];
+
+    return request;
+}
+
+- (BOXEventsLongPollRequest *)eventsLongPollRequestWithRealtimeServer:(BOXRealtimeServer *)realtimeServer
+                                                       streamPosition:(NSString *)streamPosition
+{
+    BOXEventsLongPollRequest *request = [[BOXEventsLongPollRequest alloc] initWithRealtimeServer:realtimeServer
+                                                                                  streamPosition:streamPosition];
+    [self prepareRequest:request];
+
+    return request;
+}
+
+- (BOXEventsRealtimeMonitor *)eventsRealtimeMonitorWithStreamPosition:(NSString *)streamPosition
+{
+    return [[BOXEventsRealtimeMonitor alloc] initWithClient:self streamPosition:streamPosition];
+}
+
+- (BOXEventsAdminLogsExporter *)eventsAdminLogsExporterWithCreatedAfterDate:(NSDate *)createdAfterDate
+                                                          createdBeforeDate:(NSDate *)createdBeforeDate
+                                                                       sink:(id<BOXEventsExportSink>)sink
+{
+    return [[BOXEventsAdminLogsExporter alloc] initWithClient:self
+                                             createdAfterDate:createdAfterDate
+                                            createdBeforeDate:createdBeforeDate
+                                                         sink:sink];
+}
+
 @end
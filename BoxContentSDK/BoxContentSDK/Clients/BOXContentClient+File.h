@@ -332,7 +332,7 @@
  */
 - (BOXPreflightCheckRequest *)fileUploadPreflightCheckRequestForNewFileInFolderWithID:(NSString *)folderID
                                                                                  name:(NSString *)fileName
-                                                                                 size:(NSUInteger)fileSize;
+                                                                                 size:(unsigned long long)fileSize;
 
 /**
  *  Generate a request to do a "preflight" check to determine whether replacing a file with a new version is possible. You can use this
@@ -347,7 +347,7 @@
  */
 - (BOXPreflightCheckRequest *)fileUploadPreflightCheckRequestForNewFileVersionWithID:(NSString *)fileID
                                                                                 name:(NSString *)fileName
-                                                                                size:(NSUInteger)fileSize;
+                                                                                size:(unsigned long long)fileSize;
 
 /**
  *  Generate a request to download a given representation of a file to a local filepath.
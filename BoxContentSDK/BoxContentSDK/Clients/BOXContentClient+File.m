@@ -212,7 +212,7 @@
 
 - (BOXPreflightCheckRequest *)fileUploadPreflightCheckRequestForNewFileInFolderWithID:(NSString *)folderID
                                                                                  name:(NSString *)fileName
-                                                                                 size:(NSUInteger)fileSize
+                                                                                 size:(unsigned long long)fileSize
 {
     BOXPreflightCheckRequest *request = [[BOXPreflightCheckRequest alloc] initWithFileName:fileName parentFolderID:folderID];
     request.fileSize = fileSize;
@@ -223,7 +223,7 @@
 
 - (BOXPreflightCheckRequest *)fileUploadPreflightCheckRequestForNewFileVersionWithID:(NSString *)fileID
                                                                                 name:(NSString *)fileName
-                                                                                size:(NSUInteger)fileSize
+                                                                                size:(unsigned long long)fileSize
 {
     BOXPreflightCheckRequest *request = [[BOXPreflightCheckRequest alloc] initWithFileName:fileName fileID:fileID];
     request.fileSize = fileSize;
@@ -8,6 +8,7 @@
 
 #import "BOXContentClient.h"
 #import "BOXContentSDKConstants.h"
+#import "BOXBulkItemProcessor.h"
 
 @class BOXFolderRequest;
 @class BOXFolderCopyRequest;
@@ -19,6 +20,10 @@
 @class BOXFolderPaginatedItemsRequest;
 @class BOXTrashedFolderRestoreRequest;
 @class BOXTrashedItemArrayRequest;
+@class BOXPathResolver;
+@class BOXFolderTreeWalker;
+@class BOXFolderDownloader;
+@class BOXDirectoryUploader;
 
 NS_ASSUME_NONNULL_BEGIN
 
@@ -266,6 +271,57 @@ NS_ASSUME_NONNULL_BEGIN
                                          associateID:(nullable NSString *)associateID;
 
 
+/**
+ *  Create a resolver from paths such as @"/Projects/2026/report.pdf" to item IDs. The resolver caches the
+ *  folder tree it discovers, so keep it around and feed it the items you fetch.
+ *
+ *  @return A resolver that can be customized and then used.
+ */
+- (BOXPathResolver *)pathResolver;
+
+/**
+ *  Create a walker that enumerates every item below a folder with parallel listing requests.
+ *
+ *  @param folderID The ID of the folder to walk.
+ *
+ *  @return A walker that can be customized and then started.
+ */
+- (BOXFolderTreeWalker *)folderTreeWalkerWithRootFolderID:(NSString *)folderID;
+
+/**
+ *  Create a downloader that copies a folder and everything below it to a local directory. Starting a new
+ *  downloader for the same folder and directory resumes an interrupted download.
+ *
+ *  @param folderID        The ID of the folder to download.
+ *  @param destinationPath The local directory the content of the folder is downloaded into.
+ *
+ *  @return A downloader that can be customized and then started.
+ */
+- (BOXFolderDownloader *)folderDownloaderWithFolderID:(NSString *)folderID
+                                      destinationPath:(NSString *)destinationPath;
+
+/**
+ *  Create an uploader that copies a local directory and everything below it into a new folder on Box.
+ *
+ *  @param localPath      The local directory to upload.
+ *  @param parentFolderID The ID of the folder in which the folder for the directory will be created.
+ *
+ *  @return An uploader that can be customized and then started.
+ */
+- (BOXDirectoryUploader *)directoryUploaderWithLocalPath:(NSString *)localPath
+                                          parentFolderID:(NSString *)parentFolderID;
+
+/**
+ *  Create a processor that applies the same action to many files, folders and bookmarks in parallel.
+ *
+ *  @param items  The items to act on.
+ *  @param action The action to apply to every item.
+ *
+ *  @return A processor that can be customized and then started.
+ */
+- (BOXBulkItemProcessor *)bulkItemProcessorWithItems:(NSArray<BOXModel *> *)items
+                                              action:(BOXBulkItemAction)action;
+
 @end
 
 NS_ASSUME_NONNULL_END
@@ -18,6 +18,11 @@
 #import "BOXFolderPaginatedItemsRequest.h"
 #import "BOXTrashedItemArrayRequest.h"
 #import "BOXTrashedFolderRestoreRequest.h"
+#import "BOXPathResolver.h"
+#import "BOXFolderTreeWalker.h"
+#import "BOXFolderDownloader.h"
+#import "BOXDirectoryUploader.h"
+#import "BOXBulkItemProcessor.h"
 #import "BOXFolderItemsRequest+Metadata.h"
 
 NS_ASSUME_NONNULL_BEGIN
@@ -245,6 +250,34 @@ NS_ASSUME_NONNULL_BEGIN
     return request;
 }
 
+- (BOXPathResolver *)pathResolver
+{
+    return [[BOXPathResolver alloc] initWithClient:self];
+}
+
+- (BOXFolderTreeWalker *)folderTreeWalkerWithRootFolderID:(NSString *)folderID
+{
+    return [[BOXFolderTreeWalker alloc] initWithClient:self rootFolderID:folderID];
+}
+
+- (BOXFolderDownloader *)folderDownloaderWithFolderID:(NSString *)folderID
+                                      destinationPath:(NSString *)destinationPath
+{
+    return [[BOXFolderDownloader alloc] initWithClient:self folderID:folderID destinationPath:destinationPath];
+}
+
+- (BOXDirectoryUploader *)directoryUploaderWithLocalPath:(NSString *)localPath
+                                          parentFolderID:(NSString *)parentFolderID
+{
+    return [[BOXDirectoryUploader alloc] initWithClient:self localPath:localPath parentFolderID:parentFolderID];
+}
+
+- (BOXBulkItemProcessor *)bulkItemProcessorWithItems:(NSArray<BOXModel *> *)items
+                                              action:(BOXBulkItemAction)action
+{
+    return [[BOXBulkItemProcessor alloc] initWithClient:self items:items action:action];
+}
+
 @end
 
 NS_ASSUME_NONNULL_END
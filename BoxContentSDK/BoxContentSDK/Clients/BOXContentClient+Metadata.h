@@ -13,6 +13,7 @@
 @class BOXMetadataCreateRequest;
 @class BOXMetadataUpdateRequest;
 @class BOXMetadataTemplateRequest;
+@class BOXMetadataUpdateQueue;
 
 /**
  * BOXContentClient category that provides convenience methods to setup metadata requests.
@@ -173,4 +174,12 @@
  */
 - (BOXMetadataTemplateRequest *)metadataTemplatesInfoRequest;
 
+/**
+ * Create a queue that merges successive updates of the same metadata instance into one request.
+ * Keep it around for as long as metadata is edited.
+ *
+ * @return A queue that can be customized and then used.
+ */
+- (BOXMetadataUpdateQueue *)metadataUpdateQueue;
+
 @end
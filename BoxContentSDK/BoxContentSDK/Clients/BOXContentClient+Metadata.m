@@ -13,6 +13,7 @@
 #import "BOXMetadataCreateRequest.h"
 #import "BOXMetadataUpdateRequest.h"
 #import "BOXMetadataTemplateRequest.h"
+#import "BOXMetadataUpdateQueue.h"
 
 @implementation BOXContentClient (Metadata)
 
@@ -112,4 +113,9 @@
     return request;
 }
 
+- (BOXMetadataUpdateQueue *)metadataUpdateQueue
+{
+    return [[BOXMetadataUpdateQueue alloc] initWithClient:self];
+}
+
 @end
@@ -9,6 +9,7 @@
 #import "BOXContentClient.h"
 
 @class BOXSearchRequest;
+@class BOXSearchSession;
 
 @interface BOXContentClient (Search)
 
@@ -58,4 +59,12 @@
                                                    inRange:(NSRange)range
                                        unifiedMetadataKeys:(NSArray *)unifiedMetadataKeys;
 
+/**
+ *  Create a session for search-as-you-type. The session debounces queries, cancels superseded requests
+ *  and caches recent results.
+ *
+ *  @return A session that can be customized and then fed queries from the main thread.
+ */
+- (BOXSearchSession *)searchSession;
+
 @end
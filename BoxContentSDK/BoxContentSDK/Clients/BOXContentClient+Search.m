@@ -9,6 +9,7 @@
 #import "BOXContentClient+Search.h"
 #import "BOXContentClient_Private.h"
 #import "BOXSearchRequest.h"
+#import "BOXSearchSession.h"
 
 @implementation BOXContentClient (Search)
 
@@ -36,4 +37,9 @@
     return request;
 }
 
+- (BOXSearchSession *)searchSession
+{
+    return [[BOXSearchSession alloc] initWithClient:self];
+}
+
 @end
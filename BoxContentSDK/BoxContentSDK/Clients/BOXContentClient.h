@@ -159,6 +159,33 @@ extern NSString *const BOXContentClientBackgroundTempFolder;
  */
 + (void)setAppToAppBoxAuthenticationEnabled:(BOOL)enabled;
 
+/**
+ * Whether clients created from now on share [BOXAPIScheduler sharedScheduler], which caps the operations all accounts
+ * run at once, takes turns between the accounts that have operations waiting, and can limit the rate of each.
+ * Each client keeps its own queues and authentication. The default is NO: every client runs up to its own queue
+ * limits regardless of the others.
+ *
+ *  @param enabled  Whether new clients should use the shared scheduler.
+ */
++ (void)setSharedAPISchedulerEnabled:(BOOL)enabled;
+
+/**
+ * Whether large JSON request bodies, such as metadata updates, are sent gzip-compressed. Only enable it when the
+ * API server accepts "Content-Encoding: gzip" request bodies. The default is NO.
+ * Responses are negotiated compressed regardless.
+ *
+ *  @param enabled  Whether JSON request bodies of at least 1 KB should be compressed.
+ */
++ (void)setRequestBodyCompressionEnabled:(BOOL)enabled;
+
+/**
+ * Whether connections to the Box hosts are opened ahead of the first request, when a client is created, when the
+ * app returns to the foreground and after the network went away. The default is NO.
+ *
+ *  @param enabled  Whether connections should be prewarmed.
+ */
++ (void)setConnectionPrewarmingEnabled:(BOOL)enabled;
+
 /**
  *  Resource bundle for loading images, etc.
  *
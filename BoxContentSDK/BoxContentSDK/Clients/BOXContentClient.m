@@ -23,6 +23,8 @@
 #import "BOXUserRequest.h"
 #import "BOXContentClient+User.h"
 #import "BOXURLSessionManager.h"
+#import "BOXAPIScheduler.h"
+#import "BOXAPIJSONOperation.h"
 
 // Default API URLs
 /*
@@ -65,6 +67,7 @@ static NSString *staticClientID;
 static NSString *staticClientSecret;
 static NSString *staticRedirectURIString;
 static BOOL staticAppToAppBoxAuthenticationEnabled = NO;
+static BOOL staticSharedAPISchedulerEnabled = NO;
 static NSMutableDictionary *_SDKClients;
 static dispatch_once_t onceTokenForDefaultClient = 0;
 static BOXContentClient *defaultInstance = nil;
@@ -186,6 +189,21 @@ static BOXContentClient *defaultInstance = nil;
     staticAppToAppBoxAuthenticationEnabled = enabled;
 }
 
++ (void)setSharedAPISchedulerEnabled:(BOOL)enabled
+{
+    staticSharedAPISchedulerEnabled = enabled;
+}
+
++ (void)setRequestBodyCompressionEnabled:(BOOL)enabled
+{
+    [BOXAPIJSONOperation setRequestBodyCompressionEnabled:enabled];
+}
+
++ (void)setConnectionPrewarmingEnabled:(BOOL)enabled
+{
+    [BOXURLSessionManager sharedInstance].prewarmsConnections = enabled;
+}
+
 - (instancetype)init
 {
     if (self = [super init])
@@ -194,8 +212,13 @@ static BOXContentClient *defaultInstance = nil;
         // because sessions enqueue API operations to fetch access tokens and the queue
         // manager uses the session as a lock object when enqueuing operations.
         _queueManager = [[BOXParallelAPIQueueManager alloc] init];
+        if (staticSharedAPISchedulerEnabled) {
+            ((BOXParallelAPIQueueManager *)_queueManager).scheduler = [BOXAPIScheduler sharedScheduler];
+        }
 
         _urlSessionManager = [BOXURLSessionManager sharedInstance];
+        [[self class] updateURLSessionManagerBaseURLs];
+        [_urlSessionManager prewarm];
 
         _OAuth2Session = [[BOXParallelOAuth2Session alloc] initWithClientID:staticClientID
                                                                      secret:staticClientSecret
@@ -545,11 +568,13 @@ static BOXContentClient *defaultInstance = nil;
 {
     staticAPIBaseURL = APIBaseURL;
     staticAPIBaseURLWithoutVersion = nil;
+    [self updateURLSessionManagerBaseURLs];
 }
 
 + (void)setOAuth2BaseURL:(NSString *)OAuth2BaseURL
 {
     staticOAuth2BaseURL = OAuth2BaseURL;
+    [self updateURLSessionManagerBaseURLs];
 }
 
 + (void)setAPIAuthBaseURL:(NSString *)APIAuthBaseURL
@@ -560,6 +585,18 @@ static BOXContentClient *defaultInstance = nil;
 + (void)setAPIUploadBaseURL:(NSString *)APIUploadBaseURL
 {
     staticAPIUploadBaseURL = APIUploadBaseURL;
+    [self updateURLSessionManagerBaseURLs];
+}
+
+// The shared session manager routes and prewarms by these hosts, so it follows every change to them.
+// Downloads have no base URL: the API host redirects them to content servers that are not known ahead,
+// so prewarming the API host on the download session would only open a connection no download uses.
++ (void)updateURLSessionManagerBaseURLs
+{
+    BOXURLSessionManager *urlSessionManager = [BOXURLSessionManager sharedInstance];
+    [urlSessionManager setBaseURL:[NSURL URLWithString:[self APIBaseURL]] forTrafficClass:BOXURLSessionTrafficClassAPI];
+    [urlSessionManager setBaseURL:[NSURL URLWithString:[self OAuth2BaseURL]] forTrafficClass:BOXURLSessionTrafficClassAuth];
+    [urlSessionManager setBaseURL:[NSURL URLWithString:[self APIUploadBaseURL]] forTrafficClass:BOXURLSessionTrafficClassUpload];
 }
 
 
@@ -0,0 +1,80 @@
+//
+//  BOXBulkItemProcessor.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXContentClient;
+@class BOXModel;
+
+typedef NS_ENUM(NSUInteger, BOXBulkItemAction) {
+    BOXBulkItemActionMove = 0,      // Requires destinationFolderID.
+    BOXBulkItemActionCopy,          // Requires destinationFolderID.
+    BOXBulkItemActionDelete,
+    BOXBulkItemActionRestore,       // Files and folders in the trash.
+    BOXBulkItemActionSetCollections // Requires collectionIDs.
+};
+
+/**
+ *  Called on the main thread once an item is done, with the item returned by the API if there is one.
+ */
+typedef void (^BOXBulkItemResultBlock)(BOXModel *item, BOXModel *resultItem, NSError *error);
+
+/**
+ *  Called on the main thread once every item is done. errorsByItemKey has the error of every item that
+ *  failed, keyed by +keyForItem: since a file and a folder can share an ID. error is only set if the
+ *  processor was cancelled.
+ */
+typedef void (^BOXBulkItemCompletionBlock)(NSUInteger succeededCount, NSDictionary<NSString *, NSError *> *errorsByItemKey, NSError *error);
+
+/**
+ *  BOXBulkItemProcessor applies the same action to many files, folders and bookmarks.
+ *
+ *  Requests run in parallel with an adaptive limit: it starts at initialConcurrency, grows by one each time
+ *  as many requests as the limit succeed in a row, and is halved when the API reports a rate limit (HTTP 429)
+ *  or an internal error, at which point no new request starts until a backoff interval has passed. Items
+ *  that failed with a transient error, including a folder temporarily locked by another operation, are retried.
+ *  Copies that failed with an internal error or a network error are not retried, since the copy may have been
+ *  made anyway.
+ */
+@interface BOXBulkItemProcessor : NSObject
+
+@property (nonatomic, readonly, strong) NSArray<BOXModel *> *items;
+@property (nonatomic, readonly, assign) BOXBulkItemAction action;
+
+@property (nonatomic, readwrite, copy) NSString *destinationFolderID;
+@property (nonatomic, readwrite, copy) NSArray<NSString *> *collectionIDs;
+
+/**
+ *  Number of requests in flight at the start. Defaults to 4.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger initialConcurrency;
+
+/**
+ *  Upper bound of the number of requests in flight. Defaults to 8, the width of the queue manager's global
+ *  queue.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrency;
+
+@property (nonatomic, readwrite, copy) BOXBulkItemResultBlock itemResultBlock;
+
+@property (atomic, readonly, assign) NSUInteger completedCount;
+
+/**
+ *  @param items  Files, folders and bookmarks, or any model with a type and an ID.
+ *  @param action The action applied to every item.
+ */
+- (instancetype)initWithClient:(BOXContentClient *)client
+                         items:(NSArray<BOXModel *> *)items
+                        action:(BOXBulkItemAction)action;
+
+/**
+ *  @return The key of item in the errors passed to the completion block, its type and ID, e.g. "file_12".
+ */
++ (NSString *)keyForItem:(BOXModel *)item;
+
+- (void)startWithCompletion:(BOXBulkItemCompletionBlock)completionBlock;
+- (void)cancel;
+
+@end
@@ -0,0 +1,415 @@
+//
+//  BOXBulkItemProcessor.m
+//  BoxContentSDK
+//
+
+#import "BOXBulkItemProcessor.h"
+#import "BOXBulkItemProcessor_Private.h"
+
+#import "BOXContentClient+File.h"
+#import "BOXContentClient+Folder.h"
+#import "BOXContentClient+Bookmark.h"
+#import "BOXContentClient+Collection.h"
+#import "BOXFileUpdateRequest.h"
+#import "BOXFileCopyRequest.h"
+#import "BOXFileDeleteRequest.h"
+#import "BOXTrashedFileRestoreRequest.h"
+#import "BOXFolderUpdateRequest.h"
+#import "BOXFolderCopyRequest.h"
+#import "BOXFolderDeleteRequest.h"
+#import "BOXTrashedFolderRestoreRequest.h"
+#import "BOXBookmarkUpdateRequest.h"
+#import "BOXBookmarkCopyRequest.h"
+#import "BOXBookmarkDeleteRequest.h"
+#import "BOXItemSetCollectionsRequest.h"
+#import "BOXModel.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXDispatchHelper.h"
+#import "BOXLog.h"
+
+#define BOX_BULK_ITEM_DEFAULT_INITIAL_CONCURRENCY (4)
+#define BOX_BULK_ITEM_DEFAULT_MAX_CONCURRENCY (8)
+#define BOX_BULK_ITEM_MAX_RETRIES (4)
+#define BOX_BULK_ITEM_DEFAULT_INITIAL_BACKOFF_INTERVAL (1.0)
+#define BOX_BULK_ITEM_MAX_BACKOFF_INTERVAL (60.0)
+
+// Returned with a 409 when another operation holds a lock on one of the folders involved.
+static NSString *const BOXBulkItemErrorCodeOperationBlocked = @"operation_blocked_temporary";
+
+typedef void (^BOXBulkItemRequestCompletionBlock)(BOXModel *resultItem, NSError *error);
+
+@interface BOXBulkItemTask : NSObject
+
+@property (nonatomic, readwrite, strong) BOXModel *item;
+@property (nonatomic, readwrite, assign) NSUInteger retryCount;
+@property (nonatomic, readwrite, strong) BOXRequest *request;
+
+@end
+
+@implementation BOXBulkItemTask
+@end
+
+@interface BOXBulkItemProcessor ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, strong) NSArray<BOXModel *> *items;
+@property (nonatomic, readwrite, assign) BOXBulkItemAction action;
+@property (atomic, readwrite, assign) NSUInteger completedCount;
+
+// All of the properties below are only accessed on queue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingTasks;
+@property (nonatomic, readwrite, strong) NSMutableSet *activeTasks;
+@property (nonatomic, readwrite, assign) NSUInteger successStreak;
+@property (nonatomic, readwrite, assign) NSUInteger consecutiveThrottleCount;
+@property (nonatomic, readwrite, strong) NSDate *pausedUntilDate;
+@property (nonatomic, readwrite, assign) BOOL resumeScheduled;
+@property (nonatomic, readwrite, assign) NSUInteger waitingCount;
+@property (nonatomic, readwrite, assign) NSUInteger succeededCount;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *errorsByItemKey;
+@property (nonatomic, readwrite, copy) BOXBulkItemCompletionBlock completionBlock;
+@property (nonatomic, readwrite, assign) BOOL started;
+@property (nonatomic, readwrite, assign) BOOL finished;
+
+@end
+
+@implementation BOXBulkItemProcessor
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+                         items:(NSArray<BOXModel *> *)items
+                        action:(BOXBulkItemAction)action
+{
+    if (self = [super init]) {
+        _client = client;
+        _items = [items copy];
+        _action = action;
+        _initialConcurrency = BOX_BULK_ITEM_DEFAULT_INITIAL_CONCURRENCY;
+        _maxConcurrency = BOX_BULK_ITEM_DEFAULT_MAX_CONCURRENCY;
+        _initialBackoffInterval = BOX_BULK_ITEM_DEFAULT_INITIAL_BACKOFF_INTERVAL;
+        _queue = dispatch_queue_create("com.box.contentsdk.bulkitemprocessor", DISPATCH_QUEUE_SERIAL);
+        _pendingTasks = [NSMutableArray array];
+        _activeTasks = [NSMutableSet set];
+        _errorsByItemKey = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
++ (NSString *)keyForItem:(BOXModel *)item
+{
+    if (item.modelID.length == 0 || item.type.length == 0) {
+        return nil;
+    }
+    return [NSString stringWithFormat:@"%@_%@", item.type, item.modelID];
+}
+
+- (void)startWithCompletion:(BOXBulkItemCompletionBlock)completionBlock
+{
+    BOXAssert((self.action != BOXBulkItemActionMove && self.action != BOXBulkItemActionCopy) || self.destinationFolderID.length > 0,
+              @"Moving or copying items requires a destinationFolderID");
+    BOXAssert(self.action != BOXBulkItemActionSetCollections || self.collectionIDs != nil,
+              @"Setting the collections of items requires collectionIDs");
+
+    dispatch_async(self.queue, ^{
+        if (self.started) {
+            return;
+        }
+        self.started = YES;
+        self.completionBlock = completionBlock;
+        self.concurrencyLimit = MIN(MAX(self.initialConcurrency, 1), MAX(self.maxConcurrency, 1));
+
+        for (BOXModel *item in self.items) {
+            BOXBulkItemTask *task = [[BOXBulkItemTask alloc] init];
+            task.item = item;
+            [self.pendingTasks addObject:task];
+        }
+        [self scheduleTasks];
+    });
+}
+
+- (void)cancel
+{
+    dispatch_async(self.queue, ^{
+        if (self.started && !self.finished) {
+            NSError *error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
+            [self finishWithError:error];
+        }
+    });
+}
+
+#pragma mark - Tasks (called on queue)
+
+- (void)scheduleTasks
+{
+    if (self.finished) {
+        return;
+    }
+
+    NSTimeInterval pauseInterval = [self.pausedUntilDate timeIntervalSinceNow];
+    if (pauseInterval > 0) {
+        if (!self.resumeScheduled) {
+            self.resumeScheduled = YES;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(pauseInterval * NSEC_PER_SEC)), self.queue, ^{
+                self.resumeScheduled = NO;
+                [self scheduleTasks];
+            });
+        }
+        return;
+    }
+
+    while (self.activeTasks.count < self.concurrencyLimit && self.pendingTasks.count > 0) {
+        BOXBulkItemTask *task = self.pendingTasks.firstObject;
+        [self.pendingTasks removeObjectAtIndex:0];
+        [self performTask:task];
+    }
+
+    if (self.activeTasks.count == 0 && self.pendingTasks.count == 0 && self.waitingCount == 0) {
+        [self finishWithError:nil];
+    }
+}
+
+- (void)performTask:(BOXBulkItemTask *)task
+{
+    [self.activeTasks addObject:task];
+
+    BOXRequest *request = [self performActionOnItem:task.item completion:^(BOXModel *resultItem, NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (self.finished || ![self.activeTasks containsObject:task]) {
+                return;
+            }
+            task.request = nil;
+            [self.activeTasks removeObject:task];
+            [self handleResultItem:resultItem error:error forTask:task];
+            [self scheduleTasks];
+        });
+    }];
+
+    if (request == nil) {
+        [self.activeTasks removeObject:task];
+        NSError *error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIErrorBadRequest userInfo:nil];
+        [self completeTask:task resultItem:nil error:error];
+        return;
+    }
+    task.request = request;
+}
+
+- (void)handleResultItem:(BOXModel *)resultItem error:(NSError *)error forTask:(BOXBulkItemTask *)task
+{
+    if (error == nil) {
+        // Additive increase: one more request in flight after a full round of successes.
+        self.consecutiveThrottleCount = 0;
+        self.successStreak++;
+        if (self.successStreak >= self.concurrencyLimit) {
+            self.concurrencyLimit = MIN(self.concurrencyLimit + 1, MAX(self.maxConcurrency, 1));
+            self.successStreak = 0;
+        }
+        [self completeTask:task resultItem:resultItem error:nil];
+        return;
+    }
+
+    if (task.retryCount >= BOX_BULK_ITEM_MAX_RETRIES) {
+        [self completeTask:task resultItem:nil error:error];
+        return;
+    }
+
+    BOOL isBoxError = [error.domain isEqualToString:BOXContentSDKErrorDomain];
+    BOOL isServerError = isBoxError && error.code >= BOXContentSDKAPIErrorInternalServerError && error.code < 600;
+    BOOL isThrottled = isServerError || (isBoxError && error.code == BOXContentSDKAPIErrorTooManyRequests);
+    BOOL isTransient = [error.domain isEqualToString:NSURLErrorDomain] || (isBoxError && [self isOperationBlockedError:error]);
+
+    // A copy that failed on the server or on the network may still have been made; a retry would make another one.
+    // Rate limits and locked folders are refused before anything is copied.
+    BOOL mayHaveSucceeded = ([error.domain isEqualToString:NSURLErrorDomain] ||
+                             isServerError ||
+                             (isBoxError && error.code == BOXContentSDKAPIErrorUnknownStatusCode));
+    BOOL isRetryable = !(self.action == BOXBulkItemActionCopy && mayHaveSucceeded);
+
+    if (isThrottled) {
+        // Multiplicative decrease, and a pause shared by every request.
+        self.concurrencyLimit = MAX(self.concurrencyLimit / 2, 1);
+        self.successStreak = 0;
+        NSTimeInterval delay = [self backoffIntervalForAttempt:self.consecutiveThrottleCount];
+        self.consecutiveThrottleCount++;
+        NSDate *pausedUntilDate = [NSDate dateWithTimeIntervalSinceNow:delay];
+        if (self.pausedUntilDate == nil || [pausedUntilDate compare:self.pausedUntilDate] == NSOrderedDescending) {
+            self.pausedUntilDate = pausedUntilDate;
+        }
+        BOXLog(@"Bulk item processor throttled, %lu requests in flight after a %.0fs pause", (unsigned long)self.concurrencyLimit, delay);
+    }
+
+    if (!isRetryable) {
+        [self completeTask:task resultItem:nil error:error];
+    } else if (isThrottled) {
+        task.retryCount++;
+        [self.pendingTasks insertObject:task atIndex:0];
+    } else if (isTransient) {
+        NSTimeInterval delay = [self backoffIntervalForAttempt:task.retryCount];
+        task.retryCount++;
+        self.waitingCount++;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+            self.waitingCount--;
+            if (!self.finished) {
+                [self.pendingTasks insertObject:task atIndex:0];
+                [self scheduleTasks];
+            }
+        });
+    } else {
+        [self completeTask:task resultItem:nil error:error];
+    }
+}
+
+- (NSTimeInterval)backoffIntervalForAttempt:(NSUInteger)attempt
+{
+    return MIN(self.initialBackoffInterval * pow(2.0, attempt), BOX_BULK_ITEM_MAX_BACKOFF_INTERVAL);
+}
+
+- (BOOL)isOperationBlockedError:(NSError *)error
+{
+    NSDictionary *JSON = error.userInfo[BOXJSONErrorResponseKey];
+    return (error.code == BOXContentSDKAPIErrorConflict &&
+            [JSON isKindOfClass:[NSDictionary class]] &&
+            [JSON[BOXAPIObjectKeyCode] isEqual:BOXBulkItemErrorCodeOperationBlocked]);
+}
+
+- (void)completeTask:(BOXBulkItemTask *)task resultItem:(BOXModel *)resultItem error:(NSError *)error
+{
+    if (error) {
+        NSString *itemKey = [[self class] keyForItem:task.item];
+        if (itemKey) {
+            self.errorsByItemKey[itemKey] = error;
+        }
+    } else {
+        self.succeededCount++;
+    }
+    self.completedCount++;
+
+    BOXBulkItemResultBlock itemResultBlock = self.itemResultBlock;
+    if (itemResultBlock) {
+        BOXModel *item = task.item;
+        [BOXDispatchHelper callCompletionBlock:^{
+            itemResultBlock(item, resultItem, error);
+        } onMainThread:YES];
+    }
+}
+
+- (void)finishWithError:(NSError *)error
+{
+    if (self.finished) {
+        return;
+    }
+    self.finished = YES;
+
+    for (BOXBulkItemTask *task in self.activeTasks) {
+        [task.request cancel];
+        task.request = nil;
+    }
+    [self.activeTasks removeAllObjects];
+    [self.pendingTasks removeAllObjects];
+
+    BOXBulkItemCompletionBlock completionBlock = self.completionBlock;
+    self.completionBlock = nil;
+    if (completionBlock) {
+        NSUInteger succeededCount = self.succeededCount;
+        NSDictionary *errorsByItemKey = [self.errorsByItemKey copy];
+        [BOXDispatchHelper callCompletionBlock:^{
+            completionBlock(succeededCount, errorsByItemKey, error);
+        } onMainThread:YES];
+    }
+}
+
+#pragma mark - Requests (called on queue)
+
+// Starts the request applying the action to item, or returns nil if the action does not apply to items of
+// its type, in which case completion is never called.
+- (BOXRequest *)performActionOnItem:(BOXModel *)item completion:(BOXBulkItemRequestCompletionBlock)completion
+{
+    void (^modelBlock)(id, NSError *) = ^(id resultItem, NSError *error) {
+        completion(resultItem, error);
+    };
+    BOXErrorBlock errorBlock = ^(NSError *error) {
+        completion(nil, error);
+    };
+
+    NSString *itemID = item.modelID;
+    BOOL isFile = [item.type isEqualToString:BOXAPIItemTypeFile];
+    BOOL isFolder = [item.type isEqualToString:BOXAPIItemTypeFolder];
+    BOOL isBookmark = [item.type isEqualToString:BOXAPIItemTypeWebLink];
+
+    switch (self.action) {
+        case BOXBulkItemActionMove:
+            if (isFile) {
+                BOXFileUpdateRequest *request = [self.client fileMoveRequestWithID:itemID destinationFolderID:self.destinationFolderID];
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            } else if (isFolder) {
+                BOXFolderUpdateRequest *request = [self.client folderMoveRequestWithID:itemID destinationFolderID:self.destinationFolderID];
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            } else if (isBookmark) {
+                BOXBookmarkUpdateRequest *request = [self.client bookmarkMoveRequestWithID:itemID destinationFolderID:self.destinationFolderID];
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            }
+            break;
+        case BOXBulkItemActionCopy:
+            if (isFile) {
+                BOXFileCopyRequest *request = [self.client fileCopyRequestWithID:itemID destinationFolderID:self.destinationFolderID];
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            } else if (isFolder) {
+                BOXFolderCopyRequest *request = [self.client folderCopyRequestWithID:itemID destinationFolderID:self.destinationFolderID];
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            } else if (isBookmark) {
+                BOXBookmarkCopyRequest *request = [self.client bookmarkCopyRequestWithID:itemID destinationFolderID:self.destinationFolderID];
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            }
+            break;
+        case BOXBulkItemActionDelete:
+            if (isFile) {
+                BOXFileDeleteRequest *request = [self.client fileDeleteRequestWithID:itemID];
+                [request performRequestWithCompletion:errorBlock];
+                return request;
+            } else if (isFolder) {
+                BOXFolderDeleteRequest *request = [self.client folderDeleteRequestWithID:itemID];
+                [request performRequestWithCompletion:errorBlock];
+                return request;
+            } else if (isBookmark) {
+                BOXBookmarkDeleteRequest *request = [self.client bookmarkDeleteRequestWithID:itemID];
+                [request performRequestWithCompletion:errorBlock];
+                return request;
+            }
+            break;
+        case BOXBulkItemActionRestore:
+            if (isFile) {
+                BOXTrashedFileRestoreRequest *request = [self.client trashedFileRestoreRequestWithID:itemID];
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            } else if (isFolder) {
+                BOXTrashedFolderRestoreRequest *request = [self.client trashedFolderRestoreRequestWithID:itemID];
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            }
+            break;
+        case BOXBulkItemActionSetCollections:
+            if (isFile || isFolder || isBookmark) {
+                BOXItemSetCollectionsRequest *request = nil;
+                if (isFile) {
+                    request = [self.client collectionsSetRequestForFileWithID:itemID collectionIDs:self.collectionIDs];
+                } else if (isFolder) {
+                    request = [self.client collectionsSetRequestForFolderWithID:itemID collectionIDs:self.collectionIDs];
+                } else {
+                    request = [self.client collectionsSetRequestForBookmarkWithID:itemID collectionIDs:self.collectionIDs];
+                }
+                [request performRequestWithCompletion:modelBlock];
+                return request;
+            }
+            break;
+    }
+
+    BOXLog(@"Bulk item action %lu does not apply to item %@ of type %@", (unsigned long)self.action, itemID, item.type);
+    return nil;
+}
+
+@end
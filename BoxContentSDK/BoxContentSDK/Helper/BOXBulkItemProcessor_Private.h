@@ -0,0 +1,21 @@
+//
+//  BOXBulkItemProcessor_Private.h
+//  BoxContentSDK
+//
+
+#import "BOXBulkItemProcessor.h"
+
+@interface BOXBulkItemProcessor ()
+
+/**
+ *  The current limit of requests in flight. Only accessed on the processor's queue.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger concurrencyLimit;
+
+/**
+ *  The pause after the first rate limit or internal error, and the wait before the first retry of an item that
+ *  failed with a transient error. Doubles with each further attempt. Defaults to 1 second.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval initialBackoffInterval;
+
+@end
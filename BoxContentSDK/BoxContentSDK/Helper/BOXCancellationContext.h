@@ -0,0 +1,82 @@
+//
+//  BOXCancellationContext.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Anything a BOXCancellationContext can cancel: API operations, and the child contexts of composite requests.
+ */
+@protocol BOXCancellable <NSObject>
+
+- (void)cancel;
+
+@end
+
+/**
+ * Cancellation and deadline shared by a request and everything it runs on its behalf.
+ *
+ * A request creates a context, and the operations it enqueues, including the copies re-enqueued after a token
+ * refresh or a 202, are registered with it. Composite requests, such as BOXFolderItemsRequest, give each request
+ * they spawn a child context. Cancelling a context cancels, at once, every operation registered with it or with
+ * one of its descendants, and so their session tasks.
+ *
+ * A child's deadline is the earliest of its own and its ancestors'. When it passes, the context is cancelled with
+ * BOXContentSDKAPIDeadlineExceededError: running operations are cancelled and operations that did not start yet
+ * fail without making their request.
+ *
+ * Thread safe.
+ */
+@interface BOXCancellationContext : NSObject <BOXCancellable>
+
+/**
+ * The earliest of the deadlines of this context and its ancestors, nil if there is none.
+ */
+@property (nonatomic, readonly, strong) NSDate *deadline;
+
+- (instancetype)init;
+- (instancetype)initWithDeadline:(NSDate *)deadline;
+
+/**
+ * A context cancelled along with parent. It is created cancelled if parent already is.
+ *
+ * @param parent    The context to inherit cancellation and deadline from, may be nil.
+ * @param deadline  A deadline of its own, may be nil. Only shortens the parent's.
+ */
+- (instancetype)initWithParent:(BOXCancellationContext *)parent deadline:(NSDate *)deadline;
+
+/**
+ * A child context with the same deadline.
+ */
+- (BOXCancellationContext *)childContext;
+
+/**
+ * Whether the context was cancelled, directly, through an ancestor or because its deadline passed.
+ */
+- (BOOL)isCancelled;
+
+/**
+ * BOXContentSDKAPIUserCancelledError or BOXContentSDKAPIDeadlineExceededError once the context is cancelled,
+ * nil until then.
+ */
+- (NSError *)error;
+
+/**
+ * Time left until the deadline, 0 once the context is cancelled, DBL_MAX if it has no deadline.
+ */
+- (NSTimeInterval)remainingTime;
+
+/**
+ * Cancels the context with BOXContentSDKAPIUserCancelledError. Does nothing if it already is cancelled.
+ */
+- (void)cancel;
+
+/**
+ * Cancels cancellable along with the context, immediately if it already is cancelled. The context does not
+ * retain it.
+ */
+- (void)addCancellable:(id<BOXCancellable>)cancellable;
+- (void)removeCancellable:(id<BOXCancellable>)cancellable;
+
+@end
@@ -0,0 +1,154 @@
+//
+//  BOXCancellationContext.m
+//  BoxContentSDK
+//
+
+#import "BOXCancellationContext.h"
+#import "BOXContentSDKErrors.h"
+
+@interface BOXCancellationContext ()
+
+@property (nonatomic, readwrite, strong) BOXCancellationContext *parent;
+@property (nonatomic, readwrite, strong) NSDate *deadline;
+
+// Guarded by @synchronized(self).
+@property (nonatomic, readwrite, strong) NSError *cancellationError;
+@property (nonatomic, readwrite, strong) NSHashTable *cancellables;
+
+@end
+
+@implementation BOXCancellationContext
+
+- (instancetype)init
+{
+    return [self initWithParent:nil deadline:nil];
+}
+
+- (instancetype)initWithDeadline:(NSDate *)deadline
+{
+    return [self initWithParent:nil deadline:deadline];
+}
+
+- (instancetype)initWithParent:(BOXCancellationContext *)parent deadline:(NSDate *)deadline
+{
+    if (self = [super init]) {
+        _parent = parent;
+        _cancellables = [NSHashTable weakObjectsHashTable];
+
+        NSDate *parentDeadline = parent.deadline;
+        if (parentDeadline != nil && (deadline == nil || [parentDeadline compare:deadline] == NSOrderedAscending)) {
+            _deadline = parentDeadline;
+        } else {
+            _deadline = deadline;
+        }
+
+        // The parent's timer reaches children through the parent, only a shorter deadline needs a timer of its own.
+        if (_deadline != nil && _deadline != parentDeadline) {
+            [self scheduleDeadlineTimer];
+        }
+        [parent addCancellable:self];
+    }
+    return self;
+}
+
+- (BOXCancellationContext *)childContext
+{
+    return [[BOXCancellationContext alloc] initWithParent:self deadline:nil];
+}
+
+- (void)scheduleDeadlineTimer
+{
+    __weak BOXCancellationContext *weakSelf = self;
+    NSTimeInterval delay = MAX(0, [self.deadline timeIntervalSinceNow]);
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), dispatch_get_global_queue(QOS_CLASS_UTILITY, 0), ^{
+        [weakSelf cancelWithErrorCode:BOXContentSDKAPIDeadlineExceededError];
+    });
+}
+
+#pragma mark - State
+
+- (BOOL)isCancelled
+{
+    return [self error] != nil;
+}
+
+- (NSError *)error
+{
+    @synchronized(self) {
+        if (self.cancellationError != nil) {
+            return self.cancellationError;
+        }
+    }
+    // The timer may not have fired yet; work must not start past the deadline either way.
+    if (self.deadline != nil && [self.deadline timeIntervalSinceNow] <= 0) {
+        [self cancelWithErrorCode:BOXContentSDKAPIDeadlineExceededError];
+        @synchronized(self) {
+            return self.cancellationError;
+        }
+    }
+    return nil;
+}
+
+- (NSTimeInterval)remainingTime
+{
+    if ([self isCancelled]) {
+        return 0;
+    }
+    if (self.deadline == nil) {
+        return DBL_MAX;
+    }
+    return MAX(0, [self.deadline timeIntervalSinceNow]);
+}
+
+#pragma mark - Cancellation
+
+- (void)cancel
+{
+    [self cancelWithErrorCode:BOXContentSDKAPIUserCancelledError];
+}
+
+- (void)cancelWithErrorCode:(NSInteger)errorCode
+{
+    NSArray *cancellables = nil;
+    @synchronized(self) {
+        if (self.cancellationError != nil) {
+            return;
+        }
+        // Children take the parent's reason, so that operations under an expired parent fail as expired.
+        NSError *parentError = nil;
+        @synchronized(self.parent) {
+            parentError = self.parent.cancellationError;
+        }
+        self.cancellationError = parentError ?: [NSError errorWithDomain:BOXContentSDKErrorDomain code:errorCode userInfo:nil];
+        cancellables = self.cancellables.allObjects;
+        [self.cancellables removeAllObjects];
+    }
+
+    // Outside of the lock, cancelling an operation may call back into the context.
+    for (id<BOXCancellable> cancellable in cancellables) {
+        [cancellable cancel];
+    }
+}
+
+- (void)addCancellable:(id<BOXCancellable>)cancellable
+{
+    if (cancellable == nil) {
+        return;
+    }
+    @synchronized(self) {
+        if (self.cancellationError == nil) {
+            [self.cancellables addObject:cancellable];
+            return;
+        }
+    }
+    [cancellable cancel];
+}
+
+- (void)removeCancellable:(id<BOXCancellable>)cancellable
+{
+    @synchronized(self) {
+        [self.cancellables removeObject:cancellable];
+    }
+}
+
+@end
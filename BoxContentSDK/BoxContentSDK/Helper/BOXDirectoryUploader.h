@@ -0,0 +1,105 @@
+//
+//  BOXDirectoryUploader.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXContentClient;
+
+/**
+ *  Called on the main thread as files are uploaded. estimatedTimeRemaining is negative until enough data has
+ *  been sent to measure the throughput.
+ */
+typedef void (^BOXDirectoryUploadProgressBlock)(unsigned long long bytesUploaded,
+                                                 unsigned long long totalBytes,
+                                                 double bytesPerSecond,
+                                                 NSTimeInterval estimatedTimeRemaining);
+
+/**
+ *  Called on the main thread once every file has been uploaded or skipped, or the upload failed or was
+ *  cancelled. folderID is the ID of the folder created for the directory, if it was. If some files could not
+ *  be uploaded, error is the first error encountered.
+ */
+typedef void (^BOXDirectoryUploadCompletionBlock)(NSString *folderID, NSUInteger filesUploaded, NSUInteger filesSkipped, NSError *error);
+
+/**
+ *  BOXDirectoryUploader uploads a local directory and everything below it into a folder on Box.
+ *
+ *  - Folders are created in parallel as soon as their parent exists, and the files of a folder start uploading
+ *    as soon as it is created, instead of after the whole skeleton.
+ *  - A folder that already exists is reused: the ID of the existing folder is read from the conflict error
+ *    (HTTP 409) rather than looked up with another request. A file that already exists with the same SHA1 is
+ *    skipped.
+ *  - Preflight checks are off by default, since the upload itself reports the same errors. When they are
+ *    enabled, they run ahead of the uploads instead of before each of them.
+ *  - Files smaller than smallFileThreshold are sent on the small uploads queue, so they are not held up behind
+ *    large files on the two slot uploads queue.
+ *
+ *  If stateFileURL is set, the IDs of the folders and files created are saved there, and a later uploader of
+ *  the same directory with the same state file skips them.
+ */
+@interface BOXDirectoryUploader : NSObject
+
+@property (nonatomic, readonly, copy) NSString *localPath;
+@property (nonatomic, readonly, copy) NSString *parentFolderID;
+
+/**
+ *  Maximum number of folder creation requests in flight. Defaults to 4.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentFolderCreations;
+
+/**
+ *  Maximum number of large file uploads in flight. Defaults to 2, the width of the queue manager's uploads
+ *  queue.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentUploads;
+
+/**
+ *  Maximum number of small file uploads in flight. Defaults to 4, the width of the queue manager's small
+ *  uploads queue.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentSmallUploads;
+
+/**
+ *  Files smaller than this many bytes are small uploads. Defaults to 1 MB.
+ */
+@property (nonatomic, readwrite, assign) unsigned long long smallFileThreshold;
+
+/**
+ *  Whether files and folders whose name starts with a dot, e.g. .DS_Store or .git, are left out along with
+ *  everything below them. They are neither uploaded nor counted as skipped. Defaults to YES.
+ */
+@property (nonatomic, readwrite, assign) BOOL skipsHiddenFiles;
+
+/**
+ *  Whether each file is checked with a preflight request before it is uploaded. Defaults to NO.
+ */
+@property (nonatomic, readwrite, assign) BOOL performsPreflightCheck;
+
+/**
+ *  If set, large files are uploaded with background uploads that continue if the app is suspended. The
+ *  multipart copies these need are written to this directory.
+ */
+@property (nonatomic, readwrite, copy) NSString *backgroundUploadDirectoryPath;
+
+/**
+ *  If set, progress is saved to this file so that an interrupted upload can be resumed. The file is removed
+ *  once the upload completes.
+ */
+@property (nonatomic, readwrite, strong) NSURL *stateFileURL;
+
+@property (nonatomic, readwrite, copy) BOXDirectoryUploadProgressBlock progressBlock;
+
+@property (atomic, readonly, assign) NSUInteger filesUploaded;
+@property (atomic, readonly, assign) NSUInteger filesSkipped;
+@property (atomic, readonly, assign) unsigned long long bytesUploaded;
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+                     localPath:(NSString *)localPath
+                parentFolderID:(NSString *)parentFolderID;
+
+- (void)startWithCompletion:(BOXDirectoryUploadCompletionBlock)completionBlock;
+- (void)cancel;
+
+@end
@@ -0,0 +1,734 @@
+//
+//  BOXDirectoryUploader.m
+//  BoxContentSDK
+//
+
+#import "BOXDirectoryUploader.h"
+
+#import "BOXContentClient+File.h"
+#import "BOXContentClient+Folder.h"
+#import "BOXFileUploadRequest.h"
+#import "BOXFolderCreateRequest.h"
+#import "BOXPreflightCheckRequest.h"
+#import "BOXFile.h"
+#import "BOXFolder.h"
+#import "BOXHashHelper.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXDispatchHelper.h"
+#import "BOXLog.h"
+
+#define BOX_DIRECTORY_UPLOAD_DEFAULT_MAX_CONCURRENT_FOLDER_CREATIONS (4)
+#define BOX_DIRECTORY_UPLOAD_DEFAULT_MAX_CONCURRENT_UPLOADS (2)
+#define BOX_DIRECTORY_UPLOAD_DEFAULT_MAX_CONCURRENT_SMALL_UPLOADS (4)
+#define BOX_DIRECTORY_UPLOAD_DEFAULT_SMALL_FILE_THRESHOLD (1024ull * 1024ull)
+#define BOX_DIRECTORY_UPLOAD_MAX_CONCURRENT_PREFLIGHT_CHECKS (4)
+#define BOX_DIRECTORY_UPLOAD_MAX_RETRIES (3)
+#define BOX_DIRECTORY_UPLOAD_MAX_BACKOFF_INTERVAL (60.0)
+#define BOX_DIRECTORY_UPLOAD_PROGRESS_INTERVAL (0.25)
+#define BOX_DIRECTORY_UPLOAD_STATE_SAVE_INTERVAL (20)
+
+static NSString *const BOXDirectoryUploadStateKeyFolderIDs = @"folder_ids";
+static NSString *const BOXDirectoryUploadStateKeyFileIDs = @"file_ids";
+
+@interface BOXDirectoryUploadFolder : NSObject
+
+// Path relative to the uploaded directory, empty for the directory itself.
+@property (nonatomic, readwrite, copy) NSString *relativePath;
+@property (nonatomic, readwrite, copy) NSString *name;
+@property (nonatomic, readwrite, weak) BOXDirectoryUploadFolder *parent;
+@property (nonatomic, readwrite, copy) NSString *folderID;
+@property (nonatomic, readwrite, strong) NSMutableArray *childFolders;
+@property (nonatomic, readwrite, strong) NSMutableArray *files;
+@property (nonatomic, readwrite, assign) NSUInteger retryCount;
+@property (nonatomic, readwrite, strong) BOXFolderCreateRequest *request;
+
+@end
+
+@implementation BOXDirectoryUploadFolder
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _childFolders = [NSMutableArray array];
+        _files = [NSMutableArray array];
+    }
+    return self;
+}
+
+@end
+
+@interface BOXDirectoryUploadFile : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *relativePath;
+@property (nonatomic, readwrite, copy) NSString *localPath;
+@property (nonatomic, readwrite, copy) NSString *name;
+@property (nonatomic, readwrite, assign) unsigned long long size;
+@property (nonatomic, readwrite, weak) BOXDirectoryUploadFolder *folder;
+@property (nonatomic, readwrite, assign) BOOL isSmall;
+@property (nonatomic, readwrite, assign) BOOL passedPreflightCheck;
+@property (nonatomic, readwrite, assign) NSUInteger retryCount;
+// Bytes of the file sent by the current attempt, counted in bytesUploaded.
+@property (nonatomic, readwrite, assign) unsigned long long sentLength;
+// Whether size is counted in totalBytes.
+@property (nonatomic, readwrite, assign) BOOL countedInTotalBytes;
+@property (nonatomic, readwrite, copy) NSString *multipartCopyPath;
+@property (nonatomic, readwrite, strong) BOXRequest *request;
+
+@end
+
+@implementation BOXDirectoryUploadFile
+@end
+
+@interface BOXDirectoryUploader ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, copy) NSString *localPath;
+@property (nonatomic, readwrite, copy) NSString *parentFolderID;
+@property (atomic, readwrite, assign) NSUInteger filesUploaded;
+@property (atomic, readwrite, assign) NSUInteger filesSkipped;
+@property (atomic, readwrite, assign) unsigned long long bytesUploaded;
+
+// All of the properties below are only accessed on queue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+// Enumeration and hashing of local files, kept off queue so transfers keep flowing.
+@property (nonatomic, readwrite, strong) dispatch_queue_t IOQueue;
+@property (nonatomic, readwrite, strong) BOXDirectoryUploadFolder *rootFolder;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *folderIDsByPath;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *fileIDsByPath;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingFolders;
+@property (nonatomic, readwrite, strong) NSMutableSet *activeFolders;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingPreflightChecks;
+@property (nonatomic, readwrite, strong) NSMutableSet *activePreflightChecks;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingSmallUploads;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingUploads;
+@property (nonatomic, readwrite, strong) NSMutableSet *activeUploads;
+@property (nonatomic, readwrite, assign) NSUInteger activeSmallUploadCount;
+@property (nonatomic, readwrite, assign) NSUInteger waitingCount;
+@property (nonatomic, readwrite, assign) NSUInteger pendingIOCount;
+@property (nonatomic, readwrite, assign) NSUInteger changesSinceStateSave;
+@property (nonatomic, readwrite, assign) unsigned long long totalBytes;
+@property (nonatomic, readwrite, assign) CFAbsoluteTime lastSampleTime;
+@property (nonatomic, readwrite, assign) unsigned long long lastSampleBytes;
+@property (nonatomic, readwrite, assign) double bytesPerSecond;
+@property (nonatomic, readwrite, assign) BOOL progressReportScheduled;
+@property (nonatomic, readwrite, strong) NSError *firstError;
+@property (nonatomic, readwrite, copy) BOXDirectoryUploadCompletionBlock completionBlock;
+@property (nonatomic, readwrite, assign) BOOL started;
+@property (nonatomic, readwrite, assign) BOOL finished;
+
+@end
+
+@implementation BOXDirectoryUploader
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+                     localPath:(NSString *)localPath
+                parentFolderID:(NSString *)parentFolderID
+{
+    if (self = [super init]) {
+        _client = client;
+        _localPath = [localPath copy];
+        _parentFolderID = [parentFolderID copy];
+        _maxConcurrentFolderCreations = BOX_DIRECTORY_UPLOAD_DEFAULT_MAX_CONCURRENT_FOLDER_CREATIONS;
+        _maxConcurrentUploads = BOX_DIRECTORY_UPLOAD_DEFAULT_MAX_CONCURRENT_UPLOADS;
+        _maxConcurrentSmallUploads = BOX_DIRECTORY_UPLOAD_DEFAULT_MAX_CONCURRENT_SMALL_UPLOADS;
+        _smallFileThreshold = BOX_DIRECTORY_UPLOAD_DEFAULT_SMALL_FILE_THRESHOLD;
+        _skipsHiddenFiles = YES;
+        _queue = dispatch_queue_create("com.box.contentsdk.directoryuploader", DISPATCH_QUEUE_SERIAL);
+        _IOQueue = dispatch_queue_create("com.box.contentsdk.directoryuploader.io", DISPATCH_QUEUE_SERIAL);
+        _folderIDsByPath = [NSMutableDictionary dictionary];
+        _fileIDsByPath = [NSMutableDictionary dictionary];
+        _pendingFolders = [NSMutableArray array];
+        _activeFolders = [NSMutableSet set];
+        _pendingPreflightChecks = [NSMutableArray array];
+        _activePreflightChecks = [NSMutableSet set];
+        _pendingSmallUploads = [NSMutableArray array];
+        _pendingUploads = [NSMutableArray array];
+        _activeUploads = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (void)startWithCompletion:(BOXDirectoryUploadCompletionBlock)completionBlock
+{
+    dispatch_async(self.queue, ^{
+        if (self.started) {
+            return;
+        }
+        self.started = YES;
+        self.completionBlock = completionBlock;
+        self.lastSampleTime = CFAbsoluteTimeGetCurrent();
+        [self loadState];
+
+        self.pendingIOCount++;
+        dispatch_async(self.IOQueue, ^{
+            NSError *error = nil;
+            BOXDirectoryUploadFolder *rootFolder = [self enumerateLocalDirectoryWithError:&error];
+            dispatch_async(self.queue, ^{
+                self.pendingIOCount--;
+                if (self.finished) {
+                    return;
+                }
+                if (rootFolder == nil) {
+                    [self finishWithError:error];
+                    return;
+                }
+                self.rootFolder = rootFolder;
+                [self enqueueFolder:rootFolder];
+                [self scheduleWork];
+            });
+        });
+    });
+}
+
+- (void)cancel
+{
+    dispatch_async(self.queue, ^{
+        if (self.started && !self.finished) {
+            NSError *error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
+            [self finishWithError:error];
+        }
+    });
+}
+
+#pragma mark - Local directory (called on IOQueue)
+
+- (BOXDirectoryUploadFolder *)enumerateLocalDirectoryWithError:(NSError **)error
+{
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    BOOL isDirectory = NO;
+    if (![fileManager fileExistsAtPath:self.localPath isDirectory:&isDirectory] || !isDirectory) {
+        if (error) {
+            *error = [[NSError alloc] initWithDomain:NSCocoaErrorDomain code:NSFileReadNoSuchFileError userInfo:@{NSFilePathErrorKey : self.localPath}];
+        }
+        return nil;
+    }
+
+    BOXDirectoryUploadFolder *rootFolder = [[BOXDirectoryUploadFolder alloc] init];
+    rootFolder.relativePath = @"";
+    rootFolder.name = [self.localPath lastPathComponent];
+    NSMutableDictionary *foldersByPath = [NSMutableDictionary dictionaryWithObject:rootFolder forKey:@""];
+
+    NSDirectoryEnumerator *enumerator = [fileManager enumeratorAtPath:self.localPath];
+    for (NSString *relativePath in enumerator) {
+        @autoreleasepool {
+            NSDictionary *attributes = enumerator.fileAttributes;
+            NSString *fileType = attributes[NSFileType];
+            BOOL isFolder = [fileType isEqualToString:NSFileTypeDirectory];
+
+            if (self.skipsHiddenFiles && [[relativePath lastPathComponent] hasPrefix:@"."]) {
+                if (isFolder) {
+                    [enumerator skipDescendants];
+                }
+                continue;
+            }
+
+            BOXDirectoryUploadFolder *parent = foldersByPath[[relativePath stringByDeletingLastPathComponent]];
+            if (parent == nil) {
+                continue;
+            }
+
+            if (isFolder) {
+                BOXDirectoryUploadFolder *folder = [[BOXDirectoryUploadFolder alloc] init];
+                folder.relativePath = relativePath;
+                folder.name = [relativePath lastPathComponent];
+                folder.parent = parent;
+                [parent.childFolders addObject:folder];
+                foldersByPath[relativePath] = folder;
+            } else if ([fileType isEqualToString:NSFileTypeRegular]) {
+                BOXDirectoryUploadFile *file = [[BOXDirectoryUploadFile alloc] init];
+                file.relativePath = relativePath;
+                file.localPath = [self.localPath stringByAppendingPathComponent:relativePath];
+                file.name = [relativePath lastPathComponent];
+                file.size = [attributes fileSize];
+                file.isSmall = file.size < self.smallFileThreshold;
+                file.folder = parent;
+                [parent.files addObject:file];
+            }
+        }
+    }
+
+    return rootFolder;
+}
+
+#pragma mark - Work (called on queue)
+
+- (void)enqueueFolder:(BOXDirectoryUploadFolder *)folder
+{
+    NSString *folderID = self.folderIDsByPath[folder.relativePath];
+    if (folderID) {
+        folder.folderID = folderID;
+        [self folderWasCreated:folder];
+    } else {
+        [self.pendingFolders addObject:folder];
+    }
+}
+
+- (void)folderWasCreated:(BOXDirectoryUploadFolder *)folder
+{
+    for (BOXDirectoryUploadFolder *childFolder in folder.childFolders) {
+        [self enqueueFolder:childFolder];
+    }
+
+    for (BOXDirectoryUploadFile *file in folder.files) {
+        if (self.fileIDsByPath[file.relativePath]) {
+            self.filesSkipped++;
+            continue;
+        }
+        self.totalBytes += file.size;
+        file.countedInTotalBytes = YES;
+        [self enqueueFile:file];
+    }
+}
+
+- (void)enqueueFile:(BOXDirectoryUploadFile *)file
+{
+    if (self.performsPreflightCheck && !file.passedPreflightCheck) {
+        [self.pendingPreflightChecks addObject:file];
+    } else if (file.isSmall) {
+        [self.pendingSmallUploads addObject:file];
+    } else {
+        [self.pendingUploads addObject:file];
+    }
+}
+
+- (void)scheduleWork
+{
+    if (self.finished) {
+        return;
+    }
+
+    while (self.activeFolders.count < MAX(self.maxConcurrentFolderCreations, 1) && self.pendingFolders.count > 0) {
+        BOXDirectoryUploadFolder *folder = self.pendingFolders.firstObject;
+        [self.pendingFolders removeObjectAtIndex:0];
+        [self createFolder:folder];
+    }
+
+    while (self.activePreflightChecks.count < BOX_DIRECTORY_UPLOAD_MAX_CONCURRENT_PREFLIGHT_CHECKS && self.pendingPreflightChecks.count > 0) {
+        BOXDirectoryUploadFile *file = self.pendingPreflightChecks.firstObject;
+        [self.pendingPreflightChecks removeObjectAtIndex:0];
+        [self performPreflightCheckOfFile:file];
+    }
+
+    while (self.activeSmallUploadCount < MAX(self.maxConcurrentSmallUploads, 1) && self.pendingSmallUploads.count > 0) {
+        BOXDirectoryUploadFile *file = self.pendingSmallUploads.firstObject;
+        [self.pendingSmallUploads removeObjectAtIndex:0];
+        [self uploadFile:file];
+    }
+
+    while (self.activeUploads.count - self.activeSmallUploadCount < MAX(self.maxConcurrentUploads, 1) && self.pendingUploads.count > 0) {
+        BOXDirectoryUploadFile *file = self.pendingUploads.firstObject;
+        [self.pendingUploads removeObjectAtIndex:0];
+        [self uploadFile:file];
+    }
+
+    if (self.pendingIOCount == 0 && self.waitingCount == 0 &&
+        self.activeFolders.count == 0 && self.activePreflightChecks.count == 0 && self.activeUploads.count == 0 &&
+        self.pendingFolders.count == 0 && self.pendingPreflightChecks.count == 0 &&
+        self.pendingSmallUploads.count == 0 && self.pendingUploads.count == 0) {
+        [self finishWithError:self.firstError];
+    }
+}
+
+- (void)createFolder:(BOXDirectoryUploadFolder *)folder
+{
+    NSString *parentFolderID = folder.parent ? folder.parent.folderID : self.parentFolderID;
+    BOXFolderCreateRequest *request = [self.client folderCreateRequestWithName:folder.name parentFolderID:parentFolderID];
+    folder.request = request;
+    [self.activeFolders addObject:folder];
+
+    [request performRequestWithCompletion:^(BOXFolder *createdFolder, NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (self.finished || folder.request != request) {
+                return;
+            }
+            folder.request = nil;
+            [self.activeFolders removeObject:folder];
+
+            // A folder of the same name is reused; its ID comes with the conflict error.
+            NSString *folderID = createdFolder.modelID;
+            if (error) {
+                NSDictionary *conflictingItem = [self conflictingItemFromError:error];
+                if ([conflictingItem[BOXAPIObjectKeyType] isEqualToString:BOXAPIItemTypeFolder]) {
+                    folderID = conflictingItem[BOXAPIObjectKeyID];
+                }
+            }
+
+            if (folderID) {
+                folder.folderID = folderID;
+                self.folderIDsByPath[folder.relativePath] = folderID;
+                [self stateDidChange];
+                [self folderWasCreated:folder];
+            } else if ([self shouldRetryAfterError:error retryCount:folder.retryCount]) {
+                folder.retryCount++;
+                [self retryAfterDelay:[self backoffIntervalForRetryCount:folder.retryCount] block:^{
+                    [self.pendingFolders insertObject:folder atIndex:0];
+                }];
+            } else {
+                // Nothing below a folder that could not be created is uploaded.
+                [self recordError:error];
+                BOXLog(@"Directory upload could not create folder %@: %@", folder.relativePath, error);
+            }
+            [self scheduleWork];
+        });
+    }];
+}
+
+- (void)performPreflightCheckOfFile:(BOXDirectoryUploadFile *)file
+{
+    BOXPreflightCheckRequest *request = [self.client fileUploadPreflightCheckRequestForNewFileInFolderWithID:file.folder.folderID
+                                                                                                       name:file.name
+                                                                                                       size:file.size];
+    file.request = request;
+    [self.activePreflightChecks addObject:file];
+
+    [request performRequestWithCompletion:^(NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (self.finished || file.request != request) {
+                return;
+            }
+            file.request = nil;
+            [self.activePreflightChecks removeObject:file];
+
+            if (error == nil) {
+                file.passedPreflightCheck = YES;
+                [self enqueueFile:file];
+            } else {
+                [self handleError:error forFile:file];
+            }
+            [self scheduleWork];
+        });
+    }];
+}
+
+- (void)uploadFile:(BOXDirectoryUploadFile *)file
+{
+    BOXFileUploadRequest *request = nil;
+    if (!file.isSmall && self.backgroundUploadDirectoryPath.length > 0) {
+        NSString *associateID = [[NSUUID UUID] UUIDString];
+        file.multipartCopyPath = [self.backgroundUploadDirectoryPath stringByAppendingPathComponent:associateID];
+        request = [self.client fileUploadRequestInBackgroundToFolderWithID:file.folder.folderID
+                                                         fromLocalFilePath:file.localPath
+                                               uploadMultipartCopyFilePath:file.multipartCopyPath
+                                                               associateId:associateID];
+    } else {
+        request = [self.client fileUploadRequestToFolderWithID:file.folder.folderID fromLocalFilePath:file.localPath];
+    }
+    request.isSmallUpload = file.isSmall;
+
+    file.request = request;
+    file.sentLength = 0;
+    [self.activeUploads addObject:file];
+    if (file.isSmall) {
+        self.activeSmallUploadCount++;
+    }
+
+    [request performRequestWithProgress:^(long long totalBytesTransferred, long long totalBytesExpectedToTransfer) {
+        dispatch_async(self.queue, ^{
+            if (file.request != request) {
+                return;
+            }
+            // The multipart body is slightly larger than the file.
+            unsigned long long sentLength = MIN((unsigned long long)MAX(totalBytesTransferred, 0ll), file.size);
+            if (sentLength > file.sentLength) {
+                self.bytesUploaded += sentLength - file.sentLength;
+                file.sentLength = sentLength;
+                [self scheduleProgressReport];
+            }
+        });
+    } completion:^(BOXFile *uploadedFile, NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (self.finished || file.request != request) {
+                return;
+            }
+            [self removeActiveUpload:file];
+
+            if (error == nil) {
+                self.bytesUploaded += file.size - file.sentLength;
+                file.sentLength = 0;
+                self.filesUploaded++;
+                [self recordFileID:uploadedFile.modelID ofFile:file];
+            } else {
+                [self removeSentBytesOfFile:file];
+                [self handleError:error forFile:file];
+            }
+            [self scheduleWork];
+        });
+    }];
+}
+
+- (void)removeActiveUpload:(BOXDirectoryUploadFile *)file
+{
+    file.request = nil;
+    [self.activeUploads removeObject:file];
+    if (file.isSmall) {
+        self.activeSmallUploadCount--;
+    }
+    if (file.multipartCopyPath) {
+        [[NSFileManager defaultManager] removeItemAtPath:file.multipartCopyPath error:nil];
+        file.multipartCopyPath = nil;
+    }
+}
+
+- (void)handleError:(NSError *)error forFile:(BOXDirectoryUploadFile *)file
+{
+    NSDictionary *conflictingItem = [self conflictingItemFromError:error];
+    NSString *conflictingSHA1 = conflictingItem[BOXAPIObjectKeySHA1];
+
+    if ([conflictingItem[BOXAPIObjectKeyType] isEqualToString:BOXAPIItemTypeFile] && [conflictingSHA1 isKindOfClass:[NSString class]]) {
+        // A file of the same name is only accepted as already uploaded if it has the same content.
+        self.pendingIOCount++;
+        dispatch_async(self.IOQueue, ^{
+            NSString *SHA1 = [BOXHashHelper sha1HashOfFileAtPath:file.localPath];
+            dispatch_async(self.queue, ^{
+                self.pendingIOCount--;
+                if (self.finished) {
+                    return;
+                }
+                if (SHA1 && [SHA1 caseInsensitiveCompare:conflictingSHA1] == NSOrderedSame) {
+                    self.filesSkipped++;
+                    [self removeFileFromTotalBytes:file];
+                    [self recordFileID:conflictingItem[BOXAPIObjectKeyID] ofFile:file];
+                } else {
+                    [self failFile:file withError:error];
+                }
+                [self scheduleWork];
+            });
+        });
+    } else if ([self shouldRetryAfterError:error retryCount:file.retryCount]) {
+        file.retryCount++;
+        [self retryAfterDelay:[self backoffIntervalForRetryCount:file.retryCount] block:^{
+            [self enqueueFile:file];
+        }];
+    } else {
+        [self failFile:file withError:error];
+    }
+}
+
+- (void)failFile:(BOXDirectoryUploadFile *)file withError:(NSError *)error
+{
+    [self removeFileFromTotalBytes:file];
+    [self recordError:error];
+    BOXLog(@"Directory upload could not upload file %@: %@", file.relativePath, error);
+}
+
+// Each file only takes back what it added, so the unsigned counters cannot wrap around.
+- (void)removeSentBytesOfFile:(BOXDirectoryUploadFile *)file
+{
+    self.bytesUploaded -= MIN(file.sentLength, self.bytesUploaded);
+    file.sentLength = 0;
+}
+
+- (void)removeFileFromTotalBytes:(BOXDirectoryUploadFile *)file
+{
+    if (!file.countedInTotalBytes) {
+        return;
+    }
+    file.countedInTotalBytes = NO;
+    self.totalBytes -= MIN(file.size, self.totalBytes);
+}
+
+- (void)recordError:(NSError *)error
+{
+    if (self.firstError == nil) {
+        self.firstError = error;
+    }
+}
+
+- (NSDictionary *)conflictingItemFromError:(NSError *)error
+{
+    if (![error.domain isEqualToString:BOXContentSDKErrorDomain] || error.code != BOXContentSDKAPIErrorConflict) {
+        return nil;
+    }
+    NSDictionary *JSON = error.userInfo[BOXJSONErrorResponseKey];
+    NSDictionary *contextInfo = [JSON isKindOfClass:[NSDictionary class]] ? JSON[BOXAPIObjectKeyContextInfo] : nil;
+    id conflicts = [contextInfo isKindOfClass:[NSDictionary class]] ? contextInfo[BOXAPIObjectKeyConflicts] : nil;
+
+    // Folder conflicts come as a list, file conflicts as a single item.
+    if ([conflicts isKindOfClass:[NSArray class]]) {
+        conflicts = [conflicts firstObject];
+    }
+    return [conflicts isKindOfClass:[NSDictionary class]] ? conflicts : nil;
+}
+
+- (BOOL)shouldRetryAfterError:(NSError *)error retryCount:(NSUInteger)retryCount
+{
+    if (retryCount >= BOX_DIRECTORY_UPLOAD_MAX_RETRIES) {
+        return NO;
+    }
+    // Uploads cannot be copied, so they are not retried by the queue manager after an access token refresh.
+    return ([error.domain isEqualToString:NSURLErrorDomain] ||
+            ([error.domain isEqualToString:BOXContentSDKErrorDomain] &&
+             (error.code == BOXContentSDKAPIErrorTooManyRequests ||
+              error.code == BOXContentSDKAuthErrorAccessTokenExpiredOperationCannotBeReenqueued ||
+              (error.code >= BOXContentSDKAPIErrorInternalServerError && error.code < 600))));
+}
+
+- (NSTimeInterval)backoffIntervalForRetryCount:(NSUInteger)retryCount
+{
+    return MIN(pow(2.0, retryCount), BOX_DIRECTORY_UPLOAD_MAX_BACKOFF_INTERVAL);
+}
+
+- (void)retryAfterDelay:(NSTimeInterval)delay block:(void (^)(void))block
+{
+    self.waitingCount++;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        self.waitingCount--;
+        if (self.finished) {
+            return;
+        }
+        block();
+        [self scheduleWork];
+    });
+}
+
+- (void)finishWithError:(NSError *)error
+{
+    if (self.finished) {
+        return;
+    }
+    self.finished = YES;
+
+    for (BOXDirectoryUploadFolder *folder in self.activeFolders) {
+        [folder.request cancel];
+        folder.request = nil;
+    }
+    for (BOXDirectoryUploadFile *file in [self.activePreflightChecks setByAddingObjectsFromSet:self.activeUploads]) {
+        BOXRequest *request = file.request;
+        file.request = nil;
+        [request cancel];
+        if (file.multipartCopyPath) {
+            [[NSFileManager defaultManager] removeItemAtPath:file.multipartCopyPath error:nil];
+        }
+    }
+    [self.activeFolders removeAllObjects];
+    [self.activePreflightChecks removeAllObjects];
+    [self.activeUploads removeAllObjects];
+    [self.pendingFolders removeAllObjects];
+    [self.pendingPreflightChecks removeAllObjects];
+    [self.pendingSmallUploads removeAllObjects];
+    [self.pendingUploads removeAllObjects];
+
+    if (error == nil) {
+        if (self.stateFileURL) {
+            [[NSFileManager defaultManager] removeItemAtURL:self.stateFileURL error:nil];
+        }
+    } else {
+        [self saveState];
+    }
+    [self reportProgress];
+
+    BOXDirectoryUploadCompletionBlock completionBlock = self.completionBlock;
+    self.completionBlock = nil;
+    if (completionBlock) {
+        NSString *folderID = self.rootFolder.folderID;
+        NSUInteger filesUploaded = self.filesUploaded;
+        NSUInteger filesSkipped = self.filesSkipped;
+        [BOXDispatchHelper callCompletionBlock:^{
+            completionBlock(folderID, filesUploaded, filesSkipped, error);
+        } onMainThread:YES];
+    }
+}
+
+#pragma mark - State (called on queue)
+
+- (void)recordFileID:(NSString *)fileID ofFile:(BOXDirectoryUploadFile *)file
+{
+    if (fileID) {
+        self.fileIDsByPath[file.relativePath] = fileID;
+        [self stateDidChange];
+    }
+}
+
+- (void)stateDidChange
+{
+    self.changesSinceStateSave++;
+    if (self.changesSinceStateSave >= BOX_DIRECTORY_UPLOAD_STATE_SAVE_INTERVAL) {
+        [self saveState];
+    }
+}
+
+- (void)saveState
+{
+    self.changesSinceStateSave = 0;
+    if (self.stateFileURL == nil) {
+        return;
+    }
+
+    NSDictionary *state = @{BOXDirectoryUploadStateKeyFolderIDs : self.folderIDsByPath,
+                            BOXDirectoryUploadStateKeyFileIDs : self.fileIDsByPath};
+    NSError *error = nil;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:state format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    if (data == nil || ![data writeToURL:self.stateFileURL options:NSDataWritingAtomic error:&error]) {
+        BOXLog(@"Could not save directory upload state: %@", error);
+    }
+}
+
+- (void)loadState
+{
+    if (self.stateFileURL == nil) {
+        return;
+    }
+    NSData *data = [NSData dataWithContentsOfURL:self.stateFileURL];
+    if (data == nil) {
+        return;
+    }
+    NSDictionary *state = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+    if (![state isKindOfClass:[NSDictionary class]]) {
+        return;
+    }
+
+    NSDictionary *folderIDsByPath = state[BOXDirectoryUploadStateKeyFolderIDs];
+    NSDictionary *fileIDsByPath = state[BOXDirectoryUploadStateKeyFileIDs];
+    if ([folderIDsByPath isKindOfClass:[NSDictionary class]] && [fileIDsByPath isKindOfClass:[NSDictionary class]]) {
+        [self.folderIDsByPath addEntriesFromDictionary:folderIDsByPath];
+        [self.fileIDsByPath addEntriesFromDictionary:fileIDsByPath];
+    }
+}
+
+#pragma mark - Progress (called on queue)
+
+- (void)scheduleProgressReport
+{
+    if (self.progressBlock == nil || self.progressReportScheduled) {
+        return;
+    }
+    self.progressReportScheduled = YES;
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(BOX_DIRECTORY_UPLOAD_PROGRESS_INTERVAL * NSEC_PER_SEC)), self.queue, ^{
+        self.progressReportScheduled = NO;
+        if (!self.finished) {
+            [self reportProgress];
+        }
+    });
+}
+
+- (void)reportProgress
+{
+    BOXDirectoryUploadProgressBlock progressBlock = self.progressBlock;
+    if (progressBlock == nil) {
+        return;
+    }
+
+    // The throughput is a moving average so that the estimate does not swing with every small file.
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    CFAbsoluteTime elapsed = now - self.lastSampleTime;
+    unsigned long long bytesUploaded = self.bytesUploaded;
+    if (elapsed > 0) {
+        double sample = ((double)bytesUploaded - (double)self.lastSampleBytes) / elapsed;
+        sample = MAX(sample, 0);
+        self.bytesPerSecond = self.bytesPerSecond > 0 ? 0.7 * self.bytesPerSecond + 0.3 * sample : sample;
+        self.lastSampleTime = now;
+        self.lastSampleBytes = bytesUploaded;
+    }
+
+    unsigned long long totalBytes = MAX(self.totalBytes, bytesUploaded);
+    double bytesPerSecond = self.bytesPerSecond;
+    NSTimeInterval estimatedTimeRemaining = bytesPerSecond > 0 ? (totalBytes - bytesUploaded) / bytesPerSecond : -1;
+
+    [BOXDispatchHelper callCompletionBlock:^{
+        progressBlock(bytesUploaded, totalBytes, bytesPerSecond, estimatedTimeRemaining);
+    } onMainThread:YES];
+}
+
+@end
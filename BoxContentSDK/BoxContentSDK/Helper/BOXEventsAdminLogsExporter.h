@@ -0,0 +1,84 @@
+//
+//  BOXEventsAdminLogsExporter.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXContentClient;
+@class BOXEvent;
+
+/**
+ *  Destination of the events exported by BOXEventsAdminLogsExporter. Methods are called from the
+ *  exporter's private serial queue, never concurrently.
+ */
+@protocol BOXEventsExportSink <NSObject>
+
+- (BOOL)writeEvent:(BOXEvent *)event error:(NSError **)error;
+- (BOOL)closeWithError:(NSError **)error;
+
+@end
+
+/**
+ *  Called on the main thread as pages of events are written to the sink.
+ */
+typedef void (^BOXEventsExportProgressBlock)(unsigned long long eventsExported, double eventsPerSecond);
+
+/**
+ *  Called on the main thread once the export is finished, failed or was cancelled.
+ */
+typedef void (^BOXEventsExportCompletionBlock)(unsigned long long eventsExported, double eventsPerSecond, NSError *error);
+
+/**
+ *  BOXEventsAdminLogsExporter exports the enterprise admin logs of a date range to a sink.
+ *
+ *  The range is split into windows of windowInterval which are fetched concurrently, each window
+ *  paging through its own stream position. Every page is decoded and written to the sink before the
+ *  next one of that window is requested, so memory stays bounded by maxConcurrentWindows pages no
+ *  matter how large the range is. Events recorded right at a window boundary can be returned by both
+ *  windows; they are written only once.
+ *
+ *  Rate limited pages (HTTP 429) are retried with an exponential backoff.
+ *
+ *  Both dates are required. If either is nil, or the range ends before it starts, the export fails with
+ *  BOXContentSDKAPIErrorBadRequest without sending a request.
+ */
+@interface BOXEventsAdminLogsExporter : NSObject
+
+@property (nonatomic, readonly, strong) NSDate *createdAfterDate;
+@property (nonatomic, readonly, strong) NSDate *createdBeforeDate;
+
+/**
+ *  Restrict the export to one or more comma separated event types.
+ */
+@property (nonatomic, readwrite, strong) NSString *eventType;
+
+/**
+ *  Duration of each window the range is split into. Defaults to one day.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval windowInterval;
+
+/**
+ *  Maximum number of windows fetched at the same time. Defaults to 4.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentWindows;
+
+/**
+ *  Number of events fetched per page. Defaults to 500, the maximum allowed by the API.
+ */
+@property (nonatomic, readwrite, assign) NSInteger limit;
+
+@property (nonatomic, readwrite, copy) BOXEventsExportProgressBlock progressBlock;
+
+@property (atomic, readonly, assign) unsigned long long eventsExported;
+@property (atomic, readonly, assign) double eventsPerSecond;
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+              createdAfterDate:(NSDate *)createdAfterDate
+             createdBeforeDate:(NSDate *)createdBeforeDate
+                          sink:(id<BOXEventsExportSink>)sink;
+
+- (void)startWithCompletion:(BOXEventsExportCompletionBlock)completionBlock;
+- (void)cancel;
+
+@end
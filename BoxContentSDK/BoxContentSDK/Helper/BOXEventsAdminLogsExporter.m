@@ -0,0 +1,285 @@
+//
+//  BOXEventsAdminLogsExporter.m
+//  BoxContentSDK
+//
+
+#import "BOXEventsAdminLogsExporter.h"
+
+#import "BOXContentClient+Event.h"
+#import "BOXEventsAdminLogsRequest.h"
+#import "BOXEvent.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXDispatchHelper.h"
+#import "BOXLog.h"
+
+#define BOX_EXPORT_DEFAULT_WINDOW_INTERVAL (24.0 * 60.0 * 60.0)
+#define BOX_EXPORT_DEFAULT_MAX_CONCURRENT_WINDOWS (4)
+#define BOX_EXPORT_DEFAULT_LIMIT (500)
+#define BOX_EXPORT_MAX_RETRIES (5)
+#define BOX_EXPORT_MAX_BACKOFF_INTERVAL (60.0)
+// Dates are sent to the API with a one second precision, so an event within a second of a window
+// boundary may be returned by both windows sharing it.
+#define BOX_EXPORT_BOUNDARY_TOLERANCE (1.0)
+
+@interface BOXEventsExportWindow : NSObject
+
+@property (nonatomic, readwrite, strong) NSDate *startDate;
+@property (nonatomic, readwrite, strong) NSDate *endDate;
+@property (nonatomic, readwrite, strong) NSString *streamPosition;
+@property (nonatomic, readwrite, assign) NSUInteger retryCount;
+@property (nonatomic, readwrite, strong) BOXEventsAdminLogsRequest *request;
+
+@end
+
+@implementation BOXEventsExportWindow
+@end
+
+@interface BOXEventsAdminLogsExporter ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, strong) NSDate *createdAfterDate;
+@property (nonatomic, readwrite, strong) NSDate *createdBeforeDate;
+@property (nonatomic, readwrite, strong) id<BOXEventsExportSink> sink;
+@property (atomic, readwrite, assign) unsigned long long eventsExported;
+@property (atomic, readwrite, assign) double eventsPerSecond;
+
+// All of the properties below are only accessed on queue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingWindows;
+@property (nonatomic, readwrite, strong) NSMutableSet *activeWindows;
+@property (nonatomic, readwrite, strong) NSMutableSet *boundaryEventIDs;
+@property (nonatomic, readwrite, copy) BOXEventsExportCompletionBlock completionBlock;
+@property (nonatomic, readwrite, assign) CFAbsoluteTime startTime;
+@property (nonatomic, readwrite, assign) BOOL started;
+@property (nonatomic, readwrite, assign) BOOL finished;
+
+@end
+
+@implementation BOXEventsAdminLogsExporter
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+              createdAfterDate:(NSDate *)createdAfterDate
+             createdBeforeDate:(NSDate *)createdBeforeDate
+                          sink:(id<BOXEventsExportSink>)sink
+{
+    if (self = [super init]) {
+        _client = client;
+        _createdAfterDate = createdAfterDate;
+        _createdBeforeDate = createdBeforeDate;
+        _sink = sink;
+        _windowInterval = BOX_EXPORT_DEFAULT_WINDOW_INTERVAL;
+        _maxConcurrentWindows = BOX_EXPORT_DEFAULT_MAX_CONCURRENT_WINDOWS;
+        _limit = BOX_EXPORT_DEFAULT_LIMIT;
+        _queue = dispatch_queue_create("com.box.contentsdk.eventsadminlogsexporter", DISPATCH_QUEUE_SERIAL);
+        _pendingWindows = [NSMutableArray array];
+        _activeWindows = [NSMutableSet set];
+        _boundaryEventIDs = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (void)startWithCompletion:(BOXEventsExportCompletionBlock)completionBlock
+{
+    dispatch_async(self.queue, ^{
+        if (self.started) {
+            return;
+        }
+        self.started = YES;
+        self.completionBlock = completionBlock;
+        self.startTime = CFAbsoluteTimeGetCurrent();
+
+        if (self.createdAfterDate == nil || self.createdBeforeDate == nil ||
+            [self.createdAfterDate compare:self.createdBeforeDate] == NSOrderedDescending) {
+            NSError *error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIErrorBadRequest userInfo:nil];
+            [self finishWithError:error];
+            return;
+        }
+
+        NSTimeInterval windowInterval = self.windowInterval > 0 ? self.windowInterval : BOX_EXPORT_DEFAULT_WINDOW_INTERVAL;
+        NSDate *startDate = self.createdAfterDate;
+        while ([startDate compare:self.createdBeforeDate] == NSOrderedAscending) {
+            NSDate *endDate = [startDate dateByAddingTimeInterval:windowInterval];
+            if ([endDate compare:self.createdBeforeDate] == NSOrderedDescending) {
+                endDate = self.createdBeforeDate;
+            }
+            BOXEventsExportWindow *window = [[BOXEventsExportWindow alloc] init];
+            window.startDate = startDate;
+            window.endDate = endDate;
+            [self.pendingWindows addObject:window];
+            startDate = endDate;
+        }
+
+        [self scheduleWindows];
+    });
+}
+
+- (void)cancel
+{
+    dispatch_async(self.queue, ^{
+        if (self.started && !self.finished) {
+            NSError *error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
+            [self finishWithError:error];
+        }
+    });
+}
+
+#pragma mark - Windows (called on queue)
+
+- (void)scheduleWindows
+{
+    NSUInteger maxConcurrentWindows = MAX(self.maxConcurrentWindows, 1);
+
+    while (self.activeWindows.count < maxConcurrentWindows && self.pendingWindows.count > 0) {
+        BOXEventsExportWindow *window = self.pendingWindows.firstObject;
+        [self.pendingWindows removeObjectAtIndex:0];
+        [self.activeWindows addObject:window];
+        [self fetchPageForWindow:window];
+    }
+
+    if (self.activeWindows.count == 0 && self.pendingWindows.count == 0) {
+        [self finishWithError:nil];
+    }
+}
+
+- (void)fetchPageForWindow:(BOXEventsExportWindow *)window
+{
+    BOXEventsAdminLogsRequest *request = [self.client eventsRequestForEnterprise];
+    request.createdAfterDate = window.startDate;
+    request.createdBeforeDate = window.endDate;
+    request.eventType = self.eventType;
+    request.limit = self.limit;
+    if (window.streamPosition) {
+        request.streamPosition = window.streamPosition;
+    }
+    window.request = request;
+
+    // Events are decoded on the operation thread, then handed to the queue to be written.
+    [request performRequestWithCompletion:^(NSArray<BOXEvent *> *events, NSString *nextStreamPosition, NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (self.finished) {
+                return;
+            }
+            window.request = nil;
+
+            if (error == nil) {
+                window.retryCount = 0;
+                [self writeEvents:events fromWindow:window];
+                if (self.finished) {
+                    return;
+                }
+
+                if (self.limit > 0 && (NSInteger)events.count >= self.limit) {
+                    window.streamPosition = nextStreamPosition;
+                    [self fetchPageForWindow:window];
+                } else {
+                    [self.activeWindows removeObject:window];
+                    [self scheduleWindows];
+                }
+            } else {
+                [self handleError:error forWindow:window];
+            }
+        });
+    }];
+}
+
+- (void)handleError:(NSError *)error forWindow:(BOXEventsExportWindow *)window
+{
+    BOOL isRetryable = ([error.domain isEqualToString:NSURLErrorDomain] ||
+                        ([error.domain isEqualToString:BOXContentSDKErrorDomain] &&
+                         (error.code == BOXContentSDKAPIErrorTooManyRequests || error.code >= BOXContentSDKAPIErrorInternalServerError)));
+
+    if (!isRetryable || window.retryCount >= BOX_EXPORT_MAX_RETRIES) {
+        [self finishWithError:error];
+        return;
+    }
+
+    NSTimeInterval delay = MIN(pow(2.0, window.retryCount), BOX_EXPORT_MAX_BACKOFF_INTERVAL);
+    window.retryCount++;
+    BOXLog(@"Admin logs export retrying window %@ - %@ in %.0fs after error %@", window.startDate, window.endDate, delay, error);
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        if (!self.finished) {
+            [self fetchPageForWindow:window];
+        }
+    });
+}
+
+- (void)writeEvents:(NSArray<BOXEvent *> *)events fromWindow:(BOXEventsExportWindow *)window
+{
+    BOOL hasPreviousWindow = ![window.startDate isEqualToDate:self.createdAfterDate];
+    BOOL hasNextWindow = ![window.endDate isEqualToDate:self.createdBeforeDate];
+    unsigned long long written = 0;
+
+    for (BOXEvent *event in events) @autoreleasepool {
+        BOOL isAtBoundary = ((hasPreviousWindow && fabs([event.createdDate timeIntervalSinceDate:window.startDate]) <= BOX_EXPORT_BOUNDARY_TOLERANCE) ||
+                             (hasNextWindow && fabs([event.createdDate timeIntervalSinceDate:window.endDate]) <= BOX_EXPORT_BOUNDARY_TOLERANCE));
+        // Only events at a boundary can be returned twice, so only their IDs need to be kept around.
+        if (isAtBoundary && event.modelID) {
+            if ([self.boundaryEventIDs containsObject:event.modelID]) {
+                continue;
+            }
+            [self.boundaryEventIDs addObject:event.modelID];
+        }
+
+        NSError *error = nil;
+        if (![self.sink writeEvent:event error:&error]) {
+            [self finishWithError:error];
+            return;
+        }
+        written++;
+    }
+
+    if (written > 0) {
+        [self updateThroughputWithWrittenCount:written];
+
+        BOXEventsExportProgressBlock progressBlock = self.progressBlock;
+        if (progressBlock) {
+            unsigned long long eventsExported = self.eventsExported;
+            double eventsPerSecond = self.eventsPerSecond;
+            [BOXDispatchHelper callCompletionBlock:^{
+                progressBlock(eventsExported, eventsPerSecond);
+            } onMainThread:YES];
+        }
+    }
+}
+
+- (void)updateThroughputWithWrittenCount:(unsigned long long)writtenCount
+{
+    self.eventsExported += writtenCount;
+    CFAbsoluteTime elapsed = CFAbsoluteTimeGetCurrent() - self.startTime;
+    self.eventsPerSecond = elapsed > 0 ? self.eventsExported / elapsed : 0;
+}
+
+- (void)finishWithError:(NSError *)error
+{
+    if (self.finished) {
+        return;
+    }
+    self.finished = YES;
+
+    for (BOXEventsExportWindow *window in self.activeWindows) {
+        [window.request cancel];
+        window.request = nil;
+    }
+    [self.activeWindows removeAllObjects];
+    [self.pendingWindows removeAllObjects];
+    [self.boundaryEventIDs removeAllObjects];
+
+    NSError *closeError = nil;
+    if (![self.sink closeWithError:&closeError] && error == nil) {
+        error = closeError;
+    }
+    [self updateThroughputWithWrittenCount:0];
+
+    BOXEventsExportCompletionBlock completionBlock = self.completionBlock;
+    self.completionBlock = nil;
+    if (completionBlock) {
+        unsigned long long eventsExported = self.eventsExported;
+        double eventsPerSecond = self.eventsPerSecond;
+        [BOXDispatchHelper callCompletionBlock:^{
+            completionBlock(eventsExported, eventsPerSecond, error);
+        } onMainThread:YES];
+    }
+}
+
+@end
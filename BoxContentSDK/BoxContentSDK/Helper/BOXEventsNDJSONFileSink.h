@@ -0,0 +1,23 @@
+//
+//  BOXEventsNDJSONFileSink.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+#import "BOXEventsAdminLogsExporter.h"
+
+/**
+ *  Writes each exported event as one line of JSON (the event as returned by the API) to a file.
+ *  Writes are buffered and flushed in chunks. Once closed, the sink keeps the file as it is: closing it again does
+ *  nothing and writing fails.
+ */
+@interface BOXEventsNDJSONFileSink : NSObject <BOXEventsExportSink>
+
+@property (nonatomic, readonly, strong) NSURL *fileURL;
+
+/**
+ *  @param fileURL Local file to write to. It is created, or truncated if it already exists.
+ */
+- (instancetype)initWithFileURL:(NSURL *)fileURL;
+
+@end
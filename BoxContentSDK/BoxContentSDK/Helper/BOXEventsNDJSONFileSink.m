@@ -0,0 +1,110 @@
+//
+//  BOXEventsNDJSONFileSink.m
+//  BoxContentSDK
+//
+
+#import "BOXEventsNDJSONFileSink.h"
+#import "BOXEvent.h"
+
+#define BOX_NDJSON_SINK_FLUSH_THRESHOLD (256 * 1024)
+
+@interface BOXEventsNDJSONFileSink ()
+
+@property (nonatomic, readwrite, strong) NSURL *fileURL;
+@property (nonatomic, readwrite, strong) NSOutputStream *outputStream;
+@property (nonatomic, readwrite, strong) NSMutableData *buffer;
+@property (nonatomic, readwrite, assign) BOOL closed;
+
+@end
+
+@implementation BOXEventsNDJSONFileSink
+
+- (instancetype)initWithFileURL:(NSURL *)fileURL
+{
+    if (self = [super init]) {
+        _fileURL = fileURL;
+        _buffer = [NSMutableData dataWithCapacity:BOX_NDJSON_SINK_FLUSH_THRESHOLD];
+    }
+    return self;
+}
+
+- (BOOL)writeEvent:(BOXEvent *)event error:(NSError **)error
+{
+    if (self.closed) {
+        if (error) {
+            *error = [self writeError];
+        }
+        return NO;
+    }
+    [self openIfNeeded];
+
+    NSData *line = [NSJSONSerialization dataWithJSONObject:event.JSONData options:0 error:error];
+    if (line == nil) {
+        return NO;
+    }
+    [self.buffer appendData:line];
+    [self.buffer appendBytes:"\n" length:1];
+
+    if (self.buffer.length >= BOX_NDJSON_SINK_FLUSH_THRESHOLD) {
+        return [self flushWithError:error];
+    }
+    return YES;
+}
+
+- (BOOL)closeWithError:(NSError **)error
+{
+    // Opening again would truncate the file.
+    if (self.closed) {
+        return YES;
+    }
+    // Creates the file even when no event was written.
+    [self openIfNeeded];
+    BOOL success = [self flushWithError:error];
+    [self.outputStream close];
+    self.outputStream = nil;
+    self.closed = YES;
+    return success;
+}
+
+- (void)openIfNeeded
+{
+    if (self.outputStream == nil) {
+        self.outputStream = [NSOutputStream outputStreamWithURL:self.fileURL append:NO];
+        [self.outputStream open];
+    }
+}
+
+- (BOOL)flushWithError:(NSError **)error
+{
+    // Failing to open, e.g. in a missing directory, is only reported through the stream status.
+    if (self.outputStream.streamStatus == NSStreamStatusError) {
+        if (error) {
+            *error = self.outputStream.streamError ?: [self writeError];
+        }
+        return NO;
+    }
+
+    const uint8_t *bytes = self.buffer.bytes;
+    NSUInteger remaining = self.buffer.length;
+
+    while (remaining > 0) {
+        NSInteger written = [self.outputStream write:bytes maxLength:remaining];
+        if (written <= 0) {
+            if (error) {
+                *error = self.outputStream.streamError ?: [self writeError];
+            }
+            return NO;
+        }
+        bytes += written;
+        remaining -= written;
+    }
+    self.buffer.length = 0;
+    return YES;
+}
+
+- (NSError *)writeError
+{
+    return [[NSError alloc] initWithDomain:NSCocoaErrorDomain code:NSFileWriteUnknownError userInfo:@{NSURLErrorKey : self.fileURL}];
+}
+
+@end
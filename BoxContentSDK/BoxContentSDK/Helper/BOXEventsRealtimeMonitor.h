@@ -0,0 +1,54 @@
+//
+//  BOXEventsRealtimeMonitor.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+#import "BOXRequest.h"
+#import "BOXEventsRequest.h"
+
+@class BOXContentClient;
+
+/**
+ *  BOXEventsRealtimeMonitor keeps an event stream position current using long-poll notifications
+ *  instead of periodic polling.
+ *
+ *  Once started, the monitor retrieves a realtime server (OPTIONS /events), parks a long-poll
+ *  connection on it and, as soon as the server reports a new change, fetches the events past the
+ *  saved stream position and hands them to eventsBlock. Reconnect messages, expired servers and
+ *  network failures are handled automatically, with an exponential backoff on repeated failures.
+ *
+ *  All requests go through the client's queue manager.
+ */
+@interface BOXEventsRealtimeMonitor : NSObject
+
+/**
+ *  The position in the event stream of the last events delivered. If nil when the monitor is
+ *  started, the monitor starts from the current position of the stream and only reports new events.
+ */
+@property (atomic, readonly, strong) NSString *streamPosition;
+
+/**
+ *  The event stream to monitor. Defaults to BOXEventsStreamTypeAll.
+ */
+@property (nonatomic, readwrite, assign) BOXEventsStreamType streamType;
+
+/**
+ *  Maximum number of events to fetch per page. Defaults to the API's default.
+ */
+@property (nonatomic, readwrite, assign) NSInteger limit;
+
+/**
+ *  Called on the main thread for each page of new events. If the monitor stops because of an
+ *  unrecoverable error (e.g. the user is no longer authorized), it is called once with that error.
+ */
+@property (nonatomic, readwrite, copy) BOXEventsBlock eventsBlock;
+
+@property (atomic, readonly, assign, getter=isRunning) BOOL running;
+
+- (instancetype)initWithClient:(BOXContentClient *)client streamPosition:(NSString *)streamPosition;
+
+- (void)start;
+- (void)stop;
+
+@end
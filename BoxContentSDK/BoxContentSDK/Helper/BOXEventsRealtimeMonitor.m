@@ -0,0 +1,246 @@
+//
+//  BOXEventsRealtimeMonitor.m
+//  BoxContentSDK
+//
+
+#import "BOXEventsRealtimeMonitor.h"
+
+#import "BOXContentClient+Event.h"
+#import "BOXEventsRealtimeServerRequest.h"
+#import "BOXEventsLongPollRequest.h"
+#import "BOXRealtimeServer.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXDispatchHelper.h"
+#import "BOXLog.h"
+
+#define BOX_REALTIME_DEFAULT_EVENTS_LIMIT (100)
+#define BOX_REALTIME_MAX_BACKOFF_INTERVAL (60.0)
+
+@interface BOXEventsRealtimeMonitor ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (atomic, readwrite, strong) NSString *streamPosition;
+@property (atomic, readwrite, assign, getter=isRunning) BOOL running;
+
+// All of the properties below are only accessed on queue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+@property (nonatomic, readwrite, strong) BOXRealtimeServer *realtimeServer;
+@property (nonatomic, readwrite, strong) BOXRequest *currentRequest;
+@property (nonatomic, readwrite, assign) NSInteger reconnectCount;
+@property (nonatomic, readwrite, assign) NSUInteger consecutiveFailureCount;
+@property (nonatomic, readwrite, assign) NSUInteger generation;
+
+@end
+
+@implementation BOXEventsRealtimeMonitor
+
+- (instancetype)initWithClient:(BOXContentClient *)client streamPosition:(NSString *)streamPosition
+{
+    if (self = [super init]) {
+        _client = client;
+        _streamPosition = streamPosition;
+        _streamType = BOXEventsStreamTypeAll;
+        _queue = dispatch_queue_create("com.box.contentsdk.eventsrealtimemonitor", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+- (void)start
+{
+    dispatch_async(self.queue, ^{
+        if (self.running) {
+            return;
+        }
+        self.running = YES;
+        self.generation++;
+        self.consecutiveFailureCount = 0;
+
+        if (self.streamPosition.length == 0) {
+            [self fetchCurrentStreamPosition];
+        } else {
+            [self fetchRealtimeServer];
+        }
+    });
+}
+
+- (void)stop
+{
+    dispatch_async(self.queue, ^{
+        self.running = NO;
+        self.generation++;
+        [self.currentRequest cancel];
+        self.currentRequest = nil;
+        self.realtimeServer = nil;
+    });
+}
+
+#pragma mark - State machine (called on queue)
+
+// Completion blocks of the requests below are called on the operation thread. Hop back onto
+// our queue and drop the result if the monitor was stopped or restarted in the meantime.
+- (void)performOnQueueForGeneration:(NSUInteger)generation block:(dispatch_block_t)block
+{
+    dispatch_async(self.queue, ^{
+        if (self.running && self.generation == generation) {
+            block();
+        }
+    });
+}
+
+- (void)fetchCurrentStreamPosition
+{
+    NSUInteger generation = self.generation;
+    BOXEventsRequest *request = [self.client eventsRequestForCurrentUser];
+    request.streamPosition = BOXAPIEventStreamPositionNow;
+    request.streamType = self.streamType;
+    self.currentRequest = request;
+
+    [request performRequestWithCompletion:^(NSArray<BOXEvent *> *events, NSString *nextStreamPosition, NSError *error) {
+        [self performOnQueueForGeneration:generation block:^{
+            if (error == nil) {
+                self.streamPosition = nextStreamPosition;
+                self.consecutiveFailureCount = 0;
+                [self fetchRealtimeServer];
+            } else {
+                [self handleError:error retryBlock:^{
+                    [self fetchCurrentStreamPosition];
+                }];
+            }
+        }];
+    }];
+}
+
+- (void)fetchRealtimeServer
+{
+    NSUInteger generation = self.generation;
+    BOXEventsRealtimeServerRequest *request = [self.client eventsRealtimeServerRequest];
+    self.currentRequest = request;
+
+    [request performRequestWithCompletion:^(BOXRealtimeServer *realtimeServer, NSError *error) {
+        [self performOnQueueForGeneration:generation block:^{
+            if (error == nil) {
+                self.realtimeServer = realtimeServer;
+                self.reconnectCount = 0;
+                self.consecutiveFailureCount = 0;
+                [self openLongPoll];
+            } else {
+                [self handleError:error retryBlock:^{
+                    [self fetchRealtimeServer];
+                }];
+            }
+        }];
+    }];
+}
+
+- (void)openLongPoll
+{
+    NSUInteger generation = self.generation;
+    BOXEventsLongPollRequest *request = [self.client eventsLongPollRequestWithRealtimeServer:self.realtimeServer
+                                                                             streamPosition:self.streamPosition];
+    self.currentRequest = request;
+
+    [request performRequestWithCompletion:^(NSString *message, NSError *error) {
+        [self performOnQueueForGeneration:generation block:^{
+            if (error == nil) {
+                self.consecutiveFailureCount = 0;
+                if ([message isEqualToString:BOXAPIEventLongPollMessageNewChange]) {
+                    [self fetchEvents];
+                } else {
+                    [self reconnect];
+                }
+            } else if ([error.domain isEqualToString:NSURLErrorDomain] && error.code == NSURLErrorTimedOut) {
+                // The server did not answer within retry_timeout, which is equivalent to a reconnect message.
+                [self reconnect];
+            } else {
+                // The realtime server may have gone away; start over with a new one.
+                [self handleError:error retryBlock:^{
+                    [self fetchRealtimeServer];
+                }];
+            }
+        }];
+    }];
+}
+
+- (void)reconnect
+{
+    self.reconnectCount++;
+    if (self.realtimeServer.maxRetries > 0 && self.reconnectCount >= self.realtimeServer.maxRetries) {
+        BOXLog(@"Realtime server %@ exhausted its retries, fetching a new one", self.realtimeServer.URL);
+        [self fetchRealtimeServer];
+    } else {
+        [self openLongPoll];
+    }
+}
+
+- (void)fetchEvents
+{
+    NSUInteger generation = self.generation;
+    BOXEventsRequest *request = [self.client eventsRequestForCurrentUser];
+    request.streamPosition = self.streamPosition;
+    request.streamType = self.streamType;
+    request.limit = self.limit;
+    self.currentRequest = request;
+
+    NSInteger pageSize = self.limit > 0 ? self.limit : BOX_REALTIME_DEFAULT_EVENTS_LIMIT;
+
+    [request performRequestWithCompletion:^(NSArray<BOXEvent *> *events, NSString *nextStreamPosition, NSError *error) {
+        [self performOnQueueForGeneration:generation block:^{
+            if (error == nil) {
+                self.streamPosition = nextStreamPosition;
+                self.consecutiveFailureCount = 0;
+
+                if (events.count > 0) {
+                    [self deliverEvents:events streamPosition:nextStreamPosition error:nil];
+                }
+
+                if ((NSInteger)events.count >= pageSize) {
+                    // A full page means more changes are likely waiting; drain them before parking again.
+                    [self fetchEvents];
+                } else {
+                    [self reconnect];
+                }
+            } else {
+                [self handleError:error retryBlock:^{
+                    [self fetchEvents];
+                }];
+            }
+        }];
+    }];
+}
+
+- (void)handleError:(NSError *)error retryBlock:(dispatch_block_t)retryBlock
+{
+    self.currentRequest = nil;
+
+    if ([error.domain isEqualToString:BOXContentSDKErrorDomain] &&
+        (error.code == BOXContentSDKAPIErrorUnauthorized || error.code == BOXContentSDKAPIErrorForbidden)) {
+        BOXLog(@"Realtime events monitor stopping after unrecoverable error %@", error);
+        self.running = NO;
+        self.generation++;
+        [self deliverEvents:nil streamPosition:nil error:error];
+        return;
+    }
+
+    NSTimeInterval delay = MIN(pow(2.0, self.consecutiveFailureCount), BOX_REALTIME_MAX_BACKOFF_INTERVAL);
+    self.consecutiveFailureCount++;
+
+    NSUInteger generation = self.generation;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        if (self.running && self.generation == generation) {
+            retryBlock();
+        }
+    });
+}
+
+- (void)deliverEvents:(NSArray<BOXEvent *> *)events streamPosition:(NSString *)streamPosition error:(NSError *)error
+{
+    BOXEventsBlock eventsBlock = self.eventsBlock;
+    if (eventsBlock) {
+        [BOXDispatchHelper callCompletionBlock:^{
+            eventsBlock(events, streamPosition, error);
+        } onMainThread:YES];
+    }
+}
+
+@end
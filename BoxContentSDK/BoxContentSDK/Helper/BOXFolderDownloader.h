@@ -0,0 +1,86 @@
+//
+//  BOXFolderDownloader.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXContentClient;
+
+/**
+ *  Called on the main thread as files are downloaded. totalBytes grows while the folder is still being
+ *  listed, so estimatedTimeRemaining is only an estimate of the files discovered so far. It is negative
+ *  until enough data has been received to measure the throughput.
+ */
+typedef void (^BOXFolderDownloadProgressBlock)(unsigned long long bytesDownloaded,
+                                                unsigned long long totalBytes,
+                                                double bytesPerSecond,
+                                                NSTimeInterval estimatedTimeRemaining);
+
+/**
+ *  Called on the main thread once every file has been downloaded or skipped, or the download failed or was
+ *  cancelled. If some files could not be downloaded, error is the first error encountered.
+ */
+typedef void (^BOXFolderDownloadCompletionBlock)(NSUInteger filesDownloaded, NSUInteger filesSkipped, NSError *error);
+
+/**
+ *  BOXFolderDownloader downloads a folder and everything below it to a local directory.
+ *
+ *  Transfers start as soon as the listing discovers files, so listing and downloading overlap instead of
+ *  running one after the other:
+ *  - Files smaller than smallFileThreshold run on the small downloads queue, next to thumbnails, so they
+ *    are not held up behind large files on the two slot downloads queue.
+ *  - Files larger than multipartThreshold are fetched as several byte ranges that share the large file
+ *    slots, and are put back together once all of them are received.
+ *  - Files whose local copy already has the same size and SHA1 as on Box are skipped.
+ *
+ *  Data is received into a staging directory inside destinationPath and only moved into place once a file
+ *  is complete. Starting a new downloader with the same folder and destination after the app was terminated
+ *  or the download was cancelled resumes it: complete files are skipped by their SHA1 and partial ones
+ *  continue from the bytes already received.
+ */
+@interface BOXFolderDownloader : NSObject
+
+@property (nonatomic, readonly, copy) NSString *folderID;
+@property (nonatomic, readonly, copy) NSString *destinationPath;
+
+/**
+ *  Maximum number of large file transfers in flight. Defaults to 2, the width of the queue manager's
+ *  downloads queue; raising it only helps if that queue is widened too.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentDownloads;
+
+/**
+ *  Maximum number of small file transfers in flight. Defaults to 6.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentSmallDownloads;
+
+/**
+ *  Files smaller than this many bytes are small transfers. Defaults to 1 MB.
+ */
+@property (nonatomic, readwrite, assign) unsigned long long smallFileThreshold;
+
+/**
+ *  Files of at least this many bytes are fetched as several byte ranges. Defaults to 64 MB.
+ */
+@property (nonatomic, readwrite, assign) unsigned long long multipartThreshold;
+
+/**
+ *  Number of byte ranges a multipart file is split into. Defaults to 4.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger partCount;
+
+@property (nonatomic, readwrite, copy) BOXFolderDownloadProgressBlock progressBlock;
+
+@property (atomic, readonly, assign) NSUInteger filesDownloaded;
+@property (atomic, readonly, assign) NSUInteger filesSkipped;
+@property (atomic, readonly, assign) unsigned long long bytesDownloaded;
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+                      folderID:(NSString *)folderID
+               destinationPath:(NSString *)destinationPath;
+
+- (void)startWithCompletion:(BOXFolderDownloadCompletionBlock)completionBlock;
+- (void)cancel;
+
+@end
@@ -0,0 +1,618 @@
+//
+//  BOXFolderDownloader.m
+//  BoxContentSDK
+//
+
+#import "BOXFolderDownloader.h"
+
+#import "BOXContentClient+File.h"
+#import "BOXContentClient+Folder.h"
+#import "BOXFileDownloadRequest.h"
+#import "BOXFolderTreeWalker.h"
+#import "BOXFile.h"
+#import "BOXStreamingHashHelper.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXDispatchHelper.h"
+#import "BOXLog.h"
+
+#define BOX_FOLDER_DOWNLOAD_DEFAULT_MAX_CONCURRENT_DOWNLOADS (2)
+#define BOX_FOLDER_DOWNLOAD_DEFAULT_MAX_CONCURRENT_SMALL_DOWNLOADS (6)
+#define BOX_FOLDER_DOWNLOAD_DEFAULT_SMALL_FILE_THRESHOLD (1024ull * 1024ull)
+#define BOX_FOLDER_DOWNLOAD_DEFAULT_MULTIPART_THRESHOLD (64ull * 1024ull * 1024ull)
+#define BOX_FOLDER_DOWNLOAD_DEFAULT_PART_COUNT (4)
+#define BOX_FOLDER_DOWNLOAD_MAX_RETRIES (3)
+#define BOX_FOLDER_DOWNLOAD_MAX_BACKOFF_INTERVAL (60.0)
+#define BOX_FOLDER_DOWNLOAD_PROGRESS_INTERVAL (0.25)
+#define BOX_FOLDER_DOWNLOAD_IO_BUFFER_SIZE (1024 * 1024)
+
+static NSString *const BOXFolderDownloadStagingDirectoryName = @".boxdownload";
+
+@interface BOXFolderDownloadFile : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *fileID;
+@property (nonatomic, readwrite, copy) NSString *path;
+@property (nonatomic, readwrite, copy) NSString *SHA1;
+@property (nonatomic, readwrite, assign) unsigned long long size;
+@property (nonatomic, readwrite, strong) NSArray *partPaths;
+@property (nonatomic, readwrite, assign) NSUInteger remainingPartCount;
+@property (nonatomic, readwrite, assign) BOOL failed;
+
+@end
+
+@implementation BOXFolderDownloadFile
+@end
+
+// One byte range of a file, received into its own staging file.
+@interface BOXFolderDownloadTransfer : NSObject
+
+@property (nonatomic, readwrite, strong) BOXFolderDownloadFile *file;
+@property (nonatomic, readwrite, assign) unsigned long long offset;
+@property (nonatomic, readwrite, assign) unsigned long long length;
+@property (nonatomic, readwrite, copy) NSString *stagingPath;
+// Bytes of the range already in the staging file when the current attempt started.
+@property (nonatomic, readwrite, assign) unsigned long long stagedLength;
+// Bytes received by the current attempt.
+@property (nonatomic, readwrite, assign) unsigned long long receivedLength;
+@property (nonatomic, readwrite, assign) BOOL isSmall;
+@property (nonatomic, readwrite, assign) NSUInteger retryCount;
+@property (nonatomic, readwrite, strong) BOXFileDownloadRequest *request;
+
+@end
+
+@implementation BOXFolderDownloadTransfer
+@end
+
+@interface BOXFolderDownloader ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, copy) NSString *folderID;
+@property (nonatomic, readwrite, copy) NSString *destinationPath;
+@property (nonatomic, readwrite, copy) NSString *stagingPath;
+@property (atomic, readwrite, assign) NSUInteger filesDownloaded;
+@property (atomic, readwrite, assign) NSUInteger filesSkipped;
+@property (atomic, readwrite, assign) unsigned long long bytesDownloaded;
+
+// All of the properties below are only accessed on queue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+// Hashing of local files and assembly of downloaded ones, kept off queue so transfers keep flowing.
+@property (nonatomic, readwrite, strong) dispatch_queue_t IOQueue;
+@property (nonatomic, readwrite, strong) BOXFolderTreeWalker *walker;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *folderPaths;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingSmallTransfers;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingTransfers;
+@property (nonatomic, readwrite, strong) NSMutableSet *activeTransfers;
+@property (nonatomic, readwrite, assign) NSUInteger activeSmallTransferCount;
+@property (nonatomic, readwrite, assign) NSUInteger waitingTransferCount;
+@property (nonatomic, readwrite, assign) NSUInteger pendingIOCount;
+@property (nonatomic, readwrite, assign) unsigned long long totalBytes;
+@property (nonatomic, readwrite, assign) CFAbsoluteTime lastSampleTime;
+@property (nonatomic, readwrite, assign) unsigned long long lastSampleBytes;
+@property (nonatomic, readwrite, assign) double bytesPerSecond;
+@property (nonatomic, readwrite, assign) BOOL progressReportScheduled;
+@property (nonatomic, readwrite, strong) NSError *firstError;
+@property (nonatomic, readwrite, copy) BOXFolderDownloadCompletionBlock completionBlock;
+@property (nonatomic, readwrite, assign) BOOL walkFinished;
+@property (nonatomic, readwrite, assign) BOOL started;
+@property (nonatomic, readwrite, assign) BOOL finished;
+
+@end
+
+@implementation BOXFolderDownloader
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+                      folderID:(NSString *)folderID
+               destinationPath:(NSString *)destinationPath
+{
+    if (self = [super init]) {
+        _client = client;
+        _folderID = [folderID copy];
+        _destinationPath = [destinationPath copy];
+        _stagingPath = [destinationPath stringByAppendingPathComponent:BOXFolderDownloadStagingDirectoryName];
+        _maxConcurrentDownloads = BOX_FOLDER_DOWNLOAD_DEFAULT_MAX_CONCURRENT_DOWNLOADS;
+        _maxConcurrentSmallDownloads = BOX_FOLDER_DOWNLOAD_DEFAULT_MAX_CONCURRENT_SMALL_DOWNLOADS;
+        _smallFileThreshold = BOX_FOLDER_DOWNLOAD_DEFAULT_SMALL_FILE_THRESHOLD;
+        _multipartThreshold = BOX_FOLDER_DOWNLOAD_DEFAULT_MULTIPART_THRESHOLD;
+        _partCount = BOX_FOLDER_DOWNLOAD_DEFAULT_PART_COUNT;
+        _queue = dispatch_queue_create("com.box.contentsdk.folderdownloader", DISPATCH_QUEUE_SERIAL);
+        _IOQueue = dispatch_queue_create("com.box.contentsdk.folderdownloader.io", DISPATCH_QUEUE_SERIAL);
+        _folderPaths = [NSMutableDictionary dictionary];
+        _pendingSmallTransfers = [NSMutableArray array];
+        _pendingTransfers = [NSMutableArray array];
+        _activeTransfers = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (void)startWithCompletion:(BOXFolderDownloadCompletionBlock)completionBlock
+{
+    dispatch_async(self.queue, ^{
+        if (self.started) {
+            return;
+        }
+        self.started = YES;
+        self.completionBlock = completionBlock;
+        self.lastSampleTime = CFAbsoluteTimeGetCurrent();
+
+        NSError *error = nil;
+        if (![[NSFileManager defaultManager] createDirectoryAtPath:self.stagingPath withIntermediateDirectories:YES attributes:nil error:&error]) {
+            [self finishWithError:error];
+            return;
+        }
+        self.folderPaths[self.folderID] = self.destinationPath;
+
+        // Files are queued for transfer as soon as a page of the listing comes back.
+        BOXFolderTreeWalker *walker = [self.client folderTreeWalkerWithRootFolderID:self.folderID];
+        walker.fields = @[BOXAPIObjectKeySize, BOXAPIObjectKeySHA1];
+        walker.itemsBlock = ^(NSArray<BOXItem *> *items, NSString *folderID) {
+            dispatch_async(self.queue, ^{
+                [self handleItems:items inFolderWithID:folderID];
+            });
+        };
+        self.walker = walker;
+
+        [walker startWithCompletion:^(unsigned long long itemCount, NSError *walkError) {
+            dispatch_async(self.queue, ^{
+                if (self.finished) {
+                    return;
+                }
+                self.walker = nil;
+                if (walkError) {
+                    [self finishWithError:walkError];
+                    return;
+                }
+                self.walkFinished = YES;
+                [self scheduleTransfers];
+            });
+        }];
+    });
+}
+
+- (void)cancel
+{
+    dispatch_async(self.queue, ^{
+        if (self.started && !self.finished) {
+            NSError *error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
+            [self finishWithError:error];
+        }
+    });
+}
+
+#pragma mark - Listing (called on queue)
+
+- (void)handleItems:(NSArray<BOXItem *> *)items inFolderWithID:(NSString *)folderID
+{
+    if (self.finished) {
+        return;
+    }
+
+    // The walker lists a folder only after the page of its parent that contains it, so its path is known.
+    NSString *parentPath = self.folderPaths[folderID];
+    if (parentPath == nil) {
+        BOXLog(@"Folder download received items of unknown folder %@", folderID);
+        return;
+    }
+
+    for (BOXItem *item in items) {
+        NSString *path = [parentPath stringByAppendingPathComponent:[self fileNameForItem:item]];
+        if (item.isFolder) {
+            self.folderPaths[item.modelID] = path;
+            NSError *error = nil;
+            if (![[NSFileManager defaultManager] createDirectoryAtPath:path withIntermediateDirectories:YES attributes:nil error:&error]) {
+                [self finishWithError:error];
+                return;
+            }
+        } else if (item.isFile) {
+            BOXFolderDownloadFile *file = [[BOXFolderDownloadFile alloc] init];
+            file.fileID = item.modelID;
+            file.path = path;
+            file.SHA1 = ((BOXFile *)item).SHA1;
+            file.size = [item.size unsignedLongLongValue];
+            [self checkLocalCopyOfFile:file];
+        }
+    }
+}
+
+- (NSString *)fileNameForItem:(BOXItem *)item
+{
+    NSString *name = [item.name stringByReplacingOccurrencesOfString:@"/" withString:@"_"];
+    if (name.length == 0 || [name isEqualToString:@"."] || [name isEqualToString:@".."] ||
+        [name isEqualToString:BOXFolderDownloadStagingDirectoryName]) {
+        name = [NSString stringWithFormat:@"%@ (%@)", name, item.modelID];
+    }
+    return name;
+}
+
+- (void)checkLocalCopyOfFile:(BOXFolderDownloadFile *)file
+{
+    self.pendingIOCount++;
+    dispatch_async(self.IOQueue, ^{
+        BOOL isCurrent = [self localFileAtPath:file.path matchesFile:file];
+        dispatch_async(self.queue, ^{
+            self.pendingIOCount--;
+            if (self.finished) {
+                return;
+            }
+            if (isCurrent) {
+                self.filesSkipped++;
+            } else {
+                [self enqueueTransfersForFile:file];
+            }
+            [self scheduleTransfers];
+        });
+    });
+}
+
+#pragma mark - Transfers (called on queue)
+
+- (void)enqueueTransfersForFile:(BOXFolderDownloadFile *)file
+{
+    if (file.size == 0) {
+        NSError *error = nil;
+        if ([[NSData data] writeToFile:file.path options:NSDataWritingAtomic error:&error]) {
+            self.filesDownloaded++;
+        } else {
+            [self failFile:file withError:error];
+        }
+        return;
+    }
+
+    NSUInteger partCount = 1;
+    if (file.size >= self.multipartThreshold && self.partCount > 1) {
+        partCount = self.partCount;
+    }
+    unsigned long long partLength = (file.size + partCount - 1) / partCount;
+
+    // Staging files are named after the version and split of the file, so a resumed download only continues
+    // from bytes that belong to the same content.
+    NSMutableArray *partPaths = [NSMutableArray arrayWithCapacity:partCount];
+    NSMutableArray *transfers = [NSMutableArray arrayWithCapacity:partCount];
+    for (NSUInteger i = 0; i < partCount; i++) {
+        BOXFolderDownloadTransfer *transfer = [[BOXFolderDownloadTransfer alloc] init];
+        transfer.file = file;
+        transfer.offset = i * partLength;
+        transfer.length = MIN(partLength, file.size - transfer.offset);
+        transfer.isSmall = file.size < self.smallFileThreshold;
+        transfer.stagingPath = [self.stagingPath stringByAppendingPathComponent:
+                                [NSString stringWithFormat:@"%@-%@-%lu-%lu", file.fileID, file.SHA1 ?: @"", (unsigned long)i, (unsigned long)partCount]];
+        [partPaths addObject:transfer.stagingPath];
+        [transfers addObject:transfer];
+    }
+    file.partPaths = partPaths;
+    file.remainingPartCount = partCount;
+
+    for (BOXFolderDownloadTransfer *transfer in transfers) {
+        transfer.stagedLength = [self stagedLengthOfTransfer:transfer];
+        self.totalBytes += transfer.length - transfer.stagedLength;
+        if (transfer.stagedLength == transfer.length) {
+            [self completeTransfer:transfer];
+        } else if (transfer.isSmall) {
+            [self.pendingSmallTransfers addObject:transfer];
+        } else {
+            [self.pendingTransfers addObject:transfer];
+        }
+    }
+}
+
+- (void)scheduleTransfers
+{
+    if (self.finished) {
+        return;
+    }
+
+    while (self.activeSmallTransferCount < MAX(self.maxConcurrentSmallDownloads, 1) && self.pendingSmallTransfers.count > 0) {
+        BOXFolderDownloadTransfer *transfer = self.pendingSmallTransfers.firstObject;
+        [self.pendingSmallTransfers removeObjectAtIndex:0];
+        [self startTransfer:transfer];
+    }
+
+    while (self.activeTransfers.count - self.activeSmallTransferCount < MAX(self.maxConcurrentDownloads, 1) && self.pendingTransfers.count > 0) {
+        BOXFolderDownloadTransfer *transfer = self.pendingTransfers.firstObject;
+        [self.pendingTransfers removeObjectAtIndex:0];
+        [self startTransfer:transfer];
+    }
+
+    if (self.walkFinished && self.pendingIOCount == 0 && self.waitingTransferCount == 0 && self.activeTransfers.count == 0 &&
+        self.pendingSmallTransfers.count == 0 && self.pendingTransfers.count == 0) {
+        [self finishWithError:self.firstError];
+    }
+}
+
+- (void)startTransfer:(BOXFolderDownloadTransfer *)transfer
+{
+    NSOutputStream *outputStream = [NSOutputStream outputStreamToFileAtPath:transfer.stagingPath append:YES];
+    BOXFileDownloadRequest *request = [self.client fileDownloadRequestWithID:transfer.file.fileID toOutputStream:outputStream];
+    request.isSmallDownload = transfer.isSmall;
+    if (transfer.stagedLength > 0 || transfer.length < transfer.file.size) {
+        request.byteRangeOffset = transfer.offset + transfer.stagedLength;
+        request.byteRangeLength = transfer.length - transfer.stagedLength;
+    }
+
+    transfer.request = request;
+    transfer.receivedLength = 0;
+    [self.activeTransfers addObject:transfer];
+    if (transfer.isSmall) {
+        self.activeSmallTransferCount++;
+    }
+
+    [request performRequestWithProgress:^(long long totalBytesTransferred, long long totalBytesExpectedToTransfer) {
+        dispatch_async(self.queue, ^{
+            if (transfer.request != request || totalBytesTransferred < (long long)transfer.receivedLength) {
+                return;
+            }
+            self.bytesDownloaded += totalBytesTransferred - transfer.receivedLength;
+            transfer.receivedLength = totalBytesTransferred;
+            [self scheduleProgressReport];
+        });
+    } completion:^(NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (self.finished || transfer.request != request) {
+                return;
+            }
+            [self removeActiveTransfer:transfer];
+
+            unsigned long long stagedLength = [self stagedLengthOfTransfer:transfer];
+            if (stagedLength < transfer.stagedLength + transfer.receivedLength) {
+                // Staged bytes were discarded; they will be downloaded again.
+                self.totalBytes += transfer.stagedLength + transfer.receivedLength - stagedLength;
+            }
+            transfer.stagedLength = stagedLength;
+
+            if (error == nil && stagedLength != transfer.length) {
+                error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIErrorUnknownStatusCode userInfo:nil];
+            }
+
+            if (error) {
+                [self handleError:error forTransfer:transfer];
+            } else {
+                [self completeTransfer:transfer];
+            }
+            [self scheduleTransfers];
+        });
+    }];
+}
+
+- (void)removeActiveTransfer:(BOXFolderDownloadTransfer *)transfer
+{
+    transfer.request = nil;
+    [self.activeTransfers removeObject:transfer];
+    if (transfer.isSmall) {
+        self.activeSmallTransferCount--;
+    }
+}
+
+// Length of the staging file of transfer. Staging files longer than their range are the result of a server
+// that ignored the range and are discarded.
+- (unsigned long long)stagedLengthOfTransfer:(BOXFolderDownloadTransfer *)transfer
+{
+    unsigned long long length = [[[NSFileManager defaultManager] attributesOfItemAtPath:transfer.stagingPath error:nil] fileSize];
+    if (length > transfer.length) {
+        [[NSFileManager defaultManager] removeItemAtPath:transfer.stagingPath error:nil];
+        length = 0;
+    }
+    return length;
+}
+
+- (void)handleError:(NSError *)error forTransfer:(BOXFolderDownloadTransfer *)transfer
+{
+    BOOL isRetryable = ([error.domain isEqualToString:NSURLErrorDomain] ||
+                        ([error.domain isEqualToString:BOXContentSDKErrorDomain] &&
+                         (error.code == BOXContentSDKAPIErrorTooManyRequests ||
+                          error.code == BOXContentSDKAPIErrorUnknownStatusCode ||
+                          (error.code >= BOXContentSDKAPIErrorInternalServerError && error.code < 600))));
+
+    if (!isRetryable || transfer.retryCount >= BOX_FOLDER_DOWNLOAD_MAX_RETRIES || transfer.file.failed) {
+        [self failFile:transfer.file withError:error];
+        return;
+    }
+
+    NSTimeInterval delay = MIN(pow(2.0, transfer.retryCount), BOX_FOLDER_DOWNLOAD_MAX_BACKOFF_INTERVAL);
+    transfer.retryCount++;
+    self.waitingTransferCount++;
+    BOXLog(@"Folder download retrying file %@ in %.0fs after error %@", transfer.file.fileID, delay, error);
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        self.waitingTransferCount--;
+        if (self.finished) {
+            return;
+        }
+        if (!transfer.file.failed) {
+            [(transfer.isSmall ? self.pendingSmallTransfers : self.pendingTransfers) insertObject:transfer atIndex:0];
+        }
+        [self scheduleTransfers];
+    });
+}
+
+- (void)completeTransfer:(BOXFolderDownloadTransfer *)transfer
+{
+    BOXFolderDownloadFile *file = transfer.file;
+    file.remainingPartCount--;
+    if (file.remainingPartCount > 0 || file.failed) {
+        return;
+    }
+
+    self.pendingIOCount++;
+    dispatch_async(self.IOQueue, ^{
+        NSError *error = nil;
+        BOOL success = [self assemblePartsOfFile:file error:&error];
+        dispatch_async(self.queue, ^{
+            self.pendingIOCount--;
+            if (self.finished) {
+                return;
+            }
+            if (success) {
+                self.filesDownloaded++;
+            } else {
+                [self failFile:file withError:error];
+            }
+            [self scheduleTransfers];
+        });
+    });
+}
+
+- (void)failFile:(BOXFolderDownloadFile *)file withError:(NSError *)error
+{
+    if (file.failed) {
+        return;
+    }
+    file.failed = YES;
+    if (self.firstError == nil) {
+        self.firstError = error;
+    }
+    BOXLog(@"Folder download could not download file %@: %@", file.fileID, error);
+
+    for (BOXFolderDownloadTransfer *transfer in [self.activeTransfers allObjects]) {
+        if (transfer.file == file) {
+            BOXFileDownloadRequest *request = transfer.request;
+            [self removeActiveTransfer:transfer];
+            [request cancel];
+        }
+    }
+    NSPredicate *otherFiles = [NSPredicate predicateWithBlock:^BOOL(BOXFolderDownloadTransfer *transfer, NSDictionary *bindings) {
+        return transfer.file != file;
+    }];
+    [self.pendingSmallTransfers filterUsingPredicate:otherFiles];
+    [self.pendingTransfers filterUsingPredicate:otherFiles];
+}
+
+- (void)finishWithError:(NSError *)error
+{
+    if (self.finished) {
+        return;
+    }
+    self.finished = YES;
+
+    [self.walker cancel];
+    self.walker = nil;
+
+    // Staging files are left in place so that a later download resumes from them.
+    for (BOXFolderDownloadTransfer *transfer in [self.activeTransfers allObjects]) {
+        BOXFileDownloadRequest *request = transfer.request;
+        [self removeActiveTransfer:transfer];
+        [request cancel];
+    }
+    [self.pendingSmallTransfers removeAllObjects];
+    [self.pendingTransfers removeAllObjects];
+
+    if (error == nil) {
+        [[NSFileManager defaultManager] removeItemAtPath:self.stagingPath error:nil];
+    }
+    [self reportProgress];
+
+    BOXFolderDownloadCompletionBlock completionBlock = self.completionBlock;
+    self.completionBlock = nil;
+    if (completionBlock) {
+        NSUInteger filesDownloaded = self.filesDownloaded;
+        NSUInteger filesSkipped = self.filesSkipped;
+        [BOXDispatchHelper callCompletionBlock:^{
+            completionBlock(filesDownloaded, filesSkipped, error);
+        } onMainThread:YES];
+    }
+}
+
+#pragma mark - Progress (called on queue)
+
+- (void)scheduleProgressReport
+{
+    if (self.progressBlock == nil || self.progressReportScheduled) {
+        return;
+    }
+    self.progressReportScheduled = YES;
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(BOX_FOLDER_DOWNLOAD_PROGRESS_INTERVAL * NSEC_PER_SEC)), self.queue, ^{
+        self.progressReportScheduled = NO;
+        if (!self.finished) {
+            [self reportProgress];
+        }
+    });
+}
+
+- (void)reportProgress
+{
+    BOXFolderDownloadProgressBlock progressBlock = self.progressBlock;
+    if (progressBlock == nil) {
+        return;
+    }
+
+    // The throughput is a moving average so that the estimate does not swing with every small file.
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    CFAbsoluteTime elapsed = now - self.lastSampleTime;
+    unsigned long long bytesDownloaded = self.bytesDownloaded;
+    if (elapsed > 0) {
+        double sample = (bytesDownloaded - self.lastSampleBytes) / elapsed;
+        self.bytesPerSecond = self.bytesPerSecond > 0 ? 0.7 * self.bytesPerSecond + 0.3 * sample : sample;
+        self.lastSampleTime = now;
+        self.lastSampleBytes = bytesDownloaded;
+    }
+
+    unsigned long long totalBytes = MAX(self.totalBytes, bytesDownloaded);
+    double bytesPerSecond = self.bytesPerSecond;
+    NSTimeInterval estimatedTimeRemaining = bytesPerSecond > 0 ? (totalBytes - bytesDownloaded) / bytesPerSecond : -1;
+
+    [BOXDispatchHelper callCompletionBlock:^{
+        progressBlock(bytesDownloaded, totalBytes, bytesPerSecond, estimatedTimeRemaining);
+    } onMainThread:YES];
+}
+
+#pragma mark - Files (called on IOQueue)
+
+- (BOOL)localFileAtPath:(NSString *)path matchesFile:(BOXFolderDownloadFile *)file
+{
+    NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:path error:nil];
+    if (attributes == nil || [attributes fileSize] != file.size || file.SHA1.length == 0) {
+        return NO;
+    }
+
+    NSInputStream *inputStream = [NSInputStream inputStreamWithFileAtPath:path];
+    [inputStream open];
+    BOXStreamingHashHelper *hashHelper = [[BOXStreamingHashHelper alloc] init];
+    [hashHelper open];
+
+    NSMutableData *buffer = [NSMutableData dataWithLength:BOX_FOLDER_DOWNLOAD_IO_BUFFER_SIZE];
+    NSInteger length = 0;
+    while ((length = [inputStream read:buffer.mutableBytes maxLength:buffer.length]) > 0) {
+        @autoreleasepool {
+            [hashHelper processData:[NSData dataWithBytesNoCopy:buffer.mutableBytes length:length freeWhenDone:NO]];
+        }
+    }
+    [inputStream close];
+    NSString *SHA1 = [hashHelper close];
+
+    return length == 0 && [SHA1 caseInsensitiveCompare:file.SHA1] == NSOrderedSame;
+}
+
+- (BOOL)assemblePartsOfFile:(BOXFolderDownloadFile *)file error:(NSError **)error
+{
+    NSFileManager *fileManager = [NSFileManager defaultManager];
+    NSString *firstPartPath = file.partPaths.firstObject;
+
+    if (file.partPaths.count > 1) {
+        NSFileHandle *outputHandle = [NSFileHandle fileHandleForWritingAtPath:firstPartPath];
+        [outputHandle seekToEndOfFile];
+        for (NSString *partPath in [file.partPaths subarrayWithRange:NSMakeRange(1, file.partPaths.count - 1)]) {
+            NSFileHandle *inputHandle = [NSFileHandle fileHandleForReadingAtPath:partPath];
+            if (inputHandle == nil || outputHandle == nil) {
+                [outputHandle closeFile];
+                if (error) {
+                    *error = [[NSError alloc] initWithDomain:NSCocoaErrorDomain code:NSFileReadNoSuchFileError userInfo:@{NSFilePathErrorKey : partPath}];
+                }
+                return NO;
+            }
+            NSData *data = nil;
+            do {
+                @autoreleasepool {
+                    data = [inputHandle readDataOfLength:BOX_FOLDER_DOWNLOAD_IO_BUFFER_SIZE];
+                    [outputHandle writeData:data];
+                }
+            } while (data.length > 0);
+            [inputHandle closeFile];
+            [fileManager removeItemAtPath:partPath error:nil];
+        }
+        [outputHandle closeFile];
+    }
+
+    [fileManager removeItemAtPath:file.path error:nil];
+    return [fileManager moveItemAtPath:firstPartPath toPath:file.path error:error];
+}
+
+@end
@@ -0,0 +1,75 @@
+//
+//  BOXFolderTreeWalker.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXContentClient;
+@class BOXItem;
+
+/**
+ *  Called on the walker's private serial queue with each page of items discovered in a folder.
+ */
+typedef void (^BOXFolderTreeWalkerItemsBlock)(NSArray<BOXItem *> *items, NSString *folderID);
+
+/**
+ *  Called on the main thread once the walk is finished, failed or was cancelled.
+ */
+typedef void (^BOXFolderTreeWalkerCompletionBlock)(unsigned long long itemCount, NSError *error);
+
+/**
+ *  BOXFolderTreeWalker enumerates every item below a folder.
+ *
+ *  Folders are explored breadth-first by a bounded pool of listing requests. Every page of a folder is a
+ *  separate unit of work in a shared queue: once the first page of a large folder reveals its size, its
+ *  other pages are queued and picked up by whichever listing slot is free, so one large folder does not
+ *  serialize the walk. Only the fields set in fields are requested.
+ *
+ *  When the API reports a rate limit (HTTP 429), all listings pause with an exponential backoff, so the walk
+ *  runs as fast as the rate limit allows rather than at one round trip per level.
+ *
+ *  If checkpointFileURL is set, the queue of pending work is saved there as the walk progresses and a later
+ *  walk with the same checkpoint file resumes where the previous one stopped. Pages in flight when a walk
+ *  stopped are listed again, so items may be delivered more than once across a resume.
+ */
+@interface BOXFolderTreeWalker : NSObject
+
+@property (nonatomic, readonly, copy) NSString *rootFolderID;
+
+/**
+ *  Item fields to request in addition to type, id and name, which are always requested.
+ */
+@property (nonatomic, readwrite, copy) NSArray<NSString *> *fields;
+
+/**
+ *  Maximum number of listing requests in flight. Defaults to 4.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentListings;
+
+/**
+ *  Number of items requested per page. Defaults to 1000, the maximum allowed by the API.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger pageSize;
+
+@property (nonatomic, readwrite, copy) BOXFolderTreeWalkerItemsBlock itemsBlock;
+
+/**
+ *  If set, the JSON of every item discovered is appended to this file, one item per line.
+ */
+@property (nonatomic, readwrite, strong) NSURL *itemsFileURL;
+
+/**
+ *  If set, progress is saved to this file so that an interrupted walk can be resumed. The file is
+ *  removed once the walk completes.
+ */
+@property (nonatomic, readwrite, strong) NSURL *checkpointFileURL;
+
+@property (atomic, readonly, assign) unsigned long long itemCount;
+
+- (instancetype)initWithClient:(BOXContentClient *)client rootFolderID:(NSString *)rootFolderID;
+
+- (void)startWithCompletion:(BOXFolderTreeWalkerCompletionBlock)completionBlock;
+- (void)cancel;
+
+@end
@@ -0,0 +1,348 @@
+//
+//  BOXFolderTreeWalker.m
+//  BoxContentSDK
+//
+
+#import "BOXFolderTreeWalker.h"
+
+#import "BOXContentClient+Folder.h"
+#import "BOXFolderPaginatedItemsRequest.h"
+#import "BOXItem.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXDispatchHelper.h"
+#import "BOXLog.h"
+
+#define BOX_TREE_WALKER_DEFAULT_MAX_CONCURRENT_LISTINGS (4)
+#define BOX_TREE_WALKER_DEFAULT_PAGE_SIZE (1000)
+#define BOX_TREE_WALKER_MAX_RETRIES (3)
+#define BOX_TREE_WALKER_MAX_BACKOFF_INTERVAL (60.0)
+#define BOX_TREE_WALKER_CHECKPOINT_TASK_INTERVAL (20)
+
+static NSString *const BOXTreeWalkerCheckpointKeyPendingTasks = @"pending_tasks";
+static NSString *const BOXTreeWalkerCheckpointKeyItemCount = @"item_count";
+
+// A page of a folder to list.
+@interface BOXFolderTreeWalkerTask : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *folderID;
+@property (nonatomic, readwrite, assign) NSUInteger offset;
+@property (nonatomic, readwrite, assign) NSUInteger retryCount;
+@property (nonatomic, readwrite, strong) BOXFolderPaginatedItemsRequest *request;
+
+@end
+
+@implementation BOXFolderTreeWalkerTask
+
++ (instancetype)taskWithFolderID:(NSString *)folderID offset:(NSUInteger)offset
+{
+    BOXFolderTreeWalkerTask *task = [[self alloc] init];
+    task.folderID = folderID;
+    task.offset = offset;
+    return task;
+}
+
+@end
+
+@interface BOXFolderTreeWalker ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, copy) NSString *rootFolderID;
+@property (atomic, readwrite, assign) unsigned long long itemCount;
+
+// All of the properties below are only accessed on queue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingTasks;
+@property (nonatomic, readwrite, strong) NSMutableSet *activeTasks;
+@property (nonatomic, readwrite, strong) NSOutputStream *itemsOutputStream;
+@property (nonatomic, readwrite, copy) BOXFolderTreeWalkerCompletionBlock completionBlock;
+@property (nonatomic, readwrite, strong) NSDate *pausedUntilDate;
+@property (nonatomic, readwrite, assign) NSUInteger consecutiveRateLimitCount;
+@property (nonatomic, readwrite, assign) NSUInteger tasksSinceCheckpoint;
+@property (nonatomic, readwrite, assign) BOOL started;
+@property (nonatomic, readwrite, assign) BOOL finished;
+
+@end
+
+@implementation BOXFolderTreeWalker
+
+- (instancetype)initWithClient:(BOXContentClient *)client rootFolderID:(NSString *)rootFolderID
+{
+    if (self = [super init]) {
+        _client = client;
+        _rootFolderID = [rootFolderID copy];
+        _maxConcurrentListings = BOX_TREE_WALKER_DEFAULT_MAX_CONCURRENT_LISTINGS;
+        _pageSize = BOX_TREE_WALKER_DEFAULT_PAGE_SIZE;
+        _queue = dispatch_queue_create("com.box.contentsdk.foldertreewalker", DISPATCH_QUEUE_SERIAL);
+        _pendingTasks = [NSMutableArray array];
+        _activeTasks = [NSMutableSet set];
+    }
+    return self;
+}
+
+- (void)startWithCompletion:(BOXFolderTreeWalkerCompletionBlock)completionBlock
+{
+    dispatch_async(self.queue, ^{
+        if (self.started) {
+            return;
+        }
+        self.started = YES;
+        self.completionBlock = completionBlock;
+
+        BOOL isResuming = [self loadCheckpoint];
+        if (!isResuming) {
+            [self.pendingTasks addObject:[BOXFolderTreeWalkerTask taskWithFolderID:self.rootFolderID offset:0]];
+        }
+
+        if (self.itemsFileURL) {
+            self.itemsOutputStream = [NSOutputStream outputStreamWithURL:self.itemsFileURL append:isResuming];
+            [self.itemsOutputStream open];
+        }
+
+        [self scheduleTasks];
+    });
+}
+
+- (void)cancel
+{
+    dispatch_async(self.queue, ^{
+        if (self.started && !self.finished) {
+            NSError *error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
+            [self finishWithError:error];
+        }
+    });
+}
+
+#pragma mark - Tasks (called on queue)
+
+- (void)scheduleTasks
+{
+    if (self.finished) {
+        return;
+    }
+
+    NSTimeInterval pauseInterval = [self.pausedUntilDate timeIntervalSinceNow];
+    if (pauseInterval > 0) {
+        return;
+    }
+
+    NSUInteger maxConcurrentListings = MAX(self.maxConcurrentListings, 1);
+    while (self.activeTasks.count < maxConcurrentListings && self.pendingTasks.count > 0) {
+        BOXFolderTreeWalkerTask *task = self.pendingTasks.firstObject;
+        [self.pendingTasks removeObjectAtIndex:0];
+        [self.activeTasks addObject:task];
+        [self performTask:task];
+    }
+
+    if (self.activeTasks.count == 0 && self.pendingTasks.count == 0) {
+        [self finishWithError:nil];
+    }
+}
+
+- (void)performTask:(BOXFolderTreeWalkerTask *)task
+{
+    BOXFolderPaginatedItemsRequest *request = [self.client folderPaginatedItemsRequestWithID:task.folderID
+                                                                                     inRange:NSMakeRange(task.offset, self.pageSize)];
+    request.fieldsToInclude = [self requestedFields];
+    task.request = request;
+
+    [request performRequestWithCompletion:^(NSArray<BOXItem *> *items, NSUInteger totalCount, NSRange range, NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (self.finished) {
+                return;
+            }
+            task.request = nil;
+            [self.activeTasks removeObject:task];
+
+            if (error == nil) {
+                self.consecutiveRateLimitCount = 0;
+                [self handleItems:items totalCount:totalCount limit:range.length forTask:task];
+            } else {
+                [self handleError:error forTask:task];
+            }
+        });
+    }];
+}
+
+- (void)handleItems:(NSArray<BOXItem *> *)items totalCount:(NSUInteger)totalCount limit:(NSUInteger)limit forTask:(BOXFolderTreeWalkerTask *)task
+{
+    for (BOXItem *item in items) {
+        if (item.isFolder) {
+            [self.pendingTasks addObject:[BOXFolderTreeWalkerTask taskWithFolderID:item.modelID offset:0]];
+        }
+    }
+
+    // The first page tells how large the folder is; queue its other pages so free slots can take them.
+    if (task.offset == 0 && items.count > 0 && items.count < totalCount) {
+        NSUInteger pageSize = limit > 0 ? limit : items.count;
+        for (NSUInteger offset = items.count; offset < totalCount; offset += pageSize) {
+            [self.pendingTasks addObject:[BOXFolderTreeWalkerTask taskWithFolderID:task.folderID offset:offset]];
+        }
+    }
+
+    if (items.count > 0) {
+        if (self.itemsOutputStream && ![self writeItems:items]) {
+            [self finishWithError:self.itemsOutputStream.streamError];
+            return;
+        }
+        self.itemCount += items.count;
+        if (self.itemsBlock) {
+            self.itemsBlock(items, task.folderID);
+        }
+    }
+
+    self.tasksSinceCheckpoint++;
+    if (self.tasksSinceCheckpoint >= BOX_TREE_WALKER_CHECKPOINT_TASK_INTERVAL) {
+        [self saveCheckpoint];
+    }
+
+    [self scheduleTasks];
+}
+
+- (void)handleError:(NSError *)error forTask:(BOXFolderTreeWalkerTask *)task
+{
+    BOOL isRateLimited = [error.domain isEqualToString:BOXContentSDKErrorDomain] && error.code == BOXContentSDKAPIErrorTooManyRequests;
+    BOOL isRetryable = isRateLimited || [error.domain isEqualToString:NSURLErrorDomain] ||
+                       ([error.domain isEqualToString:BOXContentSDKErrorDomain] && error.code >= BOXContentSDKAPIErrorInternalServerError);
+
+    if (!isRetryable || task.retryCount >= BOX_TREE_WALKER_MAX_RETRIES) {
+        [self finishWithError:error];
+        return;
+    }
+
+    task.retryCount++;
+    [self.pendingTasks insertObject:task atIndex:0];
+
+    NSTimeInterval delay = 0;
+    if (isRateLimited) {
+        // Hold every listing, not just this one: the limit applies to the whole account.
+        delay = MIN(pow(2.0, self.consecutiveRateLimitCount), BOX_TREE_WALKER_MAX_BACKOFF_INTERVAL);
+        self.consecutiveRateLimitCount++;
+        NSDate *pausedUntilDate = [NSDate dateWithTimeIntervalSinceNow:delay];
+        if (self.pausedUntilDate == nil || [pausedUntilDate compare:self.pausedUntilDate] == NSOrderedDescending) {
+            self.pausedUntilDate = pausedUntilDate;
+        }
+        BOXLog(@"Folder tree walk rate limited, pausing for %.0fs", delay);
+    } else {
+        delay = MIN(pow(2.0, task.retryCount), BOX_TREE_WALKER_MAX_BACKOFF_INTERVAL);
+    }
+
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        [self scheduleTasks];
+    });
+}
+
+- (NSArray *)requestedFields
+{
+    NSMutableOrderedSet *fields = [NSMutableOrderedSet orderedSetWithArray:@[BOXAPIObjectKeyType, BOXAPIObjectKeyID, BOXAPIObjectKeyName]];
+    [fields addObjectsFromArray:self.fields];
+    return [fields array];
+}
+
+- (BOOL)writeItems:(NSArray<BOXItem *> *)items
+{
+    NSMutableData *data = [NSMutableData data];
+    for (BOXItem *item in items) {
+        NSData *line = [NSJSONSerialization dataWithJSONObject:item.JSONData options:0 error:nil];
+        if (line) {
+            [data appendData:line];
+            [data appendBytes:"\n" length:1];
+        }
+    }
+
+    const uint8_t *bytes = data.bytes;
+    NSUInteger remaining = data.length;
+    while (remaining > 0) {
+        NSInteger written = [self.itemsOutputStream write:bytes maxLength:remaining];
+        if (written <= 0) {
+            return NO;
+        }
+        bytes += written;
+        remaining -= written;
+    }
+    return YES;
+}
+
+- (void)finishWithError:(NSError *)error
+{
+    if (self.finished) {
+        return;
+    }
+    self.finished = YES;
+
+    // Put the pages in flight back in the queue so that a checkpoint covers them.
+    for (BOXFolderTreeWalkerTask *task in self.activeTasks) {
+        [task.request cancel];
+        task.request = nil;
+        [self.pendingTasks insertObject:task atIndex:0];
+    }
+    [self.activeTasks removeAllObjects];
+
+    [self.itemsOutputStream close];
+    self.itemsOutputStream = nil;
+
+    if (error == nil) {
+        if (self.checkpointFileURL) {
+            [[NSFileManager defaultManager] removeItemAtURL:self.checkpointFileURL error:nil];
+        }
+    } else {
+        [self saveCheckpoint];
+    }
+
+    BOXFolderTreeWalkerCompletionBlock completionBlock = self.completionBlock;
+    self.completionBlock = nil;
+    if (completionBlock) {
+        unsigned long long itemCount = self.itemCount;
+        [BOXDispatchHelper callCompletionBlock:^{
+            completionBlock(itemCount, error);
+        } onMainThread:YES];
+    }
+}
+
+#pragma mark - Checkpoint (called on queue)
+
+- (void)saveCheckpoint
+{
+    self.tasksSinceCheckpoint = 0;
+    if (self.checkpointFileURL == nil) {
+        return;
+    }
+
+    NSMutableArray *pendingTasks = [NSMutableArray arrayWithCapacity:self.pendingTasks.count + self.activeTasks.count];
+    for (BOXFolderTreeWalkerTask *task in [self.activeTasks.allObjects arrayByAddingObjectsFromArray:self.pendingTasks]) {
+        [pendingTasks addObject:@{BOXAPIObjectKeyID : task.folderID, BOXAPIParameterKeyOffset : @(task.offset)}];
+    }
+    NSDictionary *checkpoint = @{BOXTreeWalkerCheckpointKeyPendingTasks : pendingTasks,
+                                 BOXTreeWalkerCheckpointKeyItemCount : @(self.itemCount)};
+
+    NSError *error = nil;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:checkpoint format:NSPropertyListBinaryFormat_v1_0 options:0 error:&error];
+    if (data == nil || ![data writeToURL:self.checkpointFileURL options:NSDataWritingAtomic error:&error]) {
+        BOXLog(@"Could not save folder tree walk checkpoint: %@", error);
+    }
+}
+
+- (BOOL)loadCheckpoint
+{
+    if (self.checkpointFileURL == nil) {
+        return NO;
+    }
+    NSData *data = [NSData dataWithContentsOfURL:self.checkpointFileURL];
+    if (data == nil) {
+        return NO;
+    }
+    NSDictionary *checkpoint = [NSPropertyListSerialization propertyListWithData:data options:NSPropertyListImmutable format:NULL error:nil];
+    NSArray *pendingTasks = [checkpoint isKindOfClass:[NSDictionary class]] ? checkpoint[BOXTreeWalkerCheckpointKeyPendingTasks] : nil;
+    if (![pendingTasks isKindOfClass:[NSArray class]]) {
+        return NO;
+    }
+
+    for (NSDictionary *taskDictionary in pendingTasks) {
+        [self.pendingTasks addObject:[BOXFolderTreeWalkerTask taskWithFolderID:taskDictionary[BOXAPIObjectKeyID]
+                                                                        offset:[taskDictionary[BOXAPIParameterKeyOffset] unsignedIntegerValue]]];
+    }
+    self.itemCount = [checkpoint[BOXTreeWalkerCheckpointKeyItemCount] unsignedLongLongValue];
+    return YES;
+}
+
+@end
@@ -0,0 +1,63 @@
+//
+//  BOXItemNameIndex.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXItem;
+@class BOXEvent;
+
+/**
+ *  BOXItemNameIndex is an in-memory index over the names, extensions, paths and owners of items
+ *  an app has already seen (e.g. from folder listings, search results or the event stream), so they
+ *  can be found by name without a network round trip.
+ *
+ *  Text is Unicode-normalized and folded for case, diacritics and width, then split into words.
+ *  Words are indexed by their first one and two characters and by all of their trigrams, so a query
+ *  matches words it is a prefix of and, for three characters or more, words it appears in.
+ *  Every word of a query must match; hits are ranked by where and how well they matched.
+ *
+ *  The index is updated incrementally and is safe to use from any thread.
+ */
+@interface BOXItemNameIndex : NSObject
+
+@property (nonatomic, readonly, assign) NSUInteger count;
+
+/**
+ *  Add items to the index, replacing any indexed item with the same type and ID.
+ */
+- (void)addItems:(NSArray<BOXItem *> *)items;
+
+/**
+ *  Remove an item from the index. File, folder and web link IDs may collide, so the type is required.
+ *
+ *  @param itemID   ID of the item.
+ *  @param itemType Type of the item, e.g. BOXAPIItemTypeFile.
+ */
+- (void)removeItemWithID:(NSString *)itemID type:(NSString *)itemType;
+
+- (void)removeAllItems;
+
+/**
+ *  Update the index with the source items of events from the event stream: trashed items are removed
+ *  and other items are added or replaced.
+ */
+- (void)updateWithEvents:(NSArray<BOXEvent *> *)events;
+
+/**
+ *  Return indexed items matching query, best matches first.
+ *
+ *  @param query Words to search for.
+ *  @param limit Maximum number of items returned, or 0 for no limit.
+ */
+- (NSArray<BOXItem *> *)itemsMatchingQuery:(NSString *)query limit:(NSUInteger)limit;
+
+/**
+ *  Merge server search results with local results: server items keep their order and come first,
+ *  followed by local items the server did not return. Server items are also added to the index.
+ */
+- (NSArray<BOXItem *> *)itemsByMergingServerItems:(NSArray<BOXItem *> *)serverItems
+                                       localItems:(NSArray<BOXItem *> *)localItems;
+
+@end
@@ -0,0 +1,389 @@
+//
+//  BOXItemNameIndex.m
+//  BoxContentSDK
+//
+
+#import "BOXItemNameIndex.h"
+
+#import "BOXItem.h"
+#import "BOXFile.h"
+#import "BOXFolder.h"
+#import "BOXUser.h"
+#import "BOXEvent.h"
+#import "BOXContentSDKConstants.h"
+
+// Weight of a word depending on the field it comes from.
+#define BOX_NAME_INDEX_WEIGHT_NAME (4)
+#define BOX_NAME_INDEX_WEIGHT_EXTENSION (3)
+#define BOX_NAME_INDEX_WEIGHT_PATH (1)
+#define BOX_NAME_INDEX_WEIGHT_OWNER (1)
+
+// Score of a query word depending on how it matched an indexed word.
+#define BOX_NAME_INDEX_SCORE_EXACT (3)
+#define BOX_NAME_INDEX_SCORE_PREFIX (2)
+#define BOX_NAME_INDEX_SCORE_SUBSTRING (1)
+
+#define BOX_NAME_INDEX_GRAM_LENGTH (3)
+
+@interface BOXItemNameIndexEntry : NSObject
+
+@property (nonatomic, readwrite, strong) BOXItem *item;
+// Normalized word -> NSNumber of the highest field weight it appears in.
+@property (nonatomic, readwrite, strong) NSDictionary *wordWeights;
+
+@end
+
+@implementation BOXItemNameIndexEntry
+@end
+
+@interface BOXItemNameIndex ()
+
+// Files, folders and web links have separate ID spaces, so entries are keyed by type and ID.
+@property (nonatomic, readwrite, strong) NSMutableDictionary *entriesByItemKey;
+// Normalized word -> NSMutableSet of item keys.
+@property (nonatomic, readwrite, strong) NSMutableDictionary *itemKeysByWord;
+// One and two character prefixes and trigrams -> NSMutableSet of normalized words.
+@property (nonatomic, readwrite, strong) NSMutableDictionary *wordsByGram;
+
+@end
+
+@implementation BOXItemNameIndex
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _entriesByItemKey = [NSMutableDictionary dictionary];
+        _itemKeysByWord = [NSMutableDictionary dictionary];
+        _wordsByGram = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (NSUInteger)count
+{
+    @synchronized(self) {
+        return self.entriesByItemKey.count;
+    }
+}
+
+#pragma mark - Updates
+
+- (void)addItems:(NSArray<BOXItem *> *)items
+{
+    @synchronized(self) {
+        for (BOXItem *item in items) @autoreleasepool {
+            NSString *itemKey = [self keyForItemWithID:item.modelID type:item.type];
+            if (itemKey == nil) {
+                continue;
+            }
+            [self removeEntryForItemKey:itemKey];
+
+            BOXItemNameIndexEntry *entry = [[BOXItemNameIndexEntry alloc] init];
+            entry.item = item;
+            entry.wordWeights = [self wordWeightsForItem:item];
+            self.entriesByItemKey[itemKey] = entry;
+
+            for (NSString *word in entry.wordWeights) {
+                NSMutableSet *itemKeys = self.itemKeysByWord[word];
+                if (itemKeys == nil) {
+                    itemKeys = [NSMutableSet set];
+                    self.itemKeysByWord[word] = itemKeys;
+                    [self addGramsOfWord:word];
+                }
+                [itemKeys addObject:itemKey];
+            }
+        }
+    }
+}
+
+- (void)removeItemWithID:(NSString *)itemID type:(NSString *)itemType
+{
+    NSString *itemKey = [self keyForItemWithID:itemID type:itemType];
+    if (itemKey == nil) {
+        return;
+    }
+    @synchronized(self) {
+        [self removeEntryForItemKey:itemKey];
+    }
+}
+
+- (void)removeAllItems
+{
+    @synchronized(self) {
+        [self.entriesByItemKey removeAllObjects];
+        [self.itemKeysByWord removeAllObjects];
+        [self.wordsByGram removeAllObjects];
+    }
+}
+
+- (void)updateWithEvents:(NSArray<BOXEvent *> *)events
+{
+    for (BOXEvent *event in events) {
+        if (![event.source isKindOfClass:[BOXItem class]]) {
+            continue;
+        }
+        BOXItem *item = (BOXItem *)event.source;
+        if ([event.eventType isEqualToString:BOXAPIEventTypeItemTrash]) {
+            [self removeItemWithID:item.modelID type:item.type];
+        } else {
+            [self addItems:@[item]];
+        }
+    }
+}
+
+- (NSString *)keyForItemWithID:(NSString *)itemID type:(NSString *)itemType
+{
+    if (itemID.length == 0 || itemType.length == 0) {
+        return nil;
+    }
+    return [NSString stringWithFormat:@"%@_%@", itemType, itemID];
+}
+
+// Called within @synchronized(self).
+- (void)removeEntryForItemKey:(NSString *)itemKey
+{
+    BOXItemNameIndexEntry *entry = self.entriesByItemKey[itemKey];
+    if (entry == nil) {
+        return;
+    }
+    [self.entriesByItemKey removeObjectForKey:itemKey];
+
+    for (NSString *word in entry.wordWeights) {
+        NSMutableSet *itemKeys = self.itemKeysByWord[word];
+        [itemKeys removeObject:itemKey];
+        if (itemKeys.count == 0) {
+            [self.itemKeysByWord removeObjectForKey:word];
+            [self removeGramsOfWord:word];
+        }
+    }
+}
+
+#pragma mark - Search
+
+- (NSArray<BOXItem *> *)itemsMatchingQuery:(NSString *)query limit:(NSUInteger)limit
+{
+    NSArray *queryWords = [self wordsInString:query];
+    if (queryWords.count == 0) {
+        return @[];
+    }
+
+    NSMutableArray *results = [NSMutableArray array];
+
+    @synchronized(self) {
+        NSMutableDictionary *scoresByItemKey = nil;
+
+        for (NSString *queryWord in queryWords) {
+            NSDictionary *wordScores = [self scoresByItemKeyForQueryWord:queryWord];
+            if (scoresByItemKey == nil) {
+                scoresByItemKey = [wordScores mutableCopy];
+            } else {
+                for (NSString *itemKey in [scoresByItemKey allKeys]) {
+                    NSNumber *score = wordScores[itemKey];
+                    if (score) {
+                        scoresByItemKey[itemKey] = @([scoresByItemKey[itemKey] unsignedIntegerValue] + [score unsignedIntegerValue]);
+                    } else {
+                        [scoresByItemKey removeObjectForKey:itemKey];
+                    }
+                }
+            }
+            if (scoresByItemKey.count == 0) {
+                return @[];
+            }
+        }
+
+        NSArray *sortedItemKeys = [[scoresByItemKey allKeys] sortedArrayUsingComparator:^NSComparisonResult(NSString *itemKeyA, NSString *itemKeyB) {
+            NSUInteger scoreA = [scoresByItemKey[itemKeyA] unsignedIntegerValue];
+            NSUInteger scoreB = [scoresByItemKey[itemKeyB] unsignedIntegerValue];
+            if (scoreA != scoreB) {
+                return scoreA > scoreB ? NSOrderedAscending : NSOrderedDescending;
+            }
+            BOXItem *itemA = [self.entriesByItemKey[itemKeyA] item];
+            BOXItem *itemB = [self.entriesByItemKey[itemKeyB] item];
+            if (itemA.name.length != itemB.name.length) {
+                return itemA.name.length < itemB.name.length ? NSOrderedAscending : NSOrderedDescending;
+            }
+            if (itemA.modifiedDate && itemB.modifiedDate) {
+                return [itemB.modifiedDate compare:itemA.modifiedDate];
+            }
+            return [itemKeyA compare:itemKeyB];
+        }];
+
+        for (NSString *itemKey in sortedItemKeys) {
+            [results addObject:[self.entriesByItemKey[itemKey] item]];
+            if (limit > 0 && results.count >= limit) {
+                break;
+            }
+        }
+    }
+
+    return results;
+}
+
+- (NSArray<BOXItem *> *)itemsByMergingServerItems:(NSArray<BOXItem *> *)serverItems
+                                       localItems:(NSArray<BOXItem *> *)localItems
+{
+    [self addItems:serverItems];
+
+    NSMutableArray *items = [NSMutableArray arrayWithArray:serverItems];
+    NSMutableSet *itemKeys = [NSMutableSet setWithCapacity:serverItems.count];
+    for (BOXItem *item in serverItems) {
+        NSString *itemKey = [self keyForItemWithID:item.modelID type:item.type];
+        if (itemKey) {
+            [itemKeys addObject:itemKey];
+        }
+    }
+    for (BOXItem *item in localItems) {
+        NSString *itemKey = [self keyForItemWithID:item.modelID type:item.type];
+        if (itemKey && ![itemKeys containsObject:itemKey]) {
+            [items addObject:item];
+        }
+    }
+    return items;
+}
+
+// Called within @synchronized(self).
+- (NSDictionary *)scoresByItemKeyForQueryWord:(NSString *)queryWord
+{
+    NSSet *candidateWords = nil;
+
+    if (queryWord.length < BOX_NAME_INDEX_GRAM_LENGTH) {
+        // Prefixes are shorter than trigrams, so the two never collide in wordsByGram.
+        candidateWords = self.wordsByGram[queryWord];
+    } else {
+        NSMutableSet *intersection = nil;
+        for (NSString *gram in [self trigramsOfWord:queryWord]) {
+            NSSet *words = self.wordsByGram[gram];
+            if (words == nil) {
+                return @{};
+            }
+            if (intersection == nil) {
+                intersection = [words mutableCopy];
+            } else {
+                [intersection intersectSet:words];
+            }
+            if (intersection.count == 0) {
+                return @{};
+            }
+        }
+        candidateWords = intersection;
+    }
+
+    NSMutableDictionary *scoresByItemKey = [NSMutableDictionary dictionary];
+    for (NSString *word in candidateWords) {
+        NSUInteger matchScore = 0;
+        if ([word isEqualToString:queryWord]) {
+            matchScore = BOX_NAME_INDEX_SCORE_EXACT;
+        } else if ([word hasPrefix:queryWord]) {
+            matchScore = BOX_NAME_INDEX_SCORE_PREFIX;
+        } else if ([word rangeOfString:queryWord].location != NSNotFound) {
+            matchScore = BOX_NAME_INDEX_SCORE_SUBSTRING;
+        } else {
+            // All trigrams matched but not contiguously.
+            continue;
+        }
+
+        for (NSString *itemKey in self.itemKeysByWord[word]) {
+            BOXItemNameIndexEntry *entry = self.entriesByItemKey[itemKey];
+            NSUInteger score = matchScore * [entry.wordWeights[word] unsignedIntegerValue];
+            if (score > [scoresByItemKey[itemKey] unsignedIntegerValue]) {
+                scoresByItemKey[itemKey] = @(score);
+            }
+        }
+    }
+    return scoresByItemKey;
+}
+
+#pragma mark - Words and grams
+
+- (NSDictionary *)wordWeightsForItem:(BOXItem *)item
+{
+    NSMutableDictionary *wordWeights = [NSMutableDictionary dictionary];
+    void (^addWords)(NSString *, NSUInteger) = ^(NSString *string, NSUInteger weight) {
+        for (NSString *word in [self wordsInString:string]) {
+            if (weight > [wordWeights[word] unsignedIntegerValue]) {
+                wordWeights[word] = @(weight);
+            }
+        }
+    };
+
+    addWords(item.name, BOX_NAME_INDEX_WEIGHT_NAME);
+    if ([item isKindOfClass:[BOXFile class]]) {
+        addWords(((BOXFile *)item).extension, BOX_NAME_INDEX_WEIGHT_EXTENSION);
+    }
+    for (BOXFolderMini *folder in item.pathFolders) {
+        addWords(folder.name, BOX_NAME_INDEX_WEIGHT_PATH);
+    }
+    addWords(item.owner.name, BOX_NAME_INDEX_WEIGHT_OWNER);
+    addWords(item.owner.login, BOX_NAME_INDEX_WEIGHT_OWNER);
+
+    return wordWeights;
+}
+
+- (NSArray *)wordsInString:(NSString *)string
+{
+    if (string.length == 0) {
+        return @[];
+    }
+
+    static NSCharacterSet *separators = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        separators = [[NSCharacterSet alphanumericCharacterSet] invertedSet];
+    });
+
+    NSString *normalizedString = [[string precomposedStringWithCanonicalMapping] stringByFoldingWithOptions:(NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch | NSWidthInsensitiveSearch)
+                                                                                                   locale:nil];
+    NSMutableArray *words = [NSMutableArray array];
+    for (NSString *word in [normalizedString componentsSeparatedByCharactersInSet:separators]) {
+        if (word.length > 0) {
+            [words addObject:word];
+        }
+    }
+    return words;
+}
+
+- (NSArray *)gramsOfWord:(NSString *)word
+{
+    NSMutableArray *grams = [NSMutableArray array];
+    for (NSUInteger length = 1; length < BOX_NAME_INDEX_GRAM_LENGTH && length <= word.length; length++) {
+        [grams addObject:[word substringToIndex:length]];
+    }
+    [grams addObjectsFromArray:[self trigramsOfWord:word]];
+    return grams;
+}
+
+- (NSArray *)trigramsOfWord:(NSString *)word
+{
+    NSMutableArray *trigrams = [NSMutableArray array];
+    for (NSUInteger i = 0; i + BOX_NAME_INDEX_GRAM_LENGTH <= word.length; i++) {
+        [trigrams addObject:[word substringWithRange:NSMakeRange(i, BOX_NAME_INDEX_GRAM_LENGTH)]];
+    }
+    return trigrams;
+}
+
+// Called within @synchronized(self).
+- (void)addGramsOfWord:(NSString *)word
+{
+    for (NSString *gram in [self gramsOfWord:word]) {
+        NSMutableSet *words = self.wordsByGram[gram];
+        if (words == nil) {
+            words = [NSMutableSet set];
+            self.wordsByGram[gram] = words;
+        }
+        [words addObject:word];
+    }
+}
+
+// Called within @synchronized(self).
+- (void)removeGramsOfWord:(NSString *)word
+{
+    for (NSString *gram in [self gramsOfWord:word]) {
+        NSMutableSet *words = self.wordsByGram[gram];
+        [words removeObject:word];
+        if (words.count == 0) {
+            [self.wordsByGram removeObjectForKey:gram];
+        }
+    }
+}
+
+@end
@@ -0,0 +1,94 @@
+//
+//  BOXMetadataUpdateQueue.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+#import "BOXRequest.h"
+
+@class BOXContentClient;
+@class BOXMetadata;
+@class BOXMetadataUpdateTask;
+
+/**
+ *  BOXMetadataUpdateQueue buffers metadata updates so that successive edits of the same metadata instance
+ *  are sent as one request.
+ *
+ *  Update tasks are buffered per file, scope and template. A buffer is sent once coalescingInterval has passed
+ *  since its first task was enqueued, or when flush is called. Before it is sent, the tasks on the same path are
+ *  collapsed into at most one: for instance an add followed by a replace becomes a single add of the new value,
+ *  and an add followed by a remove cancels out.
+ *
+ *  Only one update request per metadata instance is in flight at a time, so that the edits of an app do not
+ *  conflict with each other; tasks enqueued meanwhile are sent once it completes.
+ *
+ *  The last known state of each instance, taken from the response of every update or given with
+ *  recordMetadata:forFileID:, is used to guard the updates: a replace or remove of a known string value is
+ *  preceded by a test of that value, so that an edit made elsewhere is not silently overwritten. Such an update
+ *  fails with a conflict error and the known state is forgotten until the next successful update. The known
+ *  state is only kept for the 100 most recently used instances that have nothing left to send.
+ */
+@interface BOXMetadataUpdateQueue : NSObject
+
+/**
+ *  How long the tasks of a metadata instance are buffered before they are sent. Defaults to 0.5 seconds.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval coalescingInterval;
+
+/**
+ *  Number of update requests sent so far.
+ */
+@property (atomic, readonly, assign) NSUInteger requestCount;
+
+- (instancetype)initWithClient:(BOXContentClient *)client;
+
+/**
+ *  Buffers update tasks for a metadata instance.
+ *
+ *  @param updateTasks     Instances of BOXMetadataUpdateTask.
+ *  @param fileID          The ID of the file the metadata belongs to.
+ *  @param scope           The scope of the template.
+ *  @param templateName    The templateKey of the metadata.
+ *  @param completionBlock Called on the main thread once the request the tasks were sent with completes, with
+ *                         the updated metadata. If the tasks cancelled out, it is called with the last known
+ *                         metadata, if any.
+ */
+- (void)enqueueUpdateTasks:(NSArray<BOXMetadataUpdateTask *> *)updateTasks
+                    fileID:(NSString *)fileID
+                     scope:(NSString *)scope
+                  template:(NSString *)templateName
+                completion:(BOXMetadataBlock)completionBlock;
+
+/**
+ *  Records the current state of a metadata instance, as returned by BOXMetadataRequest, to guard the next
+ *  updates with.
+ */
+- (void)recordMetadata:(BOXMetadata *)metadata forFileID:(NSString *)fileID;
+
+/**
+ *  Sends every buffered task without waiting for the end of the coalescing interval.
+ */
+- (void)flush;
+
+/**
+ *  Cancels the requests in flight and drops the buffered tasks. Their completion blocks are called with a
+ *  cancellation error.
+ */
+- (void)cancel;
+
+/**
+ *  Collapses the tasks on the same path into at most one task. Test tasks are kept in place, and tasks are not
+ *  collapsed across them.
+ *
+ *  @param updateTasks Instances of BOXMetadataUpdateTask, in the order they are applied.
+ *  @param knownInfo   The custom key/value pairs of the metadata instance before the tasks are applied, or nil
+ *                     if they are unknown. When it is given, add and replace tasks are chosen according to
+ *                     whether the key exists, removals of missing keys are dropped, and replace and remove tasks
+ *                     of string values are preceded by a test of the known value.
+ *
+ *  @return The collapsed tasks.
+ */
++ (NSArray<BOXMetadataUpdateTask *> *)coalescedUpdateTasks:(NSArray<BOXMetadataUpdateTask *> *)updateTasks
+                                                 knownInfo:(NSDictionary *)knownInfo;
+
+@end
@@ -0,0 +1,421 @@
+//
+//  BOXMetadataUpdateQueue.m
+//  BoxContentSDK
+//
+
+#import "BOXMetadataUpdateQueue.h"
+
+#import "BOXContentClient+Metadata.h"
+#import "BOXMetadataUpdateRequest.h"
+#import "BOXMetadataUpdateTask.h"
+#import "BOXMetadata.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXDispatchHelper.h"
+#import "BOXLog.h"
+
+#define BOX_METADATA_UPDATE_DEFAULT_COALESCING_INTERVAL (0.5)
+#define BOX_METADATA_UPDATE_MAX_RETRIES (3)
+#define BOX_METADATA_UPDATE_MAX_BACKOFF_INTERVAL (30.0)
+// Idle instances whose known state is kept. The least recently used ones are forgotten first.
+#define BOX_METADATA_UPDATE_MAX_IDLE_BUFFERS (100)
+
+// The tasks of one metadata instance.
+@interface BOXMetadataUpdateBuffer : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *fileID;
+@property (nonatomic, readwrite, copy) NSString *scope;
+@property (nonatomic, readwrite, copy) NSString *templateName;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingTasks;
+@property (nonatomic, readwrite, strong) NSMutableArray *pendingCompletionBlocks;
+// Incremented each time the pending tasks are sent, so that the timer of an earlier batch is ignored.
+@property (nonatomic, readwrite, assign) NSUInteger generation;
+@property (nonatomic, readwrite, assign) BOOL sendScheduled;
+@property (nonatomic, readwrite, assign) BOOL sendRequested;
+@property (nonatomic, readwrite, strong) BOXMetadataUpdateRequest *request;
+@property (nonatomic, readwrite, strong) NSArray *requestTasks;
+@property (nonatomic, readwrite, strong) NSArray *requestCompletionBlocks;
+@property (nonatomic, readwrite, assign) BOOL waitingForRetry;
+@property (nonatomic, readwrite, assign) NSUInteger retryCount;
+@property (nonatomic, readwrite, strong) BOXMetadata *knownMetadata;
+
+@end
+
+@implementation BOXMetadataUpdateBuffer
+@end
+
+// The collapsed effect of the tasks on one path.
+@interface BOXMetadataPathUpdate : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *path;
+@property (nonatomic, readwrite, assign) BOXMetadataUpdateOperation firstOperation;
+@property (nonatomic, readwrite, assign) BOXMetadataUpdateOperation lastOperation;
+@property (nonatomic, readwrite, strong) NSString *value;
+
+@end
+
+@implementation BOXMetadataPathUpdate
+@end
+
+@interface BOXMetadataUpdateQueue ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (atomic, readwrite, assign) NSUInteger requestCount;
+
+// All of the properties below are only accessed on queue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *buffers;
+// Keys of the buffers with nothing to send, least recently used first.
+@property (nonatomic, readwrite, strong) NSMutableOrderedSet *idleBufferKeys;
+
+@end
+
+@implementation BOXMetadataUpdateQueue
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+{
+    if (self = [super init]) {
+        _client = client;
+        _coalescingInterval = BOX_METADATA_UPDATE_DEFAULT_COALESCING_INTERVAL;
+        _queue = dispatch_queue_create("com.box.contentsdk.metadataupdatequeue", DISPATCH_QUEUE_SERIAL);
+        _buffers = [NSMutableDictionary dictionary];
+        _idleBufferKeys = [NSMutableOrderedSet orderedSet];
+    }
+    return self;
+}
+
+- (void)enqueueUpdateTasks:(NSArray<BOXMetadataUpdateTask *> *)updateTasks
+                    fileID:(NSString *)fileID
+                     scope:(NSString *)scope
+                  template:(NSString *)templateName
+                completion:(BOXMetadataBlock)completionBlock
+{
+    BOXAssert(fileID.length > 0, @"BOXMetadataUpdateQueue FileID must not be nil.");
+    BOXAssert(scope.length > 0, @"BOXMetadataUpdateQueue Scope must not be nil.");
+    BOXAssert(templateName.length > 0, @"BOXMetadataUpdateQueue Template must not be nil.");
+
+    NSArray *tasks = [updateTasks copy];
+    BOXMetadataBlock completion = [completionBlock copy];
+    NSTimeInterval coalescingInterval = self.coalescingInterval;
+
+    dispatch_async(self.queue, ^{
+        BOXMetadataUpdateBuffer *buffer = [self bufferForFileID:fileID scope:scope templateName:templateName];
+        [buffer.pendingTasks addObjectsFromArray:tasks];
+        if (completion) {
+            [buffer.pendingCompletionBlocks addObject:completion];
+        }
+
+        if (!buffer.sendScheduled) {
+            buffer.sendScheduled = YES;
+            NSUInteger generation = buffer.generation;
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(coalescingInterval * NSEC_PER_SEC)), self.queue, ^{
+                if (buffer.generation == generation && self.buffers[[self keyForBuffer:buffer]] == buffer) {
+                    [self sendBuffer:buffer];
+                }
+            });
+        }
+    });
+}
+
+- (void)recordMetadata:(BOXMetadata *)metadata forFileID:(NSString *)fileID
+{
+    if (metadata.scope.length == 0 || metadata.templateName.length == 0 || fileID.length == 0) {
+        return;
+    }
+    dispatch_async(self.queue, ^{
+        BOXMetadataUpdateBuffer *buffer = [self bufferForFileID:fileID scope:metadata.scope templateName:metadata.templateName];
+        buffer.knownMetadata = metadata;
+        [self evictBufferIfIdle:buffer];
+    });
+}
+
+- (void)flush
+{
+    dispatch_async(self.queue, ^{
+        for (BOXMetadataUpdateBuffer *buffer in [self.buffers allValues]) {
+            [self sendBuffer:buffer];
+        }
+    });
+}
+
+- (void)cancel
+{
+    dispatch_async(self.queue, ^{
+        NSError *error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
+        for (BOXMetadataUpdateBuffer *buffer in [self.buffers allValues]) {
+            [buffer.request cancel];
+            buffer.request = nil;
+
+            NSMutableArray *completionBlocks = [NSMutableArray array];
+            if (buffer.requestCompletionBlocks) {
+                [completionBlocks addObjectsFromArray:buffer.requestCompletionBlocks];
+            }
+            [completionBlocks addObjectsFromArray:buffer.pendingCompletionBlocks];
+            [self callCompletionBlocks:completionBlocks metadata:nil error:error];
+        }
+        // Pending timers and retries check that their buffer is still there.
+        [self.buffers removeAllObjects];
+        [self.idleBufferKeys removeAllObjects];
+    });
+}
+
+#pragma mark - Buffers (called on queue)
+
+- (NSString *)keyForBuffer:(BOXMetadataUpdateBuffer *)buffer
+{
+    return [self keyForFileID:buffer.fileID scope:buffer.scope templateName:buffer.templateName];
+}
+
+- (NSString *)keyForFileID:(NSString *)fileID scope:(NSString *)scope templateName:(NSString *)templateName
+{
+    return [NSString stringWithFormat:@"%@/%@/%@", fileID, scope, templateName];
+}
+
+- (BOXMetadataUpdateBuffer *)bufferForFileID:(NSString *)fileID scope:(NSString *)scope templateName:(NSString *)templateName
+{
+    NSString *key = [self keyForFileID:fileID scope:scope templateName:templateName];
+    [self.idleBufferKeys removeObject:key];
+    BOXMetadataUpdateBuffer *buffer = self.buffers[key];
+    if (buffer == nil) {
+        buffer = [[BOXMetadataUpdateBuffer alloc] init];
+        buffer.fileID = fileID;
+        buffer.scope = scope;
+        buffer.templateName = templateName;
+        buffer.pendingTasks = [NSMutableArray array];
+        buffer.pendingCompletionBlocks = [NSMutableArray array];
+        self.buffers[key] = buffer;
+    }
+    return buffer;
+}
+
+- (void)sendBuffer:(BOXMetadataUpdateBuffer *)buffer
+{
+    if (buffer.request != nil || buffer.waitingForRetry) {
+        // Sent once the request in flight completes.
+        buffer.sendRequested = YES;
+        return;
+    }
+    buffer.sendRequested = NO;
+    // Also done when there is nothing to send, e.g. when the tasks enqueued were empty, so that the next tasks
+    // schedule a send of their own.
+    buffer.generation++;
+    buffer.sendScheduled = NO;
+    if (buffer.pendingTasks.count == 0 && buffer.pendingCompletionBlocks.count == 0) {
+        [self evictBufferIfIdle:buffer];
+        return;
+    }
+
+    NSArray *tasks = [buffer.pendingTasks copy];
+    NSArray *completionBlocks = [buffer.pendingCompletionBlocks copy];
+    [buffer.pendingTasks removeAllObjects];
+    [buffer.pendingCompletionBlocks removeAllObjects];
+
+    NSArray *coalescedTasks = [[self class] coalescedUpdateTasks:tasks knownInfo:buffer.knownMetadata.info];
+    if (coalescedTasks.count == 0) {
+        [self callCompletionBlocks:completionBlocks metadata:buffer.knownMetadata error:nil];
+        [self evictBufferIfIdle:buffer];
+        return;
+    }
+
+    BOXMetadataUpdateRequest *request = [self.client metadataUpdateRequestWithFileID:buffer.fileID
+                                                                               scope:buffer.scope
+                                                                            template:buffer.templateName
+                                                                         updateTasks:coalescedTasks];
+    buffer.request = request;
+    buffer.requestTasks = tasks;
+    buffer.requestCompletionBlocks = completionBlocks;
+    self.requestCount++;
+
+    [request performRequestWithCompletion:^(BOXMetadata *metadata, NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (buffer.request != request) {
+                return;
+            }
+            buffer.request = nil;
+            [self handleMetadata:metadata error:error forBuffer:buffer];
+        });
+    }];
+}
+
+- (void)handleMetadata:(BOXMetadata *)metadata error:(NSError *)error forBuffer:(BOXMetadataUpdateBuffer *)buffer
+{
+    NSArray *tasks = buffer.requestTasks;
+    NSArray *completionBlocks = buffer.requestCompletionBlocks;
+    buffer.requestTasks = nil;
+    buffer.requestCompletionBlocks = nil;
+
+    BOOL isBoxError = [error.domain isEqualToString:BOXContentSDKErrorDomain];
+    BOOL isRetryable = [error.domain isEqualToString:NSURLErrorDomain] ||
+                       (isBoxError && (error.code == BOXContentSDKAPIErrorTooManyRequests ||
+                                       (error.code >= BOXContentSDKAPIErrorInternalServerError && error.code < 600)));
+
+    if (error && isRetryable && buffer.retryCount < BOX_METADATA_UPDATE_MAX_RETRIES) {
+        // The tasks go back in front of the ones enqueued meanwhile, and are sent again with them.
+        [buffer.pendingTasks insertObjects:tasks atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, tasks.count)]];
+        [buffer.pendingCompletionBlocks insertObjects:completionBlocks
+                                            atIndexes:[NSIndexSet indexSetWithIndexesInRange:NSMakeRange(0, completionBlocks.count)]];
+        NSTimeInterval delay = MIN(pow(2.0, buffer.retryCount), BOX_METADATA_UPDATE_MAX_BACKOFF_INTERVAL);
+        buffer.retryCount++;
+        buffer.waitingForRetry = YES;
+        dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+            buffer.waitingForRetry = NO;
+            if (self.buffers[[self keyForBuffer:buffer]] == buffer) {
+                [self sendBuffer:buffer];
+            }
+        });
+        return;
+    }
+    buffer.retryCount = 0;
+
+    if (error) {
+        if (isBoxError && (error.code == BOXContentSDKAPIErrorConflict || error.code == BOXContentSDKAPIErrorPreconditionFailed)) {
+            // The instance was changed elsewhere, or a guard test failed: the state it was checked against is stale.
+            BOXLog(@"Metadata update of file %@ conflicted, forgetting its known state", buffer.fileID);
+            buffer.knownMetadata = nil;
+        }
+        [self callCompletionBlocks:completionBlocks metadata:nil error:error];
+    } else {
+        buffer.knownMetadata = metadata;
+        [self callCompletionBlocks:completionBlocks metadata:metadata error:nil];
+    }
+
+    if (buffer.sendRequested) {
+        [self sendBuffer:buffer];
+    } else {
+        [self evictBufferIfIdle:buffer];
+    }
+}
+
+// Drops a buffer once it has nothing to send or wait for. Only the known state of an instance makes it worth
+// keeping, and only for the most recently used instances.
+- (void)evictBufferIfIdle:(BOXMetadataUpdateBuffer *)buffer
+{
+    if (buffer.request != nil || buffer.waitingForRetry || buffer.sendScheduled ||
+        buffer.pendingTasks.count > 0 || buffer.pendingCompletionBlocks.count > 0) {
+        return;
+    }
+
+    NSString *key = [self keyForBuffer:buffer];
+    if (self.buffers[key] != buffer) {
+        return;
+    }
+    if (buffer.knownMetadata == nil) {
+        [self.buffers removeObjectForKey:key];
+        [self.idleBufferKeys removeObject:key];
+        return;
+    }
+
+    [self.idleBufferKeys removeObject:key];
+    [self.idleBufferKeys addObject:key];
+    while (self.idleBufferKeys.count > BOX_METADATA_UPDATE_MAX_IDLE_BUFFERS) {
+        [self.buffers removeObjectForKey:self.idleBufferKeys.firstObject];
+        [self.idleBufferKeys removeObjectAtIndex:0];
+    }
+}
+
+- (void)callCompletionBlocks:(NSArray *)completionBlocks metadata:(BOXMetadata *)metadata error:(NSError *)error
+{
+    if (completionBlocks.count == 0) {
+        return;
+    }
+    [BOXDispatchHelper callCompletionBlock:^{
+        for (BOXMetadataBlock completionBlock in completionBlocks) {
+            completionBlock(metadata, error);
+        }
+    } onMainThread:YES];
+}
+
+#pragma mark - Coalescing
+
++ (NSArray<BOXMetadataUpdateTask *> *)coalescedUpdateTasks:(NSArray<BOXMetadataUpdateTask *> *)updateTasks
+                                                 knownInfo:(NSDictionary *)knownInfo
+{
+    NSMutableArray *coalescedTasks = [NSMutableArray array];
+    // Tracks the effect of the tasks emitted so far, so that the tasks after a test are checked against it.
+    NSMutableDictionary *info = [knownInfo mutableCopy];
+    NSMutableArray *paths = [NSMutableArray array];
+    NSMutableDictionary *updatesByPath = [NSMutableDictionary dictionary];
+
+    for (BOXMetadataUpdateTask *task in updateTasks) {
+        if (task.operation == BOXMetadataUpdateTEST) {
+            [self appendUpdates:updatesByPath forPaths:paths info:info toTasks:coalescedTasks];
+            [paths removeAllObjects];
+            [updatesByPath removeAllObjects];
+            [coalescedTasks addObject:task];
+            continue;
+        }
+
+        BOXMetadataPathUpdate *update = updatesByPath[task.path];
+        if (update == nil) {
+            update = [[BOXMetadataPathUpdate alloc] init];
+            update.path = task.path;
+            update.firstOperation = task.operation;
+            updatesByPath[task.path] = update;
+            [paths addObject:task.path];
+        }
+        update.lastOperation = task.operation;
+        update.value = task.value;
+    }
+    [self appendUpdates:updatesByPath forPaths:paths info:info toTasks:coalescedTasks];
+
+    return coalescedTasks;
+}
+
+// Returns the key named by a JSON Pointer such as /owner, or nil if the pointer names a nested key.
++ (NSString *)topLevelKeyForPath:(NSString *)path
+{
+    if (path.length == 0 || [path characterAtIndex:0] != '/') {
+        return nil;
+    }
+    NSString *key = [path substringFromIndex:1];
+    if ([key rangeOfString:@"/"].location != NSNotFound) {
+        return nil;
+    }
+    // ~1 is decoded first so that ~01 stands for ~1, not /.
+    key = [key stringByReplacingOccurrencesOfString:@"~1" withString:@"/"];
+    return [key stringByReplacingOccurrencesOfString:@"~0" withString:@"~"];
+}
+
++ (void)appendUpdates:(NSDictionary *)updatesByPath
+             forPaths:(NSArray *)paths
+                 info:(NSMutableDictionary *)info
+              toTasks:(NSMutableArray *)tasks
+{
+    for (NSString *path in paths) {
+        BOXMetadataPathUpdate *update = updatesByPath[path];
+
+        // Only top level keys can be looked up in the known state.
+        NSString *key = [self topLevelKeyForPath:path];
+        BOOL isKnown = (info != nil && key != nil);
+        id knownValue = isKnown ? info[key] : nil;
+
+        BOXMetadataUpdateOperation operation;
+        if (update.lastOperation == BOXMetadataUpdateREMOVE) {
+            // Removing a key that was only added by these tasks, or that does not exist, is a no-op.
+            if (isKnown ? knownValue == nil : update.firstOperation == BOXMetadataUpdateADD) {
+                continue;
+            }
+            operation = BOXMetadataUpdateREMOVE;
+        } else if (isKnown) {
+            operation = (knownValue != nil) ? BOXMetadataUpdateREPLACE : BOXMetadataUpdateADD;
+        } else {
+            operation = (update.firstOperation == BOXMetadataUpdateADD) ? BOXMetadataUpdateADD : BOXMetadataUpdateREPLACE;
+        }
+
+        if (isKnown && operation != BOXMetadataUpdateADD && [knownValue isKindOfClass:[NSString class]]) {
+            [tasks addObject:[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateTEST path:path value:knownValue]];
+        }
+        NSString *value = (operation == BOXMetadataUpdateREMOVE) ? nil : update.value;
+        [tasks addObject:[[BOXMetadataUpdateTask alloc] initWithOperation:operation path:path value:value]];
+
+        if (isKnown) {
+            if (operation == BOXMetadataUpdateREMOVE) {
+                [info removeObjectForKey:key];
+            } else {
+                info[key] = value;
+            }
+        }
+    }
+}
+
+@end
@@ -0,0 +1,221 @@
+//
+//  BOXMetricsRegistry.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * Histogram of latencies in fixed memory, in the manner of HdrHistogram: values are counted in buckets whose
+ * width grows with the value, so that every recorded latency is kept to within about 6% from one microsecond
+ * to several days. Not thread safe; BOXMetricsRegistry records into atomic buckets of its own and hands out
+ * histograms copied from them.
+ */
+@interface BOXLatencyHistogram : NSObject <NSCopying>
+
+@property (nonatomic, readonly, assign) unsigned long long count;
+@property (nonatomic, readonly, assign) NSTimeInterval minLatency;
+@property (nonatomic, readonly, assign) NSTimeInterval maxLatency;
+@property (nonatomic, readonly, assign) NSTimeInterval meanLatency;
+
+- (void)recordLatency:(NSTimeInterval)latency;
+
+/**
+ * The latency below which percentile percent of the recorded latencies fall, e.g. 99.0 for the p99. Returns 0
+ * if nothing was recorded.
+ */
+- (NSTimeInterval)latencyAtPercentile:(double)percentile;
+
+@end
+
+/**
+ * Request metrics of one resource family, i.e. the first path component of the API endpoints, such as "files",
+ * "folders" or "search".
+ */
+@interface BOXRequestFamilyMetrics : NSObject <NSCopying>
+
+@property (nonatomic, readonly, copy) NSString *family;
+@property (nonatomic, readonly, assign) unsigned long long requestCount;
+@property (nonatomic, readonly, assign) unsigned long long errorCount;
+
+/**
+ * Number of failed requests by HTTP status code. Requests that failed without a response are counted under 0.
+ */
+@property (nonatomic, readonly, copy) NSDictionary<NSNumber *, NSNumber *> *errorCountsByStatusCode;
+
+/**
+ * Number of requests that were re-enqueued attempts of an earlier request, e.g. after a token refresh or a 202.
+ */
+@property (nonatomic, readonly, assign) unsigned long long retryCount;
+
+@property (nonatomic, readonly, assign) unsigned long long bytesSent;
+@property (nonatomic, readonly, assign) unsigned long long bytesReceived;
+
+/**
+ * Bytes of request bodies before they were compressed. Equal to bytesSent for requests that were not compressed.
+ */
+@property (nonatomic, readonly, assign) unsigned long long uncompressedBytesSent;
+
+/**
+ * Bytes of response bodies on the wire and after their Content-Encoding was decoded. Only counted for requests
+ * whose transaction metrics report them (iOS 13 and later), 0 otherwise.
+ */
+@property (nonatomic, readonly, assign) unsigned long long responseBodyBytesReceived;
+@property (nonatomic, readonly, assign) unsigned long long decodedResponseBodyBytes;
+
+/**
+ * Uncompressed over transferred bytes of request bodies, e.g. 5.0 when bodies shrank to a fifth. 1 if nothing
+ * was transferred.
+ */
+- (double)requestCompressionRatio;
+
+/**
+ * Decoded over transferred bytes of response bodies. 0 if no request reported its response body bytes.
+ */
+- (double)responseCompressionRatio;
+
+/**
+ * Latency from the start of the session task to its completion.
+ */
+@property (nonatomic, readonly, copy) BOXLatencyHistogram *latencyHistogram;
+
+@end
+
+/**
+ * Lookups in one cache layer.
+ */
+@interface BOXCacheMetrics : NSObject <NSCopying>
+
+@property (nonatomic, readonly, copy) NSString *layer;
+@property (nonatomic, readonly, assign) unsigned long long hitCount;
+@property (nonatomic, readonly, assign) unsigned long long missCount;
+
+/**
+ * hitCount over all lookups, 0 if there were none.
+ */
+- (double)hitRatio;
+
+@end
+
+/**
+ * Depth and in-flight count of the operation queues with one name, summed over every queue manager.
+ */
+@interface BOXQueueMetrics : NSObject
+
+@property (nonatomic, readonly, copy) NSString *name;
+
+/** Operations waiting to start. */
+@property (nonatomic, readonly, assign) NSUInteger depth;
+
+/** Operations executing. */
+@property (nonatomic, readonly, assign) NSUInteger inFlightCount;
+
+@end
+
+/**
+ * Level of the operation queues with one name, summed over every queue manager. Queue managers update it as they
+ * enqueue operations, and operations as they start and finish. Thread safe, and updating it does not lock.
+ */
+@interface BOXQueueGauge : NSObject
+
+@property (nonatomic, readonly, copy) NSString *name;
+
+- (void)operationEnqueued;
+- (void)operationStarted;
+
+/**
+ * @param started   Whether the operation was counted as started, i.e. in flight rather than waiting.
+ */
+- (void)operationFinishedAfterStarting:(BOOL)started;
+
+@end
+
+/**
+ * Immutable copy of the metrics at one point in time. It can be read from any thread without locking.
+ */
+@interface BOXMetricsSnapshot : NSObject
+
+@property (nonatomic, readonly, strong) NSDate *date;
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, BOXRequestFamilyMetrics *> *requestMetricsByFamily;
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, BOXCacheMetrics *> *cacheMetricsByLayer;
+@property (nonatomic, readonly, copy) NSDictionary<NSString *, BOXQueueMetrics *> *queueMetricsByName;
+
+- (unsigned long long)requestCount;
+- (unsigned long long)errorCount;
+- (unsigned long long)bytesSent;
+- (unsigned long long)bytesReceived;
+- (unsigned long long)uncompressedBytesSent;
+- (unsigned long long)responseBodyBytesReceived;
+- (unsigned long long)decodedResponseBodyBytes;
+
+@end
+
+/**
+ * SDK-wide metrics: per resource family request and error counts, latency histograms, bytes transferred and
+ * retries, hit and miss counts of each cache layer, and gauges of the operation queues of the queue managers.
+ *
+ * Every API operation records itself when it finishes. Recording only updates atomic counters and histogram
+ * buckets of its family, without locking or allocating, except for the first request of a family and for failed
+ * requests, whose status codes are counted under a lock of their family. Queue gauges are counters updated as
+ * operations are enqueued and finish, so taking a snapshot never walks the queues.
+ *
+ * Counters are read one at a time, so a snapshot taken while requests finish may count a request in some of them
+ * and not yet in others.
+ *
+ * Apps providing a cache client can report its lookups with recordCacheLookupInLayer:hit:, next to the layers of
+ * the SDK (BOXMetricsCacheLayerPathResolver, BOXMetricsCacheLayerSearchSession, BOXMetricsCacheLayerResumeData).
+ */
+@interface BOXMetricsRegistry : NSObject
+
++ (instancetype)sharedRegistry;
+
+/**
+ * Whether anything is recorded. Defaults to YES.
+ */
+@property (atomic, readwrite, assign) BOOL enabled;
+
+/**
+ * The resource family of an API URL: the first path component after the API version, e.g. "folders" for
+ * https://api.box.com/2.0/folders/0/items.
+ */
++ (NSString *)resourceFamilyForURL:(NSURL *)URL;
+
+- (void)recordRequestInFamily:(NSString *)family
+                   statusCode:(NSInteger)statusCode
+                       failed:(BOOL)failed
+                      latency:(NSTimeInterval)latency
+                    bytesSent:(unsigned long long)bytesSent
+                bytesReceived:(unsigned long long)bytesReceived
+                      retried:(BOOL)retried;
+
+/**
+ * As above, for requests whose bodies may have been compressed on the wire. bytesSent and bytesReceived are the
+ * bytes transferred and uncompressedBytesSent the bytes of the request body itself. responseBodyBytesReceived and
+ * decodedResponseBodyBytes are the response body bytes before and after decoding, 0 when they were not reported.
+ */
+- (void)recordRequestInFamily:(NSString *)family
+                   statusCode:(NSInteger)statusCode
+                       failed:(BOOL)failed
+                      latency:(NSTimeInterval)latency
+                    bytesSent:(unsigned long long)bytesSent
+        uncompressedBytesSent:(unsigned long long)uncompressedBytesSent
+                bytesReceived:(unsigned long long)bytesReceived
+    responseBodyBytesReceived:(unsigned long long)responseBodyBytesReceived
+     decodedResponseBodyBytes:(unsigned long long)decodedResponseBodyBytes
+                      retried:(BOOL)retried;
+
+- (void)recordCacheLookupInLayer:(NSString *)layer hit:(BOOL)hit;
+
+/**
+ * The gauge reported under name in snapshots, shared by the queues of every queue manager with that name.
+ */
+- (BOXQueueGauge *)gaugeForQueueNamed:(NSString *)name;
+
+- (BOXMetricsSnapshot *)snapshot;
+
+/**
+ * Clears every count and histogram. Queue gauges keep their levels.
+ */
+- (void)reset;
+
+@end
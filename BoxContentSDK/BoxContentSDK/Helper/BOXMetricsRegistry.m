@@ -0,0 +1,696 @@
+//
+//  BOXMetricsRegistry.m
+//  BoxContentSDK
+//
+
+#import "BOXMetricsRegistry.h"
+
+#import <stdatomic.h>
+
+// Latencies are counted in microseconds. Values below 2^4 get a bucket each; above, each power of two is split
+// into 2^4 buckets, up to 2^40 microseconds.
+#define BOX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS (4)
+#define BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT (1 << BOX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS)
+#define BOX_LATENCY_HISTOGRAM_MAX_EXPONENT (39)
+#define BOX_LATENCY_HISTOGRAM_BUCKET_COUNT (BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT * (BOX_LATENCY_HISTOGRAM_MAX_EXPONENT - BOX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS + 2))
+
+static NSUInteger BOXLatencyHistogramBucketIndex(uint64_t microseconds)
+{
+    if (microseconds < BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) {
+        return (NSUInteger)microseconds;
+    }
+    unsigned int exponent = 63 - __builtin_clzll(microseconds);
+    if (exponent > BOX_LATENCY_HISTOGRAM_MAX_EXPONENT) {
+        return BOX_LATENCY_HISTOGRAM_BUCKET_COUNT - 1;
+    }
+    unsigned int shift = exponent - BOX_LATENCY_HISTOGRAM_SUB_BUCKET_BITS;
+    NSUInteger subBucket = (NSUInteger)((microseconds >> shift) & (BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT - 1));
+    return BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT * (shift + 1) + subBucket;
+}
+
+// The highest value counted in the bucket.
+static uint64_t BOXLatencyHistogramBucketUpperBound(NSUInteger index)
+{
+    if (index < BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) {
+        return index;
+    }
+    unsigned int shift = (unsigned int)(index / BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT) - 1;
+    uint64_t subBucket = index % BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT;
+    return ((BOX_LATENCY_HISTOGRAM_SUB_BUCKET_COUNT + subBucket + 1) << shift) - 1;
+}
+
+@interface BOXLatencyHistogram ()
+{
+    uint32_t _counts[BOX_LATENCY_HISTOGRAM_BUCKET_COUNT];
+    uint64_t _minMicroseconds;
+    uint64_t _maxMicroseconds;
+    uint64_t _totalMicroseconds;
+}
+
+@property (nonatomic, readwrite, assign) unsigned long long count;
+
+- (instancetype)initWithBucketCounts:(const uint32_t *)counts
+                     minMicroseconds:(uint64_t)minMicroseconds
+                     maxMicroseconds:(uint64_t)maxMicroseconds
+                   totalMicroseconds:(uint64_t)totalMicroseconds;
+
+@end
+
+@implementation BOXLatencyHistogram
+
+// A histogram of the given bucket counts, of BOX_LATENCY_HISTOGRAM_BUCKET_COUNT buckets.
+- (instancetype)initWithBucketCounts:(const uint32_t *)counts
+                     minMicroseconds:(uint64_t)minMicroseconds
+                     maxMicroseconds:(uint64_t)maxMicroseconds
+                   totalMicroseconds:(uint64_t)totalMicroseconds
+{
+    if (self = [super init]) {
+        unsigned long long count = 0;
+        for (NSUInteger index = 0; index < BOX_LATENCY_HISTOGRAM_BUCKET_COUNT; index++) {
+            _counts[index] = counts[index];
+            count += counts[index];
+        }
+        _count = count;
+        _minMicroseconds = (count > 0) ? minMicroseconds : 0;
+        _maxMicroseconds = maxMicroseconds;
+        _totalMicroseconds = totalMicroseconds;
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    BOXLatencyHistogram *copy = [[BOXLatencyHistogram allocWithZone:zone] init];
+    memcpy(copy->_counts, _counts, sizeof(_counts));
+    copy->_minMicroseconds = _minMicroseconds;
+    copy->_maxMicroseconds = _maxMicroseconds;
+    copy->_totalMicroseconds = _totalMicroseconds;
+    copy.count = self.count;
+    return copy;
+}
+
+- (void)recordLatency:(NSTimeInterval)latency
+{
+    uint64_t microseconds = (uint64_t)llround(MAX(latency, 0) * 1000000.0);
+    NSUInteger index = BOXLatencyHistogramBucketIndex(microseconds);
+    if (_counts[index] < UINT32_MAX) {
+        _counts[index]++;
+    }
+    _minMicroseconds = (self.count == 0) ? microseconds : MIN(_minMicroseconds, microseconds);
+    _maxMicroseconds = MAX(_maxMicroseconds, microseconds);
+    _totalMicroseconds += microseconds;
+    self.count++;
+}
+
+- (NSTimeInterval)minLatency
+{
+    return _minMicroseconds / 1000000.0;
+}
+
+- (NSTimeInterval)maxLatency
+{
+    return _maxMicroseconds / 1000000.0;
+}
+
+- (NSTimeInterval)meanLatency
+{
+    return self.count > 0 ? (_totalMicroseconds / (double)self.count) / 1000000.0 : 0;
+}
+
+- (NSTimeInterval)latencyAtPercentile:(double)percentile
+{
+    if (self.count == 0) {
+        return 0;
+    }
+    double clampedPercentile = MIN(MAX(percentile, 0.0), 100.0);
+    unsigned long long targetCount = MAX((unsigned long long)ceil(clampedPercentile / 100.0 * self.count), 1ULL);
+    unsigned long long cumulativeCount = 0;
+    for (NSUInteger index = 0; index < BOX_LATENCY_HISTOGRAM_BUCKET_COUNT; index++) {
+        cumulativeCount += _counts[index];
+        if (cumulativeCount >= targetCount) {
+            return MIN(BOXLatencyHistogramBucketUpperBound(index), _maxMicroseconds) / 1000000.0;
+        }
+    }
+    return self.maxLatency;
+}
+
+@end
+
+@interface BOXRequestFamilyMetrics ()
+
+@property (nonatomic, readwrite, copy) NSString *family;
+@property (nonatomic, readwrite, assign) unsigned long long requestCount;
+@property (nonatomic, readwrite, assign) unsigned long long errorCount;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *mutableErrorCountsByStatusCode;
+@property (nonatomic, readwrite, assign) unsigned long long retryCount;
+@property (nonatomic, readwrite, assign) unsigned long long bytesSent;
+@property (nonatomic, readwrite, assign) unsigned long long bytesReceived;
+@property (nonatomic, readwrite, assign) unsigned long long uncompressedBytesSent;
+@property (nonatomic, readwrite, assign) unsigned long long responseBodyBytesReceived;
+@property (nonatomic, readwrite, assign) unsigned long long decodedResponseBodyBytes;
+@property (nonatomic, readwrite, copy) BOXLatencyHistogram *latencyHistogram;
+
+- (instancetype)initWithFamily:(NSString *)family;
+
+@end
+
+@implementation BOXRequestFamilyMetrics
+
+- (instancetype)initWithFamily:(NSString *)family
+{
+    if (self = [super init]) {
+        _family = [family copy];
+        _mutableErrorCountsByStatusCode = [NSMutableDictionary dictionary];
+        _latencyHistogram = [[BOXLatencyHistogram alloc] init];
+    }
+    return self;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    BOXRequestFamilyMetrics *copy = [[BOXRequestFamilyMetrics allocWithZone:zone] initWithFamily:self.family];
+    copy.requestCount = self.requestCount;
+    copy.errorCount = self.errorCount;
+    copy.mutableErrorCountsByStatusCode = [self.mutableErrorCountsByStatusCode mutableCopy];
+    copy.retryCount = self.retryCount;
+    copy.bytesSent = self.bytesSent;
+    copy.bytesReceived = self.bytesReceived;
+    copy.uncompressedBytesSent = self.uncompressedBytesSent;
+    copy.responseBodyBytesReceived = self.responseBodyBytesReceived;
+    copy.decodedResponseBodyBytes = self.decodedResponseBodyBytes;
+    copy.latencyHistogram = self.latencyHistogram;
+    return copy;
+}
+
+- (NSDictionary *)errorCountsByStatusCode
+{
+    return [self.mutableErrorCountsByStatusCode copy];
+}
+
+- (double)requestCompressionRatio
+{
+    return self.bytesSent > 0 ? (double)self.uncompressedBytesSent / self.bytesSent : 1.0;
+}
+
+- (double)responseCompressionRatio
+{
+    return self.responseBodyBytesReceived > 0 ? (double)self.decodedResponseBodyBytes / self.responseBodyBytesReceived : 0.0;
+}
+
+@end
+
+@interface BOXCacheMetrics ()
+
+@property (nonatomic, readwrite, copy) NSString *layer;
+@property (nonatomic, readwrite, assign) unsigned long long hitCount;
+@property (nonatomic, readwrite, assign) unsigned long long missCount;
+
+@end
+
+@implementation BOXCacheMetrics
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    BOXCacheMetrics *copy = [[BOXCacheMetrics allocWithZone:zone] init];
+    copy.layer = self.layer;
+    copy.hitCount = self.hitCount;
+    copy.missCount = self.missCount;
+    return copy;
+}
+
+- (double)hitRatio
+{
+    unsigned long long lookupCount = self.hitCount + self.missCount;
+    return lookupCount > 0 ? (double)self.hitCount / lookupCount : 0;
+}
+
+@end
+
+@interface BOXQueueMetrics ()
+
+@property (nonatomic, readwrite, copy) NSString *name;
+@property (nonatomic, readwrite, assign) NSUInteger depth;
+@property (nonatomic, readwrite, assign) NSUInteger inFlightCount;
+
+@end
+
+@implementation BOXQueueMetrics
+@end
+
+@interface BOXQueueGauge ()
+{
+    _Atomic int64_t _depth;
+    _Atomic int64_t _inFlightCount;
+}
+
+@property (nonatomic, readwrite, copy) NSString *name;
+
+- (BOXQueueMetrics *)metrics;
+
+@end
+
+@implementation BOXQueueGauge
+
+- (void)operationEnqueued
+{
+    atomic_fetch_add_explicit(&_depth, 1, memory_order_relaxed);
+}
+
+- (void)operationStarted
+{
+    atomic_fetch_sub_explicit(&_depth, 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_inFlightCount, 1, memory_order_relaxed);
+}
+
+- (void)operationFinishedAfterStarting:(BOOL)started
+{
+    if (started) {
+        atomic_fetch_sub_explicit(&_inFlightCount, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_sub_explicit(&_depth, 1, memory_order_relaxed);
+    }
+}
+
+- (BOXQueueMetrics *)metrics
+{
+    BOXQueueMetrics *metrics = [[BOXQueueMetrics alloc] init];
+    metrics.name = self.name;
+    // The two counters are not read together, so an operation starting meanwhile can briefly take them below 0.
+    metrics.depth = (NSUInteger)MAX(atomic_load_explicit(&_depth, memory_order_relaxed), 0);
+    metrics.inFlightCount = (NSUInteger)MAX(atomic_load_explicit(&_inFlightCount, memory_order_relaxed), 0);
+    return metrics;
+}
+
+@end
+
+// Counts of one resource family. Every count is atomic, so recording a request only takes a lock to count the status
+// code of a failed one.
+@interface BOXRequestFamilyRecorder : NSObject
+{
+    _Atomic uint64_t _requestCount;
+    _Atomic uint64_t _errorCount;
+    _Atomic uint64_t _retryCount;
+    _Atomic uint64_t _bytesSent;
+    _Atomic uint64_t _bytesReceived;
+    _Atomic uint64_t _uncompressedBytesSent;
+    _Atomic uint64_t _responseBodyBytesReceived;
+    _Atomic uint64_t _decodedResponseBodyBytes;
+    _Atomic uint32_t _latencyCounts[BOX_LATENCY_HISTOGRAM_BUCKET_COUNT];
+    _Atomic uint64_t _minLatencyMicroseconds;
+    _Atomic uint64_t _maxLatencyMicroseconds;
+    _Atomic uint64_t _totalLatencyMicroseconds;
+}
+
+@property (nonatomic, readonly, copy) NSString *family;
+
+// Guarded by @synchronized(self).
+@property (nonatomic, readonly, strong) NSMutableDictionary *errorCountsByStatusCode;
+
+- (instancetype)initWithFamily:(NSString *)family;
+- (void)recordStatusCode:(NSInteger)statusCode
+                  failed:(BOOL)failed
+                 latency:(NSTimeInterval)latency
+               bytesSent:(unsigned long long)bytesSent
+   uncompressedBytesSent:(unsigned long long)uncompressedBytesSent
+           bytesReceived:(unsigned long long)bytesReceived
+responseBodyBytesReceived:(unsigned long long)responseBodyBytesReceived
+decodedResponseBodyBytes:(unsigned long long)decodedResponseBodyBytes
+                 retried:(BOOL)retried;
+- (BOXRequestFamilyMetrics *)metrics;
+
+@end
+
+@implementation BOXRequestFamilyRecorder
+
+- (instancetype)initWithFamily:(NSString *)family
+{
+    if (self = [super init]) {
+        _family = [family copy];
+        _errorCountsByStatusCode = [NSMutableDictionary dictionary];
+        atomic_init(&_minLatencyMicroseconds, UINT64_MAX);
+    }
+    return self;
+}
+
+- (void)recordStatusCode:(NSInteger)statusCode
+                  failed:(BOOL)failed
+                 latency:(NSTimeInterval)latency
+               bytesSent:(unsigned long long)bytesSent
+   uncompressedBytesSent:(unsigned long long)uncompressedBytesSent
+           bytesReceived:(unsigned long long)bytesReceived
+responseBodyBytesReceived:(unsigned long long)responseBodyBytesReceived
+decodedResponseBodyBytes:(unsigned long long)decodedResponseBodyBytes
+                 retried:(BOOL)retried
+{
+    atomic_fetch_add_explicit(&_requestCount, 1, memory_order_relaxed);
+    if (failed) {
+        atomic_fetch_add_explicit(&_errorCount, 1, memory_order_relaxed);
+        NSNumber *key = @(MAX(statusCode, 0));
+        @synchronized(self) {
+            self.errorCountsByStatusCode[key] = @([self.errorCountsByStatusCode[key] unsignedLongLongValue] + 1);
+        }
+    }
+    if (retried) {
+        atomic_fetch_add_explicit(&_retryCount, 1, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&_bytesSent, bytesSent, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_bytesReceived, bytesReceived, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_uncompressedBytesSent, uncompressedBytesSent, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_responseBodyBytesReceived, responseBodyBytesReceived, memory_order_relaxed);
+    atomic_fetch_add_explicit(&_decodedResponseBodyBytes, decodedResponseBodyBytes, memory_order_relaxed);
+
+    uint64_t microseconds = (uint64_t)llround(MAX(latency, 0) * 1000000.0);
+    _Atomic uint32_t *bucket = &_latencyCounts[BOXLatencyHistogramBucketIndex(microseconds)];
+    if (atomic_load_explicit(bucket, memory_order_relaxed) < UINT32_MAX) {
+        atomic_fetch_add_explicit(bucket, 1, memory_order_relaxed);
+    }
+    atomic_fetch_add_explicit(&_totalLatencyMicroseconds, microseconds, memory_order_relaxed);
+    uint64_t minMicroseconds = atomic_load_explicit(&_minLatencyMicroseconds, memory_order_relaxed);
+    while (microseconds < minMicroseconds &&
+           !atomic_compare_exchange_weak_explicit(&_minLatencyMicroseconds, &minMicroseconds, microseconds, memory_order_relaxed, memory_order_relaxed)) {
+    }
+    uint64_t maxMicroseconds = atomic_load_explicit(&_maxLatencyMicroseconds, memory_order_relaxed);
+    while (microseconds > maxMicroseconds &&
+           !atomic_compare_exchange_weak_explicit(&_maxLatencyMicroseconds, &maxMicroseconds, microseconds, memory_order_relaxed, memory_order_relaxed)) {
+    }
+}
+
+- (BOXRequestFamilyMetrics *)metrics
+{
+    BOXRequestFamilyMetrics *metrics = [[BOXRequestFamilyMetrics alloc] initWithFamily:self.family];
+    metrics.requestCount = atomic_load_explicit(&_requestCount, memory_order_relaxed);
+    metrics.errorCount = atomic_load_explicit(&_errorCount, memory_order_relaxed);
+    metrics.retryCount = atomic_load_explicit(&_retryCount, memory_order_relaxed);
+    metrics.bytesSent = atomic_load_explicit(&_bytesSent, memory_order_relaxed);
+    metrics.bytesReceived = atomic_load_explicit(&_bytesReceived, memory_order_relaxed);
+    metrics.uncompressedBytesSent = atomic_load_explicit(&_uncompressedBytesSent, memory_order_relaxed);
+    metrics.responseBodyBytesReceived = atomic_load_explicit(&_responseBodyBytesReceived, memory_order_relaxed);
+    metrics.decodedResponseBodyBytes = atomic_load_explicit(&_decodedResponseBodyBytes, memory_order_relaxed);
+    @synchronized(self) {
+        metrics.mutableErrorCountsByStatusCode = [self.errorCountsByStatusCode mutableCopy];
+    }
+
+    uint32_t latencyCounts[BOX_LATENCY_HISTOGRAM_BUCKET_COUNT];
+    for (NSUInteger index = 0; index < BOX_LATENCY_HISTOGRAM_BUCKET_COUNT; index++) {
+        latencyCounts[index] = atomic_load_explicit(&_latencyCounts[index], memory_order_relaxed);
+    }
+    metrics.latencyHistogram = [[BOXLatencyHistogram alloc] initWithBucketCounts:latencyCounts
+                                                                 minMicroseconds:atomic_load_explicit(&_minLatencyMicroseconds, memory_order_relaxed)
+                                                                 maxMicroseconds:atomic_load_explicit(&_maxLatencyMicroseconds, memory_order_relaxed)
+                                                               totalMicroseconds:atomic_load_explicit(&_totalLatencyMicroseconds, memory_order_relaxed)];
+    return metrics;
+}
+
+@end
+
+@interface BOXCacheLayerRecorder : NSObject
+{
+    _Atomic uint64_t _hitCount;
+    _Atomic uint64_t _missCount;
+}
+
+@property (nonatomic, readwrite, copy) NSString *layer;
+
+- (void)recordHit:(BOOL)hit;
+- (BOXCacheMetrics *)metrics;
+
+@end
+
+@implementation BOXCacheLayerRecorder
+
+- (void)recordHit:(BOOL)hit
+{
+    atomic_fetch_add_explicit(hit ? &_hitCount : &_missCount, 1, memory_order_relaxed);
+}
+
+- (BOXCacheMetrics *)metrics
+{
+    BOXCacheMetrics *metrics = [[BOXCacheMetrics alloc] init];
+    metrics.layer = self.layer;
+    metrics.hitCount = atomic_load_explicit(&_hitCount, memory_order_relaxed);
+    metrics.missCount = atomic_load_explicit(&_missCount, memory_order_relaxed);
+    return metrics;
+}
+
+@end
+
+@interface BOXMetricsSnapshot ()
+
+@property (nonatomic, readwrite, strong) NSDate *date;
+@property (nonatomic, readwrite, copy) NSDictionary *requestMetricsByFamily;
+@property (nonatomic, readwrite, copy) NSDictionary *cacheMetricsByLayer;
+@property (nonatomic, readwrite, copy) NSDictionary *queueMetricsByName;
+
+@end
+
+@implementation BOXMetricsSnapshot
+
+- (unsigned long long)requestCount
+{
+    unsigned long long requestCount = 0;
+    for (BOXRequestFamilyMetrics *metrics in self.requestMetricsByFamily.allValues) {
+        requestCount += metrics.requestCount;
+    }
+    return requestCount;
+}
+
+- (unsigned long long)errorCount
+{
+    unsigned long long errorCount = 0;
+    for (BOXRequestFamilyMetrics *metrics in self.requestMetricsByFamily.allValues) {
+        errorCount += metrics.errorCount;
+    }
+    return errorCount;
+}
+
+- (unsigned long long)bytesSent
+{
+    unsigned long long bytesSent = 0;
+    for (BOXRequestFamilyMetrics *metrics in self.requestMetricsByFamily.allValues) {
+        bytesSent += metrics.bytesSent;
+    }
+    return bytesSent;
+}
+
+- (unsigned long long)bytesReceived
+{
+    unsigned long long bytesReceived = 0;
+    for (BOXRequestFamilyMetrics *metrics in self.requestMetricsByFamily.allValues) {
+        bytesReceived += metrics.bytesReceived;
+    }
+    return bytesReceived;
+}
+
+- (unsigned long long)uncompressedBytesSent
+{
+    unsigned long long uncompressedBytesSent = 0;
+    for (BOXRequestFamilyMetrics *metrics in self.requestMetricsByFamily.allValues) {
+        uncompressedBytesSent += metrics.uncompressedBytesSent;
+    }
+    return uncompressedBytesSent;
+}
+
+- (unsigned long long)responseBodyBytesReceived
+{
+    unsigned long long responseBodyBytesReceived = 0;
+    for (BOXRequestFamilyMetrics *metrics in self.requestMetricsByFamily.allValues) {
+        responseBodyBytesReceived += metrics.responseBodyBytesReceived;
+    }
+    return responseBodyBytesReceived;
+}
+
+- (unsigned long long)decodedResponseBodyBytes
+{
+    unsigned long long decodedResponseBodyBytes = 0;
+    for (BOXRequestFamilyMetrics *metrics in self.requestMetricsByFamily.allValues) {
+        decodedResponseBodyBytes += metrics.decodedResponseBodyBytes;
+    }
+    return decodedResponseBodyBytes;
+}
+
+@end
+
+@interface BOXMetricsRegistry ()
+
+// Recorders keyed by family and layer, and gauges keyed by queue name. Each dictionary is immutable, so that it can
+// be read without locking; adding an entry replaces it with a copy under @synchronized(self).
+@property (atomic, readwrite, copy) NSDictionary<NSString *, BOXRequestFamilyRecorder *> *familyRecorders;
+@property (atomic, readwrite, copy) NSDictionary<NSString *, BOXCacheLayerRecorder *> *cacheLayerRecorders;
+@property (atomic, readwrite, copy) NSDictionary<NSString *, BOXQueueGauge *> *queueGauges;
+
+@end
+
+@implementation BOXMetricsRegistry
+
++ (instancetype)sharedRegistry
+{
+    static BOXMetricsRegistry *sharedRegistry = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedRegistry = [[BOXMetricsRegistry alloc] init];
+    });
+    return sharedRegistry;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _enabled = YES;
+        _familyRecorders = @{};
+        _cacheLayerRecorders = @{};
+        _queueGauges = @{};
+    }
+    return self;
+}
+
++ (NSString *)resourceFamilyForURL:(NSURL *)URL
+{
+    NSArray *components = URL.pathComponents;
+    NSString *family = nil;
+    for (NSUInteger index = 0; index < components.count; index++) {
+        NSString *component = components[index];
+        if ([component isEqualToString:@"/"] || [component isEqualToString:@"api"]) {
+            continue;
+        }
+        // Skip the API version, e.g. "2.0".
+        if (family == nil && component.length > 0 && isdigit([component characterAtIndex:0])) {
+            continue;
+        }
+        family = component;
+        break;
+    }
+    return family.length > 0 ? family : @"unknown";
+}
+
+- (void)recordRequestInFamily:(NSString *)family
+                   statusCode:(NSInteger)statusCode
+                       failed:(BOOL)failed
+                      latency:(NSTimeInterval)latency
+                    bytesSent:(unsigned long long)bytesSent
+                bytesReceived:(unsigned long long)bytesReceived
+                      retried:(BOOL)retried
+{
+    [self recordRequestInFamily:family
+                     statusCode:statusCode
+                         failed:failed
+                        latency:latency
+                      bytesSent:bytesSent
+          uncompressedBytesSent:bytesSent
+                  bytesReceived:bytesReceived
+      responseBodyBytesReceived:0
+       decodedResponseBodyBytes:0
+                        retried:retried];
+}
+
+- (void)recordRequestInFamily:(NSString *)family
+                   statusCode:(NSInteger)statusCode
+                       failed:(BOOL)failed
+                      latency:(NSTimeInterval)latency
+                    bytesSent:(unsigned long long)bytesSent
+        uncompressedBytesSent:(unsigned long long)uncompressedBytesSent
+                bytesReceived:(unsigned long long)bytesReceived
+    responseBodyBytesReceived:(unsigned long long)responseBodyBytesReceived
+     decodedResponseBodyBytes:(unsigned long long)decodedResponseBodyBytes
+                      retried:(BOOL)retried
+{
+    if (!self.enabled || family == nil) {
+        return;
+    }
+
+    BOXRequestFamilyRecorder *recorder = self.familyRecorders[family];
+    if (recorder == nil) {
+        @synchronized(self) {
+            recorder = self.familyRecorders[family];
+            if (recorder == nil) {
+                recorder = [[BOXRequestFamilyRecorder alloc] initWithFamily:family];
+                NSMutableDictionary *familyRecorders = [self.familyRecorders mutableCopy];
+                familyRecorders[family] = recorder;
+                self.familyRecorders = familyRecorders;
+            }
+        }
+    }
+    [recorder recordStatusCode:statusCode
+                        failed:failed
+                       latency:latency
+                     bytesSent:bytesSent
+         uncompressedBytesSent:uncompressedBytesSent
+                 bytesReceived:bytesReceived
+     responseBodyBytesReceived:responseBodyBytesReceived
+      decodedResponseBodyBytes:decodedResponseBodyBytes
+                       retried:retried];
+}
+
+- (void)recordCacheLookupInLayer:(NSString *)layer hit:(BOOL)hit
+{
+    if (!self.enabled || layer == nil) {
+        return;
+    }
+
+    BOXCacheLayerRecorder *recorder = self.cacheLayerRecorders[layer];
+    if (recorder == nil) {
+        @synchronized(self) {
+            recorder = self.cacheLayerRecorders[layer];
+            if (recorder == nil) {
+                recorder = [[BOXCacheLayerRecorder alloc] init];
+                recorder.layer = layer;
+                NSMutableDictionary *cacheLayerRecorders = [self.cacheLayerRecorders mutableCopy];
+                cacheLayerRecorders[layer] = recorder;
+                self.cacheLayerRecorders = cacheLayerRecorders;
+            }
+        }
+    }
+    [recorder recordHit:hit];
+}
+
+- (BOXQueueGauge *)gaugeForQueueNamed:(NSString *)name
+{
+    NSString *key = name ?: @"unnamed";
+    BOXQueueGauge *gauge = self.queueGauges[key];
+    if (gauge == nil) {
+        @synchronized(self) {
+            gauge = self.queueGauges[key];
+            if (gauge == nil) {
+                gauge = [[BOXQueueGauge alloc] init];
+                gauge.name = key;
+                NSMutableDictionary *queueGauges = [self.queueGauges mutableCopy];
+                queueGauges[key] = gauge;
+                self.queueGauges = queueGauges;
+            }
+        }
+    }
+    return gauge;
+}
+
+- (BOXMetricsSnapshot *)snapshot
+{
+    NSMutableDictionary *requestMetricsByFamily = [NSMutableDictionary dictionary];
+    [self.familyRecorders enumerateKeysAndObjectsUsingBlock:^(NSString *family, BOXRequestFamilyRecorder *recorder, BOOL *stop) {
+        requestMetricsByFamily[family] = [recorder metrics];
+    }];
+    NSMutableDictionary *cacheMetricsByLayer = [NSMutableDictionary dictionary];
+    [self.cacheLayerRecorders enumerateKeysAndObjectsUsingBlock:^(NSString *layer, BOXCacheLayerRecorder *recorder, BOOL *stop) {
+        cacheMetricsByLayer[layer] = [recorder metrics];
+    }];
+    NSMutableDictionary *queueMetricsByName = [NSMutableDictionary dictionary];
+    [self.queueGauges enumerateKeysAndObjectsUsingBlock:^(NSString *name, BOXQueueGauge *gauge, BOOL *stop) {
+        queueMetricsByName[name] = [gauge metrics];
+    }];
+
+    BOXMetricsSnapshot *snapshot = [[BOXMetricsSnapshot alloc] init];
+    snapshot.date = [NSDate date];
+    snapshot.requestMetricsByFamily = requestMetricsByFamily;
+    snapshot.cacheMetricsByLayer = cacheMetricsByLayer;
+    snapshot.queueMetricsByName = queueMetricsByName;
+    return snapshot;
+}
+
+- (void)reset
+{
+    // Requests finishing meanwhile may still be counted by the recorders being dropped.
+    @synchronized(self) {
+        self.familyRecorders = @{};
+        self.cacheLayerRecorders = @{};
+    }
+}
+
+@end
@@ -0,0 +1,70 @@
+//
+//  BOXPathResolver.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXContentClient;
+@class BOXItem;
+
+typedef void (^BOXPathResolverBlock)(NSString *itemID, NSError *error);
+
+/**
+ *  @param itemIDsByPath Item ID of every path that could be resolved.
+ *  @param error         Set if some paths could not be resolved because a request failed. Paths that do
+ *                       not exist are simply missing from itemIDsByPath.
+ */
+typedef void (^BOXPathBatchResolverBlock)(NSDictionary<NSString *, NSString *> *itemIDsByPath, NSError *error);
+
+/**
+ *  BOXPathResolver resolves paths such as @"/Projects/2026/Q3/report.pdf" to item IDs.
+ *
+ *  It keeps a compact tree of item IDs, parent IDs and names, fed with the items the app has already
+ *  fetched (addItems:, which also records each item's path folders) and with the items it fetches itself.
+ *  Path components found in the tree and younger than freshnessInterval are resolved without a request.
+ *  Missing components are looked up with a search restricted to the parent folder (ancestorFolderIDs)
+ *  rather than by listing the parent folder; the parent is only listed when the search does not find
+ *  the name, or when many names are missing from the same folder.
+ *
+ *  Names are matched case-insensitively, as they are by Box. The resolver is safe to use from any thread,
+ *  and completion blocks are called on the main thread if the call was made on the main thread.
+ */
+@interface BOXPathResolver : NSObject
+
+/**
+ *  ID of the folder paths are relative to. Defaults to BOXAPIFolderIDRoot.
+ */
+@property (nonatomic, readwrite, copy) NSString *rootFolderID;
+
+/**
+ *  How long an entry of the tree is trusted without being fetched again. Defaults to 5 minutes.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval freshnessInterval;
+
+/**
+ *  Number of missing names in a single folder from which the folder is listed instead of searching
+ *  for each name. Defaults to 5.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger listingThreshold;
+
+- (instancetype)initWithClient:(BOXContentClient *)client;
+
+/**
+ *  Record items, and the folders of their path, in the tree.
+ */
+- (void)addItems:(NSArray<BOXItem *> *)items;
+
+- (void)removeItemWithID:(NSString *)itemID;
+
+- (void)removeAllItems;
+
+- (void)resolvePath:(NSString *)path completion:(BOXPathResolverBlock)completionBlock;
+
+/**
+ *  Resolve many paths at once. Folders shared by several paths are resolved only once, and lookups
+ *  for the same level of all paths run concurrently.
+ */
+- (void)resolvePaths:(NSArray<NSString *> *)paths completion:(BOXPathBatchResolverBlock)completionBlock;
+
+@end
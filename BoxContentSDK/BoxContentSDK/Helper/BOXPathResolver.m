@@ -0,0 +1,405 @@
+//
+//  BOXPathResolver.m
+//  BoxContentSDK
+//
+
+#import "BOXPathResolver.h"
+
+#import "BOXContentClient+Folder.h"
+#import "BOXContentClient+Search.h"
+#import "BOXFolderPaginatedItemsRequest.h"
+#import "BOXSearchRequest.h"
+#import "BOXItem.h"
+#import "BOXFolder.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXDispatchHelper.h"
+#import "BOXLog.h"
+#import "BOXMetricsRegistry.h"
+
+#define BOX_PATH_RESOLVER_DEFAULT_FRESHNESS_INTERVAL (5.0 * 60.0)
+#define BOX_PATH_RESOLVER_DEFAULT_LISTING_THRESHOLD (5)
+#define BOX_PATH_RESOLVER_SEARCH_LIMIT (100)
+#define BOX_PATH_RESOLVER_LISTING_LIMIT (1000)
+
+@interface BOXPathResolverNode : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *itemID;
+@property (nonatomic, readwrite, copy) NSString *parentID;
+@property (nonatomic, readwrite, copy) NSString *key;
+@property (nonatomic, readwrite, strong) NSDate *updatedDate;
+// Set when all the children of the folder were recorded by a listing.
+@property (nonatomic, readwrite, strong) NSDate *listedDate;
+
+@end
+
+@implementation BOXPathResolverNode
+@end
+
+// Resolution state of one path of a batch.
+@interface BOXPathResolution : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *path;
+@property (nonatomic, readwrite, strong) NSArray *keys;
+@property (nonatomic, readwrite, assign) NSUInteger index;
+@property (nonatomic, readwrite, copy) NSString *currentID;
+@property (nonatomic, readwrite, assign) BOOL finished;
+
+@end
+
+@implementation BOXPathResolution
+@end
+
+@interface BOXPathResolver ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+
+// All of the properties below are only accessed on queue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *nodesByID;
+// Parent ID -> (name key -> child ID).
+@property (nonatomic, readwrite, strong) NSMutableDictionary *childIDsByParentID;
+
+@end
+
+@implementation BOXPathResolver
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+{
+    if (self = [super init]) {
+        _client = client;
+        _rootFolderID = BOXAPIFolderIDRoot;
+        _freshnessInterval = BOX_PATH_RESOLVER_DEFAULT_FRESHNESS_INTERVAL;
+        _listingThreshold = BOX_PATH_RESOLVER_DEFAULT_LISTING_THRESHOLD;
+        _queue = dispatch_queue_create("com.box.contentsdk.pathresolver", DISPATCH_QUEUE_SERIAL);
+        _nodesByID = [NSMutableDictionary dictionary];
+        _childIDsByParentID = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+#pragma mark - Tree
+
+- (void)addItems:(NSArray<BOXItem *> *)items
+{
+    dispatch_async(self.queue, ^{
+        [self recordItems:items];
+    });
+}
+
+- (void)removeItemWithID:(NSString *)itemID
+{
+    dispatch_async(self.queue, ^{
+        [self removeNodeWithID:itemID];
+    });
+}
+
+- (void)removeAllItems
+{
+    dispatch_async(self.queue, ^{
+        [self.nodesByID removeAllObjects];
+        [self.childIDsByParentID removeAllObjects];
+    });
+}
+
+// Called on queue.
+- (void)recordItems:(NSArray<BOXItem *> *)items
+{
+    NSDate *now = [NSDate date];
+
+    for (BOXItem *item in items) {
+        // path_collection starts at the root, so each folder is the parent of the next one.
+        NSString *parentID = nil;
+        for (BOXFolderMini *folder in item.pathFolders) {
+            if (parentID) {
+                [self recordNodeWithID:folder.modelID parentID:parentID name:folder.name date:now];
+            }
+            parentID = folder.modelID;
+        }
+        if (item.parentFolder.modelID) {
+            parentID = item.parentFolder.modelID;
+        }
+        if (parentID) {
+            [self recordNodeWithID:item.modelID parentID:parentID name:item.name date:now];
+        }
+    }
+}
+
+// Called on queue.
+- (void)recordNodeWithID:(NSString *)itemID parentID:(NSString *)parentID name:(NSString *)name date:(NSDate *)date
+{
+    if (itemID.length == 0 || parentID.length == 0 || name.length == 0) {
+        return;
+    }
+
+    BOXPathResolverNode *node = self.nodesByID[itemID];
+    if (node && (![node.parentID isEqualToString:parentID] || ![node.key isEqualToString:[self keyForName:name]])) {
+        // The item was moved or renamed.
+        [self.childIDsByParentID[node.parentID] removeObjectForKey:node.key];
+    }
+    if (node == nil) {
+        node = [[BOXPathResolverNode alloc] init];
+        node.itemID = itemID;
+        self.nodesByID[itemID] = node;
+    }
+    node.parentID = parentID;
+    node.key = [self keyForName:name];
+    node.updatedDate = date;
+
+    NSMutableDictionary *childIDs = self.childIDsByParentID[parentID];
+    if (childIDs == nil) {
+        childIDs = [NSMutableDictionary dictionary];
+        self.childIDsByParentID[parentID] = childIDs;
+    }
+    childIDs[node.key] = itemID;
+}
+
+// Called on queue.
+- (void)removeNodeWithID:(NSString *)itemID
+{
+    BOXPathResolverNode *node = self.nodesByID[itemID];
+    if (node) {
+        [self.childIDsByParentID[node.parentID] removeObjectForKey:node.key];
+        [self.nodesByID removeObjectForKey:itemID];
+    }
+}
+
+- (NSString *)keyForName:(NSString *)name
+{
+    return [[name precomposedStringWithCanonicalMapping] lowercaseString];
+}
+
+- (BOOL)isDateFresh:(NSDate *)date
+{
+    return date != nil && -[date timeIntervalSinceNow] < self.freshnessInterval;
+}
+
+// Called on queue. Returns the fresh ID of the child named key of parentID, or nil.
+// Sets *isKnownMissing if the parent was recently listed and has no such child.
+- (NSString *)childIDForParentID:(NSString *)parentID key:(NSString *)key isKnownMissing:(BOOL *)isKnownMissing
+{
+    NSString *childID = self.childIDsByParentID[parentID][key];
+    BOXPathResolverNode *childNode = childID ? self.nodesByID[childID] : nil;
+    if (childNode && [self isDateFresh:childNode.updatedDate]) {
+        return childID;
+    }
+
+    BOXPathResolverNode *parentNode = self.nodesByID[parentID];
+    if (isKnownMissing) {
+        *isKnownMissing = (childID == nil && [self isDateFresh:parentNode.listedDate]);
+    }
+    return nil;
+}
+
+#pragma mark - Resolution
+
+- (void)resolvePath:(NSString *)path completion:(BOXPathResolverBlock)completionBlock
+{
+    BOOL isMainThread = [NSThread isMainThread];
+    [self resolvePaths:@[path] isMainThread:isMainThread completion:^(NSDictionary *itemIDsByPath, NSError *error) {
+        NSString *itemID = itemIDsByPath[path];
+        if (itemID == nil && error == nil) {
+            error = [[NSError alloc] initWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIErrorNotFound userInfo:nil];
+        }
+        if (completionBlock) {
+            completionBlock(itemID, error);
+        }
+    }];
+}
+
+- (void)resolvePaths:(NSArray<NSString *> *)paths completion:(BOXPathBatchResolverBlock)completionBlock
+{
+    [self resolvePaths:paths isMainThread:[NSThread isMainThread] completion:completionBlock];
+}
+
+- (void)resolvePaths:(NSArray<NSString *> *)paths isMainThread:(BOOL)isMainThread completion:(BOXPathBatchResolverBlock)completionBlock
+{
+    NSMutableArray *resolutions = [NSMutableArray arrayWithCapacity:paths.count];
+    for (NSString *path in paths) {
+        BOXPathResolution *resolution = [[BOXPathResolution alloc] init];
+        resolution.path = path;
+        NSMutableArray *keys = [NSMutableArray array];
+        for (NSString *component in [path componentsSeparatedByString:@"/"]) {
+            if (component.length > 0) {
+                [keys addObject:[self keyForName:component]];
+            }
+        }
+        resolution.keys = keys;
+        resolution.currentID = self.rootFolderID;
+        [resolutions addObject:resolution];
+    }
+
+    NSMutableDictionary *itemIDsByPath = [NSMutableDictionary dictionary];
+    __block NSError *resolutionError = nil;
+
+    dispatch_block_t complete = ^{
+        [BOXDispatchHelper callCompletionBlock:^{
+            if (completionBlock) {
+                completionBlock(itemIDsByPath, resolutionError);
+            }
+        } onMainThread:isMainThread];
+    };
+
+    dispatch_async(self.queue, ^{
+        [self advanceResolutions:resolutions
+                  attemptedLookups:[NSMutableSet set]
+                     itemIDsByPath:itemIDsByPath
+                        errorBlock:^(NSError *error) {
+                            resolutionError = error;
+                        }
+                        completion:complete];
+    });
+}
+
+// Called on queue. Walks every unfinished path down the tree as far as it can, then looks up all the
+// missing (parent, name) pairs concurrently and starts over, until every path is resolved or failed.
+// A pair is looked up at most once per batch, so a name still missing after its lookup fails the path.
+- (void)advanceResolutions:(NSArray *)resolutions
+          attemptedLookups:(NSMutableSet *)attemptedLookups
+             itemIDsByPath:(NSMutableDictionary *)itemIDsByPath
+                errorBlock:(void (^)(NSError *error))errorBlock
+                completion:(dispatch_block_t)completion
+{
+    // Parent ID -> set of missing name keys.
+    NSMutableDictionary *missingKeysByParentID = [NSMutableDictionary dictionary];
+
+    for (BOXPathResolution *resolution in resolutions) {
+        while (!resolution.finished && resolution.index < resolution.keys.count) {
+            NSString *key = resolution.keys[resolution.index];
+            NSString *lookup = [NSString stringWithFormat:@"%@/%@", resolution.currentID, key];
+            BOOL isKnownMissing = NO;
+            NSString *childID = [self childIDForParentID:resolution.currentID key:key isKnownMissing:&isKnownMissing];
+
+            [[BOXMetricsRegistry sharedRegistry] recordCacheLookupInLayer:BOXMetricsCacheLayerPathResolver hit:(childID != nil || isKnownMissing)];
+
+            if (childID) {
+                resolution.currentID = childID;
+                resolution.index++;
+            } else if (isKnownMissing || [attemptedLookups containsObject:lookup]) {
+                resolution.finished = YES;
+            } else {
+                NSMutableSet *keys = missingKeysByParentID[resolution.currentID];
+                if (keys == nil) {
+                    keys = [NSMutableSet set];
+                    missingKeysByParentID[resolution.currentID] = keys;
+                }
+                [keys addObject:key];
+                [attemptedLookups addObject:lookup];
+                break;
+            }
+        }
+        if (!resolution.finished && resolution.index == resolution.keys.count) {
+            resolution.finished = YES;
+            itemIDsByPath[resolution.path] = resolution.currentID;
+        }
+    }
+
+    if (missingKeysByParentID.count == 0) {
+        completion();
+        return;
+    }
+
+    dispatch_group_t group = dispatch_group_create();
+
+    [missingKeysByParentID enumerateKeysAndObjectsUsingBlock:^(NSString *parentID, NSSet *keys, BOOL *stop) {
+        void (^lookupCompletion)(NSError *) = ^(NSError *error) {
+            if (error) {
+                errorBlock(error);
+            }
+            dispatch_group_leave(group);
+        };
+
+        dispatch_group_enter(group);
+        if (keys.count >= self.listingThreshold) {
+            [self listFolderWithID:parentID offset:0 completion:lookupCompletion];
+        } else {
+            dispatch_group_t searchGroup = dispatch_group_create();
+            NSMutableArray *unfoundKeys = [NSMutableArray array];
+            for (NSString *key in keys) {
+                dispatch_group_enter(searchGroup);
+                [self searchChildWithKey:key parentID:parentID completion:^(BOOL found, NSError *error) {
+                    if (!found) {
+                        [unfoundKeys addObject:key];
+                    }
+                    dispatch_group_leave(searchGroup);
+                }];
+            }
+            dispatch_group_notify(searchGroup, self.queue, ^{
+                if (unfoundKeys.count > 0) {
+                    // Search can lag behind recent changes, so list the folder before giving up.
+                    [self listFolderWithID:parentID offset:0 completion:lookupCompletion];
+                } else {
+                    lookupCompletion(nil);
+                }
+            });
+        }
+    }];
+
+    dispatch_group_notify(group, self.queue, ^{
+        [self advanceResolutions:resolutions
+                attemptedLookups:attemptedLookups
+                   itemIDsByPath:itemIDsByPath
+                      errorBlock:errorBlock
+                      completion:completion];
+    });
+}
+
+// Called on queue; calls completion on queue.
+- (void)searchChildWithKey:(NSString *)key parentID:(NSString *)parentID completion:(void (^)(BOOL found, NSError *error))completion
+{
+    BOXSearchRequest *request = [self.client searchRequestWithQuery:key inRange:NSMakeRange(0, BOX_PATH_RESOLVER_SEARCH_LIMIT)];
+    request.ancestorFolderIDs = @[parentID];
+
+    [request performRequestWithCompletion:^(NSArray<BOXItem *> *items, NSUInteger totalCount, NSRange range, NSError *error) {
+        dispatch_async(self.queue, ^{
+            BOOL found = NO;
+            if (error == nil) {
+                [self recordItems:items];
+                for (BOXItem *item in items) {
+                    if ([item.parentFolder.modelID isEqualToString:parentID] && [[self keyForName:item.name] isEqualToString:key]) {
+                        found = YES;
+                        break;
+                    }
+                }
+            }
+            completion(found, error);
+        });
+    }];
+}
+
+// Called on queue; calls completion on queue.
+- (void)listFolderWithID:(NSString *)folderID offset:(NSUInteger)offset completion:(void (^)(NSError *error))completion
+{
+    BOXFolderPaginatedItemsRequest *request = [self.client folderPaginatedItemsRequestWithID:folderID
+                                                                                     inRange:NSMakeRange(offset, BOX_PATH_RESOLVER_LISTING_LIMIT)];
+
+    [request performRequestWithCompletion:^(NSArray<BOXItem *> *items, NSUInteger totalCount, NSRange range, NSError *error) {
+        dispatch_async(self.queue, ^{
+            if (error) {
+                completion(error);
+                return;
+            }
+
+            NSDate *now = [NSDate date];
+            for (BOXItem *item in items) {
+                [self recordNodeWithID:item.modelID parentID:folderID name:item.name date:now];
+            }
+
+            NSUInteger nextOffset = offset + items.count;
+            if (items.count > 0 && nextOffset < totalCount) {
+                [self listFolderWithID:folderID offset:nextOffset completion:completion];
+            } else {
+                BOXPathResolverNode *folderNode = self.nodesByID[folderID];
+                if (folderNode == nil) {
+                    folderNode = [[BOXPathResolverNode alloc] init];
+                    folderNode.itemID = folderID;
+                    self.nodesByID[folderID] = folderNode;
+                }
+                folderNode.listedDate = now;
+                completion(nil);
+            }
+        });
+    }];
+}
+
+@end
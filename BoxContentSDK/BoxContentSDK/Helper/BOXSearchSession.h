@@ -0,0 +1,98 @@
+//
+//  BOXSearchSession.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+#import "BOXRequest.h"
+
+@class BOXContentClient;
+@class BOXSearchRequest;
+
+/**
+ *  Called with the results of a session's current query.
+ *
+ *  @param query       The query the results are for.
+ *  @param items       All the results loaded so far for the query.
+ *  @param totalCount  Total number of results on the server, or 0 for provisional results.
+ *  @param provisional YES if the results were computed locally from the results of a shorter query and
+ *                     will be replaced by the server's results.
+ *  @param error       Set if the search failed.
+ */
+typedef void (^BOXSearchSessionResultsBlock)(NSString *query, NSArray <BOXItem *> *items, NSUInteger totalCount, BOOL provisional, NSError *error);
+
+/**
+ *  BOXSearchSession drives search-as-you-type on top of BOXSearchRequest.
+ *
+ *  - Queries are debounced, and a new query cancels the in-flight request of the query it supersedes.
+ *  - Results of recent queries are kept in a small LRU cache and returned without a request until they
+ *    expire.
+ *  - While the request for a longer query runs, results of a cached shorter prefix, filtered by name,
+ *    are returned as provisional results.
+ *  - Once the first page of a query is loaded, the next page is prefetched so that loadNextPage
+ *    can usually be answered immediately.
+ *
+ *  A session must be used from the main thread, and resultsBlock is called on the main thread.
+ */
+@interface BOXSearchSession : NSObject
+
+@property (nonatomic, readonly, copy) NSString *query;
+
+/**
+ *  Delay between the last call to searchWithQuery: and the search request. Defaults to 0.25s.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval debounceInterval;
+
+/**
+ *  Number of results requested per page. Defaults to 30.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger pageSize;
+
+/**
+ *  Number of queries whose results are cached. Defaults to 20.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger cacheCapacity;
+
+/**
+ *  Time after which cached results are requested again rather than returned. Defaults to 60s.
+ *  0 keeps them until they are evicted.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval cacheTimeToLive;
+
+/**
+ *  Whether the next page of a query is fetched as soon as the previous one is loaded. Defaults to YES.
+ */
+@property (nonatomic, readwrite, assign) BOOL prefetchesNextPage;
+
+/**
+ *  Called for every request created by the session, to set filters or fields on it.
+ *  The configuration must not change during the session's lifetime, since results are cached by query.
+ */
+@property (nonatomic, readwrite, copy) void (^requestConfigurationBlock)(BOXSearchRequest *request);
+
+@property (nonatomic, readwrite, copy) BOXSearchSessionResultsBlock resultsBlock;
+
+- (instancetype)initWithClient:(BOXContentClient *)client;
+
+/**
+ *  Search for query after the debounce interval, superseding any previous query.
+ *  Searching again for the current query does nothing, unless its request failed.
+ */
+- (void)searchWithQuery:(NSString *)query;
+
+/**
+ *  Load the next page of results of the current query.
+ */
+- (void)loadNextPage;
+
+/**
+ *  Cancel any pending or in-flight search.
+ */
+- (void)cancel;
+
+/**
+ *  Empty the results cache.
+ */
+- (void)clearCache;
+
+@end
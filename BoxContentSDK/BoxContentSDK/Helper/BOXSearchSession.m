@@ -0,0 +1,336 @@
+//
+//  BOXSearchSession.m
+//  BoxContentSDK
+//
+
+#import "BOXSearchSession.h"
+
+#import "BOXContentClient+Search.h"
+#import "BOXSearchRequest.h"
+#import "BOXItem.h"
+#import "BOXLog.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXMetricsRegistry.h"
+
+#define BOX_SEARCH_SESSION_DEFAULT_DEBOUNCE_INTERVAL (0.25)
+#define BOX_SEARCH_SESSION_DEFAULT_PAGE_SIZE (30)
+#define BOX_SEARCH_SESSION_DEFAULT_CACHE_CAPACITY (20)
+#define BOX_SEARCH_SESSION_DEFAULT_CACHE_TIME_TO_LIVE (60.0)
+
+@interface BOXSearchSessionCacheEntry : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *query;
+@property (nonatomic, readwrite, copy) NSString *key;
+@property (nonatomic, readwrite, strong) NSMutableArray *items;
+@property (nonatomic, readwrite, assign) NSUInteger totalCount;
+@property (nonatomic, readwrite, strong) NSDate *loadDate;
+// The page after items, fetched ahead of a call to loadNextPage.
+@property (nonatomic, readwrite, strong) NSArray *prefetchedItems;
+@property (nonatomic, readwrite, strong) BOXSearchRequest *prefetchRequest;
+@property (nonatomic, readwrite, assign) BOOL nextPageRequested;
+
+@end
+
+@implementation BOXSearchSessionCacheEntry
+@end
+
+@interface BOXSearchSession ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, copy) NSString *query;
+@property (nonatomic, readwrite, assign) NSUInteger generation;
+@property (nonatomic, readwrite, strong) BOXSearchRequest *currentRequest;
+// Whether the first page of query failed to load, so that searching for it again retries.
+@property (nonatomic, readwrite, assign) BOOL queryFailed;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *cacheEntries;
+// Keys of cacheEntries, least recently used first.
+@property (nonatomic, readwrite, strong) NSMutableArray *cacheKeys;
+
+@end
+
+@implementation BOXSearchSession
+
+- (instancetype)initWithClient:(BOXContentClient *)client
+{
+    if (self = [super init]) {
+        _client = client;
+        _debounceInterval = BOX_SEARCH_SESSION_DEFAULT_DEBOUNCE_INTERVAL;
+        _pageSize = BOX_SEARCH_SESSION_DEFAULT_PAGE_SIZE;
+        _cacheCapacity = BOX_SEARCH_SESSION_DEFAULT_CACHE_CAPACITY;
+        _cacheTimeToLive = BOX_SEARCH_SESSION_DEFAULT_CACHE_TIME_TO_LIVE;
+        _prefetchesNextPage = YES;
+        _cacheEntries = [NSMutableDictionary dictionary];
+        _cacheKeys = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [_currentRequest cancel];
+    for (BOXSearchSessionCacheEntry *entry in [_cacheEntries allValues]) {
+        [entry.prefetchRequest cancel];
+    }
+}
+
+- (void)searchWithQuery:(NSString *)query
+{
+    BOXAssert([NSThread isMainThread], @"BOXSearchSession must be used from the main thread");
+
+    NSString *trimmedQuery = [query stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    // The same query is only ignored while its results are pending or shown, a failed one is retried.
+    if (self.query != nil && [trimmedQuery isEqualToString:self.query] && !self.queryFailed) {
+        return;
+    }
+
+    [self cancelRequests];
+    self.query = trimmedQuery;
+    self.queryFailed = NO;
+
+    NSString *key = [self cacheKeyForQuery:trimmedQuery];
+    if (key.length == 0) {
+        [self deliverQuery:trimmedQuery items:@[] totalCount:0 provisional:NO error:nil];
+        return;
+    }
+
+    BOXSearchSessionCacheEntry *entry = [self cacheEntryForKey:key];
+    [[BOXMetricsRegistry sharedRegistry] recordCacheLookupInLayer:BOXMetricsCacheLayerSearchSession hit:(entry != nil)];
+    if (entry) {
+        [self deliverQuery:trimmedQuery items:[entry.items copy] totalCount:entry.totalCount provisional:NO error:nil];
+        return;
+    }
+
+    NSArray *provisionalItems = [self provisionalItemsForKey:key];
+    if (provisionalItems) {
+        [self deliverQuery:trimmedQuery items:provisionalItems totalCount:0 provisional:YES error:nil];
+    }
+
+    NSUInteger generation = self.generation;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(self.debounceInterval * NSEC_PER_SEC)), dispatch_get_main_queue(), ^{
+        if (self.generation == generation) {
+            [self fetchFirstPageOfQuery:trimmedQuery key:key];
+        }
+    });
+}
+
+- (void)loadNextPage
+{
+    BOXAssert([NSThread isMainThread], @"BOXSearchSession must be used from the main thread");
+
+    BOXSearchSessionCacheEntry *entry = self.cacheEntries[[self cacheKeyForQuery:self.query]];
+    if (entry == nil || entry.items.count >= entry.totalCount) {
+        return;
+    }
+
+    entry.nextPageRequested = YES;
+    if (entry.prefetchedItems) {
+        [self consumePrefetchedPageOfEntry:entry];
+    } else if (entry.prefetchRequest == nil) {
+        [self fetchNextPageOfEntry:entry];
+    }
+}
+
+- (void)cancel
+{
+    [self cancelRequests];
+    self.query = nil;
+}
+
+- (void)clearCache
+{
+    for (BOXSearchSessionCacheEntry *entry in [self.cacheEntries allValues]) {
+        [entry.prefetchRequest cancel];
+    }
+    [self.cacheEntries removeAllObjects];
+    [self.cacheKeys removeAllObjects];
+}
+
+#pragma mark - Requests
+
+- (void)cancelRequests
+{
+    self.generation++;
+    [self.currentRequest cancel];
+    self.currentRequest = nil;
+
+    BOXSearchSessionCacheEntry *entry = self.cacheEntries[[self cacheKeyForQuery:self.query]];
+    [entry.prefetchRequest cancel];
+    entry.prefetchRequest = nil;
+    entry.nextPageRequested = NO;
+}
+
+- (BOXSearchRequest *)requestForQuery:(NSString *)query offset:(NSUInteger)offset
+{
+    BOXSearchRequest *request = [self.client searchRequestWithQuery:query inRange:NSMakeRange(offset, self.pageSize)];
+    if (self.requestConfigurationBlock) {
+        self.requestConfigurationBlock(request);
+    }
+    return request;
+}
+
+- (void)fetchFirstPageOfQuery:(NSString *)query key:(NSString *)key
+{
+    NSUInteger generation = self.generation;
+    BOXSearchRequest *request = [self requestForQuery:query offset:0];
+    self.currentRequest = request;
+
+    [request performRequestWithCompletion:^(NSArray<BOXItem *> *items, NSUInteger totalCount, NSRange range, NSError *error) {
+        if (self.generation != generation) {
+            return;
+        }
+        self.currentRequest = nil;
+
+        if (error) {
+            self.queryFailed = YES;
+            [self deliverQuery:query items:nil totalCount:0 provisional:NO error:error];
+            return;
+        }
+
+        BOXSearchSessionCacheEntry *entry = [[BOXSearchSessionCacheEntry alloc] init];
+        entry.query = query;
+        entry.key = key;
+        entry.items = [items mutableCopy];
+        entry.totalCount = totalCount;
+        entry.loadDate = [NSDate date];
+        [self setCacheEntry:entry forKey:key];
+
+        [self deliverQuery:query items:[entry.items copy] totalCount:totalCount provisional:NO error:nil];
+
+        if (self.prefetchesNextPage && entry.items.count < totalCount) {
+            [self fetchNextPageOfEntry:entry];
+        }
+    }];
+}
+
+- (void)fetchNextPageOfEntry:(BOXSearchSessionCacheEntry *)entry
+{
+    BOXSearchRequest *request = [self requestForQuery:entry.query offset:entry.items.count];
+    entry.prefetchRequest = request;
+
+    [request performRequestWithCompletion:^(NSArray<BOXItem *> *items, NSUInteger totalCount, NSRange range, NSError *error) {
+        if (entry.prefetchRequest != request) {
+            return;
+        }
+        entry.prefetchRequest = nil;
+
+        if (error) {
+            if (entry.nextPageRequested && [entry.key isEqualToString:[self cacheKeyForQuery:self.query]]) {
+                entry.nextPageRequested = NO;
+                [self deliverQuery:entry.query items:nil totalCount:0 provisional:NO error:error];
+            }
+            return;
+        }
+
+        entry.prefetchedItems = items;
+        entry.totalCount = totalCount;
+        if (entry.nextPageRequested) {
+            [self consumePrefetchedPageOfEntry:entry];
+        }
+    }];
+}
+
+- (void)consumePrefetchedPageOfEntry:(BOXSearchSessionCacheEntry *)entry
+{
+    [entry.items addObjectsFromArray:entry.prefetchedItems];
+    entry.prefetchedItems = nil;
+    entry.nextPageRequested = NO;
+
+    if ([entry.key isEqualToString:[self cacheKeyForQuery:self.query]]) {
+        [self deliverQuery:entry.query items:[entry.items copy] totalCount:entry.totalCount provisional:NO error:nil];
+    }
+
+    if (self.prefetchesNextPage && entry.items.count < entry.totalCount) {
+        [self fetchNextPageOfEntry:entry];
+    }
+}
+
+#pragma mark - Cache
+
+- (NSString *)cacheKeyForQuery:(NSString *)query
+{
+    return [[query stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]] lowercaseString];
+}
+
+- (BOOL)isCacheEntryExpired:(BOXSearchSessionCacheEntry *)entry
+{
+    return self.cacheTimeToLive > 0 && -[entry.loadDate timeIntervalSinceNow] >= self.cacheTimeToLive;
+}
+
+- (BOXSearchSessionCacheEntry *)cacheEntryForKey:(NSString *)key
+{
+    BOXSearchSessionCacheEntry *entry = self.cacheEntries[key];
+    if (entry && [self isCacheEntryExpired:entry]) {
+        [self removeCacheEntryForKey:key];
+        entry = nil;
+    }
+    if (entry) {
+        [self.cacheKeys removeObject:key];
+        [self.cacheKeys addObject:key];
+    }
+    return entry;
+}
+
+- (void)setCacheEntry:(BOXSearchSessionCacheEntry *)entry forKey:(NSString *)key
+{
+    [self.cacheKeys removeObject:key];
+    [self.cacheKeys addObject:key];
+    self.cacheEntries[key] = entry;
+
+    while (self.cacheKeys.count > MAX(self.cacheCapacity, 1)) {
+        [self removeCacheEntryForKey:self.cacheKeys.firstObject];
+    }
+}
+
+- (void)removeCacheEntryForKey:(NSString *)key
+{
+    BOXSearchSessionCacheEntry *entry = self.cacheEntries[key];
+    [entry.prefetchRequest cancel];
+    [self.cacheEntries removeObjectForKey:key];
+    [self.cacheKeys removeObject:key];
+}
+
+// Results of the longest cached prefix of key, narrowed down to the items whose name matches every word
+// of key. The server also matches on content and descriptions, so these are only an approximation.
+- (NSArray *)provisionalItemsForKey:(NSString *)key
+{
+    BOXSearchSessionCacheEntry *prefixEntry = nil;
+    for (NSString *cachedKey in self.cacheKeys) {
+        if (cachedKey.length < key.length && [key hasPrefix:cachedKey] &&
+            (prefixEntry == nil || cachedKey.length > prefixEntry.key.length) &&
+            ![self isCacheEntryExpired:self.cacheEntries[cachedKey]]) {
+            prefixEntry = self.cacheEntries[cachedKey];
+        }
+    }
+    if (prefixEntry == nil) {
+        return nil;
+    }
+
+    NSArray *words = [key componentsSeparatedByCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    NSMutableArray *items = [NSMutableArray array];
+    NSArray *candidates = prefixEntry.prefetchedItems ? [prefixEntry.items arrayByAddingObjectsFromArray:prefixEntry.prefetchedItems] : prefixEntry.items;
+
+    for (BOXItem *item in candidates) {
+        BOOL matches = item.name.length > 0;
+        for (NSString *word in words) {
+            if (word.length > 0 && [item.name rangeOfString:word options:NSCaseInsensitiveSearch | NSDiacriticInsensitiveSearch].location == NSNotFound) {
+                matches = NO;
+                break;
+            }
+        }
+        if (matches) {
+            [items addObject:item];
+        }
+    }
+    return items;
+}
+
+#pragma mark - Delivery
+
+- (void)deliverQuery:(NSString *)query items:(NSArray *)items totalCount:(NSUInteger)totalCount provisional:(BOOL)provisional error:(NSError *)error
+{
+    if (self.resultsBlock) {
+        self.resultsBlock(query, items, totalCount, provisional, error);
+    }
+}
+
+@end
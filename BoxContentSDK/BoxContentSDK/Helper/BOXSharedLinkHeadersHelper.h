@@ -30,6 +30,11 @@
 - (void)storeHeadersFromAncestorsIfNecessaryForItemWithID:(NSString *)itemID itemType:(NSString *)itemType ancestors:(NSArray *)ancestors;
 - (void)removeStoredInformationForItemWithID:(NSString *)itemID itemType:(NSString *)itemType;
 - (void)removeStoredInformationForUserWithID:(NSString *)userID;
+/**
+ * Makes the next lookups ask the delegate again. To be called when the delegate's storage was changed other than
+ * through this helper.
+ **/
+- (void)invalidateCachedInformation;
 
 - (NSString *)sharedLinkForItemID:(NSString *)itemID itemType:(NSString *)itemType;
 - (NSString *)passwordForItemForItemWithID:(NSString *)itemID itemType:(NSString *)itemType;
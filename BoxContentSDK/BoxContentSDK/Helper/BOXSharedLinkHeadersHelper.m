@@ -11,10 +11,12 @@
 #import "BOXFolder.h"
 #import "BOXUser.h"
 #import "BOXContentClient.h"
+#import "BOXSharedLinkHeadersIndex.h"
 
 @interface BOXSharedLinkHeadersHelper ()
 
 @property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, strong) BOXSharedLinkHeadersIndex *headersIndex;
 
 @end
 
@@ -42,6 +44,18 @@
     return self.client.user.modelID;
 }
 
+// The index in front of the current delegate. Replacing the delegate starts a new index.
+- (BOXSharedLinkHeadersIndex *)currentIndex
+{
+    id <BOXSharedLinkStorageProtocol> delegate = self.delegate;
+    @synchronized(self) {
+        if (self.headersIndex == nil || self.headersIndex.delegate != delegate) {
+            self.headersIndex = [[BOXSharedLinkHeadersIndex alloc] initWithDelegate:delegate];
+        }
+        return self.headersIndex;
+    }
+}
+
 #pragma mark - Public Methods
  
 - (void)storeHeadersForItemWithID:(NSString *)itemID itemType:(NSString *)itemType sharedLink:(NSString *)sharedLink password:(NSString *)password
@@ -50,45 +64,37 @@
         BOXLog(@"The provided model was nil. Please make sure the request that called this method implements itemID:");
     }
     
-    [self.delegate storeSharedLink:sharedLink forItemWithIDKey:itemID itemTypeKey:itemType password:password userIDKey:self.userID];
+    [[self currentIndex] storeSharedLink:sharedLink password:password forItemWithID:itemID itemType:itemType userID:self.userID];
 }
 
 - (void)storeHeadersFromAncestorsIfNecessaryForItemWithID:(NSString *)itemID itemType:(NSString *)itemType ancestors:(NSArray *)ancestors
 {
-    if ([self.delegate sharedLinkForItemWithID:itemID itemType:itemType userID:self.userID] == nil) {
-        // Go from the direct parent to the most remote ancestor.
-        for (NSInteger i = ancestors.count - 1; i >= 0; i --) {
-            BOXFolderMini *folder = ancestors[i];
-            
-            NSString *link = [self.delegate sharedLinkForItemWithID:folder.modelID itemType:folder.type userID:self.userID];
-            // We found a link in one of the ancestors of the file, we need to store this file that now would need the headers of its ancestors in any API request
-            if (link) {
-                NSString *password = [self.delegate passwordForSharedItemWithID:folder.modelID itemType:folder.type userID:self.userID];
-                [self.delegate storeSharedLink:link forItemWithIDKey:itemID itemTypeKey:itemType password:password userIDKey:self.userID];
-                break;
-            }
-        }
-    }
+    [[self currentIndex] inheritSharedLinkFromAncestors:ancestors forItemWithID:itemID itemType:itemType userID:self.userID];
 }
 
 - (void)removeStoredInformationForItemWithID:(NSString *)itemID itemType:(NSString *)itemType
 {
-    [self.delegate removeStoredInformationForItemWithID:itemID itemType:itemType userID:self.userID];
+    [[self currentIndex] removeStoredInformationForItemWithID:itemID itemType:itemType userID:self.userID];
 }
 
 - (void)removeStoredInformationForUserWithID:(NSString *)userID
 {
-    [self.delegate removeStoredInformationForUserWithID:userID];
+    [[self currentIndex] removeStoredInformationForUserWithID:userID];
+}
+
+- (void)invalidateCachedInformation
+{
+    [[self currentIndex] invalidateCachedEntries];
 }
 
 - (NSString *)sharedLinkForItemID:(NSString *)itemID itemType:(NSString *)itemType
 {
-    return [self.delegate sharedLinkForItemWithID:itemID itemType:itemType userID:self.userID];
+    return [[self currentIndex] sharedLinkForItemWithID:itemID itemType:itemType userID:self.userID];
 }
 
 - (NSString *)passwordForItemForItemWithID:(NSString *)itemID itemType:(NSString *)itemType
 {
-    return [self.delegate passwordForSharedItemWithID:itemID itemType:itemType userID:self.userID];
+    return [[self currentIndex] passwordForItemWithID:itemID itemType:itemType userID:self.userID];
 }
 
 @end
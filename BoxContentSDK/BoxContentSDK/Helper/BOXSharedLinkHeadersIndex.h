@@ -0,0 +1,57 @@
+//
+//  BOXSharedLinkHeadersIndex.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+#import "BOXSharedLinkStorageProtocol.h"
+
+/**
+ * Thread-safe in-memory index of the shared links and passwords of items, keyed by user, item type and item ID, in
+ * front of a BOXSharedLinkStorageProtocol delegate.
+ *
+ * Lookups are answered from the index. An item is looked up in the delegate only the first time it is asked for,
+ * and the answer is kept. The absence of a link is only kept for missingEntryLifetime, since the delegate may learn
+ * of the link by other means. Changes update the index and are written through to the delegate. Items that inherit
+ * the link of an ancestor point at the ancestor's entry, so that they follow changes to its link and password, and
+ * still resolve with a single extra lookup.
+ *
+ * The delegate is called on a serial queue of the index, in the order of the changes, and never while the index is
+ * locked, so that lookups answered from the index do not wait for the delegate.
+ */
+@interface BOXSharedLinkHeadersIndex : NSObject
+
+@property (nonatomic, readonly, strong) id <BOXSharedLinkStorageProtocol> delegate;
+
+/**
+ * How long the absence of a link is kept before the delegate is asked again. Defaults to 60 seconds.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval missingEntryLifetime;
+
+- (instancetype)initWithDelegate:(id <BOXSharedLinkStorageProtocol>)delegate;
+
+- (NSString *)sharedLinkForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID;
+- (NSString *)passwordForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID;
+
+/**
+ * As with the delegate, a nil sharedLink or password leaves the stored one in place.
+ */
+- (void)storeSharedLink:(NSString *)sharedLink password:(NSString *)password forItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID;
+
+/**
+ * Makes an item without a link of its own inherit the link of its nearest ancestor that has one.
+ *
+ * @param ancestors BOXFolderMini instances, from the most remote ancestor to the direct parent.
+ */
+- (void)inheritSharedLinkFromAncestors:(NSArray *)ancestors forItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID;
+
+- (void)removeStoredInformationForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID;
+- (void)removeStoredInformationForUserWithID:(NSString *)userID;
+
+/**
+ * Forgets everything the index learned from the delegate, so that the next lookups ask it again. To be called when
+ * the delegate's storage was changed other than through the index.
+ */
+- (void)invalidateCachedEntries;
+
+@end
@@ -0,0 +1,295 @@
+//
+//  BOXSharedLinkHeadersIndex.m
+//  BoxContentSDK
+//
+
+#import "BOXSharedLinkHeadersIndex.h"
+#import "BOXFolder.h"
+
+#define BOX_SHARED_LINK_HEADERS_INDEX_DEFAULT_MISSING_ENTRY_LIFETIME (60.0)
+
+@interface BOXSharedLinkHeadersIndexEntry : NSObject
+
+// nil when the item has no link, so that the delegate is not asked again until expirationDate.
+@property (nonatomic, readwrite, copy) NSString *sharedLink;
+@property (nonatomic, readwrite, copy) NSString *password;
+// Key of the ancestor the link is inherited from, nil when the item has a link of its own.
+@property (nonatomic, readwrite, copy) NSString *sourceItemKey;
+// Set while the item has no link.
+@property (nonatomic, readwrite, strong) NSDate *expirationDate;
+
+@end
+
+@implementation BOXSharedLinkHeadersIndexEntry
+@end
+
+@interface BOXSharedLinkHeadersIndex ()
+
+/**
+ * Key : user ID
+ * Value : dictionary of BOXSharedLinkHeadersIndexEntry keyed by [ITEM_TYPE]_[ITEM_ID]
+ *
+ * Guarded by @synchronized(self).
+ **/
+@property (nonatomic, readwrite, strong) NSMutableDictionary *entriesByUserID;
+
+// Incremented when entries are dropped other than one at a time, so that a delegate lookup started before does not
+// put back what it read. Guarded by @synchronized(self).
+@property (nonatomic, readwrite, assign) NSUInteger generation;
+
+// Serial queue the delegate is called on. Writes are queued with the index locked, so that they reach the delegate
+// in the order of the changes, and lookups queued after them see them.
+@property (nonatomic, readwrite, strong) dispatch_queue_t delegateQueue;
+
+@end
+
+@implementation BOXSharedLinkHeadersIndex
+
+- (instancetype)initWithDelegate:(id <BOXSharedLinkStorageProtocol>)delegate
+{
+    if (self = [super init]) {
+        _delegate = delegate;
+        _missingEntryLifetime = BOX_SHARED_LINK_HEADERS_INDEX_DEFAULT_MISSING_ENTRY_LIFETIME;
+        _entriesByUserID = [NSMutableDictionary dictionary];
+        _delegateQueue = dispatch_queue_create("com.box.contentsdk.sharedlinkheadersindex", DISPATCH_QUEUE_SERIAL);
+    }
+    return self;
+}
+
+#pragma mark - Lookups
+
+- (NSString *)sharedLinkForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    [self loadEntryForItemWithID:itemID itemType:itemType userID:userID];
+    @synchronized(self) {
+        return [self resolvedEntryForItemWithID:itemID itemType:itemType userID:userID].sharedLink;
+    }
+}
+
+- (NSString *)passwordForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    [self loadEntryForItemWithID:itemID itemType:itemType userID:userID];
+    @synchronized(self) {
+        return [self resolvedEntryForItemWithID:itemID itemType:itemType userID:userID].password;
+    }
+}
+
+#pragma mark - Changes
+
+- (void)storeSharedLink:(NSString *)sharedLink password:(NSString *)password forItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    // The link or password left in place is the delegate's.
+    [self loadEntryForItemWithID:itemID itemType:itemType userID:userID];
+    @synchronized(self) {
+        BOXSharedLinkHeadersIndexEntry *entry = [self entryForItemWithID:itemID itemType:itemType userID:userID];
+        if (sharedLink) {
+            entry.sharedLink = sharedLink;
+            entry.sourceItemKey = nil;
+            entry.expirationDate = nil;
+        }
+        if (password) {
+            entry.password = password;
+        }
+        [self performDelegateWrite:^(id<BOXSharedLinkStorageProtocol> delegate) {
+            [delegate storeSharedLink:sharedLink forItemWithIDKey:itemID itemTypeKey:itemType password:password userIDKey:userID];
+        }];
+    }
+    [self waitForDelegateWrites];
+}
+
+- (void)inheritSharedLinkFromAncestors:(NSArray *)ancestors forItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    [self loadEntryForItemWithID:itemID itemType:itemType userID:userID];
+    @synchronized(self) {
+        if ([self resolvedEntryForItemWithID:itemID itemType:itemType userID:userID].sharedLink != nil) {
+            return;
+        }
+    }
+
+    // Go from the direct parent to the most remote ancestor.
+    BOOL inherited = NO;
+    for (NSInteger i = ancestors.count - 1; i >= 0 && !inherited; i--) {
+        BOXFolderMini *folder = ancestors[i];
+        [self loadEntryForItemWithID:folder.modelID itemType:folder.type userID:userID];
+        @synchronized(self) {
+            BOXSharedLinkHeadersIndexEntry *ancestorEntry = [self entryForItemWithID:folder.modelID itemType:folder.type userID:userID];
+            BOXSharedLinkHeadersIndexEntry *resolvedAncestorEntry = [self resolvedEntryForItemWithID:folder.modelID itemType:folder.type userID:userID];
+            if (resolvedAncestorEntry.sharedLink != nil) {
+                BOXSharedLinkHeadersIndexEntry *entry = [self entryForItemWithID:itemID itemType:itemType userID:userID];
+                entry.sharedLink = resolvedAncestorEntry.sharedLink;
+                entry.password = resolvedAncestorEntry.password;
+                entry.sourceItemKey = ancestorEntry.sourceItemKey ?: [self itemKeyForItemWithID:folder.modelID itemType:folder.type];
+                entry.expirationDate = nil;
+
+                // The delegate keeps a copy, for when the index is rebuilt from it.
+                NSString *sharedLink = entry.sharedLink;
+                NSString *password = entry.password;
+                [self performDelegateWrite:^(id<BOXSharedLinkStorageProtocol> delegate) {
+                    [delegate storeSharedLink:sharedLink forItemWithIDKey:itemID itemTypeKey:itemType password:password userIDKey:userID];
+                }];
+                inherited = YES;
+            }
+        }
+    }
+    if (inherited) {
+        [self waitForDelegateWrites];
+    }
+}
+
+- (void)removeStoredInformationForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    @synchronized(self) {
+        NSMutableDictionary *entries = [self entriesForUserID:userID];
+        entries[[self itemKeyForItemWithID:itemID itemType:itemType]] = [self missingEntry];
+        [self performDelegateWrite:^(id<BOXSharedLinkStorageProtocol> delegate) {
+            [delegate removeStoredInformationForItemWithID:itemID itemType:itemType userID:userID];
+        }];
+    }
+    [self waitForDelegateWrites];
+}
+
+- (void)removeStoredInformationForUserWithID:(NSString *)userID
+{
+    @synchronized(self) {
+        [self.entriesByUserID removeObjectForKey:userID ?: @""];
+        self.generation++;
+        [self performDelegateWrite:^(id<BOXSharedLinkStorageProtocol> delegate) {
+            [delegate removeStoredInformationForUserWithID:userID];
+        }];
+    }
+    [self waitForDelegateWrites];
+}
+
+- (void)invalidateCachedEntries
+{
+    @synchronized(self) {
+        [self.entriesByUserID removeAllObjects];
+        self.generation++;
+    }
+}
+
+#pragma mark - Private Helpers
+
+- (NSString *)itemKeyForItemWithID:(NSString *)itemID itemType:(NSString *)itemType
+{
+    return [NSString stringWithFormat:@"%@_%@", itemType, itemID];
+}
+
+// Called with the index locked.
+- (void)performDelegateWrite:(void (^)(id <BOXSharedLinkStorageProtocol> delegate))write
+{
+    id <BOXSharedLinkStorageProtocol> delegate = self.delegate;
+    dispatch_async(self.delegateQueue, ^{
+        write(delegate);
+    });
+}
+
+// Called with the index unlocked. Changes return once the delegate has them, as they did when it was called directly.
+- (void)waitForDelegateWrites
+{
+    dispatch_sync(self.delegateQueue, ^{});
+}
+
+- (BOXSharedLinkHeadersIndexEntry *)missingEntry
+{
+    BOXSharedLinkHeadersIndexEntry *entry = [[BOXSharedLinkHeadersIndexEntry alloc] init];
+    entry.expirationDate = [NSDate dateWithTimeIntervalSinceNow:self.missingEntryLifetime];
+    return entry;
+}
+
+// Called with the index locked.
+- (NSMutableDictionary *)entriesForUserID:(NSString *)userID
+{
+    NSString *userKey = userID ?: @"";
+    NSMutableDictionary *entries = self.entriesByUserID[userKey];
+    if (entries == nil) {
+        entries = [NSMutableDictionary dictionary];
+        self.entriesByUserID[userKey] = entries;
+    }
+    return entries;
+}
+
+// Called with the index locked. The entry of an item, unless there is none or it expired.
+- (BOXSharedLinkHeadersIndexEntry *)cachedEntryForItemKey:(NSString *)itemKey userID:(NSString *)userID
+{
+    BOXSharedLinkHeadersIndexEntry *entry = self.entriesByUserID[userID ?: @""][itemKey];
+    if (entry.expirationDate != nil && [entry.expirationDate timeIntervalSinceNow] <= 0) {
+        return nil;
+    }
+    return entry;
+}
+
+// Called with the index unlocked. Looks an item up in the delegate, unless the index has an entry for it.
+- (void)loadEntryForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    if (itemID == nil) {
+        return;
+    }
+
+    NSString *itemKey = [self itemKeyForItemWithID:itemID itemType:itemType];
+    BOOL loaded = NO;
+    while (!loaded) {
+        NSUInteger generation = 0;
+        @synchronized(self) {
+            if ([self cachedEntryForItemKey:itemKey userID:userID] != nil) {
+                return;
+            }
+            generation = self.generation;
+        }
+
+        __block NSString *sharedLink = nil;
+        __block NSString *password = nil;
+        id <BOXSharedLinkStorageProtocol> delegate = self.delegate;
+        dispatch_sync(self.delegateQueue, ^{
+            sharedLink = [delegate sharedLinkForItemWithID:itemID itemType:itemType userID:userID];
+            if (sharedLink != nil) {
+                password = [delegate passwordForSharedItemWithID:itemID itemType:itemType userID:userID];
+            }
+        });
+
+        @synchronized(self) {
+            // Entries were dropped meanwhile, maybe along with what was read: read again.
+            if (self.generation == generation) {
+                // An entry added meanwhile by a change is more recent than what was read.
+                if ([self cachedEntryForItemKey:itemKey userID:userID] == nil) {
+                    BOXSharedLinkHeadersIndexEntry *entry = [self missingEntry];
+                    if (sharedLink != nil) {
+                        entry.sharedLink = sharedLink;
+                        entry.password = password;
+                        entry.expirationDate = nil;
+                    }
+                    [self entriesForUserID:userID][itemKey] = entry;
+                }
+                loaded = YES;
+            }
+        }
+    }
+}
+
+// Called with the index locked. The entry of an item, empty if it was not loaded.
+- (BOXSharedLinkHeadersIndexEntry *)entryForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    NSString *itemKey = [self itemKeyForItemWithID:itemID itemType:itemType];
+    BOXSharedLinkHeadersIndexEntry *entry = [self cachedEntryForItemKey:itemKey userID:userID];
+    if (entry == nil) {
+        entry = [self missingEntry];
+        [self entriesForUserID:userID][itemKey] = entry;
+    }
+    return entry;
+}
+
+// Called with the index locked. The entry of an item, or of the ancestor it inherits its link from if that one
+// still has a link.
+- (BOXSharedLinkHeadersIndexEntry *)resolvedEntryForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    BOXSharedLinkHeadersIndexEntry *entry = [self entryForItemWithID:itemID itemType:itemType userID:userID];
+    if (entry.sourceItemKey != nil) {
+        BOXSharedLinkHeadersIndexEntry *sourceEntry = [self cachedEntryForItemKey:entry.sourceItemKey userID:userID];
+        if (sourceEntry.sharedLink != nil) {
+            return sourceEntry;
+        }
+    }
+    return entry;
+}
+
+@end
@@ -0,0 +1,104 @@
+//
+//  BOXTransferMemoryMonitor.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * The buffers in which operations hold transferred bytes in memory.
+ */
+typedef NS_ENUM(NSUInteger, BOXTransferBufferKind) {
+    /** Data received by a BOXAPIDataOperation that is not yet written to its output stream. */
+    BOXTransferBufferKindDownloadBuffer = 0,
+    /** Data received by a BOXStreamOperation. */
+    BOXTransferBufferKindStreamBuffer,
+    /** Response bodies held until they are parsed. */
+    BOXTransferBufferKindResponseData,
+    /** Multipart upload pieces appended as data rather than as files or streams. */
+    BOXTransferBufferKindMultipartBody,
+    /** Data written to the in-memory output stream of a BOXAPIDataOperation without an output stream of its own. */
+    BOXTransferBufferKindMemoryOutputStream,
+};
+
+#define BOX_TRANSFER_BUFFER_KIND_COUNT (5)
+
+@class BOXTransferMemoryMonitor;
+
+/**
+ * Bytes held in memory by one operation. Thread safe.
+ *
+ * Bytes still counted when the account is deallocated are removed from its monitor.
+ */
+@interface BOXTransferMemoryAccount : NSObject
+
+@property (atomic, readonly, assign) unsigned long long currentBytes;
+@property (atomic, readonly, assign) unsigned long long peakBytes;
+
+- (instancetype)initWithMonitor:(BOXTransferMemoryMonitor *)monitor;
+
+- (unsigned long long)currentBytesOfKind:(BOXTransferBufferKind)kind;
+
+/**
+ * Counts bytes the operation now holds. Bytes are counted even if they exceed a limit, since they are already
+ * in memory.
+ *
+ * @return NO if the operation or the process is now over a limit of the monitor.
+ */
+- (BOOL)addBytes:(unsigned long long)bytes ofKind:(BOXTransferBufferKind)kind;
+
+- (void)removeBytes:(unsigned long long)bytes ofKind:(BOXTransferBufferKind)kind;
+
+/**
+ * Sets the bytes held in a buffer, e.g. to its length after it was drained.
+ *
+ * @return NO if the operation or the process is now over a limit of the monitor.
+ */
+- (BOOL)setBytes:(unsigned long long)bytes ofKind:(BOXTransferBufferKind)kind;
+
+- (void)removeAllBytes;
+
+@end
+
+/**
+ * Counts the bytes that operations hold in memory while transferring, per operation and for the process, and
+ * tracks their peaks.
+ *
+ * The monitor posts BOXTransferMemoryHighWaterNotification on the main thread each time the process peak grows
+ * by highWaterNotificationInterval bytes, and BOXTransferMemoryLimitReachedNotification each time an operation
+ * goes over a limit.
+ *
+ * Limits are off by default. When one is set, operations over it apply backpressure where they can, and fail
+ * cleanly with BOXContentSDKStreamErrorMemoryLimitExceeded otherwise:
+ *  - downloads to an output stream suspend their session task until the output stream has drained their buffer;
+ *  - operations buffering a whole response or upload body in memory fail.
+ */
+@interface BOXTransferMemoryMonitor : NSObject
+
++ (instancetype)sharedMonitor;
+
+/** Maximum bytes held by one operation. 0, the default, means no limit. */
+@property (atomic, readwrite, assign) unsigned long long operationByteLimit;
+
+/** Maximum bytes held by all operations. 0, the default, means no limit. */
+@property (atomic, readwrite, assign) unsigned long long processByteLimit;
+
+/** Growth of the process peak between two high-water notifications. Defaults to 1 MB. */
+@property (atomic, readwrite, assign) unsigned long long highWaterNotificationInterval;
+
+- (unsigned long long)currentBytes;
+- (unsigned long long)peakBytes;
+- (unsigned long long)currentBytesOfKind:(BOXTransferBufferKind)kind;
+- (unsigned long long)peakBytesOfKind:(BOXTransferBufferKind)kind;
+
+/**
+ * Whether an operation holding operationBytes would be within the limits.
+ */
+- (BOOL)isWithinLimitsWithOperationBytes:(unsigned long long)operationBytes;
+
+/**
+ * Restarts peak tracking from the current bytes, e.g. at the start of a test.
+ */
+- (void)resetPeakBytes;
+
+@end
@@ -0,0 +1,223 @@
+//
+//  BOXTransferMemoryMonitor.m
+//  BoxContentSDK
+//
+
+#import "BOXTransferMemoryMonitor.h"
+#import "BOXDispatchHelper.h"
+#import "BOXContentSDKConstants.h"
+#import <stdatomic.h>
+
+#define BOX_TRANSFER_MEMORY_DEFAULT_HIGH_WATER_INTERVAL (1024 * 1024)
+
+// Raises peak to bytes if it is lower, and returns the peak.
+static uint64_t BOXTransferMemoryRaisePeak(_Atomic uint64_t *peak, uint64_t bytes)
+{
+    uint64_t peakBytes = atomic_load_explicit(peak, memory_order_relaxed);
+    while (bytes > peakBytes &&
+           !atomic_compare_exchange_weak_explicit(peak, &peakBytes, bytes, memory_order_relaxed, memory_order_relaxed)) {
+    }
+    return MAX(peakBytes, bytes);
+}
+
+@interface BOXTransferMemoryMonitor ()
+{
+    // Every chunk an operation receives changes the counts, so they are atomic rather than guarded by a lock
+    // shared by all operations. A current count can be briefly negative while a removal overtakes its addition.
+    _Atomic int64_t _currentBytesByKind[BOX_TRANSFER_BUFFER_KIND_COUNT];
+    _Atomic uint64_t _peakBytesByKind[BOX_TRANSFER_BUFFER_KIND_COUNT];
+    _Atomic int64_t _currentBytes;
+    _Atomic uint64_t _peakBytes;
+    _Atomic uint64_t _notifiedPeakBytes;
+}
+
+// Returns whether the operation and the process are within the limits after the change.
+- (BOOL)changeBytesBy:(long long)delta ofKind:(BOXTransferBufferKind)kind operationBytes:(unsigned long long)operationBytes;
+- (void)postLimitReachedNotificationWithOperationBytes:(unsigned long long)operationBytes;
+
+@end
+
+@interface BOXTransferMemoryAccount ()
+{
+    unsigned long long _bytesByKind[BOX_TRANSFER_BUFFER_KIND_COUNT];
+}
+
+@property (nonatomic, readwrite, strong) BOXTransferMemoryMonitor *monitor;
+@property (atomic, readwrite, assign) unsigned long long currentBytes;
+@property (atomic, readwrite, assign) unsigned long long peakBytes;
+@property (nonatomic, readwrite, assign) BOOL overLimit;
+
+@end
+
+@implementation BOXTransferMemoryAccount
+
+- (instancetype)initWithMonitor:(BOXTransferMemoryMonitor *)monitor
+{
+    if (self = [super init]) {
+        _monitor = monitor;
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    [self removeAllBytes];
+}
+
+- (unsigned long long)currentBytesOfKind:(BOXTransferBufferKind)kind
+{
+    @synchronized(self) {
+        return _bytesByKind[kind];
+    }
+}
+
+- (BOOL)addBytes:(unsigned long long)bytes ofKind:(BOXTransferBufferKind)kind
+{
+    @synchronized(self) {
+        return [self setBytes:_bytesByKind[kind] + bytes ofKind:kind];
+    }
+}
+
+- (void)removeBytes:(unsigned long long)bytes ofKind:(BOXTransferBufferKind)kind
+{
+    @synchronized(self) {
+        [self setBytes:_bytesByKind[kind] - MIN(bytes, _bytesByKind[kind]) ofKind:kind];
+    }
+}
+
+- (BOOL)setBytes:(unsigned long long)bytes ofKind:(BOXTransferBufferKind)kind
+{
+    BOOL withinLimits = YES;
+    BOOL reachedLimit = NO;
+    unsigned long long operationBytes = 0;
+    @synchronized(self) {
+        long long delta = (long long)bytes - (long long)_bytesByKind[kind];
+        if (delta == 0) {
+            return !self.overLimit;
+        }
+        _bytesByKind[kind] = bytes;
+        operationBytes = (unsigned long long)((long long)self.currentBytes + delta);
+        self.currentBytes = operationBytes;
+        self.peakBytes = MAX(self.peakBytes, operationBytes);
+
+        withinLimits = [self.monitor changeBytesBy:delta ofKind:kind operationBytes:operationBytes];
+        // Notify once per crossing, not for every chunk received while over a limit.
+        reachedLimit = !withinLimits && !self.overLimit;
+        self.overLimit = !withinLimits;
+    }
+    if (reachedLimit) {
+        [self.monitor postLimitReachedNotificationWithOperationBytes:operationBytes];
+    }
+    return withinLimits;
+}
+
+- (void)removeAllBytes
+{
+    @synchronized(self) {
+        for (NSUInteger kind = 0; kind < BOX_TRANSFER_BUFFER_KIND_COUNT; kind++) {
+            [self setBytes:0 ofKind:kind];
+        }
+    }
+}
+
+@end
+
+@implementation BOXTransferMemoryMonitor
+
++ (instancetype)sharedMonitor
+{
+    static BOXTransferMemoryMonitor *sharedMonitor = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedMonitor = [[BOXTransferMemoryMonitor alloc] init];
+    });
+    return sharedMonitor;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _highWaterNotificationInterval = BOX_TRANSFER_MEMORY_DEFAULT_HIGH_WATER_INTERVAL;
+    }
+    return self;
+}
+
+- (unsigned long long)currentBytes
+{
+    return (unsigned long long)MAX(atomic_load_explicit(&_currentBytes, memory_order_relaxed), 0);
+}
+
+- (unsigned long long)peakBytes
+{
+    return atomic_load_explicit(&_peakBytes, memory_order_relaxed);
+}
+
+- (unsigned long long)currentBytesOfKind:(BOXTransferBufferKind)kind
+{
+    return (unsigned long long)MAX(atomic_load_explicit(&_currentBytesByKind[kind], memory_order_relaxed), 0);
+}
+
+- (unsigned long long)peakBytesOfKind:(BOXTransferBufferKind)kind
+{
+    return atomic_load_explicit(&_peakBytesByKind[kind], memory_order_relaxed);
+}
+
+- (BOOL)isWithinLimitsWithOperationBytes:(unsigned long long)operationBytes
+{
+    unsigned long long operationByteLimit = self.operationByteLimit;
+    unsigned long long processByteLimit = self.processByteLimit;
+    return (operationByteLimit == 0 || operationBytes <= operationByteLimit) &&
+           (processByteLimit == 0 || [self currentBytes] <= processByteLimit);
+}
+
+- (void)resetPeakBytes
+{
+    unsigned long long currentBytes = [self currentBytes];
+    atomic_store_explicit(&_peakBytes, currentBytes, memory_order_relaxed);
+    atomic_store_explicit(&_notifiedPeakBytes, currentBytes, memory_order_relaxed);
+    for (NSUInteger kind = 0; kind < BOX_TRANSFER_BUFFER_KIND_COUNT; kind++) {
+        atomic_store_explicit(&_peakBytesByKind[kind], [self currentBytesOfKind:kind], memory_order_relaxed);
+    }
+}
+
+- (BOOL)changeBytesBy:(long long)delta ofKind:(BOXTransferBufferKind)kind operationBytes:(unsigned long long)operationBytes
+{
+    int64_t kindBytes = atomic_fetch_add_explicit(&_currentBytesByKind[kind], delta, memory_order_relaxed) + delta;
+    int64_t signedCurrentBytes = atomic_fetch_add_explicit(&_currentBytes, delta, memory_order_relaxed) + delta;
+    unsigned long long currentBytes = (unsigned long long)MAX(signedCurrentBytes, 0);
+    BOXTransferMemoryRaisePeak(&_peakBytesByKind[kind], (uint64_t)MAX(kindBytes, 0));
+    unsigned long long peakBytes = BOXTransferMemoryRaisePeak(&_peakBytes, currentBytes);
+
+    // Only the change that moves the notified peak past the next mark posts a notification.
+    BOOL reachedHighWater = NO;
+    if (delta > 0) {
+        unsigned long long highWaterNotificationInterval = MAX(self.highWaterNotificationInterval, 1);
+        uint64_t notifiedPeakBytes = atomic_load_explicit(&_notifiedPeakBytes, memory_order_relaxed);
+        while (peakBytes >= notifiedPeakBytes + highWaterNotificationInterval && !reachedHighWater) {
+            reachedHighWater = atomic_compare_exchange_weak_explicit(&_notifiedPeakBytes, &notifiedPeakBytes, peakBytes, memory_order_relaxed, memory_order_relaxed);
+        }
+    }
+
+    if (reachedHighWater) {
+        NSDictionary *userInfo = @{BOXTransferMemoryCurrentBytesKey : @(currentBytes),
+                                   BOXTransferMemoryPeakBytesKey : @(peakBytes)};
+        [BOXDispatchHelper callCompletionBlock:^{
+            [[NSNotificationCenter defaultCenter] postNotificationName:BOXTransferMemoryHighWaterNotification object:self userInfo:userInfo];
+        } onMainThread:YES];
+    }
+
+    // Releasing memory never counts as going over a limit.
+    return delta < 0 || [self isWithinLimitsWithOperationBytes:operationBytes];
+}
+
+- (void)postLimitReachedNotificationWithOperationBytes:(unsigned long long)operationBytes
+{
+    NSDictionary *userInfo = @{BOXTransferMemoryCurrentBytesKey : @([self currentBytes]),
+                               BOXTransferMemoryPeakBytesKey : @([self peakBytes]),
+                               BOXTransferMemoryOperationBytesKey : @(operationBytes)};
+    [BOXDispatchHelper callCompletionBlock:^{
+        [[NSNotificationCenter defaultCenter] postNotificationName:BOXTransferMemoryLimitReachedNotification object:self userInfo:userInfo];
+    } onMainThread:YES];
+}
+
+@end
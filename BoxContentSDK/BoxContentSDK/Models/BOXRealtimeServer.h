@@ -0,0 +1,37 @@
+//
+//  BOXRealtimeServer.h
+//  BoxContentSDK
+//
+
+#import "BOXModel.h"
+
+/**
+ *  Represents a long-poll server returned by an OPTIONS request on the events endpoint.
+ *  Clients open a GET on the server URL and the server holds the connection open until
+ *  a change is available on the event stream or the client is asked to reconnect.
+ */
+@interface BOXRealtimeServer : BOXModel
+
+/**
+ *  URL to open the long-poll connection on. http URLs returned by the API are upgraded to https, and URLs with any
+ *  other scheme are dropped, leaving this nil.
+ */
+@property (nonatomic, readwrite, strong) NSURL *URL;
+
+/**
+ *  Time to live of the server URL, in seconds.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval ttl;
+
+/**
+ *  Number of times a long-poll connection may be reopened on this server URL before
+ *  a new one should be retrieved.
+ */
+@property (nonatomic, readwrite, assign) NSInteger maxRetries;
+
+/**
+ *  Maximum time, in seconds, the server may hold a long-poll connection open.
+ */
+@property (nonatomic, readwrite, assign) NSTimeInterval retryTimeout;
+
+@end
@@ -0,0 +1,51 @@
+//
+//  BOXRealtimeServer.m
+//  BoxContentSDK
+//
+
+#import "BOXRealtimeServer.h"
+
+// The API returns some of the numeric fields of a realtime server as strings.
+static id BOXRealtimeServerNumericValue(NSString *key, NSDictionary *JSONResponse)
+{
+    id value = [NSJSONSerialization box_ensureObjectForKey:key
+                                              inDictionary:JSONResponse
+                                           hasExpectedType:[NSObject class]
+                                               nullAllowed:NO];
+    if ([value isKindOfClass:[NSNumber class]] || [value isKindOfClass:[NSString class]]) {
+        return value;
+    }
+    return nil;
+}
+
+@implementation BOXRealtimeServer
+
+- (instancetype)initWithJSON:(NSDictionary *)JSONResponse
+{
+    if (self = [super initWithJSON:JSONResponse])
+    {
+        NSString *URLString = [NSJSONSerialization box_ensureObjectForKey:BOXAPIObjectKeyURL
+                                                             inDictionary:JSONResponse
+                                                          hasExpectedType:[NSString class]
+                                                              nullAllowed:NO];
+        if (URLString.length > 0) {
+            // The API returns http URLs. The realtime servers also answer over https, and nothing is sent over any
+            // other scheme.
+            NSURLComponents *components = [NSURLComponents componentsWithString:URLString];
+            if ([components.scheme caseInsensitiveCompare:@"http"] == NSOrderedSame) {
+                components.scheme = @"https";
+            }
+            if ([components.scheme caseInsensitiveCompare:@"https"] == NSOrderedSame) {
+                self.URL = components.URL;
+            }
+        }
+
+        self.ttl = [BOXRealtimeServerNumericValue(BOXAPIObjectKeyTTL, JSONResponse) doubleValue];
+        self.maxRetries = [BOXRealtimeServerNumericValue(BOXAPIObjectKeyMaxRetries, JSONResponse) integerValue];
+        self.retryTimeout = [BOXRealtimeServerNumericValue(BOXAPIObjectKeyRetryTimeout, JSONResponse) doubleValue];
+    }
+
+    return self;
+}
+
+@end
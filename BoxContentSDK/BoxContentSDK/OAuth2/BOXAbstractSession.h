@@ -10,6 +10,7 @@
 #import "BOXAPIQueueManager.h"
 #import "BOXUser.h"
 #import "BOXURLSessionManager.h"
+#import "BOXSessionTokenSnapshot.h"
 
 #pragma mark Notifications
 extern NSString *const BOXSessionDidBecomeAuthenticatedNotification;
@@ -84,6 +85,14 @@ extern NSString *const BOXUserIDKey;
  */
 @property (nonatomic, readwrite, strong) NSDate *accessTokenExpiration;
 
+/**
+ * The access token and its expiration, published as one immutable object. Setting accessToken or
+ * accessTokenExpiration publishes a new snapshot; reading it never blocks.
+ *
+ * Operations read the snapshot once when they prepare their request, rather than locking the session.
+ */
+@property (atomic, readonly, strong) BOXSessionTokenSnapshot *tokenSnapshot;
+
 /**
  * By default, credentials are stored in the keychain so they can be re-used when your app restarts.
  * Set this to false to disable this behavior, which will force users to log in every time.
@@ -161,6 +170,16 @@ extern NSString *const BOXUserIDKey;
  */
 - (void)addAuthorizationParametersToRequest:(NSMutableURLRequest *)request;
 
+/**
+ * Add the Authorization header for the access token of a given snapshot to a request.
+ *
+ * @param request       The API request that should be modified with an Authorization header and Bearer token.
+ * @param tokenSnapshot The snapshot to sign the request with.
+ *
+ * @see tokenSnapshot
+ */
+- (void)addAuthorizationParametersToRequest:(NSMutableURLRequest *)request tokenSnapshot:(BOXSessionTokenSnapshot *)tokenSnapshot;
+
 #pragma mark Token Helpers
 /** @name Token Helpers */
 
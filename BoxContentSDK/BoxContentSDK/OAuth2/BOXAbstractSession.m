@@ -30,6 +30,11 @@ static NSString *staticKeychainAccessGroup;
 @interface BOXAbstractSession ()
 
 @property (nonatomic, readwrite, strong) BOXURLSessionManager *urlSessionManager;
+@property (atomic, readwrite, strong) BOXSessionTokenSnapshot *tokenSnapshot;
+
+// Serializes the writers of tokenSnapshot, so that setting the token and its expiration separately loses neither.
+// Readers do not take it.
+@property (nonatomic, readonly, strong) NSObject *tokenSnapshotWriteLock;
 
 @end
 
@@ -39,6 +44,8 @@ static NSString *staticKeychainAccessGroup;
 {
     if (self = [super init]) {
         _credentialsPersistenceEnabled = YES;
+        _tokenSnapshot = [[BOXSessionTokenSnapshot alloc] initWithAccessToken:nil accessTokenExpiration:nil];
+        _tokenSnapshotWriteLock = [[NSObject alloc] init];
     }
     
     return self;
@@ -71,26 +78,63 @@ static NSString *staticKeychainAccessGroup;
 
 #pragma mark - Token Helpers
 
+- (NSString *)accessToken
+{
+    return self.tokenSnapshot.accessToken;
+}
+
+- (void)setAccessToken:(NSString *)accessToken
+{
+    @synchronized(self.tokenSnapshotWriteLock) {
+        [self setAccessToken:accessToken accessTokenExpiration:self.tokenSnapshot.accessTokenExpiration];
+    }
+}
+
+- (NSDate *)accessTokenExpiration
+{
+    return self.tokenSnapshot.accessTokenExpiration;
+}
+
+- (void)setAccessTokenExpiration:(NSDate *)accessTokenExpiration
+{
+    @synchronized(self.tokenSnapshotWriteLock) {
+        [self setAccessToken:self.tokenSnapshot.accessToken accessTokenExpiration:accessTokenExpiration];
+    }
+}
+
+- (void)setAccessToken:(NSString *)accessToken accessTokenExpiration:(NSDate *)accessTokenExpiration
+{
+    @synchronized(self.tokenSnapshotWriteLock) {
+        self.tokenSnapshot = [[BOXSessionTokenSnapshot alloc] initWithAccessToken:accessToken accessTokenExpiration:accessTokenExpiration];
+    }
+}
+
 - (void)reassignTokensFromSession:(BOXAbstractSession *)session
 {
-    self.accessToken = session.accessToken;
-    self.accessTokenExpiration = session.accessTokenExpiration;
+    // Snapshots are immutable, so they can be shared.
+    BOXSessionTokenSnapshot *tokenSnapshot = session.tokenSnapshot;
+    @synchronized(self.tokenSnapshotWriteLock) {
+        self.tokenSnapshot = tokenSnapshot;
+    }
 }
 
 #pragma mark - Session info
 
 - (BOOL)isAuthorized
 {
-    NSDate *now = [NSDate date];
-    return [self.accessTokenExpiration timeIntervalSinceDate:now] > 0;
+    return [self.tokenSnapshot isAuthorized];
 }
 
 #pragma mark - Request Authorization
 
 - (void)addAuthorizationParametersToRequest:(NSMutableURLRequest *)request
 {
-    NSString *bearerToken = [NSString stringWithFormat:@"Bearer %@", self.accessToken];
-    [request setValue:bearerToken forHTTPHeaderField:BOXAPIHTTPHeaderAuthorization];
+    [self addAuthorizationParametersToRequest:request tokenSnapshot:self.tokenSnapshot];
+}
+
+- (void)addAuthorizationParametersToRequest:(NSMutableURLRequest *)request tokenSnapshot:(BOXSessionTokenSnapshot *)tokenSnapshot
+{
+    [request setValue:tokenSnapshot.authorizationHeaderValue forHTTPHeaderField:BOXAPIHTTPHeaderAuthorization];
 }
 
 #pragma mark - Keychain
@@ -143,26 +187,23 @@ static NSString *staticKeychainAccessGroup;
     return keychainItemWrapper;
 }
 
++ (BOXCredentialStore *)credentialStore
+{
+    return [BOXCredentialStore storeWithIdentifierPrefix:[self keychainIdentifierPrefix] accessGroup:[self keychainAccessGroup]];
+}
+
 - (void)storeCredentialsToKeychain
 {
     if (self.credentialsPersistenceEnabled) {
-        NSDictionary *dictionary = [self keychainDictionary];
-        NSData *jsonData = [NSJSONSerialization dataWithJSONObject:dictionary options:0 error:nil];
-        NSString *jsonString = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
-        
-        BOXKeychainItemWrapper *keychainItemWrapper = [[self class]keychainItemWrapperForUserWithID:self.user.modelID];
-        [keychainItemWrapper resetKeychainItem];
-        [keychainItemWrapper setObject:jsonString forKey:(__bridge id)kSecValueData];
+        [[[self class] credentialStore] storeCredentialDictionary:[self keychainDictionary] forUserWithID:self.user.modelID];
     }
 }
 
 - (void)restoreCredentialsFromKeychainForUserWithID:(NSString *)userID
 {
     if (self.credentialsPersistenceEnabled) {
-        NSString *jsonString = [[[self class] keychainItemWrapperForUserWithID:userID] objectForKey:(__bridge id)kSecValueData];
-        NSError *error = nil;
-        NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:[jsonString dataUsingEncoding:NSUTF8StringEncoding] options:0 error:&error];
-        if (!error) {
+        NSDictionary *dictionary = [[[self class] credentialStore] credentialDictionaryForUserWithID:userID];
+        if (dictionary != nil) {
             [self restoreSessionWithKeyChainDictionary:dictionary];
         }
     }
@@ -173,8 +214,7 @@ static NSString *staticKeychainAccessGroup;
     NSString *userID = self.user.modelID;
     if (userID.length > 0)
     {
-        BOXKeychainItemWrapper *keychainWrapper = [[self class] keychainItemWrapperForUserWithID:self.user.modelID];
-        [keychainWrapper resetKeychainItem];
+        [[[self class] credentialStore] removeCredentialDictionaryForUserWithID:userID];
         
         [self clearCurrentSessionWithUserID:userID];
         
@@ -193,8 +233,7 @@ static NSString *staticKeychainAccessGroup;
     {
         if (user.modelID.length > 0)
         {
-            BOXKeychainItemWrapper *keychainWrapper = [self keychainItemWrapperForUserWithID:user.modelID];
-            [keychainWrapper resetKeychainItem];
+            [[self credentialStore] removeCredentialDictionaryForUserWithID:user.modelID];
             
             [[NSNotificationCenter defaultCenter] postNotification:[NSNotification notificationWithName:BOXSessionWasRevokedNotification
                                                                                                  object:nil
@@ -207,55 +246,19 @@ static NSString *staticKeychainAccessGroup;
 {
     NSMutableArray *users = [NSMutableArray array];
     
-    // Query the keychain for entries with an identifier that has our keychainIdentifierPrefix.
-    NSMutableDictionary *keychainQuery = [NSMutableDictionary dictionaryWithDictionary:@{(__bridge id)kSecReturnAttributes : (__bridge id)kCFBooleanTrue,
-                                                                                         (__bridge id)kSecMatchLimit : (__bridge id)kSecMatchLimitAll,
-                                                                                         (__bridge id)kSecClass : (__bridge id)kSecClassGenericPassword,
-                                                                                         (__bridge id)kSecAttrService : [BOXKeychainItemWrapper keychainServiceIdentifier]}];
-    
-#if ! TARGET_IPHONE_SIMULATOR
-    // Ignore the access group if running on the iPhone simulator.
-    // Apps that are built for the simulator aren't signed, so there's no keychain access group
-    // for the simulator to check.
-    if ([self keychainAccessGroup].length > 0) {
-        [keychainQuery setObject:[self keychainAccessGroup] forKey:(__bridge id)kSecAttrAccessGroup];
-    }
-#endif
-    
-    CFArrayRef keychainQueryResult = NULL;
-    OSStatus queryStatus =  SecItemCopyMatching((__bridge CFDictionaryRef)keychainQuery, (CFTypeRef *)&keychainQueryResult);
-    if (queryStatus == 0 && keychainQueryResult != NULL)
-    {
-        NSArray* keychainEntries = (__bridge_transfer NSArray*)keychainQueryResult;
-        for (NSDictionary *dict in keychainEntries)
-        {
-            NSObject *object = [dict objectForKey:((__bridge id)kSecAttrGeneric)];
-            if (![object isKindOfClass:[NSString class]]) {
-                continue;
-            }
-            
-            NSString *keychainIdentifier = (NSString *) object;
-            if ([keychainIdentifier hasPrefix:[self keychainIdentifierPrefix]])
-            {
-                NSString *userID = [self userIDFromKeychainIdentifier:keychainIdentifier];
-                if (userID.length > 0)
-                {
-                    NSString *jsonString = [[self keychainItemWrapperForUserWithID:userID] objectForKey:(__bridge id)kSecValueData];
-                    NSError *error = nil;
-                    NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:[jsonString dataUsingEncoding:NSUTF8StringEncoding] options:0 error:&error];
-                    NSString *userIDFromKeychain = [dictionary objectForKey:keychainUserIDKey];
-                    NSString *userNameFromKeychain = [dictionary objectForKey:keychainUserNameKey];
-                    NSString *userLoginFromKeychain = [dictionary objectForKey:keychainUserLoginKey];
-                    if ([userID isEqualToString:userIDFromKeychain]) {
-                        BOXUserMini *miniUser = [[BOXUserMini alloc] initWithUserID:userIDFromKeychain
-                                                                               name:userNameFromKeychain
-                                                                              login:userLoginFromKeychain];
-                        [users addObject:miniUser];
-                    }
-                }
-            }
+    // One keychain query for every account, the first time; the credential store serves the index afterwards.
+    NSDictionary *dictionariesByUserID = [[self credentialStore] credentialDictionariesByUserID];
+    [dictionariesByUserID enumerateKeysAndObjectsUsingBlock:^(NSString *userID, NSDictionary *dictionary, BOOL *stop) {
+        NSString *userIDFromKeychain = [dictionary objectForKey:keychainUserIDKey];
+        NSString *userNameFromKeychain = [dictionary objectForKey:keychainUserNameKey];
+        NSString *userLoginFromKeychain = [dictionary objectForKey:keychainUserLoginKey];
+        if ([userID isEqualToString:userIDFromKeychain]) {
+            BOXUserMini *miniUser = [[BOXUserMini alloc] initWithUserID:userIDFromKeychain
+                                                                   name:userNameFromKeychain
+                                                                  login:userLoginFromKeychain];
+            [users addObject:miniUser];
         }
-    }
+    }];
     
     NSArray *sortedUsers = [users sortedArrayUsingComparator:^NSComparisonResult(id a, id b) {
         BOXUserMini *userA = (BOXUserMini *) a;
@@ -296,15 +299,14 @@ static NSString *staticKeychainAccessGroup;
                                                    name:userNameFromKeychain
                                                   login:userLoginFromKeychain];
         
-        self.accessToken = accessTokenFromKeychain;
-        self.accessTokenExpiration = [NSDate box_dateWithISO8601String:accessTokenExpirationAsStringFromKeychain];
+        [self setAccessToken:accessTokenFromKeychain
+       accessTokenExpiration:[NSDate box_dateWithISO8601String:accessTokenExpirationAsStringFromKeychain]];
     }
 }
 
 - (void)clearCurrentSessionWithUserID:(NSString *)userID
 {
-    self.accessToken = nil;
-    self.accessTokenExpiration = nil;
+    [self setAccessToken:nil accessTokenExpiration:nil];
     self.user = nil;
 }
 
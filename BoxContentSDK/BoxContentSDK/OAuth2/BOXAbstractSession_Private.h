@@ -8,6 +8,7 @@
 
 #import "BOXAbstractSession.h"
 #import "BOXKeychainItemWrapper.h"
+#import "BOXCredentialStore.h"
 
 @class BOXRequest;
 
@@ -21,6 +22,11 @@
 
 @property (nonatomic, readwrite, strong) BOXUserMini *user;
 
+/**
+ *  Publishes a new access token and its expiration as a single snapshot.
+ */
+- (void)setAccessToken:(NSString *)accessToken accessTokenExpiration:(NSDate *)accessTokenExpiration;
+
 + (NSString *)keychainIdentifierPrefix;
 + (NSString *)keychainAccessGroup;
 
@@ -29,6 +35,11 @@
 
 + (BOXKeychainItemWrapper *)keychainItemWrapperForUserWithID:(NSString *)userID;
 
+/**
+ *  The store the credentials of sessions of this class are kept in, for the current keychain identifier prefix and access group.
+ */
++ (BOXCredentialStore *)credentialStore;
+
 /**
  *  This method should mirror BOXContentClient's prepareRequest: for when the session needs to create a request.
  *
@@ -21,8 +21,7 @@
     __weak BOXAppUserSession *weakSelf = self;
     BOXAPIAppUsersAuthOperation *operation = [[BOXAPIAppUsersAuthOperation alloc] initWithSession:self];
     operation.success = ^(NSString *accessToken, NSDate *accessTokenExpiration) {
-        weakSelf.accessToken = accessToken;
-        weakSelf.accessTokenExpiration = accessTokenExpiration;
+        [weakSelf setAccessToken:accessToken accessTokenExpiration:accessTokenExpiration];
         
         BOXUserRequest *userRequest = [[BOXUserRequest alloc] init];
         [weakSelf prepareRequest:userRequest];
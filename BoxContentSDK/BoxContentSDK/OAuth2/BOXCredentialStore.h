@@ -0,0 +1,56 @@
+//
+//  BOXCredentialStore.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * In-memory index of the credentials the SDK keeps in the keychain, one JSON dictionary per user.
+ *
+ * The first read fetches every entry of the store, data included, with a single keychain query, so listing and
+ * restoring N accounts costs one keychain round trip rather than N + 1. Writes update the index and reach the keychain
+ * before they return, so a rotated refresh token is never lost to the app being suspended or terminated.
+ *
+ * The keychain can change underneath the index, e.g. when an app extension sharing the access group refreshes tokens.
+ * Every write posts a Darwin notification that drops the index of every process using the same store, app extensions
+ * included. The index is also dropped whenever the app or the extension's host returns to the foreground, and can be
+ * dropped with invalidate.
+ */
+@interface BOXCredentialStore : NSObject
+
+@property (nonatomic, readonly, strong) NSString *identifierPrefix;
+@property (nonatomic, readonly, strong) NSString *accessGroup;
+
+/**
+ * The store shared by every session using this keychain identifier prefix and access group.
+ */
++ (instancetype)storeWithIdentifierPrefix:(NSString *)identifierPrefix accessGroup:(NSString *)accessGroup;
+
+- (instancetype)initWithIdentifierPrefix:(NSString *)identifierPrefix accessGroup:(NSString *)accessGroup;
+
+/**
+ * The credential dictionaries of every user in the keychain, keyed by user ID.
+ */
+- (NSDictionary *)credentialDictionariesByUserID;
+
+/**
+ * The credential dictionary of a user, from the index.
+ */
+- (NSDictionary *)credentialDictionaryForUserWithID:(NSString *)userID;
+
+/**
+ * The credential dictionary of a user, read from the keychain, bypassing and then updating the index. For callers
+ * that must see changes made by other processes.
+ */
+- (NSDictionary *)reloadCredentialDictionaryForUserWithID:(NSString *)userID;
+
+- (void)storeCredentialDictionary:(NSDictionary *)dictionary forUserWithID:(NSString *)userID;
+- (void)removeCredentialDictionaryForUserWithID:(NSString *)userID;
+
+/**
+ * Drops the index. The next read fetches the keychain again.
+ */
+- (void)invalidate;
+
+@end
@@ -0,0 +1,275 @@
+//
+//  BOXCredentialStore.m
+//  BoxContentSDK
+//
+
+#import "BOXCredentialStore.h"
+#import "BOXKeychainItemWrapper.h"
+
+#import <UIKit/UIKit.h>
+
+@interface BOXCredentialStore ()
+
+// Credential dictionaries keyed by user ID, nil until the keychain is fetched. Guarded by @synchronized(self).
+@property (nonatomic, readwrite, strong) NSMutableDictionary *credentialDictionariesByUserIDIndex;
+// Every keychain access goes through this queue, so reads see the writes enqueued before them.
+@property (nonatomic, readwrite, strong) dispatch_queue_t keychainQueue;
+
+@end
+
+// Posted to every process after a write reaches the keychain, so that indexes in app extensions sharing the access
+// group, which never receive UIApplicationWillEnterForegroundNotification, are dropped too.
+static NSString *const BOXCredentialStoreDidChangeDarwinNotificationPrefix = @"com.box.contentsdk.credentialstore.didchange.";
+
+static void BOXCredentialStoreDidChange(CFNotificationCenterRef center, void *observer, CFStringRef name, const void *object, CFDictionaryRef userInfo)
+{
+    [(__bridge BOXCredentialStore *)observer invalidate];
+}
+
+@implementation BOXCredentialStore
+
++ (instancetype)storeWithIdentifierPrefix:(NSString *)identifierPrefix accessGroup:(NSString *)accessGroup
+{
+    static NSMutableDictionary *storesByKey = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        storesByKey = [NSMutableDictionary dictionary];
+    });
+
+    NSString *key = [NSString stringWithFormat:@"%@|%@", accessGroup ?: @"", identifierPrefix];
+    @synchronized(storesByKey) {
+        BOXCredentialStore *store = storesByKey[key];
+        if (store == nil) {
+            store = [[self alloc] initWithIdentifierPrefix:identifierPrefix accessGroup:accessGroup];
+            storesByKey[key] = store;
+        }
+        return store;
+    }
+}
+
+- (instancetype)initWithIdentifierPrefix:(NSString *)identifierPrefix accessGroup:(NSString *)accessGroup
+{
+    if (self = [super init]) {
+        _identifierPrefix = [identifierPrefix copy];
+        _accessGroup = [accessGroup copy];
+        _keychainQueue = dispatch_queue_create("com.box.contentsdk.credentialstore", DISPATCH_QUEUE_SERIAL);
+
+        [[NSNotificationCenter defaultCenter] addObserver:self
+                                                 selector:@selector(applicationWillEnterForeground:)
+                                                     name:UIApplicationWillEnterForegroundNotification
+                                                   object:nil];
+        if (&NSExtensionHostWillEnterForegroundNotification != NULL) {
+            [[NSNotificationCenter defaultCenter] addObserver:self
+                                                     selector:@selector(applicationWillEnterForeground:)
+                                                         name:NSExtensionHostWillEnterForegroundNotification
+                                                       object:nil];
+        }
+        CFNotificationCenterAddObserver(CFNotificationCenterGetDarwinNotifyCenter(),
+                                        (__bridge const void *)self,
+                                        BOXCredentialStoreDidChange,
+                                        (__bridge CFStringRef)[self didChangeNotificationName],
+                                        NULL,
+                                        CFNotificationSuspensionBehaviorDeliverImmediately);
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    CFNotificationCenterRemoveEveryObserver(CFNotificationCenterGetDarwinNotifyCenter(), (__bridge const void *)self);
+    [[NSNotificationCenter defaultCenter] removeObserver:self];
+}
+
+- (void)applicationWillEnterForeground:(NSNotification *)notification
+{
+    [self invalidate];
+}
+
+#pragma mark - Reads
+
+- (NSDictionary *)credentialDictionariesByUserID
+{
+    @synchronized(self) {
+        return [[self loadedIndex] copy];
+    }
+}
+
+- (NSDictionary *)credentialDictionaryForUserWithID:(NSString *)userID
+{
+    if (userID.length == 0) {
+        return nil;
+    }
+    @synchronized(self) {
+        return [self loadedIndex][userID];
+    }
+}
+
+- (NSDictionary *)reloadCredentialDictionaryForUserWithID:(NSString *)userID
+{
+    if (userID.length == 0) {
+        return nil;
+    }
+    @synchronized(self) {
+        __block NSDictionary *dictionary = nil;
+        dispatch_sync(self.keychainQueue, ^{
+            NSString *jsonString = [[self keychainItemWrapperForUserWithID:userID] objectForKey:(__bridge id)kSecValueData];
+            dictionary = [self credentialDictionaryWithJSONData:[jsonString dataUsingEncoding:NSUTF8StringEncoding]];
+        });
+        if (self.credentialDictionariesByUserIDIndex != nil) {
+            self.credentialDictionariesByUserIDIndex[userID] = dictionary;
+        }
+        return dictionary;
+    }
+}
+
+// Must be called within @synchronized(self). Fetching while holding the lock keeps a concurrent write from being
+// enqueued after the fetch but applied to an index the fetch then replaces.
+- (NSMutableDictionary *)loadedIndex
+{
+    if (self.credentialDictionariesByUserIDIndex == nil) {
+        __block NSMutableDictionary *index = nil;
+        __block OSStatus status = errSecSuccess;
+        dispatch_sync(self.keychainQueue, ^{
+            index = [self fetchCredentialDictionariesFromKeychainWithStatus:&status];
+        });
+        // A failed fetch, e.g. while the device is locked, says nothing about what the keychain holds. Keeping its
+        // empty result would hide every account until the index is next dropped, so the next read fetches again.
+        if (status != errSecSuccess && status != errSecItemNotFound) {
+            return index;
+        }
+        self.credentialDictionariesByUserIDIndex = index;
+    }
+    return self.credentialDictionariesByUserIDIndex;
+}
+
+- (NSMutableDictionary *)fetchCredentialDictionariesFromKeychainWithStatus:(OSStatus *)outStatus
+{
+    NSMutableDictionary *index = [NSMutableDictionary dictionary];
+
+    // Attributes and data of every entry in one query, rather than a query per entry for its data.
+    NSMutableDictionary *keychainQuery = [NSMutableDictionary dictionaryWithDictionary:@{(__bridge id)kSecReturnAttributes : (__bridge id)kCFBooleanTrue,
+                                                                                         (__bridge id)kSecReturnData : (__bridge id)kCFBooleanTrue,
+                                                                                         (__bridge id)kSecMatchLimit : (__bridge id)kSecMatchLimitAll,
+                                                                                         (__bridge id)kSecClass : (__bridge id)kSecClassGenericPassword,
+                                                                                         (__bridge id)kSecAttrService : [BOXKeychainItemWrapper keychainServiceIdentifier]}];
+
+#if ! TARGET_IPHONE_SIMULATOR
+    // Ignore the access group if running on the iPhone simulator.
+    // Apps that are built for the simulator aren't signed, so there's no keychain access group
+    // for the simulator to check.
+    if (self.accessGroup.length > 0) {
+        [keychainQuery setObject:self.accessGroup forKey:(__bridge id)kSecAttrAccessGroup];
+    }
+#endif
+
+    CFArrayRef keychainQueryResult = NULL;
+    OSStatus queryStatus = [self copyMatchingKeychainQuery:keychainQuery result:(CFTypeRef *)&keychainQueryResult];
+    if (outStatus != NULL) {
+        *outStatus = queryStatus;
+    }
+    if (queryStatus == errSecSuccess && keychainQueryResult != NULL) {
+        NSArray *keychainEntries = (__bridge_transfer NSArray *)keychainQueryResult;
+        for (NSDictionary *entry in keychainEntries) {
+            NSObject *object = [entry objectForKey:(__bridge id)kSecAttrGeneric];
+            if (![object isKindOfClass:[NSString class]]) {
+                continue;
+            }
+
+            NSString *keychainIdentifier = (NSString *)object;
+            if ([keychainIdentifier hasPrefix:self.identifierPrefix]) {
+                NSString *userID = [keychainIdentifier substringFromIndex:self.identifierPrefix.length];
+                NSDictionary *dictionary = [self credentialDictionaryWithJSONData:[entry objectForKey:(__bridge id)kSecValueData]];
+                if (userID.length > 0 && dictionary != nil) {
+                    index[userID] = dictionary;
+                }
+            }
+        }
+    }
+
+    return index;
+}
+
+- (OSStatus)copyMatchingKeychainQuery:(NSDictionary *)query result:(CFTypeRef *)result
+{
+    return SecItemCopyMatching((__bridge CFDictionaryRef)query, result);
+}
+
+- (NSDictionary *)credentialDictionaryWithJSONData:(NSData *)data
+{
+    if (![data isKindOfClass:[NSData class]] || data.length == 0) {
+        return nil;
+    }
+    id object = [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    return [object isKindOfClass:[NSDictionary class]] ? object : nil;
+}
+
+#pragma mark - Writes
+
+- (void)storeCredentialDictionary:(NSDictionary *)dictionary forUserWithID:(NSString *)userID
+{
+    if (userID.length == 0 || dictionary == nil) {
+        return;
+    }
+    NSDictionary *dictionaryCopy = [dictionary copy];
+    NSData *jsonData = [NSJSONSerialization dataWithJSONObject:dictionaryCopy options:0 error:nil];
+    NSString *jsonString = [[NSString alloc] initWithData:jsonData encoding:NSUTF8StringEncoding];
+
+    // Writes are synchronous. Box rotates refresh tokens, so a write still pending when the app is suspended or killed
+    // would lose the only valid refresh token and log the user out.
+    @synchronized(self) {
+        self.credentialDictionariesByUserIDIndex[userID] = dictionaryCopy;
+        dispatch_sync(self.keychainQueue, ^{
+            BOXKeychainItemWrapper *keychainItemWrapper = [self keychainItemWrapperForUserWithID:userID];
+            [keychainItemWrapper resetKeychainItem];
+            [keychainItemWrapper setObject:jsonString forKey:(__bridge id)kSecValueData];
+        });
+    }
+    [self postDidChangeNotification];
+}
+
+- (void)removeCredentialDictionaryForUserWithID:(NSString *)userID
+{
+    if (userID.length == 0) {
+        return;
+    }
+    @synchronized(self) {
+        [self.credentialDictionariesByUserIDIndex removeObjectForKey:userID];
+        dispatch_sync(self.keychainQueue, ^{
+            [[self keychainItemWrapperForUserWithID:userID] resetKeychainItem];
+        });
+    }
+    [self postDidChangeNotification];
+}
+
+- (void)invalidate
+{
+    @synchronized(self) {
+        self.credentialDictionariesByUserIDIndex = nil;
+    }
+}
+
+#pragma mark - Helpers
+
+- (NSString *)didChangeNotificationName
+{
+    return [NSString stringWithFormat:@"%@%@|%@", BOXCredentialStoreDidChangeDarwinNotificationPrefix, self.accessGroup ?: @"", self.identifierPrefix];
+}
+
+// This process receives the notification as well and drops its own index, which costs one keychain fetch on the next
+// read. Writes are rare enough, once per token refresh, for that not to matter.
+- (void)postDidChangeNotification
+{
+    CFNotificationCenterPostNotification(CFNotificationCenterGetDarwinNotifyCenter(),
+                                         (__bridge CFStringRef)[self didChangeNotificationName],
+                                         NULL,
+                                         NULL,
+                                         YES);
+}
+
+- (BOXKeychainItemWrapper *)keychainItemWrapperForUserWithID:(NSString *)userID
+{
+    NSString *identifier = [self.identifierPrefix stringByAppendingString:userID];
+    return [[BOXKeychainItemWrapper alloc] initWithIdentifier:identifier accessGroup:self.accessGroup];
+}
+
+@end
@@ -115,12 +115,12 @@
 
     operation.success = ^(NSURLRequest *request, NSHTTPURLResponse *response, NSDictionary *JSONDictionary)
     {
-        self.accessToken = [JSONDictionary valueForKey:BOXAuthTokenJSONAccessTokenKey];
         self.refreshToken = [JSONDictionary valueForKey:BOXAuthTokenJSONRefreshTokenKey];
         
         NSTimeInterval accessTokenExpiresIn = [[JSONDictionary valueForKey:BOXAuthTokenJSONExpiresInKey] integerValue];
         BOXAssert(accessTokenExpiresIn >= 0, @"accessTokenExpiresIn value is negative");
-        self.accessTokenExpiration = [NSDate dateWithTimeIntervalSinceNow:accessTokenExpiresIn];
+        [self setAccessToken:[JSONDictionary valueForKey:BOXAuthTokenJSONAccessTokenKey]
+       accessTokenExpiration:[NSDate dateWithTimeIntervalSinceNow:accessTokenExpiresIn]];
         
         BOXUserRequest *userRequest = [[BOXUserRequest alloc] init];
         [self prepareRequest:userRequest];
@@ -254,7 +254,6 @@
     
     operation.success = ^(NSURLRequest *request, NSHTTPURLResponse *response, NSDictionary *JSONDictionary)
     {
-        self.accessToken = [JSONDictionary valueForKey:BOXAuthTokenJSONAccessTokenKey];
         self.refreshToken = [JSONDictionary valueForKey:BOXAuthTokenJSONRefreshTokenKey];
         
         NSTimeInterval accessTokenExpiresIn = [[JSONDictionary valueForKey:BOXAuthTokenJSONExpiresInKey] integerValue];
@@ -262,7 +261,9 @@
             // When requesting an access token that expires immediately, this value can sometimes be -1, which isn't ideal but is technically correct.
             BOXLog(@"Warning: accessTokenExpiresIn value is negative");
         }
-        self.accessTokenExpiration = [NSDate dateWithTimeIntervalSinceNow:accessTokenExpiresIn];
+        // Operations pick up the new token and expiration together.
+        [self setAccessToken:[JSONDictionary valueForKey:BOXAuthTokenJSONAccessTokenKey]
+       accessTokenExpiration:[NSDate dateWithTimeIntervalSinceNow:accessTokenExpiresIn]];
         
         [self storeCredentialsToKeychain];
         
@@ -341,8 +342,7 @@
     NSString *userIDRevoked = [notification.userInfo objectForKey:BOXUserIDKey];
     if ([userIDRevoked isEqualToString:self.user.modelID])
     {
-        BOXKeychainItemWrapper *keychainWrapper = [[self class] keychainItemWrapperForUserWithID:self.user.modelID];
-        [keychainWrapper resetKeychainItem];
+        [[[self class] credentialStore] removeCredentialDictionaryForUserWithID:self.user.modelID];
         
         [self clearCurrentSessionWithUserID:self.user.modelID];
     }
@@ -0,0 +1,30 @@
+//
+//  BOXSessionTokenSnapshot.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * The authorization state of a session at one point in time. Sessions publish a new snapshot every time their tokens
+ * change, so a snapshot can be read from any thread without locking, and the token it signs a request with is always
+ * the one it reports.
+ */
+@interface BOXSessionTokenSnapshot : NSObject
+
+@property (nonatomic, readonly, copy) NSString *accessToken;
+@property (nonatomic, readonly, copy) NSDate *accessTokenExpiration;
+
+/**
+ * The value of the Authorization header for accessToken, built once.
+ */
+@property (nonatomic, readonly, copy) NSString *authorizationHeaderValue;
+
+- (instancetype)initWithAccessToken:(NSString *)accessToken accessTokenExpiration:(NSDate *)accessTokenExpiration;
+
+/**
+ * Whether the access token is expected to still be valid.
+ */
+- (BOOL)isAuthorized;
+
+@end
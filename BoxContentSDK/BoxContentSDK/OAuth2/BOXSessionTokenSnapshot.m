@@ -0,0 +1,25 @@
+//
+//  BOXSessionTokenSnapshot.m
+//  BoxContentSDK
+//
+
+#import "BOXSessionTokenSnapshot.h"
+
+@implementation BOXSessionTokenSnapshot
+
+- (instancetype)initWithAccessToken:(NSString *)accessToken accessTokenExpiration:(NSDate *)accessTokenExpiration
+{
+    if (self = [super init]) {
+        _accessToken = [accessToken copy];
+        _accessTokenExpiration = [accessTokenExpiration copy];
+        _authorizationHeaderValue = [NSString stringWithFormat:@"Bearer %@", accessToken];
+    }
+    return self;
+}
+
+- (BOOL)isAuthorized
+{
+    return [self.accessTokenExpiration timeIntervalSinceNow] > 0;
+}
+
+@end
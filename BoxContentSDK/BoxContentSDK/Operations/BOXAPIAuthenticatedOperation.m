@@ -7,6 +7,7 @@
 //
 
 #import "BOXAPIAuthenticatedOperation.h"
+#import "BOXAPIOperation_Private.h"
 
 #import "BOXAPIJSONOperation.h"
 #import "BOXLog.h"
@@ -35,7 +36,7 @@
 
 - (void)prepareAPIRequest
 {
-    [self.session addAuthorizationParametersToRequest:self.APIRequest];
+    [self.session addAuthorizationParametersToRequest:self.APIRequest tokenSnapshot:(self.tokenSnapshot ?: self.session.tokenSnapshot)];
 }
 
 - (BOOL)isAccessTokenExpired
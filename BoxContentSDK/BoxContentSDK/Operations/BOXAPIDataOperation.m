@@ -28,6 +28,14 @@
 
 @property (nonatomic, readwrite, assign) unsigned long long bytesReceived;
 
+// Whether the output stream is the in-memory stream created by default rather than one set by the caller.
+// Bytes written to it stay in memory, so they are counted against the memory limits.
+@property (nonatomic, readwrite, assign) BOOL writesToMemory;
+
+// Whether the session task was suspended because receivedDataBuffer put the operation over a memory limit.
+// It is resumed once the output stream has drained the buffer.
+@property (nonatomic, readwrite, assign) BOOL suspendedForMemory;
+
 - (void)writeDataToOutputStream;
 
 - (long long)contentLength;
@@ -53,6 +61,8 @@
 @synthesize receivedDataBuffer = _receivedDataBuffer;
 @synthesize outputStreamHasSpaceAvailable = _outputStreamHasSpaceAvailable;
 @synthesize bytesReceived = _bytesReceived;
+@synthesize writesToMemory = _writesToMemory;
+@synthesize suspendedForMemory = _suspendedForMemory;
 
 - (id)initWithURL:(NSURL *)URL HTTPMethod:(NSString *)HTTPMethod body:(NSDictionary *)body queryParams:(NSDictionary *)queryParams session:(BOXAbstractSession *)session
 {
@@ -61,6 +71,7 @@
     if (self != nil)
     {
         _outputStream = [NSOutputStream outputStreamToMemory];
+        _writesToMemory = YES;
         _receivedDataBuffer = [NSMutableData dataWithCapacity:0];
         _outputStreamHasSpaceAvailable = YES; // attempt to write to the output stream as soon as we receive data
         _bytesReceived = 0;
@@ -73,6 +84,12 @@
     return self;
 }
 
+- (void)setOutputStream:(NSOutputStream *)outputStream
+{
+    _outputStream = outputStream;
+    _writesToMemory = NO;
+}
+
 - (void)prepareAPIRequest
 {
     [super prepareAPIRequest];
@@ -299,8 +316,22 @@
     } else {
         // Buffer received data in an NSMutableData ivar because the output stream
         // may not have space available for writing
+        BOOL withinLimits = YES;
         @synchronized (self.receivedDataBuffer) {
             [self.receivedDataBuffer appendData:data];
+            withinLimits = [self.memoryAccount setBytes:self.receivedDataBuffer.length ofKind:BOXTransferBufferKindDownloadBuffer];
+        }
+
+        if (withinLimits == NO) {
+            if (self.writesToMemory) {
+                // Draining the buffer would not free any memory, everything received stays in memory.
+                [self failWithMemoryLimitExceeded];
+                return;
+            } else if (self.suspendedForMemory == NO) {
+                // Stop receiving until the output stream catches up.
+                self.suspendedForMemory = YES;
+                [self.sessionTask suspend];
+            }
         }
 
         // If the output stream does have space available, trigger the writeDataToOutputStream
@@ -366,6 +397,17 @@
 
                 // truncate buffer by removing the consumed bytes from the front
                 [self.receivedDataBuffer replaceBytesInRange:NSMakeRange(0, bytesWrittenToOutputStream) withBytes:NULL length:0];
+                [self.memoryAccount setBytes:self.receivedDataBuffer.length ofKind:BOXTransferBufferKindDownloadBuffer];
+
+                if (self.writesToMemory && [self accountBytes:bytesWrittenToOutputStream ofKind:BOXTransferBufferKindMemoryOutputStream] == NO) {
+                    return; // Bail out due to error
+                }
+
+                if (self.suspendedForMemory &&
+                    (self.receivedDataBuffer.length == 0 || [[BOXTransferMemoryMonitor sharedMonitor] isWithinLimitsWithOperationBytes:self.memoryAccount.currentBytes])) {
+                    self.suspendedForMemory = NO;
+                    [self.sessionTask resume];
+                }
             }
         }
     }
@@ -386,6 +428,10 @@
 {
     // Delay grows each time the request is re-enqueued.
     double delay = MIN(pow((1 + REENQUE_BASE_DELAY), self.timesReenqueued) - 1, MAX_REENQUE_DELAY);
+    // Past the deadline, the copy fails as soon as it is enqueued; there is no point in waiting for it.
+    if (self.cancellationContext != nil) {
+        delay = MIN(delay, [self.cancellationContext remainingTime]);
+    }
     return delay;
 }
 
@@ -401,12 +447,24 @@
                                                                                    queryParams:queryStringParametersCopy
                                                                                  session:self.session];
     operationCopy.outputStream = self.outputStream;
+    operationCopy.writesToMemory = self.writesToMemory;
     operationCopy.outputStream.delegate = nil;
     operationCopy.timesReenqueued = self.timesReenqueued;
+    operationCopy.cancellationContext = self.cancellationContext;
     operationCopy.successBlock = [self.successBlock copy];
     operationCopy.failureBlock = [self.failureBlock copy];
     operationCopy.progressBlock = [self.progressBlock copy];
-    
+    operationCopy.modelID = self.modelID;
+    operationCopy.isSmallDownloadOperation = self.isSmallDownloadOperation;
+    operationCopy.APIRequest.cachePolicy = self.APIRequest.cachePolicy;
+
+    // Migrate header fields: a Range header narrows the download to part of the file and shared link
+    // headers give access to the item, so the copy must request exactly what the original did.
+    NSDictionary *headers = [self.APIRequest allHTTPHeaderFields];
+    for (id key in headers) {
+        [operationCopy.APIRequest setValue:[headers objectForKey:key] forHTTPHeaderField:key];
+    }
+
     return operationCopy;
 }
 
@@ -49,6 +49,14 @@
  */
 @property (nonatomic, readwrite, strong) BOXAPIJSONFailureBlock failure;
 
+/**
+ * Describes whether or not the operation is a long-poll connection that the server may hold open
+ * for several minutes, such as a realtime events subscription. If it is, the operation will be run
+ * on a specific queue so it does not hold one of the slots of the global queue, and it is sent
+ * without the session's authorization header since realtime servers are not part of the API.
+ */
+@property (nonatomic, readwrite, assign) BOOL isLongPollOperation;
+
 /**
  * Call success or failure depending on whether or not an error has occurred during the request.
  * @see success
@@ -56,6 +64,24 @@
  */
 - (void)performCompletionCallback;
 
+/** @name Compression */
+
+/**
+ * Whether JSON request bodies of at least 1 KB are sent gzip-compressed, with "Content-Encoding: gzip".
+ * Only enable it against servers that accept compressed request bodies. The default is NO.
+ *
+ * Responses are always negotiated compressed, and decoded as they arrive by the URL loading system, so
+ * processResponseData: receives the decoded JSON.
+ */
++ (void)setRequestBodyCompressionEnabled:(BOOL)enabled;
++ (BOOL)isRequestBodyCompressionEnabled;
+
+/**
+ * Whether this operation may compress its request body when request body compression is enabled.
+ * Operations that replace the JSON body before sending it, such as multipart uploads, return NO.
+ */
+- (BOOL)shouldCompressRequestBody;
+
 /** @name JSON */
 
 /**
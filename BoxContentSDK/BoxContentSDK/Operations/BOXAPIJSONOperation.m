@@ -8,8 +8,16 @@
 
 #import "BOXAPIJSONOperation.h"
 #import "BOXContentSDKErrors.h"
+#import "BOXAPIOperation_Private.h"
+#import "NSData+BOXContentSDKAdditions.h"
 
 #define BOX_API_CONTENT_TYPE_JSON  (@"application/json")
+#define BOX_API_CONTENT_ENCODING_GZIP (@"gzip")
+
+// Smaller bodies fit in a packet either way and are not worth the CPU.
+#define BOX_API_REQUEST_BODY_COMPRESSION_MIN_LENGTH (1024)
+
+static BOOL staticRequestBodyCompressionEnabled = NO;
 
 @implementation BOXAPIJSONOperation
 
@@ -27,11 +35,18 @@
     operationCopy.success = [self.success copy];
     operationCopy.failure = [self.failure copy];
     operationCopy.timesReenqueued = self.timesReenqueued;
+    operationCopy.cancellationContext = self.cancellationContext;
+    operationCopy.isLongPollOperation = self.isLongPollOperation;
+    operationCopy.APIRequest.timeoutInterval = self.APIRequest.timeoutInterval;
 
     // Migrate header fields (this is especially important for requests where some of the key
     // information is in the headers, such as Shared Link requests for the underlying item).
+    // The copy encodes its body again, and compresses it when it is prepared.
     NSDictionary *headers = [self.APIRequest allHTTPHeaderFields];
     for (id key in headers) {
+        if ([key caseInsensitiveCompare:BOXAPIHTTPHeaderContentEncoding] == NSOrderedSame) {
+            continue;
+        }
         [operationCopy.APIRequest setValue:[headers objectForKey:key] forHTTPHeaderField:key];
     }
 
@@ -55,13 +70,53 @@
     return self;
 }
 
++ (void)setRequestBodyCompressionEnabled:(BOOL)enabled
+{
+    staticRequestBodyCompressionEnabled = enabled;
+}
+
++ (BOOL)isRequestBodyCompressionEnabled
+{
+    return staticRequestBodyCompressionEnabled;
+}
+
+- (BOOL)shouldCompressRequestBody
+{
+    return YES;
+}
+
 - (void)prepareAPIRequest
 {
-    [super prepareAPIRequest];
+    // Long-poll URLs point at realtime servers outside of the API, authorized by the channel in their query. They
+    // must never receive the account's Bearer token.
+    if (!self.isLongPollOperation) {
+        [super prepareAPIRequest];
+    }
     if ([self.HTTPMethod isEqualToString:BOXAPIHTTPMethodPOST] || [self.HTTPMethod isEqualToString:BOXAPIHTTPMethodPUT])
     {
         [self.APIRequest setValue:BOX_API_CONTENT_TYPE_JSON forHTTPHeaderField:BOXAPIHTTPHeaderContentType];
     }
+
+    [self compressRequestBodyIfNeeded];
+}
+
+- (void)compressRequestBodyIfNeeded
+{
+    NSData *body = self.APIRequest.HTTPBody;
+    if (![[self class] isRequestBodyCompressionEnabled] ||
+        ![self shouldCompressRequestBody] ||
+        self.uncompressedRequestBodyLength > 0 ||
+        body.length < BOX_API_REQUEST_BODY_COMPRESSION_MIN_LENGTH) {
+        return;
+    }
+
+    NSData *compressedBody = [body box_gzipCompressedData];
+    if (compressedBody == nil || compressedBody.length >= body.length) {
+        return;
+    }
+    self.APIRequest.HTTPBody = compressedBody;
+    [self.APIRequest setValue:BOX_API_CONTENT_ENCODING_GZIP forHTTPHeaderField:BOXAPIHTTPHeaderContentEncoding];
+    self.uncompressedRequestBodyLength = body.length;
 }
 
 - (NSData *)encodeBody:(NSDictionary *)bodyDictionary
@@ -164,4 +219,10 @@
     return YES;
 }
 
+- (BOOL)isAccessTokenExpired
+{
+    // A long poll is not signed with the access token, so its rejection says nothing about the token.
+    return !self.isLongPollOperation && [super isAccessTokenExpired];
+}
+
 @end
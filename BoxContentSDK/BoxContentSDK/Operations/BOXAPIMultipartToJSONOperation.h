@@ -45,6 +45,12 @@ typedef void (^BOXAPIMultipartProgressBlock)(unsigned long long totalBytes, unsi
  */
 @property (nonatomic, readwrite, strong) NSString *uploadMultipartCopyFilePath;
 
+/**
+ * Describes wether or not the operation is a small upload.
+ * If it is, the operation will be run on a specific queue so that it is not held up behind large uploads.
+ */
+@property (nonatomic, readwrite, assign) BOOL isSmallUploadOperation;
+
 /** @name Callbacks */
 
 /**
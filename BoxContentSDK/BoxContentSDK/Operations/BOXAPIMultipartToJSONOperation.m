@@ -61,6 +61,12 @@ static NSString * BOXAPIMultipartContentTypeHeader(void)
     return self;
 }
 
+- (BOOL)shouldCompressRequestBody
+{
+    // The body is the multipart stream, the JSON body only provides its form fields.
+    return NO;
+}
+
 #pragma mark - Append data to upload operation
 
 - (void)appendMultipartPieceWithData:(NSData *)data fieldName:(NSString *)fieldName filename:(NSString *)filename MIMEType:(NSString *)MIMEType
@@ -73,6 +79,11 @@ static NSString * BOXAPIMultipartContentTypeHeader(void)
                                                                                                    fileName:filename
                                                                                                    mimeType:MIMEType];
                                                                        }];
+
+    // The piece is held in memory until the body is sent.
+    if ([self.memoryAccount setBytes:data.length ofKind:BOXTransferBufferKindMultipartBody] == NO) {
+        [self failWithMemoryLimitExceeded];
+    }
 }
 
 - (void)appendMultipartPieceWithInputStream:(NSInputStream *)inputStream contentLength:(unsigned long long)length fieldName:(NSString *)fieldName filename:(NSString *)filename MIMEType:(NSString *)MIMEType
@@ -145,11 +145,8 @@
         return NO;
     }
 
-    NSString *jsonString = [[BOXOAuth2Session keychainItemWrapperForUserWithID:userID] objectForKey:(__bridge id)kSecValueData];
-    NSError *error = nil;
-    NSDictionary *dictionary = [NSJSONSerialization JSONObjectWithData:[jsonString dataUsingEncoding:NSUTF8StringEncoding]
-                                                               options:0
-                                                                 error:&error];
+    // Another process sharing the keychain may have refreshed the tokens, so read the keychain rather than the index.
+    NSDictionary *dictionary = [[BOXOAuth2Session credentialStore] reloadCredentialDictionaryForUserWithID:userID];
     if (dictionary != nil) {
         NSString *keychainAccessToken = dictionary[keychainAccessTokenKey];
 
@@ -9,8 +9,10 @@
 #import <Foundation/Foundation.h>
 #import "BOXContentSDKConstants.h"
 #import "BOXURLSessionManager.h"
+#import "BOXCancellationContext.h"
 
 @class BOXAbstractSession;
+@class BOXTransferMemoryAccount;
 
 // Success and Failure callbacks
 //
@@ -85,7 +87,7 @@ typedef void (^BOXAPIDataFailureBlock)(NSURLRequest *request, NSHTTPURLResponse
  * - performCompletionCallback
  *
  */
-@interface BOXAPIOperation : NSOperation <BOXURLSessionTaskDelegate>
+@interface BOXAPIOperation : NSOperation <BOXURLSessionTaskDelegate, BOXCancellable>
 
 /** @name Authorization */
 
@@ -150,6 +152,23 @@ typedef void (^BOXAPIDataFailureBlock)(NSURLRequest *request, NSHTTPURLResponse
  */
 @property (nonatomic, readwrite, strong) NSHTTPURLResponse *HTTPResponse;
 
+/**
+ * The bytes this operation holds in memory, and their peak. Counted by BOXTransferMemoryMonitor.
+ */
+@property (nonatomic, readonly, strong) BOXTransferMemoryAccount *memoryAccount;
+
+/**
+ * Identifies this operation in the records of BOXTraceLog.
+ */
+@property (nonatomic, readonly, assign) uint64_t traceID;
+
+/**
+ * The context of the request this operation runs for. The operation is cancelled along with it, and fails
+ * without making its request if it is already cancelled or past its deadline when the operation starts.
+ * Copies of the operation share it.
+ */
+@property (nonatomic, readwrite, strong) BOXCancellationContext *cancellationContext;
+
 /** @name Error handling */
 
 /**
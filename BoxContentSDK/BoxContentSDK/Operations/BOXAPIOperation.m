@@ -13,6 +13,10 @@
 #import "BOXLog.h"
 #import "BOXURLRequestSerialization.h"
 #import "BOXAPIOAuth2ToJSONOperation.h"
+#import "BOXTransferMemoryMonitor.h"
+#import "BOXMetricsRegistry.h"
+#import "BOXTraceLog.h"
+#import "BOXAPIAuthenticatedOperation.h"
 
 static NSString * BoxOperationKeyPathForState(BOXAPIOperationState state) {
     switch (state) {
@@ -56,6 +60,15 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
 
 - (void)cancelSessionTask;
 
+// When the session task was resumed, 0 if it never was.
+@property (nonatomic, readwrite, assign) CFAbsoluteTime sessionTaskStartTime;
+
+// Bytes of response body on the wire and after the loading system decoded any Content-Encoding, from the
+// transaction metrics of the session task. Both 0 where the loading system does not report them.
+// Guarded by @synchronized(self).
+@property (nonatomic, readwrite, assign) unsigned long long responseBodyBytesReceived;
+@property (nonatomic, readwrite, assign) unsigned long long decodedResponseBodyBytes;
+
 @end
 
 @implementation BOXAPIOperation
@@ -71,7 +84,10 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
 
 // request response properties
 @synthesize responseData = _responseData;
+@synthesize cancellationContext = _cancellationContext;
 @synthesize HTTPResponse = _HTTPResponse;
+@synthesize memoryAccount = _memoryAccount;
+@synthesize traceID = _traceID;
 
 // error handling
 @synthesize error = _error;
@@ -133,6 +149,8 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
         // (see BOXAPIDataOperation as an example). Some subclasses will not use this object and for
         // correct processing it needs to remain nil rather than an empty mutable data object.
         _responseData = nil;
+        _memoryAccount = [[BOXTransferMemoryAccount alloc] initWithMonitor:[BOXTransferMemoryMonitor sharedMonitor]];
+        _traceID = [BOXTraceLog nextOperationID];
 
         self.state = BOXAPIOperationStateReady;
     }
@@ -149,11 +167,26 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
     NSString *oldStateKey = BoxOperationKeyPathForState(self.state);
     NSString *newStateKey = BoxOperationKeyPathForState(state);
 
+    BOXAPIOperationState oldState = self.state;
+
     [self willChangeValueForKey:newStateKey];
     [self willChangeValueForKey:oldStateKey];
     _state = state;
     [self didChangeValueForKey:oldStateKey];
     [self didChangeValueForKey:newStateKey];
+
+    if (state == BOXAPIOperationStateExecuting) {
+        [self.queueGauge operationStarted];
+    } else if (state == BOXAPIOperationStateFinished) {
+        [self.queueGauge operationFinishedAfterStarting:(oldState == BOXAPIOperationStateExecuting)];
+    }
+}
+
+- (void)setQueueGauge:(BOXQueueGauge *)queueGauge
+{
+    BOXAssert(_queueGauge == nil && self.state == BOXAPIOperationStateReady, @"The queue gauge is set once, before the operation starts");
+    _queueGauge = queueGauge;
+    [queueGauge operationEnqueued];
 }
 
 #pragma mark - Accessors
@@ -162,6 +195,24 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
     return self.APIRequest.HTTPMethod;
 }
 
+- (void)setCancellationContext:(BOXCancellationContext *)cancellationContext
+{
+    BOXCancellationContext *previousContext = nil;
+    @synchronized(self) {
+        previousContext = _cancellationContext;
+        _cancellationContext = cancellationContext;
+    }
+    [previousContext removeCancellable:self];
+    [cancellationContext addCancellable:self];
+}
+
+- (BOXCancellationContext *)cancellationContext
+{
+    @synchronized(self) {
+        return _cancellationContext;
+    }
+}
+
 #pragma mark - Build NSURLRequest
 - (NSData *)encodeBody:(NSDictionary *)bodyDictionary
 {
@@ -175,31 +226,27 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
         return baseURL;
     }
 
-    NSMutableArray *queryParts = [NSMutableArray array];
-    for (id key in queryDictionary)
-    {
-        id value = [queryDictionary objectForKey:key];
-        NSString *keyString = BOXPercentEscapedStringFromString([key description]);
-        NSString *valueString = BOXPercentEscapedStringFromString([value description]);
-
-        [queryParts addObject:[NSString stringWithFormat:@"%@=%@", keyString, valueString]];
-    }
-    NSString *queryString = [queryParts componentsJoinedByString:@"&"];
+    // Built in a single buffer, as this runs for every request.
     NSString *existingURLString = [baseURL absoluteString];
+    NSMutableString *urlString = [NSMutableString stringWithCapacity:existingURLString.length + queryDictionary.count * 32];
+    [urlString appendString:existingURLString];
 
-    NSRange startOfQueryString = [existingURLString rangeOfString:@"?"];
-    NSString *joinString = nil;
+    BOOL hasQueryString = [existingURLString rangeOfString:@"?"].location != NSNotFound;
+    [urlString appendString:(hasQueryString ? @"&" : @"?")];
 
-    if (startOfQueryString.location == NSNotFound)
-    {
-        joinString = @"?";
-    }
-    else
+    BOOL isFirstPart = YES;
+    for (id key in queryDictionary)
     {
-        joinString = @"&";
-    }
+        id value = [queryDictionary objectForKey:key];
+        if (!isFirstPart) {
+            [urlString appendString:@"&"];
+        }
+        isFirstPart = NO;
 
-    NSString *urlString = [[existingURLString stringByAppendingString:joinString] stringByAppendingString:queryString];
+        [urlString appendString:BOXPercentEscapedStringFromString([key description])];
+        [urlString appendString:@"="];
+        [urlString appendString:BOXPercentEscapedStringFromString([value description])];
+    }
 
     return [NSURL URLWithString:urlString];
 }
@@ -210,19 +257,30 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
     BOXAbstract();
 }
 
+// Does not lock the session: the tokens are read from a single snapshot, and the rest of the preparation only
+// touches this operation.
+- (void)prepareAPIRequestWithSessionTokens
+{
+    BOXSessionTokenSnapshot *tokenSnapshot = self.session.tokenSnapshot;
+    self.tokenSnapshot = tokenSnapshot;
+    [self prepareAPIRequest];
+    // The loading system must not keep waiting on the server after the request is no longer wanted.
+    NSTimeInterval remainingTime = [self.cancellationContext remainingTime];
+    if (self.cancellationContext.deadline != nil && remainingTime < self.APIRequest.timeoutInterval) {
+        self.APIRequest.timeoutInterval = MAX(remainingTime, 1.0);
+    }
+    if (![self isKindOfClass:[BOXAPIOAuth2ToJSONOperation class]]) {
+        self.accessToken = tokenSnapshot.accessToken;
+    }
+}
+
 - (void)prepareOperation
 {
     if (![self isCancelled]) {
         if (self.sessionTask == nil) {
-            @synchronized(self.session)
-            {
-                //Note: if sessionTask exists, we cannot change its API request
-                //make sure you recreate sessionTask with the new API request if needed
-                [self prepareAPIRequest];
-                if (![self isKindOfClass:[BOXAPIOAuth2ToJSONOperation class]]) {
-                    self.accessToken = self.session.accessToken;
-                }
-            }
+            //Note: if sessionTask exists, we cannot change its API request
+            //make sure you recreate sessionTask with the new API request if needed
+            [self prepareAPIRequestWithSessionTokens];
             NSError *error = nil;
             self.sessionTask = [self createSessionTaskWithError:&error];
             if (error != nil) {
@@ -305,6 +363,7 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
         // BOXAPIQueueManagers check to ensure that operations are not executing when
         // they grab the lock and are adding dependencies.
         self.state = BOXAPIOperationStateExecuting;
+        BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationStarted, self.traceID, 0, 0, 0);
 
         [self performSelector:@selector(executeOperation) onThread:[[self class] globalAPIOperationNetworkThread] withObject:nil waitUntilDone:NO];
     }
@@ -320,6 +379,7 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
 {
     __weak BOXAPIOperation *weakSelf = self;
     NSURLSessionTask *sessionTask = [self.session.urlSessionManager dataTaskWithRequest:self.APIRequest
+                                                     taskDelegate:self
                                                 completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
                                                     [weakSelf finishURLSessionTaskWithData:data response:response error:error];
                                                 }];
@@ -358,24 +418,25 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
             [self finish];
         }
     } else {
+        self.sessionTaskStartTime = CFAbsoluteTimeGetCurrent();
         [self.sessionTask resume];
     }
 }
 
 - (void)executeOperation
 {
-    BOXLog(@"BOXAPIOperation %@ was started", self);
-    if (![self isCancelled]) {
+    BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationExecuting, self.traceID, 0, 0, 0);
+    NSError *contextError = [self.cancellationContext error];
+    if (contextError != nil) {
+        // Abandoned or late: fail right away rather than spend bandwidth on an answer nobody waits for.
+        BOXTrace(BOXTraceLevelInfo, BOXTraceEventOperationShortCircuited, self.traceID, 0, 0, 0);
+        self.error = contextError;
+        [self finish];
+    } else if (![self isCancelled]) {
         if (self.sessionTask == nil) {
-            @synchronized(self.session)
-            {
-                //Note: if sessionTask exists, we cannot change its API request
-                //make sure you recreate sessionTask with the new API request if needed
-                [self prepareAPIRequest];
-                if (![self isKindOfClass:[BOXAPIOAuth2ToJSONOperation class]]) {
-                    self.accessToken = self.session.accessToken;
-                }
-            }
+            //Note: if sessionTask exists, we cannot change its API request
+            //make sure you recreate sessionTask with the new API request if needed
+            [self prepareAPIRequestWithSessionTokens];
         }
 
         if (self.error == nil && ![self isCancelled]) {
@@ -386,7 +447,7 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
             if (error == nil) {
                 [self executeSessionTask];
             } else {
-                BOXLog(@"BOXAPIOperation %@ failed to create session task to execute API request", self);
+                BOXTrace(BOXTraceLevelWarning, BOXTraceEventOperationSessionTaskFailed, self.traceID, error.code, 0, 0);
                 NSMutableDictionary *userInfo = [NSMutableDictionary dictionary];
                 [userInfo setObject:error forKey:NSUnderlyingErrorKey];
                 self.error = [NSError errorWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKURLSessionFailToCreateSessionTask userInfo:userInfo];
@@ -401,7 +462,7 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
             [self finish];
         }
     } else {
-        BOXLog(@"BOXAPIOperation %@ was cancelled -- short circuiting and not making API call", self);
+        BOXTrace(BOXTraceLevelInfo, BOXTraceEventOperationShortCircuited, self.traceID, 0, 0, 0);
         self.error = [NSError errorWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
         [self finish];
     }
@@ -411,12 +472,12 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
 {
     [self performSelector:@selector(cancelSessionTask) onThread:[[self class] globalAPIOperationNetworkThread] withObject:nil waitUntilDone:NO];
     [super cancel];
-    BOXLog(@"BOXAPIOperation %@ was cancelled", self);
+    BOXTrace(BOXTraceLevelInfo, BOXTraceEventOperationCancelled, self.traceID, 0, 0, 0);
 }
 
 - (void)cancelSessionTask
 {
-    self.error = [NSError errorWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
+    self.error = [self.cancellationContext error] ?: [NSError errorWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
     if (self.sessionTask != nil) {
         if ([self shouldAllowResume] == YES && [self.sessionTask isKindOfClass:[NSURLSessionDownloadTask class]] == YES) {
             //if session task is a background download and it was cancelled with intention to resume,
@@ -450,7 +511,10 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
     if ([self shouldErrorTriggerLogout:self.error]) {
         [self sendLogoutNotification];
     }
+    [self recordMetrics];
+    [self traceFinish];
     [self performCompletionCallback];
+    [self.memoryAccount removeAllBytes];
 
     NSString *userId = self.session.user.modelID;
     NSError *error = nil;
@@ -462,7 +526,6 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
     }
     self.sessionTask = nil;
     self.state = BOXAPIOperationStateFinished;
-    BOXLog(@"BOXAPIOperation %@ finished with state %d", self, self.state);
 }
 
 
@@ -596,7 +659,14 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
         [self processResponse:response];
     }
 
-    if (data != nil) {
+    if (data != nil && data != self.responseData) {
+        // Data handed over whole by the session task was not counted as it arrived.
+        [self accountBytes:data.length ofKind:BOXTransferBufferKindResponseData];
+    }
+
+    if (data != nil && [self.error.domain isEqualToString:BOXContentSDKErrorDomain] && self.error.code == BOXContentSDKStreamErrorMemoryLimitExceeded) {
+        // Do not parse a body that put the operation over a memory limit.
+    } else if (data != nil) {
         // If the data object is nil, ignore it. Otherwise we need to process the data.
         [self processResponseData:data];
     }
@@ -632,12 +702,116 @@ static BOOL BoxOperationStateTransitionIsValid(BOXAPIOperationState fromState, B
 - (void)sessionTask:(NSURLSessionTask *)sessionTask processIntermediateData:(NSData *)data
 {
     @synchronized (self) {
-        if (data != nil) {
+        if (data != nil && self.error == nil) {
             [self.responseData appendData:data];
+            [self accountBytes:data.length ofKind:BOXTransferBufferKindResponseData];
+        }
+    }
+}
+
+- (void)sessionTask:(NSURLSessionTask *)sessionTask didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics API_AVAILABLE(ios(10.0))
+{
+    // Body byte counts are only reported from iOS 13 on. countOfBytesReceived of the task is counted after
+    // decoding, so there is nothing to compare against before that.
+    if (@available(iOS 13.0, *)) {
+        unsigned long long responseBodyBytesReceived = 0;
+        unsigned long long decodedResponseBodyBytes = 0;
+        for (NSURLSessionTaskTransactionMetrics *transactionMetrics in metrics.transactionMetrics) {
+            responseBodyBytesReceived += (unsigned long long)MAX(transactionMetrics.countOfResponseBodyBytesReceived, 0);
+            decodedResponseBodyBytes += (unsigned long long)MAX(transactionMetrics.countOfResponseBodyBytesAfterDecoding, 0);
+        }
+
+        @synchronized (self) {
+            self.responseBodyBytesReceived = responseBodyBytesReceived;
+            self.decodedResponseBodyBytes = decodedResponseBodyBytes;
+        }
+    }
+}
+
+#pragma mark - Metrics
+
+- (void)recordMetrics
+{
+    BOXMetricsRegistry *registry = [BOXMetricsRegistry sharedRegistry];
+    if (self.sessionTaskStartTime == 0 || registry.enabled == NO) {
+        return;
+    }
+
+    BOOL retried = [self isKindOfClass:[BOXAPIAuthenticatedOperation class]] && ((BOXAPIAuthenticatedOperation *)self).timesReenqueued > 0;
+    unsigned long long bytesSent = (unsigned long long)MAX(self.sessionTask.countOfBytesSent, 0);
+    unsigned long long bytesReceived = (unsigned long long)MAX(self.sessionTask.countOfBytesReceived, 0);
+    unsigned long long uncompressedBytesSent = self.uncompressedRequestBodyLength > 0 ? self.uncompressedRequestBodyLength : bytesSent;
+    unsigned long long responseBodyBytesReceived = 0;
+    unsigned long long decodedResponseBodyBytes = 0;
+    @synchronized (self) {
+        responseBodyBytesReceived = self.responseBodyBytesReceived;
+        decodedResponseBodyBytes = self.decodedResponseBodyBytes;
+        self.responseBodyBytesReceived = 0;
+        self.decodedResponseBodyBytes = 0;
+    }
+    [registry recordRequestInFamily:[BOXMetricsRegistry resourceFamilyForURL:self.baseRequestURL]
+                         statusCode:self.HTTPResponse.statusCode
+                             failed:(self.error != nil)
+                            latency:CFAbsoluteTimeGetCurrent() - self.sessionTaskStartTime
+                          bytesSent:bytesSent
+              uncompressedBytesSent:uncompressedBytesSent
+                      bytesReceived:bytesReceived
+          responseBodyBytesReceived:responseBodyBytesReceived
+           decodedResponseBodyBytes:decodedResponseBodyBytes
+                            retried:retried];
+    self.sessionTaskStartTime = 0;
+}
+
+#pragma mark - Trace
+
+- (void)traceFinish
+{
+    NSError *error = self.error;
+    BOXTraceErrorDomain domain = BOXTraceErrorDomainNone;
+    if ([error.domain isEqualToString:BOXContentSDKErrorDomain]) {
+        domain = BOXTraceErrorDomainContentSDK;
+    } else if ([error.domain isEqualToString:NSURLErrorDomain]) {
+        domain = BOXTraceErrorDomainURL;
+    } else if (error != nil) {
+        domain = BOXTraceErrorDomainOther;
+    }
+    // Cancellations and operations about to be re-enqueued are not failures.
+    BOOL expected = (domain == BOXTraceErrorDomainContentSDK &&
+                     (error.code == BOXContentSDKAPIUserCancelledError ||
+                      error.code == BOXContentSDKAPIDeadlineExceededError ||
+                      error.code == BOXContentSDKAuthErrorAccessTokenExpiredOperationWillBeClonedAndReenqueued ||
+                      error.code == BOXContentSDKAPIErrorAccepted));
+    BOXTraceLevel level = (error == nil) ? BOXTraceLevelDebug : (expected ? BOXTraceLevelInfo : BOXTraceLevelError);
+    BOXTrace(level, BOXTraceEventOperationFinished, self.traceID, self.HTTPResponse.statusCode, error.code, domain);
+
+    if (level == BOXTraceLevelError) {
+        BOXTraceFailureHandler failureHandler = [BOXTraceLog failureHandler];
+        if (failureHandler) {
+            failureHandler(self.traceID, error, [BOXTraceLog dumpForOperationID:self.traceID]);
         }
     }
 }
 
+#pragma mark - Memory accounting
+
+- (BOOL)accountBytes:(unsigned long long)bytes ofKind:(BOXTransferBufferKind)kind
+{
+    if ([self.memoryAccount addBytes:bytes ofKind:kind] == NO) {
+        [self failWithMemoryLimitExceeded];
+        return NO;
+    }
+    return YES;
+}
+
+- (void)failWithMemoryLimitExceeded
+{
+    BOXTrace(BOXTraceLevelWarning, BOXTraceEventOperationMemoryLimitExceeded, self.traceID, self.memoryAccount.currentBytes, 0, 0);
+    if (self.error == nil) {
+        self.error = [NSError errorWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKStreamErrorMemoryLimitExceeded userInfo:nil];
+    }
+    [self.sessionTask cancel];
+}
+
 #pragma mark - Lock
 + (NSRecursiveLock *)APIOperationGlobalLock
 {
@@ -7,6 +7,10 @@
 //
 
 #import "BOXAPIOperation.h"
+#import "BOXTransferMemoryMonitor.h"
+#import "BOXSessionTokenSnapshot.h"
+
+@class BOXQueueGauge;
 
 typedef NS_ENUM(NSUInteger, BOXAPIOperationState) {
     BOXAPIOperationStateReady = 1,
@@ -21,6 +25,23 @@ typedef NS_ENUM(NSUInteger, BOXAPIOperationState) {
 
 @property (nonatomic, readwrite, strong) NSURLSessionTask *sessionTask;
 
+/**
+ * The session's token snapshot the API request was prepared with. Read once, so that the Authorization header and
+ * accessToken always agree, even if the session's tokens change meanwhile.
+ */
+@property (nonatomic, readwrite, strong) BOXSessionTokenSnapshot *tokenSnapshot;
+
+/**
+ * Length of the request body before it was compressed, 0 if it was sent as is. Reported to BOXMetricsRegistry.
+ */
+@property (nonatomic, readwrite, assign) unsigned long long uncompressedRequestBodyLength;
+
+/**
+ * Gauge of the queue the operation was added to, which it updates as it starts and finishes. Set by the queue
+ * manager right before adding the operation to its queue; setting it counts the operation as waiting.
+ */
+@property (nonatomic, readwrite, strong) BOXQueueGauge *queueGauge;
+
 #pragma mark initializers
 - (instancetype)initWithSession:(BOXAbstractSession *)session;
 
@@ -52,4 +73,17 @@ typedef NS_ENUM(NSUInteger, BOXAPIOperationState) {
  */
 - (BOOL)shouldAllowResume;
 
+/**
+ * Counts bytes the operation now holds in memory and fails it with BOXContentSDKStreamErrorMemoryLimitExceeded
+ * if that puts it over a limit of BOXTransferMemoryMonitor. For buffers that cannot apply backpressure.
+ *
+ * @return NO if the operation was failed.
+ */
+- (BOOL)accountBytes:(unsigned long long)bytes ofKind:(BOXTransferBufferKind)kind;
+
+/**
+ * Fails the operation with BOXContentSDKStreamErrorMemoryLimitExceeded and cancels its session task.
+ */
+- (void)failWithMemoryLimitExceeded;
+
 @end
@@ -196,6 +196,9 @@
         // may not have space available for writing
         [self.receivedDataBuffer appendData:data];
         self.bytesReceived += data.length;
+        if ([self accountBytes:data.length ofKind:BOXTransferBufferKindStreamBuffer] == NO) {
+            return;
+        }
         BOXLog(@"Bytes received: %lu", (unsigned long)data.length);
         if (self.progressBlock && data.length > 0) {
             self.progressBlock(data, self.contentLength);
@@ -217,6 +220,10 @@
 {
     // Delay grows each time the request is re-enqueued.
     double delay = MIN(pow((1 + REENQUE_BASE_DELAY), self.timesReenqueued) - 1, MAX_REENQUE_DELAY);
+    // Past the deadline, the copy fails as soon as it is enqueued; there is no point in waiting for it.
+    if (self.cancellationContext != nil) {
+        delay = MIN(delay, [self.cancellationContext remainingTime]);
+    }
     return delay;
 }
 
@@ -232,6 +239,7 @@
                                                                                    queryParams:queryStringParametersCopy
                                                                                        session:self.session];
     operationCopy.timesReenqueued = self.timesReenqueued;
+    operationCopy.cancellationContext = self.cancellationContext;
     operationCopy.successBlock = [self.successBlock copy];
     operationCopy.failureBlock = [self.failureBlock copy];
     operationCopy.progressBlock = [self.progressBlock copy];
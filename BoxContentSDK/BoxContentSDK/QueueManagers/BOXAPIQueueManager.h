@@ -49,6 +49,18 @@
  */
 @property (nonatomic, readwrite, strong) NSMutableSet *enqueuedAuthOperations;
 
+/**
+ * An immutable copy of enqueuedAuthOperations, published after every change to it. Enqueueing a non-Auth
+ * operation reads it without locking the session.
+ */
+@property (atomic, readonly, copy) NSSet *pendingAuthOperations;
+
+/**
+ * Serializes publishing an Auth operation and making the enqueued operations depend on it against adding a non-Auth
+ * operation to its queue. Unlike session, it is only held for as long as it takes to add dependencies.
+ */
+@property (nonatomic, readonly, strong) NSObject *authDependencyLock;
+
 @property (nonatomic, readwrite, weak) id<BOXAPIAccessTokenDelegate> delegate;
 
 /** @name Initializers */
@@ -66,7 +78,7 @@
  * BOXAPIOAuth2ToJSONOperation/BOXAPIAppAuthOperation instance. Subclasses should enqueue operations received via this
  * method on an NSOperationQueue to be executed.
  *
- * This method synchronizes on session.
+ * Only the enqueueing of BOXAPIOAuth2ToJSONOperation/BOXAPIAppAuthOperation instances synchronizes on session.
  *
  * @param operation The BOXAPIOperation to be enqueued for execution
  */
@@ -84,6 +96,31 @@
  */
 - (BOOL)addDependency:(NSOperation *)dependency toOperation:(NSOperation *)operation;
 
+/**
+ * Must be called within @synchronized(session), after each change to enqueuedAuthOperations.
+ */
+- (void)publishPendingAuthOperations;
+
+/**
+ * Makes a non-Auth operation depend on the pending Auth operations and adds it to queue, within
+ * @synchronized(authDependencyLock). Subclasses publish an Auth operation and add it as a dependency of the enqueued
+ * operations within the same lock, so every operation either is found in its queue or finds the Auth operation
+ * pending, before it can start.
+ *
+ * @param operation The non-Auth operation being enqueued.
+ * @param queue The queue to add the operation to.
+ */
+- (void)addOperation:(NSOperation *)operation toQueueAfterPendingAuthOperations:(NSOperationQueue *)queue;
+
+/**
+ * Adds an operation to queue, counting it in the BOXMetricsRegistry gauge of the queue. Every operation is added to
+ * its queue through this method.
+ *
+ * @param operation The operation being enqueued.
+ * @param queue The queue to add the operation to.
+ */
+- (void)addOperation:(NSOperation *)operation toQueue:(NSOperationQueue *)queue;
+
 - (void)cancelAllOperations;
 
 @end
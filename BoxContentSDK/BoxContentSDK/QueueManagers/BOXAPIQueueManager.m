@@ -8,11 +8,13 @@
 
 #import "BOXAPIQueueManager.h"
 
-#import "BOXAPIOperation.h"
+#import "BOXAPIOperation_Private.h"
 #import "BOXAPIOAuth2ToJSONOperation.h"
 #import "BOXAPIAppUsersAuthOperation.h"
 #import "BOXLog.h"
+#import "BOXTraceLog.h"
 #import "BOXAppUserSession.h"
+#import "BOXMetricsRegistry.h"
 
 /**
  * This internal extension provides a notification callback for completed
@@ -37,12 +39,16 @@
  */
 - (void)AuthOperationDidComplete:(NSNotification *)notification;
 
+@property (atomic, readwrite, copy) NSSet *pendingAuthOperations;
+
 @end
 
 @implementation BOXAPIQueueManager
 
 @synthesize session = _session;
 @synthesize enqueuedAuthOperations = _enqueuedAuthOperations;
+@synthesize pendingAuthOperations = _pendingAuthOperations;
+@synthesize authDependencyLock = _authDependencyLock;
 
 - (id)initWithSession:(BOXAbstractSession *)session
 {
@@ -51,6 +57,8 @@
     {
         _session = session;
         _enqueuedAuthOperations = [NSMutableSet set];
+        _pendingAuthOperations = [NSSet set];
+        _authDependencyLock = [[NSObject alloc] init];
     }
 
     return self;
@@ -78,8 +86,9 @@
     @synchronized(self.session)
     {
         BOXAPIOperation *operation = (BOXAPIOperation *)notification.object;
-        BOXLog(@"%@ completed. Removing from set of Auth dependencies", operation);
+        BOXTrace(BOXTraceLevelDebug, BOXTraceEventAuthOperationCompleted, operation.traceID, 0, 0, 0);
         [self.enqueuedAuthOperations removeObject:operation];
+        [self publishPendingAuthOperations];
         [[NSNotificationCenter defaultCenter] removeObserver:self name:BOXAuthOperationDidCompleteNotification object:operation];
     }
 }
@@ -106,6 +115,34 @@
     return dependencyAdded;
 }
 
+- (void)publishPendingAuthOperations
+{
+    self.pendingAuthOperations = self.enqueuedAuthOperations;
+}
+
+- (void)addOperation:(NSOperation *)operation toQueueAfterPendingAuthOperations:(NSOperationQueue *)queue
+{
+    @synchronized(self.authDependencyLock)
+    {
+        for (NSOperation *pendingAuthOperation in self.pendingAuthOperations)
+        {
+            if (![operation.dependencies containsObject:pendingAuthOperation])
+            {
+                [self addDependency:pendingAuthOperation toOperation:operation];
+            }
+        }
+        [self addOperation:operation toQueue:queue];
+    }
+}
+
+- (void)addOperation:(NSOperation *)operation toQueue:(NSOperationQueue *)queue
+{
+    if ([operation isKindOfClass:[BOXAPIOperation class]]) {
+        ((BOXAPIOperation *)operation).queueGauge = [[BOXMetricsRegistry sharedRegistry] gaugeForQueueNamed:queue.name];
+    }
+    [queue addOperation:operation];
+}
+
 - (void)cancelAllOperations
 {
     for (BOXAPIOperation *operation in self.enqueuedAuthOperations) {
@@ -0,0 +1,92 @@
+//
+//  BOXAPIScheduler.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+#define BOX_API_SCHEDULER_DEFAULT_MAX_CONCURRENT_REQUESTS (8)
+#define BOX_API_SCHEDULER_DEFAULT_MAX_CONCURRENT_TRANSFERS (4)
+
+typedef NS_ENUM(NSUInteger, BOXAPISchedulerLane) {
+    /** API calls, small downloads such as thumbnails, and small uploads. */
+    BOXAPISchedulerLaneRequests = 0,
+    /** Downloads and uploads. */
+    BOXAPISchedulerLaneTransfers,
+};
+
+/**
+ * BOXAPIScheduler decides when the operations of several accounts may run, so that the accounts of a process share
+ * its concurrency fairly.
+ *
+ * Queue managers using a scheduler hand it their operations instead of adding them to their NSOperationQueues. The
+ * scheduler keeps each account's operations in FIFO order and, whenever a lane has a free slot, dispatches the next
+ * operation of the next account in round-robin order that has one waiting and is within its rate limit. Dispatching
+ * adds the operation to the queue manager's own NSOperationQueue, so each account keeps its own authentication
+ * gating. An operation is only dispatched while its queue has room to start it, so that slots of a lane are not
+ * held by operations waiting in a narrower queue.
+ *
+ * A slot is taken when the operation is dispatched and released when it finishes. Operations cancelled while they
+ * wait are dispatched right away, without taking a slot or counting against the rate limit.
+ *
+ * All scheduling happens on a private serial queue: operations are dispatched asynchronously, never on the thread
+ * that enqueues them.
+ */
+@interface BOXAPIScheduler : NSObject
+
+/**
+ * The scheduler shared by the clients created after [BOXContentClient setSharedAPISchedulerEnabled:YES].
+ */
++ (instancetype)sharedScheduler;
+
+/**
+ * Operations of every account running at once in the requests lane.
+ * Defaults to BOX_API_SCHEDULER_DEFAULT_MAX_CONCURRENT_REQUESTS.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentRequests;
+
+/**
+ * Operations of every account running at once in the transfers lane.
+ * Defaults to BOX_API_SCHEDULER_DEFAULT_MAX_CONCURRENT_TRANSFERS.
+ */
+@property (nonatomic, readwrite, assign) NSUInteger maxConcurrentTransfers;
+
+/**
+ * Operations dispatched per second for each account, across lanes, in bursts of up to one second's worth.
+ * 0, the default, does not limit the rate.
+ */
+@property (nonatomic, readwrite, assign) double maxOperationsPerSecondPerAccount;
+
+/**
+ * Queues operation for account in lane. dispatchBlock is called, on the scheduler's queue, when the operation may
+ * run, and must add it to queue. The slot it takes is released when the operation finishes.
+ *
+ * @param operation The operation to schedule.
+ * @param account The object operations are grouped by for fairness, typically a queue manager. Not retained.
+ * @param lane The lane whose concurrency the operation counts against.
+ * @param queue The queue the operation runs on. No more of its operations are dispatched at once than it runs.
+ * @param dispatchBlock Adds the operation to queue.
+ */
+- (void)scheduleOperation:(NSOperation *)operation
+               forAccount:(id)account
+                   inLane:(BOXAPISchedulerLane)lane
+                    queue:(NSOperationQueue *)queue
+            dispatchBlock:(void (^)(NSOperation *operation))dispatchBlock;
+
+/**
+ * Holds back the waiting operations of account, e.g. while its access token is refreshed, or lets them be dispatched
+ * again. Operations already dispatched are not affected.
+ */
+- (void)setOperationsHeld:(BOOL)held forAccount:(id)account;
+
+/**
+ * Operations dispatched and not finished yet in lane.
+ */
+- (NSUInteger)runningOperationCountInLane:(BOXAPISchedulerLane)lane;
+
+/**
+ * Operations waiting to be dispatched in lane, for every account.
+ */
+- (NSUInteger)pendingOperationCountInLane:(BOXAPISchedulerLane)lane;
+
+@end
@@ -0,0 +1,429 @@
+//
+//  BOXAPIScheduler.m
+//  BoxContentSDK
+//
+
+#import "BOXAPIScheduler.h"
+
+#define BOX_API_SCHEDULER_LANE_COUNT (2)
+
+static void *BOXAPISchedulerPendingOperationContext = &BOXAPISchedulerPendingOperationContext;
+static void *BOXAPISchedulerRunningOperationContext = &BOXAPISchedulerRunningOperationContext;
+
+@interface BOXAPISchedulerEntry : NSObject
+
+@property (nonatomic, readwrite, strong) NSOperation *operation;
+@property (nonatomic, readwrite, assign) BOXAPISchedulerLane lane;
+@property (nonatomic, readwrite, strong) NSOperationQueue *queue;
+@property (nonatomic, readwrite, copy) void (^dispatchBlock)(NSOperation *operation);
+
+@end
+
+@implementation BOXAPISchedulerEntry
+@end
+
+/**
+ * The operations of one account waiting to be dispatched, and its rate limiting state.
+ */
+@interface BOXAPISchedulerAccount : NSObject
+
+@property (nonatomic, readwrite, weak) id account;
+@property (nonatomic, readwrite, strong) NSArray *pendingEntriesByLane;
+@property (nonatomic, readwrite, assign) double tokens;
+@property (nonatomic, readwrite, assign) CFAbsoluteTime lastRefillTime;
+@property (nonatomic, readwrite, assign) BOOL held;
+
+@end
+
+@implementation BOXAPISchedulerAccount
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _pendingEntriesByLane = @[[NSMutableArray array], [NSMutableArray array]];
+        _tokens = -1;
+    }
+    return self;
+}
+
+- (NSMutableArray *)pendingEntriesInLane:(BOXAPISchedulerLane)lane
+{
+    return self.pendingEntriesByLane[lane];
+}
+
+- (BOOL)hasPendingEntries
+{
+    for (NSArray *entries in self.pendingEntriesByLane) {
+        if (entries.count > 0) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (void)refillTokensAtTime:(CFAbsoluteTime)time rate:(double)rate
+{
+    double burst = MAX(1.0, rate);
+    if (self.tokens < 0) {
+        self.tokens = burst;
+    } else {
+        self.tokens = MIN(burst, self.tokens + (time - self.lastRefillTime) * rate);
+    }
+    self.lastRefillTime = time;
+}
+
+- (BOOL)takeTokenAtTime:(CFAbsoluteTime)time rate:(double)rate
+{
+    if (rate <= 0) {
+        return YES;
+    }
+    [self refillTokensAtTime:time rate:rate];
+    if (self.tokens >= 1.0) {
+        self.tokens -= 1.0;
+        return YES;
+    }
+    return NO;
+}
+
+@end
+
+@interface BOXAPIScheduler ()
+
+// Everything below is only accessed on schedulerQueue.
+@property (nonatomic, readwrite, strong) dispatch_queue_t schedulerQueue;
+@property (nonatomic, readwrite, strong) NSMapTable *accountsByAccount;
+// Accounts in round-robin order.
+@property (nonatomic, readwrite, strong) NSMutableArray *accounts;
+@property (nonatomic, readwrite, assign) BOOL retryScheduled;
+// Entries of the operations dispatched and not finished yet, by operation.
+@property (nonatomic, readwrite, strong) NSMapTable *runningEntriesByOperation;
+// Number of running operations added to each queue, by queue.
+@property (nonatomic, readwrite, strong) NSMapTable *runningCountsByQueue;
+
+@end
+
+@implementation BOXAPIScheduler
+{
+    NSUInteger _runningCounts[BOX_API_SCHEDULER_LANE_COUNT];
+    NSUInteger _nextAccountIndexes[BOX_API_SCHEDULER_LANE_COUNT];
+}
+
++ (instancetype)sharedScheduler
+{
+    static BOXAPIScheduler *sharedScheduler = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedScheduler = [[self alloc] init];
+    });
+    return sharedScheduler;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _maxConcurrentRequests = BOX_API_SCHEDULER_DEFAULT_MAX_CONCURRENT_REQUESTS;
+        _maxConcurrentTransfers = BOX_API_SCHEDULER_DEFAULT_MAX_CONCURRENT_TRANSFERS;
+        _schedulerQueue = dispatch_queue_create("com.box.contentsdk.apischeduler", DISPATCH_QUEUE_SERIAL);
+        _accountsByAccount = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsWeakMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                   valueOptions:NSPointerFunctionsStrongMemory];
+        _accounts = [NSMutableArray array];
+        _runningEntriesByOperation = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                           valueOptions:NSPointerFunctionsStrongMemory];
+        _runningCountsByQueue = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality)
+                                                      valueOptions:NSPointerFunctionsStrongMemory];
+    }
+    return self;
+}
+
+- (void)dealloc
+{
+    for (BOXAPISchedulerAccount *schedulerAccount in _accounts) {
+        for (NSArray *entries in schedulerAccount.pendingEntriesByLane) {
+            for (BOXAPISchedulerEntry *entry in entries) {
+                [entry.operation removeObserver:self forKeyPath:@"isCancelled" context:BOXAPISchedulerPendingOperationContext];
+            }
+        }
+    }
+    for (NSOperation *operation in _runningEntriesByOperation) {
+        [operation removeObserver:self forKeyPath:@"isFinished" context:BOXAPISchedulerRunningOperationContext];
+    }
+}
+
+- (NSUInteger)maxConcurrentRequests
+{
+    @synchronized(self) {
+        return _maxConcurrentRequests;
+    }
+}
+
+- (void)setMaxConcurrentRequests:(NSUInteger)maxConcurrentRequests
+{
+    @synchronized(self) {
+        _maxConcurrentRequests = maxConcurrentRequests;
+    }
+    [self dispatchOperationsAsynchronously];
+}
+
+- (NSUInteger)maxConcurrentTransfers
+{
+    @synchronized(self) {
+        return _maxConcurrentTransfers;
+    }
+}
+
+- (void)setMaxConcurrentTransfers:(NSUInteger)maxConcurrentTransfers
+{
+    @synchronized(self) {
+        _maxConcurrentTransfers = maxConcurrentTransfers;
+    }
+    [self dispatchOperationsAsynchronously];
+}
+
+- (double)maxOperationsPerSecondPerAccount
+{
+    @synchronized(self) {
+        return _maxOperationsPerSecondPerAccount;
+    }
+}
+
+- (void)setMaxOperationsPerSecondPerAccount:(double)maxOperationsPerSecondPerAccount
+{
+    @synchronized(self) {
+        _maxOperationsPerSecondPerAccount = maxOperationsPerSecondPerAccount;
+    }
+    [self dispatchOperationsAsynchronously];
+}
+
+#pragma mark - Scheduling
+
+- (void)scheduleOperation:(NSOperation *)operation
+               forAccount:(id)account
+                   inLane:(BOXAPISchedulerLane)lane
+                    queue:(NSOperationQueue *)queue
+            dispatchBlock:(void (^)(NSOperation *operation))dispatchBlock
+{
+    BOXAPISchedulerEntry *entry = [[BOXAPISchedulerEntry alloc] init];
+    entry.operation = operation;
+    entry.lane = lane;
+    entry.queue = queue;
+    entry.dispatchBlock = dispatchBlock;
+
+    dispatch_async(self.schedulerQueue, ^{
+        BOXAPISchedulerAccount *schedulerAccount = [self schedulerAccountForAccount:account];
+        // Operations cancelled while they wait are dispatched right away, without taking a slot, so that they finish.
+        [operation addObserver:self forKeyPath:@"isCancelled" options:0 context:BOXAPISchedulerPendingOperationContext];
+        [[schedulerAccount pendingEntriesInLane:lane] addObject:entry];
+        [self dispatchOperations];
+    });
+}
+
+- (void)setOperationsHeld:(BOOL)held forAccount:(id)account
+{
+    dispatch_async(self.schedulerQueue, ^{
+        [self schedulerAccountForAccount:account].held = held;
+        if (!held) {
+            [self dispatchOperations];
+        }
+    });
+}
+
+// Must be called on schedulerQueue.
+- (BOXAPISchedulerAccount *)schedulerAccountForAccount:(id)account
+{
+    BOXAPISchedulerAccount *schedulerAccount = [self.accountsByAccount objectForKey:account];
+    if (schedulerAccount == nil) {
+        schedulerAccount = [[BOXAPISchedulerAccount alloc] init];
+        schedulerAccount.account = account;
+        [self.accountsByAccount setObject:schedulerAccount forKey:account];
+        [self.accounts addObject:schedulerAccount];
+    }
+    return schedulerAccount;
+}
+
+- (void)dispatchOperationsAsynchronously
+{
+    dispatch_async(self.schedulerQueue, ^{
+        [self dispatchOperations];
+    });
+}
+
+// Must be called on schedulerQueue.
+- (void)dispatchOperations
+{
+    CFAbsoluteTime now = CFAbsoluteTimeGetCurrent();
+    double rate = self.maxOperationsPerSecondPerAccount;
+
+    [self dispatchCancelledOperations];
+    [self dispatchOperationsInLane:BOXAPISchedulerLaneRequests maxCount:MAX(1, self.maxConcurrentRequests) time:now rate:rate];
+    [self dispatchOperationsInLane:BOXAPISchedulerLaneTransfers maxCount:MAX(1, self.maxConcurrentTransfers) time:now rate:rate];
+
+    // Forget accounts that went away with nothing left to dispatch.
+    NSIndexSet *goneIndexes = [self.accounts indexesOfObjectsPassingTest:^BOOL(BOXAPISchedulerAccount *schedulerAccount, NSUInteger index, BOOL *stop) {
+        return schedulerAccount.account == nil && ![schedulerAccount hasPendingEntries];
+    }];
+    if (goneIndexes.count > 0) {
+        [self.accounts removeObjectsAtIndexes:goneIndexes];
+        for (NSUInteger lane = 0; lane < BOX_API_SCHEDULER_LANE_COUNT; lane++) {
+            _nextAccountIndexes[lane] = 0;
+        }
+    }
+
+    [self scheduleRetryForRateLimitedAccountsAtTime:now rate:rate];
+}
+
+- (void)dispatchCancelledOperations
+{
+    for (BOXAPISchedulerAccount *schedulerAccount in self.accounts) {
+        for (NSMutableArray *pendingEntries in schedulerAccount.pendingEntriesByLane) {
+            NSIndexSet *cancelledIndexes = [pendingEntries indexesOfObjectsPassingTest:^BOOL(BOXAPISchedulerEntry *entry, NSUInteger index, BOOL *stop) {
+                return entry.operation.isCancelled;
+            }];
+            if (cancelledIndexes.count == 0) {
+                continue;
+            }
+            NSArray *cancelledEntries = [pendingEntries objectsAtIndexes:cancelledIndexes];
+            [pendingEntries removeObjectsAtIndexes:cancelledIndexes];
+            for (BOXAPISchedulerEntry *entry in cancelledEntries) {
+                [entry.operation removeObserver:self forKeyPath:@"isCancelled" context:BOXAPISchedulerPendingOperationContext];
+                entry.dispatchBlock(entry.operation);
+            }
+        }
+    }
+}
+
+- (void)dispatchOperationsInLane:(BOXAPISchedulerLane)lane maxCount:(NSUInteger)maxCount time:(CFAbsoluteTime)time rate:(double)rate
+{
+    while (_runningCounts[lane] < maxCount) {
+        NSUInteger accountCount = self.accounts.count;
+        BOXAPISchedulerAccount *nextAccount = nil;
+        NSUInteger nextEntryIndex = NSNotFound;
+        for (NSUInteger offset = 0; offset < accountCount; offset++) {
+            NSUInteger index = (_nextAccountIndexes[lane] + offset) % accountCount;
+            BOXAPISchedulerAccount *schedulerAccount = self.accounts[index];
+            if (schedulerAccount.held) {
+                continue;
+            }
+            NSUInteger entryIndex = [self indexOfDispatchableEntryInEntries:[schedulerAccount pendingEntriesInLane:lane]];
+            if (entryIndex != NSNotFound && [schedulerAccount takeTokenAtTime:time rate:rate]) {
+                nextAccount = schedulerAccount;
+                nextEntryIndex = entryIndex;
+                _nextAccountIndexes[lane] = index + 1;
+                break;
+            }
+        }
+        if (nextAccount == nil) {
+            return;
+        }
+
+        NSMutableArray *pendingEntries = [nextAccount pendingEntriesInLane:lane];
+        BOXAPISchedulerEntry *entry = pendingEntries[nextEntryIndex];
+        [pendingEntries removeObjectAtIndex:nextEntryIndex];
+        [entry.operation removeObserver:self forKeyPath:@"isCancelled" context:BOXAPISchedulerPendingOperationContext];
+
+        _runningCounts[lane]++;
+        [self.runningCountsByQueue setObject:@([self runningCountInQueue:entry.queue] + 1) forKey:entry.queue];
+        [self.runningEntriesByOperation setObject:entry forKey:entry.operation];
+        [entry.operation addObserver:self forKeyPath:@"isFinished" options:0 context:BOXAPISchedulerRunningOperationContext];
+        entry.dispatchBlock(entry.operation);
+    }
+}
+
+// The first entry whose queue can start it right away. Dispatching more than a queue runs at once would only hold
+// slots of the lane while the operations wait in the queue.
+- (NSUInteger)indexOfDispatchableEntryInEntries:(NSArray *)entries
+{
+    return [entries indexOfObjectPassingTest:^BOOL(BOXAPISchedulerEntry *entry, NSUInteger index, BOOL *stop) {
+        NSInteger maxConcurrentOperationCount = entry.queue.maxConcurrentOperationCount;
+        return (maxConcurrentOperationCount == NSOperationQueueDefaultMaxConcurrentOperationCount ||
+                [self runningCountInQueue:entry.queue] < (NSUInteger)maxConcurrentOperationCount);
+    }];
+}
+
+- (NSUInteger)runningCountInQueue:(NSOperationQueue *)queue
+{
+    return queue == nil ? 0 : [[self.runningCountsByQueue objectForKey:queue] unsignedIntegerValue];
+}
+
+// Must be called on schedulerQueue.
+- (void)releaseSlotOfOperation:(NSOperation *)operation
+{
+    BOXAPISchedulerEntry *entry = [self.runningEntriesByOperation objectForKey:operation];
+    if (entry == nil) {
+        return;
+    }
+    [self.runningEntriesByOperation removeObjectForKey:operation];
+    [operation removeObserver:self forKeyPath:@"isFinished" context:BOXAPISchedulerRunningOperationContext];
+
+    _runningCounts[entry.lane]--;
+    NSUInteger queueCount = [self runningCountInQueue:entry.queue];
+    if (queueCount > 1) {
+        [self.runningCountsByQueue setObject:@(queueCount - 1) forKey:entry.queue];
+    } else if (entry.queue != nil) {
+        [self.runningCountsByQueue removeObjectForKey:entry.queue];
+    }
+    [self dispatchOperations];
+}
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+{
+    if (context == BOXAPISchedulerRunningOperationContext) {
+        NSOperation *operation = object;
+        if (operation.isFinished) {
+            dispatch_async(self.schedulerQueue, ^{
+                [self releaseSlotOfOperation:operation];
+            });
+        }
+    } else if (context == BOXAPISchedulerPendingOperationContext) {
+        [self dispatchOperationsAsynchronously];
+    } else {
+        [super observeValueForKeyPath:keyPath ofObject:object change:change context:context];
+    }
+}
+
+- (void)scheduleRetryForRateLimitedAccountsAtTime:(CFAbsoluteTime)time rate:(double)rate
+{
+    if (rate <= 0 || self.retryScheduled) {
+        return;
+    }
+
+    double delay = -1;
+    for (BOXAPISchedulerAccount *schedulerAccount in self.accounts) {
+        if ([schedulerAccount hasPendingEntries] && schedulerAccount.tokens < 1.0) {
+            double accountDelay = (1.0 - schedulerAccount.tokens) / rate;
+            delay = delay < 0 ? accountDelay : MIN(delay, accountDelay);
+        }
+    }
+    if (delay < 0) {
+        return;
+    }
+
+    self.retryScheduled = YES;
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.schedulerQueue, ^{
+        self.retryScheduled = NO;
+        [self dispatchOperations];
+    });
+}
+
+#pragma mark - Counts
+
+- (NSUInteger)runningOperationCountInLane:(BOXAPISchedulerLane)lane
+{
+    __block NSUInteger count = 0;
+    dispatch_sync(self.schedulerQueue, ^{
+        count = self->_runningCounts[lane];
+    });
+    return count;
+}
+
+- (NSUInteger)pendingOperationCountInLane:(BOXAPISchedulerLane)lane
+{
+    __block NSUInteger count = 0;
+    dispatch_sync(self.schedulerQueue, ^{
+        for (BOXAPISchedulerAccount *schedulerAccount in self.accounts) {
+            count += [schedulerAccount pendingEntriesInLane:lane].count;
+        }
+    });
+    return count;
+}
+
+@end
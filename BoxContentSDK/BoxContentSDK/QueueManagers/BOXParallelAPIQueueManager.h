@@ -8,6 +8,8 @@
 
 #import "BOXAPIQueueManager.h"
 
+@class BOXAPIScheduler;
+
 /**
  * BOXParallelAPIQueueManager is an implementation of the abstract class BOXAPIQueueManager.
  * This queue manager allows many concurrent operations at a time. This means that at any
@@ -55,6 +57,25 @@
  */
 @property (nonatomic, readwrite, strong) NSOperationQueue *smallDownloadsQueue;
 
+/**
+ * The NSOperationQueue on which all small upload operations are enqueued. This queue is configured
+ * with `maxConcurrentOperationCount = 4`.
+ */
+@property (nonatomic, readwrite, strong) NSOperationQueue *smallUploadsQueue;
+
+/**
+ * The NSOperationQueue on which long-poll operations such as realtime events subscriptions
+ * are enqueued. These operations are idle most of their lifetime, so this queue is configured
+ * with `maxConcurrentOperationCount = NSOperationQueueDefaultMaxConcurrentOperationCount`.
+ */
+@property (nonatomic, readwrite, strong) NSOperationQueue *longPollQueue;
+
+/**
+ * When set, operations other than authentication and long-poll operations wait on this scheduler, shared with the
+ * queue managers of other accounts, before being added to their queue. nil, the default, adds them right away.
+ */
+@property (nonatomic, readwrite, strong) BOXAPIScheduler *scheduler;
+
 /** @name Designated initializer */
 
 /**
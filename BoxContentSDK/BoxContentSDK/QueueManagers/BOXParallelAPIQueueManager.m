@@ -9,10 +9,20 @@
 #import "BOXParallelAPIQueueManager.h"
 
 #import "BOXAPIDataOperation.h"
+#import "BOXAPIJSONOperation.h"
 #import "BOXAPIOAuth2ToJSONOperation.h"
 #import "BOXAPIMultipartToJSONOperation.h"
 #import "BOXLog.h"
+#import "BOXTraceLog.h"
 #import "BOXAPIAppUsersAuthOperation.h"
+#import "BOXAPIScheduler.h"
+
+// Defined in a private category of BOXAPIQueueManager.
+@interface BOXAPIQueueManager (AuthOperationCompletion)
+
+- (void)AuthOperationDidComplete:(NSNotification *)notification;
+
+@end
 
 @interface BOXParallelAPIQueueManager ()
 
@@ -26,6 +36,8 @@
 @synthesize downloadsQueue = _downloadsQueue;
 @synthesize uploadsQueue = _uploadsQueue;
 @synthesize smallDownloadsQueue = _smallDownloadsQueue;
+@synthesize smallUploadsQueue = _smallUploadsQueue;
+@synthesize longPollQueue = _longPollQueue;
 @synthesize currentAccessTokenHasExpired = _currentAccessTokenHasExpired;
 
 - (id)init
@@ -54,6 +66,14 @@
         _smallDownloadsQueue = [[NSOperationQueue alloc] init];
         _smallDownloadsQueue.name = @"BOXParallelAPIQueueManager small downloads queue";
         _smallDownloadsQueue.maxConcurrentOperationCount = NSOperationQueueDefaultMaxConcurrentOperationCount;
+
+        _smallUploadsQueue = [[NSOperationQueue alloc] init];
+        _smallUploadsQueue.name = @"BOXParallelAPIQueueManager small uploads queue";
+        _smallUploadsQueue.maxConcurrentOperationCount = 4;
+
+        _longPollQueue = [[NSOperationQueue alloc] init];
+        _longPollQueue.name = @"BOXParallelAPIQueueManager long-poll queue";
+        _longPollQueue.maxConcurrentOperationCount = NSOperationQueueDefaultMaxConcurrentOperationCount;
         
         _currentAccessTokenHasExpired = NO;
     }
@@ -63,78 +83,125 @@
 
 - (BOOL)enqueueOperation:(BOXAPIOperation *)operation
 {
-    // lock on the session, which is the shared resource
-    @synchronized(self.session)
-    {
-        [super enqueueOperation:operation];
+    [super enqueueOperation:operation];
 
-        // ensure that authentication operations occur before all other operations
-        if ([operation isKindOfClass:[BOXAPIOAuth2ToJSONOperation class]] || [operation isKindOfClass:[BOXAPIAppUsersAuthOperation class]])
+    // ensure that authentication operations occur before all other operations
+    BOOL isAuthOperation = [operation isKindOfClass:[BOXAPIOAuth2ToJSONOperation class]] || [operation isKindOfClass:[BOXAPIAppUsersAuthOperation class]];
+    if (isAuthOperation)
+    {
+        // lock on the session, which is the shared resource. Only authentication operations take the lock; other
+        // operations only take authDependencyLock, see addOperation:toQueueAfterPendingAuthOperations:.
+        @synchronized(self.session)
         {
-            // hold a refernce to the pending authentication operation so it can be added
-            // as a dependency to all APIOperations enqueued before it finishes
-            [self.enqueuedAuthOperations addObject:operation];
-
-            for (NSOperation *enqueuedOperation in self.globalQueue.operations)
+            @synchronized(self.authDependencyLock)
             {
-                // All API Operations should be dependent on authentication operations EXCEPT other
-                // authentication operations. For example, if a client requests 5 subsequent token refreshes,
-                // All authenticated operations should depend on these requests resolving, but these
-                // requests do not depend on each other
-                if (![enqueuedOperation isKindOfClass:[BOXAPIOAuth2ToJSONOperation class]] && ![enqueuedOperation isKindOfClass:[BOXAPIAppUsersAuthOperation class]])
+                // hold a refernce to the pending authentication operation so it can be added
+                // as a dependency to all APIOperations enqueued before it finishes.
+                [self.enqueuedAuthOperations addObject:operation];
+                [self publishPendingAuthOperations];
+                // Operations dispatched now would only hold slots of the scheduler until the token is refreshed.
+                [self.scheduler setOperationsHeld:YES forAccount:self];
+
+                for (NSOperation *enqueuedOperation in self.globalQueue.operations)
+                {
+                    // All API Operations should be dependent on authentication operations EXCEPT other
+                    // authentication operations. For example, if a client requests 5 subsequent token refreshes,
+                    // All authenticated operations should depend on these requests resolving, but these
+                    // requests do not depend on each other
+                    if (![enqueuedOperation isKindOfClass:[BOXAPIOAuth2ToJSONOperation class]] && ![enqueuedOperation isKindOfClass:[BOXAPIAppUsersAuthOperation class]])
+                    {
+                        [self addDependency:operation toOperation:enqueuedOperation];
+                    }
+                }
+                for (NSOperationQueue *operationQueue in @[self.downloadsQueue, self.smallDownloadsQueue, self.uploadsQueue, self.smallUploadsQueue, self.longPollQueue])
                 {
-                    [self addDependency:operation toOperation:enqueuedOperation];
+                    for (NSOperation *enqueuedOperation in operationQueue.operations)
+                    {
+                        [self addDependency:operation toOperation:enqueuedOperation];
+                    }
                 }
             }
-            for (NSOperation *enqueuedOperation in self.downloadsQueue.operations)
-            {
-                [self addDependency:operation toOperation:enqueuedOperation];
+        }
+    }
 
-            }
-            for (NSOperation *enqueuedOperation in self.uploadsQueue.operations)
-            {
-                [self addDependency:operation toOperation:enqueuedOperation];
 
-            }
+    NSOperationQueue *queue = nil;
+    BOXTraceQueue traceQueue = BOXTraceQueueGlobal;
+    BOXAPISchedulerLane lane = BOXAPISchedulerLaneRequests;
+    if ([operation isKindOfClass:[BOXAPIDataOperation class]])
+    {
+        BOXAPIDataOperation *apiDataOperation = (BOXAPIDataOperation *)operation;
+        if (apiDataOperation.isSmallDownloadOperation) {
+            queue = self.smallDownloadsQueue;
+            traceQueue = BOXTraceQueueSmallDownloads;
+        } else {
+            queue = self.downloadsQueue;
+            traceQueue = BOXTraceQueueDownloads;
+            lane = BOXAPISchedulerLaneTransfers;
         }
-        else
-        {
-            // If there are any incomplete authentication operations, add them as dependencies for
-            // this newly enqueued operation. Authentication operations have the potential to change
-            // the access token, which Authenticated operations need in order to complete
-            // successfully.
-            for (NSOperation *pendingAuthOperation in self.enqueuedAuthOperations)
-            {
-                [self addDependency:pendingAuthOperation toOperation:operation];
-            }
+    }
+    else if ([operation isKindOfClass:[BOXAPIMultipartToJSONOperation class]])
+    {
+        if (((BOXAPIMultipartToJSONOperation *)operation).isSmallUploadOperation) {
+            queue = self.smallUploadsQueue;
+            traceQueue = BOXTraceQueueSmallUploads;
+        } else {
+            queue = self.uploadsQueue;
+            traceQueue = BOXTraceQueueUploads;
+            lane = BOXAPISchedulerLaneTransfers;
         }
+    }
+    else if ([operation isKindOfClass:[BOXAPIJSONOperation class]] && ((BOXAPIJSONOperation *)operation).isLongPollOperation)
+    {
+        queue = self.longPollQueue;
+        traceQueue = BOXTraceQueueLongPoll;
+    }
+    else
+    {
+        queue = self.globalQueue;
+    }
 
-        
-        if ([operation isKindOfClass:[BOXAPIDataOperation class]])
-        {
-            BOXAPIDataOperation *apiDataOperation = (BOXAPIDataOperation *)operation;
-            if (apiDataOperation.isSmallDownloadOperation) {
-                [self.smallDownloadsQueue addOperation:operation];
-                BOXLog(@"enqueued %@ on thumbnails download queue", operation);
-            } else {
-                [self.downloadsQueue addOperation:operation];
-                BOXLog(@"enqueued %@ on download queue", operation);
-            }
-        }
-        else if ([operation isKindOfClass:[BOXAPIMultipartToJSONOperation class]])
+    // If there are any incomplete authentication operations, they are added as dependencies of other operations as
+    // they are added to their queue. Authentication operations have the potential to change the access token, which
+    // Authenticated operations need in order to complete successfully.
+    //
+    // Authentication operations gate every other operation of this account, and long-poll operations are idle
+    // most of their lifetime, so neither waits on the scheduler.
+    if (self.scheduler == nil || isAuthOperation || traceQueue == BOXTraceQueueLongPoll)
+    {
+        if (isAuthOperation)
         {
-            [self.uploadsQueue addOperation:operation];
-            BOXLog(@"enqueued %@ on upload queue", operation);
+            [self addOperation:operation toQueue:queue];
         }
         else
         {
-            [self.globalQueue addOperation:operation];
-            BOXLog(@"enqueued %@ on global queue", operation);
+            [self addOperation:operation toQueueAfterPendingAuthOperations:queue];
         }
-
-        return YES;
+        BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationEnqueued, operation.traceID, traceQueue, (uintptr_t)[operation class], 0);
+    }
+    else
+    {
+        [self.scheduler scheduleOperation:operation forAccount:self inLane:lane queue:queue dispatchBlock:^(NSOperation *scheduledOperation) {
+            // Authentication operations enqueued while this one waited on the scheduler were not able to add
+            // themselves as its dependencies; it picks them up as it is added to its queue.
+            [self addOperation:scheduledOperation toQueueAfterPendingAuthOperations:queue];
+            BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationEnqueued, operation.traceID, traceQueue, (uintptr_t)[operation class], 0);
+        }];
     }
+
+    return YES;
 }
 
+- (void)AuthOperationDidComplete:(NSNotification *)notification
+{
+    @synchronized(self.session)
+    {
+        [super AuthOperationDidComplete:notification];
+        if (self.pendingAuthOperations.count == 0)
+        {
+            [self.scheduler setOperationsHeld:NO forAccount:self];
+        }
+    }
+}
 
 @end
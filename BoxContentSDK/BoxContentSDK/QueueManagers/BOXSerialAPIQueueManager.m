@@ -12,6 +12,7 @@
 #import "BOXAPIOAuth2ToJSONOperation.h"
 #import "BOXAPIAppUsersAuthOperation.h"
 #import "BOXLog.h"
+#import "BOXTraceLog.h"
 #import "BOXOAuth2Session.h"
 
 @implementation BOXSerialAPIQueueManager
@@ -50,6 +51,7 @@
             // hold a refernce to the pending authenation operation so it can be added
             // as a dependency to all APIOperations enqueued before it finishes
             [self.enqueuedAuthOperations addObject:operation];
+            [self publishPendingAuthOperations];
 
             for (NSOperation *enqueuedOperation in self.globalQueue.operations)
             {
@@ -76,8 +78,8 @@
             }
         }
 
-        [self.globalQueue addOperation:operation];
-        BOXLog(@"enqueued %@", operation);
+        [self addOperation:operation toQueue:self.globalQueue];
+        BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationEnqueued, operation.traceID, BOXTraceQueueGlobal, (uintptr_t)[operation class], 0);
         
         return YES;
     }
@@ -28,6 +28,7 @@
     operationCopy.successBlock = [self.successBlock copy];
     operationCopy.failureBlock = [self.failureBlock copy];
     operationCopy.timesReenqueued = self.timesReenqueued;
+    operationCopy.cancellationContext = self.cancellationContext;
     
     // Migrate header fields (this is especially important for requests where some of the key
     // information is in the headers, such as Shared Link requests for the underlying item).
@@ -90,6 +91,10 @@
 {
     // Delay grows each time the request is re-enqueued.
     double delay = MIN(pow((1 + REENQUE_BASE_DELAY), self.timesReenqueued) - 1, MAX_REENQUE_DELAY);
+    // Past the deadline, the copy fails as soon as it is enqueued; there is no point in waiting for it.
+    if (self.cancellationContext != nil) {
+        delay = MIN(delay, [self.cancellationContext remainingTime]);
+    }
     return delay;
 }
 
@@ -0,0 +1,27 @@
+//
+//  BOXEventsLongPollRequest.h
+//  BoxContentSDK
+//
+
+#import "BOXRequest.h"
+
+/**
+ *  Opens a long-poll connection on a realtime server. The server holds the connection open
+ *  until a change is available past streamPosition (BOXAPIEventLongPollMessageNewChange) or the
+ *  client should open a new connection (BOXAPIEventLongPollMessageReconnect).
+ *
+ *  The operation runs on the long-poll queue of BOXParallelAPIQueueManager so it does not
+ *  hold a slot of the global queue while it is parked. It is sent over https without the
+ *  session's authorization header; if the realtime server has no https URL, the request
+ *  fails with NSURLErrorAppTransportSecurityRequiresSecureConnection without being sent.
+ */
+@interface BOXEventsLongPollRequest : BOXRequest
+
+@property (nonatomic, readonly, strong) BOXRealtimeServer *realtimeServer;
+@property (nonatomic, readwrite, strong) NSString *streamPosition;
+
+- (instancetype)initWithRealtimeServer:(BOXRealtimeServer *)realtimeServer streamPosition:(NSString *)streamPosition;
+
+- (void)performRequestWithCompletion:(BOXEventsLongPollBlock)completionBlock;
+
+@end
@@ -0,0 +1,83 @@
+//
+//  BOXEventsLongPollRequest.m
+//  BoxContentSDK
+//
+
+#import "BOXRequest_Private.h"
+#import "BOXEventsLongPollRequest.h"
+
+#import "BOXRealtimeServer.h"
+#import "BOXDispatchHelper.h"
+
+// Leave the server enough time to answer before the connection times out on our side.
+#define BOX_LONG_POLL_TIMEOUT_MARGIN (30.0)
+#define BOX_LONG_POLL_DEFAULT_RETRY_TIMEOUT (610.0)
+
+@implementation BOXEventsLongPollRequest
+
+- (instancetype)initWithRealtimeServer:(BOXRealtimeServer *)realtimeServer streamPosition:(NSString *)streamPosition
+{
+    if (self = [super init]) {
+        _realtimeServer = realtimeServer;
+        _streamPosition = streamPosition;
+    }
+    return self;
+}
+
+- (BOXAPIOperation *)createOperation
+{
+    NSMutableDictionary *parameters = [NSMutableDictionary dictionary];
+
+    if (self.streamPosition.length > 0) {
+        parameters[BOXAPIParameterKeyStreamPosition] = self.streamPosition;
+    }
+
+    BOXAPIJSONOperation *operation = [self JSONOperationWithURL:self.realtimeServer.URL
+                                                     HTTPMethod:BOXAPIHTTPMethodGET
+                                          queryStringParameters:parameters
+                                                 bodyDictionary:nil
+                                               JSONSuccessBlock:nil
+                                                   failureBlock:nil];
+    operation.isLongPollOperation = YES;
+
+    NSTimeInterval retryTimeout = self.realtimeServer.retryTimeout > 0 ? self.realtimeServer.retryTimeout : BOX_LONG_POLL_DEFAULT_RETRY_TIMEOUT;
+    operation.APIRequest.timeoutInterval = retryTimeout + BOX_LONG_POLL_TIMEOUT_MARGIN;
+
+    return operation;
+}
+
+- (void)performRequestWithCompletion:(BOXEventsLongPollBlock)completionBlock
+{
+    if (completionBlock) {
+        BOOL isMainThread = [NSThread isMainThread];
+
+        // BOXRealtimeServer only keeps https URLs.
+        if (self.realtimeServer.URL == nil) {
+            NSError *error = [[NSError alloc] initWithDomain:NSURLErrorDomain code:NSURLErrorAppTransportSecurityRequiresSecureConnection userInfo:nil];
+            [BOXDispatchHelper callCompletionBlock:^{
+                completionBlock(nil, error);
+            } onMainThread:isMainThread];
+            return;
+        }
+
+        BOXAPIJSONOperation *longPollOperation = (BOXAPIJSONOperation *)self.operation;
+
+        longPollOperation.success = ^(NSURLRequest *request, NSHTTPURLResponse *response, NSDictionary *JSONDictionary) {
+            NSString *message = [NSJSONSerialization box_ensureObjectForKey:BOXAPIObjectKeyMessage
+                                                               inDictionary:JSONDictionary
+                                                            hasExpectedType:[NSString class]
+                                                                nullAllowed:NO];
+            [BOXDispatchHelper callCompletionBlock:^{
+                completionBlock(message, nil);
+            } onMainThread:isMainThread];
+        };
+        longPollOperation.failure = ^(NSURLRequest *request, NSHTTPURLResponse *response, NSError *error, NSDictionary *JSONDictionary) {
+            [BOXDispatchHelper callCompletionBlock:^{
+                completionBlock(nil, error);
+            } onMainThread:isMainThread];
+        };
+        [self performRequest];
+    }
+}
+
+@end
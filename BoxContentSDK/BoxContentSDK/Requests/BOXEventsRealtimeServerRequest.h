@@ -0,0 +1,16 @@
+//
+//  BOXEventsRealtimeServerRequest.h
+//  BoxContentSDK
+//
+
+#import "BOXRequest.h"
+
+/**
+ *  Retrieves the long-poll server to use for realtime notifications on the event stream
+ *  (OPTIONS /events).
+ */
+@interface BOXEventsRealtimeServerRequest : BOXRequest
+
+- (void)performRequestWithCompletion:(BOXRealtimeServerBlock)completionBlock;
+
+@end
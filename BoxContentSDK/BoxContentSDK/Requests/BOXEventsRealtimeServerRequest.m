@@ -0,0 +1,67 @@
+//
+//  BOXEventsRealtimeServerRequest.m
+//  BoxContentSDK
+//
+
+#import "BOXRequest_Private.h"
+#import "BOXEventsRealtimeServerRequest.h"
+
+#import "BOXRealtimeServer.h"
+#import "BOXDispatchHelper.h"
+#import "BOXContentSDKErrors.h"
+
+@implementation BOXEventsRealtimeServerRequest
+
+- (BOXAPIOperation *)createOperation
+{
+    NSURL *url = [self URLWithResource:BOXAPIResourceEvents ID:nil subresource:nil subID:nil];
+
+    BOXAPIOperation *operation = [self JSONOperationWithURL:url
+                                                 HTTPMethod:BOXAPIHTTPMethodOPTIONS
+                                      queryStringParameters:nil
+                                             bodyDictionary:nil
+                                           JSONSuccessBlock:nil
+                                               failureBlock:nil];
+
+    return operation;
+}
+
+- (void)performRequestWithCompletion:(BOXRealtimeServerBlock)completionBlock
+{
+    if (completionBlock) {
+        BOOL isMainThread = [NSThread isMainThread];
+        BOXAPIJSONOperation *serverOperation = (BOXAPIJSONOperation *)self.operation;
+
+        serverOperation.success = ^(NSURLRequest *request, NSHTTPURLResponse *response, NSDictionary *JSONDictionary) {
+            BOXRealtimeServer *realtimeServer = nil;
+            NSArray *entries = JSONDictionary[BOXAPICollectionKeyEntries];
+
+            for (NSDictionary *dict in entries) {
+                if ([dict isKindOfClass:[NSDictionary class]] && [dict[BOXAPIObjectKeyType] isEqualToString:BOXAPIItemTypeRealtimeServer]) {
+                    realtimeServer = [[BOXRealtimeServer alloc] initWithJSON:dict];
+                    break;
+                }
+            }
+
+            NSError *error = nil;
+            if (realtimeServer.URL == nil) {
+                error = [NSError errorWithDomain:BOXContentSDKErrorDomain
+                                            code:BOXContentSDKJSONErrorUnexpectedType
+                                        userInfo:JSONDictionary != nil ? @{BOXJSONErrorResponseKey : JSONDictionary} : nil];
+                realtimeServer = nil;
+            }
+
+            [BOXDispatchHelper callCompletionBlock:^{
+                completionBlock(realtimeServer, error);
+            } onMainThread:isMainThread];
+        };
+        serverOperation.failure = ^(NSURLRequest *request, NSHTTPURLResponse *response, NSError *error, NSDictionary *JSONDictionary) {
+            [BOXDispatchHelper callCompletionBlock:^{
+                completionBlock(nil, error);
+            } onMainThread:isMainThread];
+        };
+        [self performRequest];
+    }
+}
+
+@end
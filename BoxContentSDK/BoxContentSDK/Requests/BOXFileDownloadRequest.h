@@ -15,6 +15,15 @@
 // Enable NSURLSession cachepolicy for this request
 @property (nonatomic, readwrite, assign) BOOL ignoreLocalURLRequestCache;
 
+// If byteRangeLength is not 0, only byteRangeLength bytes of the file starting at byteRangeOffset are
+// downloaded. Used to resume a partial download or to fetch a large file in several parts.
+@property (nonatomic, readwrite, assign) unsigned long long byteRangeOffset;
+@property (nonatomic, readwrite, assign) unsigned long long byteRangeLength;
+
+// Small downloads run on the queue manager's small downloads queue instead of the downloads queue,
+// so they are not held up behind large transfers.
+@property (nonatomic, readwrite, assign) BOOL isSmallDownload;
+
 /**
  * request will download file into destinationPath, and the file download can continue
  * running in the background even if app is not running
@@ -82,6 +82,13 @@
                                                         associateId:self.associateId];
 
     dataOperation.modelID = self.fileID;
+    dataOperation.isSmallDownloadOperation = self.isSmallDownload;
+
+    if (self.byteRangeLength > 0) {
+        NSString *range = [NSString stringWithFormat:@"bytes=%llu-%llu",
+                           self.byteRangeOffset, self.byteRangeOffset + self.byteRangeLength - 1];
+        [dataOperation.APIRequest setValue:range forHTTPHeaderField:BOXAPIHTTPHeaderRange];
+    }
     
     BOXAssert(self.outputStream != nil || self.destinationPath != nil, @"An output stream or destination file path must be specified.");
     BOXAssert(!(self.outputStream != nil && self.destinationPath != nil), @"You cannot specify both an outputStream and a destination file path.");
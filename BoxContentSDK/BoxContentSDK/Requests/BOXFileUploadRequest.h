@@ -12,6 +12,9 @@
 @property (nonatomic, readwrite, strong) NSDate *contentCreatedAt;
 @property (nonatomic, readwrite, strong) NSDate *contentModifiedAt;
 @property (nonatomic, readwrite, assign) BOOL requestAllFileFields;
+// Small uploads run on the queue manager's small uploads queue instead of the uploads queue,
+// so they are not held up behind large transfers.
+@property (nonatomic, readwrite, assign) BOOL isSmallUpload;
 
 - (instancetype)initWithPath:(NSString *)filePath targetFolderID:(NSString *)folderID;
 
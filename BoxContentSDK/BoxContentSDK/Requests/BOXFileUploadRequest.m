@@ -114,6 +114,7 @@
                                                        body:multipartBodyParameters
                                                 queryParams:queryParameters
                                               session:self.queueManager.session];
+    operation.isSmallUploadOperation = self.isSmallUpload;
 
     if ([self.localFilePath length] > 0 && [[NSFileManager defaultManager] fileExistsAtPath:self.localFilePath]) {
         if([self.uploadMultipartCopyFilePath length] <= 0) { // Foreground operations deprecated, for backward compatibility
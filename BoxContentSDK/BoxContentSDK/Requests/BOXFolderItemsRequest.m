@@ -18,7 +18,6 @@
 
 @interface BOXFolderItemsRequest ()
 
-@property (nonatomic) BOOL isCancelled;
 @property (nonatomic, readwrite, strong) BOXFolderPaginatedItemsRequest *paginatedRequest;
 
 @end
@@ -37,16 +36,6 @@
     return self;
 }
 
-- (void)cancel
-{
-    @synchronized(self) {
-        [super cancel];
-        self.isCancelled = YES;
-        [self.paginatedRequest cancel];
-        self.paginatedRequest = nil;
-    }
-}
-
 - (void)setRangeStep:(NSUInteger)rangeStep
 {
     _rangeStep = rangeStep;
@@ -159,10 +148,11 @@
                         NSUInteger limit = length;
                         NSRange range = NSMakeRange(offset, limit);
 
-                        // if operation got cancelled while preparing for the next request, call cancellation block
-                        if (self.isCancelled) {
-                            error = [NSError errorWithDomain:BOXContentSDKErrorDomain code:BOXContentSDKAPIUserCancelledError userInfo:nil];
-                            localRefreshBlock(nil, error);
+                        // if the request got cancelled or ran out of time while preparing for the next page,
+                        // fail without fetching it
+                        NSError *contextError = [self.cancellationContext error];
+                        if (contextError != nil) {
+                            localRefreshBlock(nil, contextError);
                         } else {
                             [self performPaginatedRequestWithCached:nil
                                                           refreshed:recursiveFetch
@@ -208,6 +198,8 @@
     paginatedRequest.fieldsToExclude = self.fieldsToExclude;
     paginatedRequest.userAgentPrefix = self.userAgentPrefix;
     paginatedRequest.sharedPaginatedRequestData = self.sharedPaginatedRequestData;
+    // Cancelling this request, or reaching its deadline, cancels the page being fetched.
+    paginatedRequest.cancellationContext = [self.cancellationContext childContext];
     self.paginatedRequest = paginatedRequest;
     [paginatedRequest performRequestWithCached:cacheBlock refreshed:refreshBlock];
 }
@@ -15,6 +15,12 @@
 //can be used as a way to link related paginated requests together
 @property (nonatomic, readwrite, strong) NSData *sharedPaginatedRequestData;
 
+/**
+ * The list of fields to request instead of the API's default fields, e.g. only what a tree walk needs.
+ * If requestAllItemFields is YES, fieldsToInclude will not have any effect.
+ */
+@property (nonatomic, readwrite, copy) NSArray<NSString *> *fieldsToInclude;
+
 //Metadata information parameters
 @property (nonatomic, readwrite, copy) NSString *metadataTemplateKey;
 @property (nonatomic, readwrite, copy) BOXMetadataScope metadataScope;
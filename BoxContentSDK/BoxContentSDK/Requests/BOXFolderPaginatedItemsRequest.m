@@ -52,6 +52,8 @@
     
     if (self.requestAllItemFields) {
         fieldString = [self fullItemFieldsParameterStringExcludingFields:self.fieldsToExclude];
+    } else if (self.fieldsToInclude.count > 0) {
+        fieldString = [self.fieldsToInclude componentsJoinedByString:@","];
     }
     
     if (self.metadataTemplateKey && self.metadataScope) {
@@ -10,7 +10,7 @@
 @property (nonatomic, readonly, strong) NSString *fileName;
 @property (nonatomic, readonly, strong) NSString *fileID;
 @property (nonatomic, readonly, strong) NSString *parentFolderID;
-@property (nonatomic, readwrite, assign) NSUInteger fileSize;
+@property (nonatomic, readwrite, assign) unsigned long long fileSize;
 
 - (instancetype)initWithFileName:(NSString *)fileName fileID:(NSString *)fileID;
 - (instancetype)initWithFileName:(NSString *)fileName parentFolderID:(NSString *)parentFolderID;
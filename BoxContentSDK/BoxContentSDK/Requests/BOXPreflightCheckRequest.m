@@ -45,7 +45,7 @@
         bodyDictionary[BOXAPIObjectKeyParent] = parentID;
     }
     
-    bodyDictionary[BOXAPIObjectKeySize] = [NSNumber numberWithUnsignedLong:self.fileSize];
+    bodyDictionary[BOXAPIObjectKeySize] = [NSNumber numberWithUnsignedLongLong:self.fileSize];
     
     BOXAPIJSONOperation *JSONoperation = [self JSONOperationWithURL:URL
                                                          HTTPMethod:BOXAPIHTTPMethodOPTIONS
@@ -5,6 +5,7 @@
 
 #import <UIKit/UIKit.h>
 #import "NSDate+BOXContentSDKAdditions.h"
+#import "BOXCancellationContext.h"
 
 @class BOXCollaboration;
 @class BOXFile;
@@ -20,6 +21,7 @@
 @class BOXRecentItem;
 @class BOXMetadataTemplate;
 @class BOXRepresentation;
+@class BOXRealtimeServer;
 
 typedef void (^BOXErrorBlock)(NSError *error);
 
@@ -58,6 +60,10 @@ typedef void (^BOXCollectionBlock)(BOXCollection *collection, NSError *error);
 
 typedef void (^BOXEventsBlock)(NSArray <BOXEvent *> *events, NSString *nextStreamPosition, NSError *error);
 
+typedef void (^BOXRealtimeServerBlock)(BOXRealtimeServer *realtimeServer, NSError *error);
+
+typedef void (^BOXEventsLongPollBlock)(NSString *message, NSError *error);
+
 typedef void (^BOXRecentItemsBlock)(NSArray <BOXRecentItem *> *recentItems, NSString *nextMarker, NSError *error);
 
 typedef void (^BOXFileVersionBlock)(BOXFileVersion *fileVersion, NSError *error);
@@ -81,6 +87,14 @@ typedef void (^BOXRepresentationInfoBlock)(BOXRepresentation *representation, NS
 @property (nonatomic, readwrite, strong) NSString *SDKIdentifier;
 @property (nonatomic, readwrite, strong) NSString *SDKVersion;
 
+/**
+ * Cancellation and deadline of everything the request runs, including the requests composite requests spawn
+ * and the retries of its operations. Created without a deadline if none is set. Set one with a deadline, before
+ * performing the request, to have it fail with BOXContentSDKAPIDeadlineExceededError rather than keep retrying
+ * once the result is no longer wanted.
+ */
+@property (nonatomic, readwrite, strong) BOXCancellationContext *cancellationContext;
+
 - (void)performRequest;
 - (void)cancel;
 
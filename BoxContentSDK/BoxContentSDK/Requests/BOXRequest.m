@@ -15,11 +15,23 @@
 #import "NSString+BOXContentSDKAdditions.h"
 #import "UIDevice+BOXContentSDKAdditions.h"
 #import "BOXContentClient.h"
+#import "BOXRequestTemplate.h"
 
 #define BOX_API_MULTIPART_FILENAME_DEFAULT (@"upload")
 
+@interface BOXRequest ()
+
+// Built lazily, and dropped whenever one of the properties it depends on changes.
+@property (nonatomic, readwrite, strong) BOXRequestTemplate *requestTemplate;
+
+@end
+
 @implementation BOXRequest
 
+@synthesize SDKIdentifier = _SDKIdentifier;
+@synthesize SDKVersion = _SDKVersion;
+@synthesize cancellationContext = _cancellationContext;
+
 - (BOXAPIQueueManager *)queueManager
 {
     if (_queueManager == nil) {
@@ -57,19 +69,56 @@
     return _uploadBaseURL;
 }
 
+- (void)setUserAgentPrefix:(NSString *)userAgentPrefix
+{
+    _userAgentPrefix = userAgentPrefix;
+    self.requestTemplate = nil;
+}
+
+- (void)setSDKIdentifier:(NSString *)SDKIdentifier
+{
+    _SDKIdentifier = SDKIdentifier;
+    self.requestTemplate = nil;
+}
+
+- (void)setSDKVersion:(NSString *)SDKVersion
+{
+    _SDKVersion = SDKVersion;
+    self.requestTemplate = nil;
+}
+
 - (NSURLRequest *)urlRequest
 {
     return self.operation.APIRequest;
 }
 
+- (BOXCancellationContext *)cancellationContext
+{
+    @synchronized(self) {
+        if (_cancellationContext == nil) {
+            _cancellationContext = [[BOXCancellationContext alloc] init];
+        }
+        return _cancellationContext;
+    }
+}
+
+- (void)setCancellationContext:(BOXCancellationContext *)cancellationContext
+{
+    @synchronized(self) {
+        _cancellationContext = cancellationContext;
+    }
+}
+
 - (void)performRequest
 {
     [self.operation.APIRequest setValue:[self userAgent] forHTTPHeaderField:@"User-Agent"];
+    self.operation.cancellationContext = self.cancellationContext;
     [self.queueManager enqueueOperation:self.operation];
 }
 
 - (void)cancel
 {
+    [self.cancellationContext cancel];
     [self.operation cancel];
 }
 
@@ -82,6 +131,7 @@
 - (void)prepareOperation
 {
     [self.operation.APIRequest setValue:[self userAgent] forHTTPHeaderField:@"User-Agent"];
+    self.operation.cancellationContext = self.cancellationContext;
     [self.operation prepareOperation];
 }
 
@@ -322,7 +372,7 @@
 
 - (NSString *)fullFolderFieldsParameterString
 {
-    return [[self fullFolderFieldsArray] componentsJoinedByString:@","];
+    return self.requestTemplate.fullFolderFieldsParameterString;
 }
 
 - (NSArray<NSString *> *)fullFileFieldsArray
@@ -365,7 +415,7 @@
 
 - (NSString *)fullFileFieldsParameterString
 {
-    return [[self fullFileFieldsArray] componentsJoinedByString:@","];
+    return self.requestTemplate.fullFileFieldsParameterString;
 }
 
 - (NSArray *)fullBookmarkFieldsArray
@@ -397,30 +447,35 @@
 
 - (NSString *)fullBookmarkFieldsParameterString
 {
-    return [[self fullBookmarkFieldsArray] componentsJoinedByString:@","];
+    return self.requestTemplate.fullBookmarkFieldsParameterString;
 }
 
 - (NSString *)fullItemFieldsParameterString
 {
-    NSMutableOrderedSet *set = [NSMutableOrderedSet orderedSet];
-    [set addObjectsFromArray:[self fullFolderFieldsArray]];
-    [set addObjectsFromArray:[self fullFileFieldsArray]];
-    [set addObjectsFromArray:[self fullBookmarkFieldsArray]];
-    return [[set array] componentsJoinedByString:@","];
+    return self.requestTemplate.fullItemFieldsParameterString;
 }
 
 - (NSString *)fullItemFieldsParameterStringExcludingFields:(NSArray *)excludedFields
 {
-    NSMutableOrderedSet *set = [NSMutableOrderedSet orderedSet];
-    [set addObjectsFromArray:[self fullFolderFieldsArray]];
-    [set addObjectsFromArray:[self fullFileFieldsArray]];
-    [set addObjectsFromArray:[self fullBookmarkFieldsArray]];
-
-    [set removeObjectsInArray:excludedFields];
-    return [[set array] componentsJoinedByString:@","];
+    return [self.requestTemplate fullItemFieldsParameterStringExcludingFields:excludedFields];
 }
 
 - (NSString *)fullCommentFieldsParameterString
+{
+    return self.requestTemplate.fullCommentFieldsParameterString;
+}
+
+- (NSString *)fullUserFieldsParameterString
+{
+    return self.requestTemplate.fullUserFieldsParameterString;
+}
+
+- (NSString *)fullCollaborationFieldsParameterString
+{
+    return self.requestTemplate.fullCollaborationFieldsParameterString;
+}
+
+- (NSArray *)fullCommentFieldsArray
 {
     NSArray *array = @[BOXAPIObjectKeyMessage,
                        BOXAPIObjectKeyTaggedMessage,
@@ -429,10 +484,10 @@
                        BOXAPIObjectKeyIsReplyComment,
                        BOXAPIObjectKeyModifiedAt,
                        BOXAPIObjectKeyItem];
-    return [array componentsJoinedByString:@","];
+    return array;
 }
 
-- (NSString *)fullUserFieldsParameterString
+- (NSArray *)fullUserFieldsArray
 {
     NSArray *array = @[BOXAPIObjectKeyType,
                        BOXAPIObjectKeyID,
@@ -460,10 +515,10 @@
                        BOXAPIObjectKeyIsExemptFromLoginVerification,
                        BOXAPIObjectKeyEnterprise,
                        BOXAPIObjectKeyIsBoxNotesCreationEnabled];
-    return [array componentsJoinedByString:@","];
+    return array;
 }
 
-- (NSString *)fullCollaborationFieldsParameterString
+- (NSArray *)fullCollaborationFieldsArray
 {
     NSArray *array = @[BOXAPIObjectKeyType,
                        BOXAPIObjectKeyID,
@@ -476,12 +531,18 @@
                        BOXAPIObjectKeyRole,
                        BOXAPIObjectKeyAcknowledgedAt,
                        BOXAPIObjectKeyItem];
-    return [array componentsJoinedByString:@","];
+    return array;
 }
 
 - (NSString *)deviceModelName
 {
-    return [[UIDevice currentDevice] detailedModelName];
+    // The model name is looked up with sysctl, and never changes.
+    static NSString *deviceModelName = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        deviceModelName = [[UIDevice currentDevice] detailedModelName];
+    });
+    return deviceModelName;
 }
 
 - (NSString *)SDKIdentifier
@@ -503,6 +564,34 @@
 }
 
 - (NSString *)userAgent
+{
+    return self.requestTemplate.userAgent;
+}
+
+#pragma mark - Template
+
+- (BOXRequestTemplate *)requestTemplate
+{
+    if (_requestTemplate == nil) {
+        NSArray *key = @[[self class],
+                         self.userAgentPrefix ?: @"",
+                         self.SDKIdentifier,
+                         self.SDKVersion,
+                         [self deviceModelName] ?: @""];
+        _requestTemplate = [BOXRequestTemplate templateForKey:key buildBlock:^BOXRequestTemplate *{
+            return [[BOXRequestTemplate alloc] initWithUserAgent:[self uncachedUserAgent]
+                                                 fileFieldsArray:[self fullFileFieldsArray]
+                                               folderFieldsArray:[self fullFolderFieldsArray]
+                                             bookmarkFieldsArray:[self fullBookmarkFieldsArray]
+                                              commentFieldsArray:[self fullCommentFieldsArray]
+                                                 userFieldsArray:[self fullUserFieldsArray]
+                                        collaborationFieldsArray:[self fullCollaborationFieldsArray]];
+        }];
+    }
+    return _requestTemplate;
+}
+
+- (NSString *)uncachedUserAgent
 {
     NSString *userAgent;
     NSString *defaultUserAgent = [NSString stringWithFormat:@"iOS/%@;Apple/%@;%@/%@;%@",
@@ -0,0 +1,49 @@
+//
+//  BOXRequestTemplate.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ * The parts of a request that only depend on its class and on how its client is configured: the User-Agent header
+ * and the fields parameter strings. They are built once, and shared by all the requests that have the same key.
+ *
+ * A template never changes once built. The only exception is the memo of the item fields strings excluding some
+ * fields, which is internally synchronized.
+ */
+@interface BOXRequestTemplate : NSObject
+
+@property (nonatomic, readonly, copy) NSString *userAgent;
+@property (nonatomic, readonly, copy) NSString *fullFileFieldsParameterString;
+@property (nonatomic, readonly, copy) NSString *fullFolderFieldsParameterString;
+@property (nonatomic, readonly, copy) NSString *fullBookmarkFieldsParameterString;
+@property (nonatomic, readonly, copy) NSString *fullItemFieldsParameterString;
+@property (nonatomic, readonly, copy) NSString *fullCommentFieldsParameterString;
+@property (nonatomic, readonly, copy) NSString *fullUserFieldsParameterString;
+@property (nonatomic, readonly, copy) NSString *fullCollaborationFieldsParameterString;
+
+/**
+ * Returns the template stored for the key, or builds it with the block and stores it.
+ *
+ * @param key   Identifies what the template depends on, e.g. the request class and the User-Agent components.
+ * @param block Builds the template. Called outside of any lock; if two threads race, the first stored template wins.
+ */
++ (instancetype)templateForKey:(id<NSCopying>)key buildBlock:(BOXRequestTemplate * (^)(void))block;
+
+/**
+ * Drops the stored templates. The templates already handed out stay valid.
+ */
++ (void)removeAllTemplates;
+
+- (instancetype)initWithUserAgent:(NSString *)userAgent
+                  fileFieldsArray:(NSArray *)fileFieldsArray
+                folderFieldsArray:(NSArray *)folderFieldsArray
+              bookmarkFieldsArray:(NSArray *)bookmarkFieldsArray
+               commentFieldsArray:(NSArray *)commentFieldsArray
+                  userFieldsArray:(NSArray *)userFieldsArray
+         collaborationFieldsArray:(NSArray *)collaborationFieldsArray;
+
+- (NSString *)fullItemFieldsParameterStringExcludingFields:(NSArray *)excludedFields;
+
+@end
@@ -0,0 +1,106 @@
+//
+//  BOXRequestTemplate.m
+//  BoxContentSDK
+//
+
+#import "BOXRequestTemplate.h"
+
+// Callers usually exclude the same few fields, so a small memo is enough.
+#define BOX_REQUEST_TEMPLATE_EXCLUDED_FIELDS_MEMO_LIMIT (32)
+
+@interface BOXRequestTemplate ()
+
+@property (nonatomic, readonly, strong) NSArray *itemFieldsArray;
+@property (nonatomic, readonly, strong) NSCache *itemFieldsParameterStringsByExcludedFields;
+
+@end
+
+@implementation BOXRequestTemplate
+
++ (NSMutableDictionary *)templatesByKey
+{
+    static NSMutableDictionary *templatesByKey = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        templatesByKey = [NSMutableDictionary dictionary];
+    });
+    return templatesByKey;
+}
+
++ (instancetype)templateForKey:(id<NSCopying>)key buildBlock:(BOXRequestTemplate * (^)(void))block
+{
+    NSMutableDictionary *templatesByKey = [self templatesByKey];
+    @synchronized(templatesByKey) {
+        BOXRequestTemplate *template = templatesByKey[key];
+        if (template != nil) {
+            return template;
+        }
+    }
+
+    BOXRequestTemplate *template = block();
+    @synchronized(templatesByKey) {
+        BOXRequestTemplate *storedTemplate = templatesByKey[key];
+        if (storedTemplate != nil) {
+            return storedTemplate;
+        }
+        templatesByKey[key] = template;
+    }
+    return template;
+}
+
++ (void)removeAllTemplates
+{
+    NSMutableDictionary *templatesByKey = [self templatesByKey];
+    @synchronized(templatesByKey) {
+        [templatesByKey removeAllObjects];
+    }
+}
+
+- (instancetype)initWithUserAgent:(NSString *)userAgent
+                  fileFieldsArray:(NSArray *)fileFieldsArray
+                folderFieldsArray:(NSArray *)folderFieldsArray
+              bookmarkFieldsArray:(NSArray *)bookmarkFieldsArray
+               commentFieldsArray:(NSArray *)commentFieldsArray
+                  userFieldsArray:(NSArray *)userFieldsArray
+         collaborationFieldsArray:(NSArray *)collaborationFieldsArray
+{
+    if (self = [super init]) {
+        _userAgent = [userAgent copy];
+        _fullFileFieldsParameterString = [fileFieldsArray componentsJoinedByString:@","];
+        _fullFolderFieldsParameterString = [folderFieldsArray componentsJoinedByString:@","];
+        _fullBookmarkFieldsParameterString = [bookmarkFieldsArray componentsJoinedByString:@","];
+        _fullCommentFieldsParameterString = [commentFieldsArray componentsJoinedByString:@","];
+        _fullUserFieldsParameterString = [userFieldsArray componentsJoinedByString:@","];
+        _fullCollaborationFieldsParameterString = [collaborationFieldsArray componentsJoinedByString:@","];
+
+        NSMutableOrderedSet *set = [NSMutableOrderedSet orderedSet];
+        [set addObjectsFromArray:folderFieldsArray];
+        [set addObjectsFromArray:fileFieldsArray];
+        [set addObjectsFromArray:bookmarkFieldsArray];
+        _itemFieldsArray = [set array];
+        _fullItemFieldsParameterString = [_itemFieldsArray componentsJoinedByString:@","];
+
+        _itemFieldsParameterStringsByExcludedFields = [[NSCache alloc] init];
+        _itemFieldsParameterStringsByExcludedFields.countLimit = BOX_REQUEST_TEMPLATE_EXCLUDED_FIELDS_MEMO_LIMIT;
+    }
+    return self;
+}
+
+- (NSString *)fullItemFieldsParameterStringExcludingFields:(NSArray *)excludedFields
+{
+    if (excludedFields.count == 0) {
+        return self.fullItemFieldsParameterString;
+    }
+
+    NSArray *key = [excludedFields copy];
+    NSString *fieldsString = [self.itemFieldsParameterStringsByExcludedFields objectForKey:key];
+    if (fieldsString == nil) {
+        NSMutableOrderedSet *set = [NSMutableOrderedSet orderedSetWithArray:self.itemFieldsArray];
+        [set removeObjectsInArray:excludedFields];
+        fieldsString = [[set array] componentsJoinedByString:@","];
+        [self.itemFieldsParameterStringsByExcludedFields setObject:fieldsString forKey:key];
+    }
+    return fieldsString;
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  BOXAPIEmulator.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXCannedResponse;
+
+// In-memory emulation of the parts of the Box API the SDK's requests use, for tests of flows that change state:
+// upload then list, move then events, and long soak tests of sync, bulk operations and caches.
+//
+// It holds folders, files and their versions, trash, metadata instances, representations and the event stream,
+// and answers:
+//  - folders: info, items, create, update (rename and move), copy, delete and restore from the trash;
+//  - files: info, update, copy, delete, restore from the trash, download (including single byte ranges), upload, upload of a new version
+//    and versions;
+//  - metadata instances: list, get, create, update with JSON Patch and delete;
+//  - representations: info and content, listed with the file when the representations field is requested;
+//  - events, search and OAuth2 token refreshes.
+//
+// Items are indexed by ID and by name within their folder, so listing a page, resolving a name conflict or
+// applying an update does not depend on the number of items held, and search scans them in creation order
+// without sorting. Install it with BOXAPIEmulatorURLProtocol.
+@interface BOXAPIEmulator : NSObject
+
+// If set, requests signed with any other token are rejected with an invalid_token error. Token refreshes
+// change it.
+@property (atomic, readwrite, copy) NSString *accessToken;
+
+// Whether the bytes of uploaded files are kept, so that downloads return them. Defaults to YES. Turn it off
+// for soak tests, downloads then return filler of the right size.
+@property (atomic, readwrite, assign) BOOL storesFileContents;
+
+@property (atomic, readonly, assign) NSUInteger requestCount;
+
+- (NSUInteger)itemCount;
+
+// Direct access to the store, bypassing requests, to set up a test.
+- (NSString *)createFolderWithName:(NSString *)name parentID:(NSString *)parentID;
+- (NSString *)createFileWithName:(NSString *)name parentID:(NSString *)parentID data:(NSData *)data;
+
+// Creates fileCount empty files named "file <n>" in the folder. Returns their IDs.
+- (NSArray<NSString *> *)populateFolderWithID:(NSString *)folderID fileCount:(NSUInteger)fileCount;
+
+// The JSON the API would return for the item, or nil if there is no such item.
+- (NSDictionary *)JSONForItemWithID:(NSString *)itemID;
+
+// Applies the request to the store. body is the HTTP body of the request, if any.
+- (BOXCannedResponse *)responseForRequest:(NSURLRequest *)request body:(NSData *)body;
+
+@end
@@ -0,0 +1,952 @@
+//
+//  BOXAPIEmulator.m
+//  BoxContentSDK
+//
+
+#import "BOXAPIEmulator.h"
+#import "BOXCannedResponse.h"
+#import <CommonCrypto/CommonDigest.h>
+
+#define BOX_API_EMULATOR_ROOT_FOLDER_ID (@"0")
+#define BOX_API_EMULATOR_DEFAULT_LIMIT (100)
+#define BOX_API_EMULATOR_MAX_LIMIT (1000)
+
+@interface BOXEmulatedItem : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *type;
+@property (nonatomic, readwrite, copy) NSString *itemID;
+@property (nonatomic, readwrite, copy) NSString *name;
+@property (nonatomic, readwrite, copy) NSString *itemDescription;
+@property (nonatomic, readwrite, copy) NSString *parentID;
+@property (nonatomic, readwrite, assign) NSInteger sequenceID;
+@property (nonatomic, readwrite, strong) NSDate *createdAt;
+@property (nonatomic, readwrite, strong) NSDate *modifiedAt;
+@property (nonatomic, readwrite, assign) BOOL trashed;
+
+// Folders only. Children are kept in creation order, and indexed by lowercased name for conflict checks.
+@property (nonatomic, readwrite, strong) NSMutableOrderedSet *childIDs;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *childIDsByName;
+
+// Files only.
+@property (nonatomic, readwrite, assign) unsigned long long size;
+@property (nonatomic, readwrite, copy) NSString *sha1;
+@property (nonatomic, readwrite, strong) NSData *data;
+@property (nonatomic, readwrite, copy) NSString *versionID;
+@property (nonatomic, readwrite, strong) NSMutableArray *previousVersions;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *metadataByKey;
+
+- (BOOL)isFolder;
+
+@end
+
+@implementation BOXEmulatedItem
+
+- (BOOL)isFolder
+{
+    return [self.type isEqualToString:@"folder"];
+}
+
+@end
+
+@interface BOXAPIEmulator ()
+
+@property (atomic, readwrite, assign) NSUInteger requestCount;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *itemsByID;
+// Every item ID in creation order, so that search can scan the store without sorting it.
+@property (nonatomic, readwrite, strong) NSMutableArray *itemIDs;
+@property (nonatomic, readwrite, strong) NSMutableArray *events;
+@property (nonatomic, readwrite, strong) NSDateFormatter *dateFormatter;
+@property (nonatomic, readwrite, assign) unsigned long long lastID;
+@property (nonatomic, readwrite, assign) NSUInteger tokenRefreshCount;
+
+@end
+
+@implementation BOXAPIEmulator
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _storesFileContents = YES;
+        _itemsByID = [NSMutableDictionary dictionary];
+        _itemIDs = [NSMutableArray array];
+        _events = [NSMutableArray array];
+        _lastID = 1000;
+
+        _dateFormatter = [[NSDateFormatter alloc] init];
+        _dateFormatter.locale = [NSLocale localeWithLocaleIdentifier:@"en_US_POSIX"];
+        _dateFormatter.timeZone = [NSTimeZone timeZoneForSecondsFromGMT:0];
+        _dateFormatter.dateFormat = @"yyyy-MM-dd'T'HH:mm:ssZZZZZ";
+
+        [self newItemWithID:BOX_API_EMULATOR_ROOT_FOLDER_ID type:@"folder" name:@"All Files" parentID:nil];
+    }
+    return self;
+}
+
+- (NSUInteger)itemCount
+{
+    @synchronized(self) {
+        return self.itemsByID.count;
+    }
+}
+
+#pragma mark - Seeding
+
+- (NSString *)createFolderWithName:(NSString *)name parentID:(NSString *)parentID
+{
+    @synchronized(self) {
+        return [self insertItemWithType:@"folder" name:name parentID:parentID data:nil].itemID;
+    }
+}
+
+- (NSString *)createFileWithName:(NSString *)name parentID:(NSString *)parentID data:(NSData *)data
+{
+    @synchronized(self) {
+        return [self insertItemWithType:@"file" name:name parentID:parentID data:data ?: [NSData data]].itemID;
+    }
+}
+
+- (NSArray<NSString *> *)populateFolderWithID:(NSString *)folderID fileCount:(NSUInteger)fileCount
+{
+    NSMutableArray *fileIDs = [NSMutableArray arrayWithCapacity:fileCount];
+    NSData *emptyData = [NSData data];
+    @synchronized(self) {
+        for (NSUInteger i = 0; i < fileCount; i++) {
+            @autoreleasepool {
+                NSString *name = [NSString stringWithFormat:@"file %lu", (unsigned long)i];
+                BOXEmulatedItem *file = [self insertItemWithType:@"file" name:name parentID:folderID data:emptyData];
+                if (file != nil) {
+                    [fileIDs addObject:file.itemID];
+                }
+            }
+        }
+    }
+    return fileIDs;
+}
+
+- (NSDictionary *)JSONForItemWithID:(NSString *)itemID
+{
+    @synchronized(self) {
+        BOXEmulatedItem *item = self.itemsByID[itemID];
+        return item ? [self JSONForItem:item fields:nil] : nil;
+    }
+}
+
+#pragma mark - Store
+
+- (BOXEmulatedItem *)newItemWithType:(NSString *)type name:(NSString *)name parentID:(NSString *)parentID
+{
+    return [self newItemWithID:[self nextID] type:type name:name parentID:parentID];
+}
+
+- (BOXEmulatedItem *)newItemWithID:(NSString *)itemID type:(NSString *)type name:(NSString *)name parentID:(NSString *)parentID
+{
+    BOXEmulatedItem *item = [[BOXEmulatedItem alloc] init];
+    item.type = type;
+    item.itemID = itemID;
+    item.name = name;
+    item.itemDescription = @"";
+    item.parentID = parentID;
+    item.createdAt = [NSDate date];
+    item.modifiedAt = item.createdAt;
+    if ([item isFolder]) {
+        item.childIDs = [NSMutableOrderedSet orderedSet];
+        item.childIDsByName = [NSMutableDictionary dictionary];
+    } else {
+        item.previousVersions = [NSMutableArray array];
+        item.metadataByKey = [NSMutableDictionary dictionary];
+    }
+    self.itemsByID[item.itemID] = item;
+    [self.itemIDs addObject:item.itemID];
+    return item;
+}
+
+- (NSString *)nextID
+{
+    self.lastID++;
+    return [NSString stringWithFormat:@"%llu", self.lastID];
+}
+
+- (BOXEmulatedItem *)insertItemWithType:(NSString *)type name:(NSString *)name parentID:(NSString *)parentID data:(NSData *)data
+{
+    BOXEmulatedItem *parent = [self folderWithID:parentID];
+    if (parent == nil || name.length == 0 || parent.childIDsByName[name.lowercaseString] != nil) {
+        return nil;
+    }
+    BOXEmulatedItem *item = [self newItemWithType:type name:name parentID:parentID];
+    if (![item isFolder]) {
+        [self setData:data ofFile:item];
+    }
+    [self addItem:item toFolder:parent];
+    return item;
+}
+
+- (BOXEmulatedItem *)folderWithID:(NSString *)folderID
+{
+    BOXEmulatedItem *folder = folderID ? self.itemsByID[folderID] : nil;
+    return ([folder isFolder] && !folder.trashed) ? folder : nil;
+}
+
+- (BOXEmulatedItem *)fileWithID:(NSString *)fileID
+{
+    BOXEmulatedItem *file = fileID ? self.itemsByID[fileID] : nil;
+    return (file != nil && ![file isFolder] && !file.trashed) ? file : nil;
+}
+
+- (void)addItem:(BOXEmulatedItem *)item toFolder:(BOXEmulatedItem *)folder
+{
+    item.parentID = folder.itemID;
+    [folder.childIDs addObject:item.itemID];
+    folder.childIDsByName[item.name.lowercaseString] = item.itemID;
+    folder.modifiedAt = [NSDate date];
+}
+
+- (void)removeItem:(BOXEmulatedItem *)item fromFolder:(BOXEmulatedItem *)folder
+{
+    [folder.childIDs removeObject:item.itemID];
+    [folder.childIDsByName removeObjectForKey:item.name.lowercaseString];
+    folder.modifiedAt = [NSDate date];
+}
+
+- (void)setData:(NSData *)data ofFile:(BOXEmulatedItem *)file
+{
+    unsigned char digest[CC_SHA1_DIGEST_LENGTH];
+    CC_SHA1(data.bytes, (CC_LONG)data.length, digest);
+    NSMutableString *sha1 = [NSMutableString stringWithCapacity:CC_SHA1_DIGEST_LENGTH * 2];
+    for (NSUInteger i = 0; i < CC_SHA1_DIGEST_LENGTH; i++) {
+        [sha1 appendFormat:@"%02x", digest[i]];
+    }
+
+    if (file.versionID != nil) {
+        [file.previousVersions addObject:[self versionJSONForFile:file]];
+    }
+    file.versionID = [self nextID];
+    file.size = data.length;
+    file.sha1 = sha1;
+    file.data = self.storesFileContents ? data : nil;
+    file.modifiedAt = [NSDate date];
+}
+
+- (void)touchItem:(BOXEmulatedItem *)item
+{
+    item.sequenceID++;
+    item.modifiedAt = [NSDate date];
+}
+
+- (void)trashItem:(BOXEmulatedItem *)item
+{
+    item.trashed = YES;
+    [self touchItem:item];
+    for (NSString *childID in item.childIDs) {
+        [self trashItem:self.itemsByID[childID]];
+    }
+}
+
+- (void)untrashItem:(BOXEmulatedItem *)item
+{
+    item.trashed = NO;
+    [self touchItem:item];
+    for (NSString *childID in item.childIDs) {
+        [self untrashItem:self.itemsByID[childID]];
+    }
+}
+
+- (BOXEmulatedItem *)copyItem:(BOXEmulatedItem *)item toFolder:(BOXEmulatedItem *)folder name:(NSString *)name
+{
+    BOXEmulatedItem *copy = [self newItemWithType:item.type name:name parentID:folder.itemID];
+    copy.itemDescription = item.itemDescription;
+    if ([item isFolder]) {
+        for (NSString *childID in item.childIDs) {
+            BOXEmulatedItem *child = self.itemsByID[childID];
+            [self copyItem:child toFolder:copy name:child.name];
+        }
+    } else {
+        copy.versionID = [self nextID];
+        copy.size = item.size;
+        copy.sha1 = item.sha1;
+        copy.data = item.data;
+        copy.metadataByKey = [[NSMutableDictionary alloc] initWithDictionary:item.metadataByKey copyItems:YES];
+    }
+    [self addItem:copy toFolder:folder];
+    return copy;
+}
+
+- (BOOL)isFolder:(BOXEmulatedItem *)folder insideItem:(BOXEmulatedItem *)item
+{
+    for (BOXEmulatedItem *ancestor = folder; ancestor != nil; ancestor = self.itemsByID[ancestor.parentID]) {
+        if ([ancestor.itemID isEqualToString:item.itemID]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (void)recordEventOfType:(NSString *)eventType item:(BOXEmulatedItem *)item
+{
+    [self.events addObject:@{@"type" : @"event",
+                             @"event_id" : [[NSUUID UUID] UUIDString],
+                             @"event_type" : eventType,
+                             @"created_at" : [self.dateFormatter stringFromDate:[NSDate date]],
+                             @"source" : [self JSONForItem:item fields:nil]}];
+}
+
+#pragma mark - JSON
+
+- (NSDictionary *)miniJSONForItem:(BOXEmulatedItem *)item
+{
+    NSMutableDictionary *JSON = [NSMutableDictionary dictionaryWithDictionary:@{@"type" : item.type,
+                                                                                 @"id" : item.itemID,
+                                                                                 @"name" : item.name}];
+    if (![item.itemID isEqualToString:BOX_API_EMULATOR_ROOT_FOLDER_ID]) {
+        JSON[@"etag"] = [@(item.sequenceID) stringValue];
+        JSON[@"sequence_id"] = [@(item.sequenceID) stringValue];
+    }
+    if (![item isFolder]) {
+        JSON[@"sha1"] = item.sha1;
+    }
+    return JSON;
+}
+
+- (NSDictionary *)JSONForItem:(BOXEmulatedItem *)item fields:(NSString *)fields
+{
+    NSMutableDictionary *JSON = [NSMutableDictionary dictionaryWithDictionary:[self miniJSONForItem:item]];
+    JSON[@"description"] = item.itemDescription;
+    JSON[@"created_at"] = [self.dateFormatter stringFromDate:item.createdAt];
+    JSON[@"modified_at"] = [self.dateFormatter stringFromDate:item.modifiedAt];
+    JSON[@"item_status"] = item.trashed ? @"trashed" : @"active";
+
+    NSMutableArray *pathEntries = [NSMutableArray array];
+    for (BOXEmulatedItem *ancestor = self.itemsByID[item.parentID]; ancestor != nil; ancestor = self.itemsByID[ancestor.parentID]) {
+        [pathEntries insertObject:[self miniJSONForItem:ancestor] atIndex:0];
+    }
+    JSON[@"path_collection"] = @{@"total_count" : @(pathEntries.count), @"entries" : pathEntries};
+    BOXEmulatedItem *parent = self.itemsByID[item.parentID];
+    JSON[@"parent"] = parent ? [self miniJSONForItem:parent] : [NSNull null];
+
+    if ([item isFolder]) {
+        JSON[@"size"] = @(0);
+    } else {
+        JSON[@"size"] = @(item.size);
+        JSON[@"file_version"] = @{@"type" : @"file_version", @"id" : item.versionID, @"sha1" : item.sha1};
+        if ([fields rangeOfString:@"representations"].location != NSNotFound) {
+            JSON[@"representations"] = @{@"entries" : [self representationsJSONForFile:item]};
+        }
+    }
+    return JSON;
+}
+
+- (NSDictionary *)versionJSONForFile:(BOXEmulatedItem *)file
+{
+    return @{@"type" : @"file_version",
+             @"id" : file.versionID,
+             @"sha1" : file.sha1,
+             @"name" : file.name,
+             @"size" : @(file.size),
+             @"created_at" : [self.dateFormatter stringFromDate:file.modifiedAt],
+             @"modified_at" : [self.dateFormatter stringFromDate:file.modifiedAt]};
+}
+
+- (NSArray *)representationsJSONForFile:(BOXEmulatedItem *)file
+{
+    NSMutableArray *representations = [NSMutableArray array];
+    for (NSString *dimensions in @[@"32x32", @"320x320", @"1024x1024"]) {
+        NSString *representationURL = [NSString stringWithFormat:@"https://api.box.com/2.0/internal_files/%@/versions/%@/representations/jpg_%@",
+                                        file.itemID, file.versionID, dimensions];
+        [representations addObject:@{@"representation" : @"jpg",
+                                      @"properties" : @{@"dimensions" : dimensions},
+                                      @"info" : @{@"url" : representationURL},
+                                      @"status" : @{@"state" : @"success"},
+                                      @"content" : @{@"url_template" : [representationURL stringByAppendingString:@"/content/{+asset_path}"]}}];
+    }
+    return representations;
+}
+
+- (NSDictionary *)metadataJSON:(NSDictionary *)values file:(BOXEmulatedItem *)file key:(NSString *)key
+{
+    NSArray *keyComponents = [key componentsSeparatedByString:@"/"];
+    NSMutableDictionary *JSON = [NSMutableDictionary dictionaryWithDictionary:values];
+    JSON[@"$id"] = [NSString stringWithFormat:@"%@-%@", file.itemID, key];
+    JSON[@"$type"] = [NSString stringWithFormat:@"%@-%@", keyComponents.lastObject, file.itemID];
+    JSON[@"$parent"] = [NSString stringWithFormat:@"file_%@", file.itemID];
+    JSON[@"$scope"] = keyComponents.firstObject;
+    JSON[@"$template"] = keyComponents.lastObject;
+    return JSON;
+}
+
+#pragma mark - Responses
+
+- (BOXCannedResponse *)responseForRequest:(NSURLRequest *)request body:(NSData *)body
+{
+    @synchronized(self) {
+        self.requestCount++;
+    }
+
+    NSArray *pathComponents = request.URL.pathComponents;
+    if ([request.URL.path hasSuffix:@"/oauth2/token"]) {
+        return [self tokenResponseForRequest:request];
+    }
+
+    NSString *accessToken = self.accessToken;
+    if (accessToken != nil) {
+        NSString *authorization = [request valueForHTTPHeaderField:@"Authorization"];
+        if (![authorization isEqualToString:[@"Bearer " stringByAppendingString:accessToken]]) {
+            return [self responseForRequest:request
+                                 statusCode:401
+                               headerFields:@{@"WWW-Authenticate" : @"Bearer realm=\"Service\", error=\"invalid_token\""}
+                                 JSONObject:nil];
+        }
+    }
+
+    NSUInteger versionIndex = [pathComponents indexOfObject:@"2.0"];
+    if (versionIndex == NSNotFound) {
+        return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+    }
+    NSArray *resource = [pathComponents subarrayWithRange:NSMakeRange(versionIndex + 1, pathComponents.count - versionIndex - 1)];
+
+    NSMutableDictionary *queryParameters = [NSMutableDictionary dictionary];
+    for (NSURLQueryItem *queryItem in [NSURLComponents componentsWithURL:request.URL resolvingAgainstBaseURL:NO].queryItems) {
+        queryParameters[queryItem.name] = queryItem.value ?: @"";
+    }
+
+    @synchronized(self) {
+        NSString *resourceName = resource.firstObject;
+        if ([resourceName isEqualToString:@"folders"]) {
+            return [self folderResponseForRequest:request resource:resource query:queryParameters body:body];
+        } else if ([resourceName isEqualToString:@"files"]) {
+            return [self fileResponseForRequest:request resource:resource query:queryParameters body:body];
+        } else if ([resourceName isEqualToString:@"events"]) {
+            return [self eventsResponseForRequest:request query:queryParameters];
+        } else if ([resourceName isEqualToString:@"search"]) {
+            return [self searchResponseForRequest:request query:queryParameters];
+        } else if ([resourceName isEqualToString:@"internal_files"]) {
+            return [self representationResponseForRequest:request resource:resource];
+        }
+        return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+    }
+}
+
+- (BOXCannedResponse *)tokenResponseForRequest:(NSURLRequest *)request
+{
+    NSString *accessToken = nil;
+    @synchronized(self) {
+        self.tokenRefreshCount++;
+        accessToken = [NSString stringWithFormat:@"emulator_access_token_%lu", (unsigned long)self.tokenRefreshCount];
+        if (self.accessToken != nil) {
+            self.accessToken = accessToken;
+        }
+    }
+    return [self responseForRequest:request
+                         statusCode:200
+                       headerFields:nil
+                         JSONObject:@{@"access_token" : accessToken,
+                                      @"refresh_token" : [NSString stringWithFormat:@"emulator_refresh_token_%lu", (unsigned long)self.tokenRefreshCount],
+                                      @"expires_in" : @(3600),
+                                      @"token_type" : @"bearer"}];
+}
+
+- (BOXCannedResponse *)folderResponseForRequest:(NSURLRequest *)request
+                                       resource:(NSArray *)resource
+                                          query:(NSDictionary *)query
+                                           body:(NSData *)body
+{
+    NSString *method = request.HTTPMethod;
+    NSDictionary *JSONBody = body.length > 0 ? [NSJSONSerialization JSONObjectWithData:body options:0 error:nil] : nil;
+    NSString *fields = query[@"fields"];
+
+    // POST /folders
+    if (resource.count == 1 && [method isEqualToString:@"POST"]) {
+        BOXEmulatedItem *parent = [self folderWithID:JSONBody[@"parent"][@"id"]];
+        if (parent == nil) {
+            return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+        }
+        BOXCannedResponse *conflictResponse = [self conflictResponseForRequest:request name:JSONBody[@"name"] inFolder:parent excludingItem:nil];
+        if (conflictResponse != nil) {
+            return conflictResponse;
+        }
+        BOXEmulatedItem *folder = [self insertItemWithType:@"folder" name:JSONBody[@"name"] parentID:parent.itemID data:nil];
+        [self recordEventOfType:@"ITEM_CREATE" item:folder];
+        return [self responseForRequest:request statusCode:201 headerFields:nil JSONObject:[self JSONForItem:folder fields:fields]];
+    }
+
+    // POST /folders/{id}, restoring the folder from the trash.
+    BOXEmulatedItem *trashedFolder = resource.count == 2 ? self.itemsByID[resource[1]] : nil;
+    if ([trashedFolder isFolder] && trashedFolder.trashed && [method isEqualToString:@"POST"]) {
+        return [self restoreResponseForRequest:request item:trashedFolder JSONBody:JSONBody fields:fields];
+    }
+
+    BOXEmulatedItem *folder = resource.count > 1 ? [self folderWithID:resource[1]] : nil;
+    if (folder == nil) {
+        return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+    }
+
+    // /folders/{id}
+    if (resource.count == 2) {
+        if ([method isEqualToString:@"GET"]) {
+            return [self responseForRequest:request statusCode:200 headerFields:nil JSONObject:[self JSONForItem:folder fields:fields]];
+        } else if ([method isEqualToString:@"PUT"]) {
+            return [self updateResponseForRequest:request item:folder JSONBody:JSONBody fields:fields];
+        } else if ([method isEqualToString:@"DELETE"]) {
+            if (folder.childIDs.count > 0 && ![query[@"recursive"] isEqualToString:@"true"]) {
+                return [self errorResponseForRequest:request statusCode:400 code:@"folder_not_empty" contextInfo:nil];
+            }
+            [self removeItem:folder fromFolder:self.itemsByID[folder.parentID]];
+            [self trashItem:folder];
+            [self recordEventOfType:@"ITEM_TRASH" item:folder];
+            return [self responseForRequest:request statusCode:204 headerFields:nil JSONObject:nil];
+        }
+    }
+
+    // GET /folders/{id}/items
+    if (resource.count == 3 && [resource[2] isEqualToString:@"items"] && [method isEqualToString:@"GET"]) {
+        return [self itemsResponseForRequest:request itemIDs:folder.childIDs.array query:query];
+    }
+
+    // POST /folders/{id}/copy
+    if (resource.count == 3 && [resource[2] isEqualToString:@"copy"] && [method isEqualToString:@"POST"]) {
+        return [self copyResponseForRequest:request item:folder JSONBody:JSONBody fields:fields];
+    }
+
+    return [self errorResponseForRequest:request statusCode:405 code:@"method_not_allowed" contextInfo:nil];
+}
+
+- (BOXCannedResponse *)fileResponseForRequest:(NSURLRequest *)request
+                                     resource:(NSArray *)resource
+                                        query:(NSDictionary *)query
+                                         body:(NSData *)body
+{
+    NSString *method = request.HTTPMethod;
+    NSString *fields = query[@"fields"];
+
+    // POST /files/content, on the upload host.
+    if (resource.count == 2 && [resource[1] isEqualToString:@"content"] && [method isEqualToString:@"POST"]) {
+        return [self uploadResponseForRequest:request file:nil body:body fields:fields];
+    }
+
+    // POST /files/{id}, restoring the file from the trash.
+    BOXEmulatedItem *trashedFile = resource.count == 2 ? self.itemsByID[resource[1]] : nil;
+    if (trashedFile != nil && ![trashedFile isFolder] && trashedFile.trashed && [method isEqualToString:@"POST"]) {
+        NSDictionary *JSONBody = body.length > 0 ? [NSJSONSerialization JSONObjectWithData:body options:0 error:nil] : nil;
+        return [self restoreResponseForRequest:request item:trashedFile JSONBody:JSONBody fields:fields];
+    }
+
+    BOXEmulatedItem *file = resource.count > 1 ? [self fileWithID:resource[1]] : nil;
+    if (file == nil) {
+        return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+    }
+    NSString *subresource = resource.count > 2 ? resource[2] : nil;
+
+    if (subresource == nil) {
+        if ([method isEqualToString:@"GET"]) {
+            return [self responseForRequest:request statusCode:200 headerFields:nil JSONObject:[self JSONForItem:file fields:fields]];
+        } else if ([method isEqualToString:@"PUT"]) {
+            NSDictionary *JSONBody = body.length > 0 ? [NSJSONSerialization JSONObjectWithData:body options:0 error:nil] : nil;
+            return [self updateResponseForRequest:request item:file JSONBody:JSONBody fields:fields];
+        } else if ([method isEqualToString:@"DELETE"]) {
+            [self removeItem:file fromFolder:self.itemsByID[file.parentID]];
+            [self trashItem:file];
+            [self recordEventOfType:@"ITEM_TRASH" item:file];
+            return [self responseForRequest:request statusCode:204 headerFields:nil JSONObject:nil];
+        }
+    } else if ([subresource isEqualToString:@"content"]) {
+        if ([method isEqualToString:@"GET"]) {
+            return [self contentResponseForRequest:request data:file.data length:file.size contentType:@"application/octet-stream"];
+        } else if ([method isEqualToString:@"POST"]) {
+            return [self uploadResponseForRequest:request file:file body:body fields:fields];
+        }
+    } else if ([subresource isEqualToString:@"versions"] && [method isEqualToString:@"GET"]) {
+        NSArray *versions = [[file.previousVersions reverseObjectEnumerator] allObjects];
+        return [self responseForRequest:request
+                             statusCode:200
+                           headerFields:nil
+                             JSONObject:@{@"total_count" : @(versions.count), @"entries" : versions}];
+    } else if ([subresource isEqualToString:@"copy"] && [method isEqualToString:@"POST"]) {
+        NSDictionary *JSONBody = body.length > 0 ? [NSJSONSerialization JSONObjectWithData:body options:0 error:nil] : nil;
+        return [self copyResponseForRequest:request item:file JSONBody:JSONBody fields:fields];
+    } else if ([subresource isEqualToString:@"metadata"]) {
+        return [self metadataResponseForRequest:request file:file resource:resource body:body];
+    }
+
+    return [self errorResponseForRequest:request statusCode:405 code:@"method_not_allowed" contextInfo:nil];
+}
+
+- (BOXCannedResponse *)itemsResponseForRequest:(NSURLRequest *)request itemIDs:(NSArray *)itemIDs query:(NSDictionary *)query
+{
+    NSUInteger offset = (NSUInteger)MAX([query[@"offset"] integerValue], 0);
+    NSInteger requestedLimit = [query[@"limit"] integerValue];
+    NSUInteger limit = requestedLimit > 0 ? MIN((NSUInteger)requestedLimit, BOX_API_EMULATOR_MAX_LIMIT) : BOX_API_EMULATOR_DEFAULT_LIMIT;
+
+    NSMutableArray *entries = [NSMutableArray array];
+    for (NSUInteger i = offset; i < itemIDs.count && entries.count < limit; i++) {
+        [entries addObject:[self JSONForItem:self.itemsByID[itemIDs[i]] fields:query[@"fields"]]];
+    }
+    return [self responseForRequest:request
+                         statusCode:200
+                       headerFields:nil
+                         JSONObject:@{@"total_count" : @(itemIDs.count),
+                                      @"offset" : @(offset),
+                                      @"limit" : @(limit),
+                                      @"entries" : entries}];
+}
+
+- (BOXCannedResponse *)updateResponseForRequest:(NSURLRequest *)request
+                                           item:(BOXEmulatedItem *)item
+                                       JSONBody:(NSDictionary *)JSONBody
+                                         fields:(NSString *)fields
+{
+    BOXEmulatedItem *parent = self.itemsByID[item.parentID];
+    BOXEmulatedItem *destination = parent;
+    NSString *newParentID = JSONBody[@"parent"][@"id"];
+    if (newParentID != nil) {
+        destination = [self folderWithID:newParentID];
+        if (destination == nil) {
+            return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+        }
+        if ([item isFolder] && [self isFolder:destination insideItem:item]) {
+            return [self errorResponseForRequest:request statusCode:400 code:@"bad_request" contextInfo:nil];
+        }
+    }
+    NSString *name = JSONBody[@"name"] ?: item.name;
+    BOXCannedResponse *conflictResponse = [self conflictResponseForRequest:request name:name inFolder:destination excludingItem:item];
+    if (conflictResponse != nil) {
+        return conflictResponse;
+    }
+
+    BOOL moved = destination != parent;
+    BOOL renamed = ![name isEqualToString:item.name];
+    if (moved || renamed) {
+        [self removeItem:item fromFolder:parent];
+        item.name = name;
+        [self addItem:item toFolder:destination];
+    }
+    if (JSONBody[@"description"] != nil) {
+        item.itemDescription = JSONBody[@"description"];
+    }
+    [self touchItem:item];
+
+    if (moved) {
+        [self recordEventOfType:@"ITEM_MOVE" item:item];
+    } else if (renamed) {
+        [self recordEventOfType:@"ITEM_RENAME" item:item];
+    }
+    return [self responseForRequest:request statusCode:200 headerFields:nil JSONObject:[self JSONForItem:item fields:fields]];
+}
+
+- (BOXCannedResponse *)copyResponseForRequest:(NSURLRequest *)request
+                                         item:(BOXEmulatedItem *)item
+                                     JSONBody:(NSDictionary *)JSONBody
+                                       fields:(NSString *)fields
+{
+    BOXEmulatedItem *destination = [self folderWithID:JSONBody[@"parent"][@"id"]];
+    if (destination == nil) {
+        return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+    }
+    if ([item isFolder] && [self isFolder:destination insideItem:item]) {
+        return [self errorResponseForRequest:request statusCode:400 code:@"bad_request" contextInfo:nil];
+    }
+    NSString *name = JSONBody[@"name"] ?: item.name;
+    BOXCannedResponse *conflictResponse = [self conflictResponseForRequest:request name:name inFolder:destination excludingItem:nil];
+    if (conflictResponse != nil) {
+        return conflictResponse;
+    }
+
+    BOXEmulatedItem *copy = [self copyItem:item toFolder:destination name:name];
+    [self recordEventOfType:@"ITEM_COPY" item:copy];
+    return [self responseForRequest:request statusCode:201 headerFields:nil JSONObject:[self JSONForItem:copy fields:fields]];
+}
+
+- (BOXCannedResponse *)restoreResponseForRequest:(NSURLRequest *)request
+                                            item:(BOXEmulatedItem *)item
+                                        JSONBody:(NSDictionary *)JSONBody
+                                          fields:(NSString *)fields
+{
+    // The item goes back to the folder it was trashed from unless the request names another one, and either
+    // must still be live.
+    BOXEmulatedItem *destination = [self folderWithID:JSONBody[@"parent"][@"id"] ?: item.parentID];
+    if (destination == nil) {
+        return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+    }
+    NSString *name = JSONBody[@"name"] ?: item.name;
+    BOXCannedResponse *conflictResponse = [self conflictResponseForRequest:request name:name inFolder:destination excludingItem:nil];
+    if (conflictResponse != nil) {
+        return conflictResponse;
+    }
+
+    item.name = name;
+    [self addItem:item toFolder:destination];
+    [self untrashItem:item];
+    [self recordEventOfType:@"ITEM_UNDELETE_VIA_TRASH" item:item];
+    return [self responseForRequest:request statusCode:201 headerFields:nil JSONObject:[self JSONForItem:item fields:fields]];
+}
+
+- (BOXCannedResponse *)uploadResponseForRequest:(NSURLRequest *)request
+                                           file:(BOXEmulatedItem *)file
+                                           body:(NSData *)body
+                                         fields:(NSString *)fields
+{
+    NSDictionary *parts = [self multipartPartsOfBody:body request:request];
+    NSData *data = parts[@"file"] ?: [NSData data];
+
+    if (file != nil) {
+        [self setData:data ofFile:file];
+        [self touchItem:file];
+        [self recordEventOfType:@"ITEM_UPLOAD" item:file];
+        return [self responseForRequest:request statusCode:201 headerFields:nil JSONObject:[self JSONForItem:file fields:fields]];
+    }
+
+    NSString *name = [[NSString alloc] initWithData:parts[@"name"] ?: [NSData data] encoding:NSUTF8StringEncoding];
+    NSString *parentID = [[NSString alloc] initWithData:parts[@"parent_id"] ?: [NSData data] encoding:NSUTF8StringEncoding];
+    BOXEmulatedItem *parent = [self folderWithID:parentID];
+    if (parent == nil) {
+        return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+    }
+    BOXCannedResponse *conflictResponse = [self conflictResponseForRequest:request name:name inFolder:parent excludingItem:nil];
+    if (conflictResponse != nil) {
+        return conflictResponse;
+    }
+
+    file = [self insertItemWithType:@"file" name:name parentID:parent.itemID data:data];
+    [self recordEventOfType:@"ITEM_UPLOAD" item:file];
+    return [self responseForRequest:request statusCode:201 headerFields:nil JSONObject:[self JSONForItem:file fields:fields]];
+}
+
+- (BOXCannedResponse *)metadataResponseForRequest:(NSURLRequest *)request
+                                             file:(BOXEmulatedItem *)file
+                                         resource:(NSArray *)resource
+                                             body:(NSData *)body
+{
+    NSString *method = request.HTTPMethod;
+
+    // GET /files/{id}/metadata
+    if (resource.count == 3 && [method isEqualToString:@"GET"]) {
+        NSMutableArray *entries = [NSMutableArray array];
+        for (NSString *key in [file.metadataByKey.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+            [entries addObject:[self metadataJSON:file.metadataByKey[key] file:file key:key]];
+        }
+        return [self responseForRequest:request statusCode:200 headerFields:nil JSONObject:@{@"entries" : entries}];
+    }
+    if (resource.count != 5) {
+        return [self errorResponseForRequest:request statusCode:405 code:@"method_not_allowed" contextInfo:nil];
+    }
+
+    NSString *key = [NSString stringWithFormat:@"%@/%@", resource[3], resource[4]];
+    NSMutableDictionary *values = file.metadataByKey[key];
+    id JSONBody = body.length > 0 ? [NSJSONSerialization JSONObjectWithData:body options:0 error:nil] : nil;
+
+    if ([method isEqualToString:@"POST"]) {
+        if (values != nil) {
+            return [self errorResponseForRequest:request statusCode:409 code:@"tuple_already_exists" contextInfo:nil];
+        }
+        values = [NSMutableDictionary dictionaryWithDictionary:[JSONBody isKindOfClass:[NSDictionary class]] ? JSONBody : @{}];
+        file.metadataByKey[key] = values;
+        return [self responseForRequest:request statusCode:201 headerFields:nil JSONObject:[self metadataJSON:values file:file key:key]];
+    }
+    if (values == nil) {
+        return [self errorResponseForRequest:request statusCode:404 code:@"instance_not_found" contextInfo:nil];
+    }
+    if ([method isEqualToString:@"GET"]) {
+        return [self responseForRequest:request statusCode:200 headerFields:nil JSONObject:[self metadataJSON:values file:file key:key]];
+    } else if ([method isEqualToString:@"DELETE"]) {
+        [file.metadataByKey removeObjectForKey:key];
+        return [self responseForRequest:request statusCode:204 headerFields:nil JSONObject:nil];
+    } else if ([method isEqualToString:@"PUT"]) {
+        // JSON Patch is applied atomically: a failed operation leaves the instance unchanged.
+        NSMutableDictionary *patched = [values mutableCopy];
+        for (NSDictionary *operation in [JSONBody isKindOfClass:[NSArray class]] ? JSONBody : @[]) {
+            NSString *op = operation[@"op"];
+            NSString *path = [operation[@"path"] hasPrefix:@"/"] ? [operation[@"path"] substringFromIndex:1] : operation[@"path"];
+            id value = operation[@"value"];
+            BOOL exists = path != nil && patched[path] != nil;
+            if ([op isEqualToString:@"test"] && (!exists || ![patched[path] isEqual:value])) {
+                return [self errorResponseForRequest:request statusCode:409 code:@"conflict" contextInfo:nil];
+            } else if (([op isEqualToString:@"replace"] || [op isEqualToString:@"remove"]) && !exists) {
+                return [self errorResponseForRequest:request statusCode:400 code:@"bad_request" contextInfo:nil];
+            } else if ([op isEqualToString:@"add"] || [op isEqualToString:@"replace"]) {
+                if (path == nil || value == nil) {
+                    return [self errorResponseForRequest:request statusCode:400 code:@"bad_request" contextInfo:nil];
+                }
+                patched[path] = value;
+            } else if ([op isEqualToString:@"remove"]) {
+                [patched removeObjectForKey:path];
+            }
+        }
+        file.metadataByKey[key] = patched;
+        return [self responseForRequest:request statusCode:200 headerFields:nil JSONObject:[self metadataJSON:patched file:file key:key]];
+    }
+
+    return [self errorResponseForRequest:request statusCode:405 code:@"method_not_allowed" contextInfo:nil];
+}
+
+- (BOXCannedResponse *)eventsResponseForRequest:(NSURLRequest *)request query:(NSDictionary *)query
+{
+    NSString *streamPosition = query[@"stream_position"];
+    NSUInteger position = 0;
+    if ([streamPosition isEqualToString:@"now"]) {
+        position = self.events.count;
+    } else if (streamPosition != nil) {
+        position = MIN((NSUInteger)MAX(streamPosition.longLongValue, 0), self.events.count);
+    }
+    NSInteger requestedLimit = [query[@"limit"] integerValue];
+    NSUInteger limit = requestedLimit > 0 ? MIN((NSUInteger)requestedLimit, BOX_API_EMULATOR_MAX_LIMIT) : BOX_API_EMULATOR_DEFAULT_LIMIT;
+    NSArray *entries = [self.events subarrayWithRange:NSMakeRange(position, MIN(limit, self.events.count - position))];
+
+    return [self responseForRequest:request
+                         statusCode:200
+                       headerFields:nil
+                         JSONObject:@{@"chunk_size" : @(entries.count),
+                                      @"next_stream_position" : @(position + entries.count),
+                                      @"entries" : entries}];
+}
+
+- (BOXCannedResponse *)searchResponseForRequest:(NSURLRequest *)request query:(NSDictionary *)query
+{
+    NSString *searchQuery = query[@"query"];
+    if (searchQuery.length == 0) {
+        return [self errorResponseForRequest:request statusCode:400 code:@"bad_request" contextInfo:nil];
+    }
+
+    NSMutableArray *matchingIDs = [NSMutableArray array];
+    for (NSString *itemID in self.itemIDs) {
+        BOXEmulatedItem *item = self.itemsByID[itemID];
+        if (!item.trashed && ![itemID isEqualToString:BOX_API_EMULATOR_ROOT_FOLDER_ID] &&
+            [item.name rangeOfString:searchQuery options:NSCaseInsensitiveSearch].location != NSNotFound) {
+            [matchingIDs addObject:itemID];
+        }
+    }
+    return [self itemsResponseForRequest:request itemIDs:matchingIDs query:query];
+}
+
+- (BOXCannedResponse *)representationResponseForRequest:(NSURLRequest *)request resource:(NSArray *)resource
+{
+    // internal_files/{id}/versions/{version}/representations/{representation}[/content/{asset}]
+    BOXEmulatedItem *file = resource.count > 1 ? [self fileWithID:resource[1]] : nil;
+    if (file == nil || resource.count < 6) {
+        return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+    }
+    if (resource.count > 6 && [resource[6] isEqualToString:@"content"]) {
+        // A rendition is a fraction of the original, but never empty.
+        return [self contentResponseForRequest:request data:nil length:MAX(file.size / 10, 1024) contentType:@"image/jpeg"];
+    }
+    NSString *dimensions = [resource[5] componentsSeparatedByString:@"_"].lastObject;
+    for (NSDictionary *representation in [self representationsJSONForFile:file]) {
+        if ([representation[@"properties"][@"dimensions"] isEqualToString:dimensions]) {
+            return [self responseForRequest:request statusCode:200 headerFields:nil JSONObject:representation];
+        }
+    }
+    return [self errorResponseForRequest:request statusCode:404 code:@"not_found" contextInfo:nil];
+}
+
+- (BOXCannedResponse *)conflictResponseForRequest:(NSURLRequest *)request
+                                             name:(NSString *)name
+                                         inFolder:(BOXEmulatedItem *)folder
+                                    excludingItem:(BOXEmulatedItem *)item
+{
+    if (name.length == 0) {
+        return [self errorResponseForRequest:request statusCode:400 code:@"bad_request" contextInfo:nil];
+    }
+    NSString *conflictingID = folder.childIDsByName[name.lowercaseString];
+    if (conflictingID == nil || [conflictingID isEqualToString:item.itemID]) {
+        return nil;
+    }
+    NSDictionary *conflict = [self miniJSONForItem:self.itemsByID[conflictingID]];
+    return [self errorResponseForRequest:request statusCode:409 code:@"item_name_in_use" contextInfo:@{@"conflicts" : @[conflict]}];
+}
+
+#pragma mark - Wire format
+
+- (NSDictionary *)multipartPartsOfBody:(NSData *)body request:(NSURLRequest *)request
+{
+    NSString *contentType = [request valueForHTTPHeaderField:@"Content-Type"];
+    NSRange boundaryRange = [contentType rangeOfString:@"boundary="];
+    if (boundaryRange.location == NSNotFound || body.length == 0) {
+        return @{};
+    }
+    NSString *boundary = [contentType substringFromIndex:NSMaxRange(boundaryRange)];
+    NSData *delimiter = [[@"--" stringByAppendingString:boundary] dataUsingEncoding:NSUTF8StringEncoding];
+    NSData *headerTerminator = [@"\r\n\r\n" dataUsingEncoding:NSUTF8StringEncoding];
+
+    NSMutableDictionary *parts = [NSMutableDictionary dictionary];
+    NSRange searchRange = NSMakeRange(0, body.length);
+    NSRange delimiterRange = [body rangeOfData:delimiter options:0 range:searchRange];
+    while (delimiterRange.location != NSNotFound) {
+        NSUInteger partStart = NSMaxRange(delimiterRange);
+        NSRange nextDelimiterRange = [body rangeOfData:delimiter options:0 range:NSMakeRange(partStart, body.length - partStart)];
+        if (nextDelimiterRange.location == NSNotFound) {
+            break;
+        }
+        NSRange headerEndRange = [body rangeOfData:headerTerminator options:0 range:NSMakeRange(partStart, nextDelimiterRange.location - partStart)];
+        if (headerEndRange.location != NSNotFound) {
+            NSString *headers = [[NSString alloc] initWithData:[body subdataWithRange:NSMakeRange(partStart, headerEndRange.location - partStart)]
+                                                      encoding:NSUTF8StringEncoding];
+            NSRange nameRange = [headers rangeOfString:@"name=\""];
+            if (nameRange.location != NSNotFound) {
+                NSString *nameStart = [headers substringFromIndex:NSMaxRange(nameRange)];
+                NSString *name = [nameStart substringToIndex:[nameStart rangeOfString:@"\""].location];
+                NSUInteger contentStart = NSMaxRange(headerEndRange);
+                // The part's content ends with the CRLF that precedes the next delimiter.
+                NSUInteger contentEnd = nextDelimiterRange.location >= contentStart + 2 ? nextDelimiterRange.location - 2 : contentStart;
+                parts[name] = [body subdataWithRange:NSMakeRange(contentStart, contentEnd - contentStart)];
+            }
+        }
+        delimiterRange = nextDelimiterRange;
+    }
+    return parts;
+}
+
+- (BOXCannedResponse *)contentResponseForRequest:(NSURLRequest *)request
+                                            data:(NSData *)data
+                                          length:(unsigned long long)length
+                                     contentType:(NSString *)contentType
+{
+    if (data == nil) {
+        NSMutableData *filler = [NSMutableData dataWithLength:(NSUInteger)length];
+        memset(filler.mutableBytes, 'e', filler.length);
+        data = filler;
+    }
+    NSMutableDictionary *headerFields = [NSMutableDictionary dictionaryWithObject:contentType forKey:@"Content-Type"];
+    NSInteger statusCode = 200;
+
+    // Single byte ranges, "bytes=<first>-<last>", are answered with a 206 like the API does.
+    NSString *range = [request valueForHTTPHeaderField:@"Range"];
+    if ([range hasPrefix:@"bytes="]) {
+        NSArray *bounds = [[range substringFromIndex:6] componentsSeparatedByString:@"-"];
+        unsigned long long first = [bounds.firstObject longLongValue];
+        unsigned long long last = bounds.count > 1 && [bounds[1] length] > 0 ? [bounds[1] longLongValue] : data.length - 1;
+        last = MIN(last, data.length - 1);
+        if (first <= last && first < data.length) {
+            headerFields[@"Content-Range"] = [NSString stringWithFormat:@"bytes %llu-%llu/%lu", first, last, (unsigned long)data.length];
+            data = [data subdataWithRange:NSMakeRange((NSUInteger)first, (NSUInteger)(last - first + 1))];
+            statusCode = 206;
+        }
+    }
+
+    headerFields[@"Content-Length"] = [NSString stringWithFormat:@"%lu", (unsigned long)data.length];
+    NSHTTPURLResponse *URLResponse = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:headerFields];
+    return [[BOXCannedResponse alloc] initWithURLResponse:URLResponse responseData:data];
+}
+
+- (BOXCannedResponse *)errorResponseForRequest:(NSURLRequest *)request
+                                    statusCode:(NSInteger)statusCode
+                                          code:(NSString *)code
+                                   contextInfo:(NSDictionary *)contextInfo
+{
+    NSMutableDictionary *JSON = [NSMutableDictionary dictionaryWithDictionary:@{@"type" : @"error",
+                                                                                 @"status" : @(statusCode),
+                                                                                 @"code" : code}];
+    if (contextInfo != nil) {
+        JSON[@"context_info"] = contextInfo;
+    }
+    return [self responseForRequest:request statusCode:statusCode headerFields:nil JSONObject:JSON];
+}
+
+- (BOXCannedResponse *)responseForRequest:(NSURLRequest *)request
+                               statusCode:(NSInteger)statusCode
+                             headerFields:(NSDictionary *)headerFields
+                               JSONObject:(id)JSONObject
+{
+    NSMutableDictionary *allHeaderFields = [NSMutableDictionary dictionaryWithObject:@"application/json" forKey:@"Content-Type"];
+    [allHeaderFields addEntriesFromDictionary:headerFields];
+    NSHTTPURLResponse *URLResponse = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:statusCode HTTPVersion:@"HTTP/1.1" headerFields:allHeaderFields];
+    NSData *data = JSONObject ? [NSJSONSerialization dataWithJSONObject:JSONObject options:0 error:nil] : [NSData data];
+    return [[BOXCannedResponse alloc] initWithURLResponse:URLResponse responseData:data];
+}
+
+@end
@@ -0,0 +1,183 @@
+//
+//  BOXAPIEmulatorTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXAPIEmulator.h"
+#import "BOXAPIEmulatorURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXFolderItemsRequest.h"
+#import "BOXFileUploadRequest.h"
+#import "BOXFileUpdateRequest.h"
+#import "BOXFileDeleteRequest.h"
+#import "BOXTrashedFileRestoreRequest.h"
+#import "BOXEventsRequest.h"
+#import "BOXEvent.h"
+#import "BOXFile.h"
+#import "BOXFolder.h"
+#import "BOXContentSDKErrors.h"
+#import "BOXContentSDKConstants.h"
+
+@interface BOXAPIEmulatorTests : BOXContentSDKTestCase
+
+@property (nonatomic, readwrite, strong) BOXAPIEmulator *emulator;
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+
+@end
+
+@implementation BOXAPIEmulatorTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.emulator = [[BOXAPIEmulator alloc] init];
+    [BOXAPIEmulatorURLProtocol setEmulator:self.emulator];
+
+    self.client = [self clientWithURLProtocolClass:[BOXAPIEmulatorURLProtocol class]
+                                       accessToken:@"emulator_access_token_0"
+                                      refreshToken:@"emulator_refresh_token_0"];
+}
+
+- (void)tearDown
+{
+    [BOXAPIEmulatorURLProtocol setEmulator:nil];
+    self.emulator = nil;
+    self.client = nil;
+
+    [super tearDown];
+}
+
+- (void)test_that_uploaded_file_is_listed_in_its_folder
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Reports" parentID:@"0"];
+    NSData *data = [@"quarterly numbers" dataUsingEncoding:NSUTF8StringEncoding];
+
+    XCTestExpectation *uploadExpectation = [self expectationWithDescription:@"upload"];
+    BOXFileUploadRequest *uploadRequest = [self.client fileUploadRequestToFolderWithID:folderID fromData:data fileName:@"q3.txt"];
+    [uploadRequest performRequestWithProgress:nil completion:^(BOXFile *file, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(@"q3.txt", file.name);
+        XCTAssertEqual(data.length, file.size.unsignedLongLongValue);
+        [uploadExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTestExpectation *listExpectation = [self expectationWithDescription:@"list"];
+    [[self.client folderItemsRequestWithID:folderID] performRequestWithCompletion:^(NSArray *items, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(1, items.count);
+        XCTAssertEqualObjects(@"q3.txt", [items.firstObject name]);
+        [listExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_that_move_is_reported_in_events_and_name_conflicts_are_rejected
+{
+    NSString *sourceID = [self.emulator createFolderWithName:@"Inbox" parentID:@"0"];
+    NSString *destinationID = [self.emulator createFolderWithName:@"Archive" parentID:@"0"];
+    NSString *fileID = [self.emulator createFileWithName:@"notes.txt" parentID:sourceID data:nil];
+    [self.emulator createFileWithName:@"todo.txt" parentID:destinationID data:nil];
+
+    XCTestExpectation *moveExpectation = [self expectationWithDescription:@"move"];
+    [[self.client fileMoveRequestWithID:fileID destinationFolderID:destinationID] performRequestWithCompletion:^(BOXFile *file, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(destinationID, file.parentFolder.modelID);
+        [moveExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTestExpectation *renameExpectation = [self expectationWithDescription:@"rename"];
+    [[self.client fileRenameRequestWithID:fileID newName:@"TODO.txt"] performRequestWithCompletion:^(BOXFile *file, NSError *error) {
+        XCTAssertNil(file);
+        XCTAssertEqual(409, [error.userInfo[BOXJSONErrorResponseKey][@"status"] integerValue]);
+        [renameExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTestExpectation *eventsExpectation = [self expectationWithDescription:@"events"];
+    [[self.client eventsRequestForCurrentUser] performRequestWithCompletion:^(NSArray *events, NSString *nextStreamPosition, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(1, events.count);
+        BOXEvent *event = events.firstObject;
+        XCTAssertEqualObjects(BOXAPIEventTypeItemMove, event.eventType);
+        XCTAssertEqualObjects(fileID, event.source.modelID);
+        XCTAssertEqualObjects(@"1", nextStreamPosition);
+        [eventsExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_that_trashed_file_is_restored_to_its_folder_unless_the_name_is_taken
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Drafts" parentID:@"0"];
+    NSString *fileID = [self.emulator createFileWithName:@"draft.txt" parentID:folderID data:nil];
+
+    XCTestExpectation *deleteExpectation = [self expectationWithDescription:@"delete"];
+    [[self.client fileDeleteRequestWithID:fileID] performRequestWithCompletion:^(NSError *error) {
+        XCTAssertNil(error);
+        [deleteExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    // A file created under the same name in the meantime blocks the restore.
+    NSString *replacementID = [self.emulator createFileWithName:@"draft.txt" parentID:folderID data:nil];
+    XCTestExpectation *conflictExpectation = [self expectationWithDescription:@"conflict"];
+    [[self.client trashedFileRestoreRequestWithID:fileID] performRequestWithCompletion:^(BOXFile *file, NSError *error) {
+        XCTAssertNil(file);
+        XCTAssertEqual(409, [error.userInfo[BOXJSONErrorResponseKey][@"status"] integerValue]);
+        [conflictExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTestExpectation *restoreExpectation = [self expectationWithDescription:@"restore"];
+    BOXTrashedFileRestoreRequest *restoreRequest = [self.client trashedFileRestoreRequestWithID:fileID];
+    restoreRequest.fileName = @"draft (restored).txt";
+    [restoreRequest performRequestWithCompletion:^(BOXFile *file, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(fileID, file.modelID);
+        XCTAssertEqualObjects(@"draft (restored).txt", file.name);
+        XCTAssertEqualObjects(folderID, file.parentFolder.modelID);
+        [restoreExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTestExpectation *listExpectation = [self expectationWithDescription:@"list"];
+    [[self.client folderItemsRequestWithID:folderID] performRequestWithCompletion:^(NSArray *items, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects((@[replacementID, fileID]), [items valueForKey:@"modelID"]);
+        [listExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTestExpectation *eventsExpectation = [self expectationWithDescription:@"events"];
+    [[self.client eventsRequestForCurrentUser] performRequestWithCompletion:^(NSArray *events, NSString *nextStreamPosition, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects((@[BOXAPIEventTypeItemTrash, @"ITEM_UNDELETE_VIA_TRASH"]), [events valueForKey:@"eventType"]);
+        [eventsExpectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_that_expired_token_is_refreshed_and_large_folder_is_paged
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Bulk" parentID:@"0"];
+    [self.emulator populateFolderWithID:folderID fileCount:2500];
+    self.emulator.accessToken = @"emulator_access_token_rotated";
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"list"];
+    [[self.client folderItemsRequestWithID:folderID] performRequestWithCompletion:^(NSArray *items, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(2500, items.count);
+        XCTAssertEqualObjects(@"file 2499", [items.lastObject name]);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:10.0 handler:nil];
+
+    XCTAssertEqualObjects(@"emulator_access_token_1", self.client.session.accessToken);
+    XCTAssertEqual(2502, [self.emulator itemCount]);
+}
+
+@end
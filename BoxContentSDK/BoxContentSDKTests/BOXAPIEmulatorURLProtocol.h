@@ -0,0 +1,17 @@
+//
+//  BOXAPIEmulatorURLProtocol.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@class BOXAPIEmulator;
+
+// Answers every request with the installed emulator. Responses go through BOXSimulatedNetwork when it has
+// conditions for the host, and are delivered instantly in chunks otherwise.
+@interface BOXAPIEmulatorURLProtocol : NSURLProtocol
+
++ (void)setEmulator:(BOXAPIEmulator *)emulator;
++ (BOXAPIEmulator *)emulator;
+
+@end
@@ -0,0 +1,99 @@
+//
+//  BOXAPIEmulatorURLProtocol.m
+//  BoxContentSDK
+//
+
+#import "BOXAPIEmulatorURLProtocol.h"
+#import "BOXAPIEmulator.h"
+#import "BOXCannedResponse.h"
+#import "BOXSimulatedNetwork.h"
+
+#define BOX_API_EMULATOR_READ_BUFFER_SIZE (64 * 1024)
+#define BOX_API_EMULATOR_CHUNK_SIZE (16 * 1024)
+
+static BOXAPIEmulator *_emulator;
+
+@interface BOXAPIEmulatorURLProtocol ()
+
+@property (nonatomic, readwrite, strong) BOXSimulatedTransfer *simulatedTransfer;
+
+@end
+
+@implementation BOXAPIEmulatorURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request
+{
+    return [self emulator] != nil;
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request
+{
+    return request;
+}
+
+- (NSCachedURLResponse *)cachedResponse
+{
+    return nil;
+}
+
+- (void)startLoading
+{
+    NSURLRequest *request = [self request];
+    id<NSURLProtocolClient> client = [self client];
+
+    // URL sessions hand bodies to protocols as streams, even when they were set as data.
+    NSMutableData *body = [NSMutableData dataWithData:request.HTTPBody ?: [NSData data]];
+    NSInputStream *bodyStream = request.HTTPBodyStream;
+    if (bodyStream != nil) {
+        uint8_t *buffer = malloc(BOX_API_EMULATOR_READ_BUFFER_SIZE);
+        [bodyStream open];
+        NSInteger bytesRead = 0;
+        while ((bytesRead = [bodyStream read:buffer maxLength:BOX_API_EMULATOR_READ_BUFFER_SIZE]) > 0) {
+            [body appendBytes:buffer length:bytesRead];
+        }
+        [bodyStream close];
+        free(buffer);
+    }
+
+    BOXCannedResponse *response = [[[self class] emulator] responseForRequest:request body:body];
+
+    self.simulatedTransfer = [[BOXSimulatedNetwork sharedNetwork] startTransferWithResponse:response.URLResponse
+                                                                                       data:response.responseData
+                                                                                forProtocol:self];
+    if (self.simulatedTransfer != nil) {
+        return;
+    }
+
+    [client URLProtocol:self didReceiveResponse:response.URLResponse cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    NSData *data = response.responseData;
+    for (NSUInteger offset = 0; offset < data.length; offset += BOX_API_EMULATOR_CHUNK_SIZE) {
+        @autoreleasepool {
+            [client URLProtocol:self didLoadData:[data subdataWithRange:NSMakeRange(offset, MIN(BOX_API_EMULATOR_CHUNK_SIZE, data.length - offset))]];
+        }
+    }
+    [client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading
+{
+    [self.simulatedTransfer cancel];
+    self.simulatedTransfer = nil;
+}
+
+#pragma mark - public class methods
+
++ (void)setEmulator:(BOXAPIEmulator *)emulator
+{
+    @synchronized(self) {
+        _emulator = emulator;
+    }
+}
+
++ (BOXAPIEmulator *)emulator
+{
+    @synchronized(self) {
+        return _emulator;
+    }
+}
+
+@end
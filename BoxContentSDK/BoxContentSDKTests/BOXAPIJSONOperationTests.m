@@ -0,0 +1,129 @@
+//
+//  BOXAPIJSONOperationTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXAPIJSONOperation.h"
+#import "BOXAPIMultipartToJSONOperation.h"
+#import "BOXAPIOperation_Private.h"
+#import "BOXContentSDKConstants.h"
+
+@interface BOXAPIJSONOperationTests : BOXContentSDKTestCase
+@end
+
+@implementation BOXAPIJSONOperationTests
+
+- (void)setUp
+{
+    [super setUp];
+    [BOXAPIJSONOperation setRequestBodyCompressionEnabled:YES];
+}
+
+- (void)tearDown
+{
+    [BOXAPIJSONOperation setRequestBodyCompressionEnabled:NO];
+    [super tearDown];
+}
+
+- (void)test_that_response_encodings_are_left_to_the_loading_system
+{
+    BOXAPIJSONOperation *operation = [self operationWithMethod:BOXAPIHTTPMethodGET body:nil];
+    [operation prepareAPIRequest];
+
+    XCTAssertNil([operation.APIRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderAcceptEncoding]);
+}
+
+- (void)test_that_request_body_above_threshold_is_compressed
+{
+    BOXAPIJSONOperation *operation = [self operationWithMethod:BOXAPIHTTPMethodPOST body:[self bodyWithLength:4096]];
+    NSUInteger bodyLength = operation.APIRequest.HTTPBody.length;
+    [operation prepareAPIRequest];
+
+    XCTAssertEqualObjects(@"gzip", [operation.APIRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderContentEncoding]);
+    XCTAssertEqual(bodyLength, operation.uncompressedRequestBodyLength);
+    XCTAssertLessThan(operation.APIRequest.HTTPBody.length, bodyLength);
+}
+
+- (void)test_that_request_body_below_threshold_is_not_compressed
+{
+    BOXAPIJSONOperation *operation = [self operationWithMethod:BOXAPIHTTPMethodPOST body:[self bodyWithLength:512]];
+    NSData *body = operation.APIRequest.HTTPBody;
+    XCTAssertLessThan(body.length, 1024);
+    [operation prepareAPIRequest];
+
+    XCTAssertNil([operation.APIRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderContentEncoding]);
+    XCTAssertEqual(0, operation.uncompressedRequestBodyLength);
+    XCTAssertEqualObjects(body, operation.APIRequest.HTTPBody);
+}
+
+- (void)test_that_request_body_is_not_compressed_when_disabled
+{
+    [BOXAPIJSONOperation setRequestBodyCompressionEnabled:NO];
+    BOXAPIJSONOperation *operation = [self operationWithMethod:BOXAPIHTTPMethodPOST body:[self bodyWithLength:4096]];
+    [operation prepareAPIRequest];
+
+    XCTAssertNil([operation.APIRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderContentEncoding]);
+    XCTAssertEqual(0, operation.uncompressedRequestBodyLength);
+}
+
+- (void)test_that_request_body_is_compressed_once_when_prepared_again
+{
+    BOXAPIJSONOperation *operation = [self operationWithMethod:BOXAPIHTTPMethodPOST body:[self bodyWithLength:4096]];
+    [operation prepareAPIRequest];
+    NSData *compressedBody = operation.APIRequest.HTTPBody;
+    [operation prepareAPIRequest];
+
+    XCTAssertEqualObjects(compressedBody, operation.APIRequest.HTTPBody);
+}
+
+- (void)test_that_multipart_body_is_not_compressed
+{
+    BOXAPIMultipartToJSONOperation *operation = [[BOXAPIMultipartToJSONOperation alloc] initWithURL:[NSURL URLWithString:@"https://upload.box.com/api/2.0/files/content"]
+                                                                                         HTTPMethod:BOXAPIHTTPMethodPOST
+                                                                                               body:[self bodyWithLength:4096]
+                                                                                        queryParams:nil
+                                                                                            session:nil];
+    [operation appendMultipartPieceWithData:[NSMutableData dataWithLength:4096] fieldName:@"file" filename:@"file.txt" MIMEType:@"text/plain"];
+    [operation prepareAPIRequest];
+
+    XCTAssertFalse([operation shouldCompressRequestBody]);
+    XCTAssertNil([operation.APIRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderContentEncoding]);
+    XCTAssertEqual(0, operation.uncompressedRequestBodyLength);
+}
+
+- (void)test_that_copy_compresses_its_own_body_instead_of_keeping_content_encoding
+{
+    BOXAPIJSONOperation *operation = [self operationWithMethod:BOXAPIHTTPMethodPOST body:[self bodyWithLength:4096]];
+    [operation prepareAPIRequest];
+
+    BOXAPIJSONOperation *operationCopy = [operation copy];
+    XCTAssertNil([operationCopy.APIRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderContentEncoding]);
+    XCTAssertEqual(0, operationCopy.uncompressedRequestBodyLength);
+    XCTAssertEqual(operation.uncompressedRequestBodyLength, operationCopy.APIRequest.HTTPBody.length);
+
+    [operationCopy prepareAPIRequest];
+    XCTAssertEqualObjects(@"gzip", [operationCopy.APIRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderContentEncoding]);
+    XCTAssertEqual(operation.uncompressedRequestBodyLength, operationCopy.uncompressedRequestBodyLength);
+    XCTAssertEqualObjects(operation.APIRequest.HTTPBody, operationCopy.APIRequest.HTTPBody);
+}
+
+#pragma mark - Helpers
+
+- (BOXAPIJSONOperation *)operationWithMethod:(NSString *)method body:(NSDictionary *)body
+{
+    return [[BOXAPIJSONOperation alloc] initWithURL:[NSURL URLWithString:@"https://api.box.com/2.0/folders/0/items"]
+                                         HTTPMethod:method
+                                               body:body
+                                        queryParams:nil
+                                            session:nil];
+}
+
+// JSON bodies whose encoding is about length bytes long and compresses well.
+- (NSDictionary *)bodyWithLength:(NSUInteger)length
+{
+    NSString *description = [@"" stringByPaddingToLength:length withString:@"box " startingAtIndex:0];
+    return @{@"description" : description};
+}
+
+@end
@@ -0,0 +1,230 @@
+//
+//  BOXAPISchedulerTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXAPIScheduler.h"
+
+@interface BOXAPISchedulerTests : BOXContentSDKTestCase
+@property (nonatomic, readwrite, strong) NSOperationQueue *queue;
+@end
+
+@implementation BOXAPISchedulerTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.queue = [[NSOperationQueue alloc] init];
+}
+
+- (void)tearDown
+{
+    [self.queue waitUntilAllOperationsAreFinished];
+    [super tearDown];
+}
+
+- (void)scheduleOperation:(NSOperation *)operation onScheduler:(BOXAPIScheduler *)scheduler forAccount:(id)account
+{
+    NSOperationQueue *queue = self.queue;
+    [scheduler scheduleOperation:operation forAccount:account inLane:BOXAPISchedulerLaneRequests queue:queue dispatchBlock:^(NSOperation *scheduledOperation) {
+        [queue addOperation:scheduledOperation];
+    }];
+}
+
+- (void)test_running_operations_are_capped_across_accounts
+{
+    BOXAPIScheduler *scheduler = [[BOXAPIScheduler alloc] init];
+    scheduler.maxConcurrentRequests = 2;
+    NSObject *firstAccount = [[NSObject alloc] init];
+    NSObject *secondAccount = [[NSObject alloc] init];
+
+    dispatch_semaphore_t releaseSemaphore = dispatch_semaphore_create(0);
+    for (NSUInteger index = 0; index < 5; index++) {
+        NSBlockOperation *operation = [NSBlockOperation blockOperationWithBlock:^{
+            dispatch_semaphore_wait(releaseSemaphore, DISPATCH_TIME_FOREVER);
+        }];
+        [self scheduleOperation:operation onScheduler:scheduler forAccount:(index % 2 == 0 ? firstAccount : secondAccount)];
+    }
+
+    XCTAssertEqual(2, [scheduler runningOperationCountInLane:BOXAPISchedulerLaneRequests]);
+    XCTAssertEqual(3, [scheduler pendingOperationCountInLane:BOXAPISchedulerLaneRequests]);
+    XCTAssertEqual(0, [scheduler runningOperationCountInLane:BOXAPISchedulerLaneTransfers]);
+
+    for (NSUInteger index = 0; index < 5; index++) {
+        dispatch_semaphore_signal(releaseSemaphore);
+    }
+    [self.queue waitUntilAllOperationsAreFinished];
+}
+
+- (void)test_accounts_take_turns
+{
+    BOXAPIScheduler *scheduler = [[BOXAPIScheduler alloc] init];
+    scheduler.maxConcurrentRequests = 1;
+    NSObject *busyAccount = [[NSObject alloc] init];
+    NSObject *otherAccount = [[NSObject alloc] init];
+
+    NSMutableArray *order = [NSMutableArray array];
+    dispatch_semaphore_t startedSemaphore = dispatch_semaphore_create(0);
+    dispatch_semaphore_t releaseSemaphore = dispatch_semaphore_create(0);
+    [self scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+        dispatch_semaphore_signal(startedSemaphore);
+        dispatch_semaphore_wait(releaseSemaphore, DISPATCH_TIME_FOREVER);
+    }] onScheduler:scheduler forAccount:busyAccount];
+    dispatch_semaphore_wait(startedSemaphore, DISPATCH_TIME_FOREVER);
+
+    for (NSString *name in @[@"busy 1", @"busy 2"]) {
+        [self scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+            @synchronized(order) {
+                [order addObject:name];
+            }
+        }] onScheduler:scheduler forAccount:busyAccount];
+    }
+    [self scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+        @synchronized(order) {
+            [order addObject:@"other"];
+        }
+    }] onScheduler:scheduler forAccount:otherAccount];
+    XCTAssertEqual(3, [scheduler pendingOperationCountInLane:BOXAPISchedulerLaneRequests]);
+
+    dispatch_semaphore_signal(releaseSemaphore);
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        while ([scheduler pendingOperationCountInLane:BOXAPISchedulerLaneRequests] > 0 || [scheduler runningOperationCountInLane:BOXAPISchedulerLaneRequests] > 0) {
+            [NSThread sleepForTimeInterval:0.01];
+        }
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTAssertEqualObjects((@[@"other", @"busy 1", @"busy 2"]), order);
+}
+
+- (void)test_operations_of_an_account_are_rate_limited
+{
+    BOXAPIScheduler *scheduler = [[BOXAPIScheduler alloc] init];
+    scheduler.maxOperationsPerSecondPerAccount = 2;
+    NSObject *account = [[NSObject alloc] init];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    expectation.expectedFulfillmentCount = 3;
+    for (NSUInteger index = 0; index < 3; index++) {
+        [self scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+            [expectation fulfill];
+        }] onScheduler:scheduler forAccount:account];
+    }
+
+    // A burst of two goes right away; the third waits for the bucket to refill.
+    XCTAssertEqual(1, [scheduler pendingOperationCountInLane:BOXAPISchedulerLaneRequests]);
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_operations_are_not_dispatched_beyond_their_queue_width
+{
+    BOXAPIScheduler *scheduler = [[BOXAPIScheduler alloc] init];
+    scheduler.maxConcurrentRequests = 8;
+    self.queue.maxConcurrentOperationCount = 2;
+    NSObject *account = [[NSObject alloc] init];
+
+    dispatch_semaphore_t releaseSemaphore = dispatch_semaphore_create(0);
+    for (NSUInteger index = 0; index < 4; index++) {
+        [self scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+            dispatch_semaphore_wait(releaseSemaphore, DISPATCH_TIME_FOREVER);
+        }] onScheduler:scheduler forAccount:account];
+    }
+
+    XCTAssertEqual(2, [scheduler runningOperationCountInLane:BOXAPISchedulerLaneRequests]);
+    XCTAssertEqual(2, [scheduler pendingOperationCountInLane:BOXAPISchedulerLaneRequests]);
+
+    for (NSUInteger index = 0; index < 4; index++) {
+        dispatch_semaphore_signal(releaseSemaphore);
+    }
+    [self waitUntilScheduler:scheduler isIdleInLane:BOXAPISchedulerLaneRequests];
+}
+
+- (void)test_held_account_does_not_take_slots_from_other_accounts
+{
+    BOXAPIScheduler *scheduler = [[BOXAPIScheduler alloc] init];
+    scheduler.maxConcurrentRequests = 1;
+    NSObject *refreshingAccount = [[NSObject alloc] init];
+    NSObject *otherAccount = [[NSObject alloc] init];
+
+    [scheduler setOperationsHeld:YES forAccount:refreshingAccount];
+    __block XCTestExpectation *heldExpectation = nil;
+    [self scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+        [heldExpectation fulfill];
+    }] onScheduler:scheduler forAccount:refreshingAccount];
+    XCTestExpectation *otherExpectation = [self expectationWithDescription:@"other operation"];
+    [self scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+        [otherExpectation fulfill];
+    }] onScheduler:scheduler forAccount:otherAccount];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+    XCTAssertEqual(1, [scheduler pendingOperationCountInLane:BOXAPISchedulerLaneRequests]);
+
+    heldExpectation = [self expectationWithDescription:@"held operation"];
+    [scheduler setOperationsHeld:NO forAccount:refreshingAccount];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_operation_cancelled_while_waiting_finishes_without_a_slot
+{
+    BOXAPIScheduler *scheduler = [[BOXAPIScheduler alloc] init];
+    scheduler.maxConcurrentRequests = 1;
+    NSObject *account = [[NSObject alloc] init];
+
+    dispatch_semaphore_t releaseSemaphore = dispatch_semaphore_create(0);
+    [self scheduleOperation:[NSBlockOperation blockOperationWithBlock:^{
+        dispatch_semaphore_wait(releaseSemaphore, DISPATCH_TIME_FOREVER);
+    }] onScheduler:scheduler forAccount:account];
+    NSBlockOperation *cancelledOperation = [NSBlockOperation blockOperationWithBlock:^{
+        XCTFail(@"Cancelled operations do not run");
+    }];
+    [self scheduleOperation:cancelledOperation onScheduler:scheduler forAccount:account];
+    XCTAssertEqual(1, [scheduler pendingOperationCountInLane:BOXAPISchedulerLaneRequests]);
+
+    [self keyValueObservingExpectationForObject:cancelledOperation keyPath:@"isFinished" expectedValue:@YES];
+    [cancelledOperation cancel];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTAssertEqual(0, [scheduler pendingOperationCountInLane:BOXAPISchedulerLaneRequests]);
+    XCTAssertEqual(1, [scheduler runningOperationCountInLane:BOXAPISchedulerLaneRequests]);
+
+    dispatch_semaphore_signal(releaseSemaphore);
+    [self waitUntilScheduler:scheduler isIdleInLane:BOXAPISchedulerLaneRequests];
+}
+
+- (void)test_completion_block_of_operation_is_left_alone
+{
+    BOXAPIScheduler *scheduler = [[BOXAPIScheduler alloc] init];
+    NSObject *account = [[NSObject alloc] init];
+
+    dispatch_semaphore_t releaseSemaphore = dispatch_semaphore_create(0);
+    NSBlockOperation *operation = [NSBlockOperation blockOperationWithBlock:^{
+        dispatch_semaphore_wait(releaseSemaphore, DISPATCH_TIME_FOREVER);
+    }];
+    void (^completionBlock)(void) = ^{};
+    operation.completionBlock = completionBlock;
+    [self scheduleOperation:operation onScheduler:scheduler forAccount:account];
+    XCTAssertEqual(1, [scheduler runningOperationCountInLane:BOXAPISchedulerLaneRequests]);
+    XCTAssertEqualObjects(completionBlock, operation.completionBlock);
+
+    dispatch_semaphore_signal(releaseSemaphore);
+    [self waitUntilScheduler:scheduler isIdleInLane:BOXAPISchedulerLaneRequests];
+}
+
+#pragma mark - Helpers
+
+- (void)waitUntilScheduler:(BOXAPIScheduler *)scheduler isIdleInLane:(BOXAPISchedulerLane)lane
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"idle"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        while ([scheduler pendingOperationCountInLane:lane] > 0 || [scheduler runningOperationCountInLane:lane] > 0) {
+            [NSThread sleepForTimeInterval:0.01];
+        }
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+@end
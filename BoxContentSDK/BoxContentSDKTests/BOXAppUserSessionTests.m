@@ -12,6 +12,7 @@
 #import "BOXAPIAccessTokenDelegate.h"
 #import "BOXContentClient_Private.h"
 #import "BOXKeychainItemWrapper.h"
+#import "BOXAbstractSession_Private.h"
 #import "BOXOAuth2Session.h"
 #import "BOXCannedURLProtocol.h"
 #import "BOXURLSessionManager_Private.h"
@@ -143,6 +144,7 @@
     BOXKeychainItemWrapper *keychain = [[BOXKeychainItemWrapper alloc] initWithIdentifier:[@"BoxCredential_" stringByAppendingString:user.modelID] accessGroup:nil];
     [keychain resetKeychainItem];
     [keychain setObject:jsonString forKey:(__bridge id)kSecValueData];
+    [[BOXOAuth2Session credentialStore] invalidate];
     
     BOXOAuth2Session *session = [[BOXOAuth2Session alloc] init];
     [session restoreCredentialsFromKeychainForUserWithID:user.modelID];
@@ -0,0 +1,69 @@
+//
+//  BOXBenchmarkTestCase.h
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+
+@class BOXContentClient;
+
+// Collects the measurements of one benchmark run. Thread safe.
+@interface BOXBenchmarkRecorder : NSObject
+
+// Latency of one operation, e.g. one request.
+- (void)recordLatency:(NSTimeInterval)latency;
+
+// Units of work done, e.g. items listed or bytes transferred. Throughput is their number per second.
+- (void)addProcessedUnits:(double)units;
+
+- (void)recordError:(NSError *)error;
+
+// Extra value written to the results, e.g. the number of token refreshes.
+- (void)setValue:(double)value forMetric:(NSString *)metric;
+
+@end
+
+typedef void (^BOXBenchmarkBlock)(BOXBenchmarkRecorder *recorder, dispatch_block_t done);
+
+// Base class of the benchmarks, which are skipped unless the BOX_RUN_BENCHMARKS environment variable is set.
+//
+// Each benchmark records its throughput, p50 and p99 latency, CPU time, net allocations and peak memory. The
+// results are written as JSON to BOX_BENCHMARK_RESULTS_PATH, or to benchmark_results.json in the temporary
+// directory, and compared to benchmark_baseline.json, or to the file at BOX_BENCHMARK_BASELINE_PATH. A metric
+// worse than its baseline by more than the tolerance of the baseline file fails the benchmark, and so does a
+// benchmark missing from the baseline. The baseline names the device it was measured on; until it does, benchmarks
+// are only checked for errors. To update the baseline, run the benchmarks on the reference device and copy the
+// results file, which names the device it ran on, over it.
+@interface BOXBenchmarkTestCase : BOXContentSDKTestCase
+
+// Whether BOX_RUN_BENCHMARKS is set.
++ (BOOL)benchmarksEnabled;
+
+- (NSDictionary *)fixtureJSONWithName:(NSString *)name;
+
+// Runs block, which calls done once all of its work has completed, and checks its results against the
+// baseline.
+- (void)runBenchmarkNamed:(NSString *)name timeout:(NSTimeInterval)timeout block:(BOXBenchmarkBlock)block;
+
+@end
+
+// Base class of the benchmarks of the request pipeline. They run a BOXContentClient against
+// BOXBenchmarkURLProtocol, an in-process stand-in for the Box API.
+@interface BOXAPIBenchmarkTestCase : BOXBenchmarkTestCase
+
+// An authenticated client whose requests are all served by BOXBenchmarkURLProtocol.
+@property (nonatomic, readonly, strong) BOXContentClient *client;
+
+// Number of items in the folder listed by the stand-in. Defaults to 10,000.
+@property (nonatomic, readonly, assign) NSUInteger folderItemCount;
+
+// Number of times the client refreshed its access token.
+@property (nonatomic, readonly, assign) NSUInteger tokenRefreshCount;
+
+// Size of the large transfers. Defaults to 1 GB, or BOX_BENCHMARK_TRANSFER_BYTES if set.
+@property (nonatomic, readonly, assign) unsigned long long transferSize;
+
+// Makes the stand-in reject the access token of the client, so that it has to refresh it.
+- (void)expireAccessToken;
+
+@end
@@ -0,0 +1,444 @@
+//
+//  BOXBenchmarkTestCase.m
+//  BoxContentSDK
+//
+
+#import "BOXBenchmarkTestCase.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient_Private.h"
+
+#import <mach/mach.h>
+#import <malloc/malloc.h>
+#import <sys/resource.h>
+#import <sys/sysctl.h>
+
+#define BOX_BENCHMARK_DEFAULT_TRANSFER_SIZE (1024ULL * 1024ULL * 1024ULL)
+#define BOX_BENCHMARK_DEFAULT_TOLERANCE (0.2)
+#define BOX_BENCHMARK_MEMORY_SAMPLING_INTERVAL (0.01)
+
+static NSString *const BOXBenchmarkMetricThroughput = @"throughput";
+static NSString *const BOXBenchmarkMetricP50Latency = @"p50_latency";
+static NSString *const BOXBenchmarkMetricP99Latency = @"p99_latency";
+static NSString *const BOXBenchmarkMetricCPUTime = @"cpu_time";
+static NSString *const BOXBenchmarkMetricNetAllocations = @"net_allocations";
+static NSString *const BOXBenchmarkMetricPeakMemory = @"peak_memory_bytes";
+static NSString *const BOXBenchmarkMetricErrors = @"errors";
+
+static NSString *const BOXBenchmarkFileKeyTolerance = @"tolerance";
+static NSString *const BOXBenchmarkFileKeyBenchmarks = @"benchmarks";
+static NSString *const BOXBenchmarkFileKeyDevice = @"device";
+
+static NSTimeInterval BOXBenchmarkCPUTime(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+static size_t BOXBenchmarkAllocatedBlocks(void)
+{
+    malloc_statistics_t statistics;
+    malloc_zone_statistics(NULL, &statistics);
+    return statistics.blocks_in_use;
+}
+
+static unsigned long long BOXBenchmarkMemoryFootprint(void)
+{
+    task_vm_info_data_t info;
+    mach_msg_type_number_t count = TASK_VM_INFO_COUNT;
+    if (task_info(mach_task_self(), TASK_VM_INFO, (task_info_t)&info, &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return info.phys_footprint;
+}
+
+// Model and OS version the benchmarks run on, e.g. "iPhone12,1 simulator, iOS 14.4".
+static NSString *BOXBenchmarkDeviceDescription(void)
+{
+    NSString *model = [[NSProcessInfo processInfo] environment][@"SIMULATOR_MODEL_IDENTIFIER"];
+    BOOL simulator = (model.length > 0);
+    if (!simulator) {
+        size_t length = 0;
+        sysctlbyname("hw.machine", NULL, &length, NULL, 0);
+        char machine[length > 0 ? length : 1];
+        machine[0] = '\0';
+        if (length > 0) {
+            sysctlbyname("hw.machine", machine, &length, NULL, 0);
+        }
+        model = [NSString stringWithUTF8String:machine];
+    }
+    return [NSString stringWithFormat:@"%@%@, iOS %@", model, simulator ? @" simulator" : @"", [[UIDevice currentDevice] systemVersion]];
+}
+
+@interface BOXBenchmarkRecorder ()
+
+@property (nonatomic, readwrite, strong) NSMutableArray *latencies;
+@property (nonatomic, readwrite, assign) double processedUnits;
+@property (nonatomic, readwrite, assign) NSUInteger errorCount;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *extraMetrics;
+
+@end
+
+@implementation BOXBenchmarkRecorder
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _latencies = [NSMutableArray array];
+        _extraMetrics = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)recordLatency:(NSTimeInterval)latency
+{
+    @synchronized(self) {
+        [self.latencies addObject:@(latency)];
+    }
+}
+
+- (void)addProcessedUnits:(double)units
+{
+    @synchronized(self) {
+        self.processedUnits += units;
+    }
+}
+
+- (void)recordError:(NSError *)error
+{
+    @synchronized(self) {
+        self.errorCount++;
+    }
+}
+
+- (void)setValue:(double)value forMetric:(NSString *)metric
+{
+    @synchronized(self) {
+        self.extraMetrics[metric] = @(value);
+    }
+}
+
+- (NSTimeInterval)latencyAtPercentile:(double)percentile
+{
+    @synchronized(self) {
+        if (self.latencies.count == 0) {
+            return 0;
+        }
+        NSArray *sortedLatencies = [self.latencies sortedArrayUsingSelector:@selector(compare:)];
+        NSUInteger rank = (NSUInteger)ceil(percentile * sortedLatencies.count);
+        return [sortedLatencies[MAX(rank, 1) - 1] doubleValue];
+    }
+}
+
+@end
+
+@implementation BOXBenchmarkTestCase
+
++ (BOOL)benchmarksEnabled
+{
+    return [[NSProcessInfo processInfo] environment][@"BOX_RUN_BENCHMARKS"] != nil;
+}
+
+- (NSDictionary *)fixtureJSONWithName:(NSString *)name
+{
+    NSString *filePath = [[NSBundle bundleForClass:[self class]] pathForResource:name ofType:@"json"];
+    NSData *data = [NSData dataWithContentsOfFile:filePath];
+    return data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+}
+
+#pragma mark - Running
+
+- (void)runBenchmarkNamed:(NSString *)name timeout:(NSTimeInterval)timeout block:(BOXBenchmarkBlock)block
+{
+    if (![[self class] benchmarksEnabled]) {
+        return;
+    }
+
+    BOXBenchmarkRecorder *recorder = [[BOXBenchmarkRecorder alloc] init];
+
+    __block unsigned long long peakMemory = BOXBenchmarkMemoryFootprint();
+    dispatch_queue_t samplingQueue = dispatch_queue_create("com.box.contentsdk.benchmark.sampling", DISPATCH_QUEUE_SERIAL);
+    dispatch_source_t samplingTimer = dispatch_source_create(DISPATCH_SOURCE_TYPE_TIMER, 0, 0, samplingQueue);
+    dispatch_source_set_timer(samplingTimer, DISPATCH_TIME_NOW, (uint64_t)(BOX_BENCHMARK_MEMORY_SAMPLING_INTERVAL * NSEC_PER_SEC), 0);
+    dispatch_source_set_event_handler(samplingTimer, ^{
+        peakMemory = MAX(peakMemory, BOXBenchmarkMemoryFootprint());
+    });
+
+    size_t allocatedBlocks = BOXBenchmarkAllocatedBlocks();
+    NSTimeInterval CPUTime = BOXBenchmarkCPUTime();
+    NSDate *startDate = [NSDate date];
+    dispatch_resume(samplingTimer);
+
+    XCTestExpectation *expectation = [self expectationWithDescription:name];
+    block(recorder, ^{
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:timeout handler:nil];
+
+    NSTimeInterval wallTime = -[startDate timeIntervalSinceNow];
+    CPUTime = BOXBenchmarkCPUTime() - CPUTime;
+    double netAllocations = (double)BOXBenchmarkAllocatedBlocks() - (double)allocatedBlocks;
+    dispatch_sync(samplingQueue, ^{
+        dispatch_source_cancel(samplingTimer);
+        peakMemory = MAX(peakMemory, BOXBenchmarkMemoryFootprint());
+    });
+
+    NSMutableDictionary *metrics = [NSMutableDictionary dictionary];
+    @synchronized(recorder) {
+        metrics[BOXBenchmarkMetricThroughput] = @(wallTime > 0 ? recorder.processedUnits / wallTime : 0);
+        metrics[BOXBenchmarkMetricErrors] = @(recorder.errorCount);
+        [metrics addEntriesFromDictionary:recorder.extraMetrics];
+    }
+    metrics[BOXBenchmarkMetricP50Latency] = @([recorder latencyAtPercentile:0.5]);
+    metrics[BOXBenchmarkMetricP99Latency] = @([recorder latencyAtPercentile:0.99]);
+    metrics[BOXBenchmarkMetricCPUTime] = @(CPUTime);
+    metrics[BOXBenchmarkMetricNetAllocations] = @(netAllocations);
+    metrics[BOXBenchmarkMetricPeakMemory] = @(peakMemory);
+
+    XCTAssertEqual(0, recorder.errorCount, @"Benchmark %@ had errors", name);
+
+    [self writeMetrics:metrics forBenchmarkNamed:name];
+    [self compareMetrics:metrics forBenchmarkNamed:name];
+}
+
+- (void)writeMetrics:(NSDictionary *)metrics forBenchmarkNamed:(NSString *)name
+{
+    NSString *path = [[NSProcessInfo processInfo] environment][@"BOX_BENCHMARK_RESULTS_PATH"];
+    if (path.length == 0) {
+        path = [NSTemporaryDirectory() stringByAppendingPathComponent:@"benchmark_results.json"];
+    }
+
+    // Results accumulate across benchmarks in the same file, in the format of the baseline.
+    NSMutableDictionary *results = nil;
+    NSData *data = [NSData dataWithContentsOfFile:path];
+    if (data) {
+        results = [[NSJSONSerialization JSONObjectWithData:data options:NSJSONReadingMutableContainers error:nil] mutableCopy];
+    }
+    if (![results isKindOfClass:[NSMutableDictionary class]]) {
+        results = [NSMutableDictionary dictionary];
+    }
+    NSMutableDictionary *benchmarks = [results[BOXBenchmarkFileKeyBenchmarks] mutableCopy] ?: [NSMutableDictionary dictionary];
+    benchmarks[name] = metrics;
+    results[BOXBenchmarkFileKeyBenchmarks] = benchmarks;
+    results[BOXBenchmarkFileKeyDevice] = BOXBenchmarkDeviceDescription();
+    if (results[BOXBenchmarkFileKeyTolerance] == nil) {
+        results[BOXBenchmarkFileKeyTolerance] = @(BOX_BENCHMARK_DEFAULT_TOLERANCE);
+    }
+
+    NSData *resultsData = [NSJSONSerialization dataWithJSONObject:results options:NSJSONWritingPrettyPrinted error:nil];
+    [resultsData writeToFile:path atomically:YES];
+}
+
+- (void)compareMetrics:(NSDictionary *)metrics forBenchmarkNamed:(NSString *)name
+{
+    NSString *path = [[NSProcessInfo processInfo] environment][@"BOX_BENCHMARK_BASELINE_PATH"];
+    if (path.length == 0) {
+        path = [[NSBundle bundleForClass:[BOXBenchmarkTestCase class]] pathForResource:@"benchmark_baseline" ofType:@"json"];
+    }
+    NSData *data = path ? [NSData dataWithContentsOfFile:path] : nil;
+    NSDictionary *baseline = data ? [NSJSONSerialization JSONObjectWithData:data options:0 error:nil] : nil;
+    NSDictionary *baselineMetrics = baseline[BOXBenchmarkFileKeyBenchmarks][name];
+    if (![baselineMetrics isKindOfClass:[NSDictionary class]]) {
+        XCTFail(@"No baseline for benchmark %@ in %@", name, path);
+        return;
+    }
+
+    double tolerance = baseline[BOXBenchmarkFileKeyTolerance] ? [baseline[BOXBenchmarkFileKeyTolerance] doubleValue] : BOX_BENCHMARK_DEFAULT_TOLERANCE;
+    // Only metrics measured on a named device are compared; the others are written to the results for the next
+    // baseline and are only checked for errors.
+    NSString *baselineDevice = baseline[BOXBenchmarkFileKeyDevice];
+    if (![baselineDevice isKindOfClass:[NSString class]] || baselineDevice.length == 0) {
+        NSLog(@"Benchmark %@ has no measured baseline in %@, run on %@", name, path, BOXBenchmarkDeviceDescription());
+        return;
+    }
+
+    double baselineThroughput = [baselineMetrics[BOXBenchmarkMetricThroughput] doubleValue];
+    double throughput = [metrics[BOXBenchmarkMetricThroughput] doubleValue];
+    if (baselineThroughput > 0) {
+        XCTAssertGreaterThanOrEqual(throughput, baselineThroughput * (1.0 - tolerance),
+                                    @"Benchmark %@ regressed: throughput %.1f, baseline %.1f on %@", name, throughput, baselineThroughput, baselineDevice);
+    }
+
+    NSArray *lowerIsBetterMetrics = @[BOXBenchmarkMetricP50Latency,
+                                      BOXBenchmarkMetricP99Latency,
+                                      BOXBenchmarkMetricCPUTime,
+                                      BOXBenchmarkMetricNetAllocations,
+                                      BOXBenchmarkMetricPeakMemory];
+    for (NSString *metric in lowerIsBetterMetrics) {
+        double baselineValue = [baselineMetrics[metric] doubleValue];
+        double value = [metrics[metric] doubleValue];
+        if (baselineValue > 0) {
+            XCTAssertLessThanOrEqual(value, baselineValue * (1.0 + tolerance),
+                                     @"Benchmark %@ regressed: %@ %.4f, baseline %.4f on %@", name, metric, value, baselineValue, baselineDevice);
+        }
+    }
+}
+
+@end
+
+@interface BOXAPIBenchmarkTestCase ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, assign) unsigned long long transferSize;
+@property (nonatomic, readwrite, copy) NSString *serverAccessToken;
+@property (nonatomic, readwrite, assign) NSUInteger tokenRefreshCount;
+
+@end
+
+@implementation BOXAPIBenchmarkTestCase
+
+- (void)setUp
+{
+    [super setUp];
+
+    NSString *transferSize = [[NSProcessInfo processInfo] environment][@"BOX_BENCHMARK_TRANSFER_BYTES"];
+    self.transferSize = transferSize.longLongValue > 0 ? (unsigned long long)transferSize.longLongValue : BOX_BENCHMARK_DEFAULT_TRANSFER_SIZE;
+    self.serverAccessToken = @"benchmark_access_token_0";
+
+    [NSURLProtocol registerClass:[BOXBenchmarkURLProtocol class]];
+    [self addStandInRoutes];
+
+    self.client = [self clientWithURLProtocolClass:[BOXBenchmarkURLProtocol class]
+                                       accessToken:self.serverAccessToken
+                                      refreshToken:@"benchmark_refresh_token"];
+}
+
+- (void)tearDown
+{
+    [BOXBenchmarkURLProtocol reset];
+    [NSURLProtocol unregisterClass:[BOXBenchmarkURLProtocol class]];
+    self.client = nil;
+
+    [super tearDown];
+}
+
+- (void)expireAccessToken
+{
+    @synchronized(self) {
+        self.serverAccessToken = [NSString stringWithFormat:@"benchmark_access_token_%lu", (unsigned long)self.tokenRefreshCount + 1];
+    }
+}
+
+- (NSUInteger)tokenRefreshCount
+{
+    @synchronized(self) {
+        return _tokenRefreshCount;
+    }
+}
+
+#pragma mark - Stand-in routes
+
+- (void)addStandInRoutes
+{
+    __weak BOXAPIBenchmarkTestCase *weakSelf = self;
+
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"POST" pathPattern:@"/oauth2/token$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        BOXAPIBenchmarkTestCase *strongSelf = weakSelf;
+        NSString *accessToken = nil;
+        @synchronized(strongSelf) {
+            strongSelf->_tokenRefreshCount++;
+            accessToken = strongSelf.serverAccessToken;
+        }
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"access_token" : accessToken,
+                                                                            @"refresh_token" : @"benchmark_refresh_token",
+                                                                            @"expires_in" : @(3600),
+                                                                            @"token_type" : @"bearer"}];
+    }];
+
+    NSMutableArray *itemTemplates = [NSMutableArray array];
+    [itemTemplates addObjectsFromArray:[self fixtureJSONWithName:@"get_items_0_2"][@"entries"]];
+    [itemTemplates addObjectsFromArray:[self fixtureJSONWithName:@"get_items_3_5"][@"entries"]];
+    [self addAuthenticatedRouteWithMethod:@"GET" pathPattern:@"/folders/[^/]+/items$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:[weakSelf folderItemsPageForRequest:request itemTemplates:itemTemplates]];
+    }];
+
+    NSDictionary *folder = [self fixtureJSONWithName:@"folder_default_fields"];
+    [self addAuthenticatedRouteWithMethod:@"GET" pathPattern:@"/folders/[^/]+$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:folder];
+    }];
+
+    NSDictionary *searchResults = [self fixtureJSONWithName:@"item_search_results"];
+    [self addAuthenticatedRouteWithMethod:@"GET" pathPattern:@"/search$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:searchResults];
+    }];
+
+    NSData *thumbnailData = [self thumbnailData];
+    [self addAuthenticatedRouteWithMethod:@"GET" pathPattern:@"/files/[^/]+/thumbnail\\.png$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        return [BOXBenchmarkResponse responseWithData:thumbnailData contentType:@"image/png"];
+    }];
+
+    unsigned long long transferSize = self.transferSize;
+    [self addAuthenticatedRouteWithMethod:@"GET" pathPattern:@"/files/[^/]+/content$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        return [BOXBenchmarkResponse responseWithGeneratedLength:transferSize];
+    }];
+
+    NSDictionary *file = [self fixtureJSONWithName:@"file_default_fields"];
+    [self addAuthenticatedRouteWithMethod:@"POST" pathPattern:@"/files/content$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        return [BOXBenchmarkResponse responseWithStatusCode:201 JSONObject:file];
+    }];
+}
+
+// Requests signed with anything but the current access token are rejected the way the API does, which makes
+// the client refresh its token.
+- (void)addAuthenticatedRouteWithMethod:(NSString *)method pathPattern:(NSString *)pathPattern handler:(BOXBenchmarkRouteHandler)handler
+{
+    __weak BOXAPIBenchmarkTestCase *weakSelf = self;
+    [BOXBenchmarkURLProtocol addRouteWithMethod:method pathPattern:pathPattern handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        BOXAPIBenchmarkTestCase *strongSelf = weakSelf;
+        NSString *authorization = nil;
+        @synchronized(strongSelf) {
+            authorization = [NSString stringWithFormat:@"Bearer %@", strongSelf.serverAccessToken];
+        }
+        if (![[request valueForHTTPHeaderField:@"Authorization"] isEqualToString:authorization]) {
+            BOXBenchmarkResponse *response = [BOXBenchmarkResponse responseWithStatusCode:401 JSONObject:nil];
+            response.headerFields = @{@"WWW-Authenticate" : @"Bearer realm=\"Service\", error=\"invalid_token\""};
+            return response;
+        }
+        return handler(request, bodyLength);
+    }];
+}
+
+// Pages of folderItemCount items, made of copies of the entries of the folder items fixtures with distinct IDs.
+- (NSDictionary *)folderItemsPageForRequest:(NSURLRequest *)request itemTemplates:(NSArray *)templates
+{
+    NSURLComponents *components = [NSURLComponents componentsWithURL:request.URL resolvingAgainstBaseURL:NO];
+    NSUInteger offset = 0;
+    NSUInteger limit = 100;
+    for (NSURLQueryItem *queryItem in components.queryItems) {
+        if ([queryItem.name isEqualToString:@"offset"]) {
+            offset = (NSUInteger)queryItem.value.integerValue;
+        } else if ([queryItem.name isEqualToString:@"limit"]) {
+            limit = (NSUInteger)queryItem.value.integerValue;
+        }
+    }
+
+    NSUInteger totalCount = self.folderItemCount;
+    NSMutableArray *entries = [NSMutableArray array];
+    for (NSUInteger i = offset; i < MIN(offset + limit, totalCount); i++) {
+        NSMutableDictionary *entry = [templates[i % templates.count] mutableCopy];
+        entry[@"id"] = [NSString stringWithFormat:@"%lu", (unsigned long)(100000 + i)];
+        [entries addObject:entry];
+    }
+
+    return @{@"total_count" : @(totalCount),
+             @"entries" : entries,
+             @"offset" : @(offset),
+             @"limit" : @(limit)};
+}
+
+- (NSUInteger)folderItemCount
+{
+    return 10000;
+}
+
+- (NSData *)thumbnailData
+{
+    UIGraphicsBeginImageContextWithOptions(CGSizeMake(128, 128), YES, 1.0);
+    [[UIColor grayColor] setFill];
+    UIRectFill(CGRectMake(0, 0, 128, 128));
+    UIImage *image = UIGraphicsGetImageFromCurrentImageContext();
+    UIGraphicsEndImageContext();
+    return UIImagePNGRepresentation(image);
+}
+
+@end
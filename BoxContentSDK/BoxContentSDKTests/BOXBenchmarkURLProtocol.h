@@ -0,0 +1,44 @@
+//
+//  BOXBenchmarkURLProtocol.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+@interface BOXBenchmarkResponse : NSObject
+
+@property (nonatomic, readwrite, assign) NSInteger statusCode;
+@property (nonatomic, readwrite, strong) NSDictionary *headerFields;
+
+// Response body. If nil, generatedLength bytes of filler are streamed instead.
+@property (nonatomic, readwrite, strong) NSData *data;
+@property (nonatomic, readwrite, assign) unsigned long long generatedLength;
+
+// If set, the request fails with this error instead of receiving a response.
+@property (nonatomic, readwrite, strong) NSError *error;
+
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode JSONObject:(id)JSONObject;
++ (instancetype)responseWithError:(NSError *)error;
++ (instancetype)responseWithData:(NSData *)data contentType:(NSString *)contentType;
++ (instancetype)responseWithGeneratedLength:(unsigned long long)length;
+
+@end
+
+// Called with the request and the number of body bytes it sent.
+typedef BOXBenchmarkResponse *(^BOXBenchmarkRouteHandler)(NSURLRequest *request, unsigned long long bodyLength);
+
+// In-process stand-in for the Box API used by the benchmarks. Unlike BOXCannedURLProtocol, requests are
+// routed by method and path pattern rather than matched exactly, responses can be generated per request, and
+// large bodies are streamed without being held in memory.
+@interface BOXBenchmarkURLProtocol : NSURLProtocol
+
+// pathPattern is a regular expression matched against the path of the request URL.
++ (void)addRouteWithMethod:(NSString *)method
+               pathPattern:(NSString *)pathPattern
+                   handler:(BOXBenchmarkRouteHandler)handler;
+
++ (void)reset;
+
++ (NSUInteger)requestCount;
+
+@end
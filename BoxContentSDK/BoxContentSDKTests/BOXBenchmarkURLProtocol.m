@@ -0,0 +1,194 @@
+//
+//  BOXBenchmarkURLProtocol.m
+//  BoxContentSDK
+//
+
+#import "BOXBenchmarkURLProtocol.h"
+
+#define BOX_BENCHMARK_CHUNK_SIZE (1024 * 1024)
+
+@implementation BOXBenchmarkResponse
+
++ (instancetype)responseWithStatusCode:(NSInteger)statusCode JSONObject:(id)JSONObject
+{
+    BOXBenchmarkResponse *response = [[self alloc] init];
+    response.statusCode = statusCode;
+    response.headerFields = @{@"Content-Type" : @"application/json"};
+    response.data = JSONObject ? [NSJSONSerialization dataWithJSONObject:JSONObject options:0 error:nil] : [NSData data];
+    return response;
+}
+
++ (instancetype)responseWithData:(NSData *)data contentType:(NSString *)contentType
+{
+    BOXBenchmarkResponse *response = [[self alloc] init];
+    response.statusCode = 200;
+    response.headerFields = @{@"Content-Type" : contentType};
+    response.data = data;
+    return response;
+}
+
++ (instancetype)responseWithGeneratedLength:(unsigned long long)length
+{
+    BOXBenchmarkResponse *response = [[self alloc] init];
+    response.statusCode = 200;
+    response.headerFields = @{@"Content-Type" : @"application/octet-stream",
+                              @"Content-Length" : [NSString stringWithFormat:@"%llu", length]};
+    response.generatedLength = length;
+    return response;
+}
+
++ (instancetype)responseWithError:(NSError *)error
+{
+    BOXBenchmarkResponse *response = [[self alloc] init];
+    response.error = error;
+    return response;
+}
+
+@end
+
+@interface BOXBenchmarkRoute : NSObject
+
+@property (nonatomic, readwrite, copy) NSString *method;
+@property (nonatomic, readwrite, strong) NSRegularExpression *pathExpression;
+@property (nonatomic, readwrite, copy) BOXBenchmarkRouteHandler handler;
+
+@end
+
+@implementation BOXBenchmarkRoute
+@end
+
+static NSMutableArray *_routes;
+static NSUInteger _requestCount;
+
+@implementation BOXBenchmarkURLProtocol
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request
+{
+    return [self routeForRequest:request] != nil;
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request
+{
+    return request;
+}
+
+- (NSCachedURLResponse *)cachedResponse
+{
+    return nil;
+}
+
+- (void)startLoading
+{
+    NSURLRequest *request = [self request];
+    id<NSURLProtocolClient> client = [self client];
+    BOXBenchmarkRoute *route = [[self class] routeForRequest:request];
+
+    @synchronized([self class]) {
+        _requestCount++;
+    }
+
+    // Drain the body the way a server would, without keeping it.
+    unsigned long long bodyLength = request.HTTPBody.length;
+    NSInputStream *bodyStream = request.HTTPBodyStream;
+    if (bodyStream != nil) {
+        uint8_t *buffer = malloc(BOX_BENCHMARK_CHUNK_SIZE);
+        [bodyStream open];
+        NSInteger bytesRead = 0;
+        while ((bytesRead = [bodyStream read:buffer maxLength:BOX_BENCHMARK_CHUNK_SIZE]) > 0) {
+            bodyLength += bytesRead;
+        }
+        [bodyStream close];
+        free(buffer);
+    }
+
+    BOXBenchmarkResponse *response = route.handler(request, bodyLength);
+    if (response.error != nil) {
+        [client URLProtocol:self didFailWithError:response.error];
+        return;
+    }
+    NSHTTPURLResponse *URLResponse = [[NSHTTPURLResponse alloc] initWithURL:request.URL
+                                                                 statusCode:response.statusCode
+                                                                HTTPVersion:@"HTTP/1.1"
+                                                               headerFields:response.headerFields];
+    [client URLProtocol:self didReceiveResponse:URLResponse cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+
+    if (response.data != nil) {
+        if (response.data.length > 0) {
+            [client URLProtocol:self didLoadData:response.data];
+        }
+    } else {
+        NSMutableData *filler = [NSMutableData dataWithLength:BOX_BENCHMARK_CHUNK_SIZE];
+        memset(filler.mutableBytes, 'b', filler.length);
+        NSData *chunk = [filler copy];
+        unsigned long long remaining = response.generatedLength;
+        while (remaining > 0) {
+            @autoreleasepool {
+                NSUInteger length = (NSUInteger)MIN(remaining, (unsigned long long)BOX_BENCHMARK_CHUNK_SIZE);
+                [client URLProtocol:self didLoadData:(length == chunk.length) ? chunk : [chunk subdataWithRange:NSMakeRange(0, length)]];
+                remaining -= length;
+            }
+        }
+    }
+
+    [client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading
+{
+}
+
+#pragma mark - public class methods
+
++ (void)addRouteWithMethod:(NSString *)method
+               pathPattern:(NSString *)pathPattern
+                   handler:(BOXBenchmarkRouteHandler)handler
+{
+    BOXBenchmarkRoute *route = [[BOXBenchmarkRoute alloc] init];
+    route.method = method;
+    route.pathExpression = [NSRegularExpression regularExpressionWithPattern:pathPattern options:0 error:nil];
+    route.handler = handler;
+
+    @synchronized(self) {
+        if (_routes == nil) {
+            _routes = [NSMutableArray array];
+        }
+        [_routes addObject:route];
+    }
+}
+
++ (void)reset
+{
+    @synchronized(self) {
+        [_routes removeAllObjects];
+        _requestCount = 0;
+    }
+}
+
++ (NSUInteger)requestCount
+{
+    @synchronized(self) {
+        return _requestCount;
+    }
+}
+
+#pragma mark - private helpers
+
++ (BOXBenchmarkRoute *)routeForRequest:(NSURLRequest *)request
+{
+    NSString *path = request.URL.path;
+    if (path == nil) {
+        return nil;
+    }
+
+    @synchronized(self) {
+        for (BOXBenchmarkRoute *route in _routes) {
+            if ([route.method isEqualToString:request.HTTPMethod] &&
+                [route.pathExpression firstMatchInString:path options:0 range:NSMakeRange(0, path.length)] != nil) {
+                return route;
+            }
+        }
+    }
+    return nil;
+}
+
+@end
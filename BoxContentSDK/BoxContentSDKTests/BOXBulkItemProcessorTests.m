@@ -0,0 +1,260 @@
+//
+//  BOXBulkItemProcessorTests.m
+//  BoxContentSDK
+//
+
+#import "BOXStandInClientTestCase.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXBulkItemProcessor.h"
+#import "BOXBulkItemProcessor_Private.h"
+#import "BOXBookmark.h"
+#import "BOXFile.h"
+#import "BOXFolder.h"
+
+@interface BOXBulkItemProcessorTests : BOXStandInClientTestCase
+@end
+
+@implementation BOXBulkItemProcessorTests
+
+- (void)test_that_action_not_applying_to_item_type_fails_the_item_without_a_request
+{
+    // Bookmarks cannot be restored, so the client is never asked for a request.
+    id clientMock = [OCMockObject mockForClass:[BOXContentClient class]];
+    BOXBookmark *bookmark = [[BOXBookmark alloc] initWithJSON:@{BOXAPIObjectKeyType : BOXAPIItemTypeWebLink, BOXAPIObjectKeyID : @"5"}];
+    BOXBulkItemProcessor *processor = [[BOXBulkItemProcessor alloc] initWithClient:clientMock items:@[bookmark] action:BOXBulkItemActionRestore];
+
+    XCTestExpectation *itemExpectation = [self expectationWithDescription:@"item"];
+    processor.itemResultBlock = ^(BOXModel *item, BOXModel *resultItem, NSError *error) {
+        XCTAssertEqualObjects(@"5", item.modelID);
+        XCTAssertNil(resultItem);
+        XCTAssertEqual(BOXContentSDKAPIErrorBadRequest, error.code);
+        [itemExpectation fulfill];
+    };
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [processor startWithCompletion:^(NSUInteger succeededCount, NSDictionary<NSString *, NSError *> *errorsByItemKey, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(0, succeededCount);
+        XCTAssertEqual(BOXContentSDKAPIErrorBadRequest, errorsByItemKey[@"web_link_5"].code);
+        XCTAssertEqual(1, processor.completedCount);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_that_empty_item_list_completes
+{
+    id clientMock = [OCMockObject mockForClass:[BOXContentClient class]];
+    BOXBulkItemProcessor *processor = [[BOXBulkItemProcessor alloc] initWithClient:clientMock items:@[] action:BOXBulkItemActionDelete];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [processor startWithCompletion:^(NSUInteger succeededCount, NSDictionary<NSString *, NSError *> *errorsByItemKey, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(0, succeededCount);
+        XCTAssertEqual(0, errorsByItemKey.count);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+#pragma mark - Retries
+
+- (void)test_that_internal_error_is_retried_for_deletes
+{
+    NSArray *attempts = [self addRouteWithMethod:@"DELETE" pathPattern:@"/files/11$" responses:@[[self errorResponseWithStatusCode:500 code:@"internal_server_error"],
+                                                                                                 [BOXBenchmarkResponse responseWithStatusCode:204 JSONObject:nil]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"]] action:BOXBulkItemActionDelete];
+
+    [self runProcessor:processor expectedSucceededCount:1 expectedErrorsByItemKey:@{}];
+    XCTAssertEqual(2, [attempts[0] unsignedIntegerValue]);
+}
+
+- (void)test_that_network_error_is_retried_for_deletes
+{
+    NSError *networkError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil];
+    NSArray *attempts = [self addRouteWithMethod:@"DELETE" pathPattern:@"/files/11$" responses:@[[BOXBenchmarkResponse responseWithError:networkError],
+                                                                                                 [BOXBenchmarkResponse responseWithStatusCode:204 JSONObject:nil]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"]] action:BOXBulkItemActionDelete];
+
+    [self runProcessor:processor expectedSucceededCount:1 expectedErrorsByItemKey:@{}];
+    XCTAssertEqual(2, [attempts[0] unsignedIntegerValue]);
+}
+
+- (void)test_that_temporarily_blocked_folder_is_retried
+{
+    NSArray *attempts = [self addRouteWithMethod:@"DELETE" pathPattern:@"/folders/21$" responses:@[[self errorResponseWithStatusCode:409 code:@"operation_blocked_temporary"],
+                                                                                                   [BOXBenchmarkResponse responseWithStatusCode:204 JSONObject:nil]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self folderWithID:@"21"]] action:BOXBulkItemActionDelete];
+
+    [self runProcessor:processor expectedSucceededCount:1 expectedErrorsByItemKey:@{}];
+    XCTAssertEqual(2, [attempts[0] unsignedIntegerValue]);
+}
+
+- (void)test_that_client_error_is_not_retried
+{
+    NSArray *attempts = [self addRouteWithMethod:@"DELETE" pathPattern:@"/files/11$" responses:@[[self errorResponseWithStatusCode:404 code:@"not_found"]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"]] action:BOXBulkItemActionDelete];
+
+    [self runProcessor:processor expectedSucceededCount:0 expectedErrorsByItemKey:@{@"file_11" : @(BOXContentSDKAPIErrorNotFound)}];
+    XCTAssertEqual(1, [attempts[0] unsignedIntegerValue]);
+}
+
+- (void)test_that_copies_are_not_retried_after_internal_error
+{
+    NSArray *attempts = [self addRouteWithMethod:@"POST" pathPattern:@"/files/11/copy$" responses:@[[self errorResponseWithStatusCode:500 code:@"internal_server_error"],
+                                                                                                    [BOXBenchmarkResponse responseWithStatusCode:201 JSONObject:[self fileJSONWithID:@"12"]]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"]] action:BOXBulkItemActionCopy];
+
+    [self runProcessor:processor expectedSucceededCount:0 expectedErrorsByItemKey:@{@"file_11" : @(BOXContentSDKAPIErrorInternalServerError)}];
+    XCTAssertEqual(1, [attempts[0] unsignedIntegerValue]);
+}
+
+- (void)test_that_copies_are_not_retried_after_network_error
+{
+    NSError *networkError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil];
+    NSArray *attempts = [self addRouteWithMethod:@"POST" pathPattern:@"/files/11/copy$" responses:@[[BOXBenchmarkResponse responseWithError:networkError],
+                                                                                                    [BOXBenchmarkResponse responseWithStatusCode:201 JSONObject:[self fileJSONWithID:@"12"]]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"]] action:BOXBulkItemActionCopy];
+
+    [self runProcessor:processor expectedSucceededCount:0 expectedErrorsByItemKey:@{@"file_11" : @(NSURLErrorNetworkConnectionLost)}];
+    XCTAssertEqual(1, [attempts[0] unsignedIntegerValue]);
+}
+
+- (void)test_that_copies_are_retried_after_rate_limit
+{
+    NSArray *attempts = [self addRouteWithMethod:@"POST" pathPattern:@"/files/11/copy$" responses:@[[self errorResponseWithStatusCode:429 code:@"rate_limit_exceeded"],
+                                                                                                    [BOXBenchmarkResponse responseWithStatusCode:201 JSONObject:[self fileJSONWithID:@"12"]]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"]] action:BOXBulkItemActionCopy];
+
+    [self runProcessor:processor expectedSucceededCount:1 expectedErrorsByItemKey:@{}];
+    XCTAssertEqual(2, [attempts[0] unsignedIntegerValue]);
+}
+
+#pragma mark - Concurrency
+
+- (void)test_that_rate_limit_halves_concurrency_and_pauses
+{
+    [self addRouteWithMethod:@"DELETE" pathPattern:@"/files/11$" responses:@[[self errorResponseWithStatusCode:429 code:@"rate_limit_exceeded"],
+                                                                             [BOXBenchmarkResponse responseWithStatusCode:204 JSONObject:nil]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"]] action:BOXBulkItemActionDelete];
+    processor.initialConcurrency = 4;
+    processor.initialBackoffInterval = 0.2;
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    [self runProcessor:processor expectedSucceededCount:1 expectedErrorsByItemKey:@{}];
+
+    XCTAssertGreaterThanOrEqual(CFAbsoluteTimeGetCurrent() - startTime, 0.2);
+    XCTAssertEqual(2, processor.concurrencyLimit);
+}
+
+- (void)test_that_backoff_doubles_with_consecutive_rate_limits
+{
+    [self addRouteWithMethod:@"DELETE" pathPattern:@"/files/11$" responses:@[[self errorResponseWithStatusCode:429 code:@"rate_limit_exceeded"],
+                                                                             [self errorResponseWithStatusCode:429 code:@"rate_limit_exceeded"],
+                                                                             [BOXBenchmarkResponse responseWithStatusCode:204 JSONObject:nil]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"]] action:BOXBulkItemActionDelete];
+    processor.initialConcurrency = 4;
+    processor.initialBackoffInterval = 0.1;
+
+    CFAbsoluteTime startTime = CFAbsoluteTimeGetCurrent();
+    [self runProcessor:processor expectedSucceededCount:1 expectedErrorsByItemKey:@{}];
+
+    // 0.1s after the first rate limit, 0.2s after the second.
+    XCTAssertGreaterThanOrEqual(CFAbsoluteTimeGetCurrent() - startTime, 0.3);
+    XCTAssertEqual(1, processor.concurrencyLimit);
+}
+
+- (void)test_that_errors_of_items_sharing_an_ID_are_kept_apart
+{
+    [self addRouteWithMethod:@"DELETE" pathPattern:@"/files/11$" responses:@[[BOXBenchmarkResponse responseWithStatusCode:204 JSONObject:nil]]];
+    [self addRouteWithMethod:@"DELETE" pathPattern:@"/folders/11$" responses:@[[self errorResponseWithStatusCode:404 code:@"not_found"]]];
+    BOXBulkItemProcessor *processor = [self processorWithItems:@[[self fileWithID:@"11"], [self folderWithID:@"11"]] action:BOXBulkItemActionDelete];
+
+    [self runProcessor:processor expectedSucceededCount:1 expectedErrorsByItemKey:@{@"folder_11" : @(BOXContentSDKAPIErrorNotFound)}];
+    XCTAssertEqualObjects(@"folder_11", [BOXBulkItemProcessor keyForItem:[self folderWithID:@"11"]]);
+}
+
+- (void)test_that_successes_raise_concurrency_up_to_the_maximum
+{
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSUInteger index = 0; index < 4; index++) {
+        [items addObject:[self fileWithID:[NSString stringWithFormat:@"%lu", (unsigned long)(100 + index)]]];
+    }
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"DELETE" pathPattern:@"/files/\\d+$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        return [BOXBenchmarkResponse responseWithStatusCode:204 JSONObject:nil];
+    }];
+
+    // Two successes in a row raise the limit to 3; the next two are not enough to raise it again.
+    BOXBulkItemProcessor *processor = [self processorWithItems:items action:BOXBulkItemActionDelete];
+    processor.initialConcurrency = 2;
+    [self runProcessor:processor expectedSucceededCount:4 expectedErrorsByItemKey:@{}];
+    XCTAssertEqual(3, processor.concurrencyLimit);
+
+    BOXBulkItemProcessor *cappedProcessor = [self processorWithItems:items action:BOXBulkItemActionDelete];
+    cappedProcessor.initialConcurrency = 2;
+    cappedProcessor.maxConcurrency = 2;
+    [self runProcessor:cappedProcessor expectedSucceededCount:4 expectedErrorsByItemKey:@{}];
+    XCTAssertEqual(2, cappedProcessor.concurrencyLimit);
+}
+
+#pragma mark - Helpers
+
+- (BOXBulkItemProcessor *)processorWithItems:(NSArray *)items action:(BOXBulkItemAction)action
+{
+    BOXBulkItemProcessor *processor = [[BOXBulkItemProcessor alloc] initWithClient:self.client items:items action:action];
+    processor.destinationFolderID = @"0";
+    processor.initialBackoffInterval = 0.01;
+    return processor;
+}
+
+- (void)runProcessor:(BOXBulkItemProcessor *)processor
+expectedSucceededCount:(NSUInteger)expectedSucceededCount
+expectedErrorsByItemKey:(NSDictionary<NSString *, NSNumber *> *)expectedErrorCodesByItemKey
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [processor startWithCompletion:^(NSUInteger succeededCount, NSDictionary<NSString *, NSError *> *errorsByItemKey, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(expectedSucceededCount, succeededCount);
+        XCTAssertEqualObjects([NSSet setWithArray:expectedErrorCodesByItemKey.allKeys], [NSSet setWithArray:errorsByItemKey.allKeys]);
+        for (NSString *itemKey in expectedErrorCodesByItemKey) {
+            XCTAssertEqual([expectedErrorCodesByItemKey[itemKey] integerValue], errorsByItemKey[itemKey].code);
+        }
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+// Answers the requests matching the route with responses in turn, then with the last one. The returned array
+// holds the number of requests made.
+- (NSArray *)addRouteWithMethod:(NSString *)method pathPattern:(NSString *)pathPattern responses:(NSArray<BOXBenchmarkResponse *> *)responses
+{
+    NSMutableArray *attempts = [NSMutableArray arrayWithObject:@0];
+    [BOXBenchmarkURLProtocol addRouteWithMethod:method pathPattern:pathPattern handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        @synchronized(attempts) {
+            NSUInteger attempt = [attempts[0] unsignedIntegerValue];
+            attempts[0] = @(attempt + 1);
+            return responses[MIN(attempt, responses.count - 1)];
+        }
+    }];
+    return attempts;
+}
+
+- (BOXBenchmarkResponse *)errorResponseWithStatusCode:(NSInteger)statusCode code:(NSString *)code
+{
+    return [BOXBenchmarkResponse responseWithStatusCode:statusCode JSONObject:@{@"type" : @"error", @"status" : @(statusCode), @"code" : code}];
+}
+
+- (BOXFile *)fileWithID:(NSString *)fileID
+{
+    return [[BOXFile alloc] initWithJSON:[self fileJSONWithID:fileID]];
+}
+
+- (BOXFolder *)folderWithID:(NSString *)folderID
+{
+    return [[BOXFolder alloc] initWithJSON:[self folderJSONWithID:folderID]];
+}
+
+@end
@@ -0,0 +1,107 @@
+//
+//  BOXCancellationContextTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXCancellationContext.h"
+#import "BOXContentSDKErrors.h"
+
+@interface BOXCountingCancellable : NSObject <BOXCancellable>
+@property (atomic, readwrite, assign) NSUInteger cancelCount;
+@end
+
+@implementation BOXCountingCancellable
+
+- (void)cancel
+{
+    self.cancelCount++;
+}
+
+@end
+
+@interface BOXCancellationContextTests : BOXContentSDKTestCase
+@end
+
+@implementation BOXCancellationContextTests
+
+- (void)test_cancelling_a_context_cancels_its_descendants_once
+{
+    BOXCancellationContext *context = [[BOXCancellationContext alloc] init];
+    BOXCancellationContext *child = [context childContext];
+    BOXCancellationContext *grandchild = [child childContext];
+    BOXCountingCancellable *operation = [[BOXCountingCancellable alloc] init];
+    BOXCountingCancellable *childOperation = [[BOXCountingCancellable alloc] init];
+    [context addCancellable:operation];
+    [grandchild addCancellable:childOperation];
+    XCTAssertFalse([grandchild isCancelled]);
+
+    [context cancel];
+    [context cancel];
+
+    XCTAssertEqual(1, operation.cancelCount);
+    XCTAssertEqual(1, childOperation.cancelCount);
+    XCTAssertEqual(BOXContentSDKAPIUserCancelledError, [grandchild error].code);
+    XCTAssertEqual(0, [grandchild remainingTime]);
+
+    // Work registered afterwards is cancelled right away.
+    BOXCountingCancellable *lateOperation = [[BOXCountingCancellable alloc] init];
+    [[child childContext] addCancellable:lateOperation];
+    XCTAssertEqual(1, lateOperation.cancelCount);
+}
+
+- (void)test_cancelling_a_child_leaves_its_parent_alone
+{
+    BOXCancellationContext *context = [[BOXCancellationContext alloc] init];
+    BOXCancellationContext *child = [context childContext];
+    BOXCountingCancellable *operation = [[BOXCountingCancellable alloc] init];
+    [context addCancellable:operation];
+
+    [child cancel];
+
+    XCTAssertTrue([child isCancelled]);
+    XCTAssertFalse([context isCancelled]);
+    XCTAssertEqual(0, operation.cancelCount);
+}
+
+- (void)test_children_inherit_the_earliest_deadline
+{
+    NSDate *soon = [NSDate dateWithTimeIntervalSinceNow:60];
+    NSDate *later = [NSDate dateWithTimeIntervalSinceNow:120];
+    BOXCancellationContext *context = [[BOXCancellationContext alloc] initWithDeadline:soon];
+
+    XCTAssertEqualObjects(soon, [[BOXCancellationContext alloc] initWithParent:context deadline:later].deadline);
+    XCTAssertEqualObjects(soon, [context childContext].deadline);
+    NSDate *sooner = [NSDate dateWithTimeIntervalSinceNow:30];
+    XCTAssertEqualObjects(sooner, [[BOXCancellationContext alloc] initWithParent:context deadline:sooner].deadline);
+    XCTAssertEqual(DBL_MAX, [[BOXCancellationContext alloc] init].remainingTime);
+}
+
+- (void)test_passing_the_deadline_cancels_registered_work
+{
+    BOXCancellationContext *context = [[BOXCancellationContext alloc] initWithDeadline:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    BOXCancellationContext *child = [context childContext];
+    BOXCountingCancellable *operation = [[BOXCountingCancellable alloc] init];
+    [child addCancellable:operation];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        while (operation.cancelCount == 0) {
+            [NSThread sleepForTimeInterval:0.01];
+        }
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTAssertEqual(BOXContentSDKAPIDeadlineExceededError, [child error].code);
+    XCTAssertEqual(BOXContentSDKAPIDeadlineExceededError, [context error].code);
+}
+
+- (void)test_an_expired_context_is_cancelled_before_its_timer_fires
+{
+    BOXCancellationContext *context = [[BOXCancellationContext alloc] initWithDeadline:[NSDate dateWithTimeIntervalSinceNow:-1]];
+    XCTAssertTrue([context isCancelled]);
+    XCTAssertEqual(BOXContentSDKAPIDeadlineExceededError, [context error].code);
+}
+
+@end
@@ -7,6 +7,13 @@
 //
 
 #import "BOXCannedURLProtocol.h"
+#import "BOXSimulatedNetwork.h"
+
+@interface BOXCannedURLProtocol ()
+
+@property (nonatomic, readwrite, strong) BOXSimulatedTransfer *simulatedTransfer;
+
+@end
 
 @implementation BOXCannedURLProtocol
 
@@ -79,6 +86,14 @@
             }
         }
         
+        // Deliver through the simulated network if the test set conditions for this host.
+        self.simulatedTransfer = [[BOXSimulatedNetwork sharedNetwork] startTransferWithResponse:cannedResponse.URLResponse
+                                                                                           data:cannedResponse.responseData
+                                                                                    forProtocol:self];
+        if (self.simulatedTransfer != nil) {
+            return;
+        }
+        
         [client URLProtocol:self didReceiveResponse:cannedResponse.URLResponse cacheStoragePolicy:NSURLCacheStorageNotAllowed];
         
         // Simulate receiving data in multiple chunks to ensure our networking layer handles that correctly.
@@ -93,6 +108,8 @@
 
 - (void)stopLoading
 {
+    [self.simulatedTransfer cancel];
+    self.simulatedTransfer = nil;
 }
 
 #pragma mark - public class methods
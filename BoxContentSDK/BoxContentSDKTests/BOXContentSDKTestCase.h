@@ -13,6 +13,7 @@
 @class BOXModel;
 @class BOXSharedLink;
 @class BOXFileLock;
+@class BOXContentClient;
 
 @interface BOXContentSDKTestCase : XCTestCase
 
@@ -22,4 +23,8 @@
 
 - (void)assertSharedLink:(BOXSharedLink *)sharedLinkA isEquivalentTo:(BOXSharedLink *)sharedLinkB;
 
+// Returns a client with a new session whose requests are all served by URLProtocolClass, e.g. a stand-in for the
+// Box API. The session's access token never expires.
+- (BOXContentClient *)clientWithURLProtocolClass:(Class)URLProtocolClass accessToken:(NSString *)accessToken refreshToken:(NSString *)refreshToken;
+
 @end
@@ -20,6 +20,10 @@
 #import "BOXFileVersion.h"
 #import "BOXCollaboration.h"
 #import "BOXMetadata.h"
+#import "BOXAbstractSession_Private.h"
+#import "BOXContentClient_Private.h"
+#import "BOXOAuth2Session.h"
+#import "BOXURLSessionManager_Private.h"
 
 @implementation BOXContentSDKTestCase
 
@@ -290,6 +294,21 @@
     XCTAssertEqualObjects(sharedLinkA.previewCount, sharedLinkB.previewCount);
 }
 
+- (BOXContentClient *)clientWithURLProtocolClass:(Class)URLProtocolClass accessToken:(NSString *)accessToken refreshToken:(NSString *)refreshToken
+{
+    BOXContentClient *client = [BOXContentClient clientForNewSession];
+    BOXURLSessionManager *urlSessionManager = [[BOXURLSessionManager alloc] initWithProtocolClasses:@[URLProtocolClass]];
+    BOXOAuth2Session *session = [[BOXOAuth2Session alloc] initWithClientID:@"test_client_id"
+                                                                    secret:@"test_client_secret"
+                                                              queueManager:client.queueManager
+                                                         urlSessionManager:urlSessionManager];
+    session.accessToken = accessToken;
+    session.refreshToken = refreshToken;
+    session.accessTokenExpiration = [NSDate distantFuture];
+    client.session = session;
+    return client;
+}
+
 - (void)wipeAllKeychainEntries
 {
     NSArray *secClases = @[(__bridge id)kSecClassGenericPassword,
@@ -302,6 +321,9 @@
         NSMutableDictionary *query = [NSMutableDictionary dictionaryWithObjectsAndKeys:secClass, (__bridge id)kSecClass, nil];
         SecItemDelete((__bridge CFDictionaryRef)query);
     }
+    
+    // Drop the credentials the store still has in memory.
+    [[BOXAbstractSession credentialStore] invalidate];
 }
 
 @end
@@ -0,0 +1,124 @@
+//
+//  BOXCredentialStoreTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXCredentialStore.h"
+#import "BOXKeychainItemWrapper.h"
+
+@interface BOXCredentialStore ()
+- (OSStatus)copyMatchingKeychainQuery:(NSDictionary *)query result:(CFTypeRef *)result;
+@end
+
+// Fails its next keychain fetch the way SecItemCopyMatching does while the device is locked.
+@interface BOXFailingCredentialStore : BOXCredentialStore
+@property (nonatomic, readwrite, assign) BOOL failsNextFetch;
+@property (nonatomic, readwrite, assign) NSUInteger fetchCount;
+@end
+
+@implementation BOXFailingCredentialStore
+
+- (OSStatus)copyMatchingKeychainQuery:(NSDictionary *)query result:(CFTypeRef *)result
+{
+    self.fetchCount++;
+    if (self.failsNextFetch) {
+        self.failsNextFetch = NO;
+        return errSecInteractionNotAllowed;
+    }
+    return [super copyMatchingKeychainQuery:query result:result];
+}
+
+@end
+
+@interface BOXCredentialStoreTests : BOXContentSDKTestCase
+@property (nonatomic, readwrite, strong) BOXCredentialStore *store;
+@end
+
+@implementation BOXCredentialStoreTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.store = [[BOXCredentialStore alloc] initWithIdentifierPrefix:@"BoxCredentialStoreTest_" accessGroup:nil];
+}
+
+- (void)test_stored_credentials_are_fetched_by_a_new_store
+{
+    [self.store storeCredentialDictionary:@{@"user_id" : @"1", @"access_token" : @"abc"} forUserWithID:@"1"];
+    [self.store storeCredentialDictionary:@{@"user_id" : @"2", @"access_token" : @"def"} forUserWithID:@"2"];
+
+    BOXCredentialStore *otherStore = [[BOXCredentialStore alloc] initWithIdentifierPrefix:@"BoxCredentialStoreTest_" accessGroup:nil];
+    NSDictionary *expectedDictionaries = @{@"1" : @{@"user_id" : @"1", @"access_token" : @"abc"},
+                                           @"2" : @{@"user_id" : @"2", @"access_token" : @"def"}};
+    XCTAssertEqualObjects(expectedDictionaries, [otherStore credentialDictionariesByUserID]);
+
+    BOXCredentialStore *storeWithOtherPrefix = [[BOXCredentialStore alloc] initWithIdentifierPrefix:@"OtherPrefix_" accessGroup:nil];
+    XCTAssertEqual(0, [storeWithOtherPrefix credentialDictionariesByUserID].count);
+}
+
+- (void)test_writes_reach_the_keychain_before_they_return
+{
+    XCTAssertEqual(0, [self.store credentialDictionariesByUserID].count);
+
+    [self.store storeCredentialDictionary:@{@"access_token" : @"abc"} forUserWithID:@"1"];
+    XCTAssertEqualObjects(@"abc", [self.store credentialDictionaryForUserWithID:@"1"][@"access_token"]);
+    BOXKeychainItemWrapper *keychain = [[BOXKeychainItemWrapper alloc] initWithIdentifier:@"BoxCredentialStoreTest_1" accessGroup:nil];
+    XCTAssertEqualObjects(@"{\"access_token\":\"abc\"}", [keychain objectForKey:(__bridge id)kSecValueData]);
+
+    [self.store removeCredentialDictionaryForUserWithID:@"1"];
+    XCTAssertNil([self.store credentialDictionaryForUserWithID:@"1"]);
+    BOXCredentialStore *otherStore = [[BOXCredentialStore alloc] initWithIdentifierPrefix:@"BoxCredentialStoreTest_" accessGroup:nil];
+    XCTAssertNil([otherStore credentialDictionaryForUserWithID:@"1"]);
+}
+
+- (void)test_writes_of_another_store_drop_the_index
+{
+    BOXCredentialStore *otherStore = [[BOXCredentialStore alloc] initWithIdentifierPrefix:@"BoxCredentialStoreTest_" accessGroup:nil];
+    [self.store storeCredentialDictionary:@{@"access_token" : @"abc"} forUserWithID:@"1"];
+    XCTAssertEqualObjects(@"abc", [otherStore credentialDictionaryForUserWithID:@"1"][@"access_token"]);
+
+    // Stands in for an app extension sharing the keychain, which writes through a store of its own.
+    [self.store storeCredentialDictionary:@{@"access_token" : @"def"} forUserWithID:@"1"];
+
+    NSDate *timeout = [NSDate dateWithTimeIntervalSinceNow:2.0];
+    while (![[otherStore credentialDictionaryForUserWithID:@"1"][@"access_token"] isEqualToString:@"def"] && [timeout timeIntervalSinceNow] > 0) {
+        [[NSRunLoop currentRunLoop] runMode:NSDefaultRunLoopMode beforeDate:[NSDate dateWithTimeIntervalSinceNow:0.05]];
+    }
+    XCTAssertEqualObjects(@"def", [otherStore credentialDictionaryForUserWithID:@"1"][@"access_token"]);
+}
+
+- (void)test_changes_made_outside_the_store_are_seen_after_invalidation_or_reload
+{
+    [self.store storeCredentialDictionary:@{@"access_token" : @"abc"} forUserWithID:@"1"];
+
+    BOXKeychainItemWrapper *keychain = [[BOXKeychainItemWrapper alloc] initWithIdentifier:@"BoxCredentialStoreTest_1" accessGroup:nil];
+    [keychain resetKeychainItem];
+    [keychain setObject:@"{\"access_token\":\"def\"}" forKey:(__bridge id)kSecValueData];
+
+    XCTAssertEqualObjects(@"abc", [self.store credentialDictionaryForUserWithID:@"1"][@"access_token"]);
+    XCTAssertEqualObjects(@"def", [self.store reloadCredentialDictionaryForUserWithID:@"1"][@"access_token"]);
+    XCTAssertEqualObjects(@"def", [self.store credentialDictionaryForUserWithID:@"1"][@"access_token"]);
+
+    [keychain setObject:@"{\"access_token\":\"ghi\"}" forKey:(__bridge id)kSecValueData];
+    [self.store invalidate];
+    XCTAssertEqualObjects(@"ghi", [self.store credentialDictionaryForUserWithID:@"1"][@"access_token"]);
+}
+
+- (void)test_a_failed_keychain_fetch_is_not_kept_as_the_index
+{
+    [self.store storeCredentialDictionary:@{@"access_token" : @"abc"} forUserWithID:@"1"];
+
+    BOXFailingCredentialStore *otherStore = [[BOXFailingCredentialStore alloc] initWithIdentifierPrefix:@"BoxCredentialStoreTest_" accessGroup:nil];
+    otherStore.failsNextFetch = YES;
+    XCTAssertEqual(0, [otherStore credentialDictionariesByUserID].count);
+
+    XCTAssertEqualObjects(@"abc", [otherStore credentialDictionaryForUserWithID:@"1"][@"access_token"]);
+    XCTAssertEqual(2, otherStore.fetchCount);
+
+    // A successful fetch is kept.
+    XCTAssertEqualObjects(@"abc", [otherStore credentialDictionaryForUserWithID:@"1"][@"access_token"]);
+    XCTAssertEqual(2, otherStore.fetchCount);
+}
+
+@end
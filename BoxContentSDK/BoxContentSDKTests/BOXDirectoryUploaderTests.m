@@ -0,0 +1,226 @@
+//
+//  BOXDirectoryUploaderTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXAPIEmulator.h"
+#import "BOXAPIEmulatorURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXContentClient+Folder.h"
+#import "BOXDirectoryUploader.h"
+#import "BOXContentSDKErrors.h"
+
+// Records the folder creations and uploads it answers, in the order they arrive.
+@interface BOXDirectoryUploaderTestEmulator : BOXAPIEmulator
+
+@property (nonatomic, readonly, strong) NSMutableArray *requestLog;
+
+@end
+
+@implementation BOXDirectoryUploaderTestEmulator
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _requestLog = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (BOXCannedResponse *)responseForRequest:(NSURLRequest *)request body:(NSData *)body
+{
+    if ([request.HTTPMethod isEqualToString:@"POST"]) {
+        NSString *entry = nil;
+        if ([request.URL.path hasSuffix:@"/folders"]) {
+            NSDictionary *JSON = [NSJSONSerialization JSONObjectWithData:body options:0 error:nil];
+            entry = [NSString stringWithFormat:@"folder %@", JSON[@"name"]];
+        } else if ([request.URL.path hasSuffix:@"/files/content"]) {
+            entry = @"upload";
+        }
+        if (entry) {
+            @synchronized(self.requestLog) {
+                [self.requestLog addObject:entry];
+            }
+        }
+    }
+    return [super responseForRequest:request body:body];
+}
+
+@end
+
+@interface BOXDirectoryUploaderTests : BOXContentSDKTestCase
+
+@property (nonatomic, readwrite, strong) BOXDirectoryUploaderTestEmulator *emulator;
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, copy) NSString *localPath;
+
+@end
+
+@implementation BOXDirectoryUploaderTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.emulator = [[BOXDirectoryUploaderTestEmulator alloc] init];
+    [BOXAPIEmulatorURLProtocol setEmulator:self.emulator];
+
+    self.client = [self clientWithURLProtocolClass:[BOXAPIEmulatorURLProtocol class]
+                                       accessToken:@"emulator_access_token_0"
+                                      refreshToken:@"emulator_refresh_token_0"];
+
+    self.localPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:[self.localPath stringByAppendingPathComponent:@"Photos"] withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.localPath error:nil];
+    [BOXAPIEmulatorURLProtocol setEmulator:nil];
+    self.emulator = nil;
+    self.client = nil;
+
+    [super tearDown];
+}
+
+- (void)test_that_files_upload_while_subfolders_are_still_being_created
+{
+    [self writeFileAtRelativePath:@"Photos/cover.jpg" length:300 seed:1];
+    [self writeFileAtRelativePath:@"Photos/a/b/c/d/e/beach.jpg" length:200 seed:2];
+
+    BOXDirectoryUploader *uploader = [self uploaderForDirectoryNamed:@"Photos"];
+    [self uploadWithUploader:uploader expectedErrorCode:0 filesUploaded:2 filesSkipped:0];
+
+    // The skeleton is a chain, so each folder waits for its parent. The file at the top must not wait for
+    // the bottom of the chain.
+    NSArray *requestLog = self.emulator.requestLog;
+    NSUInteger firstUploadIndex = [requestLog indexOfObject:@"upload"];
+    NSUInteger deepestFolderIndex = [requestLog indexOfObject:@"folder e"];
+    XCTAssertNotEqual(NSNotFound, firstUploadIndex);
+    XCTAssertNotEqual(NSNotFound, deepestFolderIndex);
+    XCTAssertLessThan(firstUploadIndex, deepestFolderIndex);
+    XCTAssertEqual(0, [requestLog indexOfObject:@"folder Photos"]);
+}
+
+- (void)test_that_existing_folder_is_reused_and_identical_file_is_skipped
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Photos" parentID:@"0"];
+    NSData *data = [self writeFileAtRelativePath:@"Photos/cover.jpg" length:300 seed:3];
+    [self writeFileAtRelativePath:@"Photos/beach.jpg" length:200 seed:4];
+    [self.emulator createFileWithName:@"cover.jpg" parentID:folderID data:data];
+
+    BOXDirectoryUploader *uploader = [self uploaderForDirectoryNamed:@"Photos"];
+    NSString *uploadedFolderID = [self uploadWithUploader:uploader expectedErrorCode:0 filesUploaded:1 filesSkipped:1];
+
+    XCTAssertEqualObjects(folderID, uploadedFolderID);
+    XCTAssertEqual(200, uploader.bytesUploaded);
+}
+
+- (void)test_that_conflicting_file_fails_without_stopping_the_others
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Photos" parentID:@"0"];
+    [self writeFileAtRelativePath:@"Photos/cover.jpg" length:300 seed:5];
+    [self writeFileAtRelativePath:@"Photos/beach.jpg" length:200 seed:6];
+    [self writeFileAtRelativePath:@"Photos/2016/sunset.jpg" length:100 seed:7];
+    [self.emulator createFileWithName:@"cover.jpg" parentID:folderID data:[self dataWithLength:300 seed:8]];
+
+    BOXDirectoryUploader *uploader = [self uploaderForDirectoryNamed:@"Photos"];
+    [self uploadWithUploader:uploader expectedErrorCode:BOXContentSDKAPIErrorConflict filesUploaded:2 filesSkipped:0];
+
+    XCTAssertEqual(300, uploader.bytesUploaded);
+}
+
+- (void)test_that_hidden_files_are_only_uploaded_when_asked
+{
+    [self writeFileAtRelativePath:@"Photos/cover.jpg" length:300 seed:9];
+    [self writeFileAtRelativePath:@"Photos/.DS_Store" length:20 seed:10];
+    [self writeFileAtRelativePath:@"Photos/.thumbnails/cover.jpg" length:30 seed:11];
+
+    BOXDirectoryUploader *uploader = [self uploaderForDirectoryNamed:@"Photos"];
+    [self uploadWithUploader:uploader expectedErrorCode:0 filesUploaded:1 filesSkipped:0];
+    XCTAssertEqual(300, uploader.bytesUploaded);
+    XCTAssertFalse([self.emulator.requestLog containsObject:@"folder .thumbnails"]);
+
+    BOXDirectoryUploader *hiddenFilesUploader = [self uploaderForDirectoryNamed:@"Photos"];
+    hiddenFilesUploader.skipsHiddenFiles = NO;
+    [self uploadWithUploader:hiddenFilesUploader expectedErrorCode:0 filesUploaded:2 filesSkipped:1];
+    XCTAssertTrue([self.emulator.requestLog containsObject:@"folder .thumbnails"]);
+}
+
+- (void)test_that_progress_totals_only_count_files_still_to_upload
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Photos" parentID:@"0"];
+    NSData *data = [self writeFileAtRelativePath:@"Photos/cover.jpg" length:300 seed:9];
+    [self writeFileAtRelativePath:@"Photos/beach.jpg" length:200 seed:10];
+    [self writeFileAtRelativePath:@"Photos/2016/sunset.jpg" length:100 seed:11];
+    [self writeFileAtRelativePath:@"Photos/2016/dunes.jpg" length:400 seed:12];
+    [self.emulator createFileWithName:@"cover.jpg" parentID:folderID data:data];
+    [self.emulator createFileWithName:@"beach.jpg" parentID:folderID data:[self dataWithLength:200 seed:13]];
+
+    BOXDirectoryUploader *uploader = [self uploaderForDirectoryNamed:@"Photos"];
+    NSMutableArray *reports = [NSMutableArray array];
+    uploader.progressBlock = ^(unsigned long long bytesUploaded, unsigned long long totalBytes, double bytesPerSecond, NSTimeInterval estimatedTimeRemaining) {
+        [reports addObject:@[@(bytesUploaded), @(totalBytes)]];
+    };
+    [self uploadWithUploader:uploader expectedErrorCode:BOXContentSDKAPIErrorConflict filesUploaded:2 filesSkipped:1];
+
+    // The skipped and the failed files are taken out of the total, so the last report is complete.
+    XCTAssertEqualObjects((@[@500, @500]), reports.lastObject);
+    for (NSArray *report in reports) {
+        XCTAssertLessThanOrEqual([report[0] unsignedLongLongValue], [report[1] unsignedLongLongValue]);
+        XCTAssertLessThanOrEqual([report[1] unsignedLongLongValue], 1000);
+    }
+}
+
+#pragma mark - Helpers
+
+- (BOXDirectoryUploader *)uploaderForDirectoryNamed:(NSString *)name
+{
+    return [self.client directoryUploaderWithLocalPath:[self.localPath stringByAppendingPathComponent:name] parentFolderID:@"0"];
+}
+
+// Returns the ID of the folder of the directory.
+- (NSString *)uploadWithUploader:(BOXDirectoryUploader *)uploader
+               expectedErrorCode:(NSInteger)expectedErrorCode
+                   filesUploaded:(NSUInteger)expectedFilesUploaded
+                    filesSkipped:(NSUInteger)expectedFilesSkipped
+{
+    __block NSString *uploadedFolderID = nil;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"upload"];
+    [uploader startWithCompletion:^(NSString *folderID, NSUInteger filesUploaded, NSUInteger filesSkipped, NSError *error) {
+        if (expectedErrorCode == 0) {
+            XCTAssertNil(error);
+        } else {
+            XCTAssertEqualObjects(BOXContentSDKErrorDomain, error.domain);
+            XCTAssertEqual(expectedErrorCode, error.code);
+        }
+        XCTAssertEqual(expectedFilesUploaded, filesUploaded);
+        XCTAssertEqual(expectedFilesSkipped, filesSkipped);
+        uploadedFolderID = folderID;
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    return uploadedFolderID;
+}
+
+- (NSData *)writeFileAtRelativePath:(NSString *)relativePath length:(NSUInteger)length seed:(uint8_t)seed
+{
+    NSString *path = [self.localPath stringByAppendingPathComponent:relativePath];
+    [[NSFileManager defaultManager] createDirectoryAtPath:[path stringByDeletingLastPathComponent] withIntermediateDirectories:YES attributes:nil error:nil];
+    NSData *data = [self dataWithLength:length seed:seed];
+    [data writeToFile:path atomically:YES];
+    return data;
+}
+
+- (NSData *)dataWithLength:(NSUInteger)length seed:(uint8_t)seed
+{
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    for (NSUInteger i = 0; i < length; i++) {
+        bytes[i] = (uint8_t)(i * 31 + seed);
+    }
+    return data;
+}
+
+@end
@@ -0,0 +1,240 @@
+//
+//  BOXEventsAdminLogsExporterTests.m
+//  BoxContentSDK
+//
+
+#import "BOXStandInClientTestCase.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXContentClient+Event.h"
+#import "BOXEventsAdminLogsExporter.h"
+#import "BOXEvent.h"
+#import "BOXContentSDKErrors.h"
+#import "NSURL+BOXURLHelper.h"
+#import "NSDate+BOXContentSDKAdditions.h"
+
+#define BOX_EXPORT_TEST_HOUR (60.0 * 60.0)
+
+// Keeps the events written to it.
+@interface BOXEventsAdminLogsExporterTestSink : NSObject <BOXEventsExportSink>
+
+@property (nonatomic, readonly, strong) NSMutableArray *events;
+@property (nonatomic, readwrite, assign) BOOL closed;
+
+@end
+
+@implementation BOXEventsAdminLogsExporterTestSink
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _events = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (BOOL)writeEvent:(BOXEvent *)event error:(NSError **)error
+{
+    [self.events addObject:event];
+    return YES;
+}
+
+- (BOOL)closeWithError:(NSError **)error
+{
+    self.closed = YES;
+    return YES;
+}
+
+@end
+
+@interface BOXEventsAdminLogsExporterTests : BOXStandInClientTestCase
+
+@property (nonatomic, readwrite, strong) BOXEventsAdminLogsExporterTestSink *sink;
+@property (nonatomic, readwrite, strong) NSDate *startDate;
+// Events held by the stand-in, in the order they were created.
+@property (nonatomic, readwrite, strong) NSMutableArray *eventsJSON;
+// Range and stream position of every request received, e.g. "0-3600@0", in seconds after startDate.
+@property (nonatomic, readwrite, strong) NSMutableArray *requestedPages;
+
+@end
+
+@implementation BOXEventsAdminLogsExporterTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.sink = [[BOXEventsAdminLogsExporterTestSink alloc] init];
+    self.startDate = [NSDate dateWithTimeIntervalSince1970:1451606400];
+    self.eventsJSON = [NSMutableArray array];
+    self.requestedPages = [NSMutableArray array];
+}
+
+- (void)test_that_range_is_split_into_windows
+{
+    [self addEventsAtOffsets:@[@(0.5 * BOX_EXPORT_TEST_HOUR), @(1.5 * BOX_EXPORT_TEST_HOUR), @(2.5 * BOX_EXPORT_TEST_HOUR), @(3.5 * BOX_EXPORT_TEST_HOUR)]];
+    [self addEventsRouteWithErrorStatusCodes:nil];
+
+    BOXEventsAdminLogsExporter *exporter = [self exporterForHours:4];
+    exporter.windowInterval = BOX_EXPORT_TEST_HOUR;
+    [self exportWithExporter:exporter expectedEventCount:4 expectedErrorCode:0];
+
+    NSArray *expectedPages = @[@"0-3600@0", @"3600-7200@0", @"7200-10800@0", @"10800-14400@0"];
+    XCTAssertEqualObjects([NSSet setWithArray:expectedPages], [NSSet setWithArray:self.requestedPages]);
+    XCTAssertEqual(expectedPages.count, self.requestedPages.count);
+    XCTAssertTrue(self.sink.closed);
+}
+
+- (void)test_that_event_at_a_window_boundary_is_written_once
+{
+    [self addEventsAtOffsets:@[@(0.5 * BOX_EXPORT_TEST_HOUR), @(BOX_EXPORT_TEST_HOUR), @(1.5 * BOX_EXPORT_TEST_HOUR)]];
+    [self addEventsRouteWithErrorStatusCodes:nil];
+
+    BOXEventsAdminLogsExporter *exporter = [self exporterForHours:2];
+    exporter.windowInterval = BOX_EXPORT_TEST_HOUR;
+    [self exportWithExporter:exporter expectedEventCount:3 expectedErrorCode:0];
+
+    NSArray *eventIDs = [self.sink.events valueForKey:@"modelID"];
+    XCTAssertEqualObjects((@[@"event_0", @"event_1", @"event_2"]), [eventIDs sortedArrayUsingSelector:@selector(compare:)]);
+}
+
+- (void)test_that_window_pages_through_its_stream_positions
+{
+    [self addEventsAtOffsets:@[@60, @120, @180, @240, @300]];
+    [self addEventsRouteWithErrorStatusCodes:nil];
+
+    BOXEventsAdminLogsExporter *exporter = [self exporterForHours:1];
+    exporter.limit = 2;
+    [self exportWithExporter:exporter expectedEventCount:5 expectedErrorCode:0];
+
+    XCTAssertEqualObjects((@[@"0-3600@0", @"0-3600@2", @"0-3600@4"]), self.requestedPages);
+    XCTAssertEqualObjects((@[@"event_0", @"event_1", @"event_2", @"event_3", @"event_4"]), [self.sink.events valueForKey:@"modelID"]);
+}
+
+- (void)test_that_rate_limited_page_is_retried
+{
+    [self addEventsAtOffsets:@[@60, @120]];
+    [self addEventsRouteWithErrorStatusCodes:@[@429]];
+
+    BOXEventsAdminLogsExporter *exporter = [self exporterForHours:1];
+    [self exportWithExporter:exporter expectedEventCount:2 expectedErrorCode:0];
+
+    XCTAssertEqualObjects((@[@"0-3600@0", @"0-3600@0"]), self.requestedPages);
+}
+
+- (void)test_that_forbidden_page_fails_the_export
+{
+    [self addEventsAtOffsets:@[@60]];
+    [self addEventsRouteWithErrorStatusCodes:@[@403]];
+
+    BOXEventsAdminLogsExporter *exporter = [self exporterForHours:1];
+    [self exportWithExporter:exporter expectedEventCount:0 expectedErrorCode:BOXContentSDKAPIErrorForbidden];
+
+    XCTAssertEqual(1, self.requestedPages.count);
+    XCTAssertTrue(self.sink.closed);
+}
+
+- (void)test_that_missing_dates_fail_without_a_request
+{
+    [self addEventsRouteWithErrorStatusCodes:nil];
+
+    BOXEventsAdminLogsExporter *exporter = [self.client eventsAdminLogsExporterWithCreatedAfterDate:nil
+                                                                                  createdBeforeDate:self.startDate
+                                                                                               sink:self.sink];
+    [self exportWithExporter:exporter expectedEventCount:0 expectedErrorCode:BOXContentSDKAPIErrorBadRequest];
+
+    exporter = [self.client eventsAdminLogsExporterWithCreatedAfterDate:self.startDate
+                                                      createdBeforeDate:nil
+                                                                   sink:self.sink];
+    [self exportWithExporter:exporter expectedEventCount:0 expectedErrorCode:BOXContentSDKAPIErrorBadRequest];
+
+    XCTAssertEqual(0, self.requestedPages.count);
+}
+
+#pragma mark - Helpers
+
+- (BOXEventsAdminLogsExporter *)exporterForHours:(NSUInteger)hours
+{
+    return [self.client eventsAdminLogsExporterWithCreatedAfterDate:self.startDate
+                                                  createdBeforeDate:[self.startDate dateByAddingTimeInterval:hours * BOX_EXPORT_TEST_HOUR]
+                                                               sink:self.sink];
+}
+
+- (void)exportWithExporter:(BOXEventsAdminLogsExporter *)exporter expectedEventCount:(unsigned long long)expectedEventCount expectedErrorCode:(NSInteger)expectedErrorCode
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"export"];
+    [exporter startWithCompletion:^(unsigned long long eventsExported, double eventsPerSecond, NSError *error) {
+        if (expectedErrorCode == 0) {
+            XCTAssertNil(error);
+        } else {
+            XCTAssertEqualObjects(BOXContentSDKErrorDomain, error.domain);
+            XCTAssertEqual(expectedErrorCode, error.code);
+        }
+        XCTAssertEqual(expectedEventCount, eventsExported);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    XCTAssertEqual(expectedEventCount, self.sink.events.count);
+}
+
+// Adds an event at each offset, in seconds after startDate.
+- (void)addEventsAtOffsets:(NSArray *)offsets
+{
+    for (NSNumber *offset in offsets) {
+        NSDate *createdDate = [self.startDate dateByAddingTimeInterval:offset.doubleValue];
+        [self.eventsJSON addObject:@{@"type" : @"event",
+                                     @"event_id" : [NSString stringWithFormat:@"event_%lu", (unsigned long)self.eventsJSON.count],
+                                     @"event_type" : @"LOGIN",
+                                     @"created_at" : [createdDate box_ISO8601String],
+                                     @"created_by" : @{@"type" : @"user", @"id" : @"11446498", @"name" : @"Admin"}}];
+    }
+}
+
+// Serves the events created within the requested range, bounds included as the API does, a page at a time
+// with the index of the next event as the stream position. The first requests fail with errorStatusCodes.
+- (void)addEventsRouteWithErrorStatusCodes:(NSArray *)errorStatusCodes
+{
+    NSArray *eventsJSON = [self.eventsJSON copy];
+    NSDate *startDate = self.startDate;
+    NSMutableArray *requestedPages = self.requestedPages;
+    NSMutableArray *remainingErrorStatusCodes = [errorStatusCodes mutableCopy] ?: [NSMutableArray array];
+
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"GET" pathPattern:@"/events$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        NSDictionary *parameters = [request.URL box_queryDictionary];
+        NSDate *createdAfterDate = [NSDate box_dateWithISO8601String:parameters[BOXAPIParameterKeyCreatedAfter]];
+        NSDate *createdBeforeDate = [NSDate box_dateWithISO8601String:parameters[BOXAPIParameterKeyCreatedBefore]];
+        NSUInteger position = (NSUInteger)[parameters[BOXAPIParameterKeyStreamPosition] integerValue];
+        NSUInteger limit = (NSUInteger)[parameters[BOXAPIParameterKeyLimit] integerValue];
+
+        NSNumber *errorStatusCode = nil;
+        @synchronized(requestedPages) {
+            [requestedPages addObject:[NSString stringWithFormat:@"%.0f-%.0f@%lu",
+                                       [createdAfterDate timeIntervalSinceDate:startDate],
+                                       [createdBeforeDate timeIntervalSinceDate:startDate],
+                                       (unsigned long)position]];
+            errorStatusCode = remainingErrorStatusCodes.firstObject;
+            if (errorStatusCode) {
+                [remainingErrorStatusCodes removeObjectAtIndex:0];
+            }
+        }
+        if (errorStatusCode) {
+            return [BOXBenchmarkResponse responseWithStatusCode:errorStatusCode.integerValue
+                                                     JSONObject:@{@"type" : @"error", @"status" : errorStatusCode}];
+        }
+
+        NSMutableArray *matchingEvents = [NSMutableArray array];
+        for (NSDictionary *eventJSON in eventsJSON) {
+            NSDate *createdDate = [NSDate box_dateWithISO8601String:eventJSON[@"created_at"]];
+            if ([createdDate compare:createdAfterDate] != NSOrderedAscending && [createdDate compare:createdBeforeDate] != NSOrderedDescending) {
+                [matchingEvents addObject:eventJSON];
+            }
+        }
+        NSRange range = NSMakeRange(MIN(position, matchingEvents.count), 0);
+        range.length = MIN(limit > 0 ? limit : matchingEvents.count, matchingEvents.count - range.location);
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"chunk_size" : @(range.length),
+                                                                            @"next_stream_position" : @(range.location + range.length),
+                                                                            @"entries" : [matchingEvents subarrayWithRange:range]}];
+    }];
+}
+
+@end
@@ -0,0 +1,84 @@
+//
+//  BOXEventsLongPollRequestTests.m
+//  BoxContentSDK
+//
+
+#import "BOXRequestTestCase.h"
+#import "BOXRealtimeServer.h"
+#import "BOXEventsLongPollRequest.h"
+#import "NSURL+BOXURLHelper.h"
+
+@interface BOXEventsLongPollRequestTests : BOXRequestTestCase
+
+@end
+
+@implementation BOXEventsLongPollRequestTests
+
+- (BOXRealtimeServer *)realtimeServer
+{
+    NSData *cannedData = [self cannedResponseDataWithName:@"events_realtime_server"];
+    NSDictionary *JSON = [NSJSONSerialization JSONObjectWithData:cannedData options:kNilOptions error:nil];
+    return [[BOXRealtimeServer alloc] initWithJSON:[JSON[BOXAPICollectionKeyEntries] firstObject]];
+}
+
+- (void)test_url_request_is_correct
+{
+    BOXRealtimeServer *realtimeServer = [self realtimeServer];
+    BOXEventsLongPollRequest *request = [[BOXEventsLongPollRequest alloc] initWithRealtimeServer:realtimeServer streamPosition:@"1415027508361"];
+
+    NSURL *URL = request.urlRequest.URL;
+    NSDictionary *parameters = [URL box_queryDictionary];
+
+    XCTAssertEqualObjects(BOXAPIHTTPMethodGET, request.urlRequest.HTTPMethod);
+    XCTAssertEqualObjects(@"https", URL.scheme);
+    XCTAssertEqualObjects(realtimeServer.URL.host, URL.host);
+    XCTAssertEqualObjects(realtimeServer.URL.path, URL.path);
+    XCTAssertEqualObjects(@"cc807c9c4869ffb1c81a", parameters[@"channel"]);
+    XCTAssertEqualObjects(@"1415027508361", parameters[BOXAPIParameterKeyStreamPosition]);
+    XCTAssertGreaterThan(request.urlRequest.timeoutInterval, realtimeServer.retryTimeout);
+}
+
+- (void)test_url_request_has_no_authorization_header
+{
+    BOXEventsLongPollRequest *request = [[BOXEventsLongPollRequest alloc] initWithRealtimeServer:[self realtimeServer] streamPosition:@"1415027508361"];
+    [self setFakeQueueManagerForRequest:request];
+    [request.operation prepareAPIRequest];
+
+    XCTAssertNil([request.urlRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderAuthorization]);
+}
+
+- (void)test_request_without_url_fails_without_being_sent
+{
+    BOXRealtimeServer *realtimeServer = [[BOXRealtimeServer alloc] initWithJSON:@{@"type" : @"realtime_server",
+                                                                                   @"url" : @"ftp://2.realtime.services.box.net/subscribe"}];
+    BOXEventsLongPollRequest *request = [[BOXEventsLongPollRequest alloc] initWithRealtimeServer:realtimeServer streamPosition:@"1415027508361"];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [request performRequestWithCompletion:^(NSString *message, NSError *error) {
+        XCTAssertNil(message);
+        XCTAssertEqualObjects(NSURLErrorDomain, error.domain);
+        XCTAssertEqual(NSURLErrorAppTransportSecurityRequiresSecureConnection, error.code);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_request_returns_message
+{
+    NSData *cannedData = [self cannedResponseDataWithName:@"events_long_poll_new_change"];
+
+    BOXEventsLongPollRequest *request = [[BOXEventsLongPollRequest alloc] initWithRealtimeServer:[self realtimeServer] streamPosition:@"1415027508361"];
+    [self setCannedURLResponse:[self cannedURLResponseWithStatusCode:200 responseData:cannedData] cannedResponseData:cannedData forRequest:request];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [request performRequestWithCompletion:^(NSString *message, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(BOXAPIEventLongPollMessageNewChange, message);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+@end
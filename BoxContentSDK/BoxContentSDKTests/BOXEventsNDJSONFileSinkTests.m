@@ -0,0 +1,91 @@
+//
+//  BOXEventsNDJSONFileSinkTests.m
+//  BoxContentSDK
+//
+
+#import "BOXModelTestCase.h"
+#import "BOXEvent.h"
+#import "BOXEventsNDJSONFileSink.h"
+
+@interface BOXEventsNDJSONFileSinkTests : BOXModelTestCase
+
+@property (nonatomic, readwrite, strong) NSURL *fileURL;
+
+@end
+
+@implementation BOXEventsNDJSONFileSinkTests
+
+- (void)setUp
+{
+    [super setUp];
+    NSString *fileName = [NSString stringWithFormat:@"%@.ndjson", [[NSUUID UUID] UUIDString]];
+    self.fileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:fileName]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtURL:self.fileURL error:nil];
+    [super tearDown];
+}
+
+- (void)test_events_are_written_one_per_line
+{
+    NSDictionary *dict = [self dictionaryFromCannedJSON:@"events"];
+    NSArray *eventsJSON = dict[BOXAPICollectionKeyEntries];
+
+    BOXEventsNDJSONFileSink *sink = [[BOXEventsNDJSONFileSink alloc] initWithFileURL:self.fileURL];
+    for (NSDictionary *eventJSON in eventsJSON) {
+        XCTAssertTrue([sink writeEvent:[[BOXEvent alloc] initWithJSON:eventJSON] error:nil]);
+    }
+    XCTAssertTrue([sink closeWithError:nil]);
+
+    NSString *contents = [NSString stringWithContentsOfURL:self.fileURL encoding:NSUTF8StringEncoding error:nil];
+    NSArray *lines = [[contents stringByTrimmingCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsSeparatedByString:@"\n"];
+
+    XCTAssertEqual(eventsJSON.count, lines.count);
+    for (NSUInteger i = 0; i < lines.count; i++) {
+        NSDictionary *lineJSON = [NSJSONSerialization JSONObjectWithData:[lines[i] dataUsingEncoding:NSUTF8StringEncoding] options:kNilOptions error:nil];
+        XCTAssertEqualObjects(eventsJSON[i][BOXAPIObjectKeyEventID], lineJSON[BOXAPIObjectKeyEventID]);
+    }
+}
+
+- (void)test_closing_without_events_creates_empty_file
+{
+    BOXEventsNDJSONFileSink *sink = [[BOXEventsNDJSONFileSink alloc] initWithFileURL:self.fileURL];
+    XCTAssertTrue([sink closeWithError:nil]);
+
+    NSData *data = [NSData dataWithContentsOfURL:self.fileURL];
+    XCTAssertNotNil(data);
+    XCTAssertEqual(0, data.length);
+}
+
+- (void)test_closing_again_keeps_the_written_events
+{
+    NSDictionary *dict = [self dictionaryFromCannedJSON:@"events"];
+    NSArray *eventsJSON = dict[BOXAPICollectionKeyEntries];
+
+    BOXEventsNDJSONFileSink *sink = [[BOXEventsNDJSONFileSink alloc] initWithFileURL:self.fileURL];
+    XCTAssertTrue([sink writeEvent:[[BOXEvent alloc] initWithJSON:eventsJSON[0]] error:nil]);
+    XCTAssertTrue([sink closeWithError:nil]);
+    NSData *data = [NSData dataWithContentsOfURL:self.fileURL];
+
+    XCTAssertTrue([sink closeWithError:nil]);
+    XCTAssertTrue(data.length > 0);
+    XCTAssertEqualObjects(data, [NSData dataWithContentsOfURL:self.fileURL]);
+
+    NSError *error = nil;
+    XCTAssertFalse([sink writeEvent:[[BOXEvent alloc] initWithJSON:eventsJSON[0]] error:&error]);
+    XCTAssertNotNil(error);
+}
+
+- (void)test_failed_write_reports_an_error
+{
+    NSURL *fileURL = [[self.fileURL URLByAppendingPathComponent:@"missing_directory"] URLByAppendingPathComponent:@"events.ndjson"];
+    BOXEventsNDJSONFileSink *sink = [[BOXEventsNDJSONFileSink alloc] initWithFileURL:fileURL];
+
+    NSError *error = nil;
+    XCTAssertFalse([sink closeWithError:&error]);
+    XCTAssertNotNil(error);
+}
+
+@end
@@ -0,0 +1,142 @@
+//
+//  BOXEventsRealtimeMonitorTests.m
+//  BoxContentSDK
+//
+
+#import "BOXStandInClientTestCase.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXContentClient+Event.h"
+#import "BOXEventsRealtimeMonitor.h"
+#import "BOXEvent.h"
+#import "BOXContentSDKErrors.h"
+#import "NSURL+BOXURLHelper.h"
+
+@interface BOXEventsRealtimeMonitorTests : BOXStandInClientTestCase
+@end
+
+@implementation BOXEventsRealtimeMonitorTests
+
+- (void)test_that_new_change_delivers_events_past_the_current_stream_position
+{
+    [self addRealtimeServerRouteWithMaxRetries:10 requestBlock:nil];
+
+    __block NSURLRequest *longPollRequest = nil;
+    __block NSUInteger longPollCount = 0;
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"GET" pathPattern:@"^/subscribe$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        @synchronized(self) {
+            longPollCount++;
+            if (longPollCount > 1) {
+                return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"message" : BOXAPIEventLongPollMessageReconnect}];
+            }
+            longPollRequest = request;
+        }
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"message" : BOXAPIEventLongPollMessageNewChange}];
+    }];
+
+    __block NSString *requestedStreamPosition = nil;
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"GET" pathPattern:@"/events$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        NSString *streamPosition = [request.URL box_queryDictionary][BOXAPIParameterKeyStreamPosition];
+        if ([streamPosition isEqualToString:BOXAPIEventStreamPositionNow]) {
+            return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"chunk_size" : @0, @"next_stream_position" : @100, @"entries" : @[]}];
+        }
+        requestedStreamPosition = streamPosition;
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"chunk_size" : @1, @"next_stream_position" : @101, @"entries" : @[[self eventJSON]]}];
+    }];
+
+    BOXEventsRealtimeMonitor *monitor = [self.client eventsRealtimeMonitorWithStreamPosition:nil];
+    __weak BOXEventsRealtimeMonitor *weakMonitor = monitor;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"events"];
+    monitor.eventsBlock = ^(NSArray<BOXEvent *> *events, NSString *nextStreamPosition, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqual(1, events.count);
+        XCTAssertEqualObjects(@"101", nextStreamPosition);
+        [weakMonitor stop];
+        [expectation fulfill];
+    };
+    [monitor start];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqualObjects(@"100", requestedStreamPosition);
+    XCTAssertEqualObjects(@"101", monitor.streamPosition);
+    XCTAssertEqualObjects(@"https", longPollRequest.URL.scheme);
+    XCTAssertNil([longPollRequest valueForHTTPHeaderField:BOXAPIHTTPHeaderAuthorization]);
+}
+
+- (void)test_that_exhausted_realtime_server_is_replaced
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"second realtime server"];
+    __block NSUInteger realtimeServerCount = 0;
+    [self addRealtimeServerRouteWithMaxRetries:2 requestBlock:^{
+        @synchronized(self) {
+            realtimeServerCount++;
+            if (realtimeServerCount == 2) {
+                [expectation fulfill];
+            }
+        }
+    }];
+
+    __block NSUInteger longPollCount = 0;
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"GET" pathPattern:@"^/subscribe$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        @synchronized(self) {
+            longPollCount++;
+        }
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"message" : BOXAPIEventLongPollMessageReconnect}];
+    }];
+
+    BOXEventsRealtimeMonitor *monitor = [self.client eventsRealtimeMonitorWithStreamPosition:@"100"];
+    [monitor start];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    [monitor stop];
+
+    // The first server allows two connections before it is replaced.
+    @synchronized(self) {
+        XCTAssertGreaterThanOrEqual(longPollCount, 2);
+    }
+}
+
+- (void)test_that_forbidden_error_stops_the_monitor
+{
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"OPTIONS" pathPattern:@"/events$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        return [BOXBenchmarkResponse responseWithStatusCode:403 JSONObject:@{@"type" : @"error", @"status" : @403, @"code" : @"forbidden"}];
+    }];
+
+    BOXEventsRealtimeMonitor *monitor = [self.client eventsRealtimeMonitorWithStreamPosition:@"100"];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"error"];
+    monitor.eventsBlock = ^(NSArray<BOXEvent *> *events, NSString *nextStreamPosition, NSError *error) {
+        XCTAssertNil(events);
+        XCTAssertEqual(BOXContentSDKAPIErrorForbidden, error.code);
+        [expectation fulfill];
+    };
+    [monitor start];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertFalse(monitor.isRunning);
+}
+
+#pragma mark - Helpers
+
+- (void)addRealtimeServerRouteWithMaxRetries:(NSInteger)maxRetries requestBlock:(dispatch_block_t)requestBlock
+{
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"OPTIONS" pathPattern:@"/events$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        if (requestBlock) {
+            requestBlock();
+        }
+        NSDictionary *realtimeServer = @{@"type" : @"realtime_server",
+                                         @"url" : @"http://2.realtime.services.box.net/subscribe?channel=cc807c9c4869ffb1c81a&stream_type=all",
+                                         @"ttl" : @"10",
+                                         @"max_retries" : [@(maxRetries) stringValue],
+                                         @"retry_timeout" : @610};
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"chunk_size" : @1, @"entries" : @[realtimeServer]}];
+    }];
+}
+
+- (NSDictionary *)eventJSON
+{
+    return @{@"type" : @"event",
+             @"event_id" : @"59258b2c913b322decec09a5b2932ddb57dfa296",
+             @"event_type" : @"ITEM_UPLOAD",
+             @"source" : @{@"type" : @"file", @"id" : @"22371775721", @"name" : @"Mydoc.doc"}};
+}
+
+@end
@@ -0,0 +1,53 @@
+//
+//  BOXEventsRealtimeServerRequestTests.m
+//  BoxContentSDK
+//
+
+#import "BOXRequestTestCase.h"
+#import "BOXContentClient.h"
+#import "BOXRealtimeServer.h"
+#import "BOXEventsRealtimeServerRequest.h"
+
+@interface BOXEventsRealtimeServerRequestTests : BOXRequestTestCase
+
+@end
+
+@implementation BOXEventsRealtimeServerRequestTests
+
+- (void)test_url_request_is_correct
+{
+    NSURL *url = [NSURL URLWithString:[NSString stringWithFormat:@"%@/%@", [BOXContentClient APIBaseURL], BOXAPIResourceEvents]];
+    BOXEventsRealtimeServerRequest *request = [[BOXEventsRealtimeServerRequest alloc] init];
+
+    XCTAssertEqualObjects(BOXAPIHTTPMethodOPTIONS, request.urlRequest.HTTPMethod);
+    XCTAssertEqualObjects(url, request.urlRequest.URL);
+}
+
+- (void)test_request_returns_realtime_server
+{
+    NSData *cannedData = [self cannedResponseDataWithName:@"events_realtime_server"];
+
+    BOXEventsRealtimeServerRequest *request = [[BOXEventsRealtimeServerRequest alloc] init];
+    [self setCannedURLResponse:[self cannedURLResponseWithStatusCode:200 responseData:cannedData] cannedResponseData:cannedData forRequest:request];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [request performRequestWithCompletion:^(BOXRealtimeServer *realtimeServer, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(@"https://2.realtime.services.box.net/subscribe?channel=cc807c9c4869ffb1c81a&stream_type=all", realtimeServer.URL.absoluteString);
+        XCTAssertEqual(10, realtimeServer.ttl);
+        XCTAssertEqual(10, realtimeServer.maxRetries);
+        XCTAssertEqual(610, realtimeServer.retryTimeout);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_realtime_server_with_insecure_scheme_has_no_url
+{
+    BOXRealtimeServer *realtimeServer = [[BOXRealtimeServer alloc] initWithJSON:@{@"type" : @"realtime_server",
+                                                                                   @"url" : @"ws://2.realtime.services.box.net/subscribe?channel=cc807c9c4869ffb1c81a"}];
+    XCTAssertNil(realtimeServer.URL);
+}
+
+@end
@@ -55,6 +55,48 @@
     XCTAssertEqualObjects(@"GET", URLRequest.HTTPMethod);
 }
 
+- (void)test_that_download_request_with_byte_range_has_range_header
+{
+    BOXFileDownloadRequest *request = [[BOXFileDownloadRequest alloc] initWithLocalDestination:@"/dummy/path" fileID:@"123"];
+    request.byteRangeOffset = 1024;
+    request.byteRangeLength = 2048;
+    NSURLRequest *URLRequest = request.urlRequest;
+
+    XCTAssertEqualObjects(@"bytes=1024-3071", [URLRequest valueForHTTPHeaderField:@"Range"]);
+}
+
+- (void)test_that_download_request_with_byte_range_beyond_4GB_has_range_header
+{
+    BOXFileDownloadRequest *request = [[BOXFileDownloadRequest alloc] initWithLocalDestination:@"/dummy/path" fileID:@"123"];
+    request.byteRangeOffset = 5000000000ull;
+    request.byteRangeLength = 3000000000ull;
+    NSURLRequest *URLRequest = request.urlRequest;
+
+    XCTAssertEqualObjects(@"bytes=5000000000-7999999999", [URLRequest valueForHTTPHeaderField:@"Range"]);
+}
+
+- (void)test_that_copied_operation_keeps_byte_range_and_small_download_flag
+{
+    BOXFileDownloadRequest *request = [[BOXFileDownloadRequest alloc] initWithOutputStream:[NSOutputStream outputStreamToMemory] fileID:@"123"];
+    request.byteRangeOffset = 1024;
+    request.byteRangeLength = 2048;
+    request.isSmallDownload = YES;
+
+    BOXAPIDataOperation *operationCopy = [(BOXAPIDataOperation *)request.operation copy];
+
+    XCTAssertEqualObjects(@"bytes=1024-3071", [operationCopy.APIRequest valueForHTTPHeaderField:@"Range"]);
+    XCTAssertTrue(operationCopy.isSmallDownloadOperation);
+    XCTAssertEqualObjects(@"123", operationCopy.modelID);
+}
+
+- (void)test_that_download_request_without_byte_range_has_no_range_header
+{
+    BOXFileDownloadRequest *request = [[BOXFileDownloadRequest alloc] initWithLocalDestination:@"/dummy/path" fileID:@"123"];
+    NSURLRequest *URLRequest = request.urlRequest;
+
+    XCTAssertNil([URLRequest valueForHTTPHeaderField:@"Range"]);
+}
+
 #pragma mark - Download data
 
 - (void)test_that_download_to_path_request_returns_expected_download_data
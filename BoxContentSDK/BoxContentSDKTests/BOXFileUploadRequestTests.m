@@ -226,6 +226,20 @@
     XCTAssertEqualObjects([BOXHashHelper sha1HashOfData:[uploadData dataUsingEncoding:NSUTF8StringEncoding]], URLRequest.allHTTPHeaderFields[@"Content-MD5"]);
 }
 
+- (void)test_that_small_upload_creates_small_upload_operation
+{
+    NSData *uploadData = [@"hello" dataUsingEncoding:NSUTF8StringEncoding];
+
+    BOXFileUploadRequest *request = [[BOXFileUploadRequest alloc] initWithName:@"tempFile.txt" targetFolderID:@"123" data:uploadData];
+    request.isSmallUpload = YES;
+    BOXAPIMultipartToJSONOperation *operation = (BOXAPIMultipartToJSONOperation *)request.operation;
+    XCTAssertTrue(operation.isSmallUploadOperation);
+
+    BOXFileUploadRequest *largeRequest = [[BOXFileUploadRequest alloc] initWithName:@"tempFile.txt" targetFolderID:@"123" data:uploadData];
+    BOXAPIMultipartToJSONOperation *largeOperation = (BOXAPIMultipartToJSONOperation *)largeRequest.operation;
+    XCTAssertFalse(largeOperation.isSmallUploadOperation);
+}
+
 #pragma mark - Completion and Progress Blocks
 /*
 // NOTE: NSURLProtocol has known limitations which won't call NSURLSessionTaskDelegate's method
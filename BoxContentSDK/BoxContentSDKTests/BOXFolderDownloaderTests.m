@@ -0,0 +1,178 @@
+//
+//  BOXFolderDownloaderTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXAPIEmulator.h"
+#import "BOXAPIEmulatorURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXContentClient+Folder.h"
+#import "BOXFolderDownloader.h"
+#import "BOXContentSDKErrors.h"
+
+@interface BOXFolderDownloaderTests : BOXContentSDKTestCase
+
+@property (nonatomic, readwrite, strong) BOXAPIEmulator *emulator;
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+@property (nonatomic, readwrite, copy) NSString *destinationPath;
+
+@end
+
+@implementation BOXFolderDownloaderTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.emulator = [[BOXAPIEmulator alloc] init];
+    [BOXAPIEmulatorURLProtocol setEmulator:self.emulator];
+
+    self.client = [self clientWithURLProtocolClass:[BOXAPIEmulatorURLProtocol class]
+                                       accessToken:@"emulator_access_token_0"
+                                      refreshToken:@"emulator_refresh_token_0"];
+
+    self.destinationPath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createDirectoryAtPath:self.destinationPath withIntermediateDirectories:YES attributes:nil error:nil];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtPath:self.destinationPath error:nil];
+    [BOXAPIEmulatorURLProtocol setEmulator:nil];
+    self.emulator = nil;
+    self.client = nil;
+
+    [super tearDown];
+}
+
+- (void)test_that_folder_is_downloaded_with_its_subfolders
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Photos" parentID:@"0"];
+    NSString *subfolderID = [self.emulator createFolderWithName:@"2016" parentID:folderID];
+    NSData *rootData = [self dataWithLength:300 seed:1];
+    NSData *nestedData = [self dataWithLength:500 seed:2];
+    [self.emulator createFileWithName:@"cover.jpg" parentID:folderID data:rootData];
+    [self.emulator createFileWithName:@"beach.jpg" parentID:subfolderID data:nestedData];
+
+    BOXFolderDownloader *downloader = [self.client folderDownloaderWithFolderID:folderID destinationPath:self.destinationPath];
+    [self downloadWithDownloader:downloader expectedError:nil filesDownloaded:2 filesSkipped:0];
+
+    XCTAssertEqualObjects(rootData, [NSData dataWithContentsOfFile:[self.destinationPath stringByAppendingPathComponent:@"cover.jpg"]]);
+    XCTAssertEqualObjects(nestedData, [NSData dataWithContentsOfFile:[self.destinationPath stringByAppendingPathComponent:@"2016/beach.jpg"]]);
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:[self.destinationPath stringByAppendingPathComponent:@".boxdownload"]]);
+    XCTAssertEqual(800, downloader.bytesDownloaded);
+}
+
+- (void)test_that_current_local_copies_are_skipped
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Docs" parentID:@"0"];
+    NSData *currentData = [self dataWithLength:200 seed:3];
+    NSData *changedData = [self dataWithLength:200 seed:4];
+    [self.emulator createFileWithName:@"current.txt" parentID:folderID data:currentData];
+    [self.emulator createFileWithName:@"changed.txt" parentID:folderID data:changedData];
+    [currentData writeToFile:[self.destinationPath stringByAppendingPathComponent:@"current.txt"] atomically:YES];
+    [[self dataWithLength:200 seed:5] writeToFile:[self.destinationPath stringByAppendingPathComponent:@"changed.txt"] atomically:YES];
+
+    BOXFolderDownloader *downloader = [self.client folderDownloaderWithFolderID:folderID destinationPath:self.destinationPath];
+    [self downloadWithDownloader:downloader expectedError:nil filesDownloaded:1 filesSkipped:1];
+
+    XCTAssertEqualObjects(changedData, [NSData dataWithContentsOfFile:[self.destinationPath stringByAppendingPathComponent:@"changed.txt"]]);
+    XCTAssertEqual(200, downloader.bytesDownloaded);
+}
+
+- (void)test_that_large_file_is_downloaded_in_parts_and_assembled
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Videos" parentID:@"0"];
+    NSData *data = [self dataWithLength:1000 seed:6];
+    [self.emulator createFileWithName:@"clip.mov" parentID:folderID data:data];
+
+    BOXFolderDownloader *downloader = [self.client folderDownloaderWithFolderID:folderID destinationPath:self.destinationPath];
+    downloader.smallFileThreshold = 16;
+    downloader.multipartThreshold = 16;
+    downloader.partCount = 3;
+    [self downloadWithDownloader:downloader expectedError:nil filesDownloaded:1 filesSkipped:0];
+
+    XCTAssertEqualObjects(data, [NSData dataWithContentsOfFile:[self.destinationPath stringByAppendingPathComponent:@"clip.mov"]]);
+}
+
+- (void)test_that_parts_keep_their_range_when_reenqueued_after_token_refresh
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Videos" parentID:@"0"];
+    NSData *data = [self dataWithLength:1000 seed:7];
+    [self.emulator createFileWithName:@"clip.mov" parentID:folderID data:data];
+    self.emulator.accessToken = @"emulator_access_token_rotated";
+
+    BOXFolderDownloader *downloader = [self.client folderDownloaderWithFolderID:folderID destinationPath:self.destinationPath];
+    downloader.smallFileThreshold = 16;
+    downloader.multipartThreshold = 16;
+    downloader.partCount = 3;
+    [self downloadWithDownloader:downloader expectedError:nil filesDownloaded:1 filesSkipped:0];
+
+    XCTAssertEqualObjects(data, [NSData dataWithContentsOfFile:[self.destinationPath stringByAppendingPathComponent:@"clip.mov"]]);
+    XCTAssertEqual(1000, downloader.bytesDownloaded);
+}
+
+- (void)test_that_partial_download_is_resumed_from_its_staging_file
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Music" parentID:@"0"];
+    NSData *data = [self dataWithLength:600 seed:8];
+    NSString *fileID = [self.emulator createFileWithName:@"song.mp3" parentID:folderID data:data];
+    NSString *SHA1 = [self.emulator JSONForItemWithID:fileID][@"sha1"];
+
+    NSString *stagingPath = [self.destinationPath stringByAppendingPathComponent:@".boxdownload"];
+    [[NSFileManager defaultManager] createDirectoryAtPath:stagingPath withIntermediateDirectories:YES attributes:nil error:nil];
+    NSString *partPath = [stagingPath stringByAppendingPathComponent:[NSString stringWithFormat:@"%@-%@-0-1", fileID, SHA1]];
+    [[data subdataWithRange:NSMakeRange(0, 250)] writeToFile:partPath atomically:YES];
+
+    BOXFolderDownloader *downloader = [self.client folderDownloaderWithFolderID:folderID destinationPath:self.destinationPath];
+    [self downloadWithDownloader:downloader expectedError:nil filesDownloaded:1 filesSkipped:0];
+
+    XCTAssertEqualObjects(data, [NSData dataWithContentsOfFile:[self.destinationPath stringByAppendingPathComponent:@"song.mp3"]]);
+    XCTAssertEqual(350, downloader.bytesDownloaded);
+}
+
+- (void)test_that_cancel_finishes_with_user_cancelled_error
+{
+    NSString *folderID = [self.emulator createFolderWithName:@"Bulk" parentID:@"0"];
+    [self.emulator populateFolderWithID:folderID fileCount:50];
+
+    BOXFolderDownloader *downloader = [self.client folderDownloaderWithFolderID:folderID destinationPath:self.destinationPath];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"download"];
+    [downloader startWithCompletion:^(NSUInteger filesDownloaded, NSUInteger filesSkipped, NSError *error) {
+        XCTAssertEqualObjects(BOXContentSDKErrorDomain, error.domain);
+        XCTAssertEqual(BOXContentSDKAPIUserCancelledError, error.code);
+        [expectation fulfill];
+    }];
+    [downloader cancel];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+#pragma mark - Helpers
+
+- (void)downloadWithDownloader:(BOXFolderDownloader *)downloader
+                 expectedError:(NSError *)expectedError
+               filesDownloaded:(NSUInteger)expectedFilesDownloaded
+                  filesSkipped:(NSUInteger)expectedFilesSkipped
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"download"];
+    [downloader startWithCompletion:^(NSUInteger filesDownloaded, NSUInteger filesSkipped, NSError *error) {
+        XCTAssertEqualObjects(expectedError, error);
+        XCTAssertEqual(expectedFilesDownloaded, filesDownloaded);
+        XCTAssertEqual(expectedFilesSkipped, filesSkipped);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+- (NSData *)dataWithLength:(NSUInteger)length seed:(uint8_t)seed
+{
+    NSMutableData *data = [NSMutableData dataWithLength:length];
+    uint8_t *bytes = data.mutableBytes;
+    for (NSUInteger i = 0; i < length; i++) {
+        bytes[i] = (uint8_t)(i * 31 + seed);
+    }
+    return data;
+}
+
+@end
@@ -215,4 +215,34 @@
 }
 
 
+- (void)mockFirstPageRequestWithCached:(BOXItemArrayCompletionBlock)cacheBlock refreshed:(BOXItemArrayCompletionBlock)refreshBlock
+{
+    NSArray *results = [self itemsFromResponseData:[self cannedResponseDataWithName:@"get_items_0_2"]];
+    if (refreshBlock) {
+        refreshBlock(results, 5, NSMakeRange(0, 3), nil);
+    }
+}
+
+- (void)test_that_no_further_page_is_fetched_past_the_deadline
+{
+    BOXFolderItemsRequest *request = [[BOXFolderItemsRequest alloc] initWithFolderID:@"123"];
+    request.cancellationContext = [[BOXCancellationContext alloc] initWithDeadline:[NSDate dateWithTimeIntervalSinceNow:-1]];
+
+    id requestMock = [OCMockObject partialMockForObject:request];
+
+    [[[[requestMock stub] ignoringNonObjectArgs] andCall:@selector(mockFirstPageRequestWithCached:refreshed:) onObject:self] performPaginatedRequestWithCached:OCMOCK_ANY refreshed:OCMOCK_ANY inRange:NSMakeRange(0, 0)];
+    [[[requestMock stub] andReturnValue:OCMOCK_VALUE(3)] rangeStep];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+
+    [request performRequestWithCompletion:^(NSArray *items, NSError *error) {
+        XCTAssertNil(items);
+        XCTAssertEqualObjects(BOXContentSDKErrorDomain, error.domain);
+        XCTAssertEqual(BOXContentSDKAPIDeadlineExceededError, error.code);
+
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
 @end
@@ -46,6 +46,16 @@
     
 }
 
+- (void)test_that_request_with_fields_to_include_requests_only_those_fields
+{
+    BOXFolderPaginatedItemsRequest *request = [[BOXFolderPaginatedItemsRequest alloc] initWithFolderID:@"123" inRange:NSMakeRange(0,5)];
+    request.fieldsToInclude = @[BOXAPIObjectKeyType, BOXAPIObjectKeyID, BOXAPIObjectKeyName, BOXAPIObjectKeySize];
+    BOXAPIOperation *op = [request createOperation];
+    NSString *fieldString = [op.queryStringParameters objectForKey:BOXAPIParameterKeyFields];
+
+    XCTAssertEqualObjects(@"type,id,name,size", fieldString);
+}
+
 - (void)test_that_basic_request_has_expected_URLRequest
 {
     NSString *folderID = @"123";
@@ -0,0 +1,200 @@
+//
+//  BOXFolderTreeWalkerTests.m
+//  BoxContentSDK
+//
+
+#import "BOXStandInClientTestCase.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXFolderTreeWalker.h"
+#import "BOXItem.h"
+#import "BOXContentSDKErrors.h"
+#import "NSURL+BOXURLHelper.h"
+
+@interface BOXFolderTreeWalkerTests : BOXStandInClientTestCase
+
+// Folder ID -> entries of the folder, served a page at a time.
+@property (nonatomic, readwrite, strong) NSDictionary *folderEntries;
+// Folder ID and offset of every listing received, e.g. "100@2".
+@property (nonatomic, readwrite, strong) NSMutableArray *requestedPages;
+@property (nonatomic, readwrite, strong) NSURL *checkpointFileURL;
+
+@end
+
+@implementation BOXFolderTreeWalkerTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    // 100 holds a subfolder and five files, 200 a subfolder and a file, 300 a file: nine items in all.
+    self.folderEntries = @{@"100" : @[[self folderJSONWithID:@"200"],
+                                      [self fileJSONWithID:@"101"],
+                                      [self fileJSONWithID:@"102"],
+                                      [self fileJSONWithID:@"103"],
+                                      [self fileJSONWithID:@"104"],
+                                      [self fileJSONWithID:@"105"]],
+                           @"200" : @[[self folderJSONWithID:@"300"],
+                                      [self fileJSONWithID:@"201"]],
+                           @"300" : @[[self fileJSONWithID:@"301"]]};
+    self.requestedPages = [NSMutableArray array];
+    self.checkpointFileURL = [NSURL fileURLWithPath:[NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]]];
+}
+
+- (void)tearDown
+{
+    [[NSFileManager defaultManager] removeItemAtURL:self.checkpointFileURL error:nil];
+
+    [super tearDown];
+}
+
+- (void)test_that_walk_delivers_every_item_below_the_root
+{
+    [self addFolderItemsRouteWithErrorResponses:nil];
+
+    BOXFolderTreeWalker *walker = [self walker];
+    NSMutableArray *itemIDs = [NSMutableArray array];
+    walker.itemsBlock = ^(NSArray<BOXItem *> *items, NSString *folderID) {
+        [itemIDs addObjectsFromArray:[items valueForKey:@"modelID"]];
+    };
+    [self walkWithWalker:walker expectedItemCount:9 expectedErrorCode:0];
+
+    NSSet *expectedItemIDs = [NSSet setWithObjects:@"200", @"101", @"102", @"103", @"104", @"105", @"300", @"201", @"301", nil];
+    XCTAssertEqual(9, itemIDs.count);
+    XCTAssertEqualObjects(expectedItemIDs, [NSSet setWithArray:itemIDs]);
+    XCTAssertEqual(9, walker.itemCount);
+}
+
+- (void)test_that_pages_of_a_large_folder_are_queued_from_its_first_page
+{
+    [self addFolderItemsRouteWithErrorResponses:nil];
+
+    BOXFolderTreeWalker *walker = [self walker];
+    [self walkWithWalker:walker expectedItemCount:9 expectedErrorCode:0];
+
+    // Every page is listed once, and the other pages of 100 are not chained one after the other.
+    NSArray *expectedPages = @[@"100@0", @"100@2", @"100@4", @"200@0", @"300@0"];
+    XCTAssertEqualObjects([NSSet setWithArray:expectedPages], [NSSet setWithArray:self.requestedPages]);
+    XCTAssertEqual(expectedPages.count, self.requestedPages.count);
+    XCTAssertEqualObjects(@"100@0", self.requestedPages.firstObject);
+}
+
+- (void)test_that_rate_limited_listing_is_retried
+{
+    [self addFolderItemsRouteWithErrorResponses:@{@"200@0" : @[@429]}];
+
+    BOXFolderTreeWalker *walker = [self walker];
+    [self walkWithWalker:walker expectedItemCount:9 expectedErrorCode:0];
+
+    XCTAssertEqual(2, [self.requestedPages indexesOfObjectsPassingTest:^BOOL(NSString *page, NSUInteger index, BOOL *stop) {
+        return [page isEqualToString:@"200@0"];
+    }].count);
+}
+
+- (void)test_that_missing_folder_fails_the_walk_and_saves_a_checkpoint
+{
+    [self addFolderItemsRouteWithErrorResponses:@{@"100@0" : @[@404]}];
+
+    BOXFolderTreeWalker *walker = [self walker];
+    walker.checkpointFileURL = self.checkpointFileURL;
+    [self walkWithWalker:walker expectedItemCount:0 expectedErrorCode:BOXContentSDKAPIErrorNotFound];
+
+    XCTAssertEqualObjects((@[@"100@0"]), self.requestedPages);
+
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:self.checkpointFileURL.path]);
+}
+
+- (void)test_that_cancelled_walk_resumes_from_its_checkpoint
+{
+    [self addFolderItemsRouteWithErrorResponses:nil];
+
+    BOXFolderTreeWalker *walker = [self walker];
+    walker.checkpointFileURL = self.checkpointFileURL;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"cancelled walk"];
+    [walker startWithCompletion:^(unsigned long long itemCount, NSError *error) {
+        XCTAssertEqualObjects(BOXContentSDKErrorDomain, error.domain);
+        XCTAssertEqual(BOXContentSDKAPIUserCancelledError, error.code);
+        [expectation fulfill];
+    }];
+    [walker cancel];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertTrue([[NSFileManager defaultManager] fileExistsAtPath:self.checkpointFileURL.path]);
+
+    // The page in flight when the walk stopped is listed again, so nothing is missed.
+    BOXFolderTreeWalker *resumedWalker = [self walker];
+    resumedWalker.checkpointFileURL = self.checkpointFileURL;
+    [self walkWithWalker:resumedWalker expectedItemCount:9 expectedErrorCode:0];
+
+    XCTAssertFalse([[NSFileManager defaultManager] fileExistsAtPath:self.checkpointFileURL.path]);
+}
+
+#pragma mark - Helpers
+
+- (BOXFolderTreeWalker *)walker
+{
+    BOXFolderTreeWalker *walker = [[BOXFolderTreeWalker alloc] initWithClient:self.client rootFolderID:@"100"];
+    walker.pageSize = 2;
+    return walker;
+}
+
+- (void)walkWithWalker:(BOXFolderTreeWalker *)walker expectedItemCount:(unsigned long long)expectedItemCount expectedErrorCode:(NSInteger)expectedErrorCode
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"walk"];
+    [walker startWithCompletion:^(unsigned long long itemCount, NSError *error) {
+        if (expectedErrorCode == 0) {
+            XCTAssertNil(error);
+        } else {
+            XCTAssertEqualObjects(BOXContentSDKErrorDomain, error.domain);
+            XCTAssertEqual(expectedErrorCode, error.code);
+        }
+        XCTAssertEqual(expectedItemCount, itemCount);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+// Serves folderEntries a page at a time. errorResponses maps a page, e.g. "200@0", to the status codes its
+// first requests fail with.
+- (void)addFolderItemsRouteWithErrorResponses:(NSDictionary *)errorResponses
+{
+    NSDictionary *folderEntries = self.folderEntries;
+    NSMutableArray *requestedPages = self.requestedPages;
+    NSMutableDictionary *remainingErrorResponses = [NSMutableDictionary dictionary];
+    [errorResponses enumerateKeysAndObjectsUsingBlock:^(NSString *page, NSArray *statusCodes, BOOL *stop) {
+        remainingErrorResponses[page] = [statusCodes mutableCopy];
+    }];
+
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"GET" pathPattern:@"/folders/[^/]+/items$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        NSArray *pathComponents = request.URL.pathComponents;
+        NSString *folderID = pathComponents[pathComponents.count - 2];
+        NSDictionary *parameters = [request.URL box_queryDictionary];
+        NSUInteger offset = (NSUInteger)[parameters[BOXAPIParameterKeyOffset] integerValue];
+        NSUInteger limit = (NSUInteger)[parameters[BOXAPIParameterKeyLimit] integerValue];
+        NSString *page = [NSString stringWithFormat:@"%@@%lu", folderID, (unsigned long)offset];
+
+        NSNumber *errorStatusCode = nil;
+        @synchronized(requestedPages) {
+            [requestedPages addObject:page];
+            NSMutableArray *statusCodes = remainingErrorResponses[page];
+            errorStatusCode = statusCodes.firstObject;
+            if (errorStatusCode) {
+                [statusCodes removeObjectAtIndex:0];
+            }
+        }
+        if (errorStatusCode) {
+            return [BOXBenchmarkResponse responseWithStatusCode:errorStatusCode.integerValue
+                                                     JSONObject:@{@"type" : @"error", @"status" : errorStatusCode}];
+        }
+
+        NSArray *entries = folderEntries[folderID];
+        NSRange range = NSMakeRange(MIN(offset, entries.count), 0);
+        range.length = MIN(limit, entries.count - range.location);
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"total_count" : @(entries.count),
+                                                                            @"entries" : [entries subarrayWithRange:range],
+                                                                            @"offset" : @(offset),
+                                                                            @"limit" : @(limit)}];
+    }];
+}
+
+@end
@@ -0,0 +1,142 @@
+//
+//  BOXItemNameIndexTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXItemNameIndex.h"
+#import "BOXFile.h"
+#import "BOXFolder.h"
+
+@interface BOXItemNameIndexTests : BOXContentSDKTestCase
+
+@property (nonatomic, readwrite, strong) BOXItemNameIndex *index;
+
+@end
+
+@implementation BOXItemNameIndexTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.index = [[BOXItemNameIndex alloc] init];
+    [self.index addItems:@[[self fileWithID:@"1" name:@"Quarterly Report.pdf"],
+                           [self fileWithID:@"2" name:@"Résumé Final.docx"],
+                           [self fileWithID:@"3" name:@"report-archive.zip"],
+                           [self folderWithID:@"4" name:@"Reports"]]];
+}
+
+- (BOXFile *)fileWithID:(NSString *)fileID name:(NSString *)name
+{
+    return [[BOXFile alloc] initWithJSON:@{BOXAPIObjectKeyType : BOXAPIItemTypeFile,
+                                           BOXAPIObjectKeyID : fileID,
+                                           BOXAPIObjectKeyName : name,
+                                           BOXAPIObjectKeyExtension : [name pathExtension]}];
+}
+
+- (BOXFolder *)folderWithID:(NSString *)folderID name:(NSString *)name
+{
+    return [[BOXFolder alloc] initWithJSON:@{BOXAPIObjectKeyType : BOXAPIItemTypeFolder,
+                                             BOXAPIObjectKeyID : folderID,
+                                             BOXAPIObjectKeyName : name}];
+}
+
+- (NSArray *)itemIDsMatchingQuery:(NSString *)query
+{
+    return [[self.index itemsMatchingQuery:query limit:0] valueForKey:@"modelID"];
+}
+
+- (void)test_exact_word_ranks_before_prefix_and_substring
+{
+    NSArray *itemIDs = [self itemIDsMatchingQuery:@"report"];
+
+    XCTAssertEqual(3, itemIDs.count);
+    XCTAssertEqualObjects(@"3", itemIDs[0]);
+    XCTAssertEqualObjects(@"1", itemIDs[1]);
+    XCTAssertEqualObjects(@"4", itemIDs[2]);
+}
+
+- (void)test_short_query_matches_word_prefixes
+{
+    XCTAssertEqualObjects((@[@"2"]), [self itemIDsMatchingQuery:@"fi"]);
+}
+
+- (void)test_query_matches_within_words
+{
+    XCTAssertEqualObjects((@[@"1"]), [self itemIDsMatchingQuery:@"arter"]);
+}
+
+- (void)test_query_is_case_and_diacritic_insensitive
+{
+    XCTAssertEqualObjects((@[@"2"]), [self itemIDsMatchingQuery:@"RESUME"]);
+}
+
+- (void)test_all_query_words_must_match
+{
+    XCTAssertEqualObjects((@[@"1"]), [self itemIDsMatchingQuery:@"quart rep"]);
+    XCTAssertEqual(0, [self itemIDsMatchingQuery:@"quarterly zip"].count);
+}
+
+- (void)test_extension_matches
+{
+    XCTAssertEqualObjects((@[@"1"]), [self itemIDsMatchingQuery:@"pdf"]);
+}
+
+- (void)test_updated_item_replaces_indexed_item
+{
+    [self.index addItems:@[[self fileWithID:@"1" name:@"Budget.xlsx"]]];
+
+    XCTAssertEqual(4, self.index.count);
+    XCTAssertEqual(0, [self itemIDsMatchingQuery:@"quarterly"].count);
+    XCTAssertEqualObjects((@[@"1"]), [self itemIDsMatchingQuery:@"budget"]);
+}
+
+- (void)test_removed_item_is_not_returned
+{
+    [self.index removeItemWithID:@"4" type:BOXAPIItemTypeFolder];
+
+    XCTAssertEqual(3, self.index.count);
+    XCTAssertEqual(0, [self itemIDsMatchingQuery:@"reports"].count);
+}
+
+- (void)test_file_and_folder_with_same_id_are_indexed_separately
+{
+    [self.index addItems:@[[self folderWithID:@"1" name:@"Quarterly Planning"]]];
+
+    XCTAssertEqual(5, self.index.count);
+    NSArray *items = [self.index itemsMatchingQuery:@"quarterly" limit:0];
+    XCTAssertEqual(2, items.count);
+    XCTAssertEqualObjects((@[@"1", @"1"]), [items valueForKey:@"modelID"]);
+    XCTAssertEqualObjects(([NSSet setWithObjects:BOXAPIItemTypeFile, BOXAPIItemTypeFolder, nil]), [NSSet setWithArray:[items valueForKey:@"type"]]);
+
+    [self.index removeItemWithID:@"1" type:BOXAPIItemTypeFolder];
+
+    XCTAssertEqual(4, self.index.count);
+    XCTAssertEqualObjects((@[@"1"]), [self itemIDsMatchingQuery:@"quarterly"]);
+    XCTAssertEqualObjects((@[BOXAPIItemTypeFile]), [[self.index itemsMatchingQuery:@"quarterly" limit:0] valueForKey:@"type"]);
+    XCTAssertEqual(0, [self itemIDsMatchingQuery:@"planning"].count);
+}
+
+- (void)test_merge_keeps_local_item_sharing_an_id_with_a_server_item_of_another_type
+{
+    NSArray *serverItems = @[[self folderWithID:@"3" name:@"Report Drafts"]];
+    NSArray *localItems = @[[self fileWithID:@"3" name:@"report-archive.zip"]];
+
+    NSArray *items = [self.index itemsByMergingServerItems:serverItems localItems:localItems];
+
+    XCTAssertEqualObjects((@[BOXAPIItemTypeFolder, BOXAPIItemTypeFile]), [items valueForKey:@"type"]);
+    XCTAssertEqual(5, self.index.count);
+}
+
+- (void)test_merge_keeps_server_order_and_appends_local_only_items
+{
+    NSArray *serverItems = @[[self fileWithID:@"5" name:@"Report 2015.pdf"], [self fileWithID:@"1" name:@"Quarterly Report.pdf"]];
+    NSArray *localItems = [self.index itemsMatchingQuery:@"report" limit:0];
+
+    NSArray *items = [self.index itemsByMergingServerItems:serverItems localItems:localItems];
+
+    XCTAssertEqualObjects((@[@"5", @"1", @"3", @"4"]), [items valueForKey:@"modelID"]);
+    XCTAssertEqual(5, self.index.count);
+}
+
+@end
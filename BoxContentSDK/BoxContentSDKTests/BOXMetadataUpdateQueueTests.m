@@ -0,0 +1,259 @@
+//
+//  BOXMetadataUpdateQueueTests.m
+//  BoxContentSDK
+//
+
+#import "BOXStandInClientTestCase.h"
+#import "BOXContentClient.h"
+#import "BOXMetadataUpdateQueue.h"
+#import "BOXMetadataUpdateTask.h"
+#import "BOXMetadata.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXContentSDKErrors.h"
+
+@interface BOXMetadataUpdateQueueTests : BOXStandInClientTestCase
+@end
+
+@implementation BOXMetadataUpdateQueueTests
+
+- (void)test_that_tasks_on_the_same_path_are_collapsed_when_state_is_unknown
+{
+    NSArray *tasks = @[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateADD path:@"audience" value:@"internal"],
+                       [[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREPLACE path:@"audience" value:@"external"],
+                       [[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREPLACE path:@"owner" value:@"alice"],
+                       [[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREMOVE path:@"owner" value:nil],
+                       [[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateADD path:@"draft" value:@"yes"],
+                       [[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREMOVE path:@"draft" value:nil]];
+
+    NSArray *coalescedTasks = [BOXMetadataUpdateQueue coalescedUpdateTasks:tasks knownInfo:nil];
+
+    XCTAssertEqual(2, coalescedTasks.count);
+    BOXMetadataUpdateTask *audienceTask = coalescedTasks[0];
+    XCTAssertEqual(BOXMetadataUpdateADD, audienceTask.operation);
+    XCTAssertEqualObjects(@"/audience", audienceTask.path);
+    XCTAssertEqualObjects(@"external", audienceTask.value);
+    BOXMetadataUpdateTask *ownerTask = coalescedTasks[1];
+    XCTAssertEqual(BOXMetadataUpdateREMOVE, ownerTask.operation);
+    XCTAssertEqualObjects(@"/owner", ownerTask.path);
+    XCTAssertNil(ownerTask.value);
+}
+
+- (void)test_that_known_state_guards_collapsed_tasks
+{
+    NSArray *tasks = @[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateADD path:@"audience" value:@"external"],
+                       [[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREPLACE path:@"owner" value:@"bob"],
+                       [[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREMOVE path:@"missing" value:nil]];
+    NSDictionary *knownInfo = @{@"audience" : @"internal"};
+
+    NSArray *coalescedTasks = [BOXMetadataUpdateQueue coalescedUpdateTasks:tasks knownInfo:knownInfo];
+
+    XCTAssertEqual(3, coalescedTasks.count);
+    BOXMetadataUpdateTask *testTask = coalescedTasks[0];
+    XCTAssertEqual(BOXMetadataUpdateTEST, testTask.operation);
+    XCTAssertEqualObjects(@"/audience", testTask.path);
+    XCTAssertEqualObjects(@"internal", testTask.value);
+    BOXMetadataUpdateTask *audienceTask = coalescedTasks[1];
+    XCTAssertEqual(BOXMetadataUpdateREPLACE, audienceTask.operation);
+    XCTAssertEqualObjects(@"external", audienceTask.value);
+    BOXMetadataUpdateTask *ownerTask = coalescedTasks[2];
+    XCTAssertEqual(BOXMetadataUpdateADD, ownerTask.operation);
+    XCTAssertEqualObjects(@"bob", ownerTask.value);
+}
+
+- (void)test_that_escaped_paths_are_looked_up_in_known_state
+{
+    NSArray *tasks = @[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREPLACE path:@"/cost~1center" value:@"42"],
+                       [[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREMOVE path:@"/~01" value:nil]];
+    NSDictionary *knownInfo = @{@"cost/center" : @"7", @"/" : @"slash"};
+
+    NSArray *coalescedTasks = [BOXMetadataUpdateQueue coalescedUpdateTasks:tasks knownInfo:knownInfo];
+
+    // ~01 names the missing key ~1, not the known key /, so removing it is a no-op.
+    XCTAssertEqual(2, coalescedTasks.count);
+    BOXMetadataUpdateTask *testTask = coalescedTasks[0];
+    XCTAssertEqual(BOXMetadataUpdateTEST, testTask.operation);
+    XCTAssertEqualObjects(@"/cost~1center", testTask.path);
+    XCTAssertEqualObjects(@"7", testTask.value);
+    BOXMetadataUpdateTask *costCenterTask = coalescedTasks[1];
+    XCTAssertEqual(BOXMetadataUpdateREPLACE, costCenterTask.operation);
+    XCTAssertEqualObjects(@"42", costCenterTask.value);
+}
+
+- (void)test_that_tasks_cancelling_out_complete_without_a_request
+{
+    // The client mock throws if it is asked for a request.
+    id clientMock = [OCMockObject mockForClass:[BOXContentClient class]];
+    BOXMetadataUpdateQueue *queue = [[BOXMetadataUpdateQueue alloc] initWithClient:clientMock];
+    queue.coalescingInterval = 10.0;
+
+    [queue enqueueUpdateTasks:@[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateADD path:@"draft" value:@"yes"]]
+                       fileID:@"123"
+                        scope:BOXAPITemplateScopeEnterprise
+                     template:@"review"
+                   completion:nil];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [queue enqueueUpdateTasks:@[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREMOVE path:@"draft" value:nil]]
+                       fileID:@"123"
+                        scope:BOXAPITemplateScopeEnterprise
+                     template:@"review"
+                   completion:^(BOXMetadata *metadata, NSError *error) {
+                       XCTAssertNil(metadata);
+                       XCTAssertNil(error);
+                       XCTAssertEqual(0, queue.requestCount);
+                       [expectation fulfill];
+                   }];
+    [queue flush];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_that_empty_tasks_do_not_keep_later_tasks_from_being_sent
+{
+    __block NSUInteger requestCount = 0;
+    BOXMetadataUpdateQueue *queue = [self queueAnsweringUpdatesWithHandler:^BOXBenchmarkResponse *(NSUInteger requestIndex) {
+        requestCount++;
+        return [self metadataResponseWithOwner:@"bob"];
+    }];
+    queue.coalescingInterval = 0.05;
+
+    [queue enqueueUpdateTasks:@[]
+                       fileID:@"123"
+                        scope:BOXAPITemplateScopeEnterprise
+                     template:@"review"
+                   completion:nil];
+    [self waitForInterval:0.2];
+
+    // Sent once its coalescing interval has passed, without a flush.
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [queue enqueueUpdateTasks:@[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREPLACE path:@"owner" value:@"bob"]]
+                       fileID:@"123"
+                        scope:BOXAPITemplateScopeEnterprise
+                     template:@"review"
+                   completion:^(BOXMetadata *metadata, NSError *error) {
+                       XCTAssertNil(error);
+                       XCTAssertEqualObjects(@"bob", metadata.info[@"owner"]);
+                       [expectation fulfill];
+                   }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqual(1, requestCount);
+}
+
+- (void)test_that_server_errors_are_retried
+{
+    __block NSUInteger requestCount = 0;
+    BOXMetadataUpdateQueue *queue = [self queueAnsweringUpdatesWithHandler:^BOXBenchmarkResponse *(NSUInteger requestIndex) {
+        requestCount++;
+        if (requestIndex == 0) {
+            return [BOXBenchmarkResponse responseWithStatusCode:500 JSONObject:@{@"type" : @"error", @"status" : @500}];
+        }
+        return [self metadataResponseWithOwner:@"bob"];
+    }];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completion"];
+    [queue enqueueUpdateTasks:@[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREPLACE path:@"owner" value:@"bob"]]
+                       fileID:@"123"
+                        scope:BOXAPITemplateScopeEnterprise
+                     template:@"review"
+                   completion:^(BOXMetadata *metadata, NSError *error) {
+                       XCTAssertNil(error);
+                       XCTAssertEqualObjects(@"bob", metadata.info[@"owner"]);
+                       [expectation fulfill];
+                   }];
+    [queue flush];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqual(2, requestCount);
+    XCTAssertEqual(2, queue.requestCount);
+}
+
+- (void)test_that_tasks_enqueued_while_a_request_is_in_flight_wait_for_it
+{
+    // The first request is held at the server until the second batch was enqueued and flushed.
+    dispatch_semaphore_t firstRequestSemaphore = dispatch_semaphore_create(0);
+    XCTestExpectation *firstRequestExpectation = [self expectationWithDescription:@"first request"];
+    NSMutableArray *requestLog = [NSMutableArray array];
+    BOXMetadataUpdateQueue *queue = [self queueAnsweringUpdatesWithHandler:^BOXBenchmarkResponse *(NSUInteger requestIndex) {
+        @synchronized(requestLog) {
+            [requestLog addObject:[NSString stringWithFormat:@"start %lu", (unsigned long)requestIndex]];
+        }
+        if (requestIndex == 0) {
+            [firstRequestExpectation fulfill];
+            dispatch_semaphore_wait(firstRequestSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5.0 * NSEC_PER_SEC)));
+        }
+        @synchronized(requestLog) {
+            [requestLog addObject:[NSString stringWithFormat:@"end %lu", (unsigned long)requestIndex]];
+        }
+        return [self metadataResponseWithOwner:(requestIndex == 0 ? @"bob" : @"carol")];
+    }];
+
+    NSMutableArray *completedOwners = [NSMutableArray array];
+    [queue enqueueUpdateTasks:@[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREPLACE path:@"owner" value:@"bob"]]
+                       fileID:@"123"
+                        scope:BOXAPITemplateScopeEnterprise
+                     template:@"review"
+                   completion:^(BOXMetadata *metadata, NSError *error) {
+                       XCTAssertNil(error);
+                       [completedOwners addObject:metadata.info[@"owner"]];
+                   }];
+    [queue flush];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTestExpectation *secondExpectation = [self expectationWithDescription:@"second completion"];
+    [queue enqueueUpdateTasks:@[[[BOXMetadataUpdateTask alloc] initWithOperation:BOXMetadataUpdateREPLACE path:@"owner" value:@"carol"]]
+                       fileID:@"123"
+                        scope:BOXAPITemplateScopeEnterprise
+                     template:@"review"
+                   completion:^(BOXMetadata *metadata, NSError *error) {
+                       XCTAssertNil(error);
+                       [completedOwners addObject:metadata.info[@"owner"]];
+                       [secondExpectation fulfill];
+                   }];
+    [queue flush];
+    [self waitForInterval:0.2];
+    dispatch_semaphore_signal(firstRequestSemaphore);
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqualObjects((@[@"start 0", @"end 0", @"start 1", @"end 1"]), requestLog);
+    XCTAssertEqualObjects((@[@"bob", @"carol"]), completedOwners);
+    XCTAssertEqual(2, queue.requestCount);
+}
+
+#pragma mark - Helpers
+
+// Returns a queue whose client sends metadata updates to handler, which is called with the index of each request.
+- (BOXMetadataUpdateQueue *)queueAnsweringUpdatesWithHandler:(BOXBenchmarkResponse *(^)(NSUInteger requestIndex))handler
+{
+    BOXContentClient *client = self.client;
+
+    __block NSUInteger requestIndex = 0;
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"PUT" pathPattern:@"/files/123/metadata/[^/]+/review$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        NSUInteger index;
+        @synchronized(client) {
+            index = requestIndex++;
+        }
+        return handler(index);
+    }];
+
+    BOXMetadataUpdateQueue *queue = [[BOXMetadataUpdateQueue alloc] initWithClient:client];
+    queue.coalescingInterval = 10.0;
+    return queue;
+}
+
+- (BOXBenchmarkResponse *)metadataResponseWithOwner:(NSString *)owner
+{
+    return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{BOXAPIMetadataObjectKeyScope : BOXAPITemplateScopeEnterprise,
+                                                                         BOXAPIMetadataObjectKeyTemplate : @"review",
+                                                                         BOXAPIMetadataObjectKeyParent : @"file_123",
+                                                                         @"owner" : owner}];
+}
+
+// Lets the queue and the main thread run meanwhile, without waiting for the expectations not yet fulfilled.
+- (void)waitForInterval:(NSTimeInterval)interval
+{
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:interval]];
+}
+
+@end
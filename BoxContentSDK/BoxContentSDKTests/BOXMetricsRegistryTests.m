@@ -0,0 +1,193 @@
+//
+//  BOXMetricsRegistryTests.m
+//  BoxContentSDK
+//
+
+#import "BOXRequestTestCase.h"
+#import "BOXMetricsRegistry.h"
+#import "BOXFolderRequest.h"
+#import "BOXFolder.h"
+#import "BOXRequest_Private.h"
+#import "BOXAPIOperation_Private.h"
+
+@interface BOXMetricsRegistryTests : BOXRequestTestCase
+@end
+
+@implementation BOXMetricsRegistryTests
+
+- (void)setUp
+{
+    [super setUp];
+    [[BOXMetricsRegistry sharedRegistry] reset];
+}
+
+- (void)test_histogram_percentiles_are_within_bucket_precision
+{
+    BOXLatencyHistogram *histogram = [[BOXLatencyHistogram alloc] init];
+    for (NSUInteger milliseconds = 1; milliseconds <= 1000; milliseconds++) {
+        [histogram recordLatency:milliseconds / 1000.0];
+    }
+
+    XCTAssertEqual(1000, histogram.count);
+    XCTAssertEqualWithAccuracy(0.001, histogram.minLatency, 0.000001);
+    XCTAssertEqualWithAccuracy(1.0, histogram.maxLatency, 0.000001);
+    XCTAssertEqualWithAccuracy(0.5005, histogram.meanLatency, 0.0001);
+    XCTAssertEqualWithAccuracy(0.5, [histogram latencyAtPercentile:50], 0.5 * 0.07);
+    XCTAssertEqualWithAccuracy(0.99, [histogram latencyAtPercentile:99], 0.99 * 0.07);
+    XCTAssertEqualWithAccuracy(1.0, [histogram latencyAtPercentile:100], 0.000001);
+}
+
+- (void)test_resource_family_is_first_path_component_after_version
+{
+    XCTAssertEqualObjects(@"folders", [BOXMetricsRegistry resourceFamilyForURL:[NSURL URLWithString:@"https://api.box.com/2.0/folders/0/items"]]);
+    XCTAssertEqualObjects(@"files", [BOXMetricsRegistry resourceFamilyForURL:[NSURL URLWithString:@"https://upload.box.com/api/2.0/files/content"]]);
+    XCTAssertEqualObjects(@"oauth2", [BOXMetricsRegistry resourceFamilyForURL:[NSURL URLWithString:@"https://api.box.com/oauth2/token"]]);
+    XCTAssertEqualObjects(@"unknown", [BOXMetricsRegistry resourceFamilyForURL:nil]);
+}
+
+- (void)test_requests_and_cache_lookups_are_counted
+{
+    BOXMetricsRegistry *registry = [[BOXMetricsRegistry alloc] init];
+    [registry recordRequestInFamily:@"files" statusCode:200 failed:NO latency:0.1 bytesSent:10 bytesReceived:1000 retried:NO];
+    [registry recordRequestInFamily:@"files" statusCode:404 failed:YES latency:0.2 bytesSent:10 bytesReceived:100 retried:NO];
+    [registry recordRequestInFamily:@"files" statusCode:0 failed:YES latency:0.3 bytesSent:0 bytesReceived:0 retried:YES];
+    [registry recordCacheLookupInLayer:@"app" hit:YES];
+    [registry recordCacheLookupInLayer:@"app" hit:YES];
+    [registry recordCacheLookupInLayer:@"app" hit:NO];
+
+    BOXMetricsSnapshot *snapshot = [registry snapshot];
+    BOXRequestFamilyMetrics *fileMetrics = snapshot.requestMetricsByFamily[@"files"];
+    XCTAssertEqual(3, fileMetrics.requestCount);
+    XCTAssertEqual(2, fileMetrics.errorCount);
+    XCTAssertEqualObjects((@{@404 : @1, @0 : @1}), fileMetrics.errorCountsByStatusCode);
+    XCTAssertEqual(1, fileMetrics.retryCount);
+    XCTAssertEqual(20, snapshot.bytesSent);
+    XCTAssertEqual(1100, snapshot.bytesReceived);
+    XCTAssertEqual(3, fileMetrics.latencyHistogram.count);
+    XCTAssertEqualWithAccuracy(2.0 / 3.0, [snapshot.cacheMetricsByLayer[@"app"] hitRatio], 0.0001);
+
+    // Snapshots do not change once taken.
+    [registry recordRequestInFamily:@"files" statusCode:200 failed:NO latency:0.1 bytesSent:0 bytesReceived:0 retried:NO];
+    XCTAssertEqual(3, fileMetrics.requestCount);
+    XCTAssertEqual(3, fileMetrics.latencyHistogram.count);
+}
+
+- (void)test_compression_ratios_compare_body_bytes_to_transferred_bytes
+{
+    BOXMetricsRegistry *registry = [[BOXMetricsRegistry alloc] init];
+    [registry recordRequestInFamily:@"folders" statusCode:200 failed:NO latency:0.1 bytesSent:0 uncompressedBytesSent:0 bytesReceived:1300 responseBodyBytesReceived:1000 decodedResponseBodyBytes:8000 retried:NO];
+    [registry recordRequestInFamily:@"folders" statusCode:200 failed:NO latency:0.1 bytesSent:500 uncompressedBytesSent:1500 bytesReceived:1300 responseBodyBytesReceived:1000 decodedResponseBodyBytes:2000 retried:NO];
+    [registry recordRequestInFamily:@"files" statusCode:200 failed:NO latency:0.1 bytesSent:10 bytesReceived:100 retried:NO];
+
+    BOXMetricsSnapshot *snapshot = [registry snapshot];
+    BOXRequestFamilyMetrics *folderMetrics = snapshot.requestMetricsByFamily[@"folders"];
+    XCTAssertEqualWithAccuracy(3.0, folderMetrics.requestCompressionRatio, 0.0001);
+    XCTAssertEqualWithAccuracy(5.0, folderMetrics.responseCompressionRatio, 0.0001);
+    XCTAssertEqual(2000, snapshot.responseBodyBytesReceived);
+    XCTAssertEqual(10000, snapshot.decodedResponseBodyBytes);
+    XCTAssertEqual(1510, snapshot.uncompressedBytesSent);
+}
+
+- (void)test_response_compression_ratio_is_unreported_without_body_byte_counts
+{
+    BOXMetricsRegistry *registry = [[BOXMetricsRegistry alloc] init];
+    [registry recordRequestInFamily:@"files" statusCode:200 failed:NO latency:0.1 bytesSent:10 bytesReceived:100 retried:NO];
+    [registry recordRequestInFamily:@"files" statusCode:200 failed:NO latency:0.1 bytesSent:10 uncompressedBytesSent:10 bytesReceived:100 responseBodyBytesReceived:0 decodedResponseBodyBytes:0 retried:NO];
+
+    BOXRequestFamilyMetrics *fileMetrics = [registry snapshot].requestMetricsByFamily[@"files"];
+    XCTAssertEqual(200, fileMetrics.bytesReceived);
+    XCTAssertEqual(0, fileMetrics.responseBodyBytesReceived);
+    XCTAssertEqualWithAccuracy(0.0, fileMetrics.responseCompressionRatio, 0.0001);
+    XCTAssertEqualWithAccuracy(1.0, fileMetrics.requestCompressionRatio, 0.0001);
+}
+
+- (void)test_queue_gauges_count_waiting_and_executing_operations
+{
+    BOXMetricsRegistry *registry = [[BOXMetricsRegistry alloc] init];
+    BOXQueueGauge *gauge = [registry gaugeForQueueNamed:@"test queue"];
+    XCTAssertEqual(gauge, [registry gaugeForQueueNamed:@"test queue"]);
+
+    [gauge operationEnqueued];
+    [gauge operationEnqueued];
+    [gauge operationEnqueued];
+    [gauge operationStarted];
+
+    BOXQueueMetrics *queueMetrics = [registry snapshot].queueMetricsByName[@"test queue"];
+    XCTAssertEqual(1, queueMetrics.inFlightCount);
+    XCTAssertEqual(2, queueMetrics.depth);
+
+    // One finishes, and one is cancelled before it starts.
+    [gauge operationFinishedAfterStarting:YES];
+    [gauge operationFinishedAfterStarting:NO];
+    [registry reset];
+
+    queueMetrics = [registry snapshot].queueMetricsByName[@"test queue"];
+    XCTAssertEqual(0, queueMetrics.inFlightCount);
+    XCTAssertEqual(1, queueMetrics.depth);
+}
+
+- (void)test_requests_recorded_concurrently_are_all_counted
+{
+    BOXMetricsRegistry *registry = [[BOXMetricsRegistry alloc] init];
+    dispatch_apply(1000, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t index) {
+        NSString *family = (index % 2 == 0) ? @"files" : @"folders";
+        [registry recordRequestInFamily:family statusCode:(index % 10 == 0 ? 500 : 200) failed:(index % 10 == 0) latency:(index + 1) / 1000.0 bytesSent:1 bytesReceived:2 retried:NO];
+    });
+
+    BOXMetricsSnapshot *snapshot = [registry snapshot];
+    XCTAssertEqual(1000, snapshot.requestCount);
+    XCTAssertEqual(100, snapshot.errorCount);
+    XCTAssertEqual(1000, snapshot.bytesSent);
+    XCTAssertEqual(2000, snapshot.bytesReceived);
+    BOXRequestFamilyMetrics *fileMetrics = snapshot.requestMetricsByFamily[@"files"];
+    XCTAssertEqual(500, fileMetrics.latencyHistogram.count);
+    XCTAssertEqualObjects(@{@500 : @100}, fileMetrics.errorCountsByStatusCode);
+    XCTAssertEqualWithAccuracy(0.001, fileMetrics.latencyHistogram.minLatency, 0.000001);
+    XCTAssertEqualWithAccuracy(0.999, fileMetrics.latencyHistogram.maxLatency, 0.000001);
+}
+
+- (void)test_operations_update_the_gauge_of_their_queue
+{
+    BOXQueueGauge *gauge = [[BOXMetricsRegistry sharedRegistry] gaugeForQueueNamed:@"BOXParallelAPIQueueManager global queue"];
+    BOXQueueMetrics *metricsBefore = [[BOXMetricsRegistry sharedRegistry] snapshot].queueMetricsByName[gauge.name];
+
+    BOXFolderRequest *folderRequest = [[BOXFolderRequest alloc] initWithFolderID:@"12345"];
+    NSData *cannedResponseData = [self cannedResponseDataWithName:@"folder_all_fields"];
+    NSHTTPURLResponse *URLResponse = [self cannedURLResponseWithStatusCode:200 responseData:cannedResponseData];
+    [self setCannedURLResponse:URLResponse cannedResponseData:cannedResponseData forRequest:folderRequest];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [folderRequest performRequestWithCompletion:^(BOXFolder *folder, NSError *error) {
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+    // The completion is called right before the operation finishes.
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+
+    BOXQueueMetrics *metricsAfter = [[BOXMetricsRegistry sharedRegistry] snapshot].queueMetricsByName[gauge.name];
+    XCTAssertEqual(gauge, folderRequest.operation.queueGauge);
+    XCTAssertEqual(metricsBefore.depth, metricsAfter.depth);
+    XCTAssertEqual(metricsBefore.inFlightCount, metricsAfter.inFlightCount);
+}
+
+- (void)test_finished_request_is_recorded_under_its_family
+{
+    BOXFolderRequest *folderRequest = [[BOXFolderRequest alloc] initWithFolderID:@"12345"];
+    NSData *cannedResponseData = [self cannedResponseDataWithName:@"folder_all_fields"];
+    NSHTTPURLResponse *URLResponse = [self cannedURLResponseWithStatusCode:200 responseData:cannedResponseData];
+    [self setCannedURLResponse:URLResponse cannedResponseData:cannedResponseData forRequest:folderRequest];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [folderRequest performRequestWithCompletion:^(BOXFolder *folder, NSError *error) {
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    BOXRequestFamilyMetrics *folderMetrics = [[BOXMetricsRegistry sharedRegistry] snapshot].requestMetricsByFamily[@"folders"];
+    XCTAssertEqual(1, folderMetrics.requestCount);
+    XCTAssertEqual(0, folderMetrics.errorCount);
+    XCTAssertEqual(1, folderMetrics.latencyHistogram.count);
+}
+
+@end
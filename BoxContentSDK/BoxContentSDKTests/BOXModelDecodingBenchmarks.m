@@ -0,0 +1,253 @@
+//
+//  BOXModelDecodingBenchmarks.m
+//  BoxContentSDK
+//
+
+#import "BOXBenchmarkTestCase.h"
+#import "BOXModelFixtureGenerator.h"
+#import "BOXRequest_Private.h"
+#import "BOXFolderItemsRequest.h"
+#import "BOXItem.h"
+#import "BOXFile.h"
+#import "BOXFolder.h"
+#import "BOXEvent.h"
+#import "NSDate+BOXContentSDKAdditions.h"
+
+#import <malloc/malloc.h>
+
+#define BOX_DECODING_BENCHMARK_ITERATIONS (5)
+#define BOX_DECODING_BENCHMARK_LARGE_PAGE_COUNT (10000)
+#define BOX_DECODING_BENCHMARK_SMALL_PAGE_COUNT (1000)
+#define BOX_DECODING_BENCHMARK_DEEP_PATH_DEPTH (25)
+#define BOX_DECODING_BENCHMARK_METADATA_INSTANCE_COUNT (12)
+#define BOX_DECODING_BENCHMARK_METADATA_FIELD_COUNT (24)
+
+static NSString *const BOXDecodingBenchmarkMetricBytesPerItem = @"bytes_per_item";
+static NSString *const BOXDecodingBenchmarkMetricEncodedBytesPerItem = @"encoded_bytes_per_item";
+
+// Returns what it decoded, which is kept alive until the heap growth it caused has been measured.
+typedef id (^BOXDecodingBlock)(void);
+
+@interface BOXFolderItemsRequest ()
++ (NSArray *)dedupeItemsByBoxID:(NSArray *)items;
+@end
+
+@interface BOXModelDecodingBenchmarks : BOXBenchmarkTestCase
+@end
+
+@implementation BOXModelDecodingBenchmarks
+
+#pragma mark - JSON parsing
+
+// Throughput is in entries per second.
+- (void)test_json_parse_of_1k_folder_page
+{
+    NSData *data = [self folderPageDataWithCount:BOX_DECODING_BENCHMARK_SMALL_PAGE_COUNT pathDepth:3 metadataInstanceCount:0];
+    [self runDecodingBenchmarkNamed:@"json_parse_folder_page_1k" itemCount:BOX_DECODING_BENCHMARK_SMALL_PAGE_COUNT encodedData:data block:^id{
+        return [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    }];
+}
+
+- (void)test_json_parse_of_10k_folder_page
+{
+    NSData *data = [self folderPageDataWithCount:BOX_DECODING_BENCHMARK_LARGE_PAGE_COUNT pathDepth:3 metadataInstanceCount:0];
+    [self runDecodingBenchmarkNamed:@"json_parse_folder_page_10k" itemCount:BOX_DECODING_BENCHMARK_LARGE_PAGE_COUNT encodedData:data block:^id{
+        return [NSJSONSerialization JSONObjectWithData:data options:0 error:nil];
+    }];
+}
+
+#pragma mark - Model decoding
+
+// Throughput is in items per second.
+- (void)test_item_decoding_of_10k_folder_page
+{
+    NSData *data = [self folderPageDataWithCount:BOX_DECODING_BENCHMARK_LARGE_PAGE_COUNT pathDepth:3 metadataInstanceCount:0];
+    NSArray *entries = [self entriesOfData:data];
+    [self runDecodingBenchmarkNamed:@"item_decoding_folder_page_10k" itemCount:entries.count encodedData:data block:^id{
+        NSMutableArray *items = [NSMutableArray arrayWithCapacity:entries.count];
+        for (NSDictionary *entry in entries) {
+            [items addObject:[BOXRequest itemWithJSON:entry]];
+        }
+        return items;
+    }];
+}
+
+- (void)test_file_decoding_with_deep_path_collections
+{
+    NSMutableArray *entries = [NSMutableArray array];
+    if ([[self class] benchmarksEnabled]) {
+        for (NSUInteger i = 0; i < BOX_DECODING_BENCHMARK_SMALL_PAGE_COUNT; i++) {
+            [entries addObject:[BOXModelFixtureGenerator fileJSONWithIndex:i pathDepth:BOX_DECODING_BENCHMARK_DEEP_PATH_DEPTH metadataInstanceCount:0 metadataFieldCount:0]];
+        }
+    }
+    NSData *data = [BOXModelFixtureGenerator dataWithJSONObject:entries];
+    [self runDecodingBenchmarkNamed:@"file_decoding_deep_paths" itemCount:entries.count encodedData:data block:^id{
+        NSMutableArray *files = [NSMutableArray arrayWithCapacity:entries.count];
+        for (NSDictionary *entry in entries) {
+            [files addObject:[[BOXFile alloc] initWithJSON:entry]];
+        }
+        return files;
+    }];
+}
+
+- (void)test_file_decoding_with_heavy_metadata
+{
+    NSMutableArray *entries = [NSMutableArray array];
+    if ([[self class] benchmarksEnabled]) {
+        for (NSUInteger i = 0; i < BOX_DECODING_BENCHMARK_SMALL_PAGE_COUNT; i++) {
+            [entries addObject:[BOXModelFixtureGenerator fileJSONWithIndex:i
+                                                                 pathDepth:3
+                                                     metadataInstanceCount:BOX_DECODING_BENCHMARK_METADATA_INSTANCE_COUNT
+                                                        metadataFieldCount:BOX_DECODING_BENCHMARK_METADATA_FIELD_COUNT]];
+        }
+    }
+    NSData *data = [BOXModelFixtureGenerator dataWithJSONObject:entries];
+    [self runDecodingBenchmarkNamed:@"file_decoding_heavy_metadata" itemCount:entries.count encodedData:data block:^id{
+        NSMutableArray *files = [NSMutableArray arrayWithCapacity:entries.count];
+        for (NSDictionary *entry in entries) {
+            [files addObject:[[BOXFile alloc] initWithJSON:entry]];
+        }
+        return files;
+    }];
+}
+
+- (void)test_folder_decoding
+{
+    NSMutableArray *entries = [NSMutableArray array];
+    if ([[self class] benchmarksEnabled]) {
+        for (NSUInteger i = 0; i < BOX_DECODING_BENCHMARK_SMALL_PAGE_COUNT; i++) {
+            [entries addObject:[BOXModelFixtureGenerator folderJSONWithIndex:i pathDepth:6]];
+        }
+    }
+    NSData *data = [BOXModelFixtureGenerator dataWithJSONObject:entries];
+    [self runDecodingBenchmarkNamed:@"folder_decoding" itemCount:entries.count encodedData:data block:^id{
+        NSMutableArray *folders = [NSMutableArray arrayWithCapacity:entries.count];
+        for (NSDictionary *entry in entries) {
+            [folders addObject:[[BOXFolder alloc] initWithJSON:entry]];
+        }
+        return folders;
+    }];
+}
+
+// Throughput is in events per second.
+- (void)test_event_decoding_with_mixed_sources
+{
+    NSDictionary *page = [[self class] benchmarksEnabled] ? [BOXModelFixtureGenerator eventsPageJSONWithCount:BOX_DECODING_BENCHMARK_SMALL_PAGE_COUNT pathDepth:4] : nil;
+    NSData *data = [BOXModelFixtureGenerator dataWithJSONObject:page ?: @{}];
+    NSArray *entries = page[@"entries"];
+    [self runDecodingBenchmarkNamed:@"event_decoding_mixed_sources" itemCount:entries.count encodedData:data block:^id{
+        NSMutableArray *events = [NSMutableArray arrayWithCapacity:entries.count];
+        for (NSDictionary *entry in entries) {
+            [events addObject:[[BOXEvent alloc] initWithJSON:entry]];
+        }
+        return events;
+    }];
+}
+
+#pragma mark - Item processing
+
+// A page listed twice, as when pages overlap after concurrent changes. Throughput is in items per second.
+- (void)test_dedupe_of_10k_items
+{
+    NSData *data = [self folderPageDataWithCount:BOX_DECODING_BENCHMARK_LARGE_PAGE_COUNT pathDepth:3 metadataInstanceCount:0];
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSDictionary *entry in [self entriesOfData:data]) {
+        [items addObject:[BOXRequest itemWithJSON:entry]];
+    }
+    [items addObjectsFromArray:[items subarrayWithRange:NSMakeRange(0, items.count / 10)]];
+    [self runDecodingBenchmarkNamed:@"dedupe_items_10k" itemCount:items.count encodedData:nil block:^id{
+        return [BOXFolderItemsRequest dedupeItemsByBoxID:items];
+    }];
+}
+
+// Throughput is in timestamps per second.
+- (void)test_date_parsing
+{
+    NSArray *timestamps = [[self class] benchmarksEnabled] ? [BOXModelFixtureGenerator ISO8601StringsWithCount:BOX_DECODING_BENCHMARK_LARGE_PAGE_COUNT] : @[];
+    [self runDecodingBenchmarkNamed:@"date_parsing" itemCount:timestamps.count encodedData:nil block:^id{
+        NSMutableArray *dates = [NSMutableArray arrayWithCapacity:timestamps.count];
+        for (NSString *timestamp in timestamps) {
+            [dates addObject:[NSDate box_dateWithISO8601String:timestamp]];
+        }
+        return dates;
+    }];
+}
+
+// Models are persisted as their JSON, so a round trip archives it and decodes models from the unarchived
+// copy. Throughput is in items per second.
+- (void)test_archive_round_trip_of_1k_items
+{
+    NSData *data = [self folderPageDataWithCount:BOX_DECODING_BENCHMARK_SMALL_PAGE_COUNT pathDepth:3 metadataInstanceCount:2];
+    NSArray *entries = [self entriesOfData:data];
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSDictionary *entry in entries) {
+        [items addObject:[BOXRequest itemWithJSON:entry]];
+    }
+    [self runDecodingBenchmarkNamed:@"archive_round_trip_1k" itemCount:items.count encodedData:nil block:^id{
+        NSMutableArray *JSONObjects = [NSMutableArray arrayWithCapacity:items.count];
+        for (BOXItem *item in items) {
+            [JSONObjects addObject:item.JSONData];
+        }
+        NSData *archive = [NSKeyedArchiver archivedDataWithRootObject:JSONObjects];
+        NSMutableArray *decodedItems = [NSMutableArray arrayWithCapacity:items.count];
+        for (NSDictionary *JSONObject in [NSKeyedUnarchiver unarchiveObjectWithData:archive]) {
+            [decodedItems addObject:[BOXRequest itemWithJSON:JSONObject]];
+        }
+        return decodedItems;
+    }];
+}
+
+#pragma mark - Helpers
+
+- (NSData *)folderPageDataWithCount:(NSUInteger)count pathDepth:(NSUInteger)pathDepth metadataInstanceCount:(NSUInteger)metadataInstanceCount
+{
+    // Large fixtures are only generated for benchmarks that run.
+    if (![[self class] benchmarksEnabled]) {
+        return [NSData data];
+    }
+    NSDictionary *page = [BOXModelFixtureGenerator folderItemsPageJSONWithCount:count pathDepth:pathDepth metadataInstanceCount:metadataInstanceCount];
+    return [BOXModelFixtureGenerator dataWithJSONObject:page];
+}
+
+- (NSArray *)entriesOfData:(NSData *)data
+{
+    if (data.length == 0) {
+        return @[];
+    }
+    return [NSJSONSerialization JSONObjectWithData:data options:0 error:nil][@"entries"];
+}
+
+// Runs block several times. Besides the metrics of every benchmark, records the heap growth per item of what
+// one run decoded and, when encodedData is given, its size per item.
+- (void)runDecodingBenchmarkNamed:(NSString *)name
+                        itemCount:(NSUInteger)itemCount
+                      encodedData:(NSData *)encodedData
+                            block:(BOXDecodingBlock)block
+{
+    [self runBenchmarkNamed:name timeout:600.0 block:^(BOXBenchmarkRecorder *recorder, dispatch_block_t done) {
+        for (NSUInteger i = 0; i < BOX_DECODING_BENCHMARK_ITERATIONS; i++) {
+            @autoreleasepool {
+                malloc_statistics_t statistics;
+                malloc_zone_statistics(NULL, &statistics);
+                size_t sizeInUse = statistics.size_in_use;
+
+                NSDate *startDate = [NSDate date];
+                __attribute__((objc_precise_lifetime)) id result = block();
+                [recorder recordLatency:-[startDate timeIntervalSinceNow]];
+                [recorder addProcessedUnits:itemCount];
+
+                if (i == 0 && itemCount > 0) {
+                    malloc_zone_statistics(NULL, &statistics);
+                    double heapGrowth = (double)statistics.size_in_use - (double)sizeInUse;
+                    [recorder setValue:MAX(heapGrowth, 0) / itemCount forMetric:BOXDecodingBenchmarkMetricBytesPerItem];
+                    if (encodedData != nil) {
+                        [recorder setValue:(double)encodedData.length / itemCount forMetric:BOXDecodingBenchmarkMetricEncodedBytesPerItem];
+                    }
+                }
+            }
+        }
+        done();
+    }];
+}
+
+@end
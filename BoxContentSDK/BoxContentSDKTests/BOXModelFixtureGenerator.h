@@ -0,0 +1,38 @@
+//
+//  BOXModelFixtureGenerator.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+// Synthesizes large API payloads with every field the models parse, for benchmarks of the model layer. The
+// checked-in fixtures are single small objects; these are pages of thousands of entries, items nested deep in
+// their folder tree, and items carrying many metadata instances.
+//
+// Output depends only on the arguments, so that benchmark runs decode the same bytes.
+@interface BOXModelFixtureGenerator : NSObject
+
+// An item whose path collection has pathDepth ancestors, with metadataInstanceCount metadata instances of
+// metadataFieldCount fields each.
++ (NSDictionary *)fileJSONWithIndex:(NSUInteger)index
+                          pathDepth:(NSUInteger)pathDepth
+              metadataInstanceCount:(NSUInteger)metadataInstanceCount
+                 metadataFieldCount:(NSUInteger)metadataFieldCount;
++ (NSDictionary *)folderJSONWithIndex:(NSUInteger)index pathDepth:(NSUInteger)pathDepth;
++ (NSDictionary *)webLinkJSONWithIndex:(NSUInteger)index pathDepth:(NSUInteger)pathDepth;
+
+// A page of folder items, mostly files with some folders and web links, as returned by the folder items
+// endpoint.
++ (NSDictionary *)folderItemsPageJSONWithCount:(NSUInteger)count
+                                     pathDepth:(NSUInteger)pathDepth
+                         metadataInstanceCount:(NSUInteger)metadataInstanceCount;
+
+// A page of events whose sources are files, folders, web links, comments, collaborations and users.
++ (NSDictionary *)eventsPageJSONWithCount:(NSUInteger)count pathDepth:(NSUInteger)pathDepth;
+
+// Timestamps in the formats the API returns.
++ (NSArray<NSString *> *)ISO8601StringsWithCount:(NSUInteger)count;
+
++ (NSData *)dataWithJSONObject:(id)JSONObject;
+
+@end
@@ -0,0 +1,266 @@
+//
+//  BOXModelFixtureGenerator.m
+//  BoxContentSDK
+//
+
+#import "BOXModelFixtureGenerator.h"
+
+#define BOX_FIXTURE_BASE_TIMESTAMP (1411430542)
+
+@implementation BOXModelFixtureGenerator
+
+#pragma mark - Items
+
++ (NSDictionary *)fileJSONWithIndex:(NSUInteger)index
+                          pathDepth:(NSUInteger)pathDepth
+              metadataInstanceCount:(NSUInteger)metadataInstanceCount
+                 metadataFieldCount:(NSUInteger)metadataFieldCount
+{
+    NSMutableDictionary *JSON = [self itemJSONWithType:@"file" index:index pathDepth:pathDepth];
+    NSString *extension = @[@"jpg", @"pdf", @"docx", @"mov", @"txt"][index % 5];
+    JSON[@"name"] = [NSString stringWithFormat:@"Document %lu.%@", (unsigned long)index, extension];
+    JSON[@"extension"] = extension;
+    JSON[@"sha1"] = [self sha1LikeStringWithIndex:index];
+    JSON[@"size"] = @((index * 7919) % 50000000 + 1024);
+    JSON[@"comment_count"] = @(index % 4);
+    JSON[@"version_number"] = [NSString stringWithFormat:@"%lu", (unsigned long)(index % 9 + 1)];
+    JSON[@"is_package"] = @NO;
+    JSON[@"lock"] = (index % 10 == 0) ? @{@"type" : @"lock",
+                                          @"id" : [NSString stringWithFormat:@"9%lu", (unsigned long)index],
+                                          @"created_by" : [self userJSONWithIndex:index],
+                                          @"created_at" : [self timestampWithOffset:index],
+                                          @"expires_at" : [NSNull null],
+                                          @"is_download_prevented" : @NO} : [NSNull null];
+    JSON[@"permissions"] = @{@"can_download" : @YES,
+                             @"can_preview" : @YES,
+                             @"can_upload" : @YES,
+                             @"can_comment" : @YES,
+                             @"can_rename" : @YES,
+                             @"can_delete" : @YES,
+                             @"can_share" : @YES,
+                             @"can_set_share_access" : @YES};
+
+    if (metadataInstanceCount > 0) {
+        NSMutableDictionary *templates = [NSMutableDictionary dictionary];
+        for (NSUInteger i = 0; i < metadataInstanceCount; i++) {
+            NSString *template = [NSString stringWithFormat:@"template%lu", (unsigned long)i];
+            NSMutableDictionary *instance = [NSMutableDictionary dictionary];
+            instance[@"$id"] = [NSString stringWithFormat:@"%08lx-%04lx-4000-8000-%012lx", (unsigned long)index, (unsigned long)i, (unsigned long)(index * 31 + i)];
+            instance[@"$type"] = [template stringByAppendingString:@"-7a3d"];
+            instance[@"$parent"] = [@"file_" stringByAppendingString:JSON[@"id"]];
+            instance[@"$scope"] = @"enterprise_1234";
+            instance[@"$template"] = template;
+            instance[@"$version"] = @(i);
+            instance[@"$typeVersion"] = @(2);
+            for (NSUInteger j = 0; j < metadataFieldCount; j++) {
+                instance[[NSString stringWithFormat:@"field%lu", (unsigned long)j]] = [NSString stringWithFormat:@"value %lu of item %lu", (unsigned long)j, (unsigned long)index];
+            }
+            templates[template] = instance;
+        }
+        JSON[@"metadata"] = @{@"enterprise_1234" : templates};
+    }
+    return JSON;
+}
+
++ (NSDictionary *)folderJSONWithIndex:(NSUInteger)index pathDepth:(NSUInteger)pathDepth
+{
+    NSMutableDictionary *JSON = [self itemJSONWithType:@"folder" index:index pathDepth:pathDepth];
+    JSON[@"name"] = [NSString stringWithFormat:@"Folder %lu", (unsigned long)index];
+    JSON[@"size"] = @((index * 104729) % 900000000);
+    JSON[@"folder_upload_email"] = (index % 3 == 0) ? @{@"access" : @"open", @"email" : [NSString stringWithFormat:@"upload.%lu@u.box.com", (unsigned long)index]} : [NSNull null];
+    JSON[@"sync_state"] = @[@"synced", @"not_synced", @"partially_synced"][index % 3];
+    JSON[@"has_collaborations"] = @(index % 2 == 0);
+    JSON[@"can_non_owners_invite"] = @YES;
+    JSON[@"is_externally_owned"] = @NO;
+    JSON[@"allowed_invitee_roles"] = @[@"editor", @"viewer", @"previewer", @"uploader", @"co-owner"];
+    JSON[@"permissions"] = @{@"can_download" : @YES,
+                             @"can_upload" : @YES,
+                             @"can_rename" : @YES,
+                             @"can_delete" : @YES,
+                             @"can_share" : @YES,
+                             @"can_invite_collaborator" : @YES,
+                             @"can_set_share_access" : @YES};
+    return JSON;
+}
+
++ (NSDictionary *)webLinkJSONWithIndex:(NSUInteger)index pathDepth:(NSUInteger)pathDepth
+{
+    NSMutableDictionary *JSON = [self itemJSONWithType:@"web_link" index:index pathDepth:pathDepth];
+    JSON[@"name"] = [NSString stringWithFormat:@"Link %lu", (unsigned long)index];
+    JSON[@"url"] = [NSString stringWithFormat:@"https://www.example.com/pages/%lu", (unsigned long)index];
+    JSON[@"comment_count"] = @(index % 3);
+    JSON[@"permissions"] = @{@"can_comment" : @YES, @"can_rename" : @YES, @"can_delete" : @YES, @"can_share" : @YES};
+    return JSON;
+}
+
++ (NSMutableDictionary *)itemJSONWithType:(NSString *)type index:(NSUInteger)index pathDepth:(NSUInteger)pathDepth
+{
+    NSMutableArray *pathEntries = [NSMutableArray arrayWithCapacity:pathDepth];
+    [pathEntries addObject:@{@"type" : @"folder", @"id" : @"0", @"sequence_id" : [NSNull null], @"etag" : [NSNull null], @"name" : @"All Files"}];
+    for (NSUInteger depth = 1; depth < pathDepth; depth++) {
+        [pathEntries addObject:@{@"type" : @"folder",
+                                 @"id" : [NSString stringWithFormat:@"%lu", (unsigned long)(100000 + depth)],
+                                 @"sequence_id" : @"1",
+                                 @"etag" : @"1",
+                                 @"name" : [NSString stringWithFormat:@"Level %lu", (unsigned long)depth]}];
+    }
+
+    NSMutableDictionary *JSON = [NSMutableDictionary dictionary];
+    JSON[@"type"] = type;
+    JSON[@"id"] = [NSString stringWithFormat:@"%lu", (unsigned long)(200000000 + index)];
+    JSON[@"sequence_id"] = [NSString stringWithFormat:@"%lu", (unsigned long)(index % 17)];
+    JSON[@"etag"] = JSON[@"sequence_id"];
+    JSON[@"description"] = (index % 4 == 0) ? [NSString stringWithFormat:@"Description of item %lu, long enough to be realistic.", (unsigned long)index] : @"";
+    JSON[@"created_at"] = [self timestampWithOffset:index];
+    JSON[@"modified_at"] = [self timestampWithOffset:index + 3600];
+    JSON[@"content_created_at"] = [self timestampWithOffset:index];
+    JSON[@"content_modified_at"] = [self timestampWithOffset:index + 60];
+    JSON[@"trashed_at"] = [NSNull null];
+    JSON[@"purged_at"] = [NSNull null];
+    JSON[@"item_status"] = @"active";
+    JSON[@"path_collection"] = @{@"total_count" : @(pathEntries.count), @"entries" : pathEntries};
+    JSON[@"parent"] = pathEntries.lastObject;
+    JSON[@"created_by"] = [self userJSONWithIndex:index];
+    JSON[@"modified_by"] = [self userJSONWithIndex:index + 1];
+    JSON[@"owned_by"] = [self userJSONWithIndex:0];
+    JSON[@"shared_link"] = (index % 5 == 0) ? @{@"url" : [NSString stringWithFormat:@"https://app.box.com/s/%@", [self sha1LikeStringWithIndex:index]],
+                                                @"download_url" : [NSNull null],
+                                                @"vanity_url" : [NSNull null],
+                                                @"effective_access" : @"open",
+                                                @"is_password_enabled" : @NO,
+                                                @"unshared_at" : [NSNull null],
+                                                @"download_count" : @(index % 50),
+                                                @"preview_count" : @(index % 80),
+                                                @"access" : @"open",
+                                                @"permissions" : @{@"can_download" : @YES, @"can_preview" : @YES}} : [NSNull null];
+    JSON[@"allowed_shared_link_access_levels"] = @[@"collaborators", @"open", @"company"];
+    JSON[@"collections"] = (index % 6 == 0) ? @[@{@"type" : @"collection", @"id" : @"10047", @"name" : @"Favorites", @"collection_type" : @"favorites"}] : @[];
+    return JSON;
+}
+
+#pragma mark - Pages
+
++ (NSDictionary *)folderItemsPageJSONWithCount:(NSUInteger)count
+                                     pathDepth:(NSUInteger)pathDepth
+                         metadataInstanceCount:(NSUInteger)metadataInstanceCount
+{
+    NSMutableArray *entries = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        @autoreleasepool {
+            [entries addObject:[self itemJSONForEntryAtIndex:i pathDepth:pathDepth metadataInstanceCount:metadataInstanceCount]];
+        }
+    }
+    return @{@"total_count" : @(count),
+             @"offset" : @(0),
+             @"limit" : @(count),
+             @"entries" : entries,
+             @"order" : @[@{@"by" : @"type", @"direction" : @"ASC"}, @{@"by" : @"name", @"direction" : @"ASC"}]};
+}
+
++ (NSDictionary *)itemJSONForEntryAtIndex:(NSUInteger)index pathDepth:(NSUInteger)pathDepth metadataInstanceCount:(NSUInteger)metadataInstanceCount
+{
+    // 80% files, 15% folders, 5% web links.
+    NSUInteger bucket = index % 20;
+    if (bucket < 3) {
+        return [self folderJSONWithIndex:index pathDepth:pathDepth];
+    } else if (bucket == 3) {
+        return [self webLinkJSONWithIndex:index pathDepth:pathDepth];
+    }
+    return [self fileJSONWithIndex:index pathDepth:pathDepth metadataInstanceCount:metadataInstanceCount metadataFieldCount:8];
+}
+
++ (NSDictionary *)eventsPageJSONWithCount:(NSUInteger)count pathDepth:(NSUInteger)pathDepth
+{
+    NSArray *eventTypes = @[@"ITEM_CREATE", @"ITEM_UPLOAD", @"ITEM_MOVE", @"ITEM_RENAME", @"ITEM_TRASH", @"COMMENT_CREATE", @"COLLAB_ADD_COLLABORATOR", @"ITEM_PREVIEW"];
+    NSMutableArray *entries = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        @autoreleasepool {
+            id source = nil;
+            switch (i % 6) {
+                case 0:
+                case 1:
+                    source = [self fileJSONWithIndex:i pathDepth:pathDepth metadataInstanceCount:0 metadataFieldCount:0];
+                    break;
+                case 2:
+                    source = [self folderJSONWithIndex:i pathDepth:pathDepth];
+                    break;
+                case 3:
+                    source = @{@"type" : @"comment",
+                               @"id" : [NSString stringWithFormat:@"3%lu", (unsigned long)i],
+                               @"message" : [NSString stringWithFormat:@"Comment number %lu", (unsigned long)i],
+                               @"is_reply_comment" : @NO,
+                               @"created_by" : [self userJSONWithIndex:i],
+                               @"created_at" : [self timestampWithOffset:i],
+                               @"item" : @{@"type" : @"file", @"id" : [NSString stringWithFormat:@"%lu", (unsigned long)(200000000 + i)]}};
+                    break;
+                case 4:
+                    source = @{@"type" : @"collaboration",
+                               @"id" : [NSString stringWithFormat:@"4%lu", (unsigned long)i],
+                               @"role" : @"editor",
+                               @"status" : @"accepted",
+                               @"accessible_by" : [self userJSONWithIndex:i],
+                               @"created_at" : [self timestampWithOffset:i],
+                               @"item" : @{@"type" : @"folder", @"id" : [NSString stringWithFormat:@"%lu", (unsigned long)(200000000 + i)], @"name" : @"Shared"}};
+                    break;
+                default:
+                    source = (i % 12 == 5) ? [self userJSONWithIndex:i] : [self webLinkJSONWithIndex:i pathDepth:pathDepth];
+                    break;
+            }
+            [entries addObject:@{@"type" : @"event",
+                                 @"event_id" : [NSString stringWithFormat:@"%08lx-e7e0-4000-8000-%012lx", (unsigned long)i, (unsigned long)(i * 131)],
+                                 @"event_type" : eventTypes[i % eventTypes.count],
+                                 @"session_id" : [NSString stringWithFormat:@"session%lu", (unsigned long)(i % 40)],
+                                 @"created_by" : [self userJSONWithIndex:i],
+                                 @"created_at" : [self timestampWithOffset:i],
+                                 @"recorded_at" : [self timestampWithOffset:i + 1],
+                                 @"source" : source}];
+        }
+    }
+    return @{@"chunk_size" : @(count), @"next_stream_position" : @(1152922976252290886 + count), @"entries" : entries};
+}
+
++ (NSArray<NSString *> *)ISO8601StringsWithCount:(NSUInteger)count
+{
+    NSMutableArray *strings = [NSMutableArray arrayWithCapacity:count];
+    for (NSUInteger i = 0; i < count; i++) {
+        [strings addObject:[self timestampWithOffset:i * 37]];
+    }
+    return strings;
+}
+
++ (NSData *)dataWithJSONObject:(id)JSONObject
+{
+    return [NSJSONSerialization dataWithJSONObject:JSONObject options:0 error:nil];
+}
+
+#pragma mark - Values
+
++ (NSDictionary *)userJSONWithIndex:(NSUInteger)index
+{
+    NSUInteger userIndex = index % 50;
+    return @{@"type" : @"user",
+             @"id" : [NSString stringWithFormat:@"1333%04lu", (unsigned long)userIndex],
+             @"name" : [NSString stringWithFormat:@"User %lu", (unsigned long)userIndex],
+             @"login" : [NSString stringWithFormat:@"user%lu@example.com", (unsigned long)userIndex]};
+}
+
++ (NSString *)timestampWithOffset:(NSUInteger)offset
+{
+    // The API returns Pacific time offsets, and UTC from some endpoints.
+    time_t timestamp = BOX_FIXTURE_BASE_TIMESTAMP + (time_t)offset;
+    BOOL isUTC = offset % 4 == 0;
+    time_t localTimestamp = isUTC ? timestamp : timestamp - 7 * 3600;
+    struct tm components;
+    gmtime_r(&localTimestamp, &components);
+    char buffer[32];
+    strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &components);
+    return [NSString stringWithFormat:@"%s%@", buffer, isUTC ? @"Z" : @"-07:00"];
+}
+
++ (NSString *)sha1LikeStringWithIndex:(NSUInteger)index
+{
+    uint64_t value = (uint64_t)index * 0x9E3779B97F4A7C15ULL + 0x2545F4914F6CDD1DULL;
+    return [NSString stringWithFormat:@"%016llx%016llx%08x", value, value ^ 0xFFFFFFFFFFFFFFFFULL, (unsigned int)(value >> 16)];
+}
+
+@end
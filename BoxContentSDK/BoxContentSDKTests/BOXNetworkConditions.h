@@ -0,0 +1,82 @@
+//
+//  BOXNetworkConditions.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+
+typedef NS_ENUM(NSUInteger, BOXNetworkLatencyDistribution) {
+    // Always latency.
+    BOXNetworkLatencyDistributionConstant = 0,
+    // Between latency and latency + jitter.
+    BOXNetworkLatencyDistributionUniform,
+    // latency plus a Pareto distributed delay of scale jitter, capped at 20 times jitter, for long tails.
+    BOXNetworkLatencyDistributionLongTail
+};
+
+typedef NS_ENUM(NSUInteger, BOXNetworkFaultType) {
+    // The request fails before any response, with an NSURLErrorDomain error.
+    BOXNetworkFaultTypeConnectionError = 0,
+    // The server answers with an error status instead of the canned response.
+    BOXNetworkFaultTypeHTTPStatus,
+    // The connection drops after some bytes of the body, with NSURLErrorNetworkConnectionLost.
+    BOXNetworkFaultTypeDisconnect,
+    // The body ends early but the response completes normally.
+    BOXNetworkFaultTypeTruncatedBody
+};
+
+@interface BOXNetworkFault : NSObject <NSCopying>
+
+@property (nonatomic, readonly, assign) BOXNetworkFaultType type;
+
+// For BOXNetworkFaultTypeHTTPStatus.
+@property (nonatomic, readonly, assign) NSInteger statusCode;
+@property (nonatomic, readonly, strong) NSDictionary *headerFields;
+
+// For BOXNetworkFaultTypeConnectionError.
+@property (nonatomic, readonly, assign) NSInteger errorCode;
+
+// For BOXNetworkFaultTypeDisconnect and BOXNetworkFaultTypeTruncatedBody.
+@property (nonatomic, readonly, assign) NSUInteger bodyBytesDelivered;
+
+// The requests to a host the fault applies to, by the order in which they started. Set by BOXNetworkConditions.
+@property (nonatomic, readonly, assign) NSRange requestRange;
+@property (nonatomic, readonly, assign) double probability;
+
++ (instancetype)connectionErrorWithCode:(NSInteger)errorCode;
++ (instancetype)HTTPStatusFaultWithStatusCode:(NSInteger)statusCode headerFields:(NSDictionary *)headerFields;
+// A 429 response with a Retry-After header.
++ (instancetype)rateLimitFaultWithRetryAfter:(NSTimeInterval)retryAfter;
++ (instancetype)disconnectAfterBodyBytes:(NSUInteger)bodyBytes;
++ (instancetype)truncatedBodyAfterBytes:(NSUInteger)bodyBytes;
+
+@end
+
+// Conditions of the simulated network between the SDK and one host. See BOXSimulatedNetwork.
+@interface BOXNetworkConditions : NSObject
+
+@property (nonatomic, readwrite, assign) BOXNetworkLatencyDistribution latencyDistribution;
+
+// Time to the first byte of the response.
+@property (nonatomic, readwrite, assign) NSTimeInterval latency;
+@property (nonatomic, readwrite, assign) NSTimeInterval jitter;
+
+// Bandwidth of the response body. 0, the default, is unlimited.
+@property (nonatomic, readwrite, assign) NSUInteger bytesPerSecond;
+
+// The body is delivered in chunks of this size. Defaults to 16 KB.
+@property (nonatomic, readwrite, assign) NSUInteger chunkSize;
+
+// Probability that the delivery stalls for stallDuration before a chunk of the body.
+@property (nonatomic, readwrite, assign) double stallProbability;
+@property (nonatomic, readwrite, assign) NSTimeInterval stallDuration;
+
+@property (nonatomic, readonly, strong) NSArray<BOXNetworkFault *> *faults;
+
++ (instancetype)conditionsWithLatency:(NSTimeInterval)latency bytesPerSecond:(NSUInteger)bytesPerSecond;
+
+// The first fault that applies to a request is injected. Faults added first take precedence.
+- (void)addFault:(BOXNetworkFault *)fault forRequestsInRange:(NSRange)requestRange;
+- (void)addFault:(BOXNetworkFault *)fault withProbability:(double)probability;
+
+@end
@@ -0,0 +1,133 @@
+//
+//  BOXNetworkConditions.m
+//  BoxContentSDK
+//
+
+#import "BOXNetworkConditions.h"
+
+#define BOX_NETWORK_DEFAULT_CHUNK_SIZE (16 * 1024)
+
+@interface BOXNetworkFault ()
+
+@property (nonatomic, readwrite, assign) BOXNetworkFaultType type;
+@property (nonatomic, readwrite, assign) NSInteger statusCode;
+@property (nonatomic, readwrite, strong) NSDictionary *headerFields;
+@property (nonatomic, readwrite, assign) NSInteger errorCode;
+@property (nonatomic, readwrite, assign) NSUInteger bodyBytesDelivered;
+@property (nonatomic, readwrite, assign) NSRange requestRange;
+@property (nonatomic, readwrite, assign) double probability;
+
+@end
+
+@implementation BOXNetworkFault
+
+- (instancetype)initWithType:(BOXNetworkFaultType)type
+{
+    if (self = [super init]) {
+        _type = type;
+        _requestRange = NSMakeRange(NSNotFound, 0);
+    }
+    return self;
+}
+
++ (instancetype)connectionErrorWithCode:(NSInteger)errorCode
+{
+    BOXNetworkFault *fault = [[self alloc] initWithType:BOXNetworkFaultTypeConnectionError];
+    fault.errorCode = errorCode;
+    return fault;
+}
+
++ (instancetype)HTTPStatusFaultWithStatusCode:(NSInteger)statusCode headerFields:(NSDictionary *)headerFields
+{
+    BOXNetworkFault *fault = [[self alloc] initWithType:BOXNetworkFaultTypeHTTPStatus];
+    fault.statusCode = statusCode;
+    fault.headerFields = headerFields;
+    return fault;
+}
+
++ (instancetype)rateLimitFaultWithRetryAfter:(NSTimeInterval)retryAfter
+{
+    return [self HTTPStatusFaultWithStatusCode:429 headerFields:@{@"Retry-After" : [NSString stringWithFormat:@"%.0f", retryAfter]}];
+}
+
++ (instancetype)disconnectAfterBodyBytes:(NSUInteger)bodyBytes
+{
+    BOXNetworkFault *fault = [[self alloc] initWithType:BOXNetworkFaultTypeDisconnect];
+    fault.bodyBytesDelivered = bodyBytes;
+    return fault;
+}
+
++ (instancetype)truncatedBodyAfterBytes:(NSUInteger)bodyBytes
+{
+    BOXNetworkFault *fault = [[self alloc] initWithType:BOXNetworkFaultTypeTruncatedBody];
+    fault.bodyBytesDelivered = bodyBytes;
+    return fault;
+}
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    BOXNetworkFault *fault = [[[self class] allocWithZone:zone] initWithType:self.type];
+    fault.statusCode = self.statusCode;
+    fault.headerFields = self.headerFields;
+    fault.errorCode = self.errorCode;
+    fault.bodyBytesDelivered = self.bodyBytesDelivered;
+    fault.requestRange = self.requestRange;
+    fault.probability = self.probability;
+    return fault;
+}
+
+@end
+
+@interface BOXNetworkConditions ()
+
+@property (nonatomic, readwrite, strong) NSMutableArray *mutableFaults;
+
+@end
+
+@implementation BOXNetworkConditions
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _chunkSize = BOX_NETWORK_DEFAULT_CHUNK_SIZE;
+        _mutableFaults = [NSMutableArray array];
+    }
+    return self;
+}
+
++ (instancetype)conditionsWithLatency:(NSTimeInterval)latency bytesPerSecond:(NSUInteger)bytesPerSecond
+{
+    BOXNetworkConditions *conditions = [[self alloc] init];
+    conditions.latency = latency;
+    conditions.bytesPerSecond = bytesPerSecond;
+    return conditions;
+}
+
+- (NSArray<BOXNetworkFault *> *)faults
+{
+    @synchronized(self) {
+        return [self.mutableFaults copy];
+    }
+}
+
+- (void)addFault:(BOXNetworkFault *)fault forRequestsInRange:(NSRange)requestRange
+{
+    BOXNetworkFault *scheduledFault = [fault copy];
+    scheduledFault.requestRange = requestRange;
+    scheduledFault.probability = 0;
+    @synchronized(self) {
+        [self.mutableFaults addObject:scheduledFault];
+    }
+}
+
+- (void)addFault:(BOXNetworkFault *)fault withProbability:(double)probability
+{
+    BOXNetworkFault *scheduledFault = [fault copy];
+    scheduledFault.requestRange = NSMakeRange(NSNotFound, 0);
+    scheduledFault.probability = probability;
+    @synchronized(self) {
+        [self.mutableFaults addObject:scheduledFault];
+    }
+}
+
+@end
@@ -9,6 +9,7 @@
 #import "BOXContentSDKTestCase.h"
 #import "BOXOAuth2Session.h"
 #import "BOXKeychainItemWrapper.h"
+#import "BOXAbstractSession_Private.h"
 
 @interface BOXOAuth2Session ()
 - (void)didReceiveRevokeSessionNotification:(NSNotification *)notification;
@@ -77,6 +78,7 @@
     BOXKeychainItemWrapper *keychain = [[BOXKeychainItemWrapper alloc] initWithIdentifier:[@"BoxCredential_" stringByAppendingString:user.modelID] accessGroup:nil];
     [keychain resetKeychainItem];
     [keychain setObject:jsonString forKey:(__bridge id)kSecValueData];
+    [[BOXOAuth2Session credentialStore] invalidate];
     
     BOXOAuth2Session *session = [[BOXOAuth2Session alloc] init];
     [session restoreCredentialsFromKeychainForUserWithID:user.modelID];
@@ -179,6 +181,7 @@
         BOXKeychainItemWrapper *keychain = [[BOXKeychainItemWrapper alloc] initWithIdentifier:[@"BoxCredential_" stringByAppendingString:user.modelID] accessGroup:nil];
         [keychain resetKeychainItem];
         [keychain setObject:jsonString forKey:(__bridge id)kSecValueData];
+        [[BOXOAuth2Session credentialStore] invalidate];
         
         keychainEntriesByUserID[user.modelID] = dictionary;
     }
@@ -326,4 +329,27 @@
     return [NSDate dateWithTimeIntervalSinceReferenceDate:floor([date timeIntervalSinceReferenceDate])];
 }
 
+- (void)test_that_token_changes_publish_a_new_snapshot
+{
+    BOXOAuth2Session *session = [[BOXOAuth2Session alloc] init];
+    NSDate *expiration = [NSDate dateWithTimeIntervalSinceNow:3600];
+    [session setAccessToken:@"abc" accessTokenExpiration:expiration];
+    BOXSessionTokenSnapshot *tokenSnapshot = session.tokenSnapshot;
+
+    session.accessToken = @"def";
+
+    // A snapshot read earlier is never changed, and still agrees with itself.
+    XCTAssertEqualObjects(@"abc", tokenSnapshot.accessToken);
+    XCTAssertEqualObjects(@"Bearer abc", tokenSnapshot.authorizationHeaderValue);
+    XCTAssertEqualObjects(@"def", session.tokenSnapshot.accessToken);
+    XCTAssertEqualObjects(expiration, session.tokenSnapshot.accessTokenExpiration);
+    XCTAssertTrue([session isAuthorized]);
+
+    NSMutableURLRequest *request = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://api.box.com/2.0/users/me"]];
+    [session addAuthorizationParametersToRequest:request tokenSnapshot:tokenSnapshot];
+    XCTAssertEqualObjects(@"Bearer abc", [request valueForHTTPHeaderField:BOXAPIHTTPHeaderAuthorization]);
+    [session addAuthorizationParametersToRequest:request];
+    XCTAssertEqualObjects(@"Bearer def", [request valueForHTTPHeaderField:BOXAPIHTTPHeaderAuthorization]);
+}
+
 @end
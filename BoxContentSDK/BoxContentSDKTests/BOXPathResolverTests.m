@@ -0,0 +1,278 @@
+//
+//  BOXPathResolverTests.m
+//  BoxContentSDK
+//
+
+#import "BOXStandInClientTestCase.h"
+#import "BOXContentClient.h"
+#import "BOXPathResolver.h"
+#import "BOXFile.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXContentSDKErrors.h"
+#import "NSURL+BOXURLHelper.h"
+
+@interface BOXPathResolverTests : BOXStandInClientTestCase
+
+@property (nonatomic, readwrite, strong) id clientMock;
+@property (nonatomic, readwrite, strong) BOXPathResolver *resolver;
+// Searches and listings received by the stand-in server, e.g. "search archive in 11" and "list 12@0".
+@property (nonatomic, readwrite, strong) NSMutableArray *requestLog;
+
+@end
+
+@implementation BOXPathResolverTests
+
+- (void)setUp
+{
+    [super setUp];
+    // Paths in the tree are resolved without any request, so the client is never used.
+    self.clientMock = [OCMockObject mockForClass:[BOXContentClient class]];
+    self.resolver = [[BOXPathResolver alloc] initWithClient:self.clientMock];
+    [self.resolver addItems:@[[self reportFile]]];
+    self.requestLog = [NSMutableArray array];
+}
+
+- (void)test_path_is_resolved_from_path_folders_case_insensitively
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [self.resolver resolvePath:@"/projects/2026/Report.PDF" completion:^(NSString *itemID, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(@"99", itemID);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_paths_are_resolved_in_batch
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [self.resolver resolvePaths:@[@"/Projects", @"/Projects/2026/", @"/Projects/2026/report.pdf"] completion:^(NSDictionary *itemIDsByPath, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(@"11", itemIDsByPath[@"/Projects"]);
+        XCTAssertEqualObjects(@"12", itemIDsByPath[@"/Projects/2026/"]);
+        XCTAssertEqualObjects(@"99", itemIDsByPath[@"/Projects/2026/report.pdf"]);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_root_path_resolves_to_root_folder
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [self.resolver resolvePath:@"/" completion:^(NSString *itemID, NSError *error) {
+        XCTAssertEqualObjects(BOXAPIFolderIDRoot, itemID);
+        [expectation fulfill];
+    }];
+
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_that_missing_name_is_searched_for_in_its_parent
+{
+    [self useServer];
+
+    [self resolvePath:@"/Projects/Archive" expectedItemID:@"13" expectedErrorCode:0];
+
+    XCTAssertEqualObjects((@[@"search archive in 11"]), self.requestLog);
+}
+
+- (void)test_that_name_missing_from_search_is_found_by_listing_its_parent
+{
+    [self useServer];
+
+    // Search has not indexed budget.xlsx yet.
+    [self resolvePath:@"/Projects/2026/budget.xlsx" expectedItemID:@"98" expectedErrorCode:0];
+
+    XCTAssertEqualObjects((@[@"search budget.xlsx in 12", @"list 12@0"]), self.requestLog);
+}
+
+- (void)test_that_missing_path_fails_and_is_not_looked_up_again
+{
+    [self useServer];
+
+    [self resolvePath:@"/Projects/2026/missing.txt" expectedItemID:nil expectedErrorCode:BOXContentSDKAPIErrorNotFound];
+    XCTAssertEqualObjects((@[@"search missing.txt in 12", @"list 12@0"]), self.requestLog);
+
+    // The parent was just listed, so the name is known to be missing.
+    [self resolvePath:@"/Projects/2026/missing.txt" expectedItemID:nil expectedErrorCode:BOXContentSDKAPIErrorNotFound];
+    XCTAssertEqual(2, self.requestLog.count);
+}
+
+- (void)test_that_removed_item_is_looked_up_again
+{
+    [self useServer];
+
+    [self resolvePath:@"/Projects/2026/report.pdf" expectedItemID:@"99" expectedErrorCode:0];
+    XCTAssertEqual(0, self.requestLog.count);
+
+    [self.resolver removeItemWithID:@"99"];
+    [self resolvePath:@"/Projects/2026/report.pdf" expectedItemID:@"99" expectedErrorCode:0];
+
+    XCTAssertEqualObjects((@[@"search report.pdf in 12"]), self.requestLog);
+}
+
+- (void)test_that_removing_all_items_looks_up_every_folder_again
+{
+    [self useServer];
+
+    [self.resolver removeAllItems];
+    [self resolvePath:@"/Projects/2026/report.pdf" expectedItemID:@"99" expectedErrorCode:0];
+
+    XCTAssertEqualObjects((@[@"search projects in 0", @"search 2026 in 11", @"search report.pdf in 12"]), self.requestLog);
+}
+
+- (void)test_that_stale_entries_are_looked_up_again
+{
+    [self useServer];
+    self.resolver.freshnessInterval = 0.5;
+
+    [self resolvePath:@"/Projects" expectedItemID:@"11" expectedErrorCode:0];
+    XCTAssertEqual(0, self.requestLog.count);
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.6]];
+    [self resolvePath:@"/Projects" expectedItemID:@"11" expectedErrorCode:0];
+
+    XCTAssertEqualObjects((@[@"search projects in 0"]), self.requestLog);
+}
+
+- (void)test_that_concurrent_resolutions_fill_the_tree_consistently
+{
+    [self useServer];
+    [self.resolver removeAllItems];
+
+    NSDictionary *expectedItemIDs = @{@"/Projects" : @"11",
+                                      @"/Projects/Archive" : @"13",
+                                      @"/Projects/2026" : @"12",
+                                      @"/Projects/2026/report.pdf" : @"99",
+                                      @"/Projects/2026/budget.xlsx" : @"98"};
+    NSArray *paths = [expectedItemIDs allKeys];
+    NSUInteger batchCount = 8;
+    NSMutableArray *expectations = [NSMutableArray array];
+    for (NSUInteger i = 0; i < batchCount; i++) {
+        [expectations addObject:[self expectationWithDescription:[NSString stringWithFormat:@"batch %lu", (unsigned long)i]]];
+    }
+
+    // Batches race each other to fill the same folders, while the app records items of its own.
+    BOXPathResolver *resolver = self.resolver;
+    BOXFile *reportFile = [self reportFile];
+    dispatch_apply(batchCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t i) {
+        if (i % 2 == 0) {
+            [resolver addItems:@[reportFile]];
+        }
+        NSArray *batchPaths = [paths subarrayWithRange:NSMakeRange(i % paths.count, paths.count - i % paths.count)];
+        [resolver resolvePaths:batchPaths completion:^(NSDictionary *itemIDsByPath, NSError *error) {
+            XCTAssertNil(error);
+            for (NSString *path in batchPaths) {
+                XCTAssertEqualObjects(expectedItemIDs[path], itemIDsByPath[path]);
+            }
+            [expectations[i] fulfill];
+        }];
+    });
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    // Every folder is in the tree now.
+    NSUInteger requestCount = self.requestLog.count;
+    XCTestExpectation *expectation = [self expectationWithDescription:@"filled"];
+    [self.resolver resolvePaths:paths completion:^(NSDictionary *itemIDsByPath, NSError *error) {
+        XCTAssertEqualObjects(expectedItemIDs, itemIDsByPath);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+    XCTAssertEqual(requestCount, self.requestLog.count);
+}
+
+#pragma mark - Helpers
+
+- (BOXFile *)reportFile
+{
+    NSDictionary *pathCollection = @{BOXAPICollectionKeyEntries : @[@{BOXAPIObjectKeyType : BOXAPIItemTypeFolder, BOXAPIObjectKeyID : @"0", BOXAPIObjectKeyName : @"All Files"},
+                                                                     @{BOXAPIObjectKeyType : BOXAPIItemTypeFolder, BOXAPIObjectKeyID : @"11", BOXAPIObjectKeyName : @"Projects"},
+                                                                     @{BOXAPIObjectKeyType : BOXAPIItemTypeFolder, BOXAPIObjectKeyID : @"12", BOXAPIObjectKeyName : @"2026"}]};
+    return [[BOXFile alloc] initWithJSON:@{BOXAPIObjectKeyType : BOXAPIItemTypeFile,
+                                           BOXAPIObjectKeyID : @"99",
+                                           BOXAPIObjectKeyName : @"report.pdf",
+                                           BOXAPIObjectKeyPathCollection : pathCollection,
+                                           BOXAPIObjectKeyParent : @{BOXAPIObjectKeyType : BOXAPIItemTypeFolder, BOXAPIObjectKeyID : @"12", BOXAPIObjectKeyName : @"2026"}}];
+}
+
+// Replaces the resolver with one whose client talks to a stand-in server holding /Projects/Archive,
+// /Projects/2026/report.pdf and /Projects/2026/budget.xlsx. Search has not indexed budget.xlsx.
+- (void)useServer
+{
+    self.resolver = [[BOXPathResolver alloc] initWithClient:self.client];
+    [self.resolver addItems:@[[self reportFile]]];
+
+    NSDictionary *childrenByFolderID = @{@"0" : @[[self itemJSONWithType:BOXAPIItemTypeFolder ID:@"11" name:@"Projects" parentID:@"0"]],
+                                         @"11" : @[[self itemJSONWithType:BOXAPIItemTypeFolder ID:@"12" name:@"2026" parentID:@"11"],
+                                                   [self itemJSONWithType:BOXAPIItemTypeFolder ID:@"13" name:@"Archive" parentID:@"11"]],
+                                         @"12" : @[[self itemJSONWithType:BOXAPIItemTypeFile ID:@"99" name:@"report.pdf" parentID:@"12"],
+                                                   [self itemJSONWithType:BOXAPIItemTypeFile ID:@"98" name:@"budget.xlsx" parentID:@"12"]]};
+    NSMutableArray *requestLog = self.requestLog;
+
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"GET" pathPattern:@"/search$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        NSDictionary *parameters = [request.URL box_queryDictionary];
+        NSString *query = parameters[BOXAPIParameterKeyQuery];
+        NSString *parentID = parameters[BOXAPIParameterKeyAncestorFolderIDs];
+        @synchronized(requestLog) {
+            [requestLog addObject:[NSString stringWithFormat:@"search %@ in %@", query, parentID]];
+        }
+
+        NSMutableArray *entries = [NSMutableArray array];
+        for (NSDictionary *child in childrenByFolderID[parentID]) {
+            NSString *name = child[BOXAPIObjectKeyName];
+            if ([[name lowercaseString] isEqualToString:[query lowercaseString]] && ![name isEqualToString:@"budget.xlsx"]) {
+                [entries addObject:child];
+            }
+        }
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"total_count" : @(entries.count),
+                                                                            @"entries" : entries,
+                                                                            @"offset" : @0,
+                                                                            @"limit" : @100}];
+    }];
+
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"GET" pathPattern:@"/folders/[^/]+/items$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        NSArray *pathComponents = request.URL.pathComponents;
+        NSString *folderID = pathComponents[pathComponents.count - 2];
+        NSDictionary *parameters = [request.URL box_queryDictionary];
+        NSUInteger offset = (NSUInteger)[parameters[BOXAPIParameterKeyOffset] integerValue];
+        @synchronized(requestLog) {
+            [requestLog addObject:[NSString stringWithFormat:@"list %@@%lu", folderID, (unsigned long)offset]];
+        }
+
+        NSArray *entries = childrenByFolderID[folderID] ?: @[];
+        NSArray *page = offset < entries.count ? [entries subarrayWithRange:NSMakeRange(offset, entries.count - offset)] : @[];
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"total_count" : @(entries.count),
+                                                                            @"entries" : page,
+                                                                            @"offset" : @(offset),
+                                                                            @"limit" : @1000}];
+    }];
+}
+
+- (NSDictionary *)itemJSONWithType:(NSString *)type ID:(NSString *)itemID name:(NSString *)name parentID:(NSString *)parentID
+{
+    return @{BOXAPIObjectKeyType : type,
+             BOXAPIObjectKeyID : itemID,
+             BOXAPIObjectKeyName : name,
+             BOXAPIObjectKeyParent : @{BOXAPIObjectKeyType : BOXAPIItemTypeFolder, BOXAPIObjectKeyID : parentID}};
+}
+
+- (void)resolvePath:(NSString *)path expectedItemID:(NSString *)expectedItemID expectedErrorCode:(NSInteger)expectedErrorCode
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:path];
+    [self.resolver resolvePath:path completion:^(NSString *itemID, NSError *error) {
+        if (expectedErrorCode == 0) {
+            XCTAssertNil(error);
+        } else {
+            XCTAssertEqualObjects(BOXContentSDKErrorDomain, error.domain);
+            XCTAssertEqual(expectedErrorCode, error.code);
+        }
+        XCTAssertEqualObjects(expectedItemID, itemID);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+@end
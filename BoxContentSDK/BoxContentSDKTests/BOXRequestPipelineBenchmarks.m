@@ -0,0 +1,220 @@
+//
+//  BOXRequestPipelineBenchmarks.m
+//  BoxContentSDK
+//
+
+#import "BOXBenchmarkTestCase.h"
+#import "BOXContentClient+Folder.h"
+#import "BOXContentClient+File.h"
+#import "BOXContentClient+Search.h"
+#import "BOXFolderPaginatedItemsRequest.h"
+#import "BOXFolderRequest.h"
+#import "BOXSearchRequest.h"
+#import "BOXFileThumbnailRequest.h"
+#import "BOXFileDownloadRequest.h"
+#import "BOXFileUploadRequest.h"
+
+#define BOX_BENCHMARK_PAGE_SIZE (1000)
+#define BOX_BENCHMARK_SEARCH_COUNT (100)
+#define BOX_BENCHMARK_THUMBNAIL_COUNT (60)
+#define BOX_BENCHMARK_TOKEN_REFRESH_REQUEST_COUNT (200)
+#define BOX_BENCHMARK_REQUEST_CONSTRUCTION_COUNT (10000)
+
+@interface BOXRequest ()
+
+- (NSString *)userAgent;
+
+@end
+
+@interface BOXRequestPipelineBenchmarks : BOXAPIBenchmarkTestCase
+@end
+
+@implementation BOXRequestPipelineBenchmarks
+
+// Throughput is in items per second.
+- (void)test_folder_listing_across_pages
+{
+    [self runBenchmarkNamed:@"folder_listing" timeout:120.0 block:^(BOXBenchmarkRecorder *recorder, dispatch_block_t done) {
+        [self listFolderPageAtOffset:0 recorder:recorder done:done];
+    }];
+}
+
+- (void)listFolderPageAtOffset:(NSUInteger)offset recorder:(BOXBenchmarkRecorder *)recorder done:(dispatch_block_t)done
+{
+    NSDate *startDate = [NSDate date];
+    BOXFolderPaginatedItemsRequest *request = [self.client folderPaginatedItemsRequestWithID:@"0" inRange:NSMakeRange(offset, BOX_BENCHMARK_PAGE_SIZE)];
+    [request performRequestWithCompletion:^(NSArray<BOXItem *> *items, NSUInteger totalCount, NSRange range, NSError *error) {
+        [recorder recordLatency:-[startDate timeIntervalSinceNow]];
+        if (error) {
+            [recorder recordError:error];
+            done();
+            return;
+        }
+        [recorder addProcessedUnits:items.count];
+        NSUInteger nextOffset = range.location + range.length;
+        if (items.count > 0 && nextOffset < totalCount) {
+            [self listFolderPageAtOffset:nextOffset recorder:recorder done:done];
+        } else {
+            done();
+        }
+    }];
+}
+
+// Throughput is in searches per second.
+- (void)test_search
+{
+    [self runBenchmarkNamed:@"search" timeout:120.0 block:^(BOXBenchmarkRecorder *recorder, dispatch_block_t done) {
+        dispatch_group_t group = dispatch_group_create();
+        for (NSUInteger i = 0; i < BOX_BENCHMARK_SEARCH_COUNT; i++) {
+            dispatch_group_enter(group);
+            NSDate *startDate = [NSDate date];
+            BOXSearchRequest *request = [self.client searchRequestWithQuery:[NSString stringWithFormat:@"query %lu", (unsigned long)i] inRange:NSMakeRange(0, 100)];
+            [request performRequestWithCompletion:^(NSArray<BOXItem *> *items, NSUInteger totalCount, NSRange range, NSError *error) {
+                [recorder recordLatency:-[startDate timeIntervalSinceNow]];
+                if (error) {
+                    [recorder recordError:error];
+                } else {
+                    [recorder addProcessedUnits:1];
+                }
+                dispatch_group_leave(group);
+            }];
+        }
+        dispatch_group_notify(group, dispatch_get_main_queue(), done);
+    }];
+}
+
+// A screen of thumbnails requested at once. Throughput is in thumbnails per second.
+- (void)test_thumbnail_grid
+{
+    [self runBenchmarkNamed:@"thumbnail_grid" timeout:120.0 block:^(BOXBenchmarkRecorder *recorder, dispatch_block_t done) {
+        dispatch_group_t group = dispatch_group_create();
+        for (NSUInteger i = 0; i < BOX_BENCHMARK_THUMBNAIL_COUNT; i++) {
+            dispatch_group_enter(group);
+            NSDate *startDate = [NSDate date];
+            BOXFileThumbnailRequest *request = [self.client fileThumbnailRequestWithID:[NSString stringWithFormat:@"%lu", (unsigned long)(1000 + i)]
+                                                                                 size:BOXThumbnailSize128];
+            [request performRequestWithProgress:nil completion:^(UIImage *image, NSError *error) {
+                [recorder recordLatency:-[startDate timeIntervalSinceNow]];
+                if (error) {
+                    [recorder recordError:error];
+                } else {
+                    [recorder addProcessedUnits:1];
+                }
+                dispatch_group_leave(group);
+            }];
+        }
+        dispatch_group_notify(group, dispatch_get_main_queue(), done);
+    }];
+}
+
+// Throughput is in bytes per second.
+- (void)test_large_download
+{
+    NSString *localFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+
+    [self runBenchmarkNamed:@"large_download" timeout:1800.0 block:^(BOXBenchmarkRecorder *recorder, dispatch_block_t done) {
+        NSDate *startDate = [NSDate date];
+        BOXFileDownloadRequest *request = [self.client fileDownloadRequestWithID:@"1" toLocalFilePath:localFilePath];
+        [request performRequestWithProgress:nil completion:^(NSError *error) {
+            [recorder recordLatency:-[startDate timeIntervalSinceNow]];
+            if (error) {
+                [recorder recordError:error];
+            } else {
+                NSDictionary *attributes = [[NSFileManager defaultManager] attributesOfItemAtPath:localFilePath error:nil];
+                [recorder addProcessedUnits:attributes.fileSize];
+            }
+            done();
+        }];
+    }];
+
+    [[NSFileManager defaultManager] removeItemAtPath:localFilePath error:nil];
+}
+
+// Throughput is in bytes per second.
+- (void)test_large_upload
+{
+    if (![[self class] benchmarksEnabled]) {
+        return;
+    }
+
+    // A sparse file, so that creating it takes no time.
+    NSString *localFilePath = [NSTemporaryDirectory() stringByAppendingPathComponent:[[NSUUID UUID] UUIDString]];
+    [[NSFileManager defaultManager] createFileAtPath:localFilePath contents:nil attributes:nil];
+    NSFileHandle *fileHandle = [NSFileHandle fileHandleForWritingAtPath:localFilePath];
+    [fileHandle truncateFileAtOffset:self.transferSize];
+    [fileHandle closeFile];
+    unsigned long long transferSize = self.transferSize;
+
+    [self runBenchmarkNamed:@"large_upload" timeout:1800.0 block:^(BOXBenchmarkRecorder *recorder, dispatch_block_t done) {
+        NSDate *startDate = [NSDate date];
+        BOXFileUploadRequest *request = [self.client fileUploadRequestToFolderWithID:@"0" fromLocalFilePath:localFilePath];
+        [request performRequestWithProgress:nil completion:^(BOXFile *file, NSError *error) {
+            [recorder recordLatency:-[startDate timeIntervalSinceNow]];
+            if (error) {
+                [recorder recordError:error];
+            } else {
+                [recorder addProcessedUnits:transferSize];
+            }
+            done();
+        }];
+    }];
+
+    [[NSFileManager defaultManager] removeItemAtPath:localFilePath error:nil];
+}
+
+// Many requests fail at once with an expired access token. Throughput is in requests per second, and
+// token_refreshes should stay at 1.
+- (void)test_token_refresh_under_load
+{
+    [self runBenchmarkNamed:@"token_refresh_under_load" timeout:120.0 block:^(BOXBenchmarkRecorder *recorder, dispatch_block_t done) {
+        [self expireAccessToken];
+
+        dispatch_group_t group = dispatch_group_create();
+        for (NSUInteger i = 0; i < BOX_BENCHMARK_TOKEN_REFRESH_REQUEST_COUNT; i++) {
+            dispatch_group_enter(group);
+            NSDate *startDate = [NSDate date];
+            BOXFolderRequest *request = [self.client folderInfoRequestWithID:[NSString stringWithFormat:@"%lu", (unsigned long)(1000 + i)]];
+            [request performRequestWithCompletion:^(BOXFolder *folder, NSError *error) {
+                [recorder recordLatency:-[startDate timeIntervalSinceNow]];
+                if (error) {
+                    [recorder recordError:error];
+                } else {
+                    [recorder addProcessedUnits:1];
+                }
+                dispatch_group_leave(group);
+            }];
+        }
+        dispatch_group_notify(group, dispatch_get_main_queue(), ^{
+            [recorder setValue:self.tokenRefreshCount forMetric:@"token_refreshes"];
+            done();
+        });
+    }];
+
+    if ([[self class] benchmarksEnabled]) {
+        XCTAssertEqual(1, self.tokenRefreshCount);
+    }
+}
+
+// Builds requests up to the point where they would be enqueued, without sending them. Throughput is in requests
+// per second.
+- (void)test_request_construction
+{
+    [self runBenchmarkNamed:@"request_construction" timeout:120.0 block:^(BOXBenchmarkRecorder *recorder, dispatch_block_t done) {
+        for (NSUInteger i = 0; i < BOX_BENCHMARK_REQUEST_CONSTRUCTION_COUNT; i++) {
+            @autoreleasepool {
+                NSDate *startDate = [NSDate date];
+                NSString *folderID = [NSString stringWithFormat:@"%lu", (unsigned long)(1000 + i)];
+                BOXFolderPaginatedItemsRequest *request = [self.client folderPaginatedItemsRequestWithID:folderID inRange:NSMakeRange(0, BOX_BENCHMARK_PAGE_SIZE)];
+                NSURLRequest *URLRequest = request.urlRequest;
+                NSString *userAgent = [request userAgent];
+                [recorder recordLatency:-[startDate timeIntervalSinceNow]];
+                if (URLRequest.URL != nil && userAgent.length > 0) {
+                    [recorder addProcessedUnits:1];
+                }
+            }
+        }
+        done();
+    }];
+}
+
+@end
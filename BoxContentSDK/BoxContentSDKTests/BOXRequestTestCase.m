@@ -9,6 +9,7 @@
 #import "BOXRequestTestCase.h"
 #import "BOXRequest_Private.h"
 #import "BOXCannedURLProtocol.h"
+#import "BOXSimulatedNetwork.h"
 #import "BOXParallelAPIQueueManager.h"
 #import "BOXAPIMultipartToJSONOperation.h"
 #import "BOXBookmark.h"
@@ -53,6 +54,7 @@
 - (void)tearDown
 {
     [BOXCannedURLProtocol reset];
+    [[BOXSimulatedNetwork sharedNetwork] reset];
     [NSURLProtocol unregisterClass:[BOXCannedURLProtocol class]];
     
     self.fakeQueueManager = nil;
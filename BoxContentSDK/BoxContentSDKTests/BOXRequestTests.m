@@ -315,4 +315,27 @@
     XCTAssertEqualObjects(request.userAgent, [request.urlRequest valueForHTTPHeaderField:@"User-Agent"]);
 }
 
+- (void)test_that_user_agent_follows_prefix_changes
+{
+    BOXRequest *request = [[BOXRequest alloc] init];
+    NSString *userAgentWithoutPrefix = request.userAgent;
+
+    request.userAgentPrefix = @"test_prefix";
+    XCTAssertEqualObjects([@"test_prefix;" stringByAppendingString:userAgentWithoutPrefix], request.userAgent);
+
+    request.userAgentPrefix = nil;
+    XCTAssertEqualObjects(userAgentWithoutPrefix, request.userAgent);
+}
+
+- (void)test_that_fields_strings_are_shared_between_requests
+{
+    BOXRequest *firstRequest = [[BOXRequest alloc] init];
+    BOXRequest *secondRequest = [[BOXRequest alloc] init];
+
+    XCTAssertTrue([firstRequest fullItemFieldsParameterString] == [secondRequest fullItemFieldsParameterString]);
+    XCTAssertEqualObjects([firstRequest fullItemFieldsParameterStringExcludingFields:@[BOXAPIObjectKeyCollections]],
+                          [secondRequest fullItemFieldsParameterStringExcludingFields:@[BOXAPIObjectKeyCollections]]);
+    XCTAssertFalse([[firstRequest fullItemFieldsParameterStringExcludingFields:@[BOXAPIObjectKeyCollections]] containsString:BOXAPIObjectKeyCollections]);
+}
+
 @end
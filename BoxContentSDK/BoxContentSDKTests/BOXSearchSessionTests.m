@@ -0,0 +1,258 @@
+//
+//  BOXSearchSessionTests.m
+//  BoxContentSDK
+//
+
+#import "BOXStandInClientTestCase.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient_Private.h"
+#import "BOXContentClient+Search.h"
+#import "BOXSearchSession.h"
+#import "BOXItem.h"
+#import "NSURL+BOXURLHelper.h"
+
+#define BOX_SEARCH_SESSION_TEST_RESULT_COUNT (5)
+
+@interface BOXSearchSessionTests : BOXStandInClientTestCase
+
+@property (nonatomic, readwrite, strong) BOXSearchSession *session;
+// Query and offset of every search request received, e.g. "report@2".
+@property (nonatomic, readwrite, strong) NSMutableArray *requestedPages;
+// Query of every delivery of results.
+@property (nonatomic, readwrite, strong) NSMutableArray *deliveredQueries;
+// While set, search requests fail with a network error.
+@property (atomic, readwrite, assign) BOOL offline;
+
+@end
+
+@implementation BOXSearchSessionTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.session = [self.client searchSession];
+    self.session.debounceInterval = 0.0;
+    self.session.pageSize = 2;
+    self.requestedPages = [NSMutableArray array];
+    self.deliveredQueries = [NSMutableArray array];
+}
+
+- (void)tearDown
+{
+    [self.session cancel];
+    self.session = nil;
+
+    [super tearDown];
+}
+
+- (void)test_that_debounced_queries_send_one_request
+{
+    [self addSearchRouteWithRequestBlock:nil];
+    self.session.debounceInterval = 0.1;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"results"];
+    [self setResultsBlockWithExpectation:expectation forQuery:@"rep" itemCount:2];
+    [self.session searchWithQuery:@"r"];
+    [self.session searchWithQuery:@"re"];
+    [self.session searchWithQuery:@"rep"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqualObjects(@"rep@0", self.requestedPages.firstObject);
+    XCTAssertFalse([self.requestedPages containsObject:@"r@0"]);
+    XCTAssertFalse([self.requestedPages containsObject:@"re@0"]);
+}
+
+- (void)test_that_superseded_in_flight_query_is_not_delivered
+{
+    // The request for "alpha" is held at the server until "beta" has replaced it.
+    dispatch_semaphore_t supersededSemaphore = dispatch_semaphore_create(0);
+    XCTestExpectation *alphaExpectation = [self expectationWithDescription:@"alpha requested"];
+    [self addSearchRouteWithRequestBlock:^(NSString *query, NSUInteger offset) {
+        if ([query isEqualToString:@"alpha"]) {
+            dispatch_async(dispatch_get_main_queue(), ^{
+                [alphaExpectation fulfill];
+            });
+            dispatch_semaphore_wait(supersededSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5.0 * NSEC_PER_SEC)));
+        }
+    }];
+    self.session.prefetchesNextPage = NO;
+
+    [self setResultsBlockWithExpectation:nil forQuery:nil itemCount:0];
+    [self.session searchWithQuery:@"alpha"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTestExpectation *betaExpectation = [self expectationWithDescription:@"beta results"];
+    [self setResultsBlockWithExpectation:betaExpectation forQuery:@"beta" itemCount:2];
+    [self.session searchWithQuery:@"beta"];
+    dispatch_semaphore_signal(supersededSemaphore);
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqualObjects((@[@"beta"]), self.deliveredQueries);
+}
+
+- (void)test_that_pages_are_merged_in_order_and_prefetched
+{
+    [self addSearchRouteWithRequestBlock:nil];
+
+    XCTestExpectation *firstPageExpectation = [self expectationWithDescription:@"first page"];
+    [self setResultsBlockWithExpectation:firstPageExpectation forQuery:@"report" itemCount:2];
+    [self.session searchWithQuery:@"report"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    // The second page is prefetched, so it is answered without waiting for another first request.
+    XCTestExpectation *secondPageExpectation = [self expectationWithDescription:@"second page"];
+    [self setResultsBlockWithExpectation:secondPageExpectation forQuery:@"report" itemCount:4];
+    [self.session loadNextPage];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTestExpectation *lastPageExpectation = [self expectationWithDescription:@"last page"];
+    __block NSArray *mergedItems = nil;
+    __block NSUInteger mergedTotalCount = 0;
+    self.session.resultsBlock = ^(NSString *query, NSArray<BOXItem *> *items, NSUInteger totalCount, BOOL provisional, NSError *error) {
+        XCTAssertNil(error);
+        mergedItems = items;
+        mergedTotalCount = totalCount;
+        [lastPageExpectation fulfill];
+    };
+    [self.session loadNextPage];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqualObjects((@[@"report-0", @"report-1", @"report-2", @"report-3", @"report-4"]), [mergedItems valueForKey:@"modelID"]);
+    XCTAssertEqual(BOX_SEARCH_SESSION_TEST_RESULT_COUNT, mergedTotalCount);
+    XCTAssertEqualObjects((@[@"report@0", @"report@2", @"report@4"]), self.requestedPages);
+
+    // Everything is loaded, so there is nothing left to request.
+    [self.session loadNextPage];
+    XCTAssertEqual(3, self.requestedPages.count);
+}
+
+- (void)test_that_cached_query_is_answered_without_a_request
+{
+    [self addSearchRouteWithRequestBlock:nil];
+    self.session.prefetchesNextPage = NO;
+
+    XCTestExpectation *reportExpectation = [self expectationWithDescription:@"report"];
+    [self setResultsBlockWithExpectation:reportExpectation forQuery:@"report" itemCount:2];
+    [self.session searchWithQuery:@"report"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTestExpectation *budgetExpectation = [self expectationWithDescription:@"budget"];
+    [self setResultsBlockWithExpectation:budgetExpectation forQuery:@"budget" itemCount:2];
+    [self.session searchWithQuery:@"budget"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    __block NSArray *cachedItems = nil;
+    self.session.resultsBlock = ^(NSString *query, NSArray<BOXItem *> *items, NSUInteger totalCount, BOOL provisional, NSError *error) {
+        cachedItems = items;
+    };
+    [self.session searchWithQuery:@"Report "];
+
+    XCTAssertEqualObjects((@[@"report-0", @"report-1"]), [cachedItems valueForKey:@"modelID"]);
+    XCTAssertEqual(2, self.requestedPages.count);
+}
+
+- (void)test_that_failed_query_is_retried_when_searched_again
+{
+    [self addSearchRouteWithRequestBlock:nil];
+    self.session.prefetchesNextPage = NO;
+    self.offline = YES;
+
+    XCTestExpectation *failureExpectation = [self expectationWithDescription:@"failure"];
+    self.session.resultsBlock = ^(NSString *query, NSArray<BOXItem *> *items, NSUInteger totalCount, BOOL provisional, NSError *error) {
+        XCTAssertNotNil(error);
+        [failureExpectation fulfill];
+    };
+    [self.session searchWithQuery:@"report"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    self.offline = NO;
+    XCTestExpectation *retryExpectation = [self expectationWithDescription:@"retry"];
+    [self setResultsBlockWithExpectation:retryExpectation forQuery:@"report" itemCount:2];
+    [self.session searchWithQuery:@"report"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    // Once it succeeded, searching for it again is ignored.
+    [self.session searchWithQuery:@"report"];
+    XCTAssertEqualObjects((@[@"report@0", @"report@0"]), self.requestedPages);
+    XCTAssertEqualObjects((@[@"report"]), self.deliveredQueries);
+}
+
+- (void)test_that_expired_results_are_requested_again
+{
+    [self addSearchRouteWithRequestBlock:nil];
+    self.session.prefetchesNextPage = NO;
+    self.session.cacheTimeToLive = 0.1;
+
+    XCTestExpectation *reportExpectation = [self expectationWithDescription:@"report"];
+    [self setResultsBlockWithExpectation:reportExpectation forQuery:@"report" itemCount:2];
+    [self.session searchWithQuery:@"report"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTestExpectation *budgetExpectation = [self expectationWithDescription:@"budget"];
+    [self setResultsBlockWithExpectation:budgetExpectation forQuery:@"budget" itemCount:2];
+    [self.session searchWithQuery:@"budget"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    [NSThread sleepForTimeInterval:0.2];
+
+    XCTestExpectation *refreshExpectation = [self expectationWithDescription:@"refresh"];
+    [self setResultsBlockWithExpectation:refreshExpectation forQuery:@"report" itemCount:2];
+    [self.session searchWithQuery:@"report"];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqualObjects((@[@"report@0", @"budget@0", @"report@0"]), self.requestedPages);
+}
+
+#pragma mark - Helpers
+
+// Serves BOX_SEARCH_SESSION_TEST_RESULT_COUNT files named after the query, a page at a time, unless offline
+// is set. requestBlock is called on the protocol's thread before the response is sent.
+- (void)addSearchRouteWithRequestBlock:(void (^)(NSString *query, NSUInteger offset))requestBlock
+{
+    NSMutableArray *requestedPages = self.requestedPages;
+    __weak BOXSearchSessionTests *weakSelf = self;
+    [BOXBenchmarkURLProtocol addRouteWithMethod:@"GET" pathPattern:@"/search$" handler:^BOXBenchmarkResponse *(NSURLRequest *request, unsigned long long bodyLength) {
+        NSDictionary *parameters = [request.URL box_queryDictionary];
+        NSString *query = parameters[BOXAPIParameterKeyQuery];
+        NSUInteger offset = (NSUInteger)[parameters[BOXAPIParameterKeyOffset] integerValue];
+        NSUInteger limit = (NSUInteger)[parameters[BOXAPIParameterKeyLimit] integerValue];
+        @synchronized(requestedPages) {
+            [requestedPages addObject:[NSString stringWithFormat:@"%@@%lu", query, (unsigned long)offset]];
+        }
+        if (requestBlock) {
+            requestBlock(query, offset);
+        }
+        if (weakSelf.offline) {
+            NSError *networkError = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNotConnectedToInternet userInfo:nil];
+            return [BOXBenchmarkResponse responseWithError:networkError];
+        }
+
+        NSMutableArray *entries = [NSMutableArray array];
+        for (NSUInteger i = offset; i < MIN(offset + limit, BOX_SEARCH_SESSION_TEST_RESULT_COUNT); i++) {
+            [entries addObject:@{@"type" : @"file",
+                                 @"id" : [NSString stringWithFormat:@"%@-%lu", query, (unsigned long)i],
+                                 @"name" : [NSString stringWithFormat:@"%@ %lu.pdf", query, (unsigned long)i]}];
+        }
+        return [BOXBenchmarkResponse responseWithStatusCode:200 JSONObject:@{@"total_count" : @(BOX_SEARCH_SESSION_TEST_RESULT_COUNT),
+                                                                            @"entries" : entries,
+                                                                            @"offset" : @(offset),
+                                                                            @"limit" : @(limit)}];
+    }];
+}
+
+// Records every delivery, and fulfills expectation once query has itemCount non-provisional results.
+- (void)setResultsBlockWithExpectation:(XCTestExpectation *)expectation forQuery:(NSString *)expectedQuery itemCount:(NSUInteger)itemCount
+{
+    NSMutableArray *deliveredQueries = self.deliveredQueries;
+    self.session.resultsBlock = ^(NSString *query, NSArray<BOXItem *> *items, NSUInteger totalCount, BOOL provisional, NSError *error) {
+        [deliveredQueries addObject:query];
+        if (!provisional && [query isEqualToString:expectedQuery] && items.count == itemCount) {
+            XCTAssertNil(error);
+            XCTAssertEqual(BOX_SEARCH_SESSION_TEST_RESULT_COUNT, totalCount);
+            [expectation fulfill];
+        }
+    };
+}
+
+@end
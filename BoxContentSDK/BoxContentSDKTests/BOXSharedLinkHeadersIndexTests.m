@@ -0,0 +1,157 @@
+//
+//  BOXSharedLinkHeadersIndexTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXSharedLinkHeadersIndex.h"
+#import "BOXSharedLinkHeadersDefaultManager.h"
+#import "BOXFolder.h"
+
+@interface BOXCountingSharedLinkStorage : BOXSharedLinkHeadersDefaultManager
+@property (nonatomic, readwrite, assign) NSUInteger lookupCount;
+@end
+
+@implementation BOXCountingSharedLinkStorage
+
+- (NSString *)sharedLinkForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    self.lookupCount++;
+    return [super sharedLinkForItemWithID:itemID itemType:itemType userID:userID];
+}
+
+@end
+
+// Holds the lookups of the item with ID blockedItemID until released.
+@interface BOXBlockingSharedLinkStorage : BOXSharedLinkHeadersDefaultManager
+@property (nonatomic, readwrite, copy) NSString *blockedItemID;
+@property (nonatomic, readwrite, strong) dispatch_semaphore_t lookupStartedSemaphore;
+@property (nonatomic, readwrite, strong) dispatch_semaphore_t releaseSemaphore;
+@end
+
+@implementation BOXBlockingSharedLinkStorage
+
+- (NSString *)sharedLinkForItemWithID:(NSString *)itemID itemType:(NSString *)itemType userID:(NSString *)userID
+{
+    if ([itemID isEqualToString:self.blockedItemID]) {
+        dispatch_semaphore_signal(self.lookupStartedSemaphore);
+        dispatch_semaphore_wait(self.releaseSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5.0 * NSEC_PER_SEC)));
+    }
+    return [super sharedLinkForItemWithID:itemID itemType:itemType userID:userID];
+}
+
+@end
+
+@interface BOXSharedLinkHeadersIndexTests : BOXContentSDKTestCase
+@end
+
+@implementation BOXSharedLinkHeadersIndexTests
+
+- (BOXFolderMini *)folderWithID:(NSString *)folderID
+{
+    return [[BOXFolderMini alloc] initWithJSON:@{@"type" : @"folder", @"id" : folderID}];
+}
+
+- (void)test_delegate_is_looked_up_once_per_item
+{
+    BOXCountingSharedLinkStorage *storage = [[BOXCountingSharedLinkStorage alloc] init];
+    [storage storeSharedLink:@"https://app.box.com/s/abc" forItemWithIDKey:@"1" itemTypeKey:@"file" password:@"pass" userIDKey:@"7"];
+    BOXSharedLinkHeadersIndex *index = [[BOXSharedLinkHeadersIndex alloc] initWithDelegate:storage];
+
+    for (NSUInteger i = 0; i < 10; i++) {
+        XCTAssertEqualObjects(@"https://app.box.com/s/abc", [index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+        XCTAssertEqualObjects(@"pass", [index passwordForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+        XCTAssertNil([index sharedLinkForItemWithID:@"2" itemType:@"file" userID:@"7"]);
+        XCTAssertNil([index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"8"]);
+    }
+    XCTAssertEqual(3, storage.lookupCount);
+}
+
+- (void)test_changes_are_written_through_to_the_delegate
+{
+    BOXSharedLinkHeadersDefaultManager *storage = [[BOXSharedLinkHeadersDefaultManager alloc] init];
+    BOXSharedLinkHeadersIndex *index = [[BOXSharedLinkHeadersIndex alloc] initWithDelegate:storage];
+    XCTAssertNil([index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+
+    [index storeSharedLink:@"https://app.box.com/s/abc" password:nil forItemWithID:@"1" itemType:@"file" userID:@"7"];
+    XCTAssertEqualObjects(@"https://app.box.com/s/abc", [index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+    XCTAssertEqualObjects(@"https://app.box.com/s/abc", [storage sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+
+    [index removeStoredInformationForItemWithID:@"1" itemType:@"file" userID:@"7"];
+    XCTAssertNil([index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+    XCTAssertNil([storage sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+}
+
+- (void)test_items_inherit_the_link_of_their_nearest_shared_ancestor
+{
+    BOXSharedLinkHeadersDefaultManager *storage = [[BOXSharedLinkHeadersDefaultManager alloc] init];
+    BOXSharedLinkHeadersIndex *index = [[BOXSharedLinkHeadersIndex alloc] initWithDelegate:storage];
+    [index storeSharedLink:@"https://app.box.com/s/root" password:nil forItemWithID:@"10" itemType:@"folder" userID:@"7"];
+    [index storeSharedLink:@"https://app.box.com/s/sub" password:@"old" forItemWithID:@"11" itemType:@"folder" userID:@"7"];
+
+    NSArray *ancestors = @[[self folderWithID:@"0"], [self folderWithID:@"10"], [self folderWithID:@"11"], [self folderWithID:@"12"]];
+    [index inheritSharedLinkFromAncestors:ancestors forItemWithID:@"1" itemType:@"file" userID:@"7"];
+    XCTAssertEqualObjects(@"https://app.box.com/s/sub", [index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+    XCTAssertEqualObjects(@"https://app.box.com/s/sub", [storage sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+
+    // The item follows changes to the ancestor it inherits from.
+    [index storeSharedLink:nil password:@"new" forItemWithID:@"11" itemType:@"folder" userID:@"7"];
+    XCTAssertEqualObjects(@"new", [index passwordForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+}
+
+- (void)test_missing_link_is_looked_up_again_once_expired
+{
+    BOXCountingSharedLinkStorage *storage = [[BOXCountingSharedLinkStorage alloc] init];
+    BOXSharedLinkHeadersIndex *index = [[BOXSharedLinkHeadersIndex alloc] initWithDelegate:storage];
+    index.missingEntryLifetime = 0.2;
+    XCTAssertNil([index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+
+    // The delegate learns of the link by other means.
+    [storage storeSharedLink:@"https://app.box.com/s/abc" forItemWithIDKey:@"1" itemTypeKey:@"file" password:nil userIDKey:@"7"];
+    XCTAssertNil([index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+    XCTAssertEqual(1, storage.lookupCount);
+
+    [[NSRunLoop currentRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.3]];
+    XCTAssertEqualObjects(@"https://app.box.com/s/abc", [index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+    XCTAssertEqual(2, storage.lookupCount);
+}
+
+- (void)test_invalidated_entries_are_looked_up_again
+{
+    BOXCountingSharedLinkStorage *storage = [[BOXCountingSharedLinkStorage alloc] init];
+    BOXSharedLinkHeadersIndex *index = [[BOXSharedLinkHeadersIndex alloc] initWithDelegate:storage];
+    [index storeSharedLink:@"https://app.box.com/s/old" password:nil forItemWithID:@"1" itemType:@"file" userID:@"7"];
+    XCTAssertNil([index sharedLinkForItemWithID:@"2" itemType:@"file" userID:@"7"]);
+
+    [storage storeSharedLink:@"https://app.box.com/s/new" forItemWithIDKey:@"1" itemTypeKey:@"file" password:nil userIDKey:@"7"];
+    [storage storeSharedLink:@"https://app.box.com/s/two" forItemWithIDKey:@"2" itemTypeKey:@"file" password:nil userIDKey:@"7"];
+    [index invalidateCachedEntries];
+
+    XCTAssertEqualObjects(@"https://app.box.com/s/new", [index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+    XCTAssertEqualObjects(@"https://app.box.com/s/two", [index sharedLinkForItemWithID:@"2" itemType:@"file" userID:@"7"]);
+}
+
+- (void)test_indexed_lookups_do_not_wait_for_the_delegate
+{
+    BOXBlockingSharedLinkStorage *storage = [[BOXBlockingSharedLinkStorage alloc] init];
+    storage.blockedItemID = @"2";
+    storage.lookupStartedSemaphore = dispatch_semaphore_create(0);
+    storage.releaseSemaphore = dispatch_semaphore_create(0);
+    BOXSharedLinkHeadersIndex *index = [[BOXSharedLinkHeadersIndex alloc] initWithDelegate:storage];
+    [index storeSharedLink:@"https://app.box.com/s/abc" password:nil forItemWithID:@"1" itemType:@"file" userID:@"7"];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"blocked lookup"];
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        XCTAssertNil([index sharedLinkForItemWithID:@"2" itemType:@"file" userID:@"7"]);
+        [expectation fulfill];
+    });
+    XCTAssertEqual(0, dispatch_semaphore_wait(storage.lookupStartedSemaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5.0 * NSEC_PER_SEC))));
+
+    // The delegate is busy with item 2, which does not hold up item 1.
+    XCTAssertEqualObjects(@"https://app.box.com/s/abc", [index sharedLinkForItemWithID:@"1" itemType:@"file" userID:@"7"]);
+
+    dispatch_semaphore_signal(storage.releaseSemaphore);
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+@end
@@ -0,0 +1,50 @@
+//
+//  BOXSimulatedNetwork.h
+//  BoxContentSDK
+//
+
+#import <Foundation/Foundation.h>
+#import "BOXNetworkConditions.h"
+
+// A response being delivered by the simulated network.
+@interface BOXSimulatedTransfer : NSObject
+
+- (void)cancel;
+
+@end
+
+// Simulated network between the SDK and the hosts it talks to. When conditions are set for the host of a
+// request, BOXCannedURLProtocol delivers its canned response through them instead of instantly: after a
+// latency drawn from their distribution, at their bandwidth, with their stalls, or replaced by one of their
+// faults.
+//
+// Random draws are made from a generator seeded with seed, the host and the index of the request to that
+// host, so that a test sees the same conditions on every run regardless of thread scheduling.
+@interface BOXSimulatedNetwork : NSObject
+
++ (instancetype)sharedNetwork;
+
+// Conditions of hosts without conditions of their own. nil, the default, leaves them unaffected.
+@property (atomic, readwrite, strong) BOXNetworkConditions *defaultConditions;
+
+@property (atomic, readwrite, assign) uint64_t seed;
+
+// Multiplies every simulated delay. Defaults to 1.0. Lower it to run tests of slow networks faster.
+@property (atomic, readwrite, assign) double timeScale;
+
+- (void)setConditions:(BOXNetworkConditions *)conditions forHost:(NSString *)host;
+- (BOXNetworkConditions *)conditionsForHost:(NSString *)host;
+
+// Number of requests to host that went through the simulated network.
+- (NSUInteger)requestCountForHost:(NSString *)host;
+
+// Removes all conditions and request counts, and restores the seed and time scale.
+- (void)reset;
+
+// Starts delivering response and data to the client of protocol, or returns nil if there are no conditions for
+// the host of its request. Must be called from startLoading.
+- (BOXSimulatedTransfer *)startTransferWithResponse:(NSHTTPURLResponse *)response
+                                               data:(NSData *)data
+                                        forProtocol:(NSURLProtocol *)protocol;
+
+@end
@@ -0,0 +1,286 @@
+//
+//  BOXSimulatedNetwork.m
+//  BoxContentSDK
+//
+
+#import "BOXSimulatedNetwork.h"
+
+#define BOX_SIMULATED_NETWORK_DEFAULT_SEED (0x5EED5EED5EED5EEDULL)
+#define BOX_SIMULATED_NETWORK_LONG_TAIL_ALPHA (1.5)
+#define BOX_SIMULATED_NETWORK_LONG_TAIL_CAP (20.0)
+
+// xorshift64*, so that draws do not depend on the platform's random().
+static double BOXSimulatedRandomDouble(uint64_t *state)
+{
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    uint64_t value = *state * 0x2545F4914F6CDD1DULL;
+    return (double)(value >> 11) / (double)(1ULL << 53);
+}
+
+@interface BOXSimulatedStep : NSObject
+
+@property (nonatomic, readwrite, assign) NSTimeInterval delay;
+@property (nonatomic, readwrite, copy) dispatch_block_t block;
+
+@end
+
+@implementation BOXSimulatedStep
+@end
+
+@interface BOXSimulatedTransfer ()
+
+@property (nonatomic, readwrite, strong) NSURLProtocol *protocol;
+@property (nonatomic, readwrite, strong) NSThread *clientThread;
+@property (nonatomic, readwrite, strong) NSArray *clientModes;
+@property (nonatomic, readwrite, strong) dispatch_queue_t queue;
+@property (nonatomic, readwrite, strong) NSMutableArray *steps;
+@property (nonatomic, readwrite, assign) double timeScale;
+@property (atomic, readwrite, assign) BOOL cancelled;
+
+@end
+
+@implementation BOXSimulatedTransfer
+
+- (instancetype)initWithProtocol:(NSURLProtocol *)protocol timeScale:(double)timeScale
+{
+    if (self = [super init]) {
+        _protocol = protocol;
+        _timeScale = timeScale;
+        // NSURLProtocol clients must be called on the thread, and in the run loop mode, loading started in.
+        _clientThread = [NSThread currentThread];
+        NSString *currentMode = [[NSRunLoop currentRunLoop] currentMode];
+        _clientModes = (currentMode && ![currentMode isEqualToString:NSDefaultRunLoopMode]) ? @[NSDefaultRunLoopMode, currentMode] : @[NSDefaultRunLoopMode];
+        _queue = dispatch_queue_create("com.box.contentsdk.simulatednetwork", DISPATCH_QUEUE_SERIAL);
+        _steps = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)addStepWithDelay:(NSTimeInterval)delay block:(dispatch_block_t)block
+{
+    BOXSimulatedStep *step = [[BOXSimulatedStep alloc] init];
+    step.delay = delay;
+    step.block = block;
+    [self.steps addObject:step];
+}
+
+- (void)start
+{
+    [self runStepAtIndex:0];
+}
+
+- (void)cancel
+{
+    self.cancelled = YES;
+}
+
+- (void)runStepAtIndex:(NSUInteger)index
+{
+    if (self.cancelled || index >= self.steps.count) {
+        self.protocol = nil;
+        return;
+    }
+
+    BOXSimulatedStep *step = self.steps[index];
+    NSTimeInterval delay = MAX(step.delay * self.timeScale, 0);
+    dispatch_after(dispatch_time(DISPATCH_TIME_NOW, (int64_t)(delay * NSEC_PER_SEC)), self.queue, ^{
+        if (self.cancelled) {
+            self.protocol = nil;
+            return;
+        }
+        [self performSelector:@selector(runClientBlock:) onThread:self.clientThread withObject:step.block waitUntilDone:NO modes:self.clientModes];
+        [self runStepAtIndex:index + 1];
+    });
+}
+
+- (void)runClientBlock:(dispatch_block_t)block
+{
+    if (!self.cancelled) {
+        block();
+    }
+}
+
+@end
+
+@interface BOXSimulatedNetwork ()
+
+@property (nonatomic, readwrite, strong) NSMutableDictionary *conditionsByHost;
+@property (nonatomic, readwrite, strong) NSMutableDictionary *requestCountsByHost;
+
+@end
+
+@implementation BOXSimulatedNetwork
+
++ (instancetype)sharedNetwork
+{
+    static BOXSimulatedNetwork *sharedNetwork = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedNetwork = [[BOXSimulatedNetwork alloc] init];
+    });
+    return sharedNetwork;
+}
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _seed = BOX_SIMULATED_NETWORK_DEFAULT_SEED;
+        _timeScale = 1.0;
+        _conditionsByHost = [NSMutableDictionary dictionary];
+        _requestCountsByHost = [NSMutableDictionary dictionary];
+    }
+    return self;
+}
+
+- (void)setConditions:(BOXNetworkConditions *)conditions forHost:(NSString *)host
+{
+    @synchronized(self) {
+        self.conditionsByHost[host] = conditions;
+    }
+}
+
+- (BOXNetworkConditions *)conditionsForHost:(NSString *)host
+{
+    @synchronized(self) {
+        return (host ? self.conditionsByHost[host] : nil) ?: self.defaultConditions;
+    }
+}
+
+- (NSUInteger)requestCountForHost:(NSString *)host
+{
+    @synchronized(self) {
+        return [self.requestCountsByHost[host] unsignedIntegerValue];
+    }
+}
+
+- (void)reset
+{
+    @synchronized(self) {
+        [self.conditionsByHost removeAllObjects];
+        [self.requestCountsByHost removeAllObjects];
+        self.defaultConditions = nil;
+        self.seed = BOX_SIMULATED_NETWORK_DEFAULT_SEED;
+        self.timeScale = 1.0;
+    }
+}
+
+- (BOXSimulatedTransfer *)startTransferWithResponse:(NSHTTPURLResponse *)response
+                                               data:(NSData *)data
+                                        forProtocol:(NSURLProtocol *)protocol
+{
+    NSURLRequest *request = protocol.request;
+    NSString *host = request.URL.host;
+    BOXNetworkConditions *conditions = [self conditionsForHost:host];
+    if (conditions == nil) {
+        return nil;
+    }
+
+    NSUInteger requestIndex = 0;
+    uint64_t state = 0;
+    @synchronized(self) {
+        requestIndex = [self.requestCountsByHost[host] unsignedIntegerValue];
+        self.requestCountsByHost[host] = @(requestIndex + 1);
+        state = self.seed ^ ((uint64_t)host.hash * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)(requestIndex + 1) * 0xBF58476D1CE4E5B9ULL);
+    }
+    if (state == 0) {
+        state = BOX_SIMULATED_NETWORK_DEFAULT_SEED;
+    }
+
+    NSTimeInterval latency = [self latencyWithConditions:conditions state:&state];
+    BOXNetworkFault *fault = [self faultWithConditions:conditions requestIndex:requestIndex state:&state];
+
+    BOXSimulatedTransfer *transfer = [[BOXSimulatedTransfer alloc] initWithProtocol:protocol timeScale:self.timeScale];
+    __weak NSURLProtocol *weakProtocol = protocol;
+    id<NSURLProtocolClient> client = protocol.client;
+
+    if (fault != nil && fault.type == BOXNetworkFaultTypeConnectionError) {
+        NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:fault.errorCode userInfo:nil];
+        [transfer addStepWithDelay:latency block:^{
+            [client URLProtocol:weakProtocol didFailWithError:error];
+        }];
+        [transfer start];
+        return transfer;
+    }
+
+    NSUInteger bodyLength = data.length;
+    if (fault != nil && fault.type == BOXNetworkFaultTypeHTTPStatus) {
+        NSMutableDictionary *headerFields = [NSMutableDictionary dictionaryWithObject:@"application/json" forKey:@"Content-Type"];
+        [headerFields addEntriesFromDictionary:fault.headerFields];
+        response = [[NSHTTPURLResponse alloc] initWithURL:request.URL statusCode:fault.statusCode HTTPVersion:@"HTTP/1.1" headerFields:headerFields];
+        NSDictionary *errorJSON = @{@"type" : @"error",
+                                    @"status" : @(fault.statusCode),
+                                    @"code" : (fault.statusCode == 429) ? @"rate_limit_exceeded" : @"simulated_fault"};
+        data = [NSJSONSerialization dataWithJSONObject:errorJSON options:0 error:nil];
+        bodyLength = data.length;
+    } else if (fault != nil && (fault.type == BOXNetworkFaultTypeDisconnect || fault.type == BOXNetworkFaultTypeTruncatedBody)) {
+        bodyLength = MIN(fault.bodyBytesDelivered, data.length);
+    }
+
+    NSHTTPURLResponse *URLResponse = response;
+    [transfer addStepWithDelay:latency block:^{
+        [client URLProtocol:weakProtocol didReceiveResponse:URLResponse cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    }];
+
+    NSUInteger chunkSize = MAX(conditions.chunkSize, 1);
+    for (NSUInteger offset = 0; offset < bodyLength; offset += chunkSize) {
+        NSData *chunk = [data subdataWithRange:NSMakeRange(offset, MIN(chunkSize, bodyLength - offset))];
+        NSTimeInterval delay = conditions.bytesPerSecond > 0 ? (double)chunk.length / conditions.bytesPerSecond : 0;
+        if (conditions.stallProbability > 0 && BOXSimulatedRandomDouble(&state) < conditions.stallProbability) {
+            delay += conditions.stallDuration;
+        }
+        [transfer addStepWithDelay:delay block:^{
+            [client URLProtocol:weakProtocol didLoadData:chunk];
+        }];
+    }
+
+    if (fault != nil && fault.type == BOXNetworkFaultTypeDisconnect) {
+        NSError *error = [NSError errorWithDomain:NSURLErrorDomain code:NSURLErrorNetworkConnectionLost userInfo:nil];
+        [transfer addStepWithDelay:0 block:^{
+            [client URLProtocol:weakProtocol didFailWithError:error];
+        }];
+    } else {
+        [transfer addStepWithDelay:0 block:^{
+            [client URLProtocolDidFinishLoading:weakProtocol];
+        }];
+    }
+
+    [transfer start];
+    return transfer;
+}
+
+#pragma mark - Draws
+
+- (NSTimeInterval)latencyWithConditions:(BOXNetworkConditions *)conditions state:(uint64_t *)state
+{
+    switch (conditions.latencyDistribution) {
+        case BOXNetworkLatencyDistributionConstant:
+            return conditions.latency;
+        case BOXNetworkLatencyDistributionUniform:
+            return conditions.latency + conditions.jitter * BOXSimulatedRandomDouble(state);
+        case BOXNetworkLatencyDistributionLongTail: {
+            // Inverse transform sampling of a Pareto distribution of minimum jitter.
+            double uniform = MAX(BOXSimulatedRandomDouble(state), DBL_EPSILON);
+            double tail = conditions.jitter * pow(uniform, -1.0 / BOX_SIMULATED_NETWORK_LONG_TAIL_ALPHA);
+            return conditions.latency + MIN(tail, conditions.jitter * BOX_SIMULATED_NETWORK_LONG_TAIL_CAP);
+        }
+    }
+    return conditions.latency;
+}
+
+- (BOXNetworkFault *)faultWithConditions:(BOXNetworkConditions *)conditions requestIndex:(NSUInteger)requestIndex state:(uint64_t *)state
+{
+    for (BOXNetworkFault *fault in conditions.faults) {
+        if (fault.requestRange.location != NSNotFound) {
+            if (NSLocationInRange(requestIndex, fault.requestRange)) {
+                return fault;
+            }
+        } else if (fault.probability > 0 && BOXSimulatedRandomDouble(state) < fault.probability) {
+            return fault;
+        }
+    }
+    return nil;
+}
+
+@end
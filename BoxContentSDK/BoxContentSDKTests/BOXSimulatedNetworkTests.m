@@ -0,0 +1,78 @@
+//
+//  BOXSimulatedNetworkTests.m
+//  BoxContentSDK
+//
+
+#import "BOXRequestTestCase.h"
+#import "BOXSimulatedNetwork.h"
+#import "BOXFolderRequest.h"
+#import "BOXFolder.h"
+#import "BOXContentSDKErrors.h"
+
+@interface BOXSimulatedNetworkTests : BOXRequestTestCase
+@end
+
+@implementation BOXSimulatedNetworkTests
+
+- (BOXFolderRequest *)folderRequestWithCannedResponse
+{
+    BOXFolderRequest *folderRequest = [[BOXFolderRequest alloc] initWithFolderID:@"12345"];
+    NSData *cannedResponseData = [self cannedResponseDataWithName:@"folder_all_fields"];
+    NSHTTPURLResponse *URLResponse = [self cannedURLResponseWithStatusCode:200 responseData:cannedResponseData];
+    [self setCannedURLResponse:URLResponse cannedResponseData:cannedResponseData forRequest:folderRequest];
+    return folderRequest;
+}
+
+- (void)test_that_response_is_delivered_after_latency
+{
+    BOXFolderRequest *folderRequest = [self folderRequestWithCannedResponse];
+    [[BOXSimulatedNetwork sharedNetwork] setConditions:[BOXNetworkConditions conditionsWithLatency:0.3 bytesPerSecond:0]
+                                               forHost:folderRequest.urlRequest.URL.host];
+
+    NSDate *startDate = [NSDate date];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [folderRequest performRequestWithCompletion:^(BOXFolder *folder, NSError *error) {
+        XCTAssertNil(error);
+        XCTAssertEqualObjects(@"12345", folder.modelID);
+        XCTAssertGreaterThanOrEqual(-[startDate timeIntervalSinceNow], 0.3);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+
+    XCTAssertEqual(1, [[BOXSimulatedNetwork sharedNetwork] requestCountForHost:folderRequest.urlRequest.URL.host]);
+}
+
+- (void)test_that_scheduled_rate_limit_fault_replaces_response
+{
+    BOXFolderRequest *folderRequest = [self folderRequestWithCannedResponse];
+    BOXNetworkConditions *conditions = [[BOXNetworkConditions alloc] init];
+    [conditions addFault:[BOXNetworkFault rateLimitFaultWithRetryAfter:1] forRequestsInRange:NSMakeRange(0, 1)];
+    [[BOXSimulatedNetwork sharedNetwork] setConditions:conditions forHost:folderRequest.urlRequest.URL.host];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [folderRequest performRequestWithCompletion:^(BOXFolder *folder, NSError *error) {
+        XCTAssertNil(folder);
+        XCTAssertEqual(BOXContentSDKAPIErrorTooManyRequests, error.code);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+- (void)test_that_disconnect_fault_fails_request_mid_stream
+{
+    BOXFolderRequest *folderRequest = [self folderRequestWithCannedResponse];
+    BOXNetworkConditions *conditions = [[BOXNetworkConditions alloc] init];
+    conditions.chunkSize = 64;
+    [conditions addFault:[BOXNetworkFault disconnectAfterBodyBytes:100] withProbability:1.0];
+    [[BOXSimulatedNetwork sharedNetwork] setConditions:conditions forHost:folderRequest.urlRequest.URL.host];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    [folderRequest performRequestWithCompletion:^(BOXFolder *folder, NSError *error) {
+        XCTAssertNil(folder);
+        XCTAssertNotNil(error);
+        [expectation fulfill];
+    }];
+    [self waitForExpectationsWithTimeout:2.0 handler:nil];
+}
+
+@end
@@ -0,0 +1,19 @@
+//
+//  BOXStandInClientTestCase.h
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+
+// Base class of the tests that run a BOXContentClient against BOXBenchmarkURLProtocol, an in-process stand-in for
+// the Box API. The stand-in is registered for each test, which adds the routes it needs; they are removed after it.
+@interface BOXStandInClientTestCase : BOXContentSDKTestCase
+
+// An authenticated client whose requests are all served by BOXBenchmarkURLProtocol.
+@property (nonatomic, readonly, strong) BOXContentClient *client;
+
+- (NSDictionary *)fileJSONWithID:(NSString *)fileID;
+
+- (NSDictionary *)folderJSONWithID:(NSString *)folderID;
+
+@end
@@ -0,0 +1,47 @@
+//
+//  BOXStandInClientTestCase.m
+//  BoxContentSDK
+//
+
+#import "BOXStandInClientTestCase.h"
+#import "BOXBenchmarkURLProtocol.h"
+#import "BOXContentClient.h"
+
+@interface BOXStandInClientTestCase ()
+
+@property (nonatomic, readwrite, strong) BOXContentClient *client;
+
+@end
+
+@implementation BOXStandInClientTestCase
+
+- (void)setUp
+{
+    [super setUp];
+
+    [NSURLProtocol registerClass:[BOXBenchmarkURLProtocol class]];
+    self.client = [self clientWithURLProtocolClass:[BOXBenchmarkURLProtocol class]
+                                       accessToken:@"stand_in_access_token"
+                                      refreshToken:@"stand_in_refresh_token"];
+}
+
+- (void)tearDown
+{
+    [BOXBenchmarkURLProtocol reset];
+    [NSURLProtocol unregisterClass:[BOXBenchmarkURLProtocol class]];
+    self.client = nil;
+
+    [super tearDown];
+}
+
+- (NSDictionary *)fileJSONWithID:(NSString *)fileID
+{
+    return @{@"type" : @"file", @"id" : fileID, @"name" : [NSString stringWithFormat:@"File %@.txt", fileID]};
+}
+
+- (NSDictionary *)folderJSONWithID:(NSString *)folderID
+{
+    return @{@"type" : @"folder", @"id" : folderID, @"name" : [NSString stringWithFormat:@"Folder %@", folderID]};
+}
+
+@end
@@ -0,0 +1,91 @@
+//
+//  BOXTraceLogTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXTraceLog.h"
+#import "BOXAPIJSONOperation.h"
+
+@interface BOXTraceLogTests : BOXContentSDKTestCase
+@end
+
+@implementation BOXTraceLogTests
+
+- (void)setUp
+{
+    [super setUp];
+    [BOXTraceLog clear];
+}
+
+- (void)tearDown
+{
+    BOXTraceMinimumLevel = BOXTraceLevelDebug;
+    [BOXTraceLog setFailureHandler:nil];
+    [super tearDown];
+}
+
+- (void)test_records_are_formatted_when_dumped
+{
+    uint64_t operationID = [BOXTraceLog nextOperationID];
+    BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationEnqueued, operationID, BOXTraceQueueDownloads, (uintptr_t)[BOXAPIJSONOperation class], 0);
+    BOXTrace(BOXTraceLevelError, BOXTraceEventOperationFinished, operationID, 404, -1, BOXTraceErrorDomainContentSDK);
+    BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationStarted, operationID + 1, 0, 0, 0);
+
+    NSArray *lines = [[[BOXTraceLog dumpForOperationID:operationID] stringByTrimmingCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsSeparatedByString:@"\n"];
+    XCTAssertEqual(2, lines.count);
+    XCTAssertTrue([lines[0] hasSuffix:@"enqueued BOXAPIJSONOperation on downloads queue"]);
+    XCTAssertTrue([lines[1] containsString:@"[error]"]);
+    XCTAssertTrue([lines[1] hasSuffix:@"finished with status 404, error -1 in BOXContentSDKErrorDomain"]);
+}
+
+- (void)test_records_below_minimum_level_are_dropped
+{
+    BOXTraceMinimumLevel = BOXTraceLevelWarning;
+    uint64_t operationID = [BOXTraceLog nextOperationID];
+    BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationStarted, operationID, 0, 0, 0);
+    BOXTrace(BOXTraceLevelWarning, BOXTraceEventOperationMemoryLimitExceeded, operationID, 1024, 0, 0);
+
+    NSString *dump = [BOXTraceLog dumpForOperationID:operationID];
+    XCTAssertFalse([dump containsString:@"started"]);
+    XCTAssertTrue([dump containsString:@"over its memory limit with 1024 bytes"]);
+}
+
+- (void)test_only_the_last_records_of_a_thread_are_kept
+{
+    uint64_t operationID = [BOXTraceLog nextOperationID];
+    for (NSUInteger index = 0; index < BOX_TRACE_LOG_BUFFER_CAPACITY + 10; index++) {
+        BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationSessionTaskFailed, operationID, index, 0, 0);
+    }
+
+    NSString *dump = [BOXTraceLog dumpForOperationID:operationID];
+    NSArray *lines = [[dump stringByTrimmingCharactersInSet:[NSCharacterSet newlineCharacterSet]] componentsSeparatedByString:@"\n"];
+    XCTAssertEqual(BOX_TRACE_LOG_BUFFER_CAPACITY - 1, lines.count);
+    XCTAssertTrue([lines.firstObject hasSuffix:@"error 11"]);
+}
+
+- (void)test_records_of_every_thread_are_dumped_in_order
+{
+    uint64_t operationID = [BOXTraceLog nextOperationID];
+    BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationStarted, operationID, 0, 0, 0);
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"expectation"];
+    dispatch_async(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+        BOXTrace(BOXTraceLevelDebug, BOXTraceEventOperationExecuting, operationID, 0, 0, 0);
+        [expectation fulfill];
+    });
+    [self waitForExpectationsWithTimeout:1.0 handler:nil];
+    BOXTrace(BOXTraceLevelInfo, BOXTraceEventOperationCancelled, operationID, 0, 0, 0);
+
+    NSString *dump = [BOXTraceLog dumpForOperationID:operationID];
+    NSRange startedRange = [dump rangeOfString:@"started"];
+    NSRange executingRange = [dump rangeOfString:@"executing"];
+    NSRange cancelledRange = [dump rangeOfString:@"cancelled"];
+    XCTAssertTrue(startedRange.location < executingRange.location);
+    XCTAssertTrue(executingRange.location < cancelledRange.location);
+
+    [BOXTraceLog clear];
+    XCTAssertEqual(0, [BOXTraceLog dumpForOperationID:operationID].length);
+}
+
+@end
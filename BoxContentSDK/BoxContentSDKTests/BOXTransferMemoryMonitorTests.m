@@ -0,0 +1,128 @@
+//
+//  BOXTransferMemoryMonitorTests.m
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "BOXTransferMemoryMonitor.h"
+#import "BOXContentSDKConstants.h"
+
+@interface BOXTransferMemoryMonitorTests : BOXContentSDKTestCase
+
+@property (nonatomic, readwrite, strong) BOXTransferMemoryMonitor *monitor;
+
+@end
+
+@implementation BOXTransferMemoryMonitorTests
+
+- (void)setUp
+{
+    [super setUp];
+    self.monitor = [[BOXTransferMemoryMonitor alloc] init];
+}
+
+- (void)test_bytes_are_counted_per_operation_and_for_the_process
+{
+    BOXTransferMemoryAccount *firstAccount = [[BOXTransferMemoryAccount alloc] initWithMonitor:self.monitor];
+    BOXTransferMemoryAccount *secondAccount = [[BOXTransferMemoryAccount alloc] initWithMonitor:self.monitor];
+
+    XCTAssertTrue([firstAccount addBytes:100 ofKind:BOXTransferBufferKindDownloadBuffer]);
+    XCTAssertTrue([firstAccount addBytes:50 ofKind:BOXTransferBufferKindResponseData]);
+    XCTAssertTrue([secondAccount setBytes:30 ofKind:BOXTransferBufferKindDownloadBuffer]);
+    [firstAccount removeBytes:80 ofKind:BOXTransferBufferKindDownloadBuffer];
+
+    XCTAssertEqual(70, firstAccount.currentBytes);
+    XCTAssertEqual(150, firstAccount.peakBytes);
+    XCTAssertEqual(20, [firstAccount currentBytesOfKind:BOXTransferBufferKindDownloadBuffer]);
+    XCTAssertEqual(100, self.monitor.currentBytes);
+    XCTAssertEqual(180, self.monitor.peakBytes);
+    XCTAssertEqual(50, [self.monitor currentBytesOfKind:BOXTransferBufferKindDownloadBuffer]);
+    XCTAssertEqual(130, [self.monitor peakBytesOfKind:BOXTransferBufferKindDownloadBuffer]);
+
+    // Bytes of an account that goes away are no longer held.
+    firstAccount = nil;
+    XCTAssertEqual(30, self.monitor.currentBytes);
+
+    [self.monitor resetPeakBytes];
+    XCTAssertEqual(30, self.monitor.peakBytes);
+}
+
+- (void)test_going_over_operation_limit_notifies_once
+{
+    self.monitor.operationByteLimit = 100;
+    BOXTransferMemoryAccount *account = [[BOXTransferMemoryAccount alloc] initWithMonitor:self.monitor];
+
+    __block NSUInteger notificationCount = 0;
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:BOXTransferMemoryLimitReachedNotification object:self.monitor queue:nil usingBlock:^(NSNotification *notification) {
+        notificationCount++;
+        XCTAssertEqualObjects(@(120), notification.userInfo[BOXTransferMemoryOperationBytesKey]);
+    }];
+
+    XCTAssertTrue([account addBytes:80 ofKind:BOXTransferBufferKindStreamBuffer]);
+    XCTAssertFalse([account addBytes:40 ofKind:BOXTransferBufferKindStreamBuffer]);
+    XCTAssertFalse([account addBytes:10 ofKind:BOXTransferBufferKindResponseData]);
+    XCTAssertEqual(130, account.currentBytes);
+
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    XCTAssertEqual(1, notificationCount);
+}
+
+- (void)test_process_limit_applies_to_all_operations
+{
+    self.monitor.processByteLimit = 100;
+    BOXTransferMemoryAccount *firstAccount = [[BOXTransferMemoryAccount alloc] initWithMonitor:self.monitor];
+    BOXTransferMemoryAccount *secondAccount = [[BOXTransferMemoryAccount alloc] initWithMonitor:self.monitor];
+
+    XCTAssertTrue([firstAccount addBytes:60 ofKind:BOXTransferBufferKindMultipartBody]);
+    XCTAssertFalse([secondAccount addBytes:60 ofKind:BOXTransferBufferKindMultipartBody]);
+    XCTAssertFalse([self.monitor isWithinLimitsWithOperationBytes:0]);
+
+    [firstAccount removeAllBytes];
+    XCTAssertTrue([self.monitor isWithinLimitsWithOperationBytes:secondAccount.currentBytes]);
+}
+
+- (void)test_high_water_is_notified_as_peak_grows
+{
+    self.monitor.highWaterNotificationInterval = 1000;
+    BOXTransferMemoryAccount *account = [[BOXTransferMemoryAccount alloc] initWithMonitor:self.monitor];
+
+    __block NSMutableArray *peaks = [NSMutableArray array];
+    id observer = [[NSNotificationCenter defaultCenter] addObserverForName:BOXTransferMemoryHighWaterNotification object:self.monitor queue:nil usingBlock:^(NSNotification *notification) {
+        [peaks addObject:notification.userInfo[BOXTransferMemoryPeakBytesKey]];
+    }];
+
+    [account addBytes:600 ofKind:BOXTransferBufferKindDownloadBuffer];
+    [account addBytes:600 ofKind:BOXTransferBufferKindDownloadBuffer];
+    [account removeAllBytes];
+    [account addBytes:1500 ofKind:BOXTransferBufferKindDownloadBuffer];
+    [account addBytes:800 ofKind:BOXTransferBufferKindDownloadBuffer];
+
+    [[NSRunLoop mainRunLoop] runUntilDate:[NSDate dateWithTimeIntervalSinceNow:0.1]];
+    [[NSNotificationCenter defaultCenter] removeObserver:observer];
+    XCTAssertEqualObjects((@[@(1200), @(2300)]), peaks);
+}
+
+- (void)test_concurrent_operations_keep_the_process_totals_exact
+{
+    NSUInteger operationCount = 16;
+    NSUInteger chunkCount = 1000;
+
+    dispatch_apply(operationCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t operationIndex) {
+        BOXTransferMemoryAccount *account = [[BOXTransferMemoryAccount alloc] initWithMonitor:self.monitor];
+        for (NSUInteger chunkIndex = 0; chunkIndex < chunkCount; chunkIndex++) {
+            [account addBytes:10 ofKind:BOXTransferBufferKindDownloadBuffer];
+            [account removeBytes:10 ofKind:BOXTransferBufferKindDownloadBuffer];
+        }
+        [account addBytes:10 ofKind:BOXTransferBufferKindStreamBuffer];
+        XCTAssertEqual(10, account.currentBytes);
+        [account removeAllBytes];
+    });
+
+    XCTAssertEqual(0, self.monitor.currentBytes);
+    XCTAssertEqual(0, [self.monitor currentBytesOfKind:BOXTransferBufferKindDownloadBuffer]);
+    XCTAssertGreaterThanOrEqual(self.monitor.peakBytes, 10);
+    XCTAssertLessThanOrEqual(self.monitor.peakBytes, operationCount * 10);
+}
+
+@end
@@ -0,0 +1,416 @@
+//
+//  BOXURLSessionManagerTests.m
+//  BoxContentSDK
+//
+
+#import <UIKit/UIKit.h>
+#import "BOXContentSDKTestCase.h"
+#import "BOXURLSessionManager.h"
+#import "BOXURLSessionManager_Private.h"
+#import "BOXAPIJSONOperation.h"
+#import "BOXAPIQueueManager.h"
+#import "BOXContentClient.h"
+#import "BOXContentSDKConstants.h"
+#import "BOXMetricsRegistry.h"
+#import "BOXOAuth2Session.h"
+
+// Answers every request with a 200 whose body is the path of the request, and records the requests it received.
+@interface BOXURLSessionManagerTestURLProtocol : NSURLProtocol
+
++ (NSArray<NSURLRequest *> *)receivedRequests;
+// Called on the loading thread with each request, after it was recorded.
++ (void)setRequestBlock:(void (^)(NSURLRequest *request))requestBlock;
++ (void)reset;
+
+@end
+
+static NSMutableArray<NSURLRequest *> *staticReceivedRequests;
+static void (^staticRequestBlock)(NSURLRequest *request);
+
+@implementation BOXURLSessionManagerTestURLProtocol
+
++ (NSArray<NSURLRequest *> *)receivedRequests
+{
+    @synchronized(self) {
+        return [staticReceivedRequests copy] ?: @[];
+    }
+}
+
++ (void)setRequestBlock:(void (^)(NSURLRequest *request))requestBlock
+{
+    @synchronized(self) {
+        staticRequestBlock = [requestBlock copy];
+    }
+}
+
++ (void)reset
+{
+    @synchronized(self) {
+        staticReceivedRequests = nil;
+        staticRequestBlock = nil;
+    }
+}
+
++ (BOOL)canInitWithRequest:(NSURLRequest *)request
+{
+    return YES;
+}
+
++ (NSURLRequest *)canonicalRequestForRequest:(NSURLRequest *)request
+{
+    return request;
+}
+
+- (void)startLoading
+{
+    void (^requestBlock)(NSURLRequest *request) = nil;
+    @synchronized([self class]) {
+        if (staticReceivedRequests == nil) {
+            staticReceivedRequests = [NSMutableArray array];
+        }
+        [staticReceivedRequests addObject:self.request];
+        requestBlock = staticRequestBlock;
+    }
+    if (requestBlock) {
+        requestBlock(self.request);
+    }
+
+    NSData *data = [self.request.URL.path dataUsingEncoding:NSUTF8StringEncoding];
+    NSHTTPURLResponse *response = [[NSHTTPURLResponse alloc] initWithURL:self.request.URL
+                                                              statusCode:200
+                                                             HTTPVersion:@"HTTP/1.1"
+                                                            headerFields:@{@"Content-Length" : [NSString stringWithFormat:@"%lu", (unsigned long)data.length]}];
+    [self.client URLProtocol:self didReceiveResponse:response cacheStoragePolicy:NSURLCacheStorageNotAllowed];
+    if (![self.request.HTTPMethod isEqualToString:@"HEAD"]) {
+        [self.client URLProtocol:self didLoadData:data];
+    }
+    [self.client URLProtocolDidFinishLoading:self];
+}
+
+- (void)stopLoading
+{
+}
+
+@end
+
+// Collects what the manager reports for the tasks it is the delegate of.
+@interface BOXURLSessionManagerTestTaskDelegate : NSObject <BOXURLSessionDownloadTaskDelegate, BOXURLSessionUploadTaskDelegate>
+
+@property (nonatomic, readonly, strong) NSMutableArray<NSURLSessionTask *> *tasks;
+@property (nonatomic, readonly, strong) NSMutableData *data;
+@property (nonatomic, readonly, strong) NSMutableArray<NSURLSessionTaskMetrics *> *metrics;
+@property (nonatomic, readonly, assign) NSUInteger finishCount;
+@property (nonatomic, readwrite, strong) XCTestExpectation *expectation;
+
+@end
+
+@implementation BOXURLSessionManagerTestTaskDelegate
+
+- (instancetype)init
+{
+    if (self = [super init]) {
+        _tasks = [NSMutableArray array];
+        _data = [NSMutableData data];
+        _metrics = [NSMutableArray array];
+    }
+    return self;
+}
+
+- (void)sessionTask:(NSURLSessionTask *)sessionTask didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+    @synchronized(self) {
+        [self.metrics addObject:metrics];
+    }
+}
+
+- (void)sessionTask:(NSURLSessionTask *)sessionTask processIntermediateData:(NSData *)data
+{
+    @synchronized(self) {
+        [self.tasks addObject:sessionTask];
+        [self.data appendData:data];
+    }
+}
+
+- (void)sessionTask:(NSURLSessionTask *)sessionTask didFinishWithResponse:(NSURLResponse *)response responseData:(NSData *)responseData error:(NSError *)error
+{
+    @synchronized(self) {
+        [self.tasks addObject:sessionTask];
+        _finishCount++;
+    }
+    [self.expectation fulfill];
+}
+
+@end
+
+// Counts the metrics the manager forwards to a JSON operation.
+@interface BOXURLSessionManagerTestJSONOperation : BOXAPIJSONOperation
+
+@property (atomic, readonly, assign) NSUInteger metricsCount;
+
+@end
+
+@implementation BOXURLSessionManagerTestJSONOperation
+
+- (void)sessionTask:(NSURLSessionTask *)sessionTask didFinishCollectingMetrics:(NSURLSessionTaskMetrics *)metrics
+{
+    _metricsCount++;
+    [super sessionTask:sessionTask didFinishCollectingMetrics:metrics];
+}
+
+@end
+
+@interface BOXURLSessionManagerTests : BOXContentSDKTestCase
+
+@property (nonatomic, readwrite, strong) BOXURLSessionManager *manager;
+
+@end
+
+@implementation BOXURLSessionManagerTests
+
+- (void)setUp
+{
+    [super setUp];
+
+    self.manager = [[BOXURLSessionManager alloc] initWithProtocolClasses:@[[BOXURLSessionManagerTestURLProtocol class]]];
+    [self.manager setBaseURL:[NSURL URLWithString:@"https://api.box.com/2.0"] forTrafficClass:BOXURLSessionTrafficClassAPI];
+    [self.manager setBaseURL:[NSURL URLWithString:@"https://account.box.com/api"] forTrafficClass:BOXURLSessionTrafficClassAuth];
+    [self.manager setBaseURL:[NSURL URLWithString:@"https://upload.box.com/api/2.0"] forTrafficClass:BOXURLSessionTrafficClassUpload];
+}
+
+- (void)tearDown
+{
+    [BOXURLSessionManagerTestURLProtocol reset];
+    self.manager = nil;
+
+    [super tearDown];
+}
+
+- (void)test_that_token_requests_run_on_the_auth_session
+{
+    NSURLSessionDataTask *authTask = [self.manager dataTaskWithRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://account.box.com/api/oauth2/token"]]
+                                                     completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+    NSURLSessionDataTask *APITask = [self.manager dataTaskWithRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://api.box.com/2.0/folders/0"]]
+                                                    completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {}];
+
+    XCTAssertTrue([[self dataTasksOfTrafficClass:BOXURLSessionTrafficClassAuth] containsObject:authTask]);
+    XCTAssertFalse([[self dataTasksOfTrafficClass:BOXURLSessionTrafficClassAuth] containsObject:APITask]);
+    XCTAssertTrue([[self dataTasksOfTrafficClass:BOXURLSessionTrafficClassAPI] containsObject:APITask]);
+    XCTAssertFalse([[self dataTasksOfTrafficClass:BOXURLSessionTrafficClassAPI] containsObject:authTask]);
+
+    [authTask cancel];
+    [APITask cancel];
+}
+
+- (void)test_that_transfer_tasks_report_to_their_own_delegate
+{
+    BOXURLSessionManagerTestTaskDelegate *downloadDelegate = [[BOXURLSessionManagerTestTaskDelegate alloc] init];
+    downloadDelegate.expectation = [self expectationWithDescription:@"download finished"];
+    BOXURLSessionManagerTestTaskDelegate *uploadDelegate = [[BOXURLSessionManagerTestTaskDelegate alloc] init];
+    uploadDelegate.expectation = [self expectationWithDescription:@"upload finished"];
+
+    NSMutableURLRequest *uploadRequest = [NSMutableURLRequest requestWithURL:[NSURL URLWithString:@"https://upload.box.com/api/2.0/files/content"]];
+    uploadRequest.HTTPMethod = @"POST";
+    uploadRequest.HTTPBodyStream = [NSInputStream inputStreamWithData:[@"upload body" dataUsingEncoding:NSUTF8StringEncoding]];
+    NSURLSessionDataTask *downloadTask = [self.manager foregroundDownloadTaskWithRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://api.box.com/2.0/files/1/content"]]
+                                                                            taskDelegate:downloadDelegate];
+    NSURLSessionUploadTask *uploadTask = [self.manager foregroundUploadTaskWithStreamedRequest:uploadRequest taskDelegate:uploadDelegate];
+
+    // The upload and download sessions number their tasks independently, so the first task of each shares its identifier.
+    XCTAssertEqual(downloadTask.taskIdentifier, uploadTask.taskIdentifier);
+
+    [downloadTask resume];
+    [uploadTask resume];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqualObjects([NSSet setWithObject:downloadTask], [NSSet setWithArray:downloadDelegate.tasks]);
+    XCTAssertEqualObjects([NSSet setWithObject:uploadTask], [NSSet setWithArray:uploadDelegate.tasks]);
+    XCTAssertEqualObjects(@"/2.0/files/1/content", [[NSString alloc] initWithData:downloadDelegate.data encoding:NSUTF8StringEncoding]);
+    XCTAssertEqualObjects(@"/api/2.0/files/content", [[NSString alloc] initWithData:uploadDelegate.data encoding:NSUTF8StringEncoding]);
+}
+
+- (void)test_that_completion_handler_tasks_report_metrics_to_their_delegate
+{
+    BOXURLSessionManagerTestTaskDelegate *taskDelegate = [[BOXURLSessionManagerTestTaskDelegate alloc] init];
+    XCTestExpectation *expectation = [self expectationWithDescription:@"completed"];
+    NSURLSessionDataTask *task = [self.manager dataTaskWithRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:@"https://api.box.com/2.0/folders/0"]]
+                                                      taskDelegate:taskDelegate
+                                                 completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [task resume];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    // Metrics are collected before the completion handler runs, which alone reports the response.
+    XCTAssertEqual(1, taskDelegate.metrics.count);
+    XCTAssertEqual(0, taskDelegate.finishCount);
+    XCTAssertEqual(0, taskDelegate.data.length);
+}
+
+- (void)test_that_json_operations_record_transaction_metrics
+{
+    BOXMetricsRegistry *registry = [BOXMetricsRegistry sharedRegistry];
+    [registry reset];
+
+    BOXContentClient *client = [BOXContentClient clientForNewSession];
+    BOXOAuth2Session *session = [[BOXOAuth2Session alloc] initWithClientID:@"metrics_client_id"
+                                                                    secret:@"metrics_client_secret"
+                                                              queueManager:client.queueManager
+                                                         urlSessionManager:self.manager];
+    session.accessToken = @"metrics_access_token";
+    session.refreshToken = @"metrics_refresh_token";
+    session.accessTokenExpiration = [NSDate distantFuture];
+    client.session = session;
+
+    BOXURLSessionManagerTestJSONOperation *operation = [[BOXURLSessionManagerTestJSONOperation alloc] initWithURL:[NSURL URLWithString:@"https://api.box.com/2.0/folders/0/items"]
+                                                                                                        HTTPMethod:BOXAPIHTTPMethodGET
+                                                                                                              body:nil
+                                                                                                       queryParams:nil
+                                                                                                           session:session];
+    // The test protocol answers with the path, which is not JSON; either way the request is measured.
+    XCTestExpectation *expectation = [self expectationWithDescription:@"finished"];
+    operation.success = ^(NSURLRequest *request, NSHTTPURLResponse *response, NSDictionary *JSONDictionary) {
+        [expectation fulfill];
+    };
+    operation.failure = ^(NSURLRequest *request, NSHTTPURLResponse *response, NSError *error, NSDictionary *JSONDictionary) {
+        [expectation fulfill];
+    };
+    [client.queueManager enqueueOperation:operation];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    XCTAssertEqual(1, operation.metricsCount);
+    BOXRequestFamilyMetrics *folderMetrics = [registry snapshot].requestMetricsByFamily[@"folders"];
+    XCTAssertEqual(1, folderMetrics.requestCount);
+    XCTAssertEqualObjects(@"GET https://api.box.com/2.0/folders/0/items", [self receivedRequestDescriptions].lastObject);
+}
+
+- (void)test_that_prewarm_sends_nothing_unless_enabled
+{
+    XCTAssertFalse(self.manager.prewarmsConnections);
+
+    [self.manager prewarm];
+    [self sendRequestAndWaitWithURLString:@"https://api.box.com/2.0/users/me"];
+
+    XCTAssertEqualObjects((@[@"GET https://api.box.com/2.0/users/me"]), [self receivedRequestDescriptions]);
+}
+
+- (void)test_that_prewarm_opens_each_traffic_class_once_within_the_interval
+{
+    self.manager.prewarmsConnections = YES;
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"prewarmed"];
+    __block NSUInteger HEADRequestCount = 0;
+    [BOXURLSessionManagerTestURLProtocol setRequestBlock:^(NSURLRequest *request) {
+        if ([request.HTTPMethod isEqualToString:@"HEAD"]) {
+            @synchronized(expectation) {
+                HEADRequestCount++;
+                if (HEADRequestCount == 3) {
+                    [expectation fulfill];
+                }
+            }
+        }
+    }];
+    [self.manager prewarm];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    // Downloads have no base URL, their content servers are only known from the API's redirects.
+    NSArray *expectedRequests = @[@"HEAD https://account.box.com/",
+                                  @"HEAD https://api.box.com/",
+                                  @"HEAD https://upload.box.com/"];
+    XCTAssertEqualObjects(expectedRequests, [[self receivedRequestDescriptions] sortedArrayUsingSelector:@selector(compare:)]);
+
+    // The app returning to the foreground right away does not open them again.
+    [[NSNotificationCenter defaultCenter] postNotificationName:UIApplicationWillEnterForegroundNotification object:nil];
+    [self.manager prewarm];
+    [self sendRequestAndWaitWithURLString:@"https://api.box.com/2.0/users/me"];
+
+    XCTAssertEqual(4, [BOXURLSessionManagerTestURLProtocol receivedRequests].count);
+    XCTAssertEqualObjects(@"GET https://api.box.com/2.0/users/me", [self receivedRequestDescriptions].lastObject);
+}
+
+- (void)test_that_a_new_host_is_prewarmed_within_the_interval
+{
+    self.manager.prewarmsConnections = YES;
+    [self.manager setBaseURL:nil forTrafficClass:BOXURLSessionTrafficClassAuth];
+    [self.manager setBaseURL:nil forTrafficClass:BOXURLSessionTrafficClassUpload];
+
+    XCTestExpectation *expectation = [self expectationWithDescription:@"prewarmed"];
+    __block NSUInteger HEADRequestCount = 0;
+    [BOXURLSessionManagerTestURLProtocol setRequestBlock:^(NSURLRequest *request) {
+        if ([request.HTTPMethod isEqualToString:@"HEAD"]) {
+            @synchronized(expectation) {
+                HEADRequestCount++;
+                if (HEADRequestCount == 2) {
+                    [expectation fulfill];
+                }
+            }
+        }
+    }];
+    [self.manager prewarm];
+    [self.manager setBaseURL:[NSURL URLWithString:@"https://api.example.com/2.0"] forTrafficClass:BOXURLSessionTrafficClassAPI];
+    [self.manager prewarm];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+
+    NSArray *expectedRequests = @[@"HEAD https://api.box.com/",
+                                  @"HEAD https://api.example.com/"];
+    XCTAssertEqualObjects(expectedRequests, [[self receivedRequestDescriptions] sortedArrayUsingSelector:@selector(compare:)]);
+}
+
+- (void)test_that_shared_manager_follows_the_client_base_URLs
+{
+    BOXURLSessionManager *sharedManager = [BOXURLSessionManager sharedInstance];
+
+    [BOXContentClient setAPIBaseURL:@"https://api.example.com/2.0"];
+    [BOXContentClient setOAuth2BaseURL:@"https://api.example.com/oauth2"];
+    [BOXContentClient setAPIUploadBaseURL:@"https://upload.example.com/api/2.1"];
+    XCTAssertEqualObjects([NSURL URLWithString:@"https://api.example.com/2.0"], [sharedManager baseURLForTrafficClass:BOXURLSessionTrafficClassAPI]);
+    XCTAssertEqualObjects([NSURL URLWithString:@"https://api.example.com/oauth2"], [sharedManager baseURLForTrafficClass:BOXURLSessionTrafficClassAuth]);
+    XCTAssertEqualObjects([NSURL URLWithString:@"https://upload.example.com/api/2.1"], [sharedManager baseURLForTrafficClass:BOXURLSessionTrafficClassUpload]);
+    XCTAssertNil([sharedManager baseURLForTrafficClass:BOXURLSessionTrafficClassDownload]);
+
+    // Clearing them goes back to the defaults.
+    [BOXContentClient setAPIBaseURL:nil];
+    [BOXContentClient setOAuth2BaseURL:nil];
+    [BOXContentClient setAPIUploadBaseURL:nil];
+    XCTAssertEqualObjects([NSURL URLWithString:@"https://api.box.com/2.0"], [sharedManager baseURLForTrafficClass:BOXURLSessionTrafficClassAPI]);
+    XCTAssertEqualObjects([NSURL URLWithString:@"https://api.box.com/oauth2"], [sharedManager baseURLForTrafficClass:BOXURLSessionTrafficClassAuth]);
+    XCTAssertEqualObjects([NSURL URLWithString:@"https://upload.box.com/api/2.1"], [sharedManager baseURLForTrafficClass:BOXURLSessionTrafficClassUpload]);
+}
+
+#pragma mark - Helpers
+
+- (NSArray<NSURLSessionDataTask *> *)dataTasksOfTrafficClass:(BOXURLSessionTrafficClass)trafficClass
+{
+    __block NSArray *dataTasks = nil;
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [[self.manager foregroundSessionForTrafficClass:trafficClass] getTasksWithCompletionHandler:^(NSArray *sessionDataTasks, NSArray *uploadTasks, NSArray *downloadTasks) {
+        dataTasks = sessionDataTasks;
+        dispatch_semaphore_signal(semaphore);
+    }];
+    dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, (int64_t)(5.0 * NSEC_PER_SEC)));
+    return dataTasks;
+}
+
+- (void)sendRequestAndWaitWithURLString:(NSString *)URLString
+{
+    XCTestExpectation *expectation = [self expectationWithDescription:URLString];
+    NSURLSessionDataTask *task = [self.manager dataTaskWithRequest:[NSURLRequest requestWithURL:[NSURL URLWithString:URLString]]
+                                                 completionHandler:^(NSData *data, NSURLResponse *response, NSError *error) {
+        XCTAssertNil(error);
+        [expectation fulfill];
+    }];
+    [task resume];
+    [self waitForExpectationsWithTimeout:5.0 handler:nil];
+}
+
+// "METHOD URL" of every request received, in the order they arrived.
+- (NSArray<NSString *> *)receivedRequestDescriptions
+{
+    NSMutableArray *descriptions = [NSMutableArray array];
+    for (NSURLRequest *request in [BOXURLSessionManagerTestURLProtocol receivedRequests]) {
+        [descriptions addObject:[NSString stringWithFormat:@"%@ %@", request.HTTPMethod, request.URL.absoluteString]];
+    }
+    return descriptions;
+}
+
+@end
@@ -0,0 +1,39 @@
+//
+//  NSDataBoxContentSDKAdditionsTests
+//  BoxContentSDK
+//
+
+#import "BOXContentSDKTestCase.h"
+#import "NSData+BOXContentSDKAdditions.h"
+
+@interface NSDataBoxContentSDKAdditionsTests : BOXContentSDKTestCase
+@end
+
+@implementation NSDataBoxContentSDKAdditionsTests
+
+- (void)test_gzipCompressedData_writes_a_smaller_gzip_stream_for_repetitive_JSON
+{
+    NSMutableString *JSON = [NSMutableString stringWithString:@"{\"entries\":["];
+    for (NSUInteger index = 0; index < 200; index++) {
+        [JSON appendFormat:@"{\"type\":\"file\",\"id\":\"%lu\",\"name\":\"file %lu.txt\"},", (unsigned long)index, (unsigned long)index];
+    }
+    [JSON appendString:@"{}]}"];
+    NSData *data = [JSON dataUsingEncoding:NSUTF8StringEncoding];
+
+    NSData *compressedData = [data box_gzipCompressedData];
+    XCTAssertNotNil(compressedData);
+    XCTAssertLessThan(compressedData.length, data.length / 4);
+
+    const unsigned char *bytes = compressedData.bytes;
+    XCTAssertEqual(0x1f, bytes[0]);
+    XCTAssertEqual(0x8b, bytes[1]);
+}
+
+- (void)test_gzipCompressedData_of_empty_data_is_a_valid_stream
+{
+    NSData *compressedData = [[NSData data] box_gzipCompressedData];
+    XCTAssertNotNil(compressedData);
+    XCTAssertGreaterThan(compressedData.length, 0);
+}
+
+@end